@@ -145,7 +145,7 @@ protected:
 
 namespace STAPPLER_VERSIONIZED stappler::mem_pool {
 
-namespace pool = sprt::memory::pool;
+namespace pool = stappler::memory::pool;
 namespace allocator = sprt::memory::allocator;
 
 using CharGroupId = stappler::CharGroupId;
@@ -209,7 +209,7 @@ bool exists_ordered(const Container &vec, const T &val);
 
 namespace STAPPLER_VERSIONIZED stappler::mem_std {
 
-namespace pool = sprt::memory::pool;
+namespace pool = stappler::memory::pool;
 namespace allocator = sprt::memory::allocator;
 
 using memory::allocator_t;
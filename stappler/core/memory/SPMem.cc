@@ -25,7 +25,10 @@ THE SOFTWARE.
 #include "SPMemPriorityQueue.h"
 #include "SPMemUuid.h"
 #include "SPString.h"
+#include "SPLog.h"
 #include <sprt/runtime/uuid.h>
+#include <chrono>
+#include <unordered_map>
 
 namespace STAPPLER_VERSIONIZED stappler::memory {
 
@@ -126,3 +129,412 @@ bool uuid::parse(uuid_t &d, StringView str) {
 }
 
 } // namespace stappler::memory
+
+namespace STAPPLER_VERSIONIZED stappler::memory::stats {
+
+namespace detail {
+
+SP_PUBLIC std::atomic<bool> s_enabled = false;
+
+}
+
+static uint64_t PoolStats_now() {
+	return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch())
+					.count());
+}
+
+struct PoolCounters {
+	uint64_t allocations = 0;
+	uint64_t frees = 0;
+	size_t bytes = 0;
+	size_t totalBytes = 0;
+	size_t peakBytes = 0; // high-water mark within this thread
+
+	void merge(const PoolCounters &other) {
+		allocations += other.allocations;
+		frees += other.frees;
+		bytes += other.bytes;
+		totalBytes += other.totalBytes;
+		peakBytes = std::max(peakBytes, other.peakBytes);
+	}
+};
+
+// Counters, written by one thread; mutex is contended only by snapshots and pool lifecycle
+// events, so allocations do not serialize on a global lock
+struct PoolStatsShard {
+	std::mutex mutex;
+	std::unordered_map<const pool_t *, PoolCounters> pools;
+};
+
+struct PoolInfo {
+	const char *tag = nullptr;
+	uint64_t created = 0;
+	uint32_t clears = 0;
+	size_t peakBytes = 0; // sampled on clear, destroy and snapshot
+	bool temporary = false;
+};
+
+struct PoolStatsData {
+	static PoolStatsData *getInstance() {
+		static PoolStatsData s_data;
+		return &s_data;
+	}
+
+	// lock order: mutex, then shard mutex
+	std::mutex mutex;
+	std::vector<std::shared_ptr<PoolStatsShard>> shards;
+	std::unordered_map<const pool_t *, PoolInfo> pools;
+
+	// totals for destroyed pools by tag, live pools are added on snapshot
+	std::map<std::string, TagStats, std::less<>> tags;
+	GlobalStats global;
+
+	std::atomic<uint64_t> dumpInterval = 0;
+	uint64_t lastDump = 0;
+
+	std::shared_ptr<PoolStatsShard> addShard() {
+		auto shard = std::make_shared<PoolStatsShard>();
+		std::unique_lock lock(mutex);
+		shards.emplace_back(shard);
+		return shard;
+	}
+
+	// counters of finished thread are kept in the first shard, so shards do not accumulate
+	void removeShard(const std::shared_ptr<PoolStatsShard> &shard) {
+		std::unique_lock lock(mutex);
+		auto it = std::find(shards.begin(), shards.end(), shard);
+		if (it == shards.end()) {
+			return;
+		}
+		shards.erase(it);
+
+		if (shards.empty()) {
+			shards.emplace_back(std::make_shared<PoolStatsShard>());
+		}
+
+		auto &target = shards.front();
+		std::unique_lock targetLock(target->mutex);
+		std::unique_lock shardLock(shard->mutex);
+		for (auto &it : shard->pools) { target->pools[it.first].merge(it.second); }
+		shard->pools.clear();
+	}
+
+	TagStats &getTag(const char *tag) {
+		auto name = StringView(tag ? tag : "<untagged>");
+		auto it = tags.find(name);
+		if (it == tags.end()) {
+			it = tags.emplace(name.str<memory::StandartInterface>(), TagStats()).first;
+			it->second.tag = it->first.data();
+		}
+		return it->second;
+	}
+
+	PoolInfo &getPool(const pool_t *pool, const char *tag) {
+		auto it = pools.find(pool);
+		if (it == pools.end()) {
+			it = pools.emplace(pool, PoolInfo{tag, PoolStats_now()}).first;
+
+			auto &t = getTag(tag);
+			++t.createdPools;
+		}
+		return it->second;
+	}
+
+	// sums counters for pool from all threads, optionally drops them
+	PoolCounters collect(const pool_t *pool, bool extract) {
+		PoolCounters ret;
+		for (auto &shard : shards) {
+			std::unique_lock lock(shard->mutex);
+			auto it = shard->pools.find(pool);
+			if (it != shard->pools.end()) {
+				ret.merge(it->second);
+				if (extract) {
+					shard->pools.erase(it);
+				}
+			}
+		}
+		return ret;
+	}
+
+	// all counters by pool, with metadata for pools, that were not created with wrappers
+	std::unordered_map<const pool_t *, PoolCounters> collect() {
+		std::unordered_map<const pool_t *, PoolCounters> ret;
+		for (auto &shard : shards) {
+			std::unique_lock lock(shard->mutex);
+			for (auto &it : shard->pools) { ret[it.first].merge(it.second); }
+		}
+
+		size_t bytes = 0;
+		for (auto &it : ret) {
+			auto &info = getPool(it.first, nullptr);
+			info.peakBytes =
+					std::max(info.peakBytes, std::max(it.second.peakBytes, it.second.bytes));
+			bytes += it.second.bytes;
+		}
+		global.peakBytes = std::max(global.peakBytes, bytes);
+		return ret;
+	}
+
+	void release(const pool_t *pool) {
+		auto it = pools.find(pool);
+		auto counters = collect(pool, true);
+		if (it == pools.end()) {
+			return;
+		}
+
+		auto &info = it->second;
+		auto &t = getTag(info.tag);
+		++t.destroyedPools;
+		t.allocations += counters.allocations;
+		t.totalBytes += counters.totalBytes;
+		t.clears += info.clears;
+		t.peakBytes = std::max(t.peakBytes,
+				std::max(info.peakBytes, std::max(counters.peakBytes, counters.bytes)));
+		t.totalLifetime += PoolStats_now() - info.created;
+
+		if (info.temporary) {
+			global.temporaryBytes += counters.totalBytes;
+			global.temporaryPeakBytes = std::max(global.temporaryPeakBytes, counters.totalBytes);
+		}
+
+		pools.erase(it);
+	}
+
+	bool shouldDump() {
+		auto interval = dumpInterval.load();
+		if (interval == 0) {
+			return false;
+		}
+
+		auto t = PoolStats_now();
+		if (t - lastDump >= interval) {
+			lastDump = t;
+			return true;
+		}
+		return false;
+	}
+};
+
+struct PoolStatsShardHolder {
+	std::shared_ptr<PoolStatsShard> shard;
+
+	PoolStatsShard *get() {
+		if (!shard) {
+			shard = PoolStatsData::getInstance()->addShard();
+		}
+		return shard.get();
+	}
+
+	~PoolStatsShardHolder() {
+		if (shard) {
+			PoolStatsData::getInstance()->removeShard(shard);
+		}
+	}
+};
+
+static thread_local PoolStatsShardHolder tl_poolStatsShard;
+
+void setEnabled(bool value) { detail::s_enabled = value; }
+
+void setDumpInterval(uint64_t usec) { PoolStatsData::getInstance()->dumpInterval = usec; }
+
+void foreachPool(const sprt::callback<void(const PoolStats &)> &cb) {
+	auto data = PoolStatsData::getInstance();
+
+	std::vector<PoolStats> pools;
+	do {
+		std::unique_lock lock(data->mutex);
+		auto counters = data->collect();
+		pools.reserve(data->pools.size());
+		for (auto &it : data->pools) {
+			PoolStats stats;
+			stats.pool = it.first;
+			stats.tag = it.second.tag;
+			stats.created = it.second.created;
+			stats.clears = it.second.clears;
+			stats.peakBytes = it.second.peakBytes;
+			stats.temporary = it.second.temporary;
+
+			auto cIt = counters.find(it.first);
+			if (cIt != counters.end()) {
+				stats.allocations = cIt->second.allocations;
+				stats.frees = cIt->second.frees;
+				stats.bytes = cIt->second.bytes;
+				stats.totalBytes = cIt->second.totalBytes;
+			}
+			pools.emplace_back(stats);
+		}
+	} while (0);
+
+	for (auto &it : pools) { cb(it); }
+}
+
+void foreachTag(const sprt::callback<void(const TagStats &)> &cb) {
+	auto data = PoolStatsData::getInstance();
+
+	std::vector<TagStats> tags;
+	do {
+		std::unique_lock lock(data->mutex);
+		auto counters = data->collect();
+
+		// destroyed pools are already accounted, live pools are added to the copy
+		auto result = data->tags;
+
+		for (auto &it : data->pools) {
+			auto name = StringView(it.second.tag ? it.second.tag : "<untagged>");
+			auto tIt = result.find(name);
+			if (tIt == result.end()) {
+				continue;
+			}
+
+			auto &t = tIt->second;
+			++t.livePools;
+			t.clears += it.second.clears;
+			t.peakBytes = std::max(t.peakBytes, it.second.peakBytes);
+
+			auto cIt = counters.find(it.first);
+			if (cIt != counters.end()) {
+				t.allocations += cIt->second.allocations;
+				t.bytes += cIt->second.bytes;
+				t.totalBytes += cIt->second.totalBytes;
+			}
+		}
+
+		tags.reserve(result.size());
+		for (auto &it : result) { tags.emplace_back(it.second); }
+	} while (0);
+
+	for (auto &it : tags) { cb(it); }
+}
+
+GlobalStats getGlobalStats() {
+	auto data = PoolStatsData::getInstance();
+	std::unique_lock lock(data->mutex);
+
+	auto counters = data->collect();
+
+	auto ret = data->global;
+	ret.livePools = uint32_t(data->pools.size());
+	ret.bytes = 0;
+	for (auto &it : counters) { ret.bytes += it.second.bytes; }
+	return ret;
+}
+
+void dump() {
+	auto global = getGlobalStats();
+
+	log::source().info("memory::stats", "pools: ", global.livePools, "; bytes: ", global.bytes,
+			"; peak: ", global.peakBytes, "; temporary: ", global.temporaryPerforms,
+			" performs, ", global.temporaryBytes, " bytes, ", global.temporaryPeakBytes, " peak");
+
+	foreachTag([&](const TagStats &t) {
+		log::source().info("memory::stats", "[", t.tag, "] pools: ", t.livePools, " (",
+				t.createdPools, " created, ", t.destroyedPools, " destroyed); bytes: ", t.bytes,
+				"; peak: ", t.peakBytes, "; total: ", t.totalBytes, "; allocs: ", t.allocations,
+				"; clears: ", t.clears, "; avg lifetime: ",
+				t.destroyedPools ? t.totalLifetime / t.destroyedPools : 0, " mks");
+	});
+}
+
+void reset() {
+	auto data = PoolStatsData::getInstance();
+	std::unique_lock lock(data->mutex);
+	for (auto &shard : data->shards) {
+		std::unique_lock shardLock(shard->mutex);
+		shard->pools.clear();
+	}
+	data->pools.clear();
+	data->tags.clear();
+	data->global = GlobalStats();
+}
+
+void onCreate(const pool_t *pool, const char *tag) {
+	auto data = PoolStatsData::getInstance();
+	std::unique_lock lock(data->mutex);
+
+	// pool address can be reused without destroy call through wrappers
+	data->release(pool);
+	data->getPool(pool, tag);
+}
+
+void onDestroy(const pool_t *pool) {
+	auto data = PoolStatsData::getInstance();
+
+	std::unique_lock lock(data->mutex);
+	data->release(pool);
+
+	if (data->shouldDump()) {
+		lock.unlock();
+		dump();
+	}
+}
+
+void onClear(const pool_t *pool) {
+	auto data = PoolStatsData::getInstance();
+
+	std::unique_lock lock(data->mutex);
+	auto &info = data->getPool(pool, nullptr);
+	++info.clears;
+
+	// bytes are dropped in all threads, cumulative counters are kept
+	size_t bytes = 0;
+	for (auto &shard : data->shards) {
+		std::unique_lock shardLock(shard->mutex);
+		auto it = shard->pools.find(pool);
+		if (it != shard->pools.end()) {
+			info.peakBytes = std::max(info.peakBytes, it->second.peakBytes);
+			bytes += it->second.bytes;
+			it->second.bytes = 0;
+			it->second.peakBytes = 0;
+		}
+	}
+	info.peakBytes = std::max(info.peakBytes, bytes);
+
+	if (data->shouldDump()) {
+		lock.unlock();
+		dump();
+	}
+}
+
+void onAlloc(const pool_t *pool, size_t size) {
+	auto shard = tl_poolStatsShard.get();
+	std::unique_lock lock(shard->mutex);
+
+	auto &p = shard->pools[pool];
+	++p.allocations;
+	p.bytes += size;
+	p.totalBytes += size;
+	p.peakBytes = std::max(p.peakBytes, p.bytes);
+}
+
+void onFree(const pool_t *pool, size_t) {
+	auto shard = tl_poolStatsShard.get();
+	std::unique_lock lock(shard->mutex);
+
+	// memory is returned into pool's free list, not to allocator, so, bytes are still held
+	++shard->pools[pool].frees;
+}
+
+void onTemporaryBegin(const pool_t *pool) {
+	auto data = PoolStatsData::getInstance();
+	std::unique_lock lock(data->mutex);
+
+	// temporary pool is reused by runtime, so, previous usage is dropped
+	data->release(pool);
+	data->getPool(pool, "<temporary>").temporary = true;
+	++data->global.temporaryPerforms;
+}
+
+void onTemporaryEnd(const pool_t *pool) {
+	auto data = PoolStatsData::getInstance();
+	std::unique_lock lock(data->mutex);
+
+	// temporary pool is cleared by runtime, not with wrapper
+	auto it = data->pools.find(pool);
+	if (it != data->pools.end() && it->second.temporary) {
+		data->release(pool);
+	}
+}
+
+} // namespace stappler::memory::stats
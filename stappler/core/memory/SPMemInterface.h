@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "SPMemDict.h" // IWYU pragma: keep
 #include "SPMemStringStream.h"
+#include "SPMemPoolStats.h"
 
 #include <sprt/runtime/mem/function.h>
 #include <sprt/runtime/mem/forward_list.h>
@@ -56,7 +57,27 @@ using sprt::memory::AllocPool;
 using sprt::memory::perform;
 using sprt::memory::perform_conditional;
 using sprt::memory::perform_clear;
+
+#if SP_MEMORY_POOL_STATS
+template <typename Callback, typename... Args>
+inline auto perform_temporary(Callback &&cb, Args &&...args) {
+	if (!stats::isEnabled()) {
+		return sprt::memory::perform_temporary(std::forward<Callback>(cb),
+				std::forward<Args>(args)...);
+	}
+
+	return sprt::memory::perform_temporary([&]() -> decltype(auto) {
+		struct TemporaryScope {
+			const pool_t *pool = sprt::memory::pool::acquire();
+			TemporaryScope() { stats::onTemporaryBegin(pool); }
+			~TemporaryScope() { stats::onTemporaryEnd(pool); }
+		} scope;
+		return cb();
+	}, std::forward<Args>(args)...);
+}
+#else
 using sprt::memory::perform_temporary;
+#endif
 
 using sprt::memory::function;
 using sprt::memory::basic_string;
@@ -84,19 +105,93 @@ using sprt::memory::allocator::destroy;
 
 namespace STAPPLER_VERSIONIZED stappler::memory::pool {
 
+using namespace sprt::memory::pool;
+
 using sprt::memory::pool::acquire;
+using sprt::memory::pool::cleanup_register;
+using sprt::memory::pool::pre_cleanup_register;
+using sprt::memory::pool::userdata_get;
+using sprt::memory::pool::userdata_set;
+
+#if SP_MEMORY_POOL_STATS
+// Wrappers for instrumentation, see SPMemPoolStats.h
+
+template <typename... Args>
+inline auto create(Args &&...args) {
+	auto ret = sprt::memory::pool::create(std::forward<Args>(args)...);
+	if (stats::isEnabled()) {
+		stats::onCreate(ret, nullptr);
+	}
+	return ret;
+}
+
+template <typename... Args>
+inline auto create_tagged(const char *tag, Args &&...args) {
+	auto ret = sprt::memory::pool::create_tagged(tag, std::forward<Args>(args)...);
+	if (stats::isEnabled()) {
+		stats::onCreate(ret, tag);
+	}
+	return ret;
+}
+
+template <typename... Args>
+inline void destroy(pool_t *p, Args &&...args) {
+	if (stats::isEnabled()) {
+		stats::onDestroy(p);
+	}
+	sprt::memory::pool::destroy(p, std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+inline void clear(pool_t *p, Args &&...args) {
+	if (stats::isEnabled()) {
+		stats::onClear(p);
+	}
+	sprt::memory::pool::clear(p, std::forward<Args>(args)...);
+}
+
+inline auto alloc(pool_t *p, size_t &size) {
+	auto ret = sprt::memory::pool::alloc(p, size);
+	if (stats::isEnabled()) {
+		stats::onAlloc(p, size);
+	}
+	return ret;
+}
+
+template <typename... Args>
+inline auto palloc(pool_t *p, size_t size, Args &&...args) {
+	auto ret = sprt::memory::pool::palloc(p, size, std::forward<Args>(args)...);
+	if (stats::isEnabled()) {
+		stats::onAlloc(p, size);
+	}
+	return ret;
+}
+
+inline auto calloc(pool_t *p, size_t count, size_t eltsize) {
+	auto ret = sprt::memory::pool::calloc(p, count, eltsize);
+	if (stats::isEnabled()) {
+		stats::onAlloc(p, count * eltsize);
+	}
+	return ret;
+}
+
+template <typename Ptr>
+inline void free(pool_t *p, Ptr ptr, size_t size) {
+	if (stats::isEnabled()) {
+		stats::onFree(p, size);
+	}
+	sprt::memory::pool::free(p, ptr, size);
+}
+#else
 using sprt::memory::pool::create;
 using sprt::memory::pool::create_tagged;
 using sprt::memory::pool::destroy;
 using sprt::memory::pool::clear;
-using sprt::memory::pool::cleanup_register;
-using sprt::memory::pool::pre_cleanup_register;
 using sprt::memory::pool::alloc;
 using sprt::memory::pool::palloc;
 using sprt::memory::pool::calloc;
 using sprt::memory::pool::free;
-using sprt::memory::pool::userdata_get;
-using sprt::memory::pool::userdata_set;
+#endif
 
 } // namespace stappler::memory::pool
 
@@ -0,0 +1,121 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef STAPPLER_CORE_MEMORY_SPMEMPOOLSTATS_H_
+#define STAPPLER_CORE_MEMORY_SPMEMPOOLSTATS_H_
+
+#include <sprt/runtime/mem/pool.h>
+#include <sprt/runtime/callback.h>
+#include <atomic>
+
+// Set to 0 to remove pool instrumentation wrappers at compile time
+#ifndef SP_MEMORY_POOL_STATS
+#define SP_MEMORY_POOL_STATS 1
+#endif
+
+/* Memory pool instrumentation
+ *
+ * Statistics are collected by memory::pool wrappers (create, create_tagged, destroy, clear,
+ * alloc, palloc, calloc, free) and memory::perform_temporary. Allocations, made by runtime
+ * containers directly, and allocator block acquisition are implemented in runtime and
+ * not visible on this level, so, numbers reflect explicit pool API usage.
+ *
+ * Allocation counters are kept per thread and merged on request, so, instrumented threads
+ * do not contend on allocation. Pool lifecycle events (create, clear, destroy) and
+ * snapshots take global lock. Peak values are tracked within thread and merged on clear,
+ * destroy and snapshot, so, peak for pool, used from several threads, is approximate.
+ *
+ * Instrumentation is disabled by default, when disabled wrappers cost one relaxed atomic load.
+ */
+
+namespace STAPPLER_VERSIONIZED stappler::memory::stats {
+
+using sprt::memory::pool_t;
+
+struct SP_PUBLIC PoolStats {
+	const pool_t *pool = nullptr;
+	const char *tag = nullptr;
+	uint64_t created = 0; // steady clock, microseconds
+	uint64_t allocations = 0;
+	uint64_t frees = 0;
+	size_t bytes = 0; // allocated since creation or last clear
+	size_t peakBytes = 0; // high-water mark between clears
+	size_t totalBytes = 0; // allocated over pool lifetime
+	uint32_t clears = 0;
+	bool temporary = false; // pool of perform_temporary
+};
+
+struct SP_PUBLIC TagStats {
+	const char *tag = nullptr;
+	uint32_t livePools = 0;
+	uint32_t createdPools = 0;
+	uint32_t destroyedPools = 0;
+	uint64_t allocations = 0;
+	size_t bytes = 0; // sum for live pools
+	size_t peakBytes = 0; // max high-water mark of single pool
+	size_t totalBytes = 0;
+	uint32_t clears = 0;
+	uint64_t totalLifetime = 0; // microseconds, for destroyed pools
+};
+
+struct SP_PUBLIC GlobalStats {
+	uint32_t livePools = 0;
+	size_t bytes = 0;
+	size_t peakBytes = 0;
+	uint64_t temporaryPerforms = 0;
+	size_t temporaryBytes = 0;
+	size_t temporaryPeakBytes = 0;
+};
+
+namespace detail {
+
+SP_PUBLIC extern std::atomic<bool> s_enabled;
+
+}
+
+inline bool isEnabled() { return detail::s_enabled.load(std::memory_order_relaxed); }
+
+SP_PUBLIC void setEnabled(bool);
+
+// Write stats into log not often then interval, checked on pool clear and destroy, 0 to disable
+SP_PUBLIC void setDumpInterval(uint64_t usec);
+
+SP_PUBLIC void foreachPool(const sprt::callback<void(const PoolStats &)> &);
+SP_PUBLIC void foreachTag(const sprt::callback<void(const TagStats &)> &);
+SP_PUBLIC GlobalStats getGlobalStats();
+
+SP_PUBLIC void dump();
+
+// Drops stats, live pools are tracked again on next allocation
+SP_PUBLIC void reset();
+
+SP_PUBLIC void onCreate(const pool_t *, const char *tag);
+SP_PUBLIC void onDestroy(const pool_t *);
+SP_PUBLIC void onClear(const pool_t *);
+SP_PUBLIC void onAlloc(const pool_t *, size_t);
+SP_PUBLIC void onFree(const pool_t *, size_t);
+SP_PUBLIC void onTemporaryBegin(const pool_t *);
+SP_PUBLIC void onTemporaryEnd(const pool_t *);
+
+} // namespace stappler::memory::stats
+
+#endif /* STAPPLER_CORE_MEMORY_SPMEMPOOLSTATS_H_ */
@@ -140,7 +140,41 @@ struct Source::BatchRequest {
 	}
 };
 
+// Returns subcategory block for n, or subcategories count, if n is out of subcategories range
+static size_t Source_findBlock(const Vector<size_t> &offsets, size_t n) {
+	auto it = std::upper_bound(offsets.begin() + 1, offsets.end(), n);
+	return size_t(it - offsets.begin()) - 1;
+}
+
+// Returns range within [first, first + count), that is not covered by cached items on both sides
+template <typename MapType>
+static std::pair<uint64_t, uint64_t> Source_findMissing(const MapType &items, uint64_t first,
+		size_t count) {
+	auto missingFirst = first;
+	auto missingLast = first + count;
+	auto it = items.lower_bound(typename MapType::key_type(first));
+	while (missingFirst < missingLast && it != items.end() && it->first.get() == missingFirst) {
+		++missingFirst;
+		++it;
+	}
+
+	if (missingFirst == missingLast) {
+		return std::make_pair(missingFirst, missingLast);
+	}
+
+	auto rit =
+			std::make_reverse_iterator(items.lower_bound(typename MapType::key_type(missingLast)));
+	while (missingLast > missingFirst && rit != items.rend()
+			&& rit->first.get() == missingLast - 1) {
+		--missingLast;
+		++rit;
+	}
+
+	return std::make_pair(missingFirst, missingLast);
+}
+
 void Source::clear() {
+	for (auto &it : _subCats) { it->setParent(nullptr); }
 	_subCats.clear();
 	_count = _orphanCount;
 	setDirty();
@@ -148,11 +182,14 @@ void Source::clear() {
 
 void Source::addSubcategry(Source *cat) {
 	_subCats.emplace_back(cat);
+	cat->setParent(this);
 	_count += cat->getGlobalCount();
 	setDirty();
 }
 
-Source::~Source() { }
+Source::~Source() {
+	for (auto &it : _subCats) { it->setParent(nullptr); }
+}
 
 Source *Source::getCategory(size_t n) {
 	if (n < getSubcatCount()) {
@@ -162,11 +199,10 @@ Source *Source::getCategory(size_t n) {
 }
 
 size_t Source::getCount(uint32_t l, bool subcats) const {
-	auto c = _orphanCount + ((subcats) ? _subCats.size() : 0);
-	if (l > 0) {
-		for (auto cat : _subCats) { c += cat->getCount(l - 1, subcats); }
+	if (l > 0 && !_subCats.empty()) {
+		return getCategoryIndex(l, subcats).count;
 	}
-	return c;
+	return _orphanCount + ((subcats) ? _subCats.size() : 0);
 }
 
 size_t Source::getSubcatCount() const { return _subCats.size(); }
@@ -176,11 +212,15 @@ size_t Source::getGlobalCount() const { return _count; }
 Source::Id Source::getId() const { return _categoryId; }
 
 void Source::setSubCategories(Vector<Rc<Source>> &&vec) {
+	for (auto &it : _subCats) { it->setParent(nullptr); }
 	_subCats = sp::move(vec);
+	attachSubcategories();
 	setDirty();
 }
 void Source::setSubCategories(const Vector<Rc<Source>> &vec) {
+	for (auto &it : _subCats) { it->setParent(nullptr); }
 	_subCats = vec;
+	attachSubcategories();
 	setDirty();
 }
 auto Source::getSubCategories() const -> const Vector<Rc<Source>> & { return _subCats; }
@@ -194,13 +234,31 @@ void Source::setChildsCount(size_t count) {
 
 size_t Source::getChildsCount() const { return _orphanCount; }
 
-void Source::setData(const Value &val) { _data = val; }
+void Source::setData(const Value &val) {
+	_data = val;
+	invalidate();
+}
 
-void Source::setData(Value &&val) { _data = sp::move(val); }
+void Source::setData(Value &&val) {
+	_data = sp::move(val);
+	invalidate();
+}
 
 auto Source::getData() const -> const Value & { return _data; }
 
-void Source::setDirty() { Subscription::setDirty(); }
+void Source::setDirty() {
+	invalidate();
+	Subscription::setDirty();
+}
+
+void Source::setSliceCacheLimit(size_t limit) {
+	_sliceCacheLimit = limit;
+	if (_sliceCacheLimit == 0) {
+		_sliceCaches.clear();
+	}
+}
+
+size_t Source::getSliceCacheLimit() const { return _sliceCacheLimit; }
 
 void Source::setCategoryBounds(Id &first, size_t &count, uint32_t l, bool subcats) {
 	// first should be 0 or bound value, that <= first
@@ -210,33 +268,48 @@ void Source::setCategoryBounds(Id &first, size_t &count, uint32_t l, bool subcat
 		return;
 	}
 
-	size_t lowerBound = 0, subcat = 0, offset = 0;
-	do {
-		lowerBound += offset;
-		offset = _subCats.at(subcat)->getCount(l - 1, subcats);
-		subcat++;
-	} while (subcat < (size_t)_subCats.size() && lowerBound + offset <= (size_t)first.get());
+	auto &index = getCategoryIndex(l, subcats);
+	auto nsubcats = _subCats.size();
 
-	// check if we should skip last subcategory
-	if (lowerBound + offset <= first.get()) {
-		lowerBound += offset;
+	// number of items in first n subcategories, excluding subcategory items itself
+	auto itemsBefore = [&](size_t n) { return index.offsets[n] - (subcats ? n : 0); };
+
+	// lower bound is a start of the last subcategory, that starts not after first
+	size_t lo = 0, hi = nsubcats;
+	while (lo < hi) {
+		auto mid = (lo + hi + 1) / 2;
+		if (itemsBefore(mid) <= size_t(first.get())) {
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
 	}
 
-	offset = size_t(first.get()) - lowerBound;
+	size_t lowerBound = itemsBefore(lo);
+	size_t offset = size_t(first.get()) - lowerBound;
 	first = Id(lowerBound);
 	count += offset; // increment size to match new bound
 
-	size_t upperBound = getCount(l, subcats);
+	size_t upperBound = index.count;
 	if (upperBound - _orphanCount >= lowerBound + count) {
 		upperBound -= _orphanCount;
 	}
 
-	offset = 0;
-	subcat = _subCats.size();
-	while (subcat > 0 && upperBound - offset >= lowerBound + count) {
-		upperBound -= offset;
-		offset = _subCats.at(subcat - 1)->getCount(l - 1, subcats);
-		subcat--;
+	// drop trailing subcategories, that are not required to cover [lowerBound, lowerBound + count)
+	auto total = itemsBefore(nsubcats);
+	lo = 0;
+	hi = nsubcats;
+	while (lo < hi) {
+		auto mid = (lo + hi) / 2;
+		if (upperBound - (total - itemsBefore(nsubcats - mid)) >= lowerBound + count) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	if (lo > 0) {
+		upperBound -= total - itemsBefore(nsubcats - lo + 1);
 	}
 
 	count = upperBound - lowerBound;
@@ -256,22 +329,22 @@ bool Source::getItemData(const DataCallback &cb, Id index) {
 }
 
 bool Source::getItemData(const DataCallback &cb, Id n, uint32_t l, bool subcats) {
-	if (l > 0) {
-		for (auto &cat : _subCats) {
+	if (l > 0 && !_subCats.empty()) {
+		auto &index = getCategoryIndex(l, subcats);
+		auto pos = size_t(n.get());
+		auto block = Source_findBlock(index.offsets, pos);
+		if (block < _subCats.size()) {
+			auto &cat = _subCats[block];
+			pos -= index.offsets[block];
 			if (subcats) {
-				if (n.empty()) {
+				if (pos == 0) {
 					return cat->getItemData(cb, Self);
-				} else {
-					n--;
 				}
+				--pos;
 			}
-			auto c = Id(cat->getCount(l - 1, subcats));
-			if (n < c) {
-				return cat->getItemData(cb, n, l - 1, subcats);
-			} else {
-				n -= c;
-			}
+			return cat->getItemData(cb, Id(pos), l - 1, subcats);
 		}
+		n -= Id(index.offsets.back());
 	}
 
 	if (!subcats) {
@@ -293,6 +366,7 @@ bool Source::removeItem(Id index, const Value &v) {
 	if (_removeCallback && index != Self) {
 		if (_removeCallback(index, v)) {
 			_orphanCount -= 1;
+			invalidate();
 			return true;
 		}
 	}
@@ -300,27 +374,28 @@ bool Source::removeItem(Id index, const Value &v) {
 }
 
 bool Source::removeItem(Id n, const Value &v, uint32_t l, bool subcats) {
-	if (l > 0) {
-		for (auto catIt = _subCats.begin(); catIt != _subCats.end(); ++catIt) {
-			auto &cat = *catIt;
+	if (l > 0 && !_subCats.empty()) {
+		auto &index = getCategoryIndex(l, subcats);
+		auto pos = size_t(n.get());
+		auto block = Source_findBlock(index.offsets, pos);
+		if (block < _subCats.size()) {
+			auto cat = _subCats[block];
+			pos -= index.offsets[block];
 			if (subcats) {
-				if (n.empty()) {
+				if (pos == 0) {
 					if (cat->removeItem(Self, v)) {
-						_subCats.erase(catIt);
+						cat->setParent(nullptr);
+						_subCats.erase(_subCats.begin() + block);
+						invalidate();
 						return true;
 					}
 					return false;
-				} else {
-					n--;
 				}
+				--pos;
 			}
-			auto c = Id(cat->getCount(l - 1, subcats));
-			if (n < c) {
-				return cat->removeItem(n, v, l - 1, subcats);
-			} else {
-				n -= c;
-			}
+			return cat->removeItem(Id(pos), v, l - 1, subcats);
 		}
+		n -= Id(index.offsets.back());
 	}
 
 	if (!subcats) {
@@ -336,36 +411,95 @@ bool Source::removeItem(Id n, const Value &v, uint32_t l, bool subcats) {
 
 size_t Source::getSliceData(const BatchCallback &cb, Id first, size_t count, uint32_t l,
 		bool subcats) {
-	SliceRequest *req = new (std::nothrow) SliceRequest(cb);
+	if (_sliceCacheLimit == 0 || count == 0) {
+		return requestSliceData(cb, first, count, l, subcats);
+	}
 
-	size_t f = size_t(first.get());
-	onSlice(req->vec, f, count, l, subcats);
+	auto &cache = getSliceCache(l, subcats);
+	cache.center = first.get() + count / 2;
 
-	if (!req->vec.empty()) {
-		return req->request(size_t(first.get()));
-	} else {
-		delete req;
-		return 0;
+	// only the middle part, that is not in cache, should be requested
+	auto [missingFirst, missingLast] = Source_findMissing(cache.items, first.get(), count);
+
+	Map<Id, Value> cached;
+	auto copyCached = [&](Id::Type from, Id::Type to) {
+		auto it = cache.items.lower_bound(Id(from));
+		while (it != cache.items.end() && it->first.get() < to) {
+			cached.emplace(it->first, it->second);
+			++it;
+		}
+	};
+
+	copyCached(first.get(), missingFirst);
+	copyCached(missingLast, first.get() + count);
+
+	if (missingFirst == missingLast) {
+		cb(cached);
+		return count;
 	}
+
+	auto generation = cache.generation;
+	return requestSliceData([this, guard = Rc<Source>(this), cb, l, subcats, generation,
+									cached = sp::move(cached)](Map<Id, Value> &data) mutable {
+		storeSliceData(data, l, subcats, generation);
+		for (auto &it : cached) { data.emplace(it.first, sp::move(it.second)); }
+		cb(data);
+	}, Id(missingFirst), size_t(missingLast - missingFirst), l, subcats)
+			+ (count - size_t(missingLast - missingFirst));
+}
+
+void Source::prefetchSliceData(Id first, size_t count, uint32_t l, bool subcats) {
+	if (_sliceCacheLimit == 0 || count == 0) {
+		return;
+	}
+
+	auto &cache = getSliceCache(l, subcats);
+
+	auto [missingFirst, missingLast] = Source_findMissing(cache.items, first.get(), count);
+
+	if (missingFirst == missingLast) {
+		return;
+	}
+
+	for (auto &it : cache.pending) {
+		if (it.first < missingLast && missingFirst < it.first + it.second) {
+			return; // already requested
+		}
+	}
+
+	auto range = std::make_pair(missingFirst, size_t(missingLast - missingFirst));
+	cache.pending.emplace_back(range);
+
+	auto generation = cache.generation;
+	requestSliceData([this, guard = Rc<Source>(this), l, subcats, generation, range](
+							 Map<Id, Value> &data) {
+		storeSliceData(data, l, subcats, generation);
+
+		auto &cache = getSliceCache(l, subcats);
+		auto it = std::find(cache.pending.begin(), cache.pending.end(), range);
+		if (it != cache.pending.end()) {
+			cache.pending.erase(it);
+		}
+	}, Id(range.first), range.second, l, subcats);
 }
 
 std::pair<Source *, bool> Source::getItemCategory(Id n, uint32_t l, bool subcats) {
-	if (l > 0) {
-		for (auto &cat : _subCats) {
+	if (l > 0 && !_subCats.empty()) {
+		auto &index = getCategoryIndex(l, subcats);
+		auto pos = size_t(n.get());
+		auto block = Source_findBlock(index.offsets, pos);
+		if (block < _subCats.size()) {
+			auto &cat = _subCats[block];
+			pos -= index.offsets[block];
 			if (subcats) {
-				if (n.empty()) {
-					return std::make_pair(cat, true);
-				} else {
-					n--;
+				if (pos == 0) {
+					return std::make_pair(cat.get(), true);
 				}
+				--pos;
 			}
-			auto c = cat->getCount(l - 1, subcats);
-			if (n.get() < c) {
-				return cat->getItemCategory(n, l - 1, subcats);
-			} else {
-				n -= Id(c);
-			}
+			return cat->getItemCategory(Id(pos), l - 1, subcats);
 		}
+		n -= Id(index.offsets.back());
 	}
 
 	if (!subcats) {
@@ -379,10 +513,138 @@ std::pair<Source *, bool> Source::getItemCategory(Id n, uint32_t l, bool subcats
 	}
 }
 
+auto Source::getCategoryIndex(uint32_t l, bool subcats) const -> const CategoryIndex & {
+	auto generation = _generation;
+
+	CategoryIndex *index = nullptr;
+	for (auto &it : _indexes) {
+		if (it.level == l && it.subcats == subcats) {
+			if (it.generation == generation) {
+				return it;
+			}
+			index = &it;
+			break;
+		}
+	}
+
+	if (!index) {
+		index = &_indexes.emplace_back();
+		index->level = l;
+		index->subcats = subcats;
+	}
+
+	index->offsets.resize(_subCats.size() + 1);
+	index->offsets[0] = 0;
+
+	size_t i = 0;
+	for (auto &cat : _subCats) {
+		index->offsets[i + 1] =
+				index->offsets[i] + (subcats ? 1 : 0) + cat->getCount(l - 1, subcats);
+		++i;
+	}
+
+	index->count = _orphanCount + index->offsets.back();
+	index->generation = generation;
+	return *index;
+}
+
+auto Source::getSliceCache(uint32_t l, bool subcats) -> SliceCache & {
+	auto generation = _generation;
+
+	SliceCache *cache = nullptr;
+	for (auto &it : _sliceCaches) {
+		if (it.level == l && it.subcats == subcats) {
+			cache = &it;
+			break;
+		}
+	}
+
+	if (!cache) {
+		cache = &_sliceCaches.emplace_back();
+		cache->level = l;
+		cache->subcats = subcats;
+		cache->generation = generation;
+	}
+
+	if (cache->generation != generation) {
+		cache->items.clear();
+		cache->pending.clear();
+		cache->generation = generation;
+	}
+
+	return *cache;
+}
+
+void Source::invalidate() {
+	// cached indexes of parents depend on counts of nested categories
+	auto source = this;
+	while (source) {
+		++source->_generation;
+		source = source->_parent;
+	}
+}
+
+void Source::setParent(Source *parent) { _parent = parent; }
+
+void Source::attachSubcategories() {
+	for (auto &it : _subCats) { it->setParent(this); }
+}
+
+void Source::storeSliceData(const Map<Id, Value> &data, uint32_t l, bool subcats,
+		uint64_t generation) {
+	if (_sliceCacheLimit == 0) {
+		return;
+	}
+
+	auto &cache = getSliceCache(l, subcats);
+	if (cache.generation != generation) {
+		return; // source was modified since request
+	}
+
+	for (auto &it : data) { cache.items.insert_or_assign(it.first, it.second); }
+
+	// drop items from the side, that is more distant from the last requested slice
+	while (cache.items.size() > _sliceCacheLimit) {
+		auto front = cache.items.begin()->first.get();
+		auto back = cache.items.rbegin()->first.get();
+		auto frontDist = (cache.center > front) ? cache.center - front : 0;
+		auto backDist = (back > cache.center) ? back - cache.center : 0;
+		if (frontDist > backDist) {
+			cache.items.erase(cache.items.begin());
+		} else {
+			cache.items.erase(std::prev(cache.items.end()));
+		}
+	}
+}
+
+size_t Source::requestSliceData(const BatchCallback &cb, Id first, size_t count, uint32_t l,
+		bool subcats) {
+	SliceRequest *req = new (std::nothrow) SliceRequest(cb);
+
+	size_t f = size_t(first.get());
+	onSlice(req->vec, f, count, l, subcats);
+
+	if (!req->vec.empty()) {
+		return req->request(size_t(first.get()));
+	} else {
+		delete req;
+		return 0;
+	}
+}
+
 void Source::onSlice(std::vector<Slice> &vec, size_t &first, size_t &count, uint32_t l,
 		bool subcats) {
-	if (l > 0) {
-		for (auto it = _subCats.begin(); it != _subCats.end(); it++) {
+	if (l > 0 && !_subCats.empty()) {
+		// skip subcategories before first with index lookup
+		auto &index = getCategoryIndex(l, subcats);
+		auto block = Source_findBlock(index.offsets, first);
+		first -= index.offsets[block];
+
+		for (auto it = _subCats.begin() + block; it != _subCats.end(); it++) {
+			if (first == 0 && count == 0) {
+				break;
+			}
+
 			if (first > 0) {
 				if (subcats) {
 					first--;
@@ -99,11 +99,52 @@ public:
 
 	void setDirty();
 
+	// Max number of items in slice cache, 0 disables cache (default)
+	// Cache stores copies of slice values, and drops items, that are most distant from last request
+	void setSliceCacheLimit(size_t);
+	size_t getSliceCacheLimit() const;
+
+	// Load slice into slice cache, if it's not cached or requested already
+	void prefetchSliceData(Id first, size_t count, uint32_t l = 0, bool subcats = false);
+
 protected:
 	struct BatchRequest;
 	struct SliceRequest;
 	struct Slice;
 
+	// Prefix sums of subcategory blocks for specific lookup level, so, item-to-category
+	// mapping takes binary search instead of walking over all subcategories
+	// Indexes are rebuilt lazily, when this Source or any of its subcategories was modified
+	struct CategoryIndex {
+		uint32_t level = 0;
+		bool subcats = false;
+		uint64_t generation = 0;
+		size_t count = 0;
+		Vector<size_t> offsets; // offsets.size() == _subCats.size() + 1
+	};
+
+	struct SliceCache {
+		uint32_t level = 0;
+		bool subcats = false;
+		uint64_t generation = 0;
+		Id::Type center = 0;
+		Map<Id, Value> items;
+		Vector<std::pair<Id::Type, size_t>> pending;
+	};
+
+	const CategoryIndex &getCategoryIndex(uint32_t l, bool subcats) const;
+	SliceCache &getSliceCache(uint32_t l, bool subcats);
+
+	// Increments generation of this source and all its parents
+	void invalidate();
+
+	void setParent(Source *);
+	void attachSubcategories();
+
+	void storeSliceData(const Map<Id, Value> &, uint32_t l, bool subcats, uint64_t generation);
+	size_t requestSliceData(const BatchCallback &, Id first, size_t count, uint32_t l,
+			bool subcats);
+
 	void onSlice(std::vector<Slice> &, size_t &first, size_t &count, uint32_t l, bool subcats);
 
 	virtual bool initValue();
@@ -126,6 +167,15 @@ protected:
 	DataSourceCallback _sourceCallback = nullptr;
 	BatchSourceCallback _batchCallback = nullptr;
 	RemoveSourceCallback _removeCallback = nullptr;
+
+	// Source, that holds this one as subcategory; source is expected to be a subcategory
+	// of one parent, only the last one is notified on changes
+	Source *_parent = nullptr;
+	uint64_t _generation = 1;
+
+	mutable Vector<CategoryIndex> _indexes;
+	Vector<SliceCache> _sliceCaches;
+	size_t _sliceCacheLimit = 0;
 };
 
 } // namespace stappler::data
@@ -0,0 +1,489 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "SPDataValueView.h"
+
+namespace STAPPLER_VERSIONIZED stappler::data {
+
+using namespace cbor;
+
+// limit for nested arrays and dictionaries, to prevent stack overflow on malformed input
+static constexpr uint32_t ValueViewMaxDepth = 256;
+
+static constexpr uint8_t ValueViewBreak = 0xFF;
+
+struct ValueViewHeader {
+	MajorTypeEncoded major = MajorTypeEncoded::Simple;
+	uint8_t info = 0;
+	uint64_t value = 0;
+	const uint8_t *next = nullptr; // data after header
+};
+
+static bool ValueView_readHeader(const uint8_t *ptr, const uint8_t *end, ValueViewHeader &h) {
+	if (ptr >= end) {
+		return false;
+	}
+
+	h.major = MajorTypeEncoded(*ptr & toInt(Flags::MajorTypeMaskEncoded));
+	h.info = *ptr & toInt(Flags::AdditionalInfoMask);
+	++ptr;
+
+	size_t n = 0;
+	if (h.info < toInt(Flags::MaxAdditionalNumber)) {
+		h.value = h.info;
+	} else if (h.info == toInt(Flags::AdditionalNumber8Bit)) {
+		n = 1;
+	} else if (h.info == toInt(Flags::AdditionalNumber16Bit)) {
+		n = 2;
+	} else if (h.info == toInt(Flags::AdditionalNumber32Bit)) {
+		n = 4;
+	} else if (h.info == toInt(Flags::AdditionalNumber64Bit)) {
+		n = 8;
+	} else if (h.info == toInt(Flags::UndefinedLength)) {
+		h.value = 0;
+	} else {
+		return false;
+	}
+
+	if (size_t(end - ptr) < n) {
+		return false;
+	}
+
+	if (n > 0) {
+		h.value = 0;
+		for (size_t i = 0; i < n; ++i) { h.value = (h.value << 8) | ptr[i]; }
+	}
+
+	h.next = ptr + n;
+	return true;
+}
+
+static const uint8_t *ValueView_skip(const uint8_t *ptr, const uint8_t *end, uint32_t depth) {
+	ValueViewHeader h;
+	if (depth > ValueViewMaxDepth || !ValueView_readHeader(ptr, end, h)) {
+		return nullptr;
+	}
+
+	switch (h.major) {
+	case MajorTypeEncoded::Unsigned:
+	case MajorTypeEncoded::Negative: return h.next; break;
+	case MajorTypeEncoded::Simple:
+		if (h.info == toInt(Flags::UndefinedLength)) {
+			return nullptr; // break mark is not a value
+		}
+		return h.next;
+		break;
+	case MajorTypeEncoded::ByteString:
+	case MajorTypeEncoded::CharString:
+		if (h.info == toInt(Flags::UndefinedLength)) {
+			auto p = h.next;
+			while (p < end && *p != ValueViewBreak) {
+				ValueViewHeader chunk;
+				if (!ValueView_readHeader(p, end, chunk) || chunk.major != h.major
+						|| chunk.info == toInt(Flags::UndefinedLength)
+						|| uint64_t(end - chunk.next) < chunk.value) {
+					return nullptr;
+				}
+				p = chunk.next + chunk.value;
+			}
+			return (p < end) ? p + 1 : nullptr;
+		}
+		if (uint64_t(end - h.next) < h.value) {
+			return nullptr;
+		}
+		return h.next + h.value;
+		break;
+	case MajorTypeEncoded::Array:
+	case MajorTypeEncoded::Map:
+		if (h.info == toInt(Flags::UndefinedLength)) {
+			auto p = h.next;
+			while (p && p < end && *p != ValueViewBreak) { p = ValueView_skip(p, end, depth + 1); }
+			return (p && p < end) ? p + 1 : nullptr;
+		} else {
+			auto p = h.next;
+			auto count = (h.major == MajorTypeEncoded::Map) ? h.value * 2 : h.value;
+			for (uint64_t i = 0; i < count && p; ++i) { p = ValueView_skip(p, end, depth + 1); }
+			return p;
+		}
+		break;
+	case MajorTypeEncoded::Tag: return ValueView_skip(h.next, end, depth + 1); break;
+	}
+	return nullptr;
+}
+
+// Iterates over items of array or dictionary, returns false if data is malformed
+static bool ValueView_foreachItem(const uint8_t *ptr, size_t size,
+		const Callback<void(const uint8_t *, const uint8_t *)> &cb) {
+	auto end = ptr + size;
+
+	ValueViewHeader h;
+	if (!ValueView_readHeader(ptr, end, h)) {
+		return false;
+	}
+
+	auto p = h.next;
+	if (h.info == toInt(Flags::UndefinedLength)) {
+		while (p < end && *p != ValueViewBreak) {
+			auto next = ValueView_skip(p, end, 0);
+			if (!next) {
+				return false;
+			}
+			cb(p, next);
+			p = next;
+		}
+	} else {
+		auto count = (h.major == MajorTypeEncoded::Map) ? h.value * 2 : h.value;
+		for (uint64_t i = 0; i < count; ++i) {
+			auto next = ValueView_skip(p, end, 0);
+			if (!next) {
+				return false;
+			}
+			cb(p, next);
+			p = next;
+		}
+	}
+	return true;
+}
+
+ValueView ValueView::read(BytesView data) {
+	if (data.size() > size_t(maxOf<uint32_t>())) {
+		return ValueView(); // index offsets are 32-bit
+	}
+
+	auto end = ValueView_skip(data.data(), data.data() + data.size(), 0);
+	if (!end) {
+		return ValueView();
+	}
+	return ValueView(data.data(), end - data.data());
+}
+
+ValueView::ValueView(const uint8_t *ptr, size_t size) : _ptr(ptr), _size(size) {
+	// tags are ignored, like in Decoder, including CBOR magic prefix
+	ValueViewHeader h;
+	while (_size > 0 && ValueView_readHeader(_ptr, _ptr + _size, h)
+			&& h.major == MajorTypeEncoded::Tag) {
+		_size -= h.next - _ptr;
+		_ptr = h.next;
+	}
+
+	if (_size == 0) {
+		_ptr = nullptr;
+	}
+}
+
+ValueView::~ValueView() {
+	if (auto index = _index.load(std::memory_order_relaxed)) {
+		index->release(0);
+	}
+}
+
+ValueView::ValueView(const ValueView &other) : _ptr(other._ptr), _size(other._size) {
+	if (auto index = other._index.load(std::memory_order_acquire)) {
+		index->retain();
+		_index.store(index, std::memory_order_relaxed);
+	}
+}
+
+ValueView &ValueView::operator=(const ValueView &other) {
+	if (this == &other) {
+		return *this;
+	}
+
+	auto index = other._index.load(std::memory_order_acquire);
+	if (index) {
+		index->retain();
+	}
+
+	if (auto prev = _index.exchange(index, std::memory_order_acq_rel)) {
+		prev->release(0);
+	}
+
+	_ptr = other._ptr;
+	_size = other._size;
+	return *this;
+}
+
+auto ValueView::getType() const -> Type {
+	ValueViewHeader h;
+	if (!_ptr || !ValueView_readHeader(_ptr, _ptr + _size, h)) {
+		return Type::EMPTY;
+	}
+
+	switch (h.major) {
+	case MajorTypeEncoded::Unsigned:
+	case MajorTypeEncoded::Negative: return Type::INTEGER; break;
+	case MajorTypeEncoded::ByteString: return Type::BYTESTRING; break;
+	case MajorTypeEncoded::CharString: return Type::CHARSTRING; break;
+	case MajorTypeEncoded::Array: return Type::ARRAY; break;
+	case MajorTypeEncoded::Map: return Type::DICTIONARY; break;
+	case MajorTypeEncoded::Tag: return Type::EMPTY; break;
+	case MajorTypeEncoded::Simple:
+		if (h.info == toInt(SimpleValue::True) || h.info == toInt(SimpleValue::False)) {
+			return Type::BOOLEAN;
+		} else if (h.info == toInt(SimpleValue::Null) || h.info == toInt(SimpleValue::Undefined)) {
+			return Type::EMPTY;
+		} else if (h.info == toInt(Flags::AdditionalFloat16Bit)
+				|| h.info == toInt(Flags::AdditionalFloat32Bit)
+				|| h.info == toInt(Flags::AdditionalFloat64Bit)) {
+			return Type::DOUBLE;
+		}
+		return Type::INTEGER;
+		break;
+	}
+	return Type::EMPTY;
+}
+
+int64_t ValueView::getInteger(int64_t def) const {
+	ValueViewHeader h;
+	if (!_ptr || !ValueView_readHeader(_ptr, _ptr + _size, h)) {
+		return def;
+	}
+
+	switch (getType()) {
+	case Type::INTEGER:
+		if (h.major == MajorTypeEncoded::Negative) {
+			return int64_t(-1 - h.value);
+		}
+		return int64_t(h.value);
+		break;
+	case Type::DOUBLE: return static_cast<int64_t>(getDouble()); break;
+	case Type::BOOLEAN: return (h.info == toInt(SimpleValue::True)) ? 1 : 0; break;
+	case Type::EMPTY:
+	case Type::CHARSTRING:
+	case Type::BYTESTRING: return 0; break;
+	default: break;
+	}
+	return def;
+}
+
+double ValueView::getDouble(double def) const {
+	switch (getType()) {
+	case Type::DOUBLE: {
+		BytesViewTemplate<sprt::endian::network> r(_ptr, _size);
+		auto info = r.readUnsigned() & toInt(Flags::AdditionalInfoMask);
+		if (info == toInt(Flags::AdditionalFloat16Bit)) {
+			return double(r.readFloat16());
+		} else if (info == toInt(Flags::AdditionalFloat32Bit)) {
+			return double(r.readFloat32());
+		} else {
+			return r.readFloat64();
+		}
+		break;
+	}
+	case Type::INTEGER:
+	case Type::BOOLEAN: return static_cast<double>(getInteger()); break;
+	case Type::EMPTY:
+	case Type::CHARSTRING:
+	case Type::BYTESTRING: return 0.0; break;
+	default: break;
+	}
+	return def;
+}
+
+bool ValueView::getBool() const {
+	switch (getType()) {
+	case Type::BOOLEAN:
+	case Type::INTEGER: return getInteger() != 0; break;
+	case Type::DOUBLE: return getDouble() != 0.0; break;
+	case Type::CHARSTRING: {
+		auto str = getString();
+		return !(str.empty() || str == "0" || str == "false");
+		break;
+	}
+	default: break;
+	}
+	return false;
+}
+
+StringView ValueView::getString() const {
+	ValueViewHeader h;
+	if (!_ptr || !ValueView_readHeader(_ptr, _ptr + _size, h)
+			|| h.major != MajorTypeEncoded::CharString
+			|| h.info == toInt(Flags::UndefinedLength)) {
+		return StringView();
+	}
+	return StringView((const char *)h.next, size_t(h.value));
+}
+
+BytesView ValueView::getBytes() const {
+	ValueViewHeader h;
+	if (!_ptr || !ValueView_readHeader(_ptr, _ptr + _size, h)
+			|| h.major != MajorTypeEncoded::ByteString
+			|| h.info == toInt(Flags::UndefinedLength)) {
+		return BytesView();
+	}
+	return BytesView(h.next, size_t(h.value));
+}
+
+size_t ValueView::size() const {
+	ValueViewHeader h;
+	if (!_ptr || !ValueView_readHeader(_ptr, _ptr + _size, h)
+			|| (h.major != MajorTypeEncoded::Array && h.major != MajorTypeEncoded::Map)) {
+		return 0;
+	}
+
+	if (h.info != toInt(Flags::UndefinedLength)) {
+		return size_t(h.value);
+	}
+
+	if (auto index = getIndex()) {
+		return (h.major == MajorTypeEncoded::Map) ? (index->offsets.size() - 1) / 2
+												  : index->offsets.size() - 1;
+	}
+	return 0;
+}
+
+ValueView ValueView::getValue(size_t n) const {
+	if (!isArray()) {
+		return ValueView();
+	}
+
+	auto index = getIndex();
+	if (!index || n + 1 >= index->offsets.size()) {
+		return ValueView();
+	}
+
+	return ValueView(_ptr + index->offsets[n], index->offsets[n + 1] - index->offsets[n]);
+}
+
+ValueView ValueView::getValue(StringView key) const {
+	if (!isDictionary()) {
+		return ValueView();
+	}
+
+	auto index = getIndex();
+	if (!index) {
+		return ValueView();
+	}
+
+	auto it = std::lower_bound(index->keys.begin(), index->keys.end(), key,
+			[](const Pair<StringView, uint32_t> &l, const StringView &r) { return l.first < r; });
+	if (it == index->keys.end() || it->first != key) {
+		return ValueView();
+	}
+
+	auto valueIdx = it->second * 2 + 1;
+	return ValueView(_ptr + index->offsets[valueIdx],
+			index->offsets[valueIdx + 1] - index->offsets[valueIdx]);
+}
+
+bool ValueView::hasValue(StringView key) const { return getValue(key)._ptr != nullptr; }
+
+StringView ValueView::getKey(size_t n) const {
+	if (!isDictionary()) {
+		return StringView();
+	}
+
+	auto index = getIndex();
+	if (!index || n * 2 + 1 >= index->offsets.size()) {
+		return StringView();
+	}
+
+	auto key = ValueView(_ptr + index->offsets[n * 2],
+			index->offsets[n * 2 + 1] - index->offsets[n * 2]);
+	if (key.isBytes()) {
+		return StringView((const char *)key.getBytes().data(), key.getBytes().size());
+	}
+	return key.getString();
+}
+
+void ValueView::foreach(const Callback<void(const ValueView &)> &cb) const {
+	if (!isArray()) {
+		return;
+	}
+
+	ValueView_foreachItem(_ptr, _size,
+			[&](const uint8_t *ptr, const uint8_t *end) { cb(ValueView(ptr, end - ptr)); });
+}
+
+void ValueView::foreach(const Callback<void(StringView, const ValueView &)> &cb) const {
+	if (!isDictionary()) {
+		return;
+	}
+
+	bool isKey = true;
+	StringView key;
+	ValueView_foreachItem(_ptr, _size, [&](const uint8_t *ptr, const uint8_t *end) {
+		ValueView val(ptr, end - ptr);
+		if (isKey) {
+			key = val.isBytes() ? StringView((const char *)val.getBytes().data(),
+										  val.getBytes().size())
+								: val.getString();
+		} else {
+			cb(key, val);
+		}
+		isKey = !isKey;
+	});
+}
+
+auto ValueView::getIndex() const -> const Index * {
+	if (auto index = _index.load(std::memory_order_acquire)) {
+		return index;
+	}
+
+	auto index = Rc<Index>::alloc();
+	auto isMap = isDictionary();
+
+	auto success = ValueView_foreachItem(_ptr, _size, [&](const uint8_t *ptr, const uint8_t *) {
+		index->offsets.emplace_back(uint32_t(ptr - _ptr));
+	});
+
+	if (!success || (isMap && (index->offsets.size() % 2) != 0)) {
+		return nullptr;
+	}
+
+	index->offsets.emplace_back(uint32_t(_size));
+
+	if (isMap) {
+		auto npairs = (index->offsets.size() - 1) / 2;
+		index->keys.reserve(npairs);
+		for (size_t i = 0; i < npairs; ++i) {
+			ValueView key(_ptr + index->offsets[i * 2],
+					index->offsets[i * 2 + 1] - index->offsets[i * 2]);
+			if (key.isString()) {
+				index->keys.emplace_back(key.getString(), uint32_t(i));
+			} else if (key.isBytes()) {
+				auto bytes = key.getBytes();
+				index->keys.emplace_back(StringView((const char *)bytes.data(), bytes.size()),
+						uint32_t(i));
+			}
+		}
+
+		// stable sort keeps first pair for duplicated keys, like Decoder does
+		std::stable_sort(index->keys.begin(), index->keys.end(),
+				[](const Pair<StringView, uint32_t> &l, const Pair<StringView, uint32_t> &r) {
+			return l.first < r.first;
+		});
+	}
+
+	// concurrent builder can publish its index first, then ours is dropped
+	Index *expected = nullptr;
+	index->retain();
+	if (!_index.compare_exchange_strong(expected, index.get(), std::memory_order_acq_rel,
+				std::memory_order_acquire)) {
+		index->release(0);
+		return expected;
+	}
+	return index.get();
+}
+
+} // namespace stappler::data
@@ -0,0 +1,133 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef STAPPLER_DATA_SPDATAVALUEVIEW_H_
+#define STAPPLER_DATA_SPDATAVALUEVIEW_H_
+
+#include "SPMemory.h" // IWYU pragma: keep
+#include "SPDataDecodeCbor.h"
+
+namespace STAPPLER_VERSIONIZED stappler::data {
+
+/* Read-only view over CBOR-encoded value
+ *
+ * View navigates encoded buffer in place: strings and bytes are returned as views into buffer,
+ * and nested values are not decoded unless requested. Offsets of array items and dictionary
+ * keys are indexed lazily on first indexed access, index is shared between copies of view,
+ * made after it was built. Index is published atomically, so, const view can be used from
+ * multiple threads.
+ *
+ * Offsets are 32-bit, buffers larger than 4 GiB are rejected by `read`.
+ * Buffer should outlive view and all views and StringViews, acquired from it.
+ * Indefinite-length strings are not contiguous in buffer, so, they are accessible only with
+ * `toValue`. Dictionary values with non-string keys are accessible only with `foreach`.
+ */
+class SP_PUBLIC ValueView {
+public:
+	using Type = ValueTemplate<memory::StandartInterface>::Type;
+
+	// Reads value from buffer with or without CBOR magic prefix (0xd9d9f7)
+	static ValueView read(BytesView);
+
+	ValueView() = default;
+	~ValueView();
+
+	ValueView(const ValueView &);
+	ValueView &operator=(const ValueView &);
+
+	Type getType() const;
+
+	bool isNull() const { return getType() == Type::EMPTY; }
+	bool isBasicType() const { return !isArray() && !isDictionary(); }
+	bool isArray() const { return getType() == Type::ARRAY; }
+	bool isDictionary() const { return getType() == Type::DICTIONARY; }
+	bool isBool() const { return getType() == Type::BOOLEAN; }
+	bool isInteger() const { return getType() == Type::INTEGER; }
+	bool isDouble() const { return getType() == Type::DOUBLE; }
+	bool isString() const { return getType() == Type::CHARSTRING; }
+	bool isBytes() const { return getType() == Type::BYTESTRING; }
+
+	explicit operator bool() const { return _ptr && !isNull(); }
+
+	// numeric and boolean values are converted like in Value
+	int64_t getInteger(int64_t def = 0) const;
+	double getDouble(double def = 0.0) const;
+	bool getBool() const;
+
+	StringView getString() const;
+	BytesView getBytes() const;
+
+	// number of items in array or dictionary
+	size_t size() const;
+	bool empty() const { return size() == 0; }
+
+	ValueView getValue(size_t) const;
+	ValueView getValue(StringView) const;
+	bool hasValue(StringView) const;
+
+	// key of n-th dictionary pair
+	StringView getKey(size_t) const;
+
+	// Sequential iteration, does not build index
+	void foreach(const Callback<void(const ValueView &)> &) const;
+	void foreach(const Callback<void(StringView, const ValueView &)> &) const;
+
+	// encoded value bytes, without prefix
+	BytesView getEncoded() const { return BytesView(_ptr, _size); }
+
+	template <typename Interface>
+	auto toValue() const -> ValueTemplate<Interface>;
+
+protected:
+	struct Index : public Ref {
+		// item offsets, for dictionary - interleaved key and value offsets, last - end of data
+		Vector<uint32_t> offsets;
+
+		// string keys, sorted for lookup, with number of pair in dictionary
+		Vector<Pair<StringView, uint32_t>> keys;
+	};
+
+	ValueView(const uint8_t *ptr, size_t size);
+
+	const Index *getIndex() const;
+
+	const uint8_t *_ptr = nullptr;
+	size_t _size = 0;
+
+	// owned reference to index, set once with compare-exchange
+	mutable std::atomic<Index *> _index = nullptr;
+};
+
+template <typename Interface>
+auto ValueView::toValue() const -> ValueTemplate<Interface> {
+	ValueTemplate<Interface> ret;
+	if (_ptr) {
+		BytesViewTemplate<sprt::endian::network> r(_ptr, _size);
+		cbor::Decoder<Interface> dec(r);
+		dec.decode(ret);
+	}
+	return ret;
+}
+
+} // namespace stappler::data
+
+#endif /* STAPPLER_DATA_SPDATAVALUEVIEW_H_ */
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "SPPqDriver.cc"
 #include "SPPqHandle.cc"
 #include "SPPqHandleInit.cc"
+#include "SPPqPipeline.cc"
 #include "SPSqlDriver.cc"
 #include "SPSqlHandle.cc"
 #include "SPSqlHandleObject.cc"
@@ -49,7 +49,9 @@ enum ExecStatusType {
 	PGRES_NONFATAL_ERROR,
 	PGRES_FATAL_ERROR,
 	PGRES_COPY_BOTH,
-	PGRES_SINGLE_TUPLE
+	PGRES_SINGLE_TUPLE,
+	PGRES_PIPELINE_SYNC,
+	PGRES_PIPELINE_ABORTED
 };
 
 enum PGTransactionStatusType {
@@ -104,6 +106,16 @@ struct DriverSym : AllocBase {
 	using PQgetResultType = void *(*)(void *conn);
 	using PQsetNoticeProcessorType = void (*)(void *conn, PQnoticeProcessor, void *);
 
+	// optional, pipeline mode (libpq 14+)
+	using PQsendQueryParamsType = int (*)(void *conn, const char *command, int nParams,
+			const void *paramTypes, const char *const *paramValues, const int *paramLengths,
+			const int *paramFormats, int resultFormat);
+	using PQenterPipelineModeType = int (*)(void *conn);
+	using PQexitPipelineModeType = int (*)(void *conn);
+	using PQpipelineSyncType = int (*)(void *conn);
+	using PQflushType = int (*)(void *conn);
+	using PQisnonblockingType = int (*)(const void *conn);
+
 	DriverSym(StringView n, Dso &&d) : name(n), ptr(move(d)) {
 		this->PQresultStatus = ptr.sym<DriverSym::PQresultStatusType>("PQresultStatus");
 		this->PQconnectdbParams = ptr.sym<DriverSym::PQconnectdbParamsType>("PQconnectdbParams");
@@ -138,10 +150,23 @@ struct DriverSym : AllocBase {
 		this->PQgetResult = ptr.sym<DriverSym::PQgetResultType>("PQgetResult");
 		this->PQsetNoticeProcessor =
 				ptr.sym<DriverSym::PQsetNoticeProcessorType>("PQsetNoticeProcessor");
+
+		this->PQsendQueryParams = ptr.sym<DriverSym::PQsendQueryParamsType>("PQsendQueryParams");
+		this->PQenterPipelineMode =
+				ptr.sym<DriverSym::PQenterPipelineModeType>("PQenterPipelineMode");
+		this->PQexitPipelineMode = ptr.sym<DriverSym::PQexitPipelineModeType>("PQexitPipelineMode");
+		this->PQpipelineSync = ptr.sym<DriverSym::PQpipelineSyncType>("PQpipelineSync");
+		this->PQflush = ptr.sym<DriverSym::PQflushType>("PQflush");
+		this->PQisnonblocking = ptr.sym<DriverSym::PQisnonblockingType>("PQisnonblocking");
 	}
 
 	~DriverSym() { }
 
+	bool isPipelineSupported() const {
+		return PQsendQueryParams && PQenterPipelineMode && PQexitPipelineMode && PQpipelineSync
+				&& PQflush && PQisnonblocking;
+	}
+
 	explicit operator bool() const {
 		void **begin = (void **)&this->PQconnectdbParams;
 		void **end = (void **)&this->PQsetNoticeProcessor + 1;
@@ -189,6 +214,15 @@ struct DriverSym : AllocBase {
 	PQisBusyType PQisBusy = nullptr;
 	PQgetResultType PQgetResult = nullptr;
 	PQsetNoticeProcessorType PQsetNoticeProcessor = nullptr;
+
+	// optional symbols, should not be checked in operator bool
+	PQsendQueryParamsType PQsendQueryParams = nullptr;
+	PQenterPipelineModeType PQenterPipelineMode = nullptr;
+	PQexitPipelineModeType PQexitPipelineMode = nullptr;
+	PQpipelineSyncType PQpipelineSync = nullptr;
+	PQflushType PQflush = nullptr;
+	PQisnonblockingType PQisnonblocking = nullptr;
+
 	uint32_t refCount = 1;
 };
 
@@ -534,6 +568,8 @@ Driver::Status Driver::getStatus(Result res) const {
 	case PGRES_FATAL_ERROR: return Driver::Status::FatalError; break;
 	case PGRES_COPY_BOTH: return Driver::Status::CopyBoth; break;
 	case PGRES_SINGLE_TUPLE: return Driver::Status::SingleTuple; break;
+	case PGRES_PIPELINE_SYNC: return Driver::Status::PipelineSync; break;
+	case PGRES_PIPELINE_ABORTED: return Driver::Status::PipelineAborted; break;
 	default: break;
 	}
 	return Driver::Status::Empty;
@@ -583,6 +619,8 @@ char *Driver::getStatusMessage(Status st) const {
 	case Status::FatalError: return _handle->PQresStatus(PGRES_FATAL_ERROR); break;
 	case Status::CopyBoth: return _handle->PQresStatus(PGRES_COPY_BOTH); break;
 	case Status::SingleTuple: return _handle->PQresStatus(PGRES_SINGLE_TUPLE); break;
+	case Status::PipelineSync: return _handle->PQresStatus(PGRES_PIPELINE_SYNC); break;
+	case Status::PipelineAborted: return _handle->PQresStatus(PGRES_PIPELINE_ABORTED); break;
 	}
 	return nullptr;
 }
@@ -615,6 +653,83 @@ Driver::Result Driver::exec(Connection conn, const char *command, int nParams,
 			paramLengths, paramFormats, resultFormat));
 }
 
+bool Driver::isPipelineSupported() const { return _handle->isPipelineSupported(); }
+
+bool Driver::enterPipelineMode(Connection conn) const {
+	if (!_handle->isPipelineSupported()) {
+		return false;
+	}
+	return _handle->PQenterPipelineMode(conn.get()) == 1;
+}
+
+bool Driver::exitPipelineMode(Connection conn) const {
+	if (!_handle->isPipelineSupported()) {
+		return false;
+	}
+	return _handle->PQexitPipelineMode(conn.get()) == 1;
+}
+
+bool Driver::pipelineSync(Connection conn) const {
+	if (!_handle->isPipelineSupported()) {
+		return false;
+	}
+	return _handle->PQpipelineSync(conn.get()) == 1;
+}
+
+bool Driver::send(Connection conn, const char *command, int nParams, const char *const *paramValues,
+		const int *paramLengths, const int *paramFormats, int resultFormat) const {
+	if (!_handle->PQsendQueryParams) {
+		return false;
+	}
+	return _handle->PQsendQueryParams(conn.get(), command, nParams, nullptr, paramValues,
+				   paramLengths, paramFormats, resultFormat)
+			== 1;
+}
+
+Driver::Result Driver::getResult(Connection conn) const {
+	auto res = _handle->PQgetResult(conn.get());
+	if (res && _dbCtrl) {
+		// paired with clearResult
+		_dbCtrl(false);
+	}
+	return Driver::Result(res);
+}
+
+int Driver::flush(Connection conn) const {
+	if (!_handle->PQflush) {
+		return -1;
+	}
+	return _handle->PQflush(conn.get());
+}
+
+bool Driver::consumeInput(Connection conn) const {
+	return _handle->PQconsumeInput(conn.get()) == 1;
+}
+
+bool Driver::isBusy(Connection conn) const { return _handle->PQisBusy(conn.get()) != 0; }
+
+bool Driver::isNonBlocking(Connection conn) const {
+	if (!_handle->PQisnonblocking) {
+		return false;
+	}
+	return _handle->PQisnonblocking(conn.get()) != 0;
+}
+
+bool Driver::setNonBlocking(Connection conn, bool value) const {
+	return _handle->PQsetnonblocking(conn.get(), value ? 1 : 0) == 0;
+}
+
+bool Driver::resetConnection(Connection conn) const {
+	_handle->PQreset(conn.get());
+	return _handle->PQstatus(conn.get()) == CONNECTION_OK;
+}
+
+int Driver::getSocket(Connection conn) const { return _handle->PQsocket(conn.get()); }
+
+char *Driver::getConnectionErrorMessage(Connection conn) const {
+	return _handle->PQerrorMessage(conn.get());
+}
+
 BackendInterface::StorageType Driver::getTypeById(uint32_t oid) const {
 	auto it = std::lower_bound(_storageTypes.begin(), _storageTypes.end(), oid,
 			[](const sprt::pair<uint32_t, BackendInterface::StorageType> &l, uint32_t r) -> bool {
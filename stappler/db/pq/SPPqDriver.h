@@ -43,6 +43,8 @@ public:
 		FatalError,
 		CopyBoth,
 		SingleTuple,
+		PipelineSync,
+		PipelineAborted,
 	};
 
 	enum class TransactionStatus {
@@ -105,6 +107,37 @@ public:
 	Result exec(Connection conn, const char *command, int nParams, const char *const *paramValues,
 			const int *paramLengths, const int *paramFormats, int resultFormat) const;
 
+	// Pipeline mode and non-blocking execution, see pq::Pipeline
+	// Pipeline mode is available only with libpq 14+
+	bool isPipelineSupported() const;
+
+	bool enterPipelineMode(Connection) const;
+	bool exitPipelineMode(Connection) const;
+	bool pipelineSync(Connection) const;
+
+	// Queues query without waiting for result, use getResult to read results
+	bool send(Connection conn, const char *command, int nParams, const char *const *paramValues,
+			const int *paramLengths, const int *paramFormats, int resultFormat) const;
+
+	// Returns nullptr when all results for the current query was read
+	Result getResult(Connection) const;
+
+	// 0 - all data was sent, 1 - should wait for the socket to be writable, -1 on error
+	int flush(Connection) const;
+
+	bool consumeInput(Connection) const;
+	bool isBusy(Connection) const;
+
+	bool isNonBlocking(Connection) const;
+	bool setNonBlocking(Connection, bool) const;
+
+	// Reconnects with the same parameters, drops pipeline and server-side session state
+	bool resetConnection(Connection) const;
+
+	int getSocket(Connection) const;
+
+	char *getConnectionErrorMessage(Connection) const;
+
 	explicit operator bool() const { return _handle != nullptr; }
 
 	BackendInterface::StorageType getTypeById(uint32_t) const;
@@ -399,13 +399,31 @@ Handle::Handle(const Driver *d, Driver::Handle h) : SqlHandle(d), driver(d), han
 	}
 }
 
+Handle *Handle::get(const db::Transaction &t) {
+	if (!t) {
+		return nullptr;
+	}
+	return dynamic_cast<Handle *>(t.getAdapter().getBackendInterface());
+}
+
+Handle::~Handle() {
+	if (asyncPipeline) {
+		asyncPipeline->cancel();
+	}
+}
+
 Handle::operator bool() const { return conn.get() != nullptr; }
 
 Driver::Handle Handle::getHandle() const { return handle; }
 
 Driver::Connection Handle::getConnection() const { return conn; }
 
-void Handle::close() { conn = Driver::Connection(nullptr); }
+void Handle::close() {
+	if (asyncPipeline) {
+		asyncPipeline->cancel();
+	}
+	conn = Driver::Connection(nullptr);
+}
 
 void Handle::makeQuery(const stappler::Callback<void(sql::SqlQuery &)> &cb,
 		const sql::QueryStorageHandle *s) {
@@ -417,7 +435,8 @@ void Handle::makeQuery(const stappler::Callback<void(sql::SqlQuery &)> &cb,
 bool Handle::selectQuery(const sql::SqlQuery &query,
 		const stappler::Callback<bool(sql::Result &)> &cb,
 		const Callback<void(const Value &)> &errCb) {
-	if (!conn.get() || getTransactionStatus() == db::TransactionStatus::Rollback) {
+	if (!conn.get() || isPipelineRunning()
+			|| getTransactionStatus() == db::TransactionStatus::Rollback) {
 		return false;
 	}
 
@@ -450,7 +469,7 @@ bool Handle::selectQuery(const sql::SqlQuery &query,
 
 bool Handle::performSimpleQuery(const StringView &query,
 		const Callback<void(const Value &)> &errCb) {
-	if (getTransactionStatus() == db::TransactionStatus::Rollback) {
+	if (isPipelineRunning() || getTransactionStatus() == db::TransactionStatus::Rollback) {
 		return false;
 	}
 
@@ -476,7 +495,7 @@ bool Handle::performSimpleQuery(const StringView &query,
 bool Handle::performSimpleSelect(const StringView &query,
 		const stappler::Callback<void(sql::Result &)> &cb,
 		const Callback<void(const Value &)> &errCb) {
-	if (getTransactionStatus() == db::TransactionStatus::Rollback) {
+	if (isPipelineRunning() || getTransactionStatus() == db::TransactionStatus::Rollback) {
 		return false;
 	}
 
@@ -507,6 +526,69 @@ bool Handle::performSimpleSelect(const StringView &query,
 
 bool Handle::isSuccess() const { return ResultCursor::pgsql_is_success(lastError); }
 
+bool Handle::performPipeline(const Callback<void(Pipeline &)> &cb) {
+	if (!conn.get() || isPipelineRunning()
+			|| getTransactionStatus() == db::TransactionStatus::Rollback) {
+		return false;
+	}
+
+	auto pipeline = Rc<Pipeline>::create(driver, conn);
+	if (!pipeline) {
+		return false;
+	}
+
+	cb(*pipeline);
+
+	if (pipeline->empty()) {
+		return true;
+	}
+
+	auto ret = pipeline->perform();
+	lastError = pipeline->getLastError();
+	if (!ret) {
+		cancelTransaction_pg();
+	}
+	return ret;
+}
+
+#if MODULE_STAPPLER_EVENT
+bool Handle::performPipelineAsync(event::Looper *looper, const Callback<void(Pipeline &)> &cb,
+		Pipeline::CompleteCallback &&complete) {
+	if (!conn.get() || isPipelineRunning()
+			|| getTransactionStatus() == db::TransactionStatus::Rollback) {
+		return false;
+	}
+
+	auto pipeline = Rc<Pipeline>::create(driver, conn);
+	if (!pipeline) {
+		return false;
+	}
+
+	cb(*pipeline);
+
+	if (pipeline->empty()) {
+		return false;
+	}
+
+	asyncPipeline = pipeline;
+	auto ret = pipeline->performAsync(looper,
+			[this, complete = sp::move(complete)](Pipeline *p, bool success) {
+		asyncPipeline = nullptr;
+		lastError = p->getLastError();
+		if (!success) {
+			cancelTransaction_pg();
+		}
+		if (complete) {
+			complete(p, success);
+		}
+	});
+	if (!ret) {
+		asyncPipeline = nullptr;
+	}
+	return ret;
+}
+#endif
+
 bool Handle::beginTransaction_pg(TransactionLevel l) {
 	int64_t userId = _driver->getApplicationInterface()->getUserIdFromContext();
 	int64_t now = stappler::Time::now().toMicros();
@@ -516,38 +598,43 @@ bool Handle::beginTransaction_pg(TransactionLevel l) {
 		return false;
 	}
 
-	auto setVariables = [&, this] {
-		performSimpleQuery(toString("SET LOCAL serenity.\"user\" = ", userId,
-				";SET LOCAL serenity.\"now\" = ", now, ";"));
-	};
-
+	StringView beginQuery;
 	switch (l) {
 	case TransactionLevel::ReadCommited:
-		if (performSimpleQuery("BEGIN ISOLATION LEVEL READ COMMITTED")) {
-			setVariables();
-			level = TransactionLevel::ReadCommited;
-			transactionStatus = db::TransactionStatus::Commit;
-			return true;
-		}
+		beginQuery = "BEGIN ISOLATION LEVEL READ COMMITTED";
 		break;
 	case TransactionLevel::RepeatableRead:
-		if (performSimpleQuery("BEGIN ISOLATION LEVEL REPEATABLE READ")) {
-			setVariables();
-			level = TransactionLevel::RepeatableRead;
-			transactionStatus = db::TransactionStatus::Commit;
-			return true;
-		}
+		beginQuery = "BEGIN ISOLATION LEVEL REPEATABLE READ";
 		break;
 	case TransactionLevel::Serialized:
-		if (performSimpleQuery("BEGIN ISOLATION LEVEL SERIALIZABLE")) {
-			setVariables();
-			level = TransactionLevel::Serialized;
-			transactionStatus = db::TransactionStatus::Commit;
-			return true;
-		}
+		beginQuery = "BEGIN ISOLATION LEVEL SERIALIZABLE";
 		break;
 	default: break;
 	}
+
+	if (beginQuery.empty()) {
+		return false;
+	}
+
+	bool started = false;
+	if (driver->isPipelineSupported()) {
+		// BEGIN and session variables in a single round trip
+		performPipeline([&](Pipeline &pipeline) {
+			pipeline.add(beginQuery, [&](sql::Result &) { started = true; });
+			pipeline.add(toString("SET LOCAL serenity.\"user\" = ", userId));
+			pipeline.add(toString("SET LOCAL serenity.\"now\" = ", now));
+		});
+	} else if (performSimpleQuery(beginQuery)) {
+		performSimpleQuery(toString("SET LOCAL serenity.\"user\" = ", userId,
+				";SET LOCAL serenity.\"now\" = ", now, ";"));
+		started = true;
+	}
+
+	if (started) {
+		level = l;
+		transactionStatus = db::TransactionStatus::Commit;
+		return true;
+	}
 	return false;
 }
 
@@ -25,8 +25,10 @@ THE SOFTWARE.
 #define STAPPLER_DB_PQ_SPPGHANDLE_H_
 
 #include "SPPqDriver.h"
+#include "SPPqPipeline.h"
 #include "SPSqlHandle.h"
 #include "SPDbScheme.h"
+#include "SPDbTransaction.h"
 
 namespace STAPPLER_VERSIONIZED stappler::db::pq {
 
@@ -38,7 +40,11 @@ enum class TransactionLevel {
 
 class SP_PUBLIC Handle final : public db::sql::SqlHandle {
 public:
+	// PostgreSQL handle, used by the transaction, or nullptr for other backends
+	static Handle *get(const db::Transaction &);
+
 	Handle(const Driver *, Driver::Handle);
+	virtual ~Handle();
 
 	Handle(const Handle &) = delete;
 	Handle &operator=(const Handle &) = delete;
@@ -66,6 +72,19 @@ public:
 
 	virtual bool isSuccess() const override;
 
+	// Sends all statements, added in callback, in a single round trip (see pq::Pipeline)
+	bool performPipeline(const Callback<void(Pipeline &)> &);
+
+#if MODULE_STAPPLER_EVENT
+	// Non-blocking version of performPipeline: results are read on the looper's thread.
+	// Handle rejects other queries until completion. Transaction is cancelled on failure.
+	// Returns false if pipeline can not be started; completion callback is not called then
+	bool performPipelineAsync(event::Looper *, const Callback<void(Pipeline &)> &,
+			Pipeline::CompleteCallback && = nullptr);
+#endif
+
+	bool isPipelineRunning() const { return asyncPipeline && asyncPipeline->isRunning(); }
+
 	void close();
 
 public: // adapter interface
@@ -87,6 +106,7 @@ protected:
 	Driver::Status lastError = Driver::Status::Empty;
 	Value lastErrorInfo;
 	TransactionLevel level = TransactionLevel::ReadCommited;
+	Rc<Pipeline> asyncPipeline;
 };
 
 class SP_PUBLIC PgQueryInterface : public db::QueryInterface {
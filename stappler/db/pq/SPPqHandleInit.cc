@@ -1087,6 +1087,9 @@ static void Handle_insert_sorted(Vector<sprt::pair<StringView, int64_t>> &vec, S
 }
 
 bool Handle::init(const BackendInterface::Config &cfg, const Map<StringView, const Scheme *> &s) {
+	// cached select-lists can refer to the previous scheme definitions
+	driver->clearSelectShapes();
+
 	if (!performSimpleQuery(StringView(DATABASE_DEFAULTS))) {
 		return false;
 	}
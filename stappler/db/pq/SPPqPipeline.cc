@@ -0,0 +1,415 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "SPPqPipeline.h"
+#include "SPPqHandle.h"
+
+namespace STAPPLER_VERSIONIZED stappler::db::pq {
+
+Pipeline::~Pipeline() {
+	if (_pool) {
+		memory::pool::destroy(_pool);
+		_pool = nullptr;
+	}
+}
+
+bool Pipeline::init(const Driver *driver, Driver::Connection conn) {
+	if (!driver || !conn.get()) {
+		return false;
+	}
+
+	_driver = driver;
+	_conn = conn;
+	_pool = memory::pool::create();
+	return true;
+}
+
+void Pipeline::add(const sql::SqlQuery &query, ResultCallback &&cb) {
+	auto queryInterface = static_cast<PgQueryInterface *>(query.getInterface());
+	auto text = query.getQuery().weak();
+
+	auto &st = _statements.emplace_back(Statement());
+	st.query = mem_std::String(text.data(), text.size());
+	st.params.reserve(queryInterface->params.size());
+	st.formats.reserve(queryInterface->params.size());
+	for (size_t i = 0; i < queryInterface->params.size(); ++i) {
+		auto &d = queryInterface->params.at(i);
+		st.params.emplace_back(mem_std::Bytes(d.data(), d.data() + d.size()));
+		st.formats.emplace_back(queryInterface->binary.at(i) ? 1 : 0);
+	}
+	st.callback = sp::move(cb);
+}
+
+void Pipeline::add(StringView query, ResultCallback &&cb) {
+	auto &st = _statements.emplace_back(Statement());
+	st.query = mem_std::String(query.data(), query.size());
+	st.callback = sp::move(cb);
+}
+
+bool Pipeline::perform() {
+	if (_running || _statements.empty()) {
+		return false;
+	}
+
+	bool ret = true;
+	_connectionReset = false;
+	mem_pool::perform([&, this] {
+		if (!_driver->isPipelineSupported()) {
+			// execute statements one by one, abort on first failure, like pipeline do
+			_running = true;
+			_success = true;
+			for (auto &it : _statements) {
+				if (!execStatement(it)) {
+					break;
+				}
+			}
+			finalize(_success);
+			ret = _success;
+			return;
+		}
+
+		if (!begin()) {
+			ret = false;
+			return;
+		}
+
+		size_t nullResults = 0;
+		while (!_synced) {
+			auto res = _driver->getResult(_conn);
+			if (!res.get()) {
+				// results for every statement ends with nullptr; two in a row means,
+				// that there is nothing to wait for
+				if (++nullResults > 1 || _current >= _statements.size()) {
+					_success = false;
+					break;
+				}
+				++_current;
+			} else {
+				nullResults = 0;
+				processResult(res);
+			}
+		}
+
+		finalize(_success && _synced);
+		ret = _success;
+	}, _pool);
+	memory::pool::clear(_pool);
+
+	return ret;
+}
+
+#if MODULE_STAPPLER_EVENT
+bool Pipeline::performAsync(event::Looper *looper, CompleteCallback &&cb) {
+	if (_running || _statements.empty() || !looper) {
+		return false;
+	}
+
+	if (!_driver->isPipelineSupported()) {
+		log::source().error("pq::Pipeline", "libpq pipeline mode is not supported");
+		return false;
+	}
+
+	auto socket = _driver->getSocket(_conn);
+	if (socket < 0) {
+		log::source().error("pq::Pipeline", "Invalid connection socket");
+		return false;
+	}
+
+	_wasNonBlocking = _driver->isNonBlocking(_conn);
+	if (!_wasNonBlocking && !_driver->setNonBlocking(_conn, true)) {
+		log::source().error("pq::Pipeline", _driver->getConnectionErrorMessage(_conn));
+		return false;
+	}
+
+	_async = true;
+	_connectionReset = false;
+
+	if (!begin()) {
+		return false;
+	}
+
+	auto flush = _driver->flush(_conn);
+	if (flush < 0) {
+		log::source().error("pq::Pipeline", _driver->getConnectionErrorMessage(_conn));
+		finalize(false);
+		return false;
+	}
+
+	_flushing = (flush == 1);
+	_complete = sp::move(cb);
+
+	_pollHandle = looper->listenPollableHandle((event::NativeHandle)socket,
+			_flushing ? (event::PollFlags::In | event::PollFlags::Out) : event::PollFlags::In,
+			[this](event::NativeHandle, event::PollFlags flags) -> Status { return onPoll(flags); },
+			this);
+
+	if (!_pollHandle) {
+		log::source().error("pq::Pipeline", "Fail to listen connection socket");
+		_complete = nullptr;
+		finalize(false);
+		return false;
+	}
+
+	return true;
+}
+
+#endif
+
+void Pipeline::cancel() {
+	if (!_running) {
+		return;
+	}
+
+	Rc<Pipeline> ref(this); // completion can release pipeline
+
+#if MODULE_STAPPLER_EVENT
+	if (_pollHandle) {
+		_pollHandle->cancel();
+		_pollHandle = nullptr;
+	}
+#endif
+
+	finalize(false);
+}
+
+bool Pipeline::begin() {
+	_running = true;
+	_synced = false;
+	_success = true;
+	_current = 0;
+	_lastError = Driver::Status::Empty;
+
+	if (!_driver->enterPipelineMode(_conn)) {
+		log::source().error("pq::Pipeline", "Fail to enter pipeline mode: ",
+				_driver->getConnectionErrorMessage(_conn));
+		restoreConnection();
+		_running = false;
+		return false;
+	}
+
+	_pipelineMode = true;
+
+	for (auto &it : _statements) {
+		if (!sendStatement(it)) {
+			log::source().error("pq::Pipeline", "Fail to send query: ",
+					_driver->getConnectionErrorMessage(_conn));
+			// results for the statements, that was sent, should still be read before sync
+			_success = false;
+			break;
+		}
+	}
+
+	if (!_driver->pipelineSync(_conn)) {
+		log::source().error("pq::Pipeline", "Fail to sync pipeline: ",
+				_driver->getConnectionErrorMessage(_conn));
+		restoreConnection();
+		_running = false;
+		return false;
+	}
+
+	return true;
+}
+
+static void Pipeline_writeParams(const mem_std::Vector<mem_std::Bytes> &params,
+		mem_std::Vector<const char *> &values, mem_std::Vector<int> &sizes) {
+	values.reserve(params.size());
+	sizes.reserve(params.size());
+	for (auto &it : params) {
+		values.emplace_back((const char *)it.data());
+		sizes.emplace_back(int(it.size()));
+	}
+}
+
+bool Pipeline::sendStatement(const Statement &st) {
+	mem_std::Vector<const char *> values;
+	mem_std::Vector<int> sizes;
+	Pipeline_writeParams(st.params, values, sizes);
+
+	return _driver->send(_conn, st.query.data(), int(st.params.size()), values.data(),
+			sizes.data(), st.formats.data(), 1);
+}
+
+bool Pipeline::execStatement(const Statement &st) {
+	mem_std::Vector<const char *> values;
+	mem_std::Vector<int> sizes;
+	Pipeline_writeParams(st.params, values, sizes);
+
+	processResult(_driver->exec(_conn, st.query.data(), int(st.params.size()), values.data(),
+			sizes.data(), st.formats.data(), 1));
+	++_current;
+	return _success;
+}
+
+void Pipeline::processResult(Driver::Result res) {
+	auto status = _driver->getStatus(res);
+	if (status == Driver::Status::PipelineSync) {
+		_driver->clearResult(res);
+		_synced = true;
+		return;
+	}
+
+	ResultCursor cursor(_driver, res);
+	if (_current >= _statements.size()) {
+		_success = false;
+		return;
+	}
+
+	auto &st = _statements[_current];
+	if (status == Driver::Status::PipelineAborted) {
+		// previous statement failed, error was already reported
+		_success = false;
+	} else if (!cursor.isSuccess()) {
+		_success = false;
+		_lastError = cursor.getError();
+
+		auto info = cursor.getInfo();
+		info.setString(StringView(st.query), "query");
+#if DEBUG
+		log::source().debug("pq::Pipeline", EncodeFormat::Pretty, info);
+#endif
+		_driver->getApplicationInterface()->debug("Database", "Fail to perform query",
+				sp::move(info));
+		_driver->getApplicationInterface()->error("Database", "Fail to perform query");
+	} else {
+		_lastError = cursor.getError();
+		if (st.callback) {
+			sql::Result ret(&cursor);
+			st.callback(ret);
+		}
+	}
+}
+
+#if MODULE_STAPPLER_EVENT
+bool Pipeline::readAvailable() {
+	if (!_driver->consumeInput(_conn)) {
+		log::source().error("pq::Pipeline", _driver->getConnectionErrorMessage(_conn));
+		_success = false;
+		return false;
+	}
+
+	mem_pool::perform([&, this] {
+		size_t nullResults = 0;
+		while (!_synced && !_driver->isBusy(_conn)) {
+			auto res = _driver->getResult(_conn);
+			if (!res.get()) {
+				if (++nullResults > 1) {
+					// wait for more input
+					break;
+				}
+				++_current;
+			} else {
+				nullResults = 0;
+				processResult(res);
+			}
+		}
+	}, _pool);
+	memory::pool::clear(_pool);
+
+	return true;
+}
+
+Status Pipeline::onPoll(event::PollFlags flags) {
+	Rc<Pipeline> ref(this); // completion can release pipeline
+
+	if (!_running) {
+		return Status::Done;
+	}
+
+	if (hasFlag(flags, event::PollFlags::Err)) {
+		log::source().error("pq::Pipeline", "Connection socket error");
+		_pollHandle = nullptr;
+		finalize(false);
+		return Status::ErrorCancelled;
+	}
+
+	if (_flushing && hasFlag(flags, event::PollFlags::Out)) {
+		auto flush = _driver->flush(_conn);
+		if (flush < 0) {
+			log::source().error("pq::Pipeline", _driver->getConnectionErrorMessage(_conn));
+			_pollHandle = nullptr;
+			finalize(false);
+			return Status::ErrorCancelled;
+		} else if (flush == 0) {
+			_flushing = false;
+			if (!_pollHandle->reset(event::PollFlags::In)) {
+				// keep listening for both, writable state will be ignored
+				log::source().warn("pq::Pipeline", "Fail to reset poll flags");
+			}
+		}
+	}
+
+	if (hasFlag(flags, event::PollFlags::In) || hasFlag(flags, event::PollFlags::HungUp)) {
+		if (!readAvailable()) {
+			_pollHandle = nullptr;
+			finalize(false);
+			return Status::ErrorCancelled;
+		}
+
+		if (_synced) {
+			_pollHandle = nullptr;
+			finalize(_success);
+			return Status::Done;
+		}
+	}
+
+	return Status::Ok;
+}
+
+#endif
+
+void Pipeline::restoreConnection() {
+	if (_pipelineMode) {
+		// pipeline mode can be exited only when all results was read, otherwise pending
+		// results can only be dropped with the connection itself
+		if (!_synced || !_driver->exitPipelineMode(_conn)) {
+			log::source().warn("pq::Pipeline", "Pipeline was not completed, reset connection");
+			_connectionReset = true;
+			if (!_driver->resetConnection(_conn)) {
+				log::source().error("pq::Pipeline", "Fail to reset connection: ",
+						_driver->getConnectionErrorMessage(_conn));
+			}
+			_driver->exitPipelineMode(_conn);
+		}
+		_pipelineMode = false;
+	}
+
+	if (_async && !_wasNonBlocking) {
+		_driver->setNonBlocking(_conn, false);
+	}
+	_async = false;
+}
+
+void Pipeline::finalize(bool success) {
+	restoreConnection();
+
+	_running = false;
+	_flushing = false;
+	_statements.clear();
+
+	auto complete = sp::move(_complete);
+	_complete = nullptr;
+	if (complete) {
+		complete(this, success);
+	}
+}
+
+} // namespace stappler::db::pq
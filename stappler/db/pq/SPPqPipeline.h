@@ -0,0 +1,133 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef STAPPLER_DB_PQ_SPPQPIPELINE_H_
+#define STAPPLER_DB_PQ_SPPQPIPELINE_H_
+
+#include "SPPqDriver.h"
+#include "SPSqlQuery.h"
+
+#if MODULE_STAPPLER_EVENT
+#include "SPEventLooper.h"
+#include "SPEventPollHandle.h"
+#endif
+
+namespace STAPPLER_VERSIONIZED stappler::db::pq {
+
+/* Batch of statements, sent to the server in a single round trip with libpq pipeline mode.
+ *
+ * Statements are copied on `add`, so source queries can be reused or destroyed after that.
+ * Results are dispatched to the statement callbacks in the order of addition. When one statement
+ * fails, all statements after it are aborted by the server, and their callbacks are not called.
+ *
+ * Only one SQL command per statement is allowed in pipeline mode.
+ *
+ * `perform` blocks until all results are received. `performAsync` uses non-blocking connection
+ * and polls its socket with event::Looper; result and completion callbacks are called on the
+ * looper's thread. Connection should not be used by anyone else until completion.
+ * `performAsync` is available only when stappler_event module is linked.
+ *
+ * When pipeline can not be completed normally (socket error, `cancel`), connection is restored
+ * to blocking non-pipeline mode. If unread results remain, the only way to do this is to reset
+ * the connection, so server-side session state (including open transaction) is lost;
+ * `isConnectionReset` reports this case.
+ */
+class SP_PUBLIC Pipeline : public Ref {
+public:
+	using ResultCallback = mem_std::Function<void(sql::Result &)>;
+	using CompleteCallback = mem_std::Function<void(Pipeline *, bool success)>;
+
+	virtual ~Pipeline();
+
+	bool init(const Driver *, Driver::Connection);
+
+	void add(const sql::SqlQuery &, ResultCallback && = nullptr);
+	void add(StringView, ResultCallback && = nullptr);
+
+	// Without pipeline support in libpq, statements are executed one by one
+	bool perform();
+
+#if MODULE_STAPPLER_EVENT
+	// Returns false if pipeline can not be started; completion callback is not called in this case
+	// Requires libpq pipeline support
+	bool performAsync(event::Looper *, CompleteCallback &&);
+#endif
+
+	// Stops async execution, completion callback is called with failure
+	void cancel();
+
+	bool empty() const { return _statements.empty(); }
+	size_t size() const { return _statements.size(); }
+
+	bool isRunning() const { return _running; }
+	bool isConnectionReset() const { return _connectionReset; }
+
+	Driver::Status getLastError() const { return _lastError; }
+
+protected:
+	struct Statement {
+		mem_std::String query;
+		mem_std::Vector<mem_std::Bytes> params;
+		mem_std::Vector<int> formats;
+		ResultCallback callback;
+	};
+
+	bool begin();
+	bool sendStatement(const Statement &);
+	bool execStatement(const Statement &);
+
+	void processResult(Driver::Result);
+
+#if MODULE_STAPPLER_EVENT
+	bool readAvailable();
+	Status onPoll(event::PollFlags);
+#endif
+
+	void restoreConnection();
+	void finalize(bool success);
+
+	const Driver *_driver = nullptr;
+	Driver::Connection _conn = Driver::Connection(nullptr);
+	pool_t *_pool = nullptr;
+
+	mem_std::Vector<Statement> _statements;
+	size_t _current = 0;
+
+	bool _running = false;
+	bool _synced = false;
+	bool _success = true;
+	bool _flushing = false;
+	bool _async = false;
+	bool _wasNonBlocking = false;
+	bool _pipelineMode = false;
+	bool _connectionReset = false;
+	Driver::Status _lastError = Driver::Status::Empty;
+
+#if MODULE_STAPPLER_EVENT
+	Rc<event::PollHandle> _pollHandle;
+#endif
+	CompleteCallback _complete;
+};
+
+} // namespace stappler::db::pq
+
+#endif /* STAPPLER_DB_PQ_SPPQPIPELINE_H_ */
@@ -30,6 +30,45 @@ namespace STAPPLER_VERSIONIZED stappler::db::sql {
 
 thread_local std::map<StringView, Map<StringView, const void *>> tl_DriverQueryStorage;
 
+struct DriverSelectShapes {
+	uint64_t driver = 0; // id of the driver, address of destroyed driver can be reused
+	uint64_t generation = 0;
+	std::map<std::string, Driver::SelectShape, std::less<void>> shapes;
+};
+
+struct DriverSelectShapesCache {
+	uint64_t released = 0; // s_releasedDrivers value on last cleanup
+	std::map<const Driver *, DriverSelectShapes> drivers;
+};
+
+// Ids and generations are taken from the same counter, so they are unique across drivers
+static std::atomic<uint64_t> s_selectShapesGeneration = 1;
+
+// Drivers can be destroyed on any thread, so every thread drops shapes of destroyed drivers
+// from its own cache on the next access, after s_releasedDrivers was changed
+static std::mutex s_liveDriversMutex;
+static std::set<uint64_t> s_liveDrivers;
+static std::atomic<uint64_t> s_releasedDrivers = 0;
+
+thread_local DriverSelectShapesCache tl_DriverSelectShapes;
+
+static std::map<const Driver *, DriverSelectShapes> &Driver_getSelectShapes() {
+	auto &cache = tl_DriverSelectShapes;
+	auto released = s_releasedDrivers.load(std::memory_order_acquire);
+	if (cache.released != released) {
+		std::unique_lock lock(s_liveDriversMutex);
+		for (auto it = cache.drivers.begin(); it != cache.drivers.end();) {
+			if (s_liveDrivers.find(it->second.driver) == s_liveDrivers.end()) {
+				it = cache.drivers.erase(it);
+			} else {
+				++it;
+			}
+		}
+		cache.released = released;
+	}
+	return cache.drivers;
+}
+
 QueryStorageHandle::QueryStorageHandle(const Driver *d, StringView n,
 		Map<StringView, const void *> *dt)
 : driver(d), name(n), data(dt) { }
@@ -72,7 +111,13 @@ Driver *Driver::open(pool_t *pool, ApplicationInterface *app, StringView path,
 	return ret;
 }
 
-Driver::~Driver() { }
+Driver::~Driver() {
+	tl_DriverSelectShapes.drivers.erase(this);
+
+	std::unique_lock lock(s_liveDriversMutex);
+	s_liveDrivers.erase(_selectShapesId);
+	s_releasedDrivers.fetch_add(1, std::memory_order_release);
+}
 
 void Driver::setDbCtrl(Function<void(bool)> &&fn) { _dbCtrl = sp::move(fn); }
 
@@ -119,12 +164,58 @@ Map<StringView, const void *> *Driver::registerQueryStorage(StringView name) con
 
 void Driver::unregisterQueryStorage(StringView name) const { tl_DriverQueryStorage.erase(name); }
 
-Driver::Driver(pool_t *p, ApplicationInterface *app) : _pool(p), _application(app) {
+auto Driver::getSelectShape(StringView signature) const -> const SelectShape * {
+	auto &drivers = Driver_getSelectShapes();
+	auto it = drivers.find(this);
+	if (it == drivers.end()) {
+		return nullptr;
+	}
+
+	if (it->second.driver != _selectShapesId
+			|| it->second.generation != _selectShapesGeneration.load(std::memory_order_relaxed)) {
+		drivers.erase(it);
+		return nullptr;
+	}
+
+	auto shapeIt = it->second.shapes.find(signature);
+	if (shapeIt != it->second.shapes.end()) {
+		return &shapeIt->second;
+	}
+	return nullptr;
+}
+
+auto Driver::storeSelectShape(StringView signature, SelectShape &&shape) const
+		-> const SelectShape * {
+	auto &cache = Driver_getSelectShapes()[this];
+	auto generation = _selectShapesGeneration.load(std::memory_order_relaxed);
+	if (cache.driver != _selectShapesId || cache.generation != generation
+			|| cache.shapes.size() >= SelectShapeCacheLimit) {
+		// shapes are cheap to rebuild, so just start over instead of tracking usage
+		cache.shapes.clear();
+		cache.driver = _selectShapesId;
+		cache.generation = generation;
+	}
+	return &cache.shapes
+					.insert_or_assign(std::string(signature.data(), signature.size()),
+							sp::move(shape))
+					.first->second;
+}
+
+void Driver::clearSelectShapes() const {
+	_selectShapesGeneration.store(s_selectShapesGeneration.fetch_add(1), std::memory_order_relaxed);
+}
+
+Driver::Driver(pool_t *p, ApplicationInterface *app)
+: _pool(p), _application(app), _selectShapesId(s_selectShapesGeneration.fetch_add(1))
+, _selectShapesGeneration(_selectShapesId) {
 	if (!app) {
 		auto mem = pool::palloc(_pool, sizeof(ApplicationInterface));
 
 		_application = new (mem) ApplicationInterface;
 	}
+
+	std::unique_lock lock(s_liveDriversMutex);
+	s_liveDrivers.emplace(_selectShapesId);
 }
 
 } // namespace stappler::db::sql
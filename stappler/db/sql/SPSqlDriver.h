@@ -93,6 +93,23 @@ public:
 	Map<StringView, const void *> *getQueryStorage(StringView) const;
 	Map<StringView, const void *> *getCurrentQueryStorage() const;
 
+	// Pre-rendered select-list for a field resolution shape: scheme, worker's required fields and
+	// query includes/excludes. Shapes are keyed with scheme names, versions and field names and
+	// cached per thread, so only values are rendered for repeated queries with the same shape
+	struct SelectShape {
+		std::string fields;
+		std::vector<std::string> virtuals;
+	};
+
+	static constexpr size_t SelectShapeCacheLimit = 1'024;
+
+	// Returned shape is valid until next storeSelectShape or clearSelectShapes on this thread
+	const SelectShape *getSelectShape(StringView signature) const;
+	const SelectShape *storeSelectShape(StringView signature, SelectShape &&) const;
+
+	// drops shapes in all threads, called when schemes are (re)defined
+	void clearSelectShapes() const;
+
 protected:
 	friend struct QueryStorageHandle;
 
@@ -107,6 +124,9 @@ protected:
 	ApplicationInterface *_application = nullptr;
 
 	Map<StringView, CustomFieldInfo> _customFields;
+
+	uint64_t _selectShapesId = 0;
+	mutable std::atomic<uint64_t> _selectShapesGeneration;
 };
 
 }
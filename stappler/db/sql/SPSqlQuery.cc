@@ -194,6 +194,117 @@ static inline auto SqlQuery_makeWhereClause(const Driver *driver, SqlQuery::Cont
 	}
 }
 
+// Signature covers everything FieldResolver::readFields depends on, but not the query values;
+// schemes and fields are written by names, so signature is valid for any equal scheme definition
+static StringView SqlQuery_makeSelectShapeSignature(const FieldResolver &resv, StringView source,
+		bool isSimpleGet) {
+	// buffer is reused between queries to avoid allocation for every select
+	static thread_local std::string tl_signature;
+
+	auto &ret = tl_signature;
+	ret.clear();
+
+	auto writeData = [&](const void *ptr, size_t size) {
+		ret.append((const char *)ptr, size);
+	};
+	auto writeSize = [&](size_t size) { writeData(&size, sizeof(size)); };
+	auto writeName = [&](StringView str) {
+		writeSize(str.size());
+		writeData(str.data(), str.size());
+	};
+	auto writeScheme = [&](const Scheme *scheme) {
+		if (scheme) {
+			writeName(scheme->getName());
+			writeSize(scheme->getVersion());
+		} else {
+			writeSize(stappler::maxOf<size_t>());
+		}
+	};
+	auto writeFields = [&](const Vector<const db::Field *> &fields) {
+		writeSize(fields.size());
+		for (auto &it : fields) { writeName(it->getName()); }
+	};
+
+	writeScheme(resv.scheme);
+	writeName(source);
+	ret.push_back(isSimpleGet ? 1 : 0);
+
+	if (resv.required) {
+		ret.push_back(
+				(resv.required->includeAll ? 1 : 0) | (resv.required->includeNone ? 2 : 0) | 4);
+		writeScheme(resv.required->scheme);
+		writeFields(resv.required->includeFields);
+		writeFields(resv.required->excludeFields);
+	} else {
+		ret.push_back(0);
+	}
+
+	if (resv.query) {
+		writeSize(resv.query->getIncludeFields().size());
+		for (auto &it : resv.query->getIncludeFields()) { writeName(it.name); }
+		writeSize(resv.query->getExcludeFields().size());
+		for (auto &it : resv.query->getExcludeFields()) { writeName(it.name); }
+	} else {
+		writeSize(stappler::maxOf<size_t>());
+	}
+
+	writeFields(resv.requiredFields);
+
+	return StringView(ret.data(), ret.size());
+}
+
+// Writes select-list with FieldResolver or from driver's shape cache; returns resolved virtuals when requested
+static void SqlQuery_writeSelectFields(const Driver *driver, SqlQuery::Select &sel,
+		FieldResolver &resv, StringView source, bool isSimpleGet,
+		Vector<const db::Field *> *virtuals) {
+	auto signature = SqlQuery_makeSelectShapeSignature(resv, source, isSimpleGet);
+
+	if (auto shape = driver->getSelectShape(signature)) {
+		if (!shape->fields.empty()) {
+			sel.query->getStream() << ((sel.state == SqlQuery::State::Some) ? ", " : " ")
+								   << StringView(shape->fields);
+			sel.state = SqlQuery::State::Some;
+		}
+		if (virtuals) {
+			virtuals->clear();
+			virtuals->reserve(shape->virtuals.size());
+			for (auto &it : shape->virtuals) {
+				if (auto f = resv.scheme->getField(it)) {
+					virtuals->emplace_back(f);
+				}
+			}
+		}
+		return;
+	}
+
+	auto &stream = sel.query->getStream();
+	auto state = sel.state;
+	auto start = stream.size();
+
+	resv.readFields([&] (const StringView &name, const db::Field *) {
+		sel = sel.field(source.empty() ? SqlQuery::Field(name) : SqlQuery::Field(source, name));
+	}, isSimpleGet);
+
+	Driver::SelectShape shape;
+	if (stream.size() > start) {
+		// drop leading separator, it depends on the state of the clause, not on the shape
+		auto fields = stream.weak().sub(start + ((state == SqlQuery::State::Some) ? 2 : 1));
+		shape.fields = std::string(fields.data(), fields.size());
+	}
+
+	if (virtuals) {
+		*virtuals = resv.getVirtuals();
+		shape.virtuals.reserve(virtuals->size());
+		for (auto &it : *virtuals) {
+			auto name = it->getName();
+			shape.virtuals.emplace_back(std::string(name.data(), name.size()));
+		}
+	}
+
+	// signature buffer is not used by readFields, so it is still valid here
+	driver->storeSelectShape(signature, sp::move(shape));
+}
+
 bool SqlQuery::writeQuery(Context &ctx) {
 	auto sel = (ctx.hasAltLimit)
 		? with("u", SqlQuery_makeSoftLimitWith(ctx, false)).select()
@@ -222,9 +333,8 @@ bool SqlQuery::writeQuery(Context &ctx, const db::Scheme &scheme, uint64_t oid,
 		if (ctx.shouldIncludeAll()) {
 			sel = sel.field(SqlQuery::Field(ctx.scheme->getName(), "*"));
 		} else {
-			ctx.readFields([&] (const StringView &name, const db::Field *) {
-				sel = sel.field(SqlQuery::Field(ctx.scheme->getName(), name));
-			});
+			SqlQuery_writeSelectFields(_driver, sel, ctx, ctx.scheme->getName(), false, &ctx.resolvedVirtuals);
+			ctx.hasResolvedVirtuals = true;
 		}
 	};
 
@@ -450,17 +560,16 @@ auto SqlQuery::writeSelectFrom(GenericQuery &q, const db::QueryList::Item &item,
 	auto sel = q.select();
 	writeFullTextRank(sel, *item.scheme, item.query);
 	FieldResolver resv(*item.scheme, item.query, item.getQueryFields());
-	resv.readFields([&] (const StringView &name, const db::Field *) {
-		sel = sel.field(SqlQuery::Field(schemeName, name));
-	}, isSimpleGet);
+	SqlQuery_writeSelectFields(_driver, sel, resv, schemeName, isSimpleGet, nullptr);
 	return sel.from(schemeName);
 }
 
 auto SqlQuery::writeSelectFrom(Select &sel, Context &ctx) -> SelectFrom {
 	writeFullTextRank(sel, *ctx.scheme, *ctx.query);
-	ctx.readFields([&] (const StringView &name, const db::Field *) {
-		sel = sel.field(SqlQuery::Field(name));
-	});
+	if (ctx.shouldResolveFields()) {
+		SqlQuery_writeSelectFields(_driver, sel, ctx, StringView(), false, &ctx.resolvedVirtuals);
+		ctx.hasResolvedVirtuals = true;
+	}
 	return sel.from(ctx.scheme->getName());
 }
 
@@ -786,6 +895,13 @@ SqlQuery::Context::Context(SqlQuery &sql, const Scheme &s, const Worker &w, cons
 	}
 }
 
+Vector<const db::Field *> SqlQuery::Context::getVirtuals() const {
+	if (hasResolvedVirtuals) {
+		return resolvedVirtuals;
+	}
+	return FieldResolver::getVirtuals();
+}
+
 StringView SqlQuery::Context::getAlt(StringView key) {
 	auto f = scheme->getField(key);
 	for (auto &it : query->getSelectList()) {
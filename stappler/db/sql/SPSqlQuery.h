@@ -42,7 +42,13 @@ public:
 		bool softLimitIsFts = false;
 		StringView softLimitField;
 
+		// virtual fields, resolved with select-list in writeSelectFrom
+		bool hasResolvedVirtuals = false;
+		Vector<const db::Field *> resolvedVirtuals;
+
 		StringView getAlt(StringView);
+
+		Vector<const db::Field *> getVirtuals() const;
 	};
 
 	using TypeString = db::Binder::TypeString;
@@ -36,6 +36,8 @@ namespace STAPPLER_VERSIONIZED stappler::db::sqlite {
 static void sp_ts_update_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **args);
 static void sp_ts_rank_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **args);
 static void sp_ts_query_valid_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **args);
+static void sp_ts_outdated_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **args);
+static void sp_ts_migrate_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **args);
 
 constexpr static auto DATABASE_DEFAULTS = StringView(R"Sql(
 CREATE TABLE IF NOT EXISTS "__objects" (
@@ -347,6 +349,10 @@ static Driver::Handle Driver_setupDriver(const Driver *d, DriverSym *_handle, po
 				nullptr, nullptr, nullptr);
 		_handle->_create_function_v2(db, "sp_ts_query_valid", 2, SQLITE_UTF8, (void *)h,
 				sp_ts_query_valid_xFunc, nullptr, nullptr, nullptr);
+		_handle->_create_function_v2(db, "sp_ts_outdated", 1, SQLITE_UTF8, (void *)h,
+				sp_ts_outdated_xFunc, nullptr, nullptr, nullptr);
+		_handle->_create_function_v2(db, "sp_ts_migrate", 1, SQLITE_UTF8, (void *)h,
+				sp_ts_migrate_xFunc, nullptr, nullptr, nullptr);
 
 		_handle->_create_module(db, "sp_unwrap", &s_UnwrapModule, (void *)d);
 
@@ -474,36 +480,48 @@ void Driver::setUserId(Handle h, int64_t userId) const {
 	db->userId = userId;
 }
 
-uint64_t Driver::insertWord(Handle h, StringView word) const {
-	auto data = (DriverHandle *)h.get();
-
+static uint64_t Driver_insertWord(const DriverSym *handle, DriverHandle *data, StringView word) {
 	uint64_t hash = sprt::hash32(word.data(), uint32_t(word.size()), 0) << 16;
 
-	std::unique_lock lock(data->mutex);
 	bool success = false;
 	while (!success) {
-		_handle->_bind_int64(data->wordsQuery, 1, hash);
-		_handle->_bind_text(data->wordsQuery, 2, word.data(), int(word.size()), nullptr);
+		handle->_bind_int64(data->wordsQuery, 1, hash);
+		handle->_bind_text(data->wordsQuery, 2, word.data(), int(word.size()), nullptr);
 
-		auto err = _handle->step(data->wordsQuery);
+		auto err = handle->step(data->wordsQuery);
 		if (err == SQLITE_ROW) {
-			auto w = StringView((const char *)_handle->_column_text(data->wordsQuery, 1),
-					_handle->_column_bytes(data->wordsQuery, 1));
+			auto w = StringView((const char *)handle->_column_text(data->wordsQuery, 1),
+					handle->_column_bytes(data->wordsQuery, 1));
 			if (w == word) {
 				success = true;
-				_handle->reset(data->wordsQuery);
+				handle->reset(data->wordsQuery);
 				break;
 			} else {
 				log::source().debug("sqlite::Driver", "Hash collision: ", w, " ", word, " ", hash);
 			}
 		}
-		_handle->reset(data->wordsQuery);
+		handle->reset(data->wordsQuery);
 		++hash;
 	}
 
 	return hash;
 }
 
+uint64_t Driver::insertWord(Handle h, StringView word) const {
+	auto data = (DriverHandle *)h.get();
+
+	std::unique_lock lock(data->mutex);
+	return Driver_insertWord(_handle, data, word);
+}
+
+void Driver::insertWords(Handle h, SpanView<StringView> words,
+		const Callback<void(StringView, uint64_t)> &cb) const {
+	auto data = (DriverHandle *)h.get();
+
+	std::unique_lock lock(data->mutex);
+	for (auto &it : words) { cb(it, Driver_insertWord(_handle, data, it)); }
+}
+
 Driver::Driver(pool_t *pool, ApplicationInterface *app, StringView mem, DriverSym *sym)
 : sql::Driver(pool, app) {
 	_handle = sym;
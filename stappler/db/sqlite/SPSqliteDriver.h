@@ -62,6 +62,9 @@ public:
 
 	uint64_t insertWord(Handle, StringView) const;
 
+	// resolves ids for all words with a single lock acquisition
+	void insertWords(Handle, SpanView<StringView>, const Callback<void(StringView, uint64_t)> &) const;
+
 	const DriverSym *getHandle() const { return _handle; }
 
 protected:
@@ -127,6 +127,12 @@ struct TextQueryData : AllocBase {
 	const FullTextQuery *query;
 	Vector<uint64_t> pos;
 	Vector<uint64_t> neg;
+
+	// word ids for query terms, resolved once per query
+	search::SearchVectorView::WordIdMap ids;
+
+	// reused to decompress vectors while ranking rows
+	Bytes buffer;
 };
 
 struct DriverLibStorage {
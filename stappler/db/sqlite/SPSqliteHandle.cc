@@ -179,7 +179,26 @@ void SqliteQueryInterface::bindTypeString(db::Binder &, StringStream &query,
 void SqliteQueryInterface::bindFullText(db::Binder &, StringStream &query,
 		const db::Binder::FullTextField &d) {
 	auto slot = d.field->getSlot<FieldFullTextView>();
-	auto result = slot->searchConfiguration->encodeSearchVectorData(d.data);
+
+	// words table in blob is keyed by `__words` ids, so ranking and reindexing
+	// can use ids directly
+	Vector<StringView> words;
+	words.reserve(d.data.words.size());
+	for (auto &it : d.data.words) { words.emplace_back(it.first); }
+
+	search::SearchVectorView::WordIdMap ids;
+	((const Driver *)driver)->insertWords(handle, words, [&](StringView word, uint64_t id) {
+		ids.emplace(word, id);
+	});
+
+	auto getWordId = [&](StringView word) -> uint64_t {
+		auto it = ids.find(word);
+		return (it != ids.end()) ? it->second : 0;
+	};
+	search::SearchVectorView::WordIdCallback wordId(getWordId);
+
+	auto result = slot->searchConfiguration->encodeSearchVectorData(d.data,
+			search::SearchData::Rank::Unknown, &wordId);
 	if (auto num = push(move(result))) {
 		query << "?" << num;
 	}
@@ -234,10 +253,19 @@ void SqliteQueryInterface::bindFullTextQuery(db::Binder &, StringStream &query,
 
 	auto q = new (std::nothrow) TextQueryData;
 	q->query = &d.query;
-	q->query->decompose([&, this](StringView pos) {
-		emplace_ordered(q->pos, ((const Driver *)driver)->insertWord(handle, pos));
-	}, [&, this](StringView neg) {
-		emplace_ordered(q->neg, ((const Driver *)driver)->insertWord(handle, neg));
+
+	Vector<StringView> pos;
+	Vector<StringView> neg;
+	q->query->decompose([&](StringView w) { pos.emplace_back(w); },
+			[&](StringView w) { neg.emplace_back(w); });
+
+	((const Driver *)driver)->insertWords(handle, pos, [&](StringView word, uint64_t id) {
+		emplace_ordered(q->pos, id);
+		q->ids.emplace(word, id);
+	});
+	((const Driver *)driver)->insertWords(handle, neg, [&](StringView word, uint64_t id) {
+		emplace_ordered(q->neg, id);
+		q->ids.emplace(word, id);
 	});
 
 	auto str = StringView(query.weak());
@@ -1217,6 +1217,9 @@ TableRec::TableRec(const Driver *driver, const BackendInterface::Config &cfg,
 }
 
 bool Handle::init(const BackendInterface::Config &cfg, const Map<StringView, const Scheme *> &s) {
+	// cached select-lists can refer to the previous scheme definitions
+	driver->clearSelectShapes();
+
 	level = TransactionLevel::Exclusive;
 	beginTransaction();
 
@@ -1253,6 +1256,35 @@ bool Handle::init(const BackendInterface::Config &cfg, const Map<StringView, con
 	}
 
 	StringStream query;
+
+	// rewrite full-text blobs from older formats once, so ranking can use word ids;
+	// sp_ts_update trigger reindexes words for the updated rows
+	uint32_t searchVersion = 0;
+	performSimpleSelect("SELECT version FROM __versions WHERE name = '__search_vector';",
+			[&](db::sql::Result &res) {
+		for (auto it : res) { searchVersion = uint32_t(it.toInteger(0)); }
+	});
+
+	if (searchVersion < search::SearchVectorView::Version) {
+		for (auto &it : s) {
+			for (auto &fit : it.second->getFields()) {
+				if (fit.second.getType() == db::Type::FullTextView) {
+					query << "UPDATE \"" << it.first << "\" SET \"" << fit.first
+						  << "\"=sp_ts_migrate(\"" << fit.first << "\") WHERE sp_ts_outdated(\""
+						  << fit.first << "\");";
+					performSimpleQuery(query.weak());
+					query.clear();
+				}
+			}
+		}
+
+		query << "INSERT INTO __versions(name,version) VALUES('__search_vector',"
+			  << uint32_t(search::SearchVectorView::Version) << ")"
+			  << " ON CONFLICT(name) DO UPDATE SET version = EXCLUDED.version;";
+		performSimpleQuery(query.weak());
+		query.clear();
+	}
+
 	query << "DELETE FROM __login WHERE \"date\" < "
 		  << Time::now().toSeconds() - config::STORAGE_DEFAULT_INTERNAL_INTERVAL.toSeconds() << ";";
 	performSimpleQuery(query.weak());
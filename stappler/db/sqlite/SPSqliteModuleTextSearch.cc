@@ -50,29 +50,46 @@ static void sp_ts_update_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **
 	queryStream << "INSERT INTO \"" << target << "\"(\"" << scheme << "_id\",\"word\") VALUES ";
 
 	auto wordsWritten = false;
+	auto writeWord = [&](StringView, uint64_t wordId) {
+		if (first) { first = false; } else { queryStream << ","; }
+		queryStream << "(" << id << "," << wordId << ")";
+		wordsWritten = true;
+	};
+
+	Vector<StringView> words;
 	if (auto storage = data->driver->getQueryStorage(scheme)) {
 		auto it = storage->find(field);
 		if (it != storage->end()) {
 			db::FullTextVector *vec = (db::FullTextVector *)it->second;
-			for (auto &word : vec->words) {
-				auto wordId = data->driver->insertWord(Driver::Handle(data), word.first);
-				if (first) { first = false; } else { queryStream << ","; }
-				queryStream << "(" << id << "," << wordId << ")";
-			}
-			wordsWritten = true;
+			words.reserve(vec->words.size());
+			for (auto &word : vec->words) { words.emplace_back(word.first); }
 		}
 	}
 
-	if (!wordsWritten) {
-		auto block = data::read<Interface>(blob).getValue(1);
-		if (block.getInteger(0) == 1) {
-			auto &d = data::read<Interface>(blob).getValue(1);
-			for (auto &it : d.asDict()) {
-				auto wordId = data->driver->insertWord(Driver::Handle(data), it.first);
-				if (first) { first = false; } else { queryStream << ","; }
-				queryStream << "(" << id << "," << wordId << ")";
-				wordsWritten = true;
-			}
+	if (!words.empty()) {
+		data->driver->insertWords(Driver::Handle(data), words, writeWord);
+	} else if (search::SearchVectorView::isBinaryFormat(blob)) {
+		Bytes buffer;
+		search::SearchVectorView view(blob, &buffer);
+		using PostingList = search::SearchVectorView::PostingList;
+		if (view.hasWordIds()) {
+			// ids were resolved when blob was written
+			view.foreach ([&](uint64_t wordId, StringView word, const PostingList &) {
+				writeWord(word, wordId);
+			});
+		} else {
+			words.reserve(view.getWordsCount());
+			view.foreach ([&](uint64_t, StringView word, const PostingList &) {
+				words.emplace_back(word);
+			});
+			data->driver->insertWords(Driver::Handle(data), words, writeWord);
+		}
+	} else {
+		// legacy CBOR format (version 1)
+		auto d = data::read<Interface>(blob);
+		if (d.isArray() && d.size() == 3 && d.getInteger(0) == 1) {
+			for (auto &it : d.getDict(2)) { words.emplace_back(it.first); }
+			data->driver->insertWords(Driver::Handle(data), words, writeWord);
 		}
 	}
 
@@ -102,7 +119,14 @@ static void sp_ts_rank_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **ar
 	}
 
 	auto q = (TextQueryData *)it->second;
-	sym->_result_double(ctx, q->query->rankQuery(blob, search::Normalization(norm)));
+
+	search::SearchVectorView view(blob, &q->buffer);
+	if (view.valid()) {
+		view.setWordIds(&q->ids);
+		sym->_result_double(ctx, q->query->rankQuery(view, search::Normalization(norm)));
+	} else {
+		sym->_result_double(ctx, q->query->rankQuery(blob, search::Normalization(norm)));
+	}
 }
 
 static void sp_ts_query_valid_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **args) {
@@ -124,7 +148,63 @@ static void sp_ts_query_valid_xFunc(sqlite3_context *ctx, int nargs, sqlite3_val
 	}
 
 	auto q = (TextQueryData *)it->second;
-	sym->_result_int(ctx, q->query->isMatch(blob) ? 1 : 0);
+
+	search::SearchVectorView view(blob, &q->buffer);
+	if (view.valid()) {
+		view.setWordIds(&q->ids);
+		sym->_result_int(ctx, q->query->isMatch(view) ? 1 : 0);
+	} else {
+		sym->_result_int(ctx, q->query->isMatch(blob) ? 1 : 0);
+	}
+}
+
+// returns 1 if blob should be rewritten with sp_ts_migrate
+static void sp_ts_outdated_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **args) {
+	auto sym = DriverSym::getCurrent();
+	auto blob = BytesView((const uint8_t *)sym->_value_blob(args[0]), sym->_value_bytes(args[0]));
+	sym->_result_int(ctx,
+			(!blob.empty() && !search::SearchVectorView::isCurrentFormat(blob)) ? 1 : 0);
+}
+
+// rewrites legacy CBOR or hash-keyed blob into current format, keyed by `__words` ids
+static void sp_ts_migrate_xFunc(sqlite3_context *ctx, int nargs, sqlite3_value **args) {
+	auto sym = DriverSym::getCurrent();
+	DriverHandle *data = (DriverHandle *)sym->_user_data(ctx);
+
+	auto blob = BytesView((const uint8_t *)sym->_value_blob(args[0]), sym->_value_bytes(args[0]));
+	if (blob.empty() || search::SearchVectorView::isCurrentFormat(blob)) {
+		sym->_result_blob64(ctx, blob.data(), blob.size(), SQLITE_TRANSIENT);
+		return;
+	}
+
+	auto p = pool::create(pool::acquire());
+	memory::perform([&] {
+		search::SearchVector vec;
+		if (!search::SearchVectorView::read(blob, vec)) {
+			// unknown data, keep it as is
+			sym->_result_blob64(ctx, blob.data(), blob.size(), SQLITE_TRANSIENT);
+			return;
+		}
+
+		Vector<StringView> words;
+		words.reserve(vec.words.size());
+		for (auto &it : vec.words) { words.emplace_back(it.first); }
+
+		search::SearchVectorView::WordIdMap ids;
+		data->driver->insertWords(Driver::Handle(data), words,
+				[&](StringView word, uint64_t id) { ids.emplace(word, id); });
+
+		auto getWordId = [&](StringView word) -> uint64_t {
+			auto it = ids.find(word);
+			return (it != ids.end()) ? it->second : 0;
+		};
+		search::SearchVectorView::WordIdCallback wordId(getWordId);
+
+		auto result = search::SearchVectorView::compress(search::SearchVectorView::encode(vec,
+				search::SearchData::Rank::Unknown, &wordId));
+		sym->_result_blob64(ctx, result.data(), result.size(), SQLITE_TRANSIENT);
+	}, p);
+	pool::destroy(p);
 }
 
 }
@@ -21,6 +21,7 @@
  **/
 
 #include "SPSqliteDriver.h"
+#include "SPDataValueView.h"
 #include "sqlite3.h"
 
 namespace STAPPLER_VERSIONIZED stappler::db::sqlite {
@@ -30,12 +31,26 @@ static constexpr auto UNWRAP_INPUT = 0;
 
 struct UnwrapCursor {
 	sqlite3_vtab_cursor base;
-	BytesView origValue;
-	BytesView currentValue;
-	Value value;
+	uint8_t *buffer; // copy of input blob for view
+	data::ValueView view; // used for CBOR input, without decoding
+	Value value; // used for other formats
 	size_t current = 0;
 };
 
+static void UnwrapCursor_reset(const DriverSym *sym, UnwrapCursor *p) {
+	if (p->buffer) {
+		sym->_free(p->buffer);
+		p->buffer = nullptr;
+	}
+	p->view = data::ValueView();
+	p->value = Value();
+	p->current = 0;
+}
+
+static size_t UnwrapCursor_size(UnwrapCursor *p) {
+	return p->view.isArray() ? p->view.size() : p->value.size();
+}
+
 static sqlite3_module s_UnwrapModule = {
 	.iVersion = 4,
 	.xCreate = nullptr, // [] (sqlite3*, void *pAux, int argc, const char *const* argv, sqlite3_vtab **ppVTab, char**) -> int { },
@@ -116,6 +131,7 @@ static sqlite3_module s_UnwrapModule = {
 	.xClose = [] (sqlite3_vtab_cursor *cur) -> int {
 		auto sym = DriverSym::getCurrent();
 		UnwrapCursor *p = (UnwrapCursor*)cur;
+		UnwrapCursor_reset(sym, p);
 		p->~UnwrapCursor();
 		sym->_free(cur);
 		return SQLITE_OK;
@@ -123,9 +139,28 @@ static sqlite3_module s_UnwrapModule = {
 	.xFilter = [] (sqlite3_vtab_cursor *cur, int idxNum, const char *idxStr, int argc, sqlite3_value **argv) -> int {
 		auto sym = DriverSym::getCurrent();
 		UnwrapCursor *p = (UnwrapCursor*)cur;
-		p->origValue = p->currentValue = BytesView((const uint8_t *)sym->_value_blob(argv[0]), sym->_value_bytes(argv[0]));
-		p->value = data::read<Interface>(p->origValue);
-		p->current = 0;
+		UnwrapCursor_reset(sym, p);
+
+		auto input = BytesView((const uint8_t *)sym->_value_blob(argv[0]), sym->_value_bytes(argv[0]));
+
+		uint8_t padding = 0;
+		if (!input.empty() && data::detectDataFormat(input.data(), input.size(), padding) == data::DataFormat::Cbor) {
+			// view reads values in place, so, input blob should live as long as cursor
+			p->buffer = (uint8_t *)sym->_malloc(int(input.size()));
+			if (!p->buffer) {
+				return SQLITE_NOMEM;
+			}
+			memcpy(p->buffer, input.data(), input.size());
+
+			p->view = data::ValueView::read(BytesView(p->buffer, input.size()));
+			if (p->view.isArray() || p->view.isNull()) {
+				return SQLITE_OK;
+			}
+			UnwrapCursor_reset(sym, p);
+			return SQLITE_MISMATCH;
+		}
+
+		p->value = data::read<Interface>(input);
 		if (p->value.isArray() || p->value.empty()) {
 			return SQLITE_OK;
 		}
@@ -139,7 +174,7 @@ static sqlite3_module s_UnwrapModule = {
 	},
 	.xEof = [] (sqlite3_vtab_cursor *cur) -> int {
 		UnwrapCursor *p = (UnwrapCursor*)cur;
-		if (p->value.empty() || p->current == p->value.size()) {
+		if (p->current >= UnwrapCursor_size(p)) {
 			return 1;
 		}
 		return 0;
@@ -148,6 +183,41 @@ static sqlite3_module s_UnwrapModule = {
 		auto sym = DriverSym::getCurrent();
 		UnwrapCursor *p = (UnwrapCursor*)cur;
 
+		if (p->view.isArray()) {
+			auto val = p->view.getValue(p->current);
+			switch (val.getType()) {
+			case data::ValueView::Type::INTEGER:
+				sym->_result_int64(db, val.getInteger());
+				return SQLITE_OK;
+			case data::ValueView::Type::DOUBLE:
+				sym->_result_double(db, val.getDouble());
+				return SQLITE_OK;
+			case data::ValueView::Type::BOOLEAN:
+				sym->_result_int(db, val.getBool() ? 1 : 0);
+				return SQLITE_OK;
+			case data::ValueView::Type::CHARSTRING:
+				if (auto str = val.getString(); str.data()) {
+					sym->_result_text64(db, str.data(), str.size(), SQLITE_TRANSIENT, SQLITE_UTF8);
+				} else {
+					// indefinite-length string, should be assembled
+					auto tmp = val.toValue<Interface>();
+					sym->_result_text64(db, tmp.getString().data(), tmp.getString().size(), SQLITE_TRANSIENT, SQLITE_UTF8);
+				}
+				return SQLITE_OK;
+			case data::ValueView::Type::BYTESTRING:
+				if (auto bytes = val.getBytes(); bytes.data()) {
+					sym->_result_blob64(db, bytes.data(), bytes.size(), SQLITE_TRANSIENT);
+				} else {
+					auto tmp = val.toValue<Interface>();
+					sym->_result_blob64(db, tmp.getBytes().data(), tmp.getBytes().size(), SQLITE_TRANSIENT);
+				}
+				return SQLITE_OK;
+			default:
+				sym->_result_null(db);
+				return SQLITE_OK;
+			}
+		}
+
 		auto &val = p->value.getValue(p->current);
 		switch (val.getType()) {
 		case Value::Type::INTEGER:
@@ -0,0 +1,985 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "SPDocCache.h"
+#include "SPFilesystem.h"
+#include "SPFilesystemFile.h"
+
+#include <optional>
+
+namespace STAPPLER_VERSIONIZED stappler::document {
+
+// All records are plain structures with 4-byte alignment, written in host byte order;
+// cache is a local artifact and not intended to be transferred between machines
+//
+// Strings in Chars and WideChars sections are null-terminated, so document strings can refer
+// to mapped data directly
+
+struct CacheString {
+	uint32_t offset = 0;
+	uint32_t size = 0;
+};
+
+struct CacheBlob {
+	uint64_t offset = 0;
+	uint64_t size = 0;
+};
+
+struct CacheRange {
+	uint32_t first = 0;
+	uint32_t count = 0;
+};
+
+enum class CacheSectionId : uint32_t {
+	Chars,
+	WideChars,
+	Blobs,
+	Strings,
+	StringLists,
+	KeyValues,
+	Params,
+	Queries,
+	QueryLists,
+	Spine,
+	Images,
+	Fonts,
+	Toc,
+	Rules,
+	FontFamilies,
+	FontFaces,
+	FontSources,
+	StyleLinks,
+	Styles,
+	Pages,
+	Nodes,
+	Max
+};
+
+static constexpr size_t CacheSectionCount = toInt(CacheSectionId::Max);
+
+struct CacheSection {
+	uint64_t offset = 0;
+	uint64_t size = 0; // in bytes
+};
+
+struct CacheHeader {
+	uint32_t magic = DocumentCache::Magic;
+	uint16_t version = DocumentCache::Version;
+	uint16_t endian = 0x0102;
+	uint64_t sourceHash = 0;
+	uint64_t fileSize = 0;
+	uint32_t maxNodeId = NodeIdNone;
+	uint32_t tocRoot = 0;
+	CacheRange meta;
+	CacheString uid;
+	CacheString name;
+	CacheString type;
+	CacheSection sections[CacheSectionCount];
+};
+
+struct CacheKeyValue {
+	CacheString key;
+	CacheString value;
+};
+
+struct CacheQuery {
+	uint32_t negative = 0;
+	CacheRange params;
+};
+
+struct CacheSpineFile {
+	CacheString file;
+	uint32_t linear = 1;
+};
+
+struct CacheImage {
+	CacheString key;
+	CacheString path;
+	CacheString ref;
+	CacheString ct;
+	uint32_t type = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t padding = 0;
+	CacheBlob data;
+};
+
+struct CacheFont {
+	CacheString key;
+	CacheString path;
+	CacheString ref;
+	CacheString ct;
+	CacheBlob data;
+};
+
+// Table of contents, flattened in preorder
+struct CacheContentRecord {
+	CacheString label;
+	CacheString href;
+	uint32_t childs = 0;
+};
+
+struct CacheRule {
+	CacheString selector;
+	CacheRange params;
+};
+
+struct CacheFontFamily {
+	CacheString name;
+	CacheRange faces;
+};
+
+struct CacheFontFace {
+	CacheString family;
+	CacheRange sources;
+	CacheRange params;
+	FontVariations variations;
+};
+
+struct CacheFontSource {
+	CacheString url;
+	CacheString format;
+	CacheString tech;
+	uint32_t isLocal = 0;
+};
+
+struct CacheStyleLink {
+	CacheString href;
+	uint32_t media = 0;
+};
+
+struct CacheStyleContainer {
+	CacheString key;
+	CacheRange rules;
+	CacheRange fonts;
+};
+
+struct CachePage {
+	CacheString key;
+	CacheString path;
+	CacheString title;
+	CacheString charset;
+	CacheString baseOrigin;
+	CacheString baseTarget;
+	CacheRange meta;
+	CacheRange http;
+	CacheRange links;
+	CacheRange assets;
+	CacheRange rules;
+	CacheRange fonts;
+	CacheRange nodes; // flattened in preorder, first node is root
+	uint32_t linear = 1;
+};
+
+struct CacheNode {
+	uint32_t nodeId = NodeIdNone;
+	uint32_t autoRefs = 0;
+	CacheString htmlName;
+	CacheString htmlId;
+	CacheString xType;
+	CacheString value; // in WideChars section
+	CacheRange style;
+	CacheRange classes;
+	CacheRange attributes;
+	uint32_t childs = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<StyleParameter>,
+		"StyleParameter should be stored in cache as is");
+static_assert(std::is_trivially_copyable_v<FontVariations>,
+		"FontVariations should be stored in cache as is");
+
+struct DocumentCache::Writer : public InterfaceObject<memory::StandartInterface> {
+	CacheString addString(StringView str) {
+		if (str.empty()) {
+			return CacheString();
+		}
+
+		auto it = interned.find(str);
+		if (it != interned.end()) {
+			return it->second;
+		}
+
+		CacheString ret{uint32_t(chars.size()), uint32_t(str.size())};
+		chars.append(str.data(), str.size());
+		chars.push_back(0);
+		interned.emplace(str, ret);
+		return ret;
+	}
+
+	CacheString addWideString(WideStringView str) {
+		if (str.empty()) {
+			return CacheString();
+		}
+		CacheString ret{uint32_t(wideChars.size()), uint32_t(str.size())};
+		wideChars.append(str.data(), str.size());
+		wideChars.push_back(0);
+		return ret;
+	}
+
+	CacheBlob addBlob(BytesView data) {
+		if (data.empty()) {
+			return CacheBlob();
+		}
+
+		// keep embedded data aligned for direct use from mapped region
+		blobs.resize(math::align<size_t>(blobs.size(), 16));
+
+		CacheBlob ret{uint64_t(blobs.size()), uint64_t(data.size())};
+		blobs.insert(blobs.end(), data.begin(), data.end());
+		return ret;
+	}
+
+	template <typename Container>
+	CacheRange addKeyValues(const Container &map) {
+		CacheRange ret{uint32_t(keyValues.size()), uint32_t(map.size())};
+		for (auto &it : map) {
+			keyValues.emplace_back(CacheKeyValue{addString(it.first), addString(it.second)});
+		}
+		return ret;
+	}
+
+	template <typename Container>
+	CacheRange addStringList(const Container &list) {
+		CacheRange ret{uint32_t(stringLists.size()), uint32_t(list.size())};
+		for (auto &it : list) { stringLists.emplace_back(addString(it)); }
+		return ret;
+	}
+
+	template <typename Container>
+	CacheRange addParams(const Container &list) {
+		CacheRange ret{uint32_t(params.size()), uint32_t(list.size())};
+		params.reserve(params.size() + list.size());
+		for (auto &it : list) {
+			// padding bytes are written into file, so record is zeroed before field assignment
+			auto &param = params.emplace_back();
+			memset(reinterpret_cast<void *>(&param), 0, sizeof(StyleParameter));
+			param.name = it.name;
+			param.mediaQuery = it.mediaQuery;
+			param.value = it.value;
+			param.rule = it.rule;
+		}
+		return ret;
+	}
+
+	void addContentRecord(const DocumentContentRecord &rec) {
+		toc.emplace_back(CacheContentRecord{addString(rec.label), addString(rec.href),
+			uint32_t(rec.childs.size())});
+		for (auto &it : rec.childs) { addContentRecord(it); }
+	}
+
+	void addNode(const Node *node) {
+		nodes.emplace_back(CacheNode{
+			node->_nodeId,
+			node->_autoRefs ? 1U : 0U,
+			addString(node->_htmlName),
+			addString(node->_htmlId),
+			addString(node->_xType),
+			addWideString(node->_value),
+			addParams(node->_style.data),
+			addStringList(node->_classes),
+			addKeyValues(node->_attributes),
+			uint32_t(node->_nodes.size()),
+		});
+
+		for (auto &it : node->_nodes) { addNode(it); }
+	}
+
+	Pair<CacheRange, CacheRange> addStyles(const StyleContainer *container) {
+		CacheRange rulesRange{uint32_t(rules.size()), uint32_t(container->_styles.size())};
+		for (auto &it : container->_styles) {
+			rules.emplace_back(CacheRule{addString(it.first), addParams(it.second.data)});
+		}
+
+		CacheRange fontsRange{uint32_t(fontFamilies.size()), uint32_t(container->_fonts.size())};
+		for (auto &it : container->_fonts) {
+			CacheRange facesRange{uint32_t(fontFaces.size()), uint32_t(it.second.size())};
+			for (auto &face : it.second) {
+				CacheRange sourcesRange{uint32_t(fontSources.size()), uint32_t(face.src.size())};
+				for (auto &src : face.src) {
+					fontSources.emplace_back(CacheFontSource{addString(src.url),
+						addString(src.format), addString(src.tech), src.isLocal ? 1U : 0U});
+				}
+				fontFaces.emplace_back(CacheFontFace{addString(face.fontFamily), sourcesRange,
+					addParams(face.style), face.variations});
+			}
+			fontFamilies.emplace_back(CacheFontFamily{addString(it.first), facesRange});
+		}
+		return pair(rulesRange, fontsRange);
+	}
+
+	void addPage(StringView key, const PageContainer *page) {
+		CachePage rec;
+		rec.key = addString(key);
+		rec.path = addString(page->_path);
+		rec.title = addString(page->_title);
+		rec.charset = addString(page->_charset);
+		rec.baseOrigin = addString(page->_baseOrigin);
+		rec.baseTarget = addString(page->_baseTarget);
+		rec.meta = addKeyValues(page->_meta);
+		rec.http = addKeyValues(page->_http);
+
+		rec.links = CacheRange{uint32_t(styleLinks.size()), uint32_t(page->_styleLinks.size())};
+		for (auto &it : page->_styleLinks) {
+			styleLinks.emplace_back(CacheStyleLink{addString(it.href), it.media.get()});
+		}
+
+		rec.assets = addStringList(page->_assets);
+
+		auto s = addStyles(page);
+		rec.rules = s.first;
+		rec.fonts = s.second;
+
+		rec.nodes.first = uint32_t(nodes.size());
+		if (page->_root) {
+			addNode(page->_root);
+		}
+		rec.nodes.count = uint32_t(nodes.size()) - rec.nodes.first;
+		rec.linear = page->linear ? 1 : 0;
+
+		pages.emplace_back(rec);
+	}
+
+	void addDocument(const DocumentData *data) {
+		header.uid = addString(data->uid);
+		header.name = addString(data->name);
+		header.type = addString(data->type);
+		header.maxNodeId = data->maxNodeId;
+
+		for (auto &it : data->strings) { strings.emplace_back(addString(it)); }
+
+		for (auto &it : data->queries) {
+			CacheRange range{uint32_t(queries.size()), uint32_t(it.list.size())};
+			for (auto &q : it.list) {
+				queries.emplace_back(CacheQuery{q.negative ? 1U : 0U, addParams(q.params)});
+			}
+			queryLists.emplace_back(range);
+		}
+
+		for (auto &it : data->spine) {
+			spine.emplace_back(CacheSpineFile{addString(it.file), it.linear ? 1U : 0U});
+		}
+
+		for (auto &it : data->images) {
+			images.emplace_back(CacheImage{addString(it.first), addString(it.second.path),
+				addString(it.second.ref), addString(it.second.ct), uint32_t(it.second.type),
+				it.second.width, it.second.height, 0, addBlob(it.second.data)});
+		}
+
+		for (auto &it : data->fonts) {
+			fonts.emplace_back(CacheFont{addString(it.first), addString(it.second.path),
+				addString(it.second.ref), addString(it.second.ct), addBlob(it.second.data)});
+		}
+
+		header.meta = addKeyValues(data->meta);
+
+		header.tocRoot = uint32_t(toc.size());
+		addContentRecord(data->tableOfContents);
+
+		for (auto &it : data->styles) {
+			auto s = addStyles(it.second);
+			styles.emplace_back(CacheStyleContainer{addString(it.first), s.first, s.second});
+		}
+
+		for (auto &it : data->pages) { addPage(it.first, it.second); }
+	}
+
+	template <typename T>
+	void writeSection(CacheSectionId id, const T *data, size_t size, size_t align = 8) {
+		output.resize(math::align<size_t>(output.size(), align));
+		header.sections[toInt(id)] = CacheSection{uint64_t(output.size()), uint64_t(size)};
+		if (size > 0) {
+			auto ptr = reinterpret_cast<const uint8_t *>(data);
+			output.insert(output.end(), ptr, ptr + size);
+		}
+	}
+
+	template <typename T>
+	void writeSection(CacheSectionId id, const Vector<T> &vec) {
+		writeSection(id, vec.data(), vec.size() * sizeof(T));
+	}
+
+	void finalize(uint64_t sourceHash) {
+		output.resize(sizeof(CacheHeader));
+
+		writeSection(CacheSectionId::Chars, chars.data(), chars.size());
+		writeSection(CacheSectionId::WideChars, wideChars.data(), wideChars.size() * sizeof(char16_t));
+		writeSection(CacheSectionId::Blobs, blobs.data(), blobs.size(), 16);
+		writeSection(CacheSectionId::Strings, strings);
+		writeSection(CacheSectionId::StringLists, stringLists);
+		writeSection(CacheSectionId::KeyValues, keyValues);
+		writeSection(CacheSectionId::Params, params);
+		writeSection(CacheSectionId::Queries, queries);
+		writeSection(CacheSectionId::QueryLists, queryLists);
+		writeSection(CacheSectionId::Spine, spine);
+		writeSection(CacheSectionId::Images, images);
+		writeSection(CacheSectionId::Fonts, fonts);
+		writeSection(CacheSectionId::Toc, toc);
+		writeSection(CacheSectionId::Rules, rules);
+		writeSection(CacheSectionId::FontFamilies, fontFamilies);
+		writeSection(CacheSectionId::FontFaces, fontFaces);
+		writeSection(CacheSectionId::FontSources, fontSources);
+		writeSection(CacheSectionId::StyleLinks, styleLinks);
+		writeSection(CacheSectionId::Styles, styles);
+		writeSection(CacheSectionId::Pages, pages);
+		writeSection(CacheSectionId::Nodes, nodes);
+
+		header.sourceHash = sourceHash;
+		header.fileSize = output.size();
+		memcpy(output.data(), &header, sizeof(CacheHeader));
+	}
+
+	CacheHeader header;
+
+	Map<StringView, CacheString> interned;
+	String chars;
+	WideString wideChars;
+	Bytes blobs;
+
+	Vector<CacheString> strings;
+	Vector<CacheString> stringLists;
+	Vector<CacheKeyValue> keyValues;
+	Vector<StyleParameter> params;
+	Vector<CacheQuery> queries;
+	Vector<CacheRange> queryLists;
+	Vector<CacheSpineFile> spine;
+	Vector<CacheImage> images;
+	Vector<CacheFont> fonts;
+	Vector<CacheContentRecord> toc;
+	Vector<CacheRule> rules;
+	Vector<CacheFontFamily> fontFamilies;
+	Vector<CacheFontFace> fontFaces;
+	Vector<CacheFontSource> fontSources;
+	Vector<CacheStyleLink> styleLinks;
+	Vector<CacheStyleContainer> styles;
+	Vector<CachePage> pages;
+	Vector<CacheNode> nodes;
+
+	Bytes output;
+};
+
+struct CachedDocumentData : public DocumentData {
+	virtual ~CachedDocumentData() = default;
+
+	CachedDocumentData(memory::pool_t *p) : DocumentData(p) { }
+
+	std::optional<filesystem::MemoryMappedRegion> region;
+};
+
+class CachedDocument : public Document {
+public:
+	virtual ~CachedDocument() = default;
+
+	bool init(memory::pool_t *pool, filesystem::MemoryMappedRegion &&region) {
+		if (!Document::init(pool)) {
+			return false;
+		}
+
+		getCachedData()->region.emplace(sp::move(region));
+		return true;
+	}
+
+	memory::pool_t *getPool() const { return _pool; }
+
+	CachedDocumentData *getCachedData() const { return static_cast<CachedDocumentData *>(_data); }
+
+protected:
+	virtual DocumentData *allocateData(memory::pool_t *pool) override {
+		memory::context ctx(pool);
+
+		return new (pool) CachedDocumentData(pool);
+	}
+};
+
+struct DocumentCache::Reader : public InterfaceObject<memory::PoolInterface> {
+	bool init(BytesView data, uint64_t sourceHash) {
+		if (data.size() < sizeof(CacheHeader)) {
+			return false;
+		}
+
+		memcpy(&header, data.data(), sizeof(CacheHeader));
+		if (header.magic != DocumentCache::Magic || header.version != DocumentCache::Version
+				|| header.endian != 0x0102) {
+			return false;
+		}
+
+		if (header.sourceHash != sourceHash || header.fileSize != data.size()) {
+			return false;
+		}
+
+		for (auto &it : header.sections) {
+			if (it.offset > data.size() || it.size > data.size() - it.offset) {
+				return false;
+			}
+		}
+
+		region = data;
+		return true;
+	}
+
+	template <typename T>
+	SpanView<T> section(CacheSectionId id) {
+		auto &sec = header.sections[toInt(id)];
+		if (sec.size % sizeof(T) != 0 || (sec.offset % alignof(T)) != 0) {
+			valid = false;
+			return SpanView<T>();
+		}
+		return SpanView<T>(reinterpret_cast<const T *>(region.data() + sec.offset),
+				sec.size / sizeof(T));
+	}
+
+	template <typename T>
+	SpanView<T> range(SpanView<T> source, const CacheRange &r) {
+		if (r.first > source.size() || r.count > source.size() - r.first) {
+			valid = false;
+			return SpanView<T>();
+		}
+		return source.sub(r.first, r.count);
+	}
+
+	StringView str(const CacheString &str) {
+		if (str.offset > chars.size() || str.size >= chars.size() - str.offset
+				|| chars[str.offset + str.size] != 0) {
+			if (str.size != 0) {
+				valid = false;
+			}
+			return StringView();
+		}
+		return StringView(chars.data() + str.offset, str.size);
+	}
+
+	WideStringView wstr(const CacheString &str) {
+		if (str.offset > wideChars.size() || str.size >= wideChars.size() - str.offset
+				|| wideChars[str.offset + str.size] != 0) {
+			if (str.size != 0) {
+				valid = false;
+			}
+			return WideStringView();
+		}
+		return WideStringView(wideChars.data() + str.offset, str.size);
+	}
+
+	// Pool strings without own storage, that refers to the mapped region
+	String weak(const CacheString &s) {
+		auto v = str(s);
+		return v.empty() ? String() : String::make_weak(v.data(), v.size());
+	}
+
+	WideString weakw(const CacheString &s) {
+		auto v = wstr(s);
+		return v.empty() ? WideString() : WideString::make_weak(v.data(), v.size());
+	}
+
+	BytesView blob(const CacheBlob &blob) {
+		if (blob.offset > blobs.size() || blob.size > blobs.size() - blob.offset) {
+			valid = false;
+			return BytesView();
+		}
+		return BytesView(blobs.data() + blob.offset, blob.size);
+	}
+
+	void readStyles(StyleContainer *container, const CacheRange &rulesRange,
+			const CacheRange &fontsRange) {
+		for (auto &it : range(rules, rulesRange)) {
+			auto &list = container->_styles.emplace(weak(it.selector), StyleList()).first->second;
+			auto p = range(params, it.params);
+			list.data.assign(p.begin(), p.end());
+		}
+
+		for (auto &it : range(fontFamilies, fontsRange)) {
+			auto &faces =
+					container->_fonts.emplace(weak(it.name), Vector<FontFace>()).first->second;
+			auto facesRange = range(fontFaces, it.faces);
+			faces.reserve(facesRange.size());
+			for (auto &f : facesRange) {
+				auto &face = faces.emplace_back();
+				face.fontFamily = weak(f.family);
+				face.variations = f.variations;
+				auto p = range(params, f.params);
+				face.style.assign(p.begin(), p.end());
+
+				auto sourcesRange = range(fontSources, f.sources);
+				face.src.reserve(sourcesRange.size());
+				for (auto &src : sourcesRange) {
+					face.src.emplace_back(FontFace::FontFaceSource{
+						weak(src.url),
+						weak(src.format),
+						weak(src.tech),
+						src.isLocal != 0,
+					});
+				}
+			}
+		}
+	}
+
+	void readContentRecord(DocumentContentRecord &rec, SpanView<CacheContentRecord> &source) {
+		if (source.empty()) {
+			valid = false;
+			return;
+		}
+
+		auto &it = source.front();
+		source.offset(1);
+
+		rec.label = str(it.label);
+		rec.href = str(it.href);
+		rec.childs.reserve(it.childs);
+		for (uint32_t i = 0; i < it.childs && valid; ++i) {
+			readContentRecord(rec.childs.emplace_back(), source);
+		}
+	}
+
+	Node *readNodes(memory::pool_t *pool, PageContainer *page, SpanView<CacheNode> source) {
+		if (source.empty()) {
+			return nullptr;
+		}
+
+		// All nodes of the page within a single allocation
+		auto storage = static_cast<Node *>(memory::pool::palloc(pool, sizeof(Node) * source.size()));
+
+		struct StackEntry {
+			Node *node;
+			uint32_t remains;
+		};
+
+		Vector<StackEntry> stack;
+
+		for (size_t i = 0; i < source.size(); ++i) {
+			auto &rec = source[i];
+			auto node = new (&storage[i]) Node();
+
+			node->_nodeId = rec.nodeId;
+			node->_autoRefs = rec.autoRefs != 0;
+
+			node->_htmlName = weak(rec.htmlName);
+			node->_htmlId = weak(rec.htmlId);
+			node->_xType = weak(rec.xType);
+			node->_value = weakw(rec.value);
+
+			auto style = range(params, rec.style);
+			node->_style.data.assign(style.begin(), style.end());
+
+			auto classes = range(stringLists, rec.classes);
+			node->_classes.reserve(classes.size());
+			for (auto &it : classes) { node->_classes.emplace_back(weak(it)); }
+
+			for (auto &it : range(keyValues, rec.attributes)) {
+				node->_attributes.emplace(weak(it.key), weak(it.value));
+			}
+
+			node->_nodes.reserve(rec.childs);
+
+			if (i > 0) {
+				while (!stack.empty() && stack.back().remains == 0) { stack.pop_back(); }
+				if (stack.empty()) {
+					// second root within a page
+					valid = false;
+					return nullptr;
+				}
+
+				auto parent = stack.back().node;
+				parent->_nodes.emplace_back(node);
+				node->_parent = parent;
+				--stack.back().remains;
+			}
+
+			if (rec.childs > 0) {
+				stack.emplace_back(StackEntry{node, rec.childs});
+			}
+
+			if (!node->_htmlId.empty()) {
+				page->_ids.emplace(node->getHtmlId(), node);
+			}
+		}
+
+		for (auto &it : stack) {
+			if (it.remains != 0) {
+				valid = false;
+				return nullptr;
+			}
+		}
+
+		return &storage[0];
+	}
+
+	void readPage(memory::pool_t *pool, DocumentData *data, const CachePage &rec) {
+		auto page = new (pool) PageContainer(data, str(rec.path));
+		page->_title = weak(rec.title);
+		page->_charset = weak(rec.charset);
+		page->_baseOrigin = weak(rec.baseOrigin);
+		page->_baseTarget = weak(rec.baseTarget);
+
+		for (auto &it : range(keyValues, rec.meta)) {
+			page->_meta.emplace(weak(it.key), weak(it.value));
+		}
+
+		for (auto &it : range(keyValues, rec.http)) {
+			page->_http.emplace(weak(it.key), weak(it.value));
+		}
+
+		auto links = range(styleLinks, rec.links);
+		page->_styleLinks.reserve(links.size());
+		for (auto &it : links) {
+			page->_styleLinks.emplace_back(
+					PageContainer::StyleLink{weak(it.href), MediaQueryId(uint16_t(it.media))});
+		}
+
+		auto assets = range(stringLists, rec.assets);
+		page->_assets.reserve(assets.size());
+		for (auto &it : assets) { page->_assets.emplace_back(weak(it)); }
+
+		readStyles(page, rec.rules, rec.fonts);
+
+		page->linear = rec.linear != 0;
+		if (auto root = readNodes(pool, page, range(nodes, rec.nodes))) {
+			page->_root = root;
+		}
+
+		data->pages.emplace(str(rec.key), page);
+	}
+
+	bool readDocument(memory::pool_t *pool, DocumentData *data) {
+		chars = section<char>(CacheSectionId::Chars);
+		wideChars = section<char16_t>(CacheSectionId::WideChars);
+		blobs = section<uint8_t>(CacheSectionId::Blobs);
+		strings = section<CacheString>(CacheSectionId::Strings);
+		stringLists = section<CacheString>(CacheSectionId::StringLists);
+		keyValues = section<CacheKeyValue>(CacheSectionId::KeyValues);
+		params = section<StyleParameter>(CacheSectionId::Params);
+		queries = section<CacheQuery>(CacheSectionId::Queries);
+		queryLists = section<CacheRange>(CacheSectionId::QueryLists);
+		spine = section<CacheSpineFile>(CacheSectionId::Spine);
+		images = section<CacheImage>(CacheSectionId::Images);
+		fonts = section<CacheFont>(CacheSectionId::Fonts);
+		toc = section<CacheContentRecord>(CacheSectionId::Toc);
+		rules = section<CacheRule>(CacheSectionId::Rules);
+		fontFamilies = section<CacheFontFamily>(CacheSectionId::FontFamilies);
+		fontFaces = section<CacheFontFace>(CacheSectionId::FontFaces);
+		fontSources = section<CacheFontSource>(CacheSectionId::FontSources);
+		styleLinks = section<CacheStyleLink>(CacheSectionId::StyleLinks);
+		styles = section<CacheStyleContainer>(CacheSectionId::Styles);
+		pages = section<CachePage>(CacheSectionId::Pages);
+		nodes = section<CacheNode>(CacheSectionId::Nodes);
+
+		if (!valid) {
+			return false;
+		}
+
+		// Strings and assets are views into mapped region, owned by CachedDocumentData
+		data->uid = str(header.uid);
+		data->name = str(header.name);
+		data->type = str(header.type);
+		data->maxNodeId = header.maxNodeId;
+
+		data->strings.reserve(strings.size());
+		for (auto &it : strings) { data->strings.emplace_back(str(it)); }
+
+		data->queries.reserve(queryLists.size());
+		for (auto &it : queryLists) {
+			auto &query = data->queries.emplace_back();
+			auto list = range(queries, it);
+			query.list.reserve(list.size());
+			for (auto &q : list) {
+				auto &target = query.list.emplace_back();
+				target.negative = q.negative != 0;
+				auto p = range(params, q.params);
+				target.params.assign(p.begin(), p.end());
+			}
+		}
+
+		data->spine.reserve(spine.size());
+		for (auto &it : spine) {
+			data->spine.emplace_back(SpineFile{str(it.file), it.linear != 0});
+		}
+
+		for (auto &it : images) {
+			DocumentImage img;
+			img.type = DocumentImage::Type(it.type);
+			img.width = it.width;
+			img.height = it.height;
+			img.path = str(it.path);
+			img.ref = str(it.ref);
+			img.ct = str(it.ct);
+			img.data = blob(it.data);
+			data->images.emplace(str(it.key), img);
+		}
+
+		for (auto &it : fonts) {
+			DocumentFont font{StringView()};
+			font.path = str(it.path);
+			font.ref = str(it.ref);
+			font.ct = str(it.ct);
+			font.data = blob(it.data);
+			data->fonts.emplace(str(it.key), font);
+		}
+
+		for (auto &it : range(keyValues, header.meta)) {
+			data->meta.emplace(str(it.key), str(it.value));
+		}
+
+		auto tocSource = toc.sub(header.tocRoot);
+		readContentRecord(data->tableOfContents, tocSource);
+
+		for (auto &it : styles) {
+			auto container = new (pool) StyleContainer(data);
+			readStyles(container, it.rules, it.fonts);
+			data->styles.emplace(str(it.key), container);
+		}
+
+		for (auto &it : pages) {
+			readPage(pool, data, it);
+			if (!valid) {
+				break;
+			}
+		}
+
+		return valid;
+	}
+
+	bool valid = true;
+	BytesView region;
+	CacheHeader header;
+
+	SpanView<char> chars;
+	SpanView<char16_t> wideChars;
+	SpanView<uint8_t> blobs;
+	SpanView<CacheString> strings;
+	SpanView<CacheString> stringLists;
+	SpanView<CacheKeyValue> keyValues;
+	SpanView<StyleParameter> params;
+	SpanView<CacheQuery> queries;
+	SpanView<CacheRange> queryLists;
+	SpanView<CacheSpineFile> spine;
+	SpanView<CacheImage> images;
+	SpanView<CacheFont> fonts;
+	SpanView<CacheContentRecord> toc;
+	SpanView<CacheRule> rules;
+	SpanView<CacheFontFamily> fontFamilies;
+	SpanView<CacheFontFace> fontFaces;
+	SpanView<CacheFontSource> fontSources;
+	SpanView<CacheStyleLink> styleLinks;
+	SpanView<CacheStyleContainer> styles;
+	SpanView<CachePage> pages;
+	SpanView<CacheNode> nodes;
+};
+
+uint64_t DocumentCache::getSourceHash(BytesView data) {
+	return string::hash64(StringView(reinterpret_cast<const char *>(data.data()), data.size()));
+}
+
+uint64_t DocumentCache::getSourceHash(const FileInfo &info) {
+	auto region = filesystem::MemoryMappedRegion::mapFile(info, filesystem::MappingType::Private,
+			filesystem::ProtFlags::MapRead);
+	if (!region) {
+		return 0;
+	}
+	return getSourceHash(region.getView());
+}
+
+bool DocumentCache::write(const Document *doc, const FileInfo &info, uint64_t sourceHash) {
+	auto data = doc ? doc->getData() : nullptr;
+	if (!data) {
+		return false;
+	}
+
+	Writer writer;
+	writer.addDocument(data);
+	writer.finalize(sourceHash);
+
+	// write into temporary file near the target, then replace target with it
+	auto tmpPath = string::toString<Interface>(info.path, ".tmp");
+	auto tmpInfo = FileInfo(tmpPath, info.category, info.flags);
+
+	auto file = filesystem::File::open(tmpInfo, filesystem::OpenFlags::Override);
+	if (!file) {
+		log::source().error("DocumentCache", "Fail to open cache file for writing: ", tmpInfo);
+		return false;
+	}
+
+	auto written = file.write(writer.output.data(), writer.output.size());
+	file.close();
+
+	if (written != writer.output.size()) {
+		log::source().error("DocumentCache", "Fail to write cache file: ", tmpInfo);
+		filesystem::remove(tmpInfo);
+		return false;
+	}
+
+	if (!filesystem::move(tmpInfo, info)) {
+		log::source().error("DocumentCache", "Fail to replace cache file: ", info);
+		filesystem::remove(tmpInfo);
+		return false;
+	}
+
+	return true;
+}
+
+Rc<Document> DocumentCache::load(memory::pool_t *pool, const FileInfo &info, uint64_t sourceHash) {
+	if (!filesystem::exists(info)) {
+		return nullptr;
+	}
+
+	auto region = filesystem::MemoryMappedRegion::mapFile(info, filesystem::MappingType::Private,
+			filesystem::ProtFlags::MapRead);
+	if (!region) {
+		return nullptr;
+	}
+
+	Reader reader;
+	if (!reader.init(region.getView(), sourceHash)) {
+		return nullptr;
+	}
+
+	auto doc = Rc<CachedDocument>::create(pool, sp::move(region));
+	if (!doc) {
+		return nullptr;
+	}
+
+	bool success = false;
+	memory::perform([&] { success = reader.readDocument(doc->getPool(), doc->getCachedData()); },
+			doc->getPool());
+
+	if (!success) {
+		log::source().warn("DocumentCache", "Cache file is corrupted: ", info);
+		return nullptr;
+	}
+
+	return doc;
+}
+
+Rc<Document> DocumentCache::open(memory::pool_t *pool, const FileInfo &source,
+		const FileInfo &cache, StringView ct) {
+	auto hash = getSourceHash(source);
+	if (hash != 0) {
+		if (auto doc = load(pool, cache, hash)) {
+			return doc;
+		}
+	}
+
+	auto doc = Document::open(pool, source, ct);
+	if (doc && hash != 0) {
+		write(doc, cache, hash);
+	}
+	return doc;
+}
+
+} // namespace stappler::document
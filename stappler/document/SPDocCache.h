@@ -0,0 +1,67 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef CORE_DOCUMENT_SPDOCCACHE_H_
+#define CORE_DOCUMENT_SPDOCCACHE_H_
+
+#include "SPDocPageContainer.h"
+#include "SPFilesystemMap.h"
+
+namespace STAPPLER_VERSIONIZED stappler::document {
+
+/* Precompiled binary form of a parsed document
+ *
+ * Cache file contains node trees of all pages, compiled style rules, media queries,
+ * spine, table of contents and asset metadata (with embedded image and font data),
+ * all strings interned into a single table. Cache is loaded with MemoryMappedRegion:
+ * document strings, assets and embedded data are views into mapped file, nodes for
+ * each page are constructed within a single allocation.
+ *
+ * Cache is bound to the hash of the source data and rejected when it does not match,
+ * so caller can always fallback to the regular parser.
+ */
+class SP_PUBLIC DocumentCache : public InterfaceObject<memory::StandartInterface> {
+public:
+	static constexpr uint32_t Magic = 0x4344'5053; // 'SPDC'
+	static constexpr uint16_t Version = 2;
+
+	static uint64_t getSourceHash(BytesView);
+	static uint64_t getSourceHash(const FileInfo &);
+
+	// Writes cache file for the parsed document; file is replaced atomically
+	static bool write(const Document *, const FileInfo &, uint64_t sourceHash);
+
+	// Returns nullptr if cache does not exist, is corrupted or was built from other source
+	static Rc<Document> load(memory::pool_t *, const FileInfo &, uint64_t sourceHash);
+
+	// Loads document from cache if it's valid, parses source and writes new cache otherwise
+	static Rc<Document> open(memory::pool_t *, const FileInfo &source, const FileInfo &cache,
+			StringView ct = StringView());
+
+protected:
+	struct Writer;
+	struct Reader;
+};
+
+} // namespace stappler::document
+
+#endif /* CORE_DOCUMENT_SPDOCCACHE_H_ */
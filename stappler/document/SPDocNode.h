@@ -98,6 +98,8 @@ public:
 	WideString getValueRecursive() const;
 
 protected:
+	friend class DocumentCache;
+
 	void propagateValue();
 	void foreach (const ForeachIter &, size_t level);
 	void foreach (const ForeachConstIter &, size_t level) const;
@@ -68,6 +68,8 @@ public:
 	Node *getNodeById(StringView) const;
 
 protected:
+	friend class DocumentCache;
+
 	StringView _path;
 	String _title;
 	String _charset;
@@ -98,6 +98,8 @@ public:
 			const MediaParameters &media, const SpanView<bool> &resolved) const;
 
 protected:
+	friend class DocumentCache;
+
 	void import(StringReader &);
 
 	void readStyleParameters(const StringView &name, const StringView &value,
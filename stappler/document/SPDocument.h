@@ -36,6 +36,7 @@ constexpr NodeId NodeIdNone = maxOf<NodeId>();
 class Node;
 class StyleContainer;
 class PageContainer;
+class DocumentCache;
 
 using StringDocument = ValueWrapper<StringView, class StringDocumentTag>;
 
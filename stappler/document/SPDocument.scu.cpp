@@ -31,6 +31,7 @@
 #include "SPDocFormat.cc"
 #include "SPDocParser.cc"
 #include "SPDocAsset.cc"
+#include "SPDocCache.cc"
 
 #include "html/SPDocHtml.cc"
 #include "epub/SPDocEpub.cc"
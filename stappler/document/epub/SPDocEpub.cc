@@ -40,7 +40,7 @@ SP_USED static Format s_epubFormat([](memory::pool_t *, FileInfo str, StringView
 }, 0);
 
 bool DocumentEpub::isEpub(BytesView data) {
-	ZipArchive<memory::StandartInterface> zip(data, true);
+	ZipReader zip(data);
 	if (!zip) {
 		return false;
 	}
@@ -56,7 +56,7 @@ bool DocumentEpub::isEpub(BytesView data) {
 }
 
 bool DocumentEpub::isEpub(FileInfo path) {
-	ZipArchive<memory::StandartInterface> zip(path);
+	ZipReader zip(path);
 	if (!zip) {
 		return false;
 	}
@@ -173,7 +173,9 @@ bool DocumentEpub::processArchiveFiles(EpubData *epubData) {
 				auto fontIt =
 						epubData->fonts.emplace(it.second.path, DocumentFont(it.second.path)).first;
 				fontIt->second.ct = it.second.type;
-				fontIt->second.data = data;
+
+				// inflated data is released after callback
+				fontIt->second.data = data.pdup();
 			});
 		} else if (it.second.type.starts_with("text/html")
 				|| it.second.type.starts_with("application/xhtml+xml")) {
@@ -219,7 +221,7 @@ EpubData::EpubData(memory::pool_t *p, FileInfo info, StringView ct)
 }
 
 EpubData::EpubData(memory::pool_t *p, BytesView data, StringView ct)
-: DocumentData(p), archive(data, true) {
+: DocumentData(p), archive(data.pdup(p)) {
 	type = ct.pdup(p);
 }
 
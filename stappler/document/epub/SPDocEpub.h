@@ -25,7 +25,7 @@
 
 #include "SPDocument.h"
 #include "SPDocPageContainer.h" // IWYU pragma: keep
-#include "SPZip.h"
+#include "SPZipStream.h"
 #include "SPMemForwardList.h"
 
 namespace STAPPLER_VERSIONIZED stappler::document {
@@ -116,7 +116,7 @@ struct EpubArchiveFile {
 };
 
 struct SP_PUBLIC EpubData : DocumentData {
-	ZipArchive<memory::PoolInterface> archive;
+	ZipReader archive;
 	Map<StringView, EpubArchiveFile> archiveFiles;
 	StringView rootPath;
 
@@ -26,43 +26,336 @@
 
 namespace STAPPLER_VERSIONIZED stappler::font {
 
+struct HyphenMap::PackedTrie {
+	static constexpr uint32_t Invalid = maxOf<uint32_t>();
+
+	static std::unique_ptr<PackedTrie> compile(BytesView data);
+
+	uint32_t findChild(uint32_t node, char16_t c) const {
+		auto begin = edgeChars.begin() + edgeOffsets[node];
+		auto end = edgeChars.begin() + edgeOffsets[node + 1];
+		auto it = std::lower_bound(begin, end, c);
+		if (it != end && *it == c) {
+			return edgeTargets[it - edgeChars.begin()];
+		}
+		return Invalid;
+	}
+
+	Vector<uint8_t> hyphenate(const char16_t *ptr, size_t len) const;
+
+	uint8_t lhmin = 2;
+	uint8_t rhmin = 2;
+
+	// Node N owns edges in [edgeOffsets[N], edgeOffsets[N + 1]), sorted by char
+	Vector<uint32_t> edgeOffsets;
+	Vector<char16_t> edgeChars;
+	Vector<uint32_t> edgeTargets;
+
+	// Offset of [count][values...] record in points for pattern, that ends in node
+	Vector<uint32_t> pointsOffsets;
+	Vector<uint8_t> points;
+
+	Vector<WideString> nohyphen;
+};
+
+struct HyphenMap::WordCache {
+	struct Hash {
+		using is_transparent = void;
+
+		size_t operator()(std::u16string_view str) const {
+			return std::hash<std::u16string_view>()(str);
+		}
+	};
+
+	using Storage = std::unordered_map<WideString, Vector<uint8_t>, Hash, std::equal_to<>>;
+
+	bool get(std::u16string_view word, Vector<uint8_t> &out) {
+		std::unique_lock lock(mutex);
+		auto it = current.find(word);
+		if (it != current.end()) {
+			out = it->second;
+			return true;
+		}
+
+		it = previous.find(word);
+		if (it != previous.end()) {
+			out = it->second;
+			// promote word into current generation
+			current.insert(previous.extract(it));
+			return true;
+		}
+		return false;
+	}
+
+	void set(std::u16string_view word, const Vector<uint8_t> &value, size_t limit) {
+		std::unique_lock lock(mutex);
+		current.emplace(WideString(word), value);
+		if (current.size() >= std::max(limit / 2, size_t(1))) {
+			previous = sp::move(current);
+			current.clear();
+		}
+	}
+
+	void clear() {
+		std::unique_lock lock(mutex);
+		current.clear();
+		previous.clear();
+	}
+
+	std::mutex mutex;
+	Storage current;
+	Storage previous;
+};
+
+struct HyphenMap::Dict {
+	~Dict() {
+		if (dict) {
+			hnj_hyphen_free(dict);
+		}
+	}
+
+	HyphenDict *dict = nullptr;
+	std::unique_ptr<PackedTrie> trie;
+	WordCache cache;
+};
+
+auto HyphenMap::PackedTrie::compile(BytesView data) -> std::unique_ptr<PackedTrie> {
+	struct BuildNode {
+		Map<char16_t, uint32_t> childs;
+		uint32_t pattern = Invalid;
+	};
+
+	auto ret = std::make_unique<PackedTrie>();
+
+	Vector<BuildNode> nodes;
+	Vector<Vector<uint8_t>> patterns;
+	nodes.emplace_back();
+
+	StringView r(reinterpret_cast<const char *>(data.data()), data.size());
+
+	auto charset = r.readUntil<StringView::Chars<'\n', '\r'>>();
+	charset.trimChars<StringView::WhiteSpace>();
+
+	bool isUtf8 = false;
+	if (charset == "UTF-8") {
+		isUtf8 = true;
+	} else if (charset != "ISO8859-1") {
+		return nullptr;
+	}
+
+	auto decode = [&](StringView str) -> WideString {
+		if (isUtf8) {
+			return string::toUtf16<Interface>(str);
+		}
+		WideString ret;
+		ret.reserve(str.size());
+		for (auto c : str) { ret.push_back(char16_t(uint8_t(c))); }
+		return ret;
+	};
+
+	while (!r.empty()) {
+		auto line = r.readUntil<StringView::Chars<'\n', '\r'>>();
+		r.skipChars<StringView::Chars<'\n', '\r'>>();
+
+		line.trimChars<StringView::WhiteSpace>();
+		if (line.empty() || line[0] == '%' || line[0] == '#') {
+			continue;
+		}
+
+		auto token = line.readUntil<StringView::WhiteSpace>();
+		line.skipChars<StringView::WhiteSpace>();
+
+		if (token == "LEFTHYPHENMIN") {
+			ret->lhmin = uint8_t(line.readInteger(10).get(2));
+			continue;
+		} else if (token == "RIGHTHYPHENMIN") {
+			ret->rhmin = uint8_t(line.readInteger(10).get(2));
+			continue;
+		} else if (token == "COMPOUNDLEFTHYPHENMIN" || token == "COMPOUNDRIGHTHYPHENMIN") {
+			// compound boundaries are not tracked by packed trie
+			continue;
+		} else if (token == "NOHYPHEN") {
+			line.split<StringView::Chars<','>>([&](StringView str) {
+				if (!str.empty()) {
+					ret->nohyphen.emplace_back(decode(str));
+				}
+			});
+			continue;
+		} else if (token == "NEXTLEVEL" || memchr(token.data(), '/', token.size())) {
+			// multi-level dictionaries and non-standard patterns require libhyphen
+			return nullptr;
+		}
+
+		auto pattern = decode(token);
+
+		Vector<uint8_t> values;
+		values.emplace_back(0);
+
+		uint32_t node = 0;
+		for (auto c : pattern) {
+			if (c >= u'0' && c <= u'9') {
+				values.back() = uint8_t(c - u'0');
+			} else {
+				auto it = nodes[node].childs.find(c);
+				if (it == nodes[node].childs.end()) {
+					auto next = uint32_t(nodes.size());
+					nodes[node].childs.emplace(c, next);
+					nodes.emplace_back();
+					node = next;
+				} else {
+					node = it->second;
+				}
+				values.emplace_back(0);
+			}
+		}
+
+		if (node == 0 || values.size() > 255) {
+			continue;
+		}
+
+		if (nodes[node].pattern == Invalid) {
+			nodes[node].pattern = uint32_t(patterns.size());
+			patterns.emplace_back(sp::move(values));
+		} else {
+			// duplicated pattern, keep max values
+			auto &target = patterns[nodes[node].pattern];
+			for (size_t i = 0; i < values.size(); ++i) {
+				target[i] = std::max(target[i], values[i]);
+			}
+		}
+	}
+
+	// Flatten in BFS order, so edges for each node are stored contiguously
+	Vector<uint32_t> order;
+	Vector<uint32_t> index;
+	order.reserve(nodes.size());
+	index.resize(nodes.size(), Invalid);
+
+	order.emplace_back(0);
+	index[0] = 0;
+	for (size_t i = 0; i < order.size(); ++i) {
+		for (auto &it : nodes[order[i]].childs) {
+			index[it.second] = uint32_t(order.size());
+			order.emplace_back(it.second);
+		}
+	}
+
+	ret->edgeOffsets.reserve(order.size() + 1);
+	ret->edgeChars.reserve(nodes.size() - 1);
+	ret->edgeTargets.reserve(nodes.size() - 1);
+	ret->pointsOffsets.reserve(order.size());
+
+	for (auto &nodeId : order) {
+		auto &node = nodes[nodeId];
+		ret->edgeOffsets.emplace_back(uint32_t(ret->edgeChars.size()));
+		for (auto &it : node.childs) {
+			ret->edgeChars.emplace_back(it.first);
+			ret->edgeTargets.emplace_back(index[it.second]);
+		}
+
+		if (node.pattern != Invalid) {
+			auto &values = patterns[node.pattern];
+			ret->pointsOffsets.emplace_back(uint32_t(ret->points.size()));
+			ret->points.emplace_back(uint8_t(values.size()));
+			ret->points.insert(ret->points.end(), values.begin(), values.end());
+		} else {
+			ret->pointsOffsets.emplace_back(Invalid);
+		}
+	}
+	ret->edgeOffsets.emplace_back(uint32_t(ret->edgeChars.size()));
+
+	return ret;
+}
+
+auto HyphenMap::PackedTrie::hyphenate(const char16_t *ptr, size_t len) const -> Vector<uint8_t> {
+	// word is framed with '.', as in patterns; values[N] is a value before word[N]
+	char16_t word[256 + 2];
+	uint8_t values[256 + 3] = {0};
+
+	const size_t size = len + 2;
+	word[0] = u'.';
+	memcpy(word + 1, ptr, len * sizeof(char16_t));
+	word[len + 1] = u'.';
+
+	for (size_t i = 0; i < size; ++i) {
+		uint32_t node = 0;
+		for (size_t j = i; j < size; ++j) {
+			node = findChild(node, word[j]);
+			if (node == Invalid) {
+				break;
+			}
+
+			auto offset = pointsOffsets[node];
+			if (offset != Invalid) {
+				auto count = points[offset];
+				auto source = points.data() + offset + 1;
+				for (size_t k = 0; k < count; ++k) {
+					values[i + k] = std::max(values[i + k], source[k]);
+				}
+			}
+		}
+	}
+
+	// break after char N is defined with values[N + 2]
+	std::u16string_view view(ptr, len);
+	for (auto &it : nohyphen) {
+		auto pos = view.find(it);
+		while (pos != std::u16string_view::npos) {
+			values[pos + it.size() + 1] = 0;
+			if (pos > 0) {
+				values[pos + 1] = 0;
+			}
+			pos = view.find(it, pos + 1);
+		}
+	}
+
+	Vector<uint8_t> ret;
+	for (size_t i = 0; i + 1 < len; ++i) {
+		if ((values[i + 2] & 1) && i + 1 >= lhmin && len - (i + 1) >= rhmin) {
+			ret.push_back(uint8_t(i + 1));
+		}
+	}
+	return ret;
+}
+
 HyphenMap::~HyphenMap() {
 	for (auto &it : _dicts) {
-		hnj_hyphen_free(it.second);
+		delete it.second;
 	}
 }
+
 bool HyphenMap::init() {
 	return true;
 }
 
-void HyphenMap::addHyphenDict(CharGroupId id, const FileInfo &file) {
-	auto data = filesystem::readTextFile<Interface>(file);
+void HyphenMap::addHyphenDict(CharGroupId id, const FileInfo &file, DictMode mode) {
+	auto data = filesystem::readIntoMemory<Interface>(file);
 	if (!data.empty()) {
-		auto dict = hnj_hyphen_load_data(data.data(), data.size());
-		if (dict) {
-			auto it = _dicts.find(id);
-			if (it == _dicts.end()) {
-				_dicts.emplace(id, dict);
-			} else {
-				hnj_hyphen_free(it->second);
-				it->second = dict;
-			}
-		}
+		addHyphenDict(id, data, mode);
 	}
 }
 
-void HyphenMap::addHyphenDict(CharGroupId id, BytesView data) {
-	if (!data.empty()) {
-		auto dict = hnj_hyphen_load_data((const char *)data.data(), data.size());
-		if (dict) {
-			auto it = _dicts.find(id);
-			if (it == _dicts.end()) {
-				_dicts.emplace(id, dict);
-			} else {
-				hnj_hyphen_free(it->second);
-				it->second = dict;
-			}
+void HyphenMap::addHyphenDict(CharGroupId id, BytesView data, DictMode mode) {
+	if (data.empty()) {
+		return;
+	}
+
+	if (mode == DictMode::PackedTrie) {
+		if (auto trie = PackedTrie::compile(data)) {
+			auto dict = new Dict;
+			dict->trie = sp::move(trie);
+			emplaceDict(id, dict);
+			return;
 		}
+		log::source().warn("HyphenMap", "Fail to compile packed trie for dictionary, ",
+				"libhyphen state machine will be used");
+	}
+
+	auto hdict = hnj_hyphen_load_data((const char *)data.data(), data.size());
+	if (hdict) {
+		auto dict = new Dict;
+		dict->dict = hdict;
+		emplaceDict(id, dict);
 	}
 }
 
@@ -71,7 +364,9 @@ auto HyphenMap::makeWordHyphens(const char16_t *ptr, size_t len) -> Vector<uint8
 		return Vector<uint8_t>();
 	}
 
-	HyphenDict *dict = nullptr;
+	std::shared_lock lock(_mutex);
+
+	Dict *dict = nullptr;
 	for (auto &it : _dicts) {
 		if (inCharGroup(it.first, ptr[0])) {
 			dict = it.second;
@@ -83,20 +378,97 @@ auto HyphenMap::makeWordHyphens(const char16_t *ptr, size_t len) -> Vector<uint8
 		return Vector<uint8_t>();
 	}
 
-	String word = convertWord(dict, ptr, len);
+	auto limit = _cacheLimit.load();
+	auto word = std::u16string_view(ptr, len);
+
+	Vector<uint8_t> ret;
+	if (limit > 0 && dict->cache.get(word, ret)) {
+		return ret;
+	}
+
+	ret = hyphenate(dict, ptr, len);
+
+	if (limit > 0) {
+		dict->cache.set(word, ret, limit);
+	}
+	return ret;
+}
+
+auto HyphenMap::makeWordHyphens(const WideStringView &r) -> Vector<uint8_t> {
+	return makeWordHyphens(r.data(), r.size());
+}
+
+void HyphenMap::purgeHyphenDicts() {
+	std::unique_lock lock(_mutex);
+	for (auto &it : _dicts) {
+		delete it.second;
+	}
+	_dicts.clear();
+}
+
+void HyphenMap::setCacheLimit(size_t limit) {
+	_cacheLimit.store(limit);
+	if (limit == 0) {
+		purgeCache();
+	}
+}
+
+void HyphenMap::purgeCache() {
+	std::shared_lock lock(_mutex);
+	for (auto &it : _dicts) {
+		it.second->cache.clear();
+	}
+}
+
+auto HyphenMap::convertWord(HyphenDict *dict, const char16_t *ptr, size_t len) -> String {
+	if (dict->utf8) {
+		return string::toUtf8<Interface>(WideStringView(ptr, len));
+	} else {
+		if (strcmp("KOI8-R", dict->cset) == 0) {
+			return string::toKoi8r<Interface>(WideStringView(ptr, len));
+		}
+
+		return String();
+	}
+}
+
+auto HyphenMap::hyphenate(Dict *dict, const char16_t *ptr, size_t len) -> Vector<uint8_t> {
+	if (dict->trie) {
+		return dict->trie->hyphenate(ptr, len);
+	}
+
+	String word = convertWord(dict->dict, ptr, len);
 	if (!word.empty()) {
 		Vector<char> buf; buf.resize(word.size() + 5);
 
 		char ** rep = nullptr;
 		int * pos = nullptr;
 		int * cut = nullptr;
-		hnj_hyphen_hyphenate2(dict, word.data(), int(word.size()), buf.data(), nullptr, &rep, &pos, &cut);
+		hnj_hyphen_hyphenate2(dict->dict, word.data(), int(word.size()), buf.data(), nullptr, &rep, &pos, &cut);
+
+		if (rep) {
+			for (size_t i = 0; i < word.size(); ++i) {
+				if (rep[i]) {
+					::free(rep[i]);
+				}
+			}
+			::free(rep);
+			::free(pos);
+			::free(cut);
+		}
+
+		// libhyphen counts LEFTHYPHENMIN and RIGHTHYPHENMIN in the converted word with
+		// adjustments for ligatures and digits, so limits are applied again on UTF-16 positions,
+		// as in PackedTrie mode
+		auto lhmin = size_t(dict->dict->lhmin > 0 ? dict->dict->lhmin : 2);
+		auto rhmin = size_t(dict->dict->rhmin > 0 ? dict->dict->rhmin : 2);
 
 		Vector<uint8_t> ret;
 		uint8_t i = 0;
 		for (auto &it : buf) {
 			if (it > 0) {
-				if ((it - '0') % 2 == 1) {
+				auto brk = size_t(i + 1);
+				if ((it - '0') % 2 == 1 && brk >= lhmin && brk < len && len - brk >= rhmin) {
 					ret.push_back(i + 1);
 				}
 			} else {
@@ -109,25 +481,14 @@ auto HyphenMap::makeWordHyphens(const char16_t *ptr, size_t len) -> Vector<uint8
 	return Vector<uint8_t>();
 }
 
-auto HyphenMap::makeWordHyphens(const WideStringView &r) -> Vector<uint8_t> {
-	return makeWordHyphens(r.data(), r.size());
-}
-
-void HyphenMap::purgeHyphenDicts() {
-	for (auto &it : _dicts) {
-		hnj_hyphen_free(it.second);
-	}
-}
-
-auto HyphenMap::convertWord(HyphenDict *dict, const char16_t *ptr, size_t len) -> String {
-	if (dict->utf8) {
-		return string::toUtf8<Interface>(WideStringView(ptr, len));
+void HyphenMap::emplaceDict(CharGroupId id, Dict *dict) {
+	std::unique_lock lock(_mutex);
+	auto it = _dicts.find(id);
+	if (it == _dicts.end()) {
+		_dicts.emplace(id, dict);
 	} else {
-		if (strcmp("KOI8-R", dict->cset) == 0) {
-			return string::toKoi8r<Interface>(WideStringView(ptr, len));
-		}
-
-		return String();
+		delete it->second;
+		it->second = dict;
 	}
 }
 
@@ -26,25 +26,55 @@
 #include "SPFont.h"
 #include "SPFilepath.h"
 
+#include <shared_mutex>
+
 typedef struct _HyphenDict HyphenDict;
 
 namespace STAPPLER_VERSIONIZED stappler::font {
 
 class SP_PUBLIC HyphenMap : public Ref, public InterfaceObject<memory::StandartInterface> {
 public:
+	// Words, cached for each language; older half of cache is dropped on overflow
+	static constexpr size_t DefaultCacheLimit = 16 * 1'024;
+
+	enum class DictMode {
+		// Use libhyphen state machine with conversion into dictionary encoding
+		Native,
+
+		// Compile patterns into UTF-16 packed trie; dictionaries with non-standard patterns
+		// or NEXTLEVEL sections, and encodings other than UTF-8 or ISO8859-1
+		// fall back to Native mode
+		PackedTrie,
+	};
+
 	virtual ~HyphenMap();
 	bool init();
 
-	void addHyphenDict(CharGroupId id, const FileInfo &file);
-	void addHyphenDict(CharGroupId id, BytesView data);
+	void addHyphenDict(CharGroupId id, const FileInfo &file, DictMode = DictMode::Native);
+	void addHyphenDict(CharGroupId id, BytesView data, DictMode = DictMode::Native);
 	Vector<uint8_t> makeWordHyphens(const char16_t *ptr, size_t len);
 	Vector<uint8_t> makeWordHyphens(const WideStringView &);
 	void purgeHyphenDicts();
 
+	// Max number of cached words per language, 0 to disable caching
+	void setCacheLimit(size_t);
+	size_t getCacheLimit() const { return _cacheLimit.load(); }
+
+	void purgeCache();
+
 protected:
+	struct PackedTrie;
+	struct WordCache;
+	struct Dict;
+
 	String convertWord(HyphenDict *, const char16_t *ptr, size_t len);
+	Vector<uint8_t> hyphenate(Dict *, const char16_t *ptr, size_t len);
+
+	void emplaceDict(CharGroupId id, Dict *);
 
-	Map<CharGroupId, HyphenDict *> _dicts;
+	mutable std::shared_mutex _mutex;
+	std::atomic<size_t> _cacheLimit = DefaultCacheLimit;
+	Map<CharGroupId, Dict *> _dicts;
 };
 
 }
@@ -23,6 +23,8 @@
 #include "SPColorCam16.h"
 #include "SPColorHCT.h"
 
+#include <optional>
+
 namespace STAPPLER_VERSIONIZED stappler::geom {
 
 struct Cam16Vec3 {
@@ -610,22 +612,40 @@ static Cam16Float InverseChromaticAdaptation(Cam16Float adapted) {
 	return Cam16::signum(adapted) * std::pow(base, Cam16Float(1.0 / 0.42));
 }
 
-static Color4F FindResultByJ(Cam16Float hue_radians, Cam16Float chroma, Cam16Float y) {
+// Hue-dependent terms of FindResultByJ, shared between colors of the same hue in batches
+struct HueTerms {
+	Cam16Float hue_degrees;
+	Cam16Float hue_radians;
+	Cam16Float p1;
+	Cam16Float h_sin;
+	Cam16Float h_cos;
+
+	explicit HueTerms(Cam16Float degrees)
+	: hue_degrees(degrees), hue_radians(degrees / 180 * sprt::numbers::Pi<Cam16Float>) {
+		const Cam16Float e_hue = 0.25 * (std::cos(hue_radians + Cam16Float(2.0)) + 3.8);
+		p1 = e_hue * (50000.0 / 13.0) * ViewingConditions::DEFAULT.n_c
+				* ViewingConditions::DEFAULT.ncb;
+		h_sin = std::sin(hue_radians);
+		h_cos = std::cos(hue_radians);
+	}
+};
+
+static const Cam16Float s_tInnerCoeff = 1
+		/ std::pow(Cam16Float(1.64)
+						- std::pow(Cam16Float(0.29),
+								ViewingConditions::DEFAULT.background_y_to_white_point_y),
+				Cam16Float(0.73));
+
+static Color4F FindResultByJ(const HueTerms &hue, Cam16Float chroma, Cam16Float y) {
 	// Initial estimate of j.
 	Cam16Float j = std::sqrt(y) * 11.0;
 	// ===========================================================
 	// Operations inlined from Cam16 to avoid repeated calculation
 	// ===========================================================
-	const Cam16Float t_inner_coeff = 1
-			/ std::pow(Cam16Float(1.64)
-							- std::pow(Cam16Float(0.29),
-									ViewingConditions::DEFAULT.background_y_to_white_point_y),
-					Cam16Float(0.73));
-	const Cam16Float e_hue = 0.25 * (std::cos(hue_radians + Cam16Float(2.0)) + 3.8);
-	const Cam16Float p1 = e_hue * (50000.0 / 13.0) * ViewingConditions::DEFAULT.n_c
-			* ViewingConditions::DEFAULT.ncb;
-	const Cam16Float h_sin = std::sin(hue_radians);
-	const Cam16Float h_cos = std::cos(hue_radians);
+	const Cam16Float t_inner_coeff = s_tInnerCoeff;
+	const Cam16Float p1 = hue.p1;
+	const Cam16Float h_sin = hue.h_sin;
+	const Cam16Float h_cos = hue.h_cos;
 	for (int iteration_round = 0; iteration_round < 5; ++iteration_round) {
 		// ===========================================================
 		// Operations inlined from Cam16 to avoid repeated calculation
@@ -706,30 +726,100 @@ static void fixTone(Cam16Float &h, Cam16Float &c, Cam16Float &t, Color4F &color)
 	}
 }
 
-static Color4F SolveToColor4F(Cam16Float hue_degrees, Cam16Float chroma, Cam16Float lstar) {
-	if (chroma < 0.0001 || lstar < 0.0001 || lstar > 99.9999) {
+static bool IsAchromatic(Cam16Float chroma, Cam16Float lstar) {
+	return chroma < 0.0001 || lstar < 0.0001 || lstar > 99.9999;
+}
+
+static Color4F SolveToColor4F(const HueTerms &hue, Cam16Float chroma, Cam16Float lstar) {
+	if (IsAchromatic(chroma, lstar)) {
 		return Color4FFromLstar(lstar);
 	}
 
-	hue_degrees = Cam16::sanitizeDegrees(hue_degrees);
+	Cam16Float hue_degrees = hue.hue_degrees;
 	//fixTone(hue_degrees, chroma, lstar);
-	Cam16Float hue_radians = hue_degrees / 180 * sprt::numbers::Pi<Cam16Float>;
 	Cam16Float y = ViewingConditions::YFromLstar(lstar);
-	Color4F exact_answer = FindResultByJ(hue_radians, chroma, y);
+	Color4F exact_answer = FindResultByJ(hue, chroma, y);
 	if (exact_answer != Color4F::BLACK) {
 		return exact_answer;
 	}
-	Cam16Vec3 linrgb = BisectToLimit(y, hue_radians);
+	Cam16Vec3 linrgb = BisectToLimit(y, hue.hue_radians);
 	auto ret = Color4FFromLinrgb(linrgb);
 	fixTone(hue_degrees, chroma, lstar, ret);
 	return ret;
 }
 
+static Color4F SolveToColor4F(Cam16Float hue_degrees, Cam16Float chroma, Cam16Float lstar) {
+	if (IsAchromatic(chroma, lstar)) {
+		return Color4FFromLstar(lstar);
+	}
+
+	return SolveToColor4F(HueTerms(Cam16::sanitizeDegrees(hue_degrees)), chroma, lstar);
+}
+
+static bool IsSameColor(const ColorHCT::Values &a, const ColorHCT::Values &b) {
+	return a.hue == b.hue && a.chroma == b.chroma && a.tone == b.tone;
+}
+
+static ColorHCT::Values ProgressValues(const ColorHCT::Values &a, const ColorHCT::Values &b,
+		float p) {
+	return ColorHCT::Values{
+		Cam16::sanitizeDegrees(a.hue * (1.0f - p) + b.hue * p),
+		a.chroma * (1.0f - p) + b.chroma * p,
+		a.tone * (1.0f - p) + b.tone * p,
+		a.alpha * (1.0f - p) + b.alpha * p,
+	};
+}
+
+// Returns true if result is known without solving
+static bool ProgressTrivial(const ColorHCT &a, const ColorHCT &b, float p, ColorHCT &target) {
+	if (p <= 0.0f) {
+		target = ColorHCT(a.data, a.color);
+		return true;
+	} else if (p >= 1.0f) {
+		target = ColorHCT(b.data, b.color);
+		return true;
+	} else if (IsSameColor(a.data, b.data)) {
+		// only alpha is animated, color is the same
+		target = ColorHCT(ProgressValues(a.data, b.data, p), a.color);
+		return true;
+	}
+	return false;
+}
+
 ColorHCT ColorHCT::progress(const ColorHCT &a, const ColorHCT &b, float p) {
-	return ColorHCT((a.data.hue * (1.0f - p) + b.data.hue * p),
-			(a.data.chroma * (1.0f - p) + b.data.chroma * p),
-			(a.data.tone * (1.0f - p) + b.data.tone * p),
-			(a.data.alpha * (1.0f - p) + b.data.alpha * p));
+	ColorHCT ret;
+	if (ProgressTrivial(a, b, p, ret)) {
+		return ret;
+	}
+	return ColorHCT(ProgressValues(a.data, b.data, p));
+}
+
+void ColorHCT::progress(const ColorHCT *a, const ColorHCT *b, float p, ColorHCT *target,
+		size_t count) {
+	static constexpr size_t BatchSize = 16;
+
+	Values values[BatchSize];
+	Color4F colors[BatchSize];
+	size_t indexes[BatchSize];
+
+	size_t i = 0;
+	while (i < count) {
+		size_t n = 0;
+		for (; i < count && n < BatchSize; ++i) {
+			if (!ProgressTrivial(a[i], b[i], p, target[i])) {
+				values[n] = ProgressValues(a[i].data, b[i].data, p);
+				indexes[n] = i;
+				++n;
+			}
+		}
+
+		if (n > 0) {
+			solveColor4F(SpanView<Values>(values, n), colors);
+			for (size_t j = 0; j < n; ++j) {
+				target[indexes[j]] = ColorHCT(values[j], colors[j]);
+			}
+		}
+	}
 }
 
 ColorHCT ColorHCT::solveColorHCT(Cam16Float h, Cam16Float c, Cam16Float t, float a) {
@@ -744,6 +834,91 @@ Color4F ColorHCT::solveColor4F(Cam16Float h, Cam16Float c, Cam16Float t, float a
 	return tmp;
 }
 
+void ColorHCT::solveColor4F(SpanView<Values> values, Color4F *target) {
+	std::optional<HueTerms> hue;
+	const Values *prev = nullptr;
+
+	for (size_t i = 0; i < values.size(); ++i) {
+		auto &v = values[i];
+		if (prev && IsSameColor(*prev, v)) {
+			target[i] = target[i - 1];
+		} else if (IsAchromatic(v.chroma, v.tone)) {
+			target[i] = Color4FFromLstar(v.tone);
+		} else {
+			auto degrees = Cam16::sanitizeDegrees(v.hue);
+			if (!hue || hue->hue_degrees != degrees) {
+				hue.emplace(degrees);
+			}
+			target[i] = SolveToColor4F(*hue, v.chroma, v.tone);
+		}
+		target[i].a = v.alpha;
+		prev = &v;
+	}
+}
+
+void ColorHCT::solveColorHCT(SpanView<Values> values, ColorHCT *target) {
+	static constexpr size_t BatchSize = 16;
+
+	Color4F colors[BatchSize];
+	while (!values.empty()) {
+		auto n = std::min(values.size(), BatchSize);
+		auto batch = values.sub(0, n);
+		solveColor4F(batch, colors);
+		for (size_t i = 0; i < n; ++i) { *target++ = ColorHCT(colors[i]); }
+		values.offset(n);
+	}
+}
+
+ColorHCTToneTable::ColorHCTToneTable(Cam16Float hue, Cam16Float chroma, float maxError)
+: _hue(Cam16::sanitizeDegrees(hue)), _chroma(chroma) {
+	const HueTerms terms(_hue);
+
+	auto solve = [&](Cam16Float tone) { return SolveToColor4F(terms, _chroma, tone); };
+
+	uint32_t steps = MinSteps;
+	while (true) {
+		_colors.resize(steps + 1);
+		for (uint32_t i = 0; i <= steps; ++i) {
+			_colors[i] = solve(Cam16Float(100) * i / steps);
+		}
+
+		// measure error in the middle between steps, where linear interpolation is worst
+		_maxError = 0.0f;
+		for (uint32_t i = 0; i < steps; ++i) {
+			auto exact = solve(Cam16Float(100) * (i + 0.5f) / steps);
+			auto &l = _colors[i];
+			auto &r = _colors[i + 1];
+			_maxError = std::max(_maxError, std::fabs((l.r + r.r) * 0.5f - exact.r));
+			_maxError = std::max(_maxError, std::fabs((l.g + r.g) * 0.5f - exact.g));
+			_maxError = std::max(_maxError, std::fabs((l.b + r.b) * 0.5f - exact.b));
+		}
+
+		if (_maxError <= maxError || steps >= MaxSteps) {
+			break;
+		}
+		steps *= 2;
+	}
+}
+
+Color4F ColorHCTToneTable::get(Cam16Float tone, float alpha) const {
+	if (_colors.empty()) {
+		return ColorHCT::solveColor4F(_hue, _chroma, tone, alpha);
+	}
+
+	const auto steps = _colors.size() - 1;
+	const auto pos = std::clamp(tone, Cam16Float(0), Cam16Float(100)) * steps / Cam16Float(100);
+	const auto idx = std::min(size_t(pos), steps - 1);
+	const auto p = float(pos - idx);
+
+	auto ret = _colors[idx] * (1.0f - p) + _colors[idx + 1] * p;
+	ret.a = alpha;
+	return ret;
+}
+
+ColorHCT ColorHCTToneTable::hct(Cam16Float tone, float alpha) const {
+	return ColorHCT(ColorHCT::Values{_hue, _chroma, tone, alpha}, get(tone, alpha));
+}
+
 std::ostream &operator<<(std::ostream &stream, const ColorHCT &obj) {
 	stream << "ColorHCT(h:" << obj.data.hue << " c:" << obj.data.chroma << " t:" << obj.data.tone
 		   << " a:" << obj.data.alpha << ");";
@@ -42,10 +42,19 @@ struct alignas(16) ColorHCT {
 
 	static ColorHCT progress(const ColorHCT &a, const ColorHCT &b, float p);
 
+	// interpolates arrays of colors, only changed colors are solved, as a single batch
+	static void progress(const ColorHCT *a, const ColorHCT *b, float p, ColorHCT *target,
+			size_t count);
+
 	// returns closest possible HCT, that can be represented in sRGB by given HCT
 	static ColorHCT solveColorHCT(Cam16Float h, Cam16Float c, Cam16Float t, float a);
 	static Color4F solveColor4F(Cam16Float h, Cam16Float c, Cam16Float t, float a);
 
+	// solves colors as a batch; hue-dependent terms are shared between consecutive values
+	// with the same hue, repeated values are solved once
+	static void solveColor4F(SpanView<Values>, Color4F *target);
+	static void solveColorHCT(SpanView<Values>, ColorHCT *target);
+
 	constexpr ColorHCT() : data({0.0f, 50.0f, 0.0f, 1.0f}), color(Color4F::BLACK) { }
 
 	ColorHCT(float h, float c, float t, float a)
@@ -57,6 +66,9 @@ struct alignas(16) ColorHCT {
 	: data(d)
 	, color(solveColor4F(Cam16::sanitizeDegrees(data.hue), data.chroma, data.tone, data.alpha)) { }
 
+	// for the values, that was already solved into color
+	ColorHCT(const Values &d, const Color4F &c) : data(d), color(c) { color.a = d.alpha; }
+
 	explicit ColorHCT(const Color4F &c) {
 		auto cam = Cam16::create(c);
 		data.hue = cam.hue;
@@ -85,6 +97,37 @@ struct alignas(16) ColorHCT {
 	Color4F color;
 };
 
+/* Precomputed tone ramp for a fixed hue and chroma
+ *
+ * Ramp is interpolated linearly in sRGB. Number of steps is doubled until error, measured
+ * against exact solution between every two steps, fits into requested bound (or MaxSteps
+ * is reached, use getMaxError to check actual error).
+ */
+class SP_PUBLIC ColorHCTToneTable {
+public:
+	static constexpr uint32_t MinSteps = 32;
+	static constexpr uint32_t MaxSteps = 1'024;
+
+	ColorHCTToneTable() = default;
+	ColorHCTToneTable(Cam16Float hue, Cam16Float chroma, float maxError = 0.5f / 255.0f);
+
+	Color4F get(Cam16Float tone, float alpha = 1.0f) const;
+	ColorHCT hct(Cam16Float tone, float alpha = 1.0f) const;
+
+	Cam16Float getHue() const { return _hue; }
+	Cam16Float getChroma() const { return _chroma; }
+	float getMaxError() const { return _maxError; }
+	uint32_t getSteps() const { return uint32_t(_colors.size()) - 1; }
+
+	bool empty() const { return _colors.empty(); }
+
+protected:
+	Cam16Float _hue = 0.0f;
+	Cam16Float _chroma = 0.0f;
+	float _maxError = 0.0f;
+	std::vector<Color4F> _colors;
+};
+
 SP_PUBLIC std::ostream &operator<<(std::ostream &stream, const ColorHCT &obj);
 
 } // namespace stappler::geom
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "SPGeometry.cc"
 #include "SPMat4.cc"
 #include "SPQuaternion.cc"
+#include "SPSIMDBatch.cc"
 #include "SPVec2.cc"
 #include "SPVec3.cc"
 #include "SPVec4.cc"
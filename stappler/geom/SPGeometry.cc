@@ -299,4 +299,11 @@ Rect TransformRect(const Rect &rect, const Mat4 &transform) {
 	return Rect(minX, minY, (maxX - minX), (maxY - minY));
 }
 
+void TransformRects(const Rect *src, Rect *dst, size_t count, const Mat4 &transform) {
+	static_assert(sizeof(Rect) == sizeof(float) * 4, "Rect should be packed as (x, y, width, height)");
+
+	simd::transformRectBatch(transform.m, &src->origin.x, sizeof(Rect), &dst->origin.x,
+			sizeof(Rect), count);
+}
+
 } // namespace stappler::geom
@@ -461,6 +461,9 @@ constexpr Rect Rect::ZERO = Rect(0.0f, 0.0f, 0.0f, 0.0f);
 
 SP_PUBLIC Rect TransformRect(const Rect &rect, const Mat4 &transform);
 
+// Batched TransformRect, src and dst can be the same array
+SP_PUBLIC void TransformRects(const Rect *src, Rect *dst, size_t count, const Mat4 &transform);
+
 inline const CallbackStream &operator<<(const CallbackStream &stream, const Rect &obj) {
 	stream << "Rect(x:" << obj.origin.x << " y:" << obj.origin.y << " width:" << obj.size.width
 		   << " height:" << obj.size.height << ");";
@@ -28,6 +28,7 @@ This file was modified for stappler project
 #include "SPVec2.h"
 #include "SPVec3.h"
 #include "SPVec4.h"
+#include "SPSIMDBatch.h"
 
 namespace STAPPLER_VERSIONIZED stappler::geom {
 
@@ -153,6 +154,11 @@ public:
 		simd::subtractMat4(m1.m, m2.m, dst->m);
 	}
 
+	// dst[i] = mat * src[i], src and dst can be the same array
+	static void multiply(const Mat4 &mat, const Mat4 *src, Mat4 *dst, size_t count) {
+		simd::multiplyMat4Batch(mat.m, src->m, sizeof(Mat4), dst->m, sizeof(Mat4), count);
+	}
+
 	float m[16];
 
 	constexpr Mat4() { *this = IDENTITY; }
@@ -260,6 +266,14 @@ public:
 		simd::transformVec4(m, &vector.x, &dst->x);
 	}
 
+	// Batched forms, src and dst can be the same array
+	void transformPoints(const Vec2 *src, Vec2 *dst, size_t count) const {
+		simd::transformVec2Batch(m, &src->x, sizeof(Vec2), &dst->x, sizeof(Vec2), count);
+	}
+	void transformVectors(const Vec4 *src, Vec4 *dst, size_t count) const {
+		simd::transformVec4Batch(m, &src->x, sizeof(Vec4), &dst->x, sizeof(Vec4), count);
+	}
+
 	void translate(float x, float y, float z);
 	void translate(float x, float y, float z, Mat4 *dst) const;
 	void translate(const Vec3 &t);
@@ -0,0 +1,854 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "SPSIMDBatch.h"
+#include "SPSIMD_Sse.h"
+
+#if (__x86_64__ || __i386__) && (__GNUC__ || __clang__)
+#define SP_SIMD_BATCH_AVX2 1
+#include <immintrin.h>
+#else
+#define SP_SIMD_BATCH_AVX2 0
+#endif
+
+#if __aarch64__
+#define SP_SIMD_BATCH_NEON 1
+#include <arm_neon.h>
+#else
+#define SP_SIMD_BATCH_NEON 0
+#endif
+
+namespace STAPPLER_VERSIONIZED stappler::simd {
+
+template <typename T>
+static inline T *Batch_at(T *ptr, size_t stride, size_t idx) {
+	using Byte = std::conditional_t<std::is_const_v<T>, const uint8_t, uint8_t>;
+	return reinterpret_cast<T *>(reinterpret_cast<Byte *>(ptr) + stride * idx);
+}
+
+static inline void Batch_rectBounds(float x0, float x1, float x2, float x3, float y0, float y1,
+		float y2, float y3, float *dst) {
+	const float minX = std::min(std::min(x0, x1), std::min(x2, x3));
+	const float maxX = std::max(std::max(x0, x1), std::max(x2, x3));
+	const float minY = std::min(std::min(y0, y1), std::min(y2, y3));
+	const float maxY = std::max(std::max(y0, y1), std::max(y2, y3));
+
+	dst[0] = minX;
+	dst[1] = minY;
+	dst[2] = maxX - minX;
+	dst[3] = maxY - minY;
+}
+
+namespace batch_scalar {
+
+static void transformVec2(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	const float tx = m[8] + m[12];
+	const float ty = m[9] + m[13];
+	for (size_t i = 0; i < count; ++i) {
+		auto s = Batch_at(src, srcStride, i);
+		auto d = Batch_at(dst, dstStride, i);
+		const float x = s[0];
+		const float y = s[1];
+		d[0] = m[0] * x + m[4] * y + tx;
+		d[1] = m[1] * x + m[5] * y + ty;
+	}
+}
+
+static void transformVec4(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		auto s = Batch_at(src, srcStride, i);
+		auto d = Batch_at(dst, dstStride, i);
+		const float x = s[0];
+		const float y = s[1];
+		const float z = s[2];
+		const float w = s[3];
+		for (size_t r = 0; r < 4; ++r) {
+			d[r] = m[r] * x + m[4 + r] * y + m[8 + r] * z + m[12 + r] * w;
+		}
+	}
+}
+
+static void multiplyMat4(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	float tmp[16];
+	for (size_t i = 0; i < count; ++i) {
+		auto s = Batch_at(src, srcStride, i);
+		auto d = Batch_at(dst, dstStride, i);
+		for (size_t c = 0; c < 4; ++c) {
+			for (size_t r = 0; r < 4; ++r) {
+				tmp[c * 4 + r] = m[r] * s[c * 4] + m[4 + r] * s[c * 4 + 1]
+						+ m[8 + r] * s[c * 4 + 2] + m[12 + r] * s[c * 4 + 3];
+			}
+		}
+		memcpy(d, tmp, sizeof(tmp));
+	}
+}
+
+static void transformRect(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	const float tx = m[8] + m[12];
+	const float ty = m[9] + m[13];
+	for (size_t i = 0; i < count; ++i) {
+		auto s = Batch_at(src, srcStride, i);
+		const float l = s[0];
+		const float t = s[1];
+		const float r = l + s[2];
+		const float b = t + s[3];
+
+		Batch_rectBounds(m[0] * l + m[4] * t + tx, m[0] * r + m[4] * t + tx,
+				m[0] * l + m[4] * b + tx, m[0] * r + m[4] * b + tx, m[1] * l + m[5] * t + ty,
+				m[1] * r + m[5] * t + ty, m[1] * l + m[5] * b + ty, m[1] * r + m[5] * b + ty,
+				Batch_at(dst, dstStride, i));
+	}
+}
+
+static void transformVec2SoA(const float m[16], const float *x, const float *y, float *dstX,
+		float *dstY, size_t count) {
+	const float tx = m[8] + m[12];
+	const float ty = m[9] + m[13];
+	for (size_t i = 0; i < count; ++i) {
+		const float vx = x[i];
+		const float vy = y[i];
+		dstX[i] = m[0] * vx + m[4] * vy + tx;
+		dstY[i] = m[1] * vx + m[5] * vy + ty;
+	}
+}
+
+static void transformVec4SoA(const float m[16], const float *const src[4], float *const dst[4],
+		size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		const float x = src[0][i];
+		const float y = src[1][i];
+		const float z = src[2][i];
+		const float w = src[3][i];
+		for (size_t r = 0; r < 4; ++r) {
+			dst[r][i] = m[r] * x + m[4 + r] * y + m[8 + r] * z + m[12 + r] * w;
+		}
+	}
+}
+
+static void transformRectSoA(const float m[16], const float *const src[4], float *const dst[4],
+		size_t count) {
+	float tmp[4];
+	for (size_t i = 0; i < count; ++i) {
+		float rect[4] = {src[0][i], src[1][i], src[2][i], src[3][i]};
+		transformRect(m, rect, 0, tmp, 0, 1);
+		dst[0][i] = tmp[0];
+		dst[1][i] = tmp[1];
+		dst[2][i] = tmp[2];
+		dst[3][i] = tmp[3];
+	}
+}
+
+static void advanceTimeSoA(float *elapsed, const float *rate, const float *invDuration,
+		float *progress, float dt, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		const float e = elapsed[i] + rate[i] * dt;
+		elapsed[i] = e;
+		progress[i] = std::min(e * invDuration[i], 1.0f);
+	}
+}
+
+static void lerpSoA(const float *from, const float *delta, const float *t, float *dst,
+		size_t count) {
+	for (size_t i = 0; i < count; ++i) { dst[i] = from[i] + delta[i] * t[i]; }
+}
+
+static constexpr BatchKernels Kernels{BatchBackend::Scalar, &transformVec2, &transformVec4,
+	&multiplyMat4, &transformRect, &transformVec2SoA, &transformVec4SoA, &transformRectSoA,
+	&advanceTimeSoA, &lerpSoA};
+
+} // namespace batch_scalar
+
+namespace batch_sse {
+
+using namespace simd::sse;
+
+static inline void loadMat4u(const float m[16], simde__m128 dst[4]) {
+	dst[0] = simde_mm_loadu_ps(&m[0]);
+	dst[1] = simde_mm_loadu_ps(&m[4]);
+	dst[2] = simde_mm_loadu_ps(&m[8]);
+	dst[3] = simde_mm_loadu_ps(&m[12]);
+}
+
+static inline simde__m128 hmin(simde__m128 v) {
+	v = simde_mm_min_ps(v, simde_mm_shuffle_ps(v, v, SIMDE_MM_SHUFFLE(2, 3, 0, 1)));
+	return simde_mm_min_ps(v, simde_mm_shuffle_ps(v, v, SIMDE_MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+static inline simde__m128 hmax(simde__m128 v) {
+	v = simde_mm_max_ps(v, simde_mm_shuffle_ps(v, v, SIMDE_MM_SHUFFLE(2, 3, 0, 1)));
+	return simde_mm_max_ps(v, simde_mm_shuffle_ps(v, v, SIMDE_MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+static void transformVec2(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	const simde__m128 c0 = simde_mm_loadu_ps(&m[0]);
+	const simde__m128 c1 = simde_mm_loadu_ps(&m[4]);
+	const simde__m128 t = simde_mm_add_ps(simde_mm_loadu_ps(&m[8]), simde_mm_loadu_ps(&m[12]));
+
+	for (size_t i = 0; i < count; ++i) {
+		auto s = Batch_at(src, srcStride, i);
+		auto r = simde_mm_add_ps(
+				simde_mm_add_ps(simde_mm_mul_ps(c0, simde_mm_set1_ps(s[0])),
+						simde_mm_mul_ps(c1, simde_mm_set1_ps(s[1]))),
+				t);
+		simde_mm_storel_pi(reinterpret_cast<simde__m64 *>(Batch_at(dst, dstStride, i)), r);
+	}
+}
+
+static void transformVec4(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	simde__m128 mat[4];
+	loadMat4u(m, mat);
+
+	simde__m128 r;
+	for (size_t i = 0; i < count; ++i) {
+		transformVec4_impl(mat, simde_mm_loadu_ps(Batch_at(src, srcStride, i)), r);
+		simde_mm_storeu_ps(Batch_at(dst, dstStride, i), r);
+	}
+}
+
+static void multiplyMat4(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	simde__m128 mat[4];
+	simde__m128 s[4];
+	simde__m128 d[4];
+	loadMat4u(m, mat);
+
+	for (size_t i = 0; i < count; ++i) {
+		loadMat4u(Batch_at(src, srcStride, i), s);
+		multiplyMat4_impl(mat, s, d);
+
+		auto target = Batch_at(dst, dstStride, i);
+		simde_mm_storeu_ps(&target[0], d[0]);
+		simde_mm_storeu_ps(&target[4], d[1]);
+		simde_mm_storeu_ps(&target[8], d[2]);
+		simde_mm_storeu_ps(&target[12], d[3]);
+	}
+}
+
+static void transformRect(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	const simde__m128 m0 = simde_mm_set1_ps(m[0]);
+	const simde__m128 m1 = simde_mm_set1_ps(m[1]);
+	const simde__m128 m4 = simde_mm_set1_ps(m[4]);
+	const simde__m128 m5 = simde_mm_set1_ps(m[5]);
+	const simde__m128 tx = simde_mm_set1_ps(m[8] + m[12]);
+	const simde__m128 ty = simde_mm_set1_ps(m[9] + m[13]);
+
+	for (size_t i = 0; i < count; ++i) {
+		auto s = Batch_at(src, srcStride, i);
+		const float l = s[0];
+		const float t = s[1];
+		const float r = l + s[2];
+		const float b = t + s[3];
+
+		// corners: (l, t), (r, t), (l, b), (r, b)
+		auto xs = simde_mm_set_ps(r, l, r, l);
+		auto ys = simde_mm_set_ps(b, b, t, t);
+
+		auto x = simde_mm_add_ps(simde_mm_add_ps(simde_mm_mul_ps(m0, xs), simde_mm_mul_ps(m4, ys)),
+				tx);
+		auto y = simde_mm_add_ps(simde_mm_add_ps(simde_mm_mul_ps(m1, xs), simde_mm_mul_ps(m5, ys)),
+				ty);
+
+		auto minV = simde_mm_unpacklo_ps(hmin(x), hmin(y)); // (minX, minY, ...)
+		auto maxV = simde_mm_unpacklo_ps(hmax(x), hmax(y)); // (maxX, maxY, ...)
+
+		simde_mm_storeu_ps(Batch_at(dst, dstStride, i),
+				simde_mm_movelh_ps(minV, simde_mm_sub_ps(maxV, minV)));
+	}
+}
+
+static void transformVec2SoA(const float m[16], const float *x, const float *y, float *dstX,
+		float *dstY, size_t count) {
+	const simde__m128 m0 = simde_mm_set1_ps(m[0]);
+	const simde__m128 m1 = simde_mm_set1_ps(m[1]);
+	const simde__m128 m4 = simde_mm_set1_ps(m[4]);
+	const simde__m128 m5 = simde_mm_set1_ps(m[5]);
+	const simde__m128 tx = simde_mm_set1_ps(m[8] + m[12]);
+	const simde__m128 ty = simde_mm_set1_ps(m[9] + m[13]);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto vx = simde_mm_loadu_ps(x + i);
+		auto vy = simde_mm_loadu_ps(y + i);
+		simde_mm_storeu_ps(dstX + i,
+				simde_mm_add_ps(simde_mm_add_ps(simde_mm_mul_ps(m0, vx), simde_mm_mul_ps(m4, vy)),
+						tx));
+		simde_mm_storeu_ps(dstY + i,
+				simde_mm_add_ps(simde_mm_add_ps(simde_mm_mul_ps(m1, vx), simde_mm_mul_ps(m5, vy)),
+						ty));
+	}
+
+	batch_scalar::transformVec2SoA(m, x + i, y + i, dstX + i, dstY + i, count - i);
+}
+
+static void transformVec4SoA(const float m[16], const float *const src[4], float *const dst[4],
+		size_t count) {
+	simde__m128 mv[16];
+	for (size_t j = 0; j < 16; ++j) { mv[j] = simde_mm_set1_ps(m[j]); }
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto x = simde_mm_loadu_ps(src[0] + i);
+		auto y = simde_mm_loadu_ps(src[1] + i);
+		auto z = simde_mm_loadu_ps(src[2] + i);
+		auto w = simde_mm_loadu_ps(src[3] + i);
+		for (size_t r = 0; r < 4; ++r) {
+			simde_mm_storeu_ps(dst[r] + i,
+					simde_mm_add_ps(
+							simde_mm_add_ps(simde_mm_mul_ps(mv[r], x), simde_mm_mul_ps(mv[4 + r], y)),
+							simde_mm_add_ps(simde_mm_mul_ps(mv[8 + r], z),
+									simde_mm_mul_ps(mv[12 + r], w))));
+		}
+	}
+
+	if (i < count) {
+		const float *tailSrc[4] = {src[0] + i, src[1] + i, src[2] + i, src[3] + i};
+		float *tailDst[4] = {dst[0] + i, dst[1] + i, dst[2] + i, dst[3] + i};
+		batch_scalar::transformVec4SoA(m, tailSrc, tailDst, count - i);
+	}
+}
+
+static void transformRectSoA(const float m[16], const float *const src[4], float *const dst[4],
+		size_t count) {
+	const simde__m128 m0 = simde_mm_set1_ps(m[0]);
+	const simde__m128 m1 = simde_mm_set1_ps(m[1]);
+	const simde__m128 m4 = simde_mm_set1_ps(m[4]);
+	const simde__m128 m5 = simde_mm_set1_ps(m[5]);
+	const simde__m128 tx = simde_mm_set1_ps(m[8] + m[12]);
+	const simde__m128 ty = simde_mm_set1_ps(m[9] + m[13]);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto l = simde_mm_loadu_ps(src[0] + i);
+		auto t = simde_mm_loadu_ps(src[1] + i);
+		auto r = simde_mm_add_ps(l, simde_mm_loadu_ps(src[2] + i));
+		auto b = simde_mm_add_ps(t, simde_mm_loadu_ps(src[3] + i));
+
+		// x and y components of the corner transform, split into x and y parts
+		auto lx = simde_mm_mul_ps(m0, l);
+		auto rx = simde_mm_mul_ps(m0, r);
+		auto ly = simde_mm_mul_ps(m1, l);
+		auto ry = simde_mm_mul_ps(m1, r);
+		auto tX = simde_mm_add_ps(simde_mm_mul_ps(m4, t), tx);
+		auto bX = simde_mm_add_ps(simde_mm_mul_ps(m4, b), tx);
+		auto tY = simde_mm_add_ps(simde_mm_mul_ps(m5, t), ty);
+		auto bY = simde_mm_add_ps(simde_mm_mul_ps(m5, b), ty);
+
+		auto x0 = simde_mm_add_ps(lx, tX);
+		auto x1 = simde_mm_add_ps(rx, tX);
+		auto x2 = simde_mm_add_ps(lx, bX);
+		auto x3 = simde_mm_add_ps(rx, bX);
+
+		auto y0 = simde_mm_add_ps(ly, tY);
+		auto y1 = simde_mm_add_ps(ry, tY);
+		auto y2 = simde_mm_add_ps(ly, bY);
+		auto y3 = simde_mm_add_ps(ry, bY);
+
+		auto minX = simde_mm_min_ps(simde_mm_min_ps(x0, x1), simde_mm_min_ps(x2, x3));
+		auto maxX = simde_mm_max_ps(simde_mm_max_ps(x0, x1), simde_mm_max_ps(x2, x3));
+		auto minY = simde_mm_min_ps(simde_mm_min_ps(y0, y1), simde_mm_min_ps(y2, y3));
+		auto maxY = simde_mm_max_ps(simde_mm_max_ps(y0, y1), simde_mm_max_ps(y2, y3));
+
+		simde_mm_storeu_ps(dst[0] + i, minX);
+		simde_mm_storeu_ps(dst[1] + i, minY);
+		simde_mm_storeu_ps(dst[2] + i, simde_mm_sub_ps(maxX, minX));
+		simde_mm_storeu_ps(dst[3] + i, simde_mm_sub_ps(maxY, minY));
+	}
+
+	if (i < count) {
+		const float *tailSrc[4] = {src[0] + i, src[1] + i, src[2] + i, src[3] + i};
+		float *tailDst[4] = {dst[0] + i, dst[1] + i, dst[2] + i, dst[3] + i};
+		batch_scalar::transformRectSoA(m, tailSrc, tailDst, count - i);
+	}
+}
+
+static void advanceTimeSoA(float *elapsed, const float *rate, const float *invDuration,
+		float *progress, float dt, size_t count) {
+	const simde__m128 vdt = simde_mm_set1_ps(dt);
+	const simde__m128 one = simde_mm_set1_ps(1.0f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto e = simde_mm_add_ps(simde_mm_loadu_ps(elapsed + i),
+				simde_mm_mul_ps(simde_mm_loadu_ps(rate + i), vdt));
+		simde_mm_storeu_ps(elapsed + i, e);
+		simde_mm_storeu_ps(progress + i,
+				simde_mm_min_ps(simde_mm_mul_ps(e, simde_mm_loadu_ps(invDuration + i)), one));
+	}
+
+	batch_scalar::advanceTimeSoA(elapsed + i, rate + i, invDuration + i, progress + i, dt,
+			count - i);
+}
+
+static void lerpSoA(const float *from, const float *delta, const float *t, float *dst,
+		size_t count) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		simde_mm_storeu_ps(dst + i,
+				simde_mm_add_ps(simde_mm_loadu_ps(from + i),
+						simde_mm_mul_ps(simde_mm_loadu_ps(delta + i), simde_mm_loadu_ps(t + i))));
+	}
+
+	batch_scalar::lerpSoA(from + i, delta + i, t + i, dst + i, count - i);
+}
+
+static constexpr BatchKernels Kernels{BatchBackend::Sse, &transformVec2, &transformVec4,
+	&multiplyMat4, &transformRect, &transformVec2SoA, &transformVec4SoA, &transformRectSoA,
+	&advanceTimeSoA, &lerpSoA};
+
+} // namespace batch_sse
+
+#if SP_SIMD_BATCH_AVX2
+
+// AVX2 kernels process 8 SoA elements or 2 AoS vectors per iteration
+// Kernels without benefits from wider registers are shared with SSE
+namespace batch_avx2 {
+
+#define SP_SIMD_AVX2_FN __attribute__((target("avx2,fma")))
+
+SP_SIMD_AVX2_FN static void transformVec4(const float m[16], const float *src, size_t srcStride,
+		float *dst, size_t dstStride, size_t count) {
+	// both lanes contains the same matrix column
+	const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[0]));
+	const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[4]));
+	const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[8]));
+	const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[12]));
+
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		auto v = _mm256_set_m128(_mm_loadu_ps(Batch_at(src, srcStride, i + 1)),
+				_mm_loadu_ps(Batch_at(src, srcStride, i)));
+
+		auto r = _mm256_mul_ps(c0, _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = _mm256_fmadd_ps(c1, _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = _mm256_fmadd_ps(c2, _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = _mm256_fmadd_ps(c3, _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+
+		_mm_storeu_ps(Batch_at(dst, dstStride, i), _mm256_castps256_ps128(r));
+		_mm_storeu_ps(Batch_at(dst, dstStride, i + 1), _mm256_extractf128_ps(r, 1));
+	}
+
+	batch_scalar::transformVec4(m, Batch_at(src, srcStride, i), srcStride, Batch_at(dst, dstStride, i),
+			dstStride, count - i);
+}
+
+SP_SIMD_AVX2_FN static void multiplyMat4(const float m[16], const float *src, size_t srcStride,
+		float *dst, size_t dstStride, size_t count) {
+	const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[0]));
+	const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[4]));
+	const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[8]));
+	const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[12]));
+
+	for (size_t i = 0; i < count; ++i) {
+		auto s = Batch_at(src, srcStride, i);
+
+		// two columns of the source per register
+		auto v01 = _mm256_loadu_ps(&s[0]);
+		auto v23 = _mm256_loadu_ps(&s[8]);
+
+		auto r01 = _mm256_mul_ps(c0, _mm256_permute_ps(v01, _MM_SHUFFLE(0, 0, 0, 0)));
+		r01 = _mm256_fmadd_ps(c1, _mm256_permute_ps(v01, _MM_SHUFFLE(1, 1, 1, 1)), r01);
+		r01 = _mm256_fmadd_ps(c2, _mm256_permute_ps(v01, _MM_SHUFFLE(2, 2, 2, 2)), r01);
+		r01 = _mm256_fmadd_ps(c3, _mm256_permute_ps(v01, _MM_SHUFFLE(3, 3, 3, 3)), r01);
+
+		auto r23 = _mm256_mul_ps(c0, _mm256_permute_ps(v23, _MM_SHUFFLE(0, 0, 0, 0)));
+		r23 = _mm256_fmadd_ps(c1, _mm256_permute_ps(v23, _MM_SHUFFLE(1, 1, 1, 1)), r23);
+		r23 = _mm256_fmadd_ps(c2, _mm256_permute_ps(v23, _MM_SHUFFLE(2, 2, 2, 2)), r23);
+		r23 = _mm256_fmadd_ps(c3, _mm256_permute_ps(v23, _MM_SHUFFLE(3, 3, 3, 3)), r23);
+
+		auto d = Batch_at(dst, dstStride, i);
+		_mm256_storeu_ps(&d[0], r01);
+		_mm256_storeu_ps(&d[8], r23);
+	}
+}
+
+SP_SIMD_AVX2_FN static void transformVec2SoA(const float m[16], const float *x, const float *y,
+		float *dstX, float *dstY, size_t count) {
+	const __m256 m0 = _mm256_set1_ps(m[0]);
+	const __m256 m1 = _mm256_set1_ps(m[1]);
+	const __m256 m4 = _mm256_set1_ps(m[4]);
+	const __m256 m5 = _mm256_set1_ps(m[5]);
+	const __m256 tx = _mm256_set1_ps(m[8] + m[12]);
+	const __m256 ty = _mm256_set1_ps(m[9] + m[13]);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto vx = _mm256_loadu_ps(x + i);
+		auto vy = _mm256_loadu_ps(y + i);
+		_mm256_storeu_ps(dstX + i, _mm256_fmadd_ps(m0, vx, _mm256_fmadd_ps(m4, vy, tx)));
+		_mm256_storeu_ps(dstY + i, _mm256_fmadd_ps(m1, vx, _mm256_fmadd_ps(m5, vy, ty)));
+	}
+
+	batch_scalar::transformVec2SoA(m, x + i, y + i, dstX + i, dstY + i, count - i);
+}
+
+SP_SIMD_AVX2_FN static void transformVec4SoA(const float m[16], const float *const src[4],
+		float *const dst[4], size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto x = _mm256_loadu_ps(src[0] + i);
+		auto y = _mm256_loadu_ps(src[1] + i);
+		auto z = _mm256_loadu_ps(src[2] + i);
+		auto w = _mm256_loadu_ps(src[3] + i);
+		for (size_t r = 0; r < 4; ++r) {
+			auto v = _mm256_mul_ps(_mm256_set1_ps(m[r]), x);
+			v = _mm256_fmadd_ps(_mm256_set1_ps(m[4 + r]), y, v);
+			v = _mm256_fmadd_ps(_mm256_set1_ps(m[8 + r]), z, v);
+			v = _mm256_fmadd_ps(_mm256_set1_ps(m[12 + r]), w, v);
+			_mm256_storeu_ps(dst[r] + i, v);
+		}
+	}
+
+	if (i < count) {
+		const float *tailSrc[4] = {src[0] + i, src[1] + i, src[2] + i, src[3] + i};
+		float *tailDst[4] = {dst[0] + i, dst[1] + i, dst[2] + i, dst[3] + i};
+		batch_scalar::transformVec4SoA(m, tailSrc, tailDst, count - i);
+	}
+}
+
+SP_SIMD_AVX2_FN static void transformRectSoA(const float m[16], const float *const src[4],
+		float *const dst[4], size_t count) {
+	const __m256 m0 = _mm256_set1_ps(m[0]);
+	const __m256 m1 = _mm256_set1_ps(m[1]);
+	const __m256 m4 = _mm256_set1_ps(m[4]);
+	const __m256 m5 = _mm256_set1_ps(m[5]);
+	const __m256 tx = _mm256_set1_ps(m[8] + m[12]);
+	const __m256 ty = _mm256_set1_ps(m[9] + m[13]);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto l = _mm256_loadu_ps(src[0] + i);
+		auto t = _mm256_loadu_ps(src[1] + i);
+		auto r = _mm256_add_ps(l, _mm256_loadu_ps(src[2] + i));
+		auto b = _mm256_add_ps(t, _mm256_loadu_ps(src[3] + i));
+
+		auto tX = _mm256_fmadd_ps(m4, t, tx);
+		auto bX = _mm256_fmadd_ps(m4, b, tx);
+		auto tY = _mm256_fmadd_ps(m5, t, ty);
+		auto bY = _mm256_fmadd_ps(m5, b, ty);
+
+		auto x0 = _mm256_fmadd_ps(m0, l, tX);
+		auto x1 = _mm256_fmadd_ps(m0, r, tX);
+		auto x2 = _mm256_fmadd_ps(m0, l, bX);
+		auto x3 = _mm256_fmadd_ps(m0, r, bX);
+
+		auto y0 = _mm256_fmadd_ps(m1, l, tY);
+		auto y1 = _mm256_fmadd_ps(m1, r, tY);
+		auto y2 = _mm256_fmadd_ps(m1, l, bY);
+		auto y3 = _mm256_fmadd_ps(m1, r, bY);
+
+		auto minX = _mm256_min_ps(_mm256_min_ps(x0, x1), _mm256_min_ps(x2, x3));
+		auto maxX = _mm256_max_ps(_mm256_max_ps(x0, x1), _mm256_max_ps(x2, x3));
+		auto minY = _mm256_min_ps(_mm256_min_ps(y0, y1), _mm256_min_ps(y2, y3));
+		auto maxY = _mm256_max_ps(_mm256_max_ps(y0, y1), _mm256_max_ps(y2, y3));
+
+		_mm256_storeu_ps(dst[0] + i, minX);
+		_mm256_storeu_ps(dst[1] + i, minY);
+		_mm256_storeu_ps(dst[2] + i, _mm256_sub_ps(maxX, minX));
+		_mm256_storeu_ps(dst[3] + i, _mm256_sub_ps(maxY, minY));
+	}
+
+	if (i < count) {
+		const float *tailSrc[4] = {src[0] + i, src[1] + i, src[2] + i, src[3] + i};
+		float *tailDst[4] = {dst[0] + i, dst[1] + i, dst[2] + i, dst[3] + i};
+		batch_scalar::transformRectSoA(m, tailSrc, tailDst, count - i);
+	}
+}
+
+SP_SIMD_AVX2_FN static void advanceTimeSoA(float *elapsed, const float *rate,
+		const float *invDuration, float *progress, float dt, size_t count) {
+	const __m256 vdt = _mm256_set1_ps(dt);
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		auto e = _mm256_fmadd_ps(_mm256_loadu_ps(rate + i), vdt, _mm256_loadu_ps(elapsed + i));
+		_mm256_storeu_ps(elapsed + i, e);
+		_mm256_storeu_ps(progress + i,
+				_mm256_min_ps(_mm256_mul_ps(e, _mm256_loadu_ps(invDuration + i)), one));
+	}
+
+	batch_scalar::advanceTimeSoA(elapsed + i, rate + i, invDuration + i, progress + i, dt,
+			count - i);
+}
+
+SP_SIMD_AVX2_FN static void lerpSoA(const float *from, const float *delta, const float *t,
+		float *dst, size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i,
+				_mm256_fmadd_ps(_mm256_loadu_ps(delta + i), _mm256_loadu_ps(t + i),
+						_mm256_loadu_ps(from + i)));
+	}
+
+	batch_scalar::lerpSoA(from + i, delta + i, t + i, dst + i, count - i);
+}
+
+#undef SP_SIMD_AVX2_FN
+
+static constexpr BatchKernels Kernels{BatchBackend::Avx2, &batch_sse::transformVec2, &transformVec4,
+	&multiplyMat4, &batch_sse::transformRect, &transformVec2SoA, &transformVec4SoA, &transformRectSoA,
+	&advanceTimeSoA, &lerpSoA};
+
+} // namespace batch_avx2
+
+#endif
+
+#if SP_SIMD_BATCH_NEON
+
+namespace batch_neon {
+
+static void transformVec4(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	const float32x4_t c0 = vld1q_f32(&m[0]);
+	const float32x4_t c1 = vld1q_f32(&m[4]);
+	const float32x4_t c2 = vld1q_f32(&m[8]);
+	const float32x4_t c3 = vld1q_f32(&m[12]);
+
+	for (size_t i = 0; i < count; ++i) {
+		auto v = vld1q_f32(Batch_at(src, srcStride, i));
+		auto r = vmulq_laneq_f32(c0, v, 0);
+		r = vfmaq_laneq_f32(r, c1, v, 1);
+		r = vfmaq_laneq_f32(r, c2, v, 2);
+		r = vfmaq_laneq_f32(r, c3, v, 3);
+		vst1q_f32(Batch_at(dst, dstStride, i), r);
+	}
+}
+
+static void multiplyMat4(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	const float32x4_t c0 = vld1q_f32(&m[0]);
+	const float32x4_t c1 = vld1q_f32(&m[4]);
+	const float32x4_t c2 = vld1q_f32(&m[8]);
+	const float32x4_t c3 = vld1q_f32(&m[12]);
+
+	float32x4_t r[4];
+	for (size_t i = 0; i < count; ++i) {
+		auto s = Batch_at(src, srcStride, i);
+		for (size_t j = 0; j < 4; ++j) {
+			auto v = vld1q_f32(&s[j * 4]);
+			r[j] = vmulq_laneq_f32(c0, v, 0);
+			r[j] = vfmaq_laneq_f32(r[j], c1, v, 1);
+			r[j] = vfmaq_laneq_f32(r[j], c2, v, 2);
+			r[j] = vfmaq_laneq_f32(r[j], c3, v, 3);
+		}
+
+		auto d = Batch_at(dst, dstStride, i);
+		vst1q_f32(&d[0], r[0]);
+		vst1q_f32(&d[4], r[1]);
+		vst1q_f32(&d[8], r[2]);
+		vst1q_f32(&d[12], r[3]);
+	}
+}
+
+static void transformVec2SoA(const float m[16], const float *x, const float *y, float *dstX,
+		float *dstY, size_t count) {
+	const float32x4_t tx = vdupq_n_f32(m[8] + m[12]);
+	const float32x4_t ty = vdupq_n_f32(m[9] + m[13]);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto vx = vld1q_f32(x + i);
+		auto vy = vld1q_f32(y + i);
+		vst1q_f32(dstX + i, vfmaq_n_f32(vfmaq_n_f32(tx, vx, m[0]), vy, m[4]));
+		vst1q_f32(dstY + i, vfmaq_n_f32(vfmaq_n_f32(ty, vx, m[1]), vy, m[5]));
+	}
+
+	batch_scalar::transformVec2SoA(m, x + i, y + i, dstX + i, dstY + i, count - i);
+}
+
+static void transformVec4SoA(const float m[16], const float *const src[4], float *const dst[4],
+		size_t count) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto x = vld1q_f32(src[0] + i);
+		auto y = vld1q_f32(src[1] + i);
+		auto z = vld1q_f32(src[2] + i);
+		auto w = vld1q_f32(src[3] + i);
+		for (size_t r = 0; r < 4; ++r) {
+			auto v = vmulq_n_f32(x, m[r]);
+			v = vfmaq_n_f32(v, y, m[4 + r]);
+			v = vfmaq_n_f32(v, z, m[8 + r]);
+			v = vfmaq_n_f32(v, w, m[12 + r]);
+			vst1q_f32(dst[r] + i, v);
+		}
+	}
+
+	if (i < count) {
+		const float *tailSrc[4] = {src[0] + i, src[1] + i, src[2] + i, src[3] + i};
+		float *tailDst[4] = {dst[0] + i, dst[1] + i, dst[2] + i, dst[3] + i};
+		batch_scalar::transformVec4SoA(m, tailSrc, tailDst, count - i);
+	}
+}
+
+static void transformRectSoA(const float m[16], const float *const src[4], float *const dst[4],
+		size_t count) {
+	const float32x4_t tx = vdupq_n_f32(m[8] + m[12]);
+	const float32x4_t ty = vdupq_n_f32(m[9] + m[13]);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto l = vld1q_f32(src[0] + i);
+		auto t = vld1q_f32(src[1] + i);
+		auto r = vaddq_f32(l, vld1q_f32(src[2] + i));
+		auto b = vaddq_f32(t, vld1q_f32(src[3] + i));
+
+		auto tX = vfmaq_n_f32(tx, t, m[4]);
+		auto bX = vfmaq_n_f32(tx, b, m[4]);
+		auto tY = vfmaq_n_f32(ty, t, m[5]);
+		auto bY = vfmaq_n_f32(ty, b, m[5]);
+
+		auto x0 = vfmaq_n_f32(tX, l, m[0]);
+		auto x1 = vfmaq_n_f32(tX, r, m[0]);
+		auto x2 = vfmaq_n_f32(bX, l, m[0]);
+		auto x3 = vfmaq_n_f32(bX, r, m[0]);
+
+		auto y0 = vfmaq_n_f32(tY, l, m[1]);
+		auto y1 = vfmaq_n_f32(tY, r, m[1]);
+		auto y2 = vfmaq_n_f32(bY, l, m[1]);
+		auto y3 = vfmaq_n_f32(bY, r, m[1]);
+
+		auto minX = vminq_f32(vminq_f32(x0, x1), vminq_f32(x2, x3));
+		auto maxX = vmaxq_f32(vmaxq_f32(x0, x1), vmaxq_f32(x2, x3));
+		auto minY = vminq_f32(vminq_f32(y0, y1), vminq_f32(y2, y3));
+		auto maxY = vmaxq_f32(vmaxq_f32(y0, y1), vmaxq_f32(y2, y3));
+
+		vst1q_f32(dst[0] + i, minX);
+		vst1q_f32(dst[1] + i, minY);
+		vst1q_f32(dst[2] + i, vsubq_f32(maxX, minX));
+		vst1q_f32(dst[3] + i, vsubq_f32(maxY, minY));
+	}
+
+	if (i < count) {
+		const float *tailSrc[4] = {src[0] + i, src[1] + i, src[2] + i, src[3] + i};
+		float *tailDst[4] = {dst[0] + i, dst[1] + i, dst[2] + i, dst[3] + i};
+		batch_scalar::transformRectSoA(m, tailSrc, tailDst, count - i);
+	}
+}
+
+static void advanceTimeSoA(float *elapsed, const float *rate, const float *invDuration,
+		float *progress, float dt, size_t count) {
+	const float32x4_t one = vdupq_n_f32(1.0f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		auto e = vfmaq_n_f32(vld1q_f32(elapsed + i), vld1q_f32(rate + i), dt);
+		vst1q_f32(elapsed + i, e);
+		vst1q_f32(progress + i, vminq_f32(vmulq_f32(e, vld1q_f32(invDuration + i)), one));
+	}
+
+	batch_scalar::advanceTimeSoA(elapsed + i, rate + i, invDuration + i, progress + i, dt,
+			count - i);
+}
+
+static void lerpSoA(const float *from, const float *delta, const float *t, float *dst,
+		size_t count) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		vst1q_f32(dst + i, vfmaq_f32(vld1q_f32(from + i), vld1q_f32(delta + i), vld1q_f32(t + i)));
+	}
+
+	batch_scalar::lerpSoA(from + i, delta + i, t + i, dst + i, count - i);
+}
+
+static constexpr BatchKernels Kernels{BatchBackend::Neon, &batch_sse::transformVec2, &transformVec4,
+	&multiplyMat4, &batch_sse::transformRect, &transformVec2SoA, &transformVec4SoA, &transformRectSoA,
+	&advanceTimeSoA, &lerpSoA};
+
+} // namespace batch_neon
+
+#endif
+
+static const BatchKernels *Batch_select() {
+#if SP_SIMD_BATCH_AVX2
+	if (isBatchBackendSupported(BatchBackend::Avx2)) {
+		return &batch_avx2::Kernels;
+	}
+#endif
+#if SP_SIMD_BATCH_NEON
+	return &batch_neon::Kernels;
+#else
+	return &batch_sse::Kernels;
+#endif
+}
+
+static std::atomic<const BatchKernels *> s_batchKernels = nullptr;
+
+bool isBatchBackendSupported(BatchBackend backend) {
+	switch (backend) {
+	case BatchBackend::Scalar:
+	case BatchBackend::Sse: return true; break;
+	case BatchBackend::Avx2:
+#if SP_SIMD_BATCH_AVX2
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+		return false;
+#endif
+		break;
+	case BatchBackend::Neon: return SP_SIMD_BATCH_NEON; break;
+	}
+	return false;
+}
+
+const BatchKernels *getBatchKernels(BatchBackend backend) {
+	if (!isBatchBackendSupported(backend)) {
+		return &batch_scalar::Kernels;
+	}
+
+	switch (backend) {
+	case BatchBackend::Scalar: return &batch_scalar::Kernels; break;
+	case BatchBackend::Sse: return &batch_sse::Kernels; break;
+	case BatchBackend::Avx2:
+#if SP_SIMD_BATCH_AVX2
+		return &batch_avx2::Kernels;
+#endif
+		break;
+	case BatchBackend::Neon:
+#if SP_SIMD_BATCH_NEON
+		return &batch_neon::Kernels;
+#endif
+		break;
+	}
+	return &batch_scalar::Kernels;
+}
+
+const BatchKernels *getBatchKernels() {
+	auto ret = s_batchKernels.load(std::memory_order_relaxed);
+	if (!ret) {
+		// selection is idempotent, so concurrent initialization is harmless
+		ret = Batch_select();
+		s_batchKernels.store(ret, std::memory_order_relaxed);
+	}
+	return ret;
+}
+
+void setBatchBackend(BatchBackend backend) {
+	s_batchKernels.store(getBatchKernels(backend), std::memory_order_relaxed);
+}
+
+} // namespace stappler::simd
@@ -0,0 +1,143 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef STAPPLER_GEOM_SPSIMDBATCH_H_
+#define STAPPLER_GEOM_SPSIMDBATCH_H_
+
+#include "SPSIMD.h"
+
+// Batched transform kernels
+//
+// Unlike single-value functions from SPSIMD.h, implementation for batched kernels is selected
+// at runtime: AVX2 (with FMA) is used when CPU supports it, NEON is used on AArch64, SSE
+// (or it's SIMDe emulation) is used otherwise.
+//
+// AoS kernels accept strides in bytes, so they can be used for fields within larger structs.
+// Source and destination can be the same memory, partially overlapped ranges are not allowed.
+
+namespace STAPPLER_VERSIONIZED stappler::simd {
+
+enum class BatchBackend {
+	Scalar,
+	Sse,
+	Avx2,
+	Neon,
+};
+
+struct BatchKernels {
+	BatchBackend backend;
+
+	// dst[i] = m * (x, y, 1, 1), same as Mat4 * Vec2
+	void (*transformVec2)(const float m[16], const float *src, size_t srcStride, float *dst,
+			size_t dstStride, size_t count);
+
+	// dst[i] = m * (x, y, z, w)
+	void (*transformVec4)(const float m[16], const float *src, size_t srcStride, float *dst,
+			size_t dstStride, size_t count);
+
+	// dst[i] = m * src[i]
+	void (*multiplyMat4)(const float m[16], const float *src, size_t srcStride, float *dst,
+			size_t dstStride, size_t count);
+
+	// Axis-aligned bounding box of transformed rect (x, y, width, height), same as TransformRect
+	void (*transformRect)(const float m[16], const float *src, size_t srcStride, float *dst,
+			size_t dstStride, size_t count);
+
+	// SoA forms: separate arrays for every component
+	void (*transformVec2SoA)(const float m[16], const float *x, const float *y, float *dstX,
+			float *dstY, size_t count);
+
+	void (*transformVec4SoA)(const float m[16], const float *const src[4], float *const dst[4],
+			size_t count);
+
+	// (x, y, width, height) arrays
+	void (*transformRectSoA)(const float m[16], const float *const src[4], float *const dst[4],
+			size_t count);
+
+	// elapsed[i] += rate[i] * dt, progress[i] = min(elapsed[i] * invDuration[i], 1.0)
+	void (*advanceTimeSoA)(float *elapsed, const float *rate, const float *invDuration,
+			float *progress, float dt, size_t count);
+
+	// dst[i] = from[i] + delta[i] * t[i]
+	void (*lerpSoA)(const float *from, const float *delta, const float *t, float *dst,
+			size_t count);
+};
+
+SP_PUBLIC bool isBatchBackendSupported(BatchBackend);
+
+// Returns kernels for the specific backend, or scalar kernels, if backend is not supported
+SP_PUBLIC const BatchKernels *getBatchKernels(BatchBackend);
+
+// Kernels, selected for the current CPU
+SP_PUBLIC const BatchKernels *getBatchKernels();
+
+// Overrides runtime selection (intended for benchmarks and tests)
+SP_PUBLIC void setBatchBackend(BatchBackend);
+
+inline void transformVec2Batch(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	getBatchKernels()->transformVec2(m, src, srcStride, dst, dstStride, count);
+}
+
+inline void transformVec4Batch(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	getBatchKernels()->transformVec4(m, src, srcStride, dst, dstStride, count);
+}
+
+inline void multiplyMat4Batch(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	getBatchKernels()->multiplyMat4(m, src, srcStride, dst, dstStride, count);
+}
+
+inline void transformRectBatch(const float m[16], const float *src, size_t srcStride, float *dst,
+		size_t dstStride, size_t count) {
+	getBatchKernels()->transformRect(m, src, srcStride, dst, dstStride, count);
+}
+
+inline void transformVec2BatchSoA(const float m[16], const float *x, const float *y, float *dstX,
+		float *dstY, size_t count) {
+	getBatchKernels()->transformVec2SoA(m, x, y, dstX, dstY, count);
+}
+
+inline void transformVec4BatchSoA(const float m[16], const float *const src[4],
+		float *const dst[4], size_t count) {
+	getBatchKernels()->transformVec4SoA(m, src, dst, count);
+}
+
+inline void transformRectBatchSoA(const float m[16], const float *const src[4],
+		float *const dst[4], size_t count) {
+	getBatchKernels()->transformRectSoA(m, src, dst, count);
+}
+
+inline void advanceTimeBatchSoA(float *elapsed, const float *rate, const float *invDuration,
+		float *progress, float dt, size_t count) {
+	getBatchKernels()->advanceTimeSoA(elapsed, rate, invDuration, progress, dt, count);
+}
+
+inline void lerpBatchSoA(const float *from, const float *delta, const float *t, float *dst,
+		size_t count) {
+	getBatchKernels()->lerpSoA(from, delta, t, dst, count);
+}
+
+} // namespace stappler::simd
+
+#endif /* STAPPLER_GEOM_SPSIMDBATCH_H_ */
@@ -168,5 +168,6 @@ uint32_t getActiveHandles() { return CurlHandle::getActiveHandles(); }
 #include "SPNetworkSetup.cc"
 #include "SPNetworkData.cc"
 #include "SPNetworkHandle.cc"
+#include "SPNetworkSocketDriver.cc"
 
 //#include "SPNetworkMultiHandle.cc"
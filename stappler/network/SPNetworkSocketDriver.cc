@@ -0,0 +1,253 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "SPNetworkSocketDriver.h"
+
+#if MODULE_STAPPLER_EVENT
+
+#include "SPLog.h"
+
+namespace STAPPLER_VERSIONIZED stappler::network {
+
+static event::PollFlags SocketDriver_getPollFlags(int what) {
+	switch (what) {
+	case CURL_POLL_IN: return event::PollFlags::In; break;
+	case CURL_POLL_OUT: return event::PollFlags::Out; break;
+	case CURL_POLL_INOUT: return event::PollFlags::In | event::PollFlags::Out; break;
+	default: break;
+	}
+	return event::PollFlags::None;
+}
+
+static int SocketDriver_getActionFlags(event::PollFlags flags) {
+	int ret = 0;
+	if (hasFlag(flags, event::PollFlags::In) || hasFlag(flags, event::PollFlags::Pri)) {
+		ret |= CURL_CSELECT_IN;
+	}
+	if (hasFlag(flags, event::PollFlags::Out)) {
+		ret |= CURL_CSELECT_OUT;
+	}
+	if (hasFlag(flags, event::PollFlags::Err) || hasFlag(flags, event::PollFlags::HungUp)) {
+		ret |= CURL_CSELECT_ERR;
+	}
+	return ret;
+}
+
+SocketDriver::~SocketDriver() { cancel(); }
+
+bool SocketDriver::init(event::Looper *looper, CompletionCallback &&cb) {
+	if (!looper) {
+		return false;
+	}
+
+	_handle = curl_multi_init();
+	if (!_handle) {
+		return false;
+	}
+
+	_looper = looper;
+	_completion = sp::move(cb);
+
+	curl_multi_setopt(_handle, CURLMOPT_SOCKETFUNCTION, &onSocket);
+	curl_multi_setopt(_handle, CURLMOPT_SOCKETDATA, this);
+	curl_multi_setopt(_handle, CURLMOPT_TIMERFUNCTION, &onTimer);
+	curl_multi_setopt(_handle, CURLMOPT_TIMERDATA, this);
+	return true;
+}
+
+bool SocketDriver::addHandle(CURL *curl) {
+	if (!_handle) {
+		return false;
+	}
+
+	// CURL will request initial timeout via timer callback to start transfer
+	auto err = curl_multi_add_handle(_handle, curl);
+	if (err != CURLM_OK) {
+		log::source().error("network::SocketDriver", "Fail to add handle: ", int(err));
+		return false;
+	}
+	++_running;
+	return true;
+}
+
+bool SocketDriver::removeHandle(CURL *curl) {
+	if (!_handle) {
+		return false;
+	}
+
+	if (curl_multi_remove_handle(_handle, curl) == CURLM_OK) {
+		if (_running > 0) {
+			--_running;
+		}
+		return true;
+	}
+	return false;
+}
+
+void SocketDriver::cancel() {
+	if (_handle) {
+		// curl_multi_cleanup can invoke socket and timer callbacks with SocketData pointers,
+		// so, callbacks are detached and multi handle is destroyed before driver's state
+		curl_multi_setopt(_handle, CURLMOPT_SOCKETFUNCTION, nullptr);
+		curl_multi_setopt(_handle, CURLMOPT_SOCKETDATA, nullptr);
+		curl_multi_setopt(_handle, CURLMOPT_TIMERFUNCTION, nullptr);
+		curl_multi_setopt(_handle, CURLMOPT_TIMERDATA, nullptr);
+		curl_multi_cleanup(_handle);
+		_handle = nullptr;
+	}
+
+	if (_timer) {
+		_timer->cancel();
+		_timer = nullptr;
+	}
+
+	for (auto &it : _sockets) {
+		if (it.second->handle) {
+			it.second->handle->cancel();
+			it.second->handle = nullptr;
+		}
+	}
+	_sockets.clear();
+
+	_running = 0;
+}
+
+int SocketDriver::onSocket(CURL *, curl_socket_t s, int what, void *userp, void *socketp) {
+	reinterpret_cast<SocketDriver *>(userp)->updateSocket(s, what,
+			reinterpret_cast<SocketData *>(socketp));
+	return 0;
+}
+
+int SocketDriver::onTimer(CURLM *, long timeoutMs, void *userp) {
+	reinterpret_cast<SocketDriver *>(userp)->updateTimer(timeoutMs);
+	return 0;
+}
+
+void SocketDriver::updateSocket(curl_socket_t s, int what, SocketData *data) {
+	if (what == CURL_POLL_REMOVE) {
+		if (data) {
+			if (data->handle) {
+				data->handle->cancel();
+				data->handle = nullptr;
+			}
+			curl_multi_assign(_handle, s, nullptr);
+			_sockets.erase(s);
+		}
+		return;
+	}
+
+	auto flags = SocketDriver_getPollFlags(what);
+
+	if (data && data->handle) {
+		if (data->handle->reset(flags)) {
+			return;
+		}
+
+		// handle can not be reset in place, replace it
+		data->handle->cancel();
+		data->handle = nullptr;
+	}
+
+	if (!data) {
+		auto d = Rc<SocketData>::alloc();
+		d->socket = s;
+		data = d.get();
+		_sockets.emplace(s, move(d));
+		curl_multi_assign(_handle, s, data);
+	}
+
+	data->handle = _looper->listenPollableHandle((event::NativeHandle)s, flags,
+			[this, s](event::NativeHandle, event::PollFlags flags) {
+		performAction(s, SocketDriver_getActionFlags(flags));
+		return Status::Ok;
+	});
+
+	if (!data->handle) {
+		log::source().error("network::SocketDriver", "Fail to listen socket: ", s);
+	}
+}
+
+void SocketDriver::updateTimer(long timeoutMs) {
+	if (_timer) {
+		_timer->cancel();
+		_timer = nullptr;
+	}
+
+	if (timeoutMs < 0) {
+		return;
+	}
+
+	if (timeoutMs == 0) {
+		// socket_action can not be called from within CURL callback, defer it to the next event
+		// deferred call retains the driver, it can be released before the next event
+		_looper->performOnThread([this, ref = Rc<SocketDriver>(this)] {
+			performAction(CURL_SOCKET_TIMEOUT, 0);
+		}, this, false);
+	} else {
+		_timer = _looper->schedule(TimeInterval::milliseconds(timeoutMs),
+				[this](event::Handle *handle, bool success) {
+			if (success && handle == _timer.get()) {
+				_timer = nullptr;
+				performAction(CURL_SOCKET_TIMEOUT, 0);
+			}
+		});
+	}
+}
+
+void SocketDriver::performAction(curl_socket_t s, int flags) {
+	if (!_handle) {
+		return;
+	}
+
+	Rc<SocketDriver> ref(this); // completion can release driver
+
+	int running = 0;
+	auto err = curl_multi_socket_action(_handle, s, flags, &running);
+	if (err != CURLM_OK) {
+		log::source().error("network::SocketDriver", "Fail to perform socket action: ", int(err));
+	}
+
+	readCompleted();
+}
+
+void SocketDriver::readCompleted() {
+	struct CURLMsg *msg = nullptr;
+	do {
+		int msgq = 0;
+		if (!_handle) {
+			break;
+		}
+		msg = curl_multi_info_read(_handle, &msgq);
+		if (msg && (msg->msg == CURLMSG_DONE)) {
+			auto e = msg->easy_handle;
+			auto code = msg->data.result;
+			removeHandle(e);
+			if (_completion) {
+				_completion(e, code);
+			}
+		}
+	} while (msg);
+}
+
+} // namespace stappler::network
+
+#endif
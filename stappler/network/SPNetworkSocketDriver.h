@@ -0,0 +1,96 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef STAPPLER_NETWORK_SPNETWORKSOCKETDRIVER_H_
+#define STAPPLER_NETWORK_SPNETWORKSOCKETDRIVER_H_
+
+#include "SPNetworkContext.h"
+
+#if MODULE_STAPPLER_EVENT
+
+#include "SPEventLooper.h"
+#include "SPEventPollHandle.h"
+
+namespace STAPPLER_VERSIONIZED stappler::network {
+
+/* Driver for CURL multi handle, based on curl_multi_socket_action
+ *
+ * Sockets and timers, requested by CURL, are registered within event::Looper,
+ * so, transfers are processed by the looper itself, without dedicated polling thread
+ *
+ * Driver is single-threaded: all methods should be called on the looper's thread,
+ * completion callback is also called on this thread
+ *
+ * Socket and timer handles do not retain the driver, `cancel` is called on destruction
+ */
+class SP_PUBLIC SocketDriver : public Ref {
+public:
+	using CompletionCallback = mem_std::Function<void(CURL *, CURLcode)>;
+
+	virtual ~SocketDriver();
+
+	bool init(event::Looper *, CompletionCallback &&);
+
+	// Easy handle should be prepared with `network::prepare` before adding
+	// Driver does not own easy handles, they should be released by the caller
+	// after completion or removal
+	bool addHandle(CURL *);
+	bool removeHandle(CURL *);
+
+	// Cancels all pending socket and timer operations and destroys multi handle
+	// All easy handles should be removed before this call
+	void cancel();
+
+	CURLM *getHandle() const { return _handle; }
+	event::Looper *getLooper() const { return _looper; }
+
+	size_t getRunningCount() const { return _running; }
+
+protected:
+	struct SocketData : Ref {
+		curl_socket_t socket = CURL_SOCKET_BAD;
+		Rc<event::PollHandle> handle;
+	};
+
+	static int onSocket(CURL *, curl_socket_t, int what, void *userp, void *socketp);
+	static int onTimer(CURLM *, long timeoutMs, void *userp);
+
+	void updateSocket(curl_socket_t, int what, SocketData *);
+	void updateTimer(long timeoutMs);
+
+	void performAction(curl_socket_t, int flags);
+	void readCompleted();
+
+	event::Looper *_looper = nullptr;
+	CURLM *_handle = nullptr;
+	CompletionCallback _completion;
+
+	Rc<event::Handle> _timer;
+	mem_std::Map<curl_socket_t, Rc<SocketData>> _sockets;
+	int _running = 0;
+};
+
+} // namespace stappler::network
+
+#endif
+
+#endif /* STAPPLER_NETWORK_SPNETWORKSOCKETDRIVER_H_ */
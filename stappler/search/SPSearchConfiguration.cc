@@ -377,28 +377,9 @@ String Configuration::encodeSearchVectorPostgres(const SearchVector &vec,
 	return ret.str();
 }
 
-Bytes Configuration::encodeSearchVectorData(const SearchVector &data, SearchData::Rank rank) const {
-	data::cbor::Encoder<Interface> enc(true);
-	data::cbor::_writeArrayStart(enc, 3);
-	data::cbor::_writeInt(enc, 1); // version
-	data::cbor::_writeInt(enc, data.documentLength); // version
-	data::cbor::_writeMapStart(enc, data.words.size());
-	for (auto &it : data.words) {
-		enc.write(it.first);
-		_writeArrayStart(enc, it.second.size() * 2);
-		for (auto &iit : it.second) {
-			data::cbor::_writeInt(enc, iit.first);
-			data::cbor::_writeInt(enc,
-					toInt((iit.second == SearchData::Rank::Unknown) ? rank : iit.second));
-		}
-	}
-	auto result = enc.data();
-	auto r = data::compress<Interface>(result.data(), result.size(),
-			data::EncodeFormat::Compression::LZ4HCCompression, true);
-	if (r.empty()) {
-		return result;
-	}
-	return r;
+Bytes Configuration::encodeSearchVectorData(const SearchVector &data, SearchData::Rank rank,
+		const SearchVectorView::WordIdCallback *wordId) const {
+	return SearchVectorView::compress(SearchVectorView::encode(data, rank, wordId));
 }
 
 void Configuration::stemHtml(const StringView &str, const StemWordCallback &cb) const {
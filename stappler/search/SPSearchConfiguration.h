@@ -92,8 +92,11 @@ public:
 	// encode for postgres textual representation
 	String encodeSearchVectorPostgres(const SearchVector &, SearchData::Rank rank = SearchData::Rank::Unknown) const;
 
-	// encode for binary blob
-	Bytes encodeSearchVectorData(const SearchVector &, SearchData::Rank rank = SearchData::Rank::Unknown) const;
+	// encode for binary blob, that can be read with SearchVectorView
+	// wordId provides external word ids (like sqlite `__words` ids) to key the words table;
+	// data is compressed only above SearchVectorView::CompressionThreshold
+	Bytes encodeSearchVectorData(const SearchVector &, SearchData::Rank rank = SearchData::Rank::Unknown,
+			const SearchVectorView::WordIdCallback *wordId = nullptr) const;
 
 	SearchQuery parseQuery(StringView, bool strict = false, StringView *err = nullptr) const;
 
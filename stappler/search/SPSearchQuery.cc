@@ -239,6 +239,13 @@ static auto SearchQuery_isMatch(const SearchVectorType &vec, StringView stem) ->
 	return nullptr;
 }
 
+static SearchVectorView::PostingList SearchQuery_isMatch(const SearchVectorView &vec,
+		StringView stem) {
+	SearchVectorView::PostingList ret;
+	vec.find(stem, ret);
+	return ret;
+}
+
 static void SearchQuery_foreachValueMatches(
 		Vector< sprt::pair<SearchData::Rank, Vector<size_t>> > &path,
 		const Vector<sprt::pair<size_t, SearchData::Rank>> &matches) {
@@ -288,18 +295,50 @@ static int64_t SearchQuery_toInt(const SearchData::Rank &val) { return toInt(val
 
 static int64_t SearchQuery_toInt(const size_t &val) { return val; }
 
+static void SearchQuery_foreachValueMatches(
+		Vector< sprt::pair<SearchData::Rank, Vector<size_t>> > &path,
+		const SearchVectorView::PostingList &matches) {
+	for (auto &it : matches) {
+		auto &obj = path.emplace_back(
+				sprt::pair<SearchData::Rank, Vector<size_t>>(it.second, Vector<size_t>()));
+		obj.second.emplace_back(it.first);
+	}
+}
+
+static const SearchVectorView::PostingList &SearchQuery_matchesToArray(
+		const SearchVectorView::PostingList &matches) {
+	return matches;
+}
+
+template <typename SearchVectorTypeValue>
+static bool SearchQuery_isFound(const SearchVectorTypeValue *v) {
+	return v != nullptr;
+}
+
+static bool SearchQuery_isFound(const SearchVectorView::PostingList &v) { return v.ptr != nullptr; }
+
+template <typename SearchVectorTypeValue>
+static const SearchVectorTypeValue &SearchQuery_getMatches(const SearchVectorTypeValue *v) {
+	return *v;
+}
+
+static const SearchVectorView::PostingList &SearchQuery_getMatches(
+		const SearchVectorView::PostingList &v) {
+	return v;
+}
+
 template <typename SearchVectorTypeValue>
 static bool SearchQuery_isFollow(Vector< sprt::pair<SearchData::Rank, Vector<size_t>> > &path,
-		const SearchVectorTypeValue *v2, size_t offset) {
+		const SearchVectorTypeValue &v2, size_t offset) {
 	if (offset < 1) {
 		offset = 1;
 	}
 
 	if (path.empty()) {
 		// add all matches to follow path list
-		SearchQuery_foreachValueMatches(path, *v2);
+		SearchQuery_foreachValueMatches(path, v2);
 	} else {
-		auto arr = SearchQuery_matchesToArray(*v2);
+		auto &&arr = SearchQuery_matchesToArray(v2);
 
 		// for every known path, check, if next word within range
 		// if no next word found within range for path - remove path
@@ -379,11 +418,11 @@ static bool SearchQuery_isMatch(const SearchVectorType &vec, const SearchQuery &
 			Vector< sprt::pair<SearchData::Rank, Vector<size_t>> > path;
 			for (auto &it : q.args) {
 				auto tmp = SearchQuery_isMatch(vec, it.value);
-				if (!tmp) {
+				if (!SearchQuery_isFound(tmp)) {
 					return q.neg;
 				}
 
-				if (!SearchQuery_isFollow(path, tmp, it.offset)) {
+				if (!SearchQuery_isFollow(path, SearchQuery_getMatches(tmp), it.offset)) {
 					return q.neg;
 				}
 			}
@@ -393,9 +432,9 @@ static bool SearchQuery_isMatch(const SearchVectorType &vec, const SearchQuery &
 	} else if (!q.value.empty()) {
 		auto v = SearchQuery_isMatch(vec, q.value);
 		if (q.neg) {
-			return v == nullptr;
+			return !SearchQuery_isFound(v);
 		} else {
-			return v != nullptr;
+			return SearchQuery_isFound(v);
 		}
 	}
 	return false;
@@ -406,10 +445,25 @@ bool SearchQuery::isMatch(const SearchVector &vec) const {
 }
 
 bool SearchQuery::isMatch(const BytesView &blob) const {
+	if (SearchVectorView::isBinaryFormat(blob)) {
+		SearchVectorView view(blob);
+		if (view.valid()) {
+			return isMatch(view);
+		}
+	}
+
 	auto p = pool::create(pool::acquire());
 
 	bool result = false;
 	perform([&, this] {
+		Bytes buffer;
+		SearchVectorView view(blob, &buffer);
+		if (view.valid()) {
+			result = isMatch(view);
+			return;
+		}
+
+		// legacy CBOR format (version 1)
 		auto d = data::read<Interface>(blob);
 		if (d.isArray() && d.size() == 3 && d.getInteger(0) == 1) {
 			auto &dict = d.getDict(2);
@@ -421,6 +475,20 @@ bool SearchQuery::isMatch(const BytesView &blob) const {
 	return result;
 }
 
+bool SearchQuery::isMatch(const SearchVectorView &view) const {
+	if (!view.valid()) {
+		return false;
+	}
+	return SearchQuery_isMatch(view, *this);
+}
+
+static SearchVectorView::PostingList SearchQuery_getWordInfo(const SearchVectorView &vec,
+		StringView word) {
+	SearchVectorView::PostingList ret;
+	vec.find(word, ret);
+	return ret;
+}
+
 static SpanView<sprt::pair<size_t, SearchData::Rank>> SearchQuery_getWordInfo(
 		const SearchVector &vec, StringView word) {
 	auto it = vec.words.find(word);
@@ -492,10 +560,25 @@ float SearchQuery::rankQuery(const SearchVector &vec, Normalization norm,
 }
 
 float SearchQuery::rankQuery(const BytesView &blob, Normalization norm, RankingValues vals) const {
+	if (SearchVectorView::isBinaryFormat(blob)) {
+		SearchVectorView view(blob);
+		if (view.valid()) {
+			return rankQuery(view, norm, vals);
+		}
+	}
+
 	auto p = pool::create(pool::acquire());
 
 	float result = 0.0f;
 	perform([&, this] {
+		Bytes buffer;
+		SearchVectorView view(blob, &buffer);
+		if (view.valid()) {
+			result = rankQuery(view, norm, vals);
+			return;
+		}
+
+		// legacy CBOR format (version 1)
 		auto d = data::read<Interface>(blob);
 		if (d.isArray() && d.size() == 3 && d.getInteger(0) == 1) {
 			auto docLength = d.getInteger(1);
@@ -509,6 +592,15 @@ float SearchQuery::rankQuery(const BytesView &blob, Normalization norm, RankingV
 	return result;
 }
 
+float SearchQuery::rankQuery(const SearchVectorView &view, Normalization norm,
+		RankingValues vals) const {
+	if (!view.valid()) {
+		return 0.0f;
+	}
+	return SearchQuery_rankQuery(*this, view, norm, vals, view.getDocumentLength(),
+			view.getWordsCount());
+}
+
 void SearchQuery::normalize() {
 	if (!args.empty() && neg) {
 		switch (op) {
@@ -610,4 +702,372 @@ void SearchQuery::decompose(const Callback<void(StringView)> &positive,
 	}
 }
 
+static bool SearchVectorView_readVarint(const uint8_t *&ptr, const uint8_t *end, uint64_t &ret) {
+	ret = 0;
+	uint32_t shift = 0;
+	while (ptr < end && shift < 64) {
+		auto b = *ptr++;
+		ret |= uint64_t(b & 0x7F) << shift;
+		if ((b & 0x80) == 0) {
+			return true;
+		}
+		shift += 7;
+	}
+	return false;
+}
+
+static void SearchVectorView_writeVarint(Bytes &buf, uint64_t value) {
+	while (value >= 0x80) {
+		buf.emplace_back(uint8_t(value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	buf.emplace_back(uint8_t(value));
+}
+
+static uint32_t SearchVectorView_readUint32(const uint8_t *ptr) {
+	return uint32_t(ptr[0]) | (uint32_t(ptr[1]) << 8) | (uint32_t(ptr[2]) << 16)
+			| (uint32_t(ptr[3]) << 24);
+}
+
+static void SearchVectorView_writeUint32(uint8_t *ptr, uint32_t value) {
+	ptr[0] = uint8_t(value & 0xFF);
+	ptr[1] = uint8_t((value >> 8) & 0xFF);
+	ptr[2] = uint8_t((value >> 16) & 0xFF);
+	ptr[3] = uint8_t((value >> 24) & 0xFF);
+}
+
+static uint64_t SearchVectorView_readUint64(const uint8_t *ptr) {
+	return uint64_t(SearchVectorView_readUint32(ptr))
+			| (uint64_t(SearchVectorView_readUint32(ptr + 4)) << 32);
+}
+
+static void SearchVectorView_writeUint64(uint8_t *ptr, uint64_t value) {
+	SearchVectorView_writeUint32(ptr, uint32_t(value & 0xFFFF'FFFF));
+	SearchVectorView_writeUint32(ptr + 4, uint32_t(value >> 32));
+}
+
+SearchVectorView::PostingIterator::PostingIterator(const uint8_t *ptr, const uint8_t *end,
+		size_t count)
+: _ptr(ptr), _end(end), _remaining(count) {
+	if (_remaining > 0) {
+		read();
+	}
+}
+
+SearchVectorView::PostingIterator &SearchVectorView::PostingIterator::operator++() {
+	if (_remaining > 0) {
+		--_remaining;
+		if (_remaining > 0) {
+			read();
+		}
+	}
+	return *this;
+}
+
+void SearchVectorView::PostingIterator::read() {
+	uint64_t value = 0;
+	if (!SearchVectorView_readVarint(_ptr, _end, value)) {
+		// malformed data, stop iteration
+		_remaining = 0;
+		return;
+	}
+
+	_value.first += size_t(value >> 3);
+
+	auto rank = value & 0x7;
+	_value.second =
+			(rank > uint64_t(toInt(SearchRank::A))) ? SearchRank::Unknown : SearchRank(rank);
+}
+
+bool SearchVectorView::isBinaryFormat(BytesView data) {
+	return data.size() >= HeaderSize && data[0] == 'S' && data[1] == 'V' && data[2] == 'D'
+			&& data[3] == Version;
+}
+
+bool SearchVectorView::isCurrentFormat(BytesView data) {
+	return isBinaryFormat(data)
+			&& (SearchVectorView_readUint32(data.data() + 12) & FlagWordIds) != 0;
+}
+
+Bytes SearchVectorView::encode(const SearchVector &vec, SearchData::Rank rank,
+		const WordIdCallback *wordId) {
+	struct WordInfo {
+		uint64_t key;
+		StringView word;
+		const SearchVector::MatchVector *matches;
+	};
+
+	Vector<WordInfo> words;
+	words.reserve(vec.words.size());
+	for (auto &it : vec.words) {
+		auto key = wordId ? (*wordId)(it.first) : uint64_t(hash32(it.first));
+		words.emplace_back(WordInfo{key, it.first, &it.second});
+	}
+
+	std::sort(words.begin(), words.end(), [](const WordInfo &l, const WordInfo &r) {
+		if (l.key != r.key) {
+			return l.key < r.key;
+		}
+		return l.word < r.word;
+	});
+
+	Bytes ret;
+	ret.resize(HeaderSize + words.size() * EntrySize);
+	ret[0] = 'S';
+	ret[1] = 'V';
+	ret[2] = 'D';
+	ret[3] = Version;
+	SearchVectorView_writeUint32(ret.data() + 4, uint32_t(vec.documentLength));
+	SearchVectorView_writeUint32(ret.data() + 8, uint32_t(words.size()));
+	SearchVectorView_writeUint32(ret.data() + 12, wordId ? FlagWordIds : 0);
+
+	SearchVector::MatchVector postings;
+
+	size_t idx = 0;
+	for (auto &it : words) {
+		auto entry = HeaderSize + idx * EntrySize;
+		SearchVectorView_writeUint64(ret.data() + entry, it.key);
+		SearchVectorView_writeUint32(ret.data() + entry + 8, uint32_t(ret.size()));
+
+		SearchVectorView_writeVarint(ret, it.word.size());
+		ret.insert(ret.end(), (const uint8_t *)it.word.data(),
+				(const uint8_t *)it.word.data() + it.word.size());
+
+		postings.clear();
+		for (auto &m : *it.matches) {
+			postings.emplace_back(m.first,
+					(m.second == SearchData::Rank::Unknown) ? rank : m.second);
+		}
+
+		// positions are delta-encoded, so they should be ordered
+		std::sort(postings.begin(), postings.end(), [](const Posting &l, const Posting &r) {
+			if (l.first != r.first) {
+				return l.first < r.first;
+			}
+			return toInt(l.second) < toInt(r.second);
+		});
+
+		SearchVectorView_writeVarint(ret, postings.size());
+
+		size_t prev = 0;
+		for (auto &m : postings) {
+			SearchVectorView_writeVarint(ret,
+					(uint64_t(m.first - prev) << 3) | uint64_t(toInt(m.second)));
+			prev = m.first;
+		}
+		++idx;
+	}
+	return ret;
+}
+
+Bytes SearchVectorView::compress(Bytes &&data, size_t threshold) {
+	if (!isBinaryFormat(data) || data.size() < threshold) {
+		return move(data);
+	}
+
+	auto flags = SearchVectorView_readUint32(data.data() + 12);
+	if ((flags & FlagCompressed) != 0) {
+		return move(data);
+	}
+
+	// header stays uncompressed, so format and version can be checked without decompression
+	auto body = data::compress<Interface>(data.data() + HeaderSize, data.size() - HeaderSize,
+			data::EncodeFormat::LZ4HCCompression, true);
+	if (body.empty()) {
+		return move(data);
+	}
+
+	Bytes ret;
+	ret.resize(HeaderSize + body.size());
+	memcpy(ret.data(), data.data(), HeaderSize);
+	memcpy(ret.data() + HeaderSize, body.data(), body.size());
+	SearchVectorView_writeUint32(ret.data() + 12, flags | FlagCompressed);
+	return ret;
+}
+
+bool SearchVectorView::read(BytesView data, SearchVector &vec) {
+	Bytes buffer;
+	SearchVectorView view(data, &buffer);
+	if (view.valid()) {
+		vec.documentLength = view.getDocumentLength();
+		view.foreach ([&](uint64_t, StringView word, const PostingList &list) {
+			auto &m = vec.words.emplace(word.pdup(), SearchVector::MatchVector()).first->second;
+			m.reserve(list.size());
+			for (auto &it : list) { m.emplace_back(it); }
+		});
+		return true;
+	}
+
+	// legacy CBOR format (version 1)
+	auto d = data::read<Interface>(data);
+	if (d.isArray() && d.size() == 3 && d.getInteger(0) == 1) {
+		vec.documentLength = size_t(d.getInteger(1));
+		for (auto &it : d.getDict(2)) {
+			auto &m = vec.words.emplace(StringView(it.first).pdup(), SearchVector::MatchVector())
+							  .first->second;
+			auto &arr = it.second.asArray();
+			m.reserve(arr.size() / 2);
+			for (size_t i = 0; i + 1 < arr.size(); i += 2) {
+				m.emplace_back(size_t(arr[i].getInteger()),
+						SearchData::Rank(arr[i + 1].getInteger()));
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+SearchVectorView::SearchVectorView(BytesView data, Bytes *buffer) {
+	if (!isBinaryFormat(data)) {
+		return;
+	}
+
+	auto flags = SearchVectorView_readUint32(data.data() + 12);
+
+	if ((flags & FlagCompressed) != 0) {
+		if (!buffer) {
+			return;
+		}
+
+		auto src = data.data() + HeaderSize;
+		auto srcSize = data.size() - HeaderSize;
+		auto size = data::getDecompressedSize(src, srcSize);
+		if (size == 0) {
+			return;
+		}
+
+		buffer->resize(HeaderSize + size);
+		memcpy(buffer->data(), data.data(), HeaderSize);
+		if (data::decompress(src, srcSize, buffer->data() + HeaderSize, size) != size) {
+			return;
+		}
+		data = BytesView(buffer->data(), buffer->size());
+	}
+
+	auto wordsCount = SearchVectorView_readUint32(data.data() + 8);
+	if ((data.size() - HeaderSize) / EntrySize < wordsCount) {
+		return;
+	}
+
+	_data = data;
+	_documentLength = SearchVectorView_readUint32(data.data() + 4);
+	_wordsCount = wordsCount;
+	_flags = flags;
+}
+
+bool SearchVectorView::find(StringView word, PostingList &ret) const {
+	if (!valid()) {
+		ret = PostingList();
+		return false;
+	}
+
+	StringView w;
+	if (hasWordIds()) {
+		if (_wordIds) {
+			auto it = _wordIds->find(word);
+			if (it != _wordIds->end()) {
+				return find(it->second, ret);
+			}
+		} else {
+			for (size_t i = 0; i < _wordsCount; ++i) {
+				if (readWord(i, w, ret) && w == word) {
+					return true;
+				}
+			}
+		}
+		ret = PostingList();
+		return false;
+	}
+
+	auto hash = uint64_t(hash32(word));
+
+	// lower bound for hash in words table
+	size_t first = 0;
+	size_t count = _wordsCount;
+	while (count > 0) {
+		auto step = count / 2;
+		auto idx = first + step;
+		if (readKey(idx) < hash) {
+			first = idx + 1;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+
+	while (first < _wordsCount && readKey(first) == hash) {
+		if (readWord(first, w, ret) && w == word) {
+			return true;
+		}
+		++first;
+	}
+	ret = PostingList();
+	return false;
+}
+
+bool SearchVectorView::find(uint64_t key, PostingList &ret) const {
+	size_t first = 0;
+	size_t count = _wordsCount;
+	while (count > 0) {
+		auto step = count / 2;
+		auto idx = first + step;
+		if (readKey(idx) < key) {
+			first = idx + 1;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+
+	StringView w;
+	if (first < _wordsCount && readKey(first) == key && readWord(first, w, ret)) {
+		return true;
+	}
+	ret = PostingList();
+	return false;
+}
+
+void SearchVectorView::foreach (
+		const Callback<void(uint64_t, StringView, const PostingList &)> &cb) const {
+	StringView word;
+	PostingList list;
+	for (size_t i = 0; i < _wordsCount; ++i) {
+		if (readWord(i, word, list)) {
+			cb(readKey(i), word, list);
+		}
+	}
+}
+
+uint64_t SearchVectorView::readKey(size_t idx) const {
+	return SearchVectorView_readUint64(_data.data() + HeaderSize + idx * EntrySize);
+}
+
+bool SearchVectorView::readWord(size_t idx, StringView &word, PostingList &list) const {
+	auto offset = SearchVectorView_readUint32(_data.data() + HeaderSize + idx * EntrySize + 8);
+	if (offset >= _data.size()) {
+		return false;
+	}
+
+	auto ptr = _data.data() + offset;
+	auto end = _data.data() + _data.size();
+
+	uint64_t len = 0;
+	if (!SearchVectorView_readVarint(ptr, end, len) || len > uint64_t(end - ptr)) {
+		return false;
+	}
+
+	word = StringView((const char *)ptr, size_t(len));
+	ptr += len;
+
+	uint64_t count = 0;
+	if (!SearchVectorView_readVarint(ptr, end, count)) {
+		return false;
+	}
+
+	list.ptr = ptr;
+	list.end_ptr = end;
+	list.count = size_t(count);
+	return true;
+}
+
 } // namespace stappler::search
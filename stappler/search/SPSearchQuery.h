@@ -75,6 +75,133 @@ struct SP_PUBLIC SearchVector {
 	bool empty() const { return words.empty(); }
 };
 
+// Read-only view over binary search vector, produced with `Configuration::encodeSearchVectorData`
+//
+// Format (little-endian):
+// - header: 'S', 'V', 'D', version, uint32 documentLength, uint32 wordsCount, uint32 flags
+// - words table: wordsCount * (uint64 key, uint32 offset), sorted by key, then by word
+// - word block at offset: varint length, word bytes, varint count,
+//   then count * varint ((position - prevPosition) << 3 | rank), sorted by position
+//
+// Key is a hash32 of the word, or an external word id (like sqlite `__words` id), when
+// FlagWordIds is set. With FlagCompressed, everything after the header is stored as LZ4 frame,
+// offsets are relative to the uncompressed data.
+//
+// Uncompressed data is read in place, no allocations required for matching or ranking
+struct SP_PUBLIC SearchVectorView {
+	static constexpr uint8_t Version = 2; // version 1 is the legacy CBOR format
+	static constexpr size_t HeaderSize = 16;
+	static constexpr size_t EntrySize = 12;
+
+	static constexpr uint32_t FlagWordIds = 1 << 0;
+	static constexpr uint32_t FlagCompressed = 1 << 1;
+
+	// smaller vectors are stored uncompressed, so they can be ranked in place
+	static constexpr size_t CompressionThreshold = 16 * 1024;
+
+	using Posting = sprt::pair<size_t, SearchData::Rank>;
+	using WordIdMap = Map<StringView, uint64_t>;
+	using WordIdCallback = Callback<uint64_t(StringView)>;
+
+	struct SP_PUBLIC PostingIterator {
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Posting;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Posting *;
+		using reference = const Posting &;
+
+		PostingIterator() = default;
+		PostingIterator(const uint8_t *ptr, const uint8_t *end, size_t count);
+
+		reference operator*() const { return _value; }
+		pointer operator->() const { return &_value; }
+
+		PostingIterator &operator++();
+		PostingIterator operator++(int) {
+			auto tmp = *this;
+			++(*this);
+			return tmp;
+		}
+
+		bool operator==(const PostingIterator &other) const {
+			return _remaining == other._remaining;
+		}
+		bool operator!=(const PostingIterator &other) const {
+			return _remaining != other._remaining;
+		}
+
+	protected:
+		void read();
+
+		const uint8_t *_ptr = nullptr;
+		const uint8_t *_end = nullptr;
+		size_t _remaining = 0;
+		Posting _value = Posting(0, SearchData::Rank::Unknown);
+	};
+
+	struct SP_PUBLIC PostingList {
+		PostingIterator begin() const { return PostingIterator(ptr, end_ptr, count); }
+		PostingIterator end() const { return PostingIterator(); }
+
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+
+		const uint8_t *ptr = nullptr;
+		const uint8_t *end_ptr = nullptr;
+		size_t count = 0;
+	};
+
+	// binary format of the current version, keyed by hashes or word ids
+	static bool isBinaryFormat(BytesView);
+
+	// current version, keyed by word ids; older blobs should be rewritten with `read` and `encode`
+	static bool isCurrentFormat(BytesView);
+
+	// keys are taken from `wordId`, when it's provided, hash32 is used otherwise
+	static Bytes encode(const SearchVector &, SearchData::Rank rank = SearchData::Rank::Unknown,
+			const WordIdCallback *wordId = nullptr);
+
+	// compress words table and word blocks, returns data as is, if data is smaller than
+	// threshold or compression is not effective
+	static Bytes compress(Bytes &&, size_t threshold = CompressionThreshold);
+
+	// decodes any known format (including legacy CBOR) into SearchVector, words are
+	// allocated from the current pool
+	static bool read(BytesView, SearchVector &);
+
+	SearchVectorView() = default;
+
+	// buffer is used to decompress data; compressed data is not readable without it
+	SearchVectorView(BytesView, Bytes *buffer = nullptr);
+
+	bool valid() const { return !_data.empty(); }
+
+	bool hasWordIds() const { return (_flags & FlagWordIds) != 0; }
+	bool isCompressed() const { return (_flags & FlagCompressed) != 0; }
+
+	size_t getDocumentLength() const { return _documentLength; }
+	size_t getWordsCount() const { return _wordsCount; }
+
+	// ids of the query words for the view, keyed with FlagWordIds; without it, such views
+	// are searched by the word itself with linear scan
+	void setWordIds(const WordIdMap *ids) { _wordIds = ids; }
+
+	bool find(StringView, PostingList &) const;
+	bool find(uint64_t key, PostingList &) const;
+
+	void foreach (const Callback<void(uint64_t, StringView, const PostingList &)> &) const;
+
+protected:
+	uint64_t readKey(size_t idx) const;
+	bool readWord(size_t idx, StringView &word, PostingList &) const;
+
+	BytesView _data;
+	size_t _documentLength = 0;
+	size_t _wordsCount = 0;
+	uint32_t _flags = 0;
+	const WordIdMap *_wordIds = nullptr;
+};
+
 struct SP_PUBLIC SearchQuery {
 	enum Block : uint8_t {
 		None,
@@ -114,6 +241,8 @@ struct SP_PUBLIC SearchQuery {
 	// used with opaque index format from `Configuration::encodeSearchVectorData`
 	bool isMatch(const BytesView &) const;
 
+	bool isMatch(const SearchVectorView &) const;
+
 	float rankQuery(const SearchVector &, Normalization = Normalization::Default,
 			RankingValues = RankingValues()) const;
 
@@ -121,6 +250,9 @@ struct SP_PUBLIC SearchQuery {
 	float rankQuery(const BytesView &, Normalization = Normalization::Default,
 			RankingValues = RankingValues()) const;
 
+	float rankQuery(const SearchVectorView &, Normalization = Normalization::Default,
+			RankingValues = RankingValues()) const;
+
 	void normalize();
 
 	void decompose(const Callback<void(StringView)> &positive,
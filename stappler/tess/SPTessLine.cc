@@ -272,6 +272,239 @@ static void drawArcRecursive(LineDrawer &drawer, const EllipseData &e, float sta
 	drawArcRecursive(drawer, e, startAngle + n_sweep, n_sweep, s.x, s.y, x1, y1, depth + 1);
 }
 
+// Analytic flattening, based on:
+// https://raphlinus.github.io/graphics/curves/2019/12/23/flatten-quadbez.html
+
+// upper bound for the segments within one curve, same as for max recursion depth
+constexpr uint32_t getMaxFlattenSegments() { return 1 << getMaxRecursionDepth(); }
+constexpr uint32_t getMaxFlattenQuads() { return 64; }
+
+// Curve in power basis: P(t) = c0 + c1 * t + c2 * t^2 + c3 * t^3
+struct FlattenCurve {
+	float cx[4];
+	float cy[4];
+
+	static FlattenCurve makeQuad(float x0, float y0, float x1, float y1, float x2, float y2) {
+		return FlattenCurve{
+			{x0, 2.0f * (x1 - x0), x0 - 2.0f * x1 + x2, 0.0f},
+			{y0, 2.0f * (y1 - y0), y0 - 2.0f * y1 + y2, 0.0f},
+		};
+	}
+
+	static FlattenCurve makeCubic(float x0, float y0, float x1, float y1, float x2, float y2,
+			float x3, float y3) {
+		return FlattenCurve{
+			{x0, 3.0f * (x1 - x0), 3.0f * (x0 - 2.0f * x1 + x2), x3 - x0 + 3.0f * (x1 - x2)},
+			{y0, 3.0f * (y1 - y0), 3.0f * (y0 - 2.0f * y1 + y2), y3 - y0 + 3.0f * (y1 - y2)},
+		};
+	}
+
+	Vec2 eval(float t) const {
+		return Vec2(cx[0] + t * (cx[1] + t * (cx[2] + t * cx[3])),
+				cy[0] + t * (cy[1] + t * (cy[2] + t * cy[3])));
+	}
+
+	Vec2 derivative(float t) const {
+		return Vec2(cx[1] + t * (2.0f * cx[2] + t * 3.0f * cx[3]),
+				cy[1] + t * (2.0f * cy[2] + t * 3.0f * cy[3]));
+	}
+};
+
+// Contiguous batch of curve parameters, that evaluated together before pushing into drawer
+struct FlattenBuffer {
+	static constexpr size_t Size = 32;
+
+	alignas(16) float t[Size] = {0.0f};
+	alignas(16) float x[Size];
+	alignas(16) float y[Size];
+	size_t count = 0;
+};
+
+// Parabola approximation for the quadratic bezier, see the article above
+struct FlattenQuadParams {
+	float a0 = 0.0f;
+	float a2 = 0.0f;
+	float u0 = 0.0f;
+	float u2 = 0.0f;
+	float val = 0.0f;
+
+	static float approxIntegral(float x) {
+		constexpr float d = 0.67f;
+		return x / (1.0f - d + sqrtf(sqrtf(d * d * d * d + 0.25f * x * x)));
+	}
+
+	static float approxInvIntegral(float x) {
+		constexpr float b = 0.39f;
+		return x * (1.0f - b + sqrtf(b * b + 0.25f * x * x));
+	}
+
+	// returns false for the degenerate curve (control points are collinear)
+	bool init(float x0, float y0, float x1, float y1, float x2, float y2, float sqrtTolerance) {
+		const float ddx = 2.0f * x1 - x0 - x2, ddy = 2.0f * y1 - y0 - y2;
+		const float cross = (x2 - x0) * ddy - (y2 - y0) * ddx;
+		if (fabsf(cross) <= std::numeric_limits<float>::epsilon()) {
+			return false;
+		}
+
+		const float px0 = ((x1 - x0) * ddx + (y1 - y0) * ddy) / cross;
+		const float px2 = ((x2 - x1) * ddx + (y2 - y1) * ddy) / cross;
+		const float scale = fabsf(cross) / (sqrtf(ddx * ddx + ddy * ddy) * fabsf(px2 - px0));
+		if (!std::isfinite(scale)) {
+			return false;
+		}
+
+		a0 = approxIntegral(px0);
+		a2 = approxIntegral(px2);
+
+		const float sqrtScale = sqrtf(scale);
+		if (std::signbit(px0) == std::signbit(px2)) {
+			val = fabsf(a2 - a0) * sqrtScale;
+		} else {
+			// curve contains the vertex of the parabola, limit its contribution
+			const float xmin = sqrtTolerance / sqrtScale;
+			val = sqrtTolerance * fabsf(a2 - a0) / approxIntegral(xmin);
+		}
+
+		u0 = approxInvIntegral(a0);
+		u2 = approxInvIntegral(a2);
+		return std::isfinite(val);
+	}
+
+	// curve parameter for the fraction of the approximated arc length
+	float getT(float u) const { return (approxInvIntegral(a0 + (a2 - a0) * u) - u0) / (u2 - u0); }
+};
+
+SP_ATTR_OPTIMIZE_FN static void drawFlattenFlush(LineDrawer &drawer, const FlattenCurve &curve,
+		FlattenBuffer &buf) {
+	const simd::f32x4 cx0 = simd::load(curve.cx[0]), cx1 = simd::load(curve.cx[1]),
+					  cx2 = simd::load(curve.cx[2]), cx3 = simd::load(curve.cx[3]);
+	const simd::f32x4 cy0 = simd::load(curve.cy[0]), cy1 = simd::load(curve.cy[1]),
+					  cy2 = simd::load(curve.cy[2]), cy3 = simd::load(curve.cy[3]);
+
+	// Horner's scheme for 4 points at once
+	for (size_t i = 0; i < buf.count; i += 4) {
+		const simd::f32x4 t = simd::load(&buf.t[i]);
+		simd::store(&buf.x[i],
+				simd::add(cx0,
+						simd::mul(t, simd::add(cx1, simd::mul(t, simd::add(cx2, simd::mul(t, cx3)))))));
+		simd::store(&buf.y[i],
+				simd::add(cy0,
+						simd::mul(t, simd::add(cy1, simd::mul(t, simd::add(cy2, simd::mul(t, cy3)))))));
+	}
+
+	for (size_t i = 0; i < buf.count; ++i) { drawer.push(buf.x[i], buf.y[i]); }
+
+	buf.count = 0;
+}
+
+static inline void drawFlattenPoint(LineDrawer &drawer, const FlattenCurve &curve,
+		FlattenBuffer &buf, float t) {
+	buf.t[buf.count++] = t;
+	if (buf.count == FlattenBuffer::Size) {
+		drawFlattenFlush(drawer, curve, buf);
+	}
+}
+
+static uint32_t getFlattenSegments(const LineDrawer &drawer, float n, float turn) {
+	n = ceilf(n);
+
+	// for stroke, offset curve should also follow the tangent closely enough
+	if (drawer.angularError >= std::numeric_limits<float>::epsilon()) {
+		n = std::max(n, ceilf(turn / drawer.angularError));
+	}
+
+	return uint32_t(std::clamp(n, 1.0f, float(getMaxFlattenSegments())));
+}
+
+static bool drawQuadBezierAnalytic(LineDrawer &drawer, float x0, float y0, float x1, float y1,
+		float x2, float y2) {
+	const float sqrtTolerance = sqrtf(sqrtf(drawer.distanceError));
+
+	FlattenQuadParams params;
+	if (!params.init(x0, y0, x1, y1, x2, y2, sqrtTolerance)) {
+		return false;
+	}
+
+	const auto n = getFlattenSegments(drawer, 0.5f * params.val / sqrtTolerance,
+			fabsf(draw_angle(x1 - x0, y1 - y0, x2 - x1, y2 - y1)));
+
+	const auto curve = FlattenCurve::makeQuad(x0, y0, x1, y1, x2, y2);
+
+	FlattenBuffer buf;
+	for (uint32_t i = 1; i < n; ++i) {
+		drawFlattenPoint(drawer, curve, buf, params.getT(float(i) / float(n)));
+	}
+	drawFlattenFlush(drawer, curve, buf);
+	return true;
+}
+
+static bool drawCubicBezierAnalytic(LineDrawer &drawer, float x0, float y0, float x1, float y1,
+		float x2, float y2, float x3, float y3) {
+	const float tolerance = sqrtf(drawer.distanceError);
+
+	// Cubic is split into quadratics first, small part of the tolerance is spent on it:
+	// error of the quadratic approximation is sqrt(3) / 36 * |p3 - 3p2 + 3p1 - p0| * dt^3
+	const float quadTolerance = tolerance * 0.1f;
+	const float sqrtTolerance = sqrtf(tolerance * 0.9f);
+
+	const float ddx = x3 - 3.0f * x2 + 3.0f * x1 - x0, ddy = y3 - 3.0f * y2 + 3.0f * y1 - y0;
+	const float err = sqrtf(ddx * ddx + ddy * ddy) * (sqrtf(3.0f) / 36.0f);
+	const auto nquads = std::max(1.0f, ceilf(cbrtf(err / quadTolerance)));
+	if (nquads > float(getMaxFlattenQuads())) {
+		return false;
+	}
+
+	const auto curve = FlattenCurve::makeCubic(x0, y0, x1, y1, x2, y2, x3, y3);
+	const auto quadsCount = uint32_t(nquads);
+	const float dt = 1.0f / nquads;
+
+	FlattenQuadParams params[getMaxFlattenQuads()];
+
+	float sum = 0.0f;
+	float turn = 0.0f;
+
+	for (uint32_t i = 0; i < quadsCount; ++i) {
+		const float t0 = float(i) * dt, t1 = float(i + 1) * dt;
+
+		const Vec2 p0 = curve.eval(t0);
+		const Vec2 p2 = curve.eval(t1);
+
+		// control point for the quadratic, that matches the cubic segment at the midpoint
+		const Vec2 c0 = p0 + curve.derivative(t0) * (dt / 3.0f);
+		const Vec2 c1 = p2 - curve.derivative(t1) * (dt / 3.0f);
+		const Vec2 p1 = ((c0 + c1) * 3.0f - p0 - p2) * 0.25f;
+
+		if (!params[i].init(p0.x, p0.y, p1.x, p1.y, p2.x, p2.y, sqrtTolerance)) {
+			return false;
+		}
+
+		sum += params[i].val;
+		turn += fabsf(draw_angle(p1.x - p0.x, p1.y - p0.y, p2.x - p1.x, p2.y - p1.y));
+	}
+
+	const auto n = getFlattenSegments(drawer, 0.5f * sum / sqrtTolerance, turn);
+	const float step = sum / float(n);
+
+	// distribute points uniformly along the whole curve, not within every quadratic
+	FlattenBuffer buf;
+	float valSum = 0.0f;
+	uint32_t idx = 1;
+	for (uint32_t i = 0; i < quadsCount; ++i) {
+		const float val = params[i].val;
+		if (val > 0.0f) {
+			while (idx < n && float(idx) * step <= valSum + val) {
+				const float u = (float(idx) * step - valSum) / val;
+				drawFlattenPoint(drawer, curve, buf,
+						(float(i) + std::clamp(params[i].getT(u), 0.0f, 1.0f)) * dt);
+				++idx;
+			}
+		}
+		valSum += val;
+	}
+	drawFlattenFlush(drawer, curve, buf);
+	return true;
+}
+
 static void drawArcBegin(LineDrawer &drawer, float x0, float y0, float rx, float ry, float phi,
 		bool largeArc, bool sweep, float x1, float y1) {
 	rx = fabsf(rx); ry = fabsf(ry);
@@ -305,6 +538,23 @@ static void drawArcBegin(LineDrawer &drawer, float x0, float y0, float rx, float
 			: std::min(fabsf(sweepAngle), float(M_PI * 2 - fabsf(sweepAngle)));
 
 	if (rx > std::numeric_limits<float>::epsilon() && ry > std::numeric_limits<float>::epsilon()) {
+		const float tolerance = sqrtf(drawer.distanceError);
+		const float r_max = std::max(rx, ry);
+		if (drawer.flattening == LineFlattening::Analytic && tolerance < r_max) {
+			// chord error for the largest radius bounds the error for the ellipse
+			const uint32_t npts = getFlattenSegments(drawer,
+					sweepAngle / (acosf(1.0f - tolerance / r_max) * 2.0f), sweepAngle);
+
+			EllipseData d{ cx, cy, rx, ry, (rx * rx) / (ry * ry), cos_phi, sin_phi };
+			const float segmentAngle = (sweep ? -1.0f : 1.0f) * sweepAngle / float(npts);
+			for (uint32_t i = 1; i < npts; ++ i) {
+				const Vec2 s = d.rotatePoint(startAngle, segmentAngle * float(i));
+				drawer.push(s.x, s.y);
+			}
+			drawer.push(x1, y1);
+			return;
+		}
+
 		const float r_avg = (rx + ry) / 2.0f;
 		const float err = (r_avg - sqrtf(drawer.distanceError)) / r_avg;
 		if (err > M_SQRT1_2 * 0.5f - std::numeric_limits<float>::epsilon()) {
@@ -394,11 +644,18 @@ void LineDrawer::drawLine(float x, float y) {
 	push(x, y);
 }
 void LineDrawer::drawQuadBezier(float x1, float y1, float x2, float y2) {
-	drawQuadBezierRecursive(*this, target->point.x, target->point.y, x1, y1, x2, y2, 0);
+	if (flattening != LineFlattening::Analytic
+			|| !drawQuadBezierAnalytic(*this, target->point.x, target->point.y, x1, y1, x2, y2)) {
+		drawQuadBezierRecursive(*this, target->point.x, target->point.y, x1, y1, x2, y2, 0);
+	}
 	push(x2, y2);
 }
 void LineDrawer::drawCubicBezier(float x1, float y1, float x2, float y2, float x3, float y3) {
-	drawCubicBezierRecursive(*this, target->point.x, target->point.y, x1, y1, x2, y2, x3, y3, 0);
+	if (flattening != LineFlattening::Analytic
+			|| !drawCubicBezierAnalytic(*this, target->point.x, target->point.y, x1, y1, x2, y2,
+					x3, y3)) {
+		drawCubicBezierRecursive(*this, target->point.x, target->point.y, x1, y1, x2, y2, x3, y3, 0);
+	}
 	push(x3, y3);
 }
 void LineDrawer::drawArc(float rx, float ry, float phi, bool largeArc, bool sweep, float x1, float y1) {
@@ -54,6 +54,16 @@ SP_DEFINE_ENUM_AS_MASK(DrawFlags)
 
 using DrawStyle = DrawFlags;
 
+enum class LineFlattening {
+	// Recursive subdivision with distance and angular checks on every level
+	Recursive,
+
+	// Segment count is computed up front with parabola approximation, then curve points are
+	// evaluated with SIMD in batches. Produces fewer segments for the same distance error.
+	// Falls back to Recursive for degenerate curves (cusps, collinear control points)
+	Analytic,
+};
+
 // Helper class, that transform lines in SVG notation (bezier2/3, arcs) into series of segments,
 // then output this segments to contour in tesselator
 struct SP_PUBLIC LineDrawer {
@@ -81,6 +91,7 @@ struct SP_PUBLIC LineDrawer {
 	};
 
 	DrawStyle style = DrawStyle::None;
+	LineFlattening flattening = LineFlattening::Recursive;
 	LineJoin lineJoin = LineJoin::Miter;
 	LineCup lineCup = LineCup::Butt;
 	float distanceError = 0.0f;
@@ -44,6 +44,14 @@ protected:
 	StringView _name;
 };
 
+static std::atomic<ThreadPool::ExecutionHook> s_executionBeginHook = nullptr;
+static std::atomic<ThreadPool::ExecutionHook> s_executionEndHook = nullptr;
+
+void ThreadPool::setExecutionHooks(ExecutionHook begin, ExecutionHook end) {
+	s_executionBeginHook.store(begin);
+	s_executionEndHook.store(end);
+}
+
 bool ThreadPool::init(ThreadPoolInfo &&info) { return _context.init(move(info), this); }
 
 Status ThreadPool::perform(Rc<Task> &&task, bool first) {
@@ -119,8 +127,18 @@ bool ThreadPool::Worker::worker() {
 	}
 
 	--_queue->tasksInQueue;
+
+	auto endHook = s_executionEndHook.load(std::memory_order_relaxed);
+	if (auto beginHook = s_executionBeginHook.load(std::memory_order_relaxed)) {
+		beginHook(*task);
+	}
+
 	task->execute();
 
+	if (endHook) {
+		endHook(*task);
+	}
+
 	_queue->onMainThreadWorker(sp::move(task));
 
 	return true;
@@ -61,6 +61,12 @@ struct SP_PUBLIC ThreadPoolInfo {
 
 class SP_PUBLIC ThreadPool : public Ref {
 public:
+	using ExecutionHook = void (*)(const Task &);
+
+	// Hooks called by worker threads around Task::execute, used by profilers
+	// Pass nullptr to remove hooks
+	static void setExecutionHooks(ExecutionHook begin, ExecutionHook end);
+
 	virtual ~ThreadPool() = default;
 
 	bool init(ThreadPoolInfo &&);
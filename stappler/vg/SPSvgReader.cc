@@ -534,21 +534,23 @@ void SvgReader::emplacePath(Tag &tag) {
 		if (ref.is('#')) {
 			++ref;
 		}
-		auto pathIt = _paths.find(ref);
-		if (pathIt != _paths.end()) {
-			if (_defs) {
-				if (!tag.id.empty()) {
-					VectorPath npath(pathIt->second);
-					npath.applyTransform(tag.mat);
-					_paths.emplace(tag.id.str<Interface>(), move(npath));
-				}
+		if (ref.empty()) {
+			return;
+		}
+
+		// reference can point to the element, defined later in file,
+		// so, references are resolved in `finalize`, without copying paths
+		if (_defs) {
+			if (!tag.id.empty()) {
+				_refs.emplace(tag.id.str<Interface>(),
+						PathXRef{ref.str<Interface>(), Interface::StringType(), tag.mat});
+			}
+		} else {
+			if (tag.mat.isIdentity()) {
+				_drawOrder.emplace_back(PathXRef{ref.str<Interface>()});
 			} else {
-				if (tag.mat.isIdentity()) {
-					_drawOrder.emplace_back(PathXRef{ref.str<Interface>()});
-				} else {
-					_drawOrder.emplace_back(
-							PathXRef{ref.str<Interface>(), Interface::StringType(), tag.mat});
-				}
+				_drawOrder.emplace_back(
+						PathXRef{ref.str<Interface>(), Interface::StringType(), tag.mat});
 			}
 		}
 	} else if (tag.rpath) {
@@ -567,4 +569,45 @@ void SvgReader::emplacePath(Tag &tag) {
 	}
 }
 
+void SvgReader::finalize() {
+	// limits alias chains, also protects from cyclic references
+	static constexpr size_t MaxRefDepth = 16;
+
+	auto it = _drawOrder.begin();
+	while (it != _drawOrder.end()) {
+		if (_paths.find(it->id) != _paths.end()) {
+			++it;
+			continue;
+		}
+
+		// alias transform applies before the transform of the outer reference
+		bool found = false;
+		StringView id(it->id);
+		Mat4 mat(it->mat);
+		for (size_t depth = 0; depth < MaxRefDepth; ++depth) {
+			auto refIt = _refs.find(id);
+			if (refIt == _refs.end()) {
+				break;
+			}
+
+			mat = refIt->second.mat * mat;
+			id = refIt->second.id;
+			if (_paths.find(id) != _paths.end()) {
+				found = true;
+				break;
+			}
+		}
+
+		if (found) {
+			it->id = id.str<Interface>();
+			it->mat = mat;
+			++it;
+		} else {
+			it = _drawOrder.erase(it);
+		}
+	}
+
+	_refs.clear();
+}
+
 } // namespace stappler::vg
@@ -86,6 +86,9 @@ struct SP_PUBLIC SvgReader {
 
 	void emplacePath(Tag &tag);
 
+	// Resolves <use> references, should be called when parsing is finished
+	void finalize();
+
 	bool _defs = false;
 	float _squareLength = 0.0f;
 	float _width = 0;
@@ -95,6 +98,10 @@ struct SP_PUBLIC SvgReader {
 	Rect _viewBox;
 	Interface::VectorType<PathXRef> _drawOrder;
 	Interface::MapType<Interface::StringType, VectorPath> _paths;
+
+	// <use> elements with id within <defs>: aliases for other paths, resolved lazily,
+	// only when they are actually drawn
+	Interface::MapType<Interface::StringType, PathXRef> _refs;
 };
 
 }
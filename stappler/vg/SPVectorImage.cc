@@ -28,8 +28,264 @@ THE SOFTWARE.
 #include "SPBitmap.h"
 #endif
 
+#if MODULE_STAPPLER_FILESYSTEM
+#include "SPFilesystemMap.h"
+#endif
+
 namespace STAPPLER_VERSIONIZED stappler::vg {
 
+// Binary image layout: header, paths, xrefs (draw order), strings, points, uv, commands
+// Offsets are from the start of the data, ranges within arrays are in elements
+struct VectorImageBinaryHeader {
+	static constexpr uint32_t Magic = 0x4956'5053; // 'SPVI'
+	static constexpr uint32_t ByteOrder = 0x0102'0304;
+
+	uint32_t magic = Magic;
+	uint32_t version = VectorImage::BinaryVersion;
+	uint32_t byteOrder = ByteOrder;
+	uint32_t batchDrawing = 0;
+
+	float imageSize[2] = {0.0f, 0.0f};
+	float viewBox[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	float viewBoxTransform[16];
+
+	uint32_t nextId = 0;
+	uint32_t pathsCount = 0;
+	uint32_t xrefsCount = 0;
+	uint32_t stringsSize = 0;
+	uint32_t pointsCount = 0;
+	uint32_t uvCount = 0;
+	uint32_t commandsCount = 0;
+	uint32_t padding = 0;
+
+	uint64_t pathsOffset = 0;
+	uint64_t xrefsOffset = 0;
+	uint64_t stringsOffset = 0;
+	uint64_t pointsOffset = 0;
+	uint64_t uvOffset = 0;
+	uint64_t commandsOffset = 0;
+	uint64_t dataSize = 0;
+};
+
+struct VectorImageBinaryPath {
+	uint32_t idOffset = 0;
+	uint32_t idSize = 0;
+	uint32_t firstPoint = 0;
+	uint32_t pointsCount = 0;
+	uint32_t firstUv = 0;
+	uint32_t uvCount = 0;
+	uint32_t firstCommand = 0;
+	uint32_t commandsCount = 0;
+
+	float transform[16];
+	uint8_t fillColor[4];
+	uint8_t strokeColor[4];
+	uint32_t style = 0;
+	float strokeWidth = 1.0f;
+	uint32_t winding = 0;
+	uint32_t lineCup = 0;
+	uint32_t lineJoin = 0;
+	float miterLimit = 4.0f;
+	uint32_t antialiased = 0;
+	uint32_t padding = 0;
+};
+
+struct VectorImageBinaryXRef {
+	uint32_t idOffset = 0;
+	uint32_t idSize = 0;
+	uint32_t cacheIdOffset = 0;
+	uint32_t cacheIdSize = 0;
+	float mat[16];
+	float color[4];
+};
+
+#if MODULE_STAPPLER_FILESYSTEM
+// Mapped binary image file, retained by paths, that read their data from it
+class VectorImageMapping : public Ref {
+public:
+	bool init(filesystem::MemoryMappedRegion &&r) {
+		region.emplace(sp::move(r));
+		return true;
+	}
+
+	BytesView getView() const { return region->getView(); }
+
+protected:
+	std::optional<filesystem::MemoryMappedRegion> region;
+};
+#endif
+
+template <typename Type>
+static bool VectorImage_isAligned(const uint8_t *ptr) {
+	return reinterpret_cast<uintptr_t>(ptr) % alignof(Type) == 0;
+}
+
+// With storage, that holds `data`, paths reference points, commands and uv in it directly,
+// otherwise (or when data is not aligned) arrays are copied into paths
+static Rc<VectorImageData> VectorImage_readBinary(VectorImage *image, BytesView data,
+		Ref *storage) {
+	if (data.size() < sizeof(VectorImageBinaryHeader)) {
+		return nullptr;
+	}
+
+	VectorImageBinaryHeader header;
+	memcpy(&header, data.data(), sizeof(VectorImageBinaryHeader));
+
+	if (header.magic != VectorImageBinaryHeader::Magic
+			|| header.version != VectorImage::BinaryVersion
+			|| header.byteOrder != VectorImageBinaryHeader::ByteOrder
+			|| header.dataSize != data.size()) {
+		return nullptr;
+	}
+
+	auto isValidRange = [&](uint64_t offset, uint64_t count, size_t size) {
+		return offset <= data.size() && count <= (data.size() - offset) / size;
+	};
+
+	if (!isValidRange(header.pathsOffset, header.pathsCount, sizeof(VectorImageBinaryPath))
+			|| !isValidRange(header.xrefsOffset, header.xrefsCount, sizeof(VectorImageBinaryXRef))
+			|| !isValidRange(header.stringsOffset, header.stringsSize, 1)
+			|| !isValidRange(header.pointsOffset, header.pointsCount, sizeof(CommandData))
+			|| !isValidRange(header.uvOffset, header.uvCount, sizeof(Vec2))
+			|| !isValidRange(header.commandsOffset, header.commandsCount, sizeof(Command))) {
+		return nullptr;
+	}
+
+	// data can be unaligned (e.g. from arbitrary buffer), so, values are copied with memcpy,
+	// arrays - with single memcpy for each path, if they can not be referenced in storage
+	auto strings = StringView(reinterpret_cast<const char *>(data.data() + header.stringsOffset),
+			header.stringsSize);
+	auto points = data.data() + header.pointsOffset;
+	auto uv = data.data() + header.uvOffset;
+	auto commands = data.data() + header.commandsOffset;
+
+	bool useStorage = storage && VectorImage_isAligned<CommandData>(points)
+			&& VectorImage_isAligned<Vec2>(uv) && VectorImage_isAligned<Command>(commands);
+
+	auto readString = [&](uint32_t offset, uint32_t size, StringView &out) {
+		if (uint64_t(offset) + size > strings.size()) {
+			return false;
+		}
+		out = strings.sub(offset, size);
+		return true;
+	};
+
+	auto styleMask =
+			toInt(DrawFlags::Fill | DrawFlags::Stroke | DrawFlags::PseudoSdf | DrawFlags::UV);
+
+	Interface::MapType<VectorImageData::String, Rc<VectorPath>> paths;
+	for (uint32_t i = 0; i < header.pathsCount; ++i) {
+		VectorImageBinaryPath it;
+		memcpy(&it, data.data() + header.pathsOffset + i * sizeof(VectorImageBinaryPath),
+				sizeof(VectorImageBinaryPath));
+
+		StringView id;
+		if (!readString(it.idOffset, it.idSize, id)
+				|| uint64_t(it.firstPoint) + it.pointsCount > header.pointsCount
+				|| uint64_t(it.firstUv) + it.uvCount > header.uvCount
+				|| uint64_t(it.firstCommand) + it.commandsCount > header.commandsCount) {
+			return nullptr;
+		}
+
+		// enum values are used as indexes and switch values in tesselator, check them before use
+		if ((it.style & ~styleMask) != 0 || it.winding > toInt(Winding::AbsGeqTwo)
+				|| it.lineCup > toInt(LineCup::Square) || it.lineJoin > toInt(LineJoin::Bevel)) {
+			return nullptr;
+		}
+
+		auto pathCommands = SpanView<Command>(
+				reinterpret_cast<const Command *>(commands + it.firstCommand * sizeof(Command)),
+				it.commandsCount);
+
+		// commands defines how points are read in renderer, so, they should match exactly
+		size_t expectedPoints = 0;
+		for (auto cmd : pathCommands) {
+			switch (cmd) {
+			case Command::MoveTo:
+			case Command::LineTo: expectedPoints += 1; break;
+			case Command::QuadTo: expectedPoints += 2; break;
+			case Command::CubicTo:
+			case Command::ArcTo: expectedPoints += 3; break;
+			case Command::ClosePath: break;
+			default: return nullptr;
+			}
+		}
+
+		if (expectedPoints != it.pointsCount) {
+			return nullptr;
+		}
+
+		PathParams params;
+		memcpy(params.transform.m, it.transform, sizeof(float) * 16);
+		params.fillColor =
+				Color4B(it.fillColor[0], it.fillColor[1], it.fillColor[2], it.fillColor[3]);
+		params.strokeColor = Color4B(it.strokeColor[0], it.strokeColor[1], it.strokeColor[2],
+				it.strokeColor[3]);
+		params.style = DrawFlags(it.style);
+		params.strokeWidth = it.strokeWidth;
+		params.winding = Winding(it.winding);
+		params.lineCup = LineCup(it.lineCup);
+		params.lineJoin = LineJoin(it.lineJoin);
+		params.miterLimit = it.miterLimit;
+		params.isAntialiased = it.antialiased != 0;
+
+		auto path = Rc<VectorPath>::alloc();
+		if (useStorage) {
+			auto pathPoints = SpanView<CommandData>(
+					reinterpret_cast<const CommandData *>(points) + it.firstPoint, it.pointsCount);
+			auto pathUv = SpanView<Vec2>(reinterpret_cast<const Vec2 *>(uv) + it.firstUv,
+					it.uvCount);
+			path->init(params, pathCommands, pathPoints, pathUv, Rc<Ref>(storage));
+		} else {
+			PathData<Interface> pathData;
+			pathData.params = params;
+
+			pathData.commands.resize(it.commandsCount);
+			memcpy(pathData.commands.data(), pathCommands.data(),
+					it.commandsCount * sizeof(Command));
+
+			pathData.points.resize(it.pointsCount);
+			memcpy(pathData.points.data(), points + it.firstPoint * sizeof(CommandData),
+					it.pointsCount * sizeof(CommandData));
+
+			pathData.uv.resize(it.uvCount);
+			memcpy(pathData.uv.data(), uv + it.firstUv * sizeof(Vec2), it.uvCount * sizeof(Vec2));
+
+			path->init(sp::move(pathData));
+		}
+		paths.emplace(id.str<Interface>(), sp::move(path));
+	}
+
+	Interface::VectorType<PathXRef> order;
+	order.reserve(header.xrefsCount);
+	for (uint32_t i = 0; i < header.xrefsCount; ++i) {
+		VectorImageBinaryXRef it;
+		memcpy(&it, data.data() + header.xrefsOffset + i * sizeof(VectorImageBinaryXRef),
+				sizeof(VectorImageBinaryXRef));
+
+		StringView id, cacheId;
+		if (!readString(it.idOffset, it.idSize, id)
+				|| !readString(it.cacheIdOffset, it.cacheIdSize, cacheId)) {
+			return nullptr;
+		}
+
+		auto &ref = order.emplace_back(PathXRef{id.str<Interface>(), cacheId.str<Interface>()});
+		memcpy(ref.mat.m, it.mat, sizeof(float) * 16);
+		ref.color = Color4F(it.color[0], it.color[1], it.color[2], it.color[3]);
+	}
+
+	Mat4 viewBoxTransform;
+	memcpy(viewBoxTransform.m, header.viewBoxTransform, sizeof(float) * 16);
+
+	auto ret = Rc<VectorImageData>::create(image, Size2(header.imageSize[0], header.imageSize[1]),
+			Rect(header.viewBox[0], header.viewBox[1], header.viewBox[2], header.viewBox[3]),
+			viewBoxTransform, sp::move(order), sp::move(paths), uint16_t(header.nextId));
+	if (ret) {
+		ret->setBatchDrawing(header.batchDrawing != 0);
+	}
+	return ret;
+}
+
 bool VectorPathRef::init(VectorImage *image, const String &id, const Rc<VectorPath> &path) {
 	_image = image;
 	_id = id;
@@ -354,6 +610,19 @@ bool VectorImageData::init(VectorImage *image, Size2 size, Rect viewBox) {
 	return true;
 }
 
+bool VectorImageData::init(VectorImage *image, Size2 size, Rect viewBox,
+		const Mat4 &viewBoxTransform, Interface::VectorType<PathXRef> &&order,
+		Interface::MapType<String, Rc<VectorPath>> &&paths, uint16_t ids) {
+	_imageSize = size;
+	_image = image;
+	_viewBox = viewBox;
+	_viewBoxTransform = viewBoxTransform;
+	_order = sp::move(order);
+	_paths = sp::move(paths);
+	_nextId = ids;
+	return true;
+}
+
 bool VectorImageData::init(VectorImageData &data) {
 	_allowBatchDrawing = data._allowBatchDrawing;
 	_imageSize = data._imageSize;
@@ -474,6 +743,28 @@ bool VectorImage::isSvg(const FileInfo &file) {
 #endif
 #endif // MODULE_STAPPLER_BITMAP
 
+bool VectorImage::isBinary(BytesView data) {
+	if (data.size() < sizeof(VectorImageBinaryHeader)) {
+		return false;
+	}
+
+	uint32_t magic = 0;
+	memcpy(&magic, data.data(), sizeof(uint32_t));
+	return magic == VectorImageBinaryHeader::Magic;
+}
+
+Interface::BytesType VectorImage::convertSvgToBinary(BytesView data) {
+	if (isBinary(data)) {
+		return Interface::BytesType(data.data(), data.data() + data.size());
+	}
+
+	auto image = Rc<VectorImage>::create(data);
+	if (!image) {
+		return Interface::BytesType();
+	}
+	return image->encode();
+}
+
 VectorImage::~VectorImage() {
 	for (auto &it : _paths) { it.second->setImage(nullptr); }
 }
@@ -498,9 +789,10 @@ bool VectorImage::init(Size2 size) {
 }
 
 bool VectorImage::init(StringView data) {
-	String tmp = data.str<Interface>();
+	// reader does not hold references to the source data after parsing, no need to copy it
 	vg::SvgReader reader;
-	html::parse<vg::SvgReader, StringView, vg::SvgTag>(reader, StringView(tmp));
+	html::parse<vg::SvgReader, StringView, vg::SvgTag>(reader, data);
+	reader.finalize();
 
 	if (!reader._paths.empty()) {
 		_data = Rc<VectorImageData>::create(this, Size2(reader._width, reader._height),
@@ -525,9 +817,14 @@ bool VectorImage::init(StringView data) {
 }
 
 bool VectorImage::init(BytesView data) {
+	if (isBinary(data)) {
+		return initBinary(data, nullptr);
+	}
+
 	vg::SvgReader reader;
 	html::parse<vg::SvgReader, StringView, vg::SvgTag>(reader,
 			StringView((const char *)data.data(), data.size()));
+	reader.finalize();
 
 	if (!reader._paths.empty()) {
 		_data = Rc<VectorImageData>::create(this, Size2(reader._width, reader._height),
@@ -553,16 +850,47 @@ bool VectorImage::init(BytesView data) {
 
 #if MODULE_STAPPLER_FILESYSTEM
 bool VectorImage::init(const FileInfo &ipath) {
-	auto data = filesystem::readTextFile<Interface>(ipath);
+	// parse directly from the mapped file, without reading it into memory
+	auto region = filesystem::MemoryMappedRegion::mapFile(ipath, filesystem::MappingType::Private,
+			filesystem::ProtFlags::MapRead);
+	if (region) {
+		auto data = region.getView();
+		if (isBinary(data)) {
+			// paths read their data from the mapping directly and retain it
+			if (auto mapping = Rc<VectorImageMapping>::create(sp::move(region))) {
+				return initBinary(mapping->getView(), mapping.get());
+			}
+			return false;
+		}
+		if (!data.empty()) {
+			return init(data);
+		}
+		return false;
+	}
+
+	auto data = filesystem::readIntoMemory<Interface>(ipath);
 
 	if (!data.empty()) {
-		return init(sp::move(data));
+		return init(BytesView(data));
 	}
 
 	return false;
 }
 #endif
 
+bool VectorImage::initBinary(BytesView data, Ref *storage) {
+	_data = VectorImage_readBinary(this, data, storage);
+	if (!_data) {
+		log::source().error("layout::Image", "Invalid binary image data");
+		return false;
+	}
+
+	for (auto &it : _data->getPaths()) {
+		_paths.emplace(it.first, Rc<VectorPathRef>::create(this, it.first, it.second));
+	}
+	return true;
+}
+
 void VectorImage::setImageSize(const Size2 &size) {
 	if (size == _data->getImageSize()) {
 		return;
@@ -716,6 +1044,179 @@ Rc<VectorImageData> VectorImage::popData() {
 	return _data;
 }
 
+Interface::BytesType VectorImage::encode() const {
+	static constexpr size_t Align = 16;
+
+	auto alignOffset = [](size_t offset) { return (offset + Align - 1) & ~(Align - 1); };
+
+	auto &paths = _data->getPaths();
+	auto &order = _data->getDrawOrder();
+
+	Interface::StringType strings;
+	size_t pointsCount = 0;
+	size_t uvCount = 0;
+	size_t commandsCount = 0;
+
+	for (auto &it : paths) {
+		pointsCount += it.second->getPoints().size();
+		uvCount += it.second->getUVPoints().size();
+		commandsCount += it.second->getCommands().size();
+	}
+
+	if (paths.size() > maxOf<uint32_t>() || order.size() > maxOf<uint32_t>()
+			|| pointsCount > maxOf<uint32_t>() || uvCount > maxOf<uint32_t>()
+			|| commandsCount > maxOf<uint32_t>()) {
+		log::source().error("VectorImage", "Image is too large for binary encoding");
+		return Interface::BytesType();
+	}
+
+	// offsets in strings section are 32-bit, so, size is checked before every append
+	bool stringsOverflow = false;
+	auto addString = [&](StringView str, uint32_t &offset, uint32_t &size) {
+		if (stringsOverflow || str.size() > maxOf<uint32_t>() - strings.size()) {
+			stringsOverflow = true;
+			return;
+		}
+		offset = uint32_t(strings.size());
+		size = uint32_t(str.size());
+		strings.append(str.data(), str.size());
+	};
+
+	VectorImageBinaryHeader header;
+	header.batchDrawing = _data->isBatchDrawing() ? 1 : 0;
+	header.imageSize[0] = _data->getImageSize().width;
+	header.imageSize[1] = _data->getImageSize().height;
+	header.viewBox[0] = _data->getViewBox().origin.x;
+	header.viewBox[1] = _data->getViewBox().origin.y;
+	header.viewBox[2] = _data->getViewBox().size.width;
+	header.viewBox[3] = _data->getViewBox().size.height;
+	memcpy(header.viewBoxTransform, _data->getViewBoxTransform().m, sizeof(float) * 16);
+	header.nextId = _data->getIdCounter();
+	header.pathsCount = uint32_t(paths.size());
+	header.xrefsCount = uint32_t(order.size());
+	header.pointsCount = uint32_t(pointsCount);
+	header.uvCount = uint32_t(uvCount);
+	header.commandsCount = uint32_t(commandsCount);
+
+	Interface::VectorType<VectorImageBinaryPath> binPaths;
+	binPaths.reserve(paths.size());
+
+	uint32_t pointsOffset = 0;
+	uint32_t uvOffset = 0;
+	uint32_t commandsOffset = 0;
+	for (auto &it : paths) {
+		auto &path = *it.second;
+		auto &bin = binPaths.emplace_back();
+		addString(it.first, bin.idOffset, bin.idSize);
+
+		bin.firstPoint = pointsOffset;
+		bin.pointsCount = uint32_t(path.getPoints().size());
+		bin.firstUv = uvOffset;
+		bin.uvCount = uint32_t(path.getUVPoints().size());
+		bin.firstCommand = commandsOffset;
+		bin.commandsCount = uint32_t(path.getCommands().size());
+
+		pointsOffset += bin.pointsCount;
+		uvOffset += bin.uvCount;
+		commandsOffset += bin.commandsCount;
+
+		memcpy(bin.transform, path.getTransform().m, sizeof(float) * 16);
+
+		auto &fill = path.getFillColor();
+		auto &stroke = path.getStrokeColor();
+		bin.fillColor[0] = fill.r;
+		bin.fillColor[1] = fill.g;
+		bin.fillColor[2] = fill.b;
+		bin.fillColor[3] = fill.a;
+		bin.strokeColor[0] = stroke.r;
+		bin.strokeColor[1] = stroke.g;
+		bin.strokeColor[2] = stroke.b;
+		bin.strokeColor[3] = stroke.a;
+		bin.style = toInt(path.getStyle());
+		bin.strokeWidth = path.getStrokeWidth();
+		bin.winding = toInt(path.getWindingRule());
+		bin.lineCup = toInt(path.getLineCup());
+		bin.lineJoin = toInt(path.getLineJoin());
+		bin.miterLimit = path.getMiterLimit();
+		bin.antialiased = path.isAntialiased() ? 1 : 0;
+	}
+
+	Interface::VectorType<VectorImageBinaryXRef> binOrder;
+	binOrder.reserve(order.size());
+	for (auto &it : order) {
+		auto &bin = binOrder.emplace_back();
+		addString(it.id, bin.idOffset, bin.idSize);
+		addString(it.cacheId, bin.cacheIdOffset, bin.cacheIdSize);
+		memcpy(bin.mat, it.mat.m, sizeof(float) * 16);
+		bin.color[0] = it.color.r;
+		bin.color[1] = it.color.g;
+		bin.color[2] = it.color.b;
+		bin.color[3] = it.color.a;
+	}
+
+	if (stringsOverflow) {
+		log::source().error("VectorImage", "Image is too large for binary encoding");
+		return Interface::BytesType();
+	}
+	header.stringsSize = uint32_t(strings.size());
+
+	// sections are aligned, so, float arrays can be read directly from mapped memory
+	size_t offset = alignOffset(sizeof(VectorImageBinaryHeader));
+	header.pathsOffset = offset;
+	offset = alignOffset(offset + binPaths.size() * sizeof(VectorImageBinaryPath));
+	header.xrefsOffset = offset;
+	offset = alignOffset(offset + binOrder.size() * sizeof(VectorImageBinaryXRef));
+	header.pointsOffset = offset;
+	offset = alignOffset(offset + pointsCount * sizeof(CommandData));
+	header.uvOffset = offset;
+	offset = alignOffset(offset + uvCount * sizeof(Vec2));
+	header.commandsOffset = offset;
+	offset = alignOffset(offset + commandsCount * sizeof(Command));
+	header.stringsOffset = offset;
+	offset += strings.size();
+	header.dataSize = offset;
+
+	Interface::BytesType ret;
+	ret.resize(offset, 0);
+
+	auto data = ret.data();
+	memcpy(data, &header, sizeof(VectorImageBinaryHeader));
+	if (!binPaths.empty()) {
+		memcpy(data + header.pathsOffset, binPaths.data(),
+				binPaths.size() * sizeof(VectorImageBinaryPath));
+	}
+	if (!binOrder.empty()) {
+		memcpy(data + header.xrefsOffset, binOrder.data(),
+				binOrder.size() * sizeof(VectorImageBinaryXRef));
+	}
+	if (!strings.empty()) {
+		memcpy(data + header.stringsOffset, strings.data(), strings.size());
+	}
+
+	auto points = data + header.pointsOffset;
+	auto uv = data + header.uvOffset;
+	auto commands = data + header.commandsOffset;
+	for (auto &it : paths) {
+		auto p = it.second->getPoints();
+		auto u = it.second->getUVPoints();
+		auto c = it.second->getCommands();
+		if (!p.empty()) {
+			memcpy(points, p.data(), p.size() * sizeof(CommandData));
+			points += p.size() * sizeof(CommandData);
+		}
+		if (!u.empty()) {
+			memcpy(uv, u.data(), u.size() * sizeof(Vec2));
+			uv += u.size() * sizeof(Vec2);
+		}
+		if (!c.empty()) {
+			memcpy(commands, c.data(), c.size() * sizeof(Command));
+			commands += c.size() * sizeof(Command);
+		}
+	}
+
+	return ret;
+}
+
 bool VectorImage::isDirty() const { return _dirty; }
 
 void VectorImage::setDirty() { _dirty = true; }
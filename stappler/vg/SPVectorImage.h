@@ -110,6 +110,9 @@ public:
 	bool init(VectorImage *, Size2 size, Rect viewBox, Interface::VectorType<PathXRef> &&,
 			Interface::MapType<String, VectorPath> &&, uint16_t ids);
 	bool init(VectorImage *, Size2 size, Rect viewBox);
+	bool init(VectorImage *, Size2 size, Rect viewBox, const Mat4 &viewBoxTransform,
+			Interface::VectorType<PathXRef> &&, Interface::MapType<String, Rc<VectorPath>> &&,
+			uint16_t ids);
 	bool init(VectorImageData &);
 
 	void setImageSize(const Size2 &);
@@ -121,6 +124,7 @@ public:
 	Rc<VectorPath> copyPath(StringView);
 
 	uint16_t getNextId();
+	uint16_t getIdCounter() const { return _nextId; }
 
 	Rc<VectorPath> addPath(StringView id, StringView cacheId, VectorPath &&,
 			Mat4 mat = Mat4::IDENTITY);
@@ -165,6 +169,16 @@ public:
 #endif
 #endif // MODULE_STAPPLER_BITMAP
 
+	// Binary container for the whole image (paths with params, draw order, view box), intended
+	// to be produced once from SVG and loaded without parsing; init(BytesView) and
+	// init(FileInfo) detect it automatically. Format depends on the platform byte order
+	static constexpr uint32_t BinaryVersion = 1;
+
+	static bool isBinary(BytesView);
+
+	// Returns empty bytes if SVG can not be read
+	static Interface::BytesType convertSvgToBinary(BytesView);
+
 	virtual ~VectorImage();
 
 	bool init(Size2, StringView);
@@ -211,6 +225,8 @@ public:
 
 	Rc<VectorImageData> popData();
 
+	Interface::BytesType encode() const;
+
 	bool isDirty() const;
 	void setDirty();
 	void clearDirty();
@@ -218,6 +234,9 @@ public:
 protected:
 	friend class VectorPathRef;
 
+	// Storage retains `data`, if paths can reference it directly, nullptr to copy data into paths
+	bool initBinary(BytesView data, Ref *storage);
+
 	void copy();
 	void markCopyOnWrite();
 
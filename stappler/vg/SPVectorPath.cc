@@ -35,30 +35,52 @@ VectorPath::VectorPath(size_t count) { _data.getWriter().reserve(count); }
 bool VectorPath::init() { return true; }
 
 bool VectorPath::init(StringView path) {
+	releaseStorage();
 	_data.clear();
 
 	return _data.getWriter().readFromPathString(path);
 }
 
 bool VectorPath::init(const FileInfo &str) {
+	releaseStorage();
 	_data.clear();
 
 	return _data.getWriter().readFromFile(str);
 }
 
 bool VectorPath::init(BytesView data) {
+	releaseStorage();
 	_data.clear();
 
 	return _data.getWriter().readFromBytes(data);
 }
 
 bool VectorPath::init(const PathData<memory::StandartInterface> &data) {
+	releaseStorage();
 	_data.clear();
 	_data = data;
 	return true;
 }
 
+bool VectorPath::init(PathData<memory::StandartInterface> &&data) {
+	releaseStorage();
+	_data = sp::move(data);
+	return true;
+}
+
+bool VectorPath::init(const PathParams &params, SpanView<Command> commands,
+		SpanView<CommandData> points, SpanView<Vec2> uv, Rc<Ref> &&storage) {
+	_data.clear();
+	_data.params = params;
+	_storage = sp::move(storage);
+	_storageCommands = commands;
+	_storagePoints = points;
+	_storageUv = uv;
+	return true;
+}
+
 bool VectorPath::init(const PathData<memory::PoolInterface> &data) {
+	releaseStorage();
 	_data.clear();
 	_data.params = data.params;
 	_data.points = sprt::makeSpanView(data.points).vec<Interface>();
@@ -66,38 +88,70 @@ bool VectorPath::init(const PathData<memory::PoolInterface> &data) {
 	return true;
 }
 
-VectorPath::VectorPath(const VectorPath &path) : _data(path._data) { }
+// External storage is shared between copies
+VectorPath::VectorPath(const VectorPath &path)
+: _data(path._data)
+, _storage(path._storage)
+, _storageCommands(path._storageCommands)
+, _storagePoints(path._storagePoints)
+, _storageUv(path._storageUv) { }
 
 VectorPath &VectorPath::operator=(const VectorPath &path) {
 	_data = path._data;
+	_storage = path._storage;
+	_storageCommands = path._storageCommands;
+	_storagePoints = path._storagePoints;
+	_storageUv = path._storageUv;
 	return *this;
 }
 
-VectorPath::VectorPath(VectorPath &&path) : _data(move(path._data)) { }
+VectorPath::VectorPath(VectorPath &&path)
+: _data(move(path._data))
+, _storage(move(path._storage))
+, _storageCommands(path._storageCommands)
+, _storagePoints(path._storagePoints)
+, _storageUv(path._storageUv) {
+	path.releaseStorage();
+}
 
 VectorPath &VectorPath::operator=(VectorPath &&path) {
 	_data = move(path._data);
+	_storage = move(path._storage);
+	_storageCommands = path._storageCommands;
+	_storagePoints = path._storagePoints;
+	_storageUv = path._storageUv;
+	path.releaseStorage();
 	return *this;
 }
 
 VectorPath &VectorPath::addPath(const VectorPath &path) {
-	_data.getWriter().addPath(path._data);
+	detachStorage();
+	if (path._storage) {
+		VectorPath tmp(path);
+		tmp.detachStorage();
+		_data.getWriter().addPath(tmp._data);
+	} else {
+		_data.getWriter().addPath(path._data);
+	}
 	return *this;
 }
 
 VectorPath &VectorPath::addPath(StringView str) {
+	detachStorage();
 	_data.getWriter().addPath(str);
 	return *this;
 }
 
 VectorPath &VectorPath::addPath(BytesView data) {
+	detachStorage();
 	_data.getWriter().addPath(data);
 	return *this;
 }
 
-size_t VectorPath::count() const { return _data.commands.size(); }
+size_t VectorPath::count() const { return getCommands().size(); }
 
 VectorPath &VectorPath::openForWriting(const Callback<void(PathWriter &)> &cb) {
+	detachStorage();
 	auto writer = _data.getWriter();
 	cb(writer);
 	return *this;
@@ -199,6 +253,7 @@ const Mat4 &VectorPath::getTransform() const { return _data.params.transform; }
 
 VectorPath &VectorPath::clear() {
 	if (!empty()) {
+		releaseStorage();
 		_data.clear();
 	}
 	return *this;
@@ -211,23 +266,67 @@ VectorPath &VectorPath::setParams(const PathParams &p) {
 
 PathParams VectorPath::getParams() const { return _data.params; }
 
-bool VectorPath::empty() const { return _data.commands.empty(); }
+bool VectorPath::empty() const { return getCommands().empty(); }
 
-void VectorPath::reserve(size_t s) { _data.getWriter().reserve(s); }
+void VectorPath::reserve(size_t s) {
+	detachStorage();
+	_data.getWriter().reserve(s);
+}
+
+SpanView<Command> VectorPath::getCommands() const {
+	return _storage ? _storageCommands : sprt::makeSpanView(_data.commands);
+}
 
-const Interface::VectorType<Command> &VectorPath::getCommands() const { return _data.commands; }
+SpanView<CommandData> VectorPath::getPoints() const {
+	return _storage ? _storagePoints : sprt::makeSpanView(_data.points);
+}
 
-const Interface::VectorType<CommandData> &VectorPath::getPoints() const { return _data.points; }
+SpanView<Vec2> VectorPath::getUVPoints() const {
+	return _storage ? _storageUv : sprt::makeSpanView(_data.uv);
+}
 
-Interface::BytesType VectorPath::encode() const { return _data.encode<Interface>(); }
+Interface::BytesType VectorPath::encode() const {
+	if (_storage) {
+		VectorPath tmp(*this);
+		tmp.detachStorage();
+		return tmp._data.encode<Interface>();
+	}
+	return _data.encode<Interface>();
+}
 
 Interface::StringType VectorPath::toString(bool newline) const {
+	if (_storage) {
+		VectorPath tmp(*this);
+		tmp.detachStorage();
+		return tmp._data.toString<Interface>();
+	}
 	return _data.toString<Interface>();
 }
 
-size_t VectorPath::commandsCount() const { return _data.commands.size(); }
-size_t VectorPath::dataCount() const { return _data.points.size(); }
+size_t VectorPath::commandsCount() const { return getCommands().size(); }
+size_t VectorPath::dataCount() const { return getPoints().size(); }
+
+PathWriter VectorPath::getWriter() {
+	detachStorage();
+	return PathWriter(_data);
+}
+
+void VectorPath::detachStorage() {
+	if (!_storage) {
+		return;
+	}
+
+	_data.commands = _storageCommands.vec<Interface>();
+	_data.points = _storagePoints.vec<Interface>();
+	_data.uv = _storageUv.vec<Interface>();
+	releaseStorage();
+}
 
-PathWriter VectorPath::getWriter() { return PathWriter(_data); }
+void VectorPath::releaseStorage() {
+	_storage = nullptr;
+	_storageCommands = SpanView<Command>();
+	_storagePoints = SpanView<CommandData>();
+	_storageUv = SpanView<Vec2>();
+}
 
 } // namespace stappler::vg
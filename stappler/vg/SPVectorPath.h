@@ -60,6 +60,12 @@ public:
 
 	bool init(const PathData<memory::StandartInterface> &);
 	bool init(const PathData<memory::PoolInterface> &);
+	bool init(PathData<memory::StandartInterface> &&);
+
+	// Points, commands and uv are read from external storage (like mapped binary image) without
+	// copying. Storage is retained by path, data is copied into the path on first modification
+	bool init(const PathParams &, SpanView<Command>, SpanView<CommandData>, SpanView<Vec2>,
+			Rc<Ref> &&storage);
 
 	VectorPath &addPath(const VectorPath &);
 	VectorPath &addPath(BytesView);
@@ -120,8 +126,11 @@ public:
 
 	void reserve(size_t);
 
-	const Interface::VectorType<Command> &getCommands() const;
-	const Interface::VectorType<CommandData> &getPoints() const;
+	SpanView<Command> getCommands() const;
+	SpanView<CommandData> getPoints() const;
+	SpanView<Vec2> getUVPoints() const;
+
+	bool hasExternalStorage() const { return _storage != nullptr; }
 
 	explicit operator bool() const { return !empty(); }
 
@@ -137,7 +146,16 @@ protected:
 
 	PathWriter getWriter();
 
+	// copy data from external storage into own PathData, then release storage
+	void detachStorage();
+	void releaseStorage();
+
 	PathData<Interface> _data;
+
+	Rc<Ref> _storage;
+	SpanView<Command> _storageCommands;
+	SpanView<CommandData> _storagePoints;
+	SpanView<Vec2> _storageUv;
 };
 
 } // namespace stappler::vg
@@ -23,6 +23,8 @@
 #include "SPVectorPathData.h"
 #include "SPFilesystem.h"
 
+#include <bit>
+
 namespace STAPPLER_VERSIONIZED stappler::vg {
 
 #define SP_PATH_LOG(...)
@@ -32,6 +34,115 @@ namespace STAPPLER_VERSIONIZED stappler::vg {
 //#define SP_PATH_LOG_TEXT(...) stappler::log::text(log::Debug, "Path Debug", __VA_ARGS__)
 
 
+// SWAR (SIMD within a register) check and conversion for 8 decimal digits at once, see
+// https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/
+static inline bool svg_isEightDigits(uint64_t val) {
+	return (((val & 0xF0F0'F0F0'F0F0'F0F0)
+					| (((val + 0x0606'0606'0606'0606) & 0xF0F0'F0F0'F0F0'F0F0) >> 4))
+			== 0x3333'3333'3333'3333);
+}
+
+static inline uint32_t svg_parseEightDigits(uint64_t val) {
+	const uint64_t mask = 0x0000'00FF'0000'00FF;
+	const uint64_t mul1 = 0x000F'4240'0000'0064; // 100 + (1000000ULL << 32)
+	const uint64_t mul2 = 0x0000'2710'0000'0001; // 1 + (10000ULL << 32)
+	val -= 0x3030'3030'3030'3030;
+	val = (val * 10) + (val >> 8);
+	val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+	return uint32_t(val);
+}
+
+static inline const char *svg_readDigits(const char *p, const char *end, uint64_t &mantissa,
+		uint32_t &digits) {
+	if constexpr (std::endian::native == std::endian::little) {
+		while (end - p >= 8) {
+			uint64_t val;
+			memcpy(&val, p, sizeof(uint64_t));
+			if (!svg_isEightDigits(val)) {
+				break;
+			}
+			mantissa = mantissa * 100'000'000 + svg_parseEightDigits(val);
+			digits += 8;
+			p += 8;
+		}
+	}
+
+	while (p < end && *p >= '0' && *p <= '9') {
+		mantissa = mantissa * 10 + uint64_t(*p - '0');
+		++digits;
+		++p;
+	}
+	return p;
+}
+
+bool readPathFastNumber(StringView &reader, double &val) {
+	static constexpr double s_powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+		1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	if (reader.empty()) {
+		return false;
+	}
+
+	auto p = reader.data();
+	auto end = p + reader.size();
+
+	bool negative = false;
+	if (*p == '-' || *p == '+') {
+		negative = (*p == '-');
+		++p;
+	}
+
+	uint64_t mantissa = 0;
+	uint32_t digits = 0;
+	int32_t exponent = 0;
+
+	p = svg_readDigits(p, end, mantissa, digits);
+	auto intDigits = digits;
+
+	if (p < end && *p == '.') {
+		++p;
+		p = svg_readDigits(p, end, mantissa, digits);
+		exponent = -int32_t(digits - intDigits);
+	}
+
+	if (digits == 0) {
+		return false;
+	}
+
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		++p;
+		bool expNegative = false;
+		if (p < end && (*p == '-' || *p == '+')) {
+			expNegative = (*p == '-');
+			++p;
+		}
+
+		int32_t exp = 0;
+		auto expStart = p;
+		while (p < end && *p >= '0' && *p <= '9' && exp < 1'000) {
+			exp = exp * 10 + (*p - '0');
+			++p;
+		}
+
+		if (p == expStart || (p < end && *p >= '0' && *p <= '9')) {
+			return false;
+		}
+		exponent += expNegative ? -exp : exp;
+	}
+
+	// mantissa overflow or inexact conversion
+	if (digits > 19 || mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+		return false;
+	}
+
+	double v = double(mantissa);
+	v = (exponent < 0) ? v / s_powers[-exponent] : v * s_powers[exponent];
+	val = negative ? -v : v;
+
+	reader += size_t(p - reader.data());
+	return true;
+}
+
 // to prevent math errors on relative values we use double for SVG reader
 // Path itself uses single-word float for performance
 class SVGPathReader {
@@ -541,6 +652,9 @@ protected:
 
 	bool readNumber(double &val) {
 		if (!reader.empty()) {
+			if (readPathFastNumber(reader, val)) {
+				return true;
+			}
 			if (!reader.readDouble().grab(val)) {
 				return false;
 			}
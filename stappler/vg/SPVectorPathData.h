@@ -160,6 +160,10 @@ struct SP_PUBLIC PathWriter {
 	bool addPath(StringView);
 };
 
+// Fast path for the common SVG coordinate values: when mantissa and exponent are small enough,
+// conversion to double is exact (same result, as from StringView::readDouble). Returns false
+// without consuming input for all other cases, so, they should be parsed with readDouble
+SP_PUBLIC bool readPathFastNumber(StringView &, double &);
 
 }
 
@@ -0,0 +1,781 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "SPCommon.h"
+#include "SPZipStream.h"
+#include "SPLog.h"
+
+#ifdef MODULE_STAPPLER_THREADS
+#include "SPThreadPool.h"
+#endif
+
+#include <zlib.h>
+
+namespace STAPPLER_VERSIONIZED stappler {
+
+static constexpr uint32_t ZIP_LOCAL_HEADER_SIG = 0x0403'4b50;
+static constexpr uint32_t ZIP_CENTRAL_HEADER_SIG = 0x0201'4b50;
+static constexpr uint32_t ZIP_EOCD_SIG = 0x0605'4b50;
+static constexpr uint32_t ZIP64_EOCD_SIG = 0x0606'4b50;
+static constexpr uint32_t ZIP64_LOCATOR_SIG = 0x0706'4b50;
+static constexpr uint32_t ZIP_SPAN_SIG = 0x0807'4b50;
+
+static constexpr size_t ZIP_LOCAL_HEADER_SIZE = 30;
+static constexpr size_t ZIP_CENTRAL_HEADER_SIZE = 46;
+static constexpr size_t ZIP_EOCD_SIZE = 22;
+static constexpr size_t ZIP64_EOCD_SIZE = 56;
+static constexpr size_t ZIP64_LOCATOR_SIZE = 20;
+
+static constexpr uint16_t ZIP_METHOD_STORE = 0;
+static constexpr uint16_t ZIP_METHOD_DEFLATE = 8;
+
+static constexpr uint16_t ZIP_FLAG_ENCRYPTED = 1 << 0;
+static constexpr uint16_t ZIP_FLAG_UTF8 = 1 << 11;
+
+static constexpr uint16_t ZIP_VERSION = 20;
+static constexpr uint16_t ZIP64_VERSION = 45;
+
+static constexpr uint32_t ZIP_MAX32 = 0xFFFF'FFFF;
+static constexpr uint16_t ZIP_MAX16 = 0xFFFF;
+
+// deflate can not expand data more than 1032 times, larger declared sizes are invalid
+static constexpr uint64_t ZIP_MAX_DEFLATE_RATIO = 1'032;
+
+static uint16_t ZipStream_read16(const uint8_t *p) { return uint16_t(p[0]) | uint16_t(p[1]) << 8; }
+
+static uint32_t ZipStream_read32(const uint8_t *p) {
+	return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+static uint64_t ZipStream_read64(const uint8_t *p) {
+	return uint64_t(ZipStream_read32(p)) | uint64_t(ZipStream_read32(p + 4)) << 32;
+}
+
+struct ZipStreamBuffer {
+	void put16(uint16_t v) {
+		data.emplace_back(uint8_t(v));
+		data.emplace_back(uint8_t(v >> 8));
+	}
+
+	void put32(uint32_t v) {
+		put16(uint16_t(v));
+		put16(uint16_t(v >> 16));
+	}
+
+	void put64(uint64_t v) {
+		put32(uint32_t(v));
+		put32(uint32_t(v >> 32));
+	}
+
+	void put(StringView str) { data.insert(data.end(), str.data(), str.data() + str.size()); }
+
+	mem_std::Bytes data;
+};
+
+static uint32_t ZipStream_crc32(BytesView data) {
+	// zlib accepts only uInt lengths
+	uLong crc = crc32(0, nullptr, 0);
+	while (!data.empty()) {
+		auto chunk = std::min(data.size(), size_t(1_GiB));
+		crc = crc32(crc, data.data(), uInt(chunk));
+		data.offset(chunk);
+	}
+	return uint32_t(crc);
+}
+
+static void ZipStream_toDosTime(Time t, uint16_t &dosTime, uint16_t &dosDate) {
+	auto tm = t.asLocal();
+	if (tm.tm_year < 80) {
+		dosTime = 0;
+		dosDate = (1 << 5) | 1; // 1980-01-01
+		return;
+	}
+	dosTime = uint16_t((tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2));
+	dosDate = uint16_t(((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday);
+}
+
+static Time ZipStream_fromDosTime(uint16_t dosTime, uint16_t dosDate) {
+	struct tm tm;
+	memset(&tm, 0, sizeof(struct tm));
+	tm.tm_sec = (dosTime & 0x1F) * 2;
+	tm.tm_min = (dosTime >> 5) & 0x3F;
+	tm.tm_hour = dosTime >> 11;
+	tm.tm_mday = dosDate & 0x1F;
+	tm.tm_mon = ((dosDate >> 5) & 0x0F) - 1;
+	tm.tm_year = (dosDate >> 9) + 80;
+	tm.tm_isdst = -1;
+	auto t = mktime(&tm);
+	if (t == time_t(-1)) {
+		return Time();
+	}
+	return Time::seconds(t);
+}
+
+struct ZipWriter::Entry {
+	mem_std::String name;
+	mem_std::Bytes data;
+	Time mtime;
+	uint64_t size = 0;
+	uint64_t compressedSize = 0;
+	uint64_t offset = 0;
+	uint32_t crc = 0;
+	uint16_t method = ZIP_METHOD_STORE;
+	bool uncompressed = false;
+	bool ready = false;
+	bool failed = false;
+	bool written = false;
+
+	bool isZip64() const { return size >= ZIP_MAX32 || compressedSize >= ZIP_MAX32; }
+};
+
+ZipWriter::ZipWriter(FILE *file, thread::ThreadPool *pool, int level)
+: _level(level), _file(file), _pool(pool) {
+	_valid = _file != nullptr;
+}
+
+#ifdef MODULE_STAPPLER_FILESYSTEM
+ZipWriter::ZipWriter(const FileInfo &info, thread::ThreadPool *pool, int level)
+: _level(level), _pool(pool) {
+	_fsFile = filesystem::File::open(info, filesystem::OpenFlags::Override);
+	_valid = _fsFile.is_open();
+	if (!_valid) {
+		log::source().error("ZipWriter", "Fail to open file for writing: ", info);
+	}
+}
+#endif
+
+ZipWriter::~ZipWriter() {
+	if (_valid && !_finalized) {
+		finalize();
+	}
+}
+
+void ZipWriter::setPendingLimit(size_t limit) {
+	std::unique_lock lock(_mutex);
+	_pendingLimit = limit;
+	_cond.notify_all();
+}
+
+bool ZipWriter::addDir(StringView name, Time mtime) {
+	if (!name.ends_with("/")) {
+		return pushEntry(string::toString<memory::StandartInterface>(name, "/"), mem_std::Bytes(),
+				true, mtime);
+	}
+	return pushEntry(name, mem_std::Bytes(), true, mtime);
+}
+
+bool ZipWriter::addFile(StringView name, BytesView data, bool uncompressed, Time mtime) {
+	return pushEntry(name, data.bytes<memory::StandartInterface>(), uncompressed, mtime);
+}
+
+bool ZipWriter::addFile(StringView name, mem_std::Bytes &&data, bool uncompressed, Time mtime) {
+	return pushEntry(name, sp::move(data), uncompressed, mtime);
+}
+
+bool ZipWriter::finalize() {
+	if (!_valid) {
+		return false;
+	}
+
+	std::unique_lock lock(_mutex);
+	if (_finalized) {
+		return false;
+	}
+
+	_finalized = true;
+	_cond.wait(lock, [&] { return _nextWrite == _entries.size(); });
+
+	auto ret = !_failed && writeCentralDirectory();
+
+	if (_file) {
+		fflush(_file);
+	}
+#ifdef MODULE_STAPPLER_FILESYSTEM
+	if (_fsFile) {
+		_fsFile.close();
+	}
+#endif
+	return ret;
+}
+
+size_t ZipWriter::size() const {
+	std::unique_lock lock(_mutex);
+	return _entries.size();
+}
+
+uint64_t ZipWriter::getWrittenSize() const {
+	std::unique_lock lock(_mutex);
+	return _offset;
+}
+
+bool ZipWriter::pushEntry(StringView name, mem_std::Bytes &&data, bool uncompressed, Time mtime) {
+	if (!_valid || name.empty() || name.size() >= ZIP_MAX16) {
+		return false;
+	}
+
+	auto size = data.size();
+
+	std::unique_lock lock(_mutex);
+
+	// backpressure: single entry larger than limit is allowed when nothing else is pending
+	_cond.wait(lock, [&] {
+		return _finalized || _pendingBytes == 0 || _pendingBytes + size <= _pendingLimit;
+	});
+
+	if (_finalized) {
+		return false;
+	}
+
+	auto &entry = _entries.emplace_back();
+	entry.name = name.str<memory::StandartInterface>();
+	entry.data = sp::move(data);
+	entry.mtime = mtime;
+	entry.size = size;
+	entry.uncompressed = uncompressed || size == 0 || size >= ZIP_MAX32;
+
+	_pendingBytes += size;
+
+	lock.unlock();
+
+#ifdef MODULE_STAPPLER_THREADS
+	if (_pool && !entry.uncompressed && size >= MinParallelSize) {
+		auto e = &entry;
+		auto st = _pool->perform([this, e] {
+			compressEntry(*e);
+			completeEntry(*e);
+		}, nullptr, false, "ZipWriter");
+		if (st == Status::Ok) {
+			return true;
+		}
+	}
+#endif
+
+	compressEntry(entry);
+	completeEntry(entry);
+	return true;
+}
+
+void ZipWriter::compressEntry(Entry &entry) const {
+	entry.crc = ZipStream_crc32(BytesView(entry.data.data(), entry.data.size()));
+	entry.compressedSize = entry.size;
+	entry.method = ZIP_METHOD_STORE;
+
+	if (entry.uncompressed) {
+		return;
+	}
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(z_stream));
+
+	// raw deflate stream, as required by ZIP format
+	if (deflateInit2(&stream, _level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		entry.failed = true;
+		return;
+	}
+
+	mem_std::Bytes out;
+	out.resize(deflateBound(&stream, uLong(entry.size)));
+
+	stream.next_in = entry.data.data();
+	stream.avail_in = uInt(entry.size);
+	stream.next_out = out.data();
+	stream.avail_out = uInt(out.size());
+
+	auto err = deflate(&stream, Z_FINISH);
+	auto compressedSize = stream.total_out;
+	deflateEnd(&stream);
+
+	if (err != Z_STREAM_END) {
+		entry.failed = true;
+		return;
+	}
+
+	// keep data uncompressed when compression does not help
+	if (compressedSize < entry.size) {
+		out.resize(compressedSize);
+		entry.data = sp::move(out);
+		entry.compressedSize = compressedSize;
+		entry.method = ZIP_METHOD_DEFLATE;
+	}
+}
+
+void ZipWriter::completeEntry(Entry &entry) {
+	std::unique_lock lock(_mutex);
+	entry.ready = true;
+
+	// flush all consecutive completed entries in order of addition
+	while (_nextWrite < _entries.size() && _entries[_nextWrite].ready) {
+		auto &it = _entries[_nextWrite];
+		writeEntry(it);
+		_pendingBytes -= it.size;
+		mem_std::Bytes().swap(it.data);
+		++_nextWrite;
+	}
+
+	_cond.notify_all();
+}
+
+void ZipWriter::writeEntry(Entry &entry) {
+	if (entry.failed || _failed) {
+		log::source().error("ZipWriter", "Fail to compress entry: ", entry.name);
+		_failed = true;
+		return;
+	}
+
+	entry.offset = _offset;
+
+	auto zip64 = entry.isZip64();
+
+	uint16_t dosTime, dosDate;
+	ZipStream_toDosTime(entry.mtime, dosTime, dosDate);
+
+	ZipStreamBuffer buf;
+	buf.data.reserve(ZIP_LOCAL_HEADER_SIZE + entry.name.size() + 20);
+	buf.put32(ZIP_LOCAL_HEADER_SIG);
+	buf.put16(zip64 ? ZIP64_VERSION : ZIP_VERSION);
+	buf.put16(ZIP_FLAG_UTF8);
+	buf.put16(entry.method);
+	buf.put16(dosTime);
+	buf.put16(dosDate);
+	buf.put32(entry.crc);
+	buf.put32(zip64 ? ZIP_MAX32 : uint32_t(entry.compressedSize));
+	buf.put32(zip64 ? ZIP_MAX32 : uint32_t(entry.size));
+	buf.put16(uint16_t(entry.name.size()));
+	buf.put16(zip64 ? 20 : 0);
+	buf.put(entry.name);
+	if (zip64) {
+		buf.put16(0x0001);
+		buf.put16(16);
+		buf.put64(entry.size);
+		buf.put64(entry.compressedSize);
+	}
+
+	if (!writeData(buf.data.data(), buf.data.size())
+			|| !writeData(entry.data.data(), entry.data.size())) {
+		_failed = true;
+		return;
+	}
+
+	_offset += buf.data.size() + entry.data.size();
+	entry.written = true;
+}
+
+bool ZipWriter::writeCentralDirectory() {
+	auto cdOffset = _offset;
+	uint64_t count = 0;
+
+	ZipStreamBuffer buf;
+	for (auto &entry : _entries) {
+		if (!entry.written) {
+			continue;
+		}
+
+		auto sizeOverflow = entry.isZip64();
+		auto offsetOverflow = entry.offset >= ZIP_MAX32;
+
+		uint16_t extraSize = (sizeOverflow ? 16 : 0) + (offsetOverflow ? 8 : 0);
+
+		uint16_t dosTime, dosDate;
+		ZipStream_toDosTime(entry.mtime, dosTime, dosDate);
+
+		buf.put32(ZIP_CENTRAL_HEADER_SIG);
+		buf.put16(3 << 8 | ZIP64_VERSION); // made by unix
+		buf.put16(extraSize ? ZIP64_VERSION : ZIP_VERSION);
+		buf.put16(ZIP_FLAG_UTF8);
+		buf.put16(entry.method);
+		buf.put16(dosTime);
+		buf.put16(dosDate);
+		buf.put32(entry.crc);
+		buf.put32(sizeOverflow ? ZIP_MAX32 : uint32_t(entry.compressedSize));
+		buf.put32(sizeOverflow ? ZIP_MAX32 : uint32_t(entry.size));
+		buf.put16(uint16_t(entry.name.size()));
+		buf.put16(extraSize ? extraSize + 4 : 0);
+		buf.put16(0); // comment
+		buf.put16(0); // disk
+		buf.put16(0); // internal attributes
+		// unix mode in high bits, MS-DOS directory flag in low bits
+		buf.put32(StringView(entry.name).ends_with("/") ? (uint32_t(040'755) << 16) | 0x10
+														: uint32_t(0100'644) << 16);
+		buf.put32(offsetOverflow ? ZIP_MAX32 : uint32_t(entry.offset));
+		buf.put(entry.name);
+		if (extraSize) {
+			buf.put16(0x0001);
+			buf.put16(extraSize);
+			if (sizeOverflow) {
+				buf.put64(entry.size);
+				buf.put64(entry.compressedSize);
+			}
+			if (offsetOverflow) {
+				buf.put64(entry.offset);
+			}
+		}
+		++count;
+	}
+
+	auto cdSize = uint64_t(buf.data.size());
+	auto zip64 = count >= ZIP_MAX16 || cdOffset >= ZIP_MAX32 || cdSize >= ZIP_MAX32;
+
+	if (zip64) {
+		auto eocd64Offset = cdOffset + cdSize;
+
+		buf.put32(ZIP64_EOCD_SIG);
+		buf.put64(ZIP64_EOCD_SIZE - 12);
+		buf.put16(3 << 8 | ZIP64_VERSION);
+		buf.put16(ZIP64_VERSION);
+		buf.put32(0); // disk
+		buf.put32(0); // disk with central directory
+		buf.put64(count);
+		buf.put64(count);
+		buf.put64(cdSize);
+		buf.put64(cdOffset);
+
+		buf.put32(ZIP64_LOCATOR_SIG);
+		buf.put32(0);
+		buf.put64(eocd64Offset);
+		buf.put32(1); // total disks
+	}
+
+	buf.put32(ZIP_EOCD_SIG);
+	buf.put16(0);
+	buf.put16(0);
+	buf.put16(zip64 ? ZIP_MAX16 : uint16_t(count));
+	buf.put16(zip64 ? ZIP_MAX16 : uint16_t(count));
+	buf.put32(zip64 ? ZIP_MAX32 : uint32_t(cdSize));
+	buf.put32(zip64 ? ZIP_MAX32 : uint32_t(cdOffset));
+	buf.put16(0); // comment
+
+	if (!writeData(buf.data.data(), buf.data.size())) {
+		return false;
+	}
+	_offset += buf.data.size();
+	return true;
+}
+
+bool ZipWriter::writeData(const uint8_t *data, size_t size) {
+	if (size == 0) {
+		return true;
+	}
+	if (_file) {
+		return fwrite(data, 1, size, _file) == size;
+	}
+#ifdef MODULE_STAPPLER_FILESYSTEM
+	if (_fsFile) {
+		return _fsFile.write(data, size) == size;
+	}
+#endif
+	return false;
+}
+
+ZipReader::ZipReader(BytesView data) { _valid = init(data); }
+
+#ifdef MODULE_STAPPLER_FILESYSTEM
+ZipReader::ZipReader(const FileInfo &info) {
+	auto region = filesystem::MemoryMappedRegion::mapFile(info, filesystem::MappingType::Private,
+			filesystem::ProtFlags::MapRead);
+	if (!region) {
+		log::source().error("ZipReader", "Fail to map file: ", info);
+		return;
+	}
+
+	_region.emplace(sp::move(region));
+	_valid = init(_region->getView());
+}
+#endif
+
+uint64_t ZipReader::locateFile(StringView name) const {
+	auto it = std::lower_bound(_sorted.begin(), _sorted.end(), name,
+			[&](uint32_t idx, StringView n) { return _entries[idx].name < n; });
+	if (it != _sorted.end() && _entries[*it].name == name) {
+		return *it;
+	}
+	return maxOf<uint64_t>();
+}
+
+StringView ZipReader::getFileName(uint64_t idx) const {
+	if (idx < _entries.size()) {
+		return _entries[idx].name;
+	}
+	return StringView();
+}
+
+const ZipReader::Entry *ZipReader::getEntry(uint64_t idx) const {
+	if (idx < _entries.size()) {
+		return &_entries[idx];
+	}
+	return nullptr;
+}
+
+void ZipReader::ftw(
+		const Callback<void(uint64_t, StringView path, size_t size, Time time)> &cb) const {
+	for (uint64_t i = 0; i < _entries.size(); ++i) {
+		auto &it = _entries[i];
+		cb(i, it.name, it.size, ZipStream_fromDosTime(it.dosTime, it.dosDate));
+	}
+}
+
+BytesView ZipReader::getFileView(uint64_t idx) const {
+	if (idx >= _entries.size()) {
+		return BytesView();
+	}
+
+	auto &entry = _entries[idx];
+	if (entry.method != ZIP_METHOD_STORE || (entry.flags & ZIP_FLAG_ENCRYPTED)) {
+		return BytesView();
+	}
+	return getEntryData(entry);
+}
+
+bool ZipReader::readFile(StringView name, const Callback<void(BytesView)> &cb) const {
+	return readFile(locateFile(name), cb);
+}
+
+bool ZipReader::readFile(uint64_t idx, const Callback<void(BytesView)> &cb) const {
+	if (idx >= _entries.size()) {
+		return false;
+	}
+
+	auto &entry = _entries[idx];
+	if (entry.flags & ZIP_FLAG_ENCRYPTED) {
+		log::source().error("ZipReader", "Encrypted entries are not supported: ", entry.name);
+		return false;
+	}
+
+	auto data = getEntryData(entry);
+	if (data.size() != entry.compressedSize) {
+		log::source().error("ZipReader", "Invalid entry data: ", entry.name);
+		return false;
+	}
+
+	switch (entry.method) {
+	case ZIP_METHOD_STORE:
+		if (entry.size != data.size()) {
+			log::source().error("ZipReader", "Invalid size for stored entry: ", entry.name);
+			return false;
+		}
+		if (ZipStream_crc32(data) != entry.crc) {
+			log::source().error("ZipReader", "CRC mismatch for entry: ", entry.name);
+			return false;
+		}
+		cb(data);
+		return true;
+	case ZIP_METHOD_DEFLATE: {
+		if (entry.size >= ZIP_MAX32 || data.size() >= ZIP_MAX32) {
+			log::source().error("ZipReader", "Entry is too large to inflate: ", entry.name);
+			return false;
+		}
+
+		// output buffer is allocated from declared size, so it should be reachable from input
+		if (entry.size / ZIP_MAX_DEFLATE_RATIO > data.size()) {
+			log::source().error("ZipReader", "Invalid size for compressed entry: ", entry.name);
+			return false;
+		}
+
+		z_stream stream;
+		memset(&stream, 0, sizeof(z_stream));
+		if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+			return false;
+		}
+
+		auto buf = std::unique_ptr<uint8_t[]>(new uint8_t[std::max(entry.size, uint64_t(1))]);
+
+		stream.next_in = const_cast<uint8_t *>(data.data());
+		stream.avail_in = uInt(data.size());
+		stream.next_out = buf.get();
+		stream.avail_out = uInt(entry.size);
+
+		auto err = inflate(&stream, Z_FINISH);
+		auto size = stream.total_out;
+		inflateEnd(&stream);
+
+		if (err != Z_STREAM_END || size != entry.size) {
+			log::source().error("ZipReader", "Fail to inflate entry: ", entry.name);
+			return false;
+		}
+
+		BytesView result(buf.get(), size);
+		if (ZipStream_crc32(result) != entry.crc) {
+			log::source().error("ZipReader", "CRC mismatch for entry: ", entry.name);
+			return false;
+		}
+
+		cb(result);
+		return true;
+	}
+	default:
+		log::source().error("ZipReader", "Unsupported compression method ", entry.method,
+				" for entry: ", entry.name);
+		break;
+	}
+	return false;
+}
+
+bool ZipReader::init(BytesView data) {
+	_data = data;
+
+	if (data.size() < ZIP_EOCD_SIZE) {
+		return false;
+	}
+
+	// archive starts with local header, span marker, or with end of central directory when
+	// empty; other data is rejected silently, so reader can be used to probe a format
+	auto sig = ZipStream_read32(data.data());
+	if (sig != ZIP_LOCAL_HEADER_SIG && sig != ZIP_EOCD_SIG && sig != ZIP_SPAN_SIG) {
+		return false;
+	}
+
+	// end of central directory record is followed by comment up to 64KiB
+	auto ptr = data.data();
+	size_t minPos = (data.size() > ZIP_EOCD_SIZE + ZIP_MAX16)
+			? data.size() - ZIP_EOCD_SIZE - ZIP_MAX16
+			: 0;
+	size_t pos = data.size() - ZIP_EOCD_SIZE;
+	while (ZipStream_read32(ptr + pos) != ZIP_EOCD_SIG) {
+		if (pos == minPos) {
+			log::source().error("ZipReader", "End of central directory not found");
+			return false;
+		}
+		--pos;
+	}
+
+	auto eocd = ptr + pos;
+	uint64_t count = ZipStream_read16(eocd + 10);
+	uint64_t cdSize = ZipStream_read32(eocd + 12);
+	uint64_t cdOffset = ZipStream_read32(eocd + 16);
+
+	if (count == ZIP_MAX16 || cdSize == ZIP_MAX32 || cdOffset == ZIP_MAX32) {
+		if (pos >= ZIP64_LOCATOR_SIZE
+				&& ZipStream_read32(eocd - ZIP64_LOCATOR_SIZE) == ZIP64_LOCATOR_SIG) {
+			auto recordOffset = ZipStream_read64(eocd - ZIP64_LOCATOR_SIZE + 8);
+			if (recordOffset + ZIP64_EOCD_SIZE <= pos
+					&& ZipStream_read32(ptr + recordOffset) == ZIP64_EOCD_SIG) {
+				auto record = ptr + recordOffset;
+				count = ZipStream_read64(record + 32);
+				cdSize = ZipStream_read64(record + 40);
+				cdOffset = ZipStream_read64(record + 48);
+			}
+		}
+	}
+
+	if (cdOffset > data.size() || cdSize > data.size() - cdOffset
+			|| count > cdSize / ZIP_CENTRAL_HEADER_SIZE) {
+		log::source().error("ZipReader", "Invalid central directory");
+		return false;
+	}
+
+	_entries.reserve(count);
+
+	auto cd = BytesView(ptr + cdOffset, cdSize);
+	for (uint64_t i = 0; i < count; ++i) {
+		if (cd.size() < ZIP_CENTRAL_HEADER_SIZE
+				|| ZipStream_read32(cd.data()) != ZIP_CENTRAL_HEADER_SIG) {
+			log::source().error("ZipReader", "Invalid central directory header");
+			return false;
+		}
+
+		auto h = cd.data();
+		auto nameLen = ZipStream_read16(h + 28);
+		auto extraLen = ZipStream_read16(h + 30);
+		auto commentLen = ZipStream_read16(h + 32);
+
+		if (cd.size() < ZIP_CENTRAL_HEADER_SIZE + nameLen + extraLen + commentLen) {
+			log::source().error("ZipReader", "Invalid central directory header");
+			return false;
+		}
+
+		Entry entry;
+		entry.flags = ZipStream_read16(h + 8);
+		entry.method = ZipStream_read16(h + 10);
+		entry.dosTime = ZipStream_read16(h + 12);
+		entry.dosDate = ZipStream_read16(h + 14);
+		entry.crc = ZipStream_read32(h + 16);
+		entry.compressedSize = ZipStream_read32(h + 20);
+		entry.size = ZipStream_read32(h + 24);
+		entry.offset = ZipStream_read32(h + 42);
+		entry.name = StringView((const char *)h + ZIP_CENTRAL_HEADER_SIZE, nameLen);
+
+		// ZIP64 extended information contains only fields, that overflow in header
+		auto extra = BytesView(h + ZIP_CENTRAL_HEADER_SIZE + nameLen, extraLen);
+		while (extra.size() >= 4) {
+			auto id = ZipStream_read16(extra.data());
+			auto size = ZipStream_read16(extra.data() + 2);
+			extra.offset(4);
+			if (size > extra.size()) {
+				break;
+			}
+
+			if (id == 0x0001) {
+				auto field = BytesView(extra.data(), size);
+				if (entry.size == ZIP_MAX32 && field.size() >= 8) {
+					entry.size = ZipStream_read64(field.data());
+					field.offset(8);
+				}
+				if (entry.compressedSize == ZIP_MAX32 && field.size() >= 8) {
+					entry.compressedSize = ZipStream_read64(field.data());
+					field.offset(8);
+				}
+				if (entry.offset == ZIP_MAX32 && field.size() >= 8) {
+					entry.offset = ZipStream_read64(field.data());
+					field.offset(8);
+				}
+			}
+			extra.offset(size);
+		}
+
+		if (entry.offset >= cdOffset || entry.compressedSize > cdOffset - entry.offset) {
+			log::source().error("ZipReader", "Invalid entry bounds: ", entry.name);
+			return false;
+		}
+
+		_entries.emplace_back(entry);
+		cd.offset(ZIP_CENTRAL_HEADER_SIZE + nameLen + extraLen + commentLen);
+	}
+
+	_sorted.resize(_entries.size());
+	for (uint32_t i = 0; i < _sorted.size(); ++i) { _sorted[i] = i; }
+
+	std::stable_sort(_sorted.begin(), _sorted.end(),
+			[&](uint32_t l, uint32_t r) { return _entries[l].name < _entries[r].name; });
+
+	return true;
+}
+
+BytesView ZipReader::getEntryData(const Entry &entry) const {
+	if (entry.offset > _data.size() || _data.size() - entry.offset < ZIP_LOCAL_HEADER_SIZE) {
+		return BytesView();
+	}
+
+	auto h = _data.data() + entry.offset;
+	if (ZipStream_read32(h) != ZIP_LOCAL_HEADER_SIG) {
+		return BytesView();
+	}
+
+	// local extra field can differ from central one, so data offset is resolved from local header
+	auto start = entry.offset + ZIP_LOCAL_HEADER_SIZE + ZipStream_read16(h + 26)
+			+ ZipStream_read16(h + 28);
+	if (start > _data.size() || _data.size() - start < entry.compressedSize) {
+		return BytesView();
+	}
+
+	return BytesView(_data.data() + start, entry.compressedSize);
+}
+
+} // namespace STAPPLER_VERSIONIZED stappler
@@ -0,0 +1,207 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef STAPPLER_ZIP_SPZIPSTREAM_H_
+#define STAPPLER_ZIP_SPZIPSTREAM_H_
+
+#include "SPZip.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <optional>
+
+#ifdef MODULE_STAPPLER_FILESYSTEM
+#include "SPFilesystemFile.h"
+#include "SPFilesystemMap.h"
+#endif
+
+namespace STAPPLER_VERSIONIZED stappler::thread {
+
+class ThreadPool;
+
+}
+
+namespace STAPPLER_VERSIONIZED stappler {
+
+/* Streaming ZIP writer
+ *
+ * Entries are deflated independently, so with a thread pool attached every addFile call
+ * schedules its compression as a separate task. Completed entries are written to the output
+ * in the order they were added, as soon as all preceding entries are done, so the archive
+ * is never held in memory as a whole.
+ *
+ * Memory held by entries that are not yet written is bounded by the pending limit: addFile
+ * blocks until enough of the preceding entries are flushed.
+ *
+ * Entries larger than 4GiB are stored without compression. ZIP64 records are emitted when
+ * required by entry sizes, offsets or number of entries.
+ */
+class SP_PUBLIC ZipWriter final {
+public:
+	static constexpr size_t DefaultPendingLimit = 64_MiB;
+
+	// entries smaller than this are compressed on the calling thread
+	static constexpr size_t MinParallelSize = 16_KiB;
+
+	// output FILE is not closed by writer
+	ZipWriter(FILE *, thread::ThreadPool * = nullptr, int level = -1);
+
+#ifdef MODULE_STAPPLER_FILESYSTEM
+	ZipWriter(const FileInfo &, thread::ThreadPool * = nullptr, int level = -1);
+#endif
+
+	~ZipWriter();
+
+	ZipWriter(const ZipWriter &) = delete;
+	ZipWriter &operator=(const ZipWriter &) = delete;
+
+	explicit operator bool() const { return _valid; }
+
+	void setPendingLimit(size_t);
+	size_t getPendingLimit() const { return _pendingLimit; }
+
+	bool addDir(StringView name, Time mtime = Time::now());
+	bool addFile(StringView name, BytesView data, bool uncompressed = false,
+			Time mtime = Time::now());
+	bool addFile(StringView name, StringView data, bool uncompressed = false,
+			Time mtime = Time::now());
+	bool addFile(StringView name, mem_std::Bytes &&data, bool uncompressed = false,
+			Time mtime = Time::now());
+
+	// waits for pending entries, then writes central directory
+	// no entries can be added after this call
+	bool finalize();
+
+	size_t size() const;
+
+	uint64_t getWrittenSize() const;
+
+protected:
+	struct Entry;
+
+	bool pushEntry(StringView name, mem_std::Bytes &&data, bool uncompressed, Time mtime);
+
+	void compressEntry(Entry &) const;
+	void completeEntry(Entry &);
+	void writeEntry(Entry &);
+
+	bool writeCentralDirectory();
+	bool writeData(const uint8_t *, size_t);
+
+	bool _valid = false;
+	bool _finalized = false;
+	bool _failed = false;
+	int _level = -1;
+
+	FILE *_file = nullptr;
+#ifdef MODULE_STAPPLER_FILESYSTEM
+	filesystem::File _fsFile;
+#endif
+
+	thread::ThreadPool *_pool = nullptr;
+
+	mutable std::mutex _mutex;
+	std::condition_variable _cond;
+	std::deque<Entry> _entries;
+	size_t _nextWrite = 0;
+	size_t _pendingBytes = 0;
+	size_t _pendingLimit = DefaultPendingLimit;
+	uint64_t _offset = 0;
+};
+
+/* Random-access ZIP reader
+ *
+ * Builds an index over the central directory of an archive in memory or in a memory-mapped
+ * file. Lookups by name are binary searches over the sorted index, stored entries are
+ * returned as views into the archive data without copying, compressed entries are inflated
+ * on demand. Reader does not modify its state after construction, so it can be used from
+ * multiple threads concurrently.
+ */
+class SP_PUBLIC ZipReader final {
+public:
+	struct Entry {
+		StringView name;
+		uint64_t offset = 0; // local header offset
+		uint64_t compressedSize = 0;
+		uint64_t size = 0;
+		uint32_t crc = 0;
+		uint16_t method = 0;
+		uint16_t flags = 0;
+		uint16_t dosTime = 0;
+		uint16_t dosDate = 0;
+	};
+
+	// data should outlive reader
+	ZipReader(BytesView);
+
+#ifdef MODULE_STAPPLER_FILESYSTEM
+	ZipReader(const FileInfo &);
+#endif
+
+	ZipReader(const ZipReader &) = delete;
+	ZipReader &operator=(const ZipReader &) = delete;
+
+	explicit operator bool() const { return _valid; }
+
+	size_t size() const { return _entries.size(); }
+
+	// returns maxOf<uint64_t>() on failure
+	uint64_t locateFile(StringView) const;
+
+	StringView getFileName(uint64_t idx) const;
+
+	const Entry *getEntry(uint64_t idx) const;
+
+	void ftw(const Callback<void(uint64_t, StringView path, size_t size, Time time)> &) const;
+
+	// returns view into archive data for stored entries, empty view for compressed ones
+	// view is not checked against CRC, use readFile for untrusted archives
+	BytesView getFileView(uint64_t idx) const;
+
+	// entry data is checked against declared sizes and CRC before callback is called
+	bool readFile(StringView, const Callback<void(BytesView)> &) const;
+	bool readFile(uint64_t, const Callback<void(BytesView)> &) const;
+
+protected:
+	bool init(BytesView);
+
+	BytesView getEntryData(const Entry &) const;
+
+	bool _valid = false;
+	BytesView _data;
+	mem_std::Vector<Entry> _entries;
+	mem_std::Vector<uint32_t> _sorted;
+
+#ifdef MODULE_STAPPLER_FILESYSTEM
+	std::optional<filesystem::MemoryMappedRegion> _region;
+#endif
+};
+
+inline bool ZipWriter::addFile(StringView name, StringView data, bool uncompressed, Time mtime) {
+	return addFile(name, BytesView((const uint8_t *)data.data(), data.size()), uncompressed,
+			mtime);
+}
+
+} // namespace STAPPLER_VERSIONIZED stappler
+
+#endif /* STAPPLER_ZIP_SPZIPSTREAM_H_ */
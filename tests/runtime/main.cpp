@@ -36,6 +36,8 @@ THE SOFTWARE.
 #include <sprt/runtime/compress.h>
 #include <sprt/runtime/idn.h>
 
+#include "RuntimeTest.h"
+
 using namespace stappler;
 
 static sprt::qmutex s_mutex;
@@ -195,7 +197,18 @@ static void performUnicodeTests() {
 }
 
 int main(int argc, const char *argv[]) {
-	return perform_main(argc, argv, []() {
+	return perform_main(argc, argv, [&]() {
+		// runtimetest test [filter] | runtimetest bench [filter]
+		if (argc > 1) {
+			auto mode = StringView(argv[1]);
+			auto filter = (argc > 2) ? StringView(argv[2]) : StringView();
+			if (mode == "test") {
+				return test::RuntimeTest::run(test::RuntimeTest::Type::Test, filter) ? 1 : 0;
+			} else if (mode == "bench") {
+				return test::RuntimeTest::run(test::RuntimeTest::Type::Benchmark, filter) ? 1 : 0;
+			}
+		}
+
 		//printCaseTables();
 		//runDataCoverter();
 
@@ -0,0 +1,312 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "Basic2dTestData.h"
+
+#if MODULE_XENOLITH_RENDERER_BASIC2D
+
+#include "XL2dCommandFlattener.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+struct FlattenerTestSpan {
+	core::MaterialId material = 0;
+	uint32_t indexes = 0;
+
+	bool operator==(const FlattenerTestSpan &) const = default;
+};
+
+// Draw order, produced by the per-level material maps (write plan, used before CommandFlattener):
+// solid and surface commands are grouped by material, transparent commands are ordered by
+// z-path, then by material
+struct FlattenerTestPlan {
+	Map<core::MaterialId, uint32_t> solid;
+	Map<core::MaterialId, uint32_t> surface;
+	Vector<FlattenerTestSpan> transparent;
+};
+
+static FlattenerTestPlan makeFlattenerWritePlan(const basic2d::CommandList *list,
+		const core::MaterialSet *set) {
+	FlattenerTestPlan ret;
+	std::map<SpanView<ZOrder>, Map<core::MaterialId, uint32_t>, ZOrderLess> transparent;
+
+	auto cmd = list->getFirst();
+	while (cmd) {
+		if (cmd->type == basic2d::CommandType::VertexArray) {
+			auto data = reinterpret_cast<const basic2d::CmdVertexArray *>(cmd->data);
+			auto mIt = set->getMaterials().find(data->material);
+			if (mIt != set->getMaterials().end()) {
+				uint32_t indexes = 0;
+				for (auto &it : data->vertexes) { indexes += it.data->indexes.size(); }
+
+				if (mIt->second->getPipeline()->isSolid()) {
+					ret.solid[data->material] += indexes;
+				} else if (data->renderingLevel == core::RenderingLevel::Surface) {
+					ret.surface[data->material] += indexes;
+				} else {
+					transparent[data->zPath][data->material] += indexes;
+				}
+			}
+		}
+		cmd = cmd->next;
+	}
+
+	for (auto &pIt : transparent) {
+		for (auto &mIt : pIt.second) {
+			ret.transparent.emplace_back(FlattenerTestSpan{mIt.first, mIt.second});
+		}
+	}
+	return ret;
+}
+
+// Pseudo-random scene with all rendering levels and overlapping z-paths
+static Rc<basic2d::CommandList> makeFlattenerTestCommands(uint32_t count,
+		SpanView<core::MaterialId> materials) {
+	auto list = Rc<basic2d::CommandList>::create(Rc<PoolRef>::alloc());
+
+	uint32_t seed = 0x1234'5678;
+	auto next = [&] {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		return seed >> 8;
+	};
+
+	for (uint32_t i = 0; i < count; ++i) {
+		ZOrder zPath[3];
+		auto depth = next() % 3 + 1;
+		for (uint32_t j = 0; j < depth; ++j) { zPath[j] = ZOrder(int16_t(next() % 8)); }
+
+		basic2d::CmdInfo info;
+		info.zPath = makeSpanView(zPath, depth);
+
+		switch (next() % 3) {
+		case 0:
+			info.renderingLevel = core::RenderingLevel::Solid;
+			info.material = materials[(next() % (materials.size() / 2)) * 2];
+			break;
+		case 1:
+			info.renderingLevel = core::RenderingLevel::Surface;
+			info.material = materials[(next() % (materials.size() / 2)) * 2 + 1];
+			break;
+		default:
+			info.renderingLevel = core::RenderingLevel::Transparent;
+			info.material = materials[(next() % (materials.size() / 2)) * 2 + 1];
+			break;
+		}
+
+		list->pushVertexArray(makeTestQuad(Vec2(float(i % 64), float(i / 64)), 1.0f, info.material),
+				Mat4::IDENTITY, sp::move(info));
+	}
+	return list;
+}
+
+struct FlattenerTestOutput {
+	basic2d::CommandFlattener::Result result;
+	Bytes vertexes;
+	Bytes indexes;
+	Bytes transforms;
+};
+
+static bool runFlattener(const core::MaterialSet *set, basic2d::FrameContextHandle2d *input,
+		FlattenerTestOutput &out) {
+	basic2d::CommandFlattenerInfo info;
+	info.surfaceExtent = Extent3(1'024, 768, 1);
+
+	basic2d::CommandFlattener flattener;
+	if (!flattener.init(info, set, input)) {
+		return false;
+	}
+
+	flattener.pushCommands(input->commands.get());
+	flattener.sort();
+
+	out.vertexes.resize((flattener.getVertexesCount() + 8) * sizeof(basic2d::Vertex));
+	out.indexes.resize((flattener.getIndexesCount() + 12) * sizeof(uint32_t));
+	out.transforms.resize(
+			(input->commands->getPredefinedTransforms() + flattener.getTransformsCount() + 1)
+			* sizeof(basic2d::TransformData));
+
+	basic2d::CommandFlattener::WriteTarget target;
+	target.vertexes = out.vertexes.data();
+	target.indexes = out.indexes.data();
+	target.transform = reinterpret_cast<basic2d::TransformData *>(out.transforms.data());
+	target.transformOffset = input->commands->getPredefinedTransforms();
+
+	flattener.write(target, out.result);
+	return true;
+}
+
+static bool runFlattenerOrderTest(uint32_t count) {
+	StringView name("basic2d.flattener.order");
+
+	Basic2dTestPipelines pipelines;
+	Vector<core::MaterialId> materials;
+	auto set = makeTestMaterialSet(pipelines, 8, materials);
+
+	auto input = Rc<basic2d::FrameContextHandle2d>::alloc();
+	input->commands = makeFlattenerTestCommands(count, materials);
+
+	auto plan = makeFlattenerWritePlan(input->commands.get(), set.get());
+
+	bool success = true;
+	auto pool = memory::pool::create(memory::pool::acquire());
+	mem_pool::perform([&] {
+		FlattenerTestOutput out;
+		if (!expect(runFlattener(set.get(), input.get(), out), name, "fail to init flattener")) {
+			success = false;
+			return;
+		}
+
+		auto &spans = out.result.materialSpans;
+		success = expect(out.result.solidCmds + out.result.surfaceCmds
+								+ out.result.transparentCmds
+						== spans.size(),
+				name, "spans count mismatch");
+		if (!success) {
+			return;
+		}
+
+		// solid and surface levels can be drawn in any order, compare index counts per material
+		Map<core::MaterialId, uint32_t> solid;
+		Map<core::MaterialId, uint32_t> surface;
+		Vector<FlattenerTestSpan> transparent;
+
+		size_t idx = 0;
+		for (; idx < out.result.solidCmds; ++idx) {
+			solid[spans[idx].material] += spans[idx].indexCount;
+		}
+		for (; idx < out.result.solidCmds + out.result.surfaceCmds; ++idx) {
+			surface[spans[idx].material] += spans[idx].indexCount;
+		}
+		for (; idx < spans.size(); ++idx) {
+			transparent.emplace_back(FlattenerTestSpan{spans[idx].material, spans[idx].indexCount});
+		}
+
+		success = expect(solid == plan.solid, name, "solid level does not match write plan")
+				&& success;
+		success = expect(surface == plan.surface, name, "surface level does not match write plan")
+				&& success;
+
+		// transparent level should be drawn strictly in z-order
+		success = expect(transparent == plan.transparent, name,
+						  toString("transparent order does not match write plan: ",
+								  transparent.size(), " spans, expected ",
+								  plan.transparent.size()))
+				&& success;
+	}, pool);
+	memory::pool::destroy(pool);
+
+	return success;
+}
+
+static RuntimeTest s_flattenerOrderTest("basic2d.flattener.order", RuntimeTest::Type::Test, [] {
+	return runFlattenerOrderTest(100) && runFlattenerOrderTest(5'000);
+});
+
+static RuntimeTest s_flattenerSortKeyTest("basic2d.flattener.sort_key", RuntimeTest::Type::Test,
+		[] {
+	StringView name("basic2d.flattener.sort_key");
+	using Flattener = basic2d::CommandFlattener;
+
+	bool success = true;
+
+	auto key = [](uint32_t zRank, uint32_t materialRank, StateId state) {
+		return Flattener::makeSortKey(Flattener::Level::Transparent, zRank, materialRank, state,
+				Flattener::BlockType::Instanced);
+	};
+
+	// largest values, that fit into fields, should keep the order
+	success &= expect(Flattener::fitsSortKey(Flattener::ZRankMask, Flattener::MaterialMask,
+							  Flattener::StateMask - 1),
+			name, "max values should fit");
+	success &= expect(key(0, 0, Flattener::StateMask - 2) < key(0, 0, Flattener::StateMask - 1),
+			name, "states are not ordered");
+	success &= expect(key(0, 0, Flattener::StateMask - 1) < key(0, 0, StateIdNone), name,
+			"objects without state should be last");
+	success &= expect(key(Flattener::ZRankMask - 1, 0, 0) < key(Flattener::ZRankMask, 0, 0), name,
+			"z-ranks are not ordered");
+
+	// values out of fields should be detected, so, flattener can use the full-width ordering
+	success &= expect(Flattener::fitsSortKey(0, 0, StateIdNone), name,
+			"no state should fit");
+	success &= expect(!Flattener::fitsSortKey(0, 0, Flattener::StateMask), name,
+			"state overflow is not detected");
+	success &= expect(!Flattener::fitsSortKey(Flattener::ZRankMask + 1, 0, 0), name,
+			"z-rank overflow is not detected");
+	success &= expect(!Flattener::fitsSortKey(0, Flattener::MaterialMask + 1, 0), name,
+			"material overflow is not detected");
+
+	return success;
+});
+
+static bool runFlattenerBenchmark(StringView name, uint32_t count) {
+	static constexpr uint32_t Iterations = 20;
+
+	Basic2dTestPipelines pipelines;
+	Vector<core::MaterialId> materials;
+	auto set = makeTestMaterialSet(pipelines, 16, materials);
+
+	auto input = Rc<basic2d::FrameContextHandle2d>::alloc();
+	input->commands = makeTestCommandList(count, materials);
+
+	uint64_t planTime = 0;
+	uint64_t flattenTime = 0;
+	size_t spans = 0;
+
+	for (uint32_t i = 0; i < Iterations; ++i) {
+		auto pool = memory::pool::create(memory::pool::acquire());
+		mem_pool::perform([&] {
+			auto t = Time::now();
+			auto plan = makeFlattenerWritePlan(input->commands.get(), set.get());
+			planTime += (Time::now() - t).toMicros();
+
+			FlattenerTestOutput out;
+			t = Time::now();
+			runFlattener(set.get(), input.get(), out);
+			flattenTime += (Time::now() - t).toMicros();
+
+			spans = out.result.materialSpans.size();
+		}, pool);
+		memory::pool::destroy(pool);
+	}
+
+	reportBenchmark(name, "commands", count, "");
+	reportBenchmark(name, "draw spans", spans, "");
+	reportBenchmark(name, "flattener (push, sort, write)",
+			double(flattenTime) / Iterations / 1'000.0, "ms");
+	reportBenchmark(name, "write plan (material maps, no vertex copy)",
+			double(planTime) / Iterations / 1'000.0, "ms");
+	return true;
+}
+
+static RuntimeTest s_flattener1k("basic2d.flattener.1k", RuntimeTest::Type::Benchmark,
+		[] { return runFlattenerBenchmark("basic2d.flattener.1k", 1'000); });
+
+static RuntimeTest s_flattener10k("basic2d.flattener.10k", RuntimeTest::Type::Benchmark,
+		[] { return runFlattenerBenchmark("basic2d.flattener.10k", 10'000); });
+
+static RuntimeTest s_flattener100k("basic2d.flattener.100k", RuntimeTest::Type::Benchmark,
+		[] { return runFlattenerBenchmark("basic2d.flattener.100k", 100'000); });
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,229 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_RENDERER_BASIC2D && MODULE_STAPPLER_DATA
+
+#include "XL2dDataScrollView.h"
+#include "XL2dDataScrollHandlerFixed.h"
+#include "SPDataSource.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+static constexpr float DataScrollTestItemSize = 48.0f;
+static constexpr float DataScrollTestFrame = 1.0f / 60.0f;
+
+class DataScrollTestNode : public Node {
+public:
+	uint32_t type = 0;
+	uint64_t id = 0;
+};
+
+// Without director, slices are built synchronously instead of the application thread
+class DataScrollTestView : public basic2d::DataScrollView {
+public:
+	virtual void acquireItemsForSlice(DataMap &val, Time time, Request type) override {
+		if (time < _invalidateAfter || !_handlerCallback) {
+			return;
+		}
+
+		if (_items.empty() && type != Request::Update) {
+			type = Request::Reset;
+		}
+
+		auto handler = makeHandler();
+		auto items = handler->run(type, sp::move(val));
+		for (auto &it : items) { it.second->setId(it.first.get()); }
+		updateSliceItems(sp::move(items), time, type);
+	}
+
+	void scrollTo(float pos) {
+		setScrollPosition(pos);
+		onPosition();
+	}
+
+	size_t getReusePoolSize() const {
+		size_t ret = 0;
+		for (auto &it : _itemReusePool) { ret += it.second.size(); }
+		return ret;
+	}
+};
+
+struct DataScrollTestStats {
+	size_t created = 0;
+	size_t reused = 0;
+	size_t mismatched = 0;
+	uint64_t lastId = 0;
+	size_t frames = 0;
+	Vector<double> frameTime;
+};
+
+static Rc<DataScrollTestView> makeDataScrollTestView(size_t count, bool reuse,
+		DataScrollTestStats &stats) {
+	auto source = Rc<data::Source>::create(data::Source::ChildsCount(count),
+			[](const data::Source::BatchCallback &cb, data::Source::Id::Type first, size_t size) {
+		mem_std::Map<data::Source::Id, data::Source::Value> map;
+		for (auto i = first; i < first + size; ++i) {
+			map.emplace(data::Source::Id(i), data::Source::Value(int64_t(i)));
+		}
+		cb(map);
+	});
+
+	auto view = Rc<DataScrollTestView>::create(source.get());
+	view->setHandlerCallback(
+			[](basic2d::DataScrollView *v) -> Rc<basic2d::DataScrollView::Handler> {
+		return Rc<basic2d::DataScrollHandlerFixed>::create(v, DataScrollTestItemSize);
+	});
+	view->setItemCallback([&stats](basic2d::DataScrollView::Item *item) -> Rc<Node> {
+		auto node = Rc<DataScrollTestNode>::create();
+		node->type = uint32_t(item->getId() % 2);
+		node->id = item->getId();
+		stats.lastId = std::max(stats.lastId, node->id);
+		++stats.created;
+		return node;
+	});
+
+	if (reuse) {
+		view->setItemTypeCallback(
+				[](basic2d::DataScrollView::Item *item) { return uint32_t(item->getId() % 2); });
+		view->setItemReuseCallback([&stats](Node *node, basic2d::DataScrollView::Item *item) {
+			auto n = static_cast<DataScrollTestNode *>(node);
+			if (n->type != uint32_t(item->getId() % 2)) {
+				++stats.mismatched;
+				return false;
+			}
+			n->id = item->getId();
+			stats.lastId = std::max(stats.lastId, n->id);
+			++stats.reused;
+			return true;
+		});
+	}
+
+	view->setContentSize(Size2(400.0f, 800.0f));
+	view->handleContentSizeDirty();
+	return view;
+}
+
+// Constant velocity fling from the top to the end of the source, back slices are loaded,
+// when scroll reaches the end of the current slice
+static void runDataScrollTestFling(DataScrollTestView *view, float velocity,
+		DataScrollTestStats &stats) {
+	auto step = velocity * DataScrollTestFrame;
+	while (true) {
+		auto start = Time::now();
+
+		auto pos = view->getScrollPosition() + step;
+		auto max = view->getScrollMaxPosition();
+		bool loaded = false;
+		if (pos >= max) {
+			loaded = view->downloadBackSlice();
+			max = view->getScrollMaxPosition();
+		}
+
+		if (!loaded && view->getScrollPosition() >= max) {
+			break;
+		}
+
+		view->scrollTo(std::min(pos, max));
+
+		stats.frameTime.emplace_back(double((Time::now() - start).toMicros()));
+		++stats.frames;
+	}
+}
+
+static RuntimeTest s_dataScrollReuse("basic2d.data_scroll", RuntimeTest::Type::Test, [] {
+	StringView name("basic2d.data_scroll");
+	static constexpr size_t ItemsCount = 10'000;
+
+	bool success = true;
+
+	DataScrollTestStats plain;
+	auto plainView = makeDataScrollTestView(ItemsCount, false, plain);
+	success &= expect(plain.created > 0, name, "no item nodes for the first slice");
+
+	runDataScrollTestFling(plainView, 4'000.0f, plain);
+	success &= expect(plain.lastId == ItemsCount - 1, name, "fling does not reach the last item");
+	success &= expect(plain.created >= ItemsCount, name, "not every item was built");
+	success &= expect(plainView->getReusePoolSize() == 0, name,
+			"nodes are pooled without reuse callback");
+
+	DataScrollTestStats reuse;
+	auto reuseView = makeDataScrollTestView(ItemsCount, true, reuse);
+	auto limit = reuseView->getItemReuseLimit();
+
+	runDataScrollTestFling(reuseView, 4'000.0f, reuse);
+	success &= expect(reuse.lastId == ItemsCount - 1, name, "fling does not reach the last item");
+	success &= expect(reuse.mismatched == 0, name, "node is offered to item of other type");
+	success &= expect(reuse.reused > 0, name, "nodes are not reused");
+	success &= expect(reuse.created + reuse.reused >= ItemsCount, name,
+			"not every item was built");
+
+	// only the visible area and the pools are allocated, not every item
+	success &= expect(reuse.created < ItemsCount / 10, name,
+			toString("too many nodes created with reuse: ", reuse.created));
+	success &= expect(reuseView->getReusePoolSize() <= limit * 2, name,
+			"pool is not limited per type");
+
+	reuseView->clearItemReusePool();
+	success &= expect(reuseView->getReusePoolSize() == 0, name, "pool is not cleared");
+
+	return success;
+});
+
+// Per-frame update cost of a CPU-only fling through 100k items, with and without node reuse
+static RuntimeTest s_dataScrollBenchmark("basic2d.data_scroll", RuntimeTest::Type::Benchmark, [] {
+	StringView name("basic2d.data_scroll");
+	static constexpr size_t ItemsCount = 100'000;
+
+	for (auto reuse : {false, true}) {
+		DataScrollTestStats stats;
+		auto view = makeDataScrollTestView(ItemsCount, reuse, stats);
+		runDataScrollTestFling(view, 4'000.0f, stats);
+
+		if (stats.frameTime.empty()) {
+			continue;
+		}
+
+		auto &times = stats.frameTime;
+		double total = 0.0;
+		for (auto &it : times) { total += it; }
+		std::sort(times.begin(), times.end());
+
+		auto prefix = reuse ? StringView("reuse") : StringView("no reuse");
+		reportBenchmark(name, toString(prefix, ", mean"), total / double(times.size()),
+				"us/frame");
+		reportBenchmark(name, toString(prefix, ", p99"), times[(times.size() * 99) / 100],
+				"us/frame");
+		reportBenchmark(name, toString(prefix, ", max"), times.back(), "us/frame");
+		reportBenchmark(name, toString(prefix, ", nodes created"), double(stats.created),
+				"nodes");
+	}
+	return true;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,177 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_RENDERER_BASIC2D
+
+#include "XL2dVectorCanvas.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+// Curve-heavy images: arcs, quadratic and cubic beziers, fill and stroke
+static constexpr StringView s_flatteningImages[] = {
+	R"(<svg width="64" height="64" viewBox="0 0 64 64">
+		<circle cx="32" cy="32" r="28" fill="black"/>
+	</svg>)",
+	R"(<svg width="64" height="64" viewBox="0 0 64 64">
+		<rect x="4" y="12" width="56" height="40" rx="12" ry="8" fill="black"/>
+	</svg>)",
+	R"(<svg width="64" height="64" viewBox="0 0 64 64">
+		<path d="M32 56 C-8 28 12 0 32 16 C52 0 72 28 32 56 Z" fill="black"/>
+	</svg>)",
+	R"(<svg width="64" height="64" viewBox="0 0 64 64">
+		<path d="M4 32 Q18 -8 32 32 T60 32 Q46 72 32 32 T4 32 Z" fill="black"/>
+	</svg>)",
+	R"(<svg width="64" height="64" viewBox="0 0 64 64">
+		<path d="M4 48 C16 -12 48 76 60 16" fill="none" stroke="black" stroke-width="4"/>
+	</svg>)",
+	R"(<svg width="64" height="64" viewBox="0 0 64 64">
+		<path d="M8 32 A24 16 30 1 1 56 32 A12 12 0 0 0 8 32 Z" fill="black"
+			stroke="black" stroke-width="2"/>
+	</svg>)",
+};
+
+struct FlatteningDrawStat {
+	size_t vertexes = 0;
+	Rect bbox;
+};
+
+static Vector<Rc<basic2d::VectorImageData>> makeFlatteningImages() {
+	Vector<Rc<basic2d::VectorImageData>> ret;
+	for (auto &it : s_flatteningImages) {
+		if (auto image = Rc<vg::VectorImage>::create(it)) {
+			ret.emplace_back(image->popData());
+		}
+	}
+	return ret;
+}
+
+static FlatteningDrawStat drawFlatteningImage(basic2d::VectorCanvas *canvas,
+		const Rc<basic2d::VectorImageData> &image, geom::LineFlattening flattening, float scale) {
+	basic2d::VectorCanvasConfig config;
+	config.flattening = flattening;
+	config.targetSize = Size2(64.0f * scale, 64.0f * scale);
+
+	FlatteningDrawStat ret;
+	Vec2 min(maxOf<float>(), maxOf<float>());
+	Vec2 max(-maxOf<float>(), -maxOf<float>());
+
+	auto result = canvas->draw(config, Rc<basic2d::VectorImageData>(image));
+	for (auto &data : result->data) {
+		ret.vertexes += data.data->data.size();
+		for (auto &v : data.data->data) {
+			min = Vec2(std::min(min.x, v.pos.x), std::min(min.y, v.pos.y));
+			max = Vec2(std::max(max.x, v.pos.x), std::max(max.y, v.pos.y));
+		}
+	}
+	if (ret.vertexes > 0) {
+		ret.bbox = Rect(min.x, min.y, max.x - min.x, max.y - min.y);
+	}
+	return ret;
+}
+
+static RuntimeTest s_basic2dFlattening("basic2d.flattening", RuntimeTest::Type::Test, [] {
+	StringView name("basic2d.flattening");
+	static constexpr float Scale = 4.0f;
+	static constexpr float Tolerance = 1.0f; // in pixels of target size
+
+	bool success = true;
+	auto images = makeFlatteningImages();
+	success &= expect(images.size() == std::size(s_flatteningImages), name,
+			"fail to read test images");
+
+	auto canvas = Rc<basic2d::VectorCanvas>::create(false);
+
+	auto isNear = [](const Rect &a, const Rect &b) {
+		return std::abs(a.origin.x - b.origin.x) < Tolerance
+				&& std::abs(a.origin.y - b.origin.y) < Tolerance
+				&& std::abs(a.size.width - b.size.width) < Tolerance
+				&& std::abs(a.size.height - b.size.height) < Tolerance;
+	};
+
+	for (size_t i = 0; i < images.size(); ++i) {
+		auto recursive =
+				drawFlatteningImage(canvas, images[i], geom::LineFlattening::Recursive, Scale);
+		auto analytic =
+				drawFlatteningImage(canvas, images[i], geom::LineFlattening::Analytic, Scale);
+
+		success &= expect(recursive.vertexes > 0 && analytic.vertexes > 0, name,
+				toString("empty result for image ", i));
+
+		// both modes should follow the same curve within the distance error
+		success &= expect(isNear(recursive.bbox, analytic.bbox), name,
+				toString("bounds differ for image ", i, ": ", recursive.bbox, " ", analytic.bbox));
+	}
+
+	basic2d::VectorCanvasConfig config;
+	config.flattening = geom::LineFlattening::Analytic;
+	config.targetSize = Size2(64.0f, 64.0f);
+	if (!images.empty()) {
+		auto result = canvas->draw(config, Rc<basic2d::VectorImageData>(images.front()));
+		success &= expect(result->config.flattening == geom::LineFlattening::Analytic, name,
+				"flattening mode is not stored in result config");
+	}
+
+	return success;
+});
+
+// Output size and tesselation time for both flattening modes on the same images
+static RuntimeTest s_basic2dFlatteningBenchmark("basic2d.flattening",
+		RuntimeTest::Type::Benchmark, [] {
+	StringView name("basic2d.flattening");
+	static constexpr size_t Iterations = 200;
+
+	auto images = makeFlatteningImages();
+	auto canvas = Rc<basic2d::VectorCanvas>::create(false);
+
+	for (auto scale : {1.0f, 4.0f, 16.0f}) {
+		for (auto flattening : {geom::LineFlattening::Recursive, geom::LineFlattening::Analytic}) {
+			auto mode = (flattening == geom::LineFlattening::Recursive) ? "recursive" : "analytic";
+
+			size_t vertexes = 0;
+			for (auto &it : images) {
+				vertexes += drawFlatteningImage(canvas, it, flattening, scale).vertexes;
+			}
+
+			auto start = Time::now();
+			for (size_t i = 0; i < Iterations; ++i) {
+				for (auto &it : images) { drawFlatteningImage(canvas, it, flattening, scale); }
+			}
+			auto time = double((Time::now() - start).toMicros()) / double(Iterations);
+
+			reportBenchmark(name, toString("vertexes, ", mode, ", ", scale * 64.0f, "px"),
+					double(vertexes), "vertexes");
+			reportBenchmark(name, toString("time, ", mode, ", ", scale * 64.0f, "px"), time,
+					"us/set");
+		}
+	}
+
+	return true;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,217 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_BACKEND_NULL && MODULE_XENOLITH_RENDERER_BASIC2D
+
+#include "XL2dFrameContext.h"
+#include "XL2dNullRenderQueue.h"
+#include "XL2dSprite.h"
+#include "XLCoreInstance.h"
+#include "XLCoreLoop.h"
+#include "XLCoreQueue.h"
+#include "XLCoreFrameRequest.h"
+#include "XLDirector.h"
+#include "XLScene.h"
+#include "XLTexture.h"
+#include "XLNull.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+// Owns FrameContext2d like SceneContent2d does, but has no window bindings
+class NullFrameBenchmarkLayer : public Node {
+public:
+	virtual ~NullFrameBenchmarkLayer() = default;
+
+	virtual bool init() override {
+		if (!Node::init()) {
+			return false;
+		}
+
+		_context = Rc<basic2d::FrameContext2d>::create();
+		_frameContext = _context;
+		return true;
+	}
+
+protected:
+	Rc<basic2d::FrameContext2d> _context;
+};
+
+/* Frame-time benchmark for the headless (null) backend
+ *
+ * Scene with sprites is rendered by headless Director into basic2d null queue: FrameRequests
+ * are created by benchmark instead of presentation engine, everything else follows the regular
+ * frame path (scene visit, command list, material compilation, command flattening).
+ * Simulated GPU latency is disabled, so numbers reflect CPU-side cost only.
+ */
+static bool runNullFrameBenchmark(StringView name, uint32_t sprites, uint32_t frames) {
+	auto looper = event::Looper::acquire(event::LooperInfo{
+		.name = StringView("NullFrameBenchmark"),
+		.workersCount = 2,
+	});
+
+	auto instanceInfo = Rc<core::InstanceInfo>::alloc();
+	instanceInfo->api = core::InstanceApi::None;
+
+	auto instance = core::Instance::create(sp::move(instanceInfo));
+	if (!expect(instance != nullptr, name, "null instance is not available")) {
+		return false;
+	}
+
+	auto backend = Rc<xenolith::null::LoopBackendInfo>::alloc();
+	backend->submitLatency = TimeInterval();
+
+	auto loopInfo = Rc<core::LoopInfo>::alloc();
+	loopInfo->backend = backend;
+
+	auto loop = instance->makeLoop(looper, sp::move(loopInfo));
+	if (!expect(loop != nullptr, name, "fail to create null loop")) {
+		return false;
+	}
+
+	loop->run();
+
+	core::FrameConstraints constraints;
+	constraints.extent = Extent3(1'024, 768, 1);
+	constraints.density = 1.0f;
+
+	core::Queue::Builder builder("NullFrameBenchmark");
+	basic2d::null::MaterialPass::RenderQueueInfo queueInfo{
+		loop.get(),
+		Extent2(constraints.extent.width, constraints.extent.height),
+		Color4F::WHITE,
+	};
+	basic2d::null::MaterialPass::makeRenderQueue(builder, queueInfo);
+
+	auto scene = Rc<Scene>::create(sp::move(builder), constraints);
+	auto &queue = scene->getQueue();
+
+	bool compiled = false;
+	bool success = false;
+	loop->compileQueue(queue, [&](bool s) {
+		success = s;
+		compiled = true;
+	});
+
+	if (!expect(waitFor(looper, [&] { return compiled; }) && success, name,
+				"fail to compile queue")) {
+		loop->stop();
+		return false;
+	}
+
+	auto res = queue->getInternalResource();
+	auto texture = Rc<Texture>::create(res->getImage(core::SolidTextureName), res);
+
+	auto layer = scene->addChild(Rc<NullFrameBenchmarkLayer>::create());
+	layer->setAnchorPoint(Anchor::Middle);
+	layer->setContentSize(Size2(constraints.extent.width, constraints.extent.height));
+	layer->setPosition(Vec2(constraints.extent.width, constraints.extent.height) / 2.0f);
+
+	// sprites spread across z-orders, odd sprites are transparent
+	for (uint32_t i = 0; i < sprites; ++i) {
+		auto sprite = layer->addChild(Rc<basic2d::Sprite>::create(Rc<Texture>(texture)),
+				ZOrder(int16_t(i / 64 % 128)));
+		sprite->setContentSize(Size2(4.0f, 4.0f));
+		sprite->setPosition(Vec2(float(i % 256) * 4.0f, float(i / 256 % 192) * 4.0f));
+		sprite->setColor(Color4F(float(i % 7) / 6.0f, float(i % 5) / 4.0f, 1.0f, 1.0f));
+		if (i % 2) {
+			sprite->setOpacity(0.5f);
+		}
+	}
+
+	auto director = Rc<Director>::create(loop.get(), constraints);
+	director->runScene(Rc<Scene>(scene));
+
+	uint64_t renderTime = 0;
+	uint64_t frameTime = 0;
+	uint64_t minFrameTime = maxOf<uint64_t>();
+	uint64_t maxFrameTime = 0;
+	uint32_t completed = 0;
+
+	for (uint32_t frame = 0; frame < frames; ++frame) {
+		// dirty all transforms, as a scrolling or animated scene does
+		layer->setRotation(float(frame % 360));
+
+		auto start = Time::now();
+
+		auto req = Rc<core::FrameRequest>::create(queue, constraints);
+		for (auto &it : queue->getOutputAttachments()) {
+			req->setOutput(it,
+					[](core::FrameAttachmentData &, bool, Ref *) -> bool { return true; });
+		}
+
+		if (!director->acquireFrame(req)) {
+			break;
+		}
+
+		auto rendered = Time::now();
+
+		bool frameComplete = false;
+		bool frameSuccess = false;
+		loop->runRenderQueue(sp::move(req), 0, [&](bool s) {
+			frameSuccess = s;
+			frameComplete = true;
+		});
+
+		if (!waitFor(looper, [&] { return frameComplete; }) || !frameSuccess) {
+			break;
+		}
+
+		auto end = Time::now();
+		auto t = (end - start).toMicros();
+
+		renderTime += (rendered - start).toMicros();
+		frameTime += t;
+		minFrameTime = std::min(minFrameTime, t);
+		maxFrameTime = std::max(maxFrameTime, t);
+		++completed;
+	}
+
+	director->end();
+	loop->stop();
+	looper->poll();
+
+	if (!expect(completed == frames, name, "some frames were not completed")) {
+		return false;
+	}
+
+	reportBenchmark(name, "sprites", sprites, "");
+	reportBenchmark(name, "frame (avg)", double(frameTime) / completed / 1'000.0, "ms");
+	reportBenchmark(name, "frame (min)", double(minFrameTime) / 1'000.0, "ms");
+	reportBenchmark(name, "frame (max)", double(maxFrameTime) / 1'000.0, "ms");
+	reportBenchmark(name, "scene render (avg)", double(renderTime) / completed / 1'000.0, "ms");
+	return true;
+}
+
+static RuntimeTest s_nullFrame1k("basic2d.null.frame.1k", RuntimeTest::Type::Benchmark,
+		[] { return runNullFrameBenchmark("basic2d.null.frame.1k", 1'000, 240); });
+
+static RuntimeTest s_nullFrame10k("basic2d.null.frame.10k", RuntimeTest::Type::Benchmark,
+		[] { return runNullFrameBenchmark("basic2d.null.frame.10k", 10'000, 120); });
+
+} // namespace stappler::test
+
+#endif
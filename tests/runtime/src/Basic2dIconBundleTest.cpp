@@ -0,0 +1,167 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_RENDERER_BASIC2D
+
+#include "XL2dIcons.h"
+#include "XL2dVectorCanvas.h"
+#include "XL2dVectorSprite.h"
+#include "SPFilesystem.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+// Static icons, as drawn by IconSprite
+static Vector<Rc<basic2d::VectorImageData>> makeIconBundleImages(size_t count) {
+	Vector<Rc<basic2d::VectorImageData>> ret;
+	for (auto i = toInt(basic2d::IconName::Empty) + 1;
+			i < toInt(basic2d::IconName::Max) && ret.size() < count; ++i) {
+		auto name = basic2d::IconName(i);
+		if (name == basic2d::IconName::Dynamic_Loader || name == basic2d::IconName::Dynamic_Nav
+				|| name == basic2d::IconName::Dynamic_DownloadProgress) {
+			continue;
+		}
+
+		if (auto image = Rc<vg::VectorImage>::create(Size2(24.0f, 24.0f))) {
+			basic2d::drawIcon(*image, name, 0.0f);
+			ret.emplace_back(image->popData());
+		}
+	}
+	return ret;
+}
+
+static basic2d::VectorCanvasConfig makeIconBundleConfig(float scale) {
+	auto config = basic2d::VectorSprite::makeCanvasConfig(basic2d::VectorSprite::QualityNormal,
+			1.0f, 0.0f);
+	config.targetSize = Size2(24.0f * scale, 24.0f * scale);
+	return config;
+}
+
+struct IconBundleDrawStat {
+	size_t vertexes = 0;
+	size_t indexes = 0;
+	double posSum = 0.0;
+};
+
+// New canvas releases runtime tesselation cache of the previous one, so every call is a cold start
+static Vector<IconBundleDrawStat> drawIconBundleImages(
+		const Vector<Rc<basic2d::VectorImageData>> &images, float scale) {
+	Vector<IconBundleDrawStat> ret;
+	auto canvas = Rc<basic2d::VectorCanvas>::create(false);
+	auto config = makeIconBundleConfig(scale);
+	for (auto &it : images) {
+		auto &stat = ret.emplace_back(IconBundleDrawStat());
+		auto result = canvas->draw(config, Rc<basic2d::VectorImageData>(it));
+		for (auto &data : result->data) {
+			stat.vertexes += data.data->data.size();
+			stat.indexes += data.data->indexes.size();
+			for (auto &v : data.data->data) { stat.posSum += v.pos.x + v.pos.y; }
+		}
+	}
+	return ret;
+}
+
+static RuntimeTest s_basic2dIconBundle("basic2d.icon_bundle", RuntimeTest::Type::Test, [] {
+	StringView name("basic2d.icon_bundle");
+	static constexpr size_t IconsCount = 64;
+	static constexpr float Scale = 2.0f;
+
+	bool success = true;
+	auto path = filesystem::findPath<Interface>(
+			FileInfo{"icon-bundle-test.xlbundle", FileCategory::AppCache});
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+
+	auto images = makeIconBundleImages(IconsCount);
+	auto imagesView = SpanView<Rc<basic2d::VectorImageData>>(images.data(), images.size());
+	float scales[] = {1.0f, Scale};
+
+	success &= expect(basic2d::VectorCanvas::writeBundle(FileInfo{path},
+							  makeIconBundleConfig(Scale), scales, imagesView),
+			name, "fail to write bundle");
+
+	auto runtime = drawIconBundleImages(images, Scale);
+
+	success &= expect(basic2d::VectorCanvas::addBundle(FileInfo{path}), name,
+			"fail to load bundle");
+	auto bundled = drawIconBundleImages(images, Scale);
+	basic2d::VectorCanvas::clearBundles();
+
+	success &= expect(runtime.size() == bundled.size(), name, "invalid results count");
+	for (size_t i = 0; i < std::min(runtime.size(), bundled.size()); ++i) {
+		auto &r = runtime[i];
+		auto &b = bundled[i];
+		if (!expect(r.vertexes == b.vertexes && r.indexes == b.indexes
+							&& std::abs(r.posSum - b.posSum) < 1e-2,
+					name, toString("bundled result differs for icon ", i))) {
+			success = false;
+			break;
+		}
+	}
+
+	filesystem::remove(FileInfo{path});
+	return success;
+});
+
+// First draw of a screenful of icons: runtime tesselation against precompiled bundle
+static RuntimeTest s_basic2dIconBundleBenchmark("basic2d.icon_bundle",
+		RuntimeTest::Type::Benchmark, [] {
+	StringView name("basic2d.icon_bundle");
+	static constexpr size_t IconsCount = 256;
+
+	auto path = filesystem::findPath<Interface>(
+			FileInfo{"icon-bundle-benchmark.xlbundle", FileCategory::AppCache});
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+
+	auto images = makeIconBundleImages(IconsCount);
+	auto imagesView = SpanView<Rc<basic2d::VectorImageData>>(images.data(), images.size());
+	bool success = true;
+
+	for (auto scale : {1.0f, 2.0f, 3.0f}) {
+		float scales[] = {scale};
+		success &= expect(basic2d::VectorCanvas::writeBundle(FileInfo{path},
+								  makeIconBundleConfig(scale), scales, imagesView),
+				name, "fail to write bundle");
+
+		auto start = Time::now();
+		drawIconBundleImages(images, scale);
+		reportBenchmark(name, toString("cold start, runtime tesselation, ", scale * 24.0f, "px"),
+				double((Time::now() - start).toMicros()) / 1'000.0, "ms");
+
+		start = Time::now();
+		basic2d::VectorCanvas::addBundle(FileInfo{path});
+		drawIconBundleImages(images, scale);
+		reportBenchmark(name, toString("cold start, bundle, ", scale * 24.0f, "px"),
+				double((Time::now() - start).toMicros()) / 1'000.0, "ms");
+		basic2d::VectorCanvas::clearBundles();
+	}
+
+	filesystem::remove(FileInfo{path});
+	return success;
+});
+
+} // namespace stappler::test
+
+#endif
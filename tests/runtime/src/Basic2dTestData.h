@@ -0,0 +1,122 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#ifndef TESTS_RUNTIME_SRC_BASIC2DTESTDATA_H_
+#define TESTS_RUNTIME_SRC_BASIC2DTESTDATA_H_
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_RENDERER_BASIC2D
+
+#include "XL2dCommandList.h"
+#include "XLCoreMaterial.h"
+#include "XLCoreQueueData.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+// Pipelines without GPU objects: CommandFlattener uses only material info to sort commands
+struct Basic2dTestPipelines {
+	core::GraphicPipelineData solid;
+	core::GraphicPipelineData transparent;
+
+	Basic2dTestPipelines() {
+		solid.key = StringView("TestSolid");
+		solid.material.setDepthInfo(core::DepthInfo(true, true, core::CompareOp::Less));
+
+		transparent.key = StringView("TestTransparent");
+		transparent.material.setBlendInfo(
+				core::BlendInfo(core::BlendFactor::SrcAlpha, core::BlendFactor::OneMinusSrcAlpha));
+		transparent.material.setDepthInfo(
+				core::DepthInfo(false, true, core::CompareOp::LessOrEqual));
+	}
+};
+
+// Materials without images; odd materials use transparent pipeline
+inline Rc<core::MaterialSet> makeTestMaterialSet(const Basic2dTestPipelines &pipelines,
+		uint32_t count, Vector<core::MaterialId> &ids) {
+	auto set = Rc<core::MaterialSet>::create(uint32_t(0));
+
+	Vector<Rc<core::Material>> materials;
+	for (uint32_t i = 0; i < count; ++i) {
+		auto id = core::MaterialId(i + 1);
+		ids.emplace_back(id);
+		auto pipeline = (i % 2) ? &pipelines.transparent : &pipelines.solid;
+		materials.emplace_back(
+				Rc<core::Material>::create(id, pipeline, Vector<core::MaterialImage>()));
+	}
+
+	set->updateMaterials(materials, SpanView<core::MaterialId>(), SpanView<core::MaterialId>(),
+			[](const core::MaterialImage &) -> Rc<core::ImageView> { return nullptr; });
+	return set;
+}
+
+// Axis-aligned quad, two triangles
+inline Rc<basic2d::VertexData> makeTestQuad(Vec2 origin, float size, uint32_t material) {
+	auto ret = Rc<basic2d::VertexData>::alloc();
+	ret->data.reserve(4);
+	ret->indexes.reserve(6);
+
+	auto color = Vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	ret->data.emplace_back(basic2d::Vertex{Vec4(origin.x, origin.y, 0.0f, 1.0f), color,
+		Vec2(0.0f, 0.0f), material, 0});
+	ret->data.emplace_back(basic2d::Vertex{Vec4(origin.x, origin.y + size, 0.0f, 1.0f), color,
+		Vec2(0.0f, 1.0f), material, 0});
+	ret->data.emplace_back(basic2d::Vertex{Vec4(origin.x + size, origin.y, 0.0f, 1.0f), color,
+		Vec2(1.0f, 0.0f), material, 0});
+	ret->data.emplace_back(basic2d::Vertex{Vec4(origin.x + size, origin.y + size, 0.0f, 1.0f),
+		color, Vec2(1.0f, 1.0f), material, 0});
+
+	for (auto idx : {0, 1, 2, 2, 1, 3}) { ret->indexes.emplace_back(uint32_t(idx)); }
+	return ret;
+}
+
+// Scene-like command list: `count` sprites, spread across materials and z-paths;
+// `materials[i]` should use transparent pipeline for odd i
+inline Rc<basic2d::CommandList> makeTestCommandList(uint32_t count,
+		SpanView<core::MaterialId> materials) {
+	auto list = Rc<basic2d::CommandList>::create(Rc<PoolRef>::alloc());
+	for (uint32_t i = 0; i < count; ++i) {
+		auto matIdx = i % materials.size();
+		ZOrder zPath[3] = {ZOrder(1), ZOrder(int16_t(i / 64 % 128)), ZOrder(int16_t(i % 64))};
+
+		basic2d::CmdInfo info;
+		info.zPath = makeSpanView(zPath, 3);
+		info.material = materials[matIdx];
+		info.renderingLevel = (matIdx % 2) ? core::RenderingLevel::Transparent
+									 : core::RenderingLevel::Solid;
+
+		list->pushVertexArray(
+				makeTestQuad(Vec2(float(i % 256) * 4.0f, float(i / 256 % 192) * 4.0f), 4.0f,
+						materials[matIdx]),
+				Mat4::IDENTITY, sp::move(info));
+	}
+	return list;
+}
+
+} // namespace stappler::test
+
+#endif
+
+#endif /* TESTS_RUNTIME_SRC_BASIC2DTESTDATA_H_ */
@@ -0,0 +1,308 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_GEOM
+
+#include "SPColorHCT.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+static float nextColorHCTTestValue(uint32_t &seed, float min, float max) {
+	seed = seed * 1'664'525 + 1'013'904'223;
+	return min + (max - min) * float(seed >> 8) / float(1 << 24);
+}
+
+// Random values, runs of the same hue as in color schemes, repeated values and edge cases
+static Vector<geom::ColorHCT::Values> makeColorHCTTestValues(size_t count, uint32_t seed) {
+	Vector<geom::ColorHCT::Values> ret;
+	ret.reserve(count + 8);
+
+	ret.emplace_back(geom::ColorHCT::Values{0.0f, 0.0f, 50.0f, 1.0f});
+	ret.emplace_back(geom::ColorHCT::Values{120.0f, 40.0f, 0.0f, 1.0f});
+	ret.emplace_back(geom::ColorHCT::Values{120.0f, 40.0f, 100.0f, 1.0f});
+	ret.emplace_back(geom::ColorHCT::Values{-30.0f, 60.0f, 40.0f, 0.5f});
+	ret.emplace_back(geom::ColorHCT::Values{390.0f, 60.0f, 40.0f, 0.5f});
+	ret.emplace_back(geom::ColorHCT::Values{270.0f, 150.0f, 50.0f, 1.0f});
+
+	while (ret.size() < count) {
+		auto hue = nextColorHCTTestValue(seed, 0.0f, 360.0f);
+		auto chroma = nextColorHCTTestValue(seed, 0.0f, 120.0f);
+		auto run = size_t(nextColorHCTTestValue(seed, 1.0f, 8.0f));
+		for (size_t i = 0; i < run; ++i) {
+			auto tone = nextColorHCTTestValue(seed, 0.0f, 100.0f);
+			auto alpha = nextColorHCTTestValue(seed, 0.0f, 1.0f);
+			ret.emplace_back(geom::ColorHCT::Values{hue, chroma, tone, alpha});
+			if (i % 3 == 2) {
+				ret.emplace_back(ret.back());
+			}
+		}
+	}
+	return ret;
+}
+
+static bool isSameColorHCTTestColor(const Color4F &a, const Color4F &b, float eps) {
+	return std::fabs(a.r - b.r) <= eps && std::fabs(a.g - b.g) <= eps
+			&& std::fabs(a.b - b.b) <= eps && std::fabs(a.a - b.a) <= eps;
+}
+
+static RuntimeTest s_colorHCT("geom.color_hct", RuntimeTest::Type::Test, [] {
+	StringView name("geom.color_hct");
+	bool success = true;
+
+	auto values = makeColorHCTTestValues(4'096, 1);
+
+	// batch solver should be exact to scalar one
+	Vector<Color4F> colors;
+	colors.resize(values.size());
+	geom::ColorHCT::solveColor4F(values, colors.data());
+
+	Vector<geom::ColorHCT> hcts;
+	hcts.resize(values.size());
+	geom::ColorHCT::solveColorHCT(values, hcts.data());
+
+	size_t mismatches = 0;
+	for (size_t i = 0; i < values.size(); ++i) {
+		auto &v = values[i];
+		auto color = geom::ColorHCT::solveColor4F(v.hue, v.chroma, v.tone, v.alpha);
+		auto hct = geom::ColorHCT::solveColorHCT(v.hue, v.chroma, v.tone, v.alpha);
+		if (colors[i] != color || hcts[i].color != hct.color || hcts[i].data != hct.data) {
+			++mismatches;
+		}
+
+		// solver keeps tone, hue and chroma can be reduced to fit sRGB
+		if (v.tone > 1.0f && v.tone < 99.0f) {
+			auto tone = geom::ColorHCT(color).data.tone;
+			success &= expect(std::fabs(tone - v.tone) < 1.0f, name,
+					toString("tone is not preserved for ", v.hue, " ", v.chroma, " ", v.tone));
+		}
+	}
+	success &= expect(mismatches == 0, name,
+			toString(mismatches, " batch results differ from scalar solver"));
+
+	// batch progress against scalar progress and direct solve of interpolated values
+	Vector<geom::ColorHCT> from;
+	Vector<geom::ColorHCT> to;
+	for (size_t i = 0; i + 1 < values.size() && from.size() < 512; i += 2) {
+		from.emplace_back(geom::ColorHCT(values[i]));
+		if (i % 8 == 0) {
+			// only alpha is changed
+			auto v = values[i];
+			v.alpha = 1.0f - v.alpha;
+			to.emplace_back(geom::ColorHCT(v));
+		} else {
+			to.emplace_back(geom::ColorHCT(values[i + 1]));
+		}
+	}
+
+	Vector<geom::ColorHCT> result;
+	result.resize(from.size());
+	for (float p : {-0.5f, 0.0f, 0.25f, 0.5f, 0.75f, 1.0f, 1.5f}) {
+		geom::ColorHCT::progress(from.data(), to.data(), p, result.data(), from.size());
+		for (size_t i = 0; i < from.size(); ++i) {
+			auto scalar = geom::ColorHCT::progress(from[i], to[i], p);
+			if (result[i].color != scalar.color || result[i].data != scalar.data) {
+				success &= expect(false, name, toString("progress differs at ", p, " for ", i));
+				break;
+			}
+
+			if (p > 0.0f && p < 1.0f) {
+				auto exact = geom::ColorHCT(geom::ColorHCT::Values{
+					geom::Cam16::sanitizeDegrees(
+							from[i].data.hue * (1.0f - p) + to[i].data.hue * p),
+					from[i].data.chroma * (1.0f - p) + to[i].data.chroma * p,
+					from[i].data.tone * (1.0f - p) + to[i].data.tone * p,
+					from[i].data.alpha * (1.0f - p) + to[i].data.alpha * p,
+				});
+				if (!isSameColorHCTTestColor(result[i].color, exact.color, 1.0e-4f)) {
+					success &= expect(false, name,
+							toString("progress is not accurate at ", p, " for ", i));
+					break;
+				}
+			}
+		}
+	}
+
+	return success;
+});
+
+static RuntimeTest s_colorHCTToneTable("geom.color_hct.tone_table", RuntimeTest::Type::Test, [] {
+	StringView name("geom.color_hct.tone_table");
+	static constexpr float MaxError = 0.5f / 255.0f;
+
+	// measured error is checked between steps only, so dense samples can be off by
+	// a bit more, but should stay within one 8-bit step
+	static constexpr float SampleError = 1.0f / 255.0f;
+
+	bool success = true;
+
+	Vector<std::pair<float, float>> ramps{{0.0f, 0.0f}, {25.0f, 48.0f}, {120.0f, 40.0f},
+		{210.0f, 16.0f}, {270.0f, 150.0f}, {-30.0f, 60.0f}};
+	uint32_t seed = 3;
+	for (size_t i = 0; i < 32; ++i) {
+		auto hue = nextColorHCTTestValue(seed, 0.0f, 360.0f);
+		ramps.emplace_back(hue, nextColorHCTTestValue(seed, 0.0f, 120.0f));
+	}
+
+	for (auto &it : ramps) {
+		geom::ColorHCTToneTable table(it.first, it.second, MaxError);
+		if (!expect(!table.empty(), name, "table is empty")) {
+			success = false;
+			continue;
+		}
+
+		success &= expect(table.getSteps() >= geom::ColorHCTToneTable::MinSteps
+						&& table.getSteps() <= geom::ColorHCTToneTable::MaxSteps,
+				name, toString("invalid steps count: ", table.getSteps()));
+		success &= expect(table.getMaxError() <= MaxError
+						|| table.getSteps() == geom::ColorHCTToneTable::MaxSteps,
+				name,
+				toString("error bound is not reached for ", it.first, " ", it.second, ": ",
+						table.getMaxError()));
+
+		auto bound = std::max(table.getMaxError(), SampleError);
+		for (uint32_t i = 0; i <= 1'000; ++i) {
+			auto tone = float(i) / 10.0f;
+			auto exact = geom::ColorHCT::solveColor4F(it.first, it.second, tone, 0.75f);
+			auto color = table.get(tone, 0.75f);
+			if (!isSameColorHCTTestColor(color, exact, bound)) {
+				success &= expect(false, name,
+						toString("tone ", tone, " is out of error bound for ", it.first, " ",
+								it.second, ": ", color, " ", exact));
+				break;
+			}
+		}
+
+		// steps are exact solutions
+		auto steps = table.getSteps();
+		for (uint32_t i = 0; i <= steps; ++i) {
+			auto tone = 100.0f * float(i) / float(steps);
+			auto exact = geom::ColorHCT::solveColor4F(it.first, it.second, tone, 1.0f);
+			if (!isSameColorHCTTestColor(table.get(tone), exact, 1.0e-5f)) {
+				success &= expect(false, name, toString("step ", i, " is not exact"));
+				break;
+			}
+		}
+
+		auto hct = table.hct(40.0f, 0.5f);
+		success &= expect(hct.data.tone == 40.0f && hct.data.alpha == 0.5f
+						&& isSameColorHCTTestColor(hct.color, table.get(40.0f, 0.5f), 0.0f),
+				name, "hct values do not match the table");
+	}
+
+	// out of range tones are clamped
+	geom::ColorHCTToneTable table(200.0f, 36.0f);
+	success &= expect(isSameColorHCTTestColor(table.get(-10.0f), table.get(0.0f), 0.0f)
+					&& isSameColorHCTTestColor(table.get(110.0f), table.get(100.0f), 0.0f),
+			name, "tone is not clamped");
+
+	return success;
+});
+
+// Solved colors per second for scalar and batch solver, tone table lookup,
+// and for batch interpolation
+static RuntimeTest s_colorHCTBenchmark("geom.color_hct", RuntimeTest::Type::Benchmark, [] {
+	StringView name("geom.color_hct");
+	static constexpr size_t ValuesCount = 100'000;
+
+	auto values = makeColorHCTTestValues(ValuesCount, 2);
+	Vector<Color4F> colors;
+	colors.resize(values.size());
+
+	auto measure = [&](StringView metric, const Callback<void()> &cb) {
+		auto start = Time::now();
+		cb();
+		auto time = double((Time::now() - start).toMicros()) / 1'000'000.0;
+		reportBenchmark(name, metric, double(values.size()) / time / 1'000'000.0, "Mcolors/s");
+	};
+
+	float check1 = 0.0f;
+	measure("solve, scalar", [&] {
+		for (auto &v : values) {
+			check1 += geom::ColorHCT::solveColor4F(v.hue, v.chroma, v.tone, v.alpha).r;
+		}
+	});
+
+	float check2 = 0.0f;
+	measure("solve, batch", [&] {
+		geom::ColorHCT::solveColor4F(values, colors.data());
+		for (auto &it : colors) { check2 += it.r; }
+	});
+
+	// tone ramps of 16 hues, like tonal palettes of a scheme
+	Vector<geom::ColorHCTToneTable> tables;
+	for (size_t i = 0; i < 16; ++i) { tables.emplace_back(values[i].hue, values[i].chroma); }
+
+	float check3 = 0.0f;
+	measure("tone table, get", [&] {
+		for (size_t i = 0; i < values.size(); ++i) {
+			check3 += tables[i % tables.size()].get(values[i].tone, values[i].alpha).r;
+		}
+	});
+
+	// surface animation: three colors for each surface, one of them changes alpha only
+	Vector<geom::ColorHCT> from;
+	Vector<geom::ColorHCT> to;
+	for (size_t i = 0; i + 1 < values.size() && from.size() < 3 * 1'000; i += 2) {
+		from.emplace_back(geom::ColorHCT(values[i]));
+		if (from.size() % 3 == 0) {
+			auto v = values[i];
+			v.alpha = 1.0f - v.alpha;
+			to.emplace_back(geom::ColorHCT(v));
+		} else {
+			to.emplace_back(geom::ColorHCT(values[i + 1]));
+		}
+	}
+
+	Vector<geom::ColorHCT> result;
+	result.resize(from.size());
+
+	static constexpr size_t Frames = 30;
+	auto measureProgress = [&](StringView metric, const Callback<void(float)> &cb) {
+		auto start = Time::now();
+		for (size_t i = 0; i < Frames; ++i) { cb(float(i + 1) / float(Frames + 1)); }
+		reportBenchmark(name, metric,
+				double((Time::now() - start).toMicros()) / 1'000.0 / double(Frames), "ms/frame");
+	};
+
+	measureProgress("progress 1000 surfaces, scalar", [&](float p) {
+		for (size_t i = 0; i < from.size(); ++i) {
+			result[i] = geom::ColorHCT::progress(from[i], to[i], p);
+		}
+	});
+
+	measureProgress("progress 1000 surfaces, batch", [&](float p) {
+		for (size_t i = 0; i < from.size(); i += 3) {
+			geom::ColorHCT::progress(from.data() + i, to.data() + i, p, result.data() + i, 3);
+		}
+	});
+
+	return expect(check1 == check2 && check3 >= 0.0f, name, "results differ");
+});
+
+} // namespace stappler::test
+
+#endif
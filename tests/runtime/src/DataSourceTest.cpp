@@ -0,0 +1,204 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_DATA
+
+#include "SPDataSource.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using data::Source;
+
+static Source::BatchSourceCallback makeDataSourceTestCallback(size_t *requested) {
+	return [requested](const Source::BatchCallback &cb, Source::Id::Type first, size_t size) {
+		mem_std::Map<Source::Id, Source::Value> map;
+		for (auto i = first; i < first + size; ++i) {
+			map.emplace(Source::Id(i), Source::Value(int64_t(i)));
+		}
+		if (requested) {
+			*requested += size;
+		}
+		cb(map);
+	};
+}
+
+// root -> cats -> subcats -> items, with varying number of items in subcategories
+static Rc<Source> makeDataSourceTestTree(size_t cats, size_t subcats, size_t items,
+		size_t *requested = nullptr) {
+	uint32_t seed = 1;
+	auto root = Rc<Source>::create(Source::ChildsCount(items),
+			makeDataSourceTestCallback(requested));
+	for (size_t i = 0; i < cats; ++i) {
+		auto cat = Rc<Source>::create(Source::Id(i), Source::ChildsCount(items));
+		for (size_t j = 0; j < subcats; ++j) {
+			seed = seed * 1'664'525 + 1'013'904'223;
+			cat->addSubcategry(Rc<Source>::create(Source::Id(j),
+					Source::ChildsCount((seed >> 16) % (items * 2))));
+		}
+		root->addSubcategry(cat);
+	}
+	return root;
+}
+
+// Reference implementation: walk over all subcategories, as Source did without indexes
+static size_t getDataSourceTestCount(Source *source, uint32_t l, bool subcats) {
+	auto c = source->getChildsCount() + (subcats ? source->getSubcatCount() : 0);
+	if (l > 0) {
+		for (auto &cat : source->getSubCategories()) {
+			c += getDataSourceTestCount(cat, l - 1, subcats);
+		}
+	}
+	return c;
+}
+
+static std::pair<Source *, bool> getDataSourceTestCategory(Source *source, size_t n, uint32_t l,
+		bool subcats) {
+	if (l > 0) {
+		for (auto &cat : source->getSubCategories()) {
+			if (subcats) {
+				if (n == 0) {
+					return std::make_pair(cat.get(), true);
+				}
+				--n;
+			}
+			auto c = getDataSourceTestCount(cat, l - 1, subcats);
+			if (n < c) {
+				return getDataSourceTestCategory(cat, n, l - 1, subcats);
+			}
+			n -= c;
+		}
+	}
+	if (subcats && n < source->getSubcatCount()) {
+		return std::make_pair(source->getCategory(n), true);
+	}
+	return std::make_pair(source, false);
+}
+
+static RuntimeTest s_dataSourceIndex("data.source.index", RuntimeTest::Type::Test, [] {
+	StringView name("data.source.index");
+	bool success = true;
+
+	auto root = makeDataSourceTestTree(16, 16, 8);
+
+	for (auto subcats : {false, true}) {
+		for (uint32_t l = 0; l <= 2; ++l) {
+			auto count = root->getCount(l, subcats);
+			success &= expect(count == getDataSourceTestCount(root, l, subcats), name,
+					"invalid count");
+
+			for (size_t n = 0; n < count; ++n) {
+				auto ret = root->getItemCategory(Source::Id(n), l, subcats);
+				success &= expect(ret == getDataSourceTestCategory(root, n, l, subcats), name,
+						toString("invalid category for item ", n, " level ", l));
+				if (!success) {
+					return false;
+				}
+			}
+		}
+	}
+
+	// changes of nested category are propagated to index of the root
+	auto nested = root->getCategory(3)->getCategory(5);
+	auto count = root->getCount(2);
+	nested->setChildsCount(nested->getChildsCount() + 5);
+	success &= expect(root->getCount(2) == count + 5, name, "nested change was not propagated");
+
+	nested->setSubCategories(
+			mem_std::Vector<Rc<Source>>{Rc<Source>::create(Source::ChildsCount(7))});
+	success &= expect(root->getCount(3) == getDataSourceTestCount(root, 3, false), name,
+			"new subcategory was not propagated");
+
+	// unrelated source does not affect the root
+	auto other = makeDataSourceTestTree(2, 2, 2);
+	other->getCategory(0)->setChildsCount(100);
+	success &= expect(root->getCount(2) == getDataSourceTestCount(root, 2, false), name,
+			"invalid count after unrelated change");
+
+	// cached slice is served without new requests
+	size_t requested = 0;
+	auto cached = makeDataSourceTestTree(0, 0, 1'000, &requested);
+	cached->setSliceCacheLimit(200);
+
+	size_t received = 0;
+	auto cb = [&](mem_std::Map<Source::Id, Source::Value> &data) { received += data.size(); };
+	cached->getSliceData(cb, Source::Id(100), 100);
+	cached->getSliceData(cb, Source::Id(150), 100);
+	cached->getSliceData(cb, Source::Id(100), 100);
+	success &= expect(received == 300 && requested == 150, name, "slice cache was not used");
+
+	cached->setData(Source::Value(true));
+	cached->getSliceData(cb, Source::Id(100), 100);
+	success &= expect(requested == 250, name, "slice cache was not invalidated");
+
+	return success;
+});
+
+// Lookups in 100 x 100 categories with indexes, and with the reference walk; index updates
+// after modifications of unrelated sources, that dropped indexes of all sources before
+static RuntimeTest s_dataSourceIndexBenchmark("data.source.index", RuntimeTest::Type::Benchmark,
+		[] {
+	StringView name("data.source.index");
+	static constexpr size_t LookupsCount = 100'000;
+
+	auto root = makeDataSourceTestTree(100, 100, 10);
+	auto count = root->getCount(2);
+
+	auto measure = [&](StringView metric, size_t n, const Callback<void(size_t)> &cb) {
+		auto start = Time::now();
+		for (size_t i = 0; i < n; ++i) { cb(i); }
+		reportBenchmark(name, metric,
+				double((Time::now() - start).toMicros()) * 1'000.0 / double(n), "ns/op");
+	};
+
+	uint32_t seed = 1;
+	size_t sum = 0;
+	measure("getItemCategory", LookupsCount, [&](size_t) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		sum += size_t(root->getItemCategory(Source::Id(seed % count), 2).first->getId().get());
+	});
+
+	measure("getItemCategory (walk)", LookupsCount / 100, [&](size_t) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		sum += size_t(getDataSourceTestCategory(root, seed % count, 2, false).first->getId().get());
+	});
+
+	auto other = Rc<Source>::create();
+	measure("getCount after unrelated change", LookupsCount, [&](size_t i) {
+		other->setData(Source::Value(int64_t(i)));
+		sum += root->getCount(2);
+	});
+
+	auto nested = root->getCategory(50)->getCategory(50);
+	measure("getCount after nested change", LookupsCount / 100, [&](size_t i) {
+		nested->setChildsCount(i % 10);
+		sum += root->getCount(2);
+	});
+
+	return sum > 0;
+});
+
+} // namespace stappler::test
+
+#endif
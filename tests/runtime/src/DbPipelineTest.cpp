@@ -0,0 +1,243 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_DB && MODULE_STAPPLER_EVENT
+
+#include "SPDbSimpleServer.h"
+#include "SPPqHandle.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+// PostgreSQL tests require a server; connection parameters are taken from environment in
+// libpq conninfo form, e.g. STAPPLER_TEST_PGSQL="host=localhost dbname=test user=test"
+// Returns false when server is configured, but not available; ret is empty when skipped
+static bool openPipelineTestServer(StringView name, Rc<db::SimpleServer> &ret) {
+	auto env = ::getenv("STAPPLER_TEST_PGSQL");
+	if (!env) {
+		log::source().info(name, "STAPPLER_TEST_PGSQL is not defined, skipped");
+		return true;
+	}
+
+	mem_pool::perform([&] {
+		db::Value params({
+			stappler::pair("driver", db::Value("pgsql")),
+		});
+
+		StringView(env).split<StringView::WhiteSpace>([&](StringView param) {
+			auto key = param.readUntil<StringView::Chars<'='>>();
+			if (param.is('=')) {
+				++param;
+				params.setString(param, key);
+			}
+		});
+
+		ret = Rc<db::SimpleServer>::create(params);
+	}, memory::pool::acquire());
+
+	if (!expect(ret != nullptr, name, "fail to connect to PostgreSQL server")) {
+		return false;
+	}
+
+	bool supported = false;
+	ret->perform([&](const db::Transaction &t) {
+		auto h = db::pq::Handle::get(t);
+		supported = h && h->getDriver()->isPipelineSupported();
+		return true;
+	});
+
+	if (!supported) {
+		log::source().info(name, "libpq pipeline mode is not supported, skipped");
+		ret = nullptr;
+	}
+	return true;
+}
+
+static void addPipelineTestStatements(db::pq::Pipeline &pipeline, size_t count, size_t offset,
+		int64_t &sum) {
+	for (size_t i = 0; i < count; ++i) {
+		pipeline.add(toString("SELECT ", offset + i, "::int8"), [&](db::Result &res) {
+			sum += res.current().toInteger(0);
+		});
+	}
+}
+
+static RuntimeTest s_dbPqPipeline("db.pq_pipeline", RuntimeTest::Type::Test, [] {
+	StringView name("db.pq_pipeline");
+	static constexpr size_t BatchSize = 16;
+
+	Rc<db::SimpleServer> serv;
+	if (!openPipelineTestServer(name, serv)) {
+		return false;
+	} else if (!serv) {
+		return true;
+	}
+
+	auto looper = event::Looper::acquire(event::LooperInfo{
+		.name = StringView("DbPipelineTest"),
+		.workersCount = 1,
+	});
+
+	bool success = true;
+	serv->perform([&](const db::Transaction &t) {
+		auto h = db::pq::Handle::get(t);
+
+		int64_t expected = 0;
+		for (size_t i = 0; i < BatchSize; ++i) { expected += int64_t(i); }
+
+		int64_t blockingSum = 0;
+		success &= expect(h->performPipeline([&](db::pq::Pipeline &pipeline) {
+			addPipelineTestStatements(pipeline, BatchSize, 0, blockingSum);
+		}), name, "blocking pipeline failed");
+		success &= expect(blockingSum == expected, name, "invalid blocking pipeline results");
+
+		int64_t asyncSum = 0;
+		bool completed = false;
+		bool asyncSuccess = false;
+		success &= expect(h->performPipelineAsync(looper,
+				[&](db::pq::Pipeline &pipeline) {
+			addPipelineTestStatements(pipeline, BatchSize, 0, asyncSum);
+		}, [&](db::pq::Pipeline *, bool ok) {
+			completed = true;
+			asyncSuccess = ok;
+		}), name, "fail to start async pipeline");
+
+		// handle should reject queries while pipeline is running
+		success &= expect(!h->isPipelineRunning() || !h->performSimpleQuery("SELECT 1"), name,
+				"query is accepted while pipeline is running");
+
+		success &= expect(waitFor(looper, [&] { return completed; }), name,
+				"async pipeline was not completed");
+		success &= expect(asyncSuccess && asyncSum == expected, name,
+				"invalid async pipeline results");
+		success &= expect(h->performSimpleQuery("SELECT 1"), name,
+				"connection is not usable after async pipeline");
+		return true;
+	});
+
+	// cancelled pipeline should leave connection in blocking non-pipeline mode
+	serv->perform([&](const db::Transaction &t) {
+		auto h = db::pq::Handle::get(t);
+		auto pipeline = Rc<db::pq::Pipeline>::create(h->getDriver(), h->getConnection());
+
+		int64_t sum = 0;
+		bool cancelled = false;
+		pipeline->add("SELECT pg_sleep(0.1)");
+		addPipelineTestStatements(*pipeline, BatchSize, 0, sum);
+		pipeline->performAsync(looper, [&](db::pq::Pipeline *, bool ok) {
+			cancelled = !ok;
+		});
+		pipeline->cancel();
+
+		success &= expect(cancelled && !pipeline->isRunning(), name,
+				"cancel does not complete pipeline");
+		success &= expect(pipeline->isConnectionReset(), name,
+				"connection with unread results was not reset");
+		success &= expect(!h->getDriver()->isNonBlocking(h->getConnection()), name,
+				"connection is left in non-blocking mode");
+		success &= expect(h->performSimpleQuery("SELECT 1"), name,
+				"connection is not usable after cancel");
+
+		// transaction was dropped with the connection
+		return false;
+	});
+
+	return success;
+});
+
+// Batch of short statements: one round trip per statement against one round trip per batch
+static RuntimeTest s_dbPqPipelineBenchmark("db.pq_pipeline", RuntimeTest::Type::Benchmark, [] {
+	StringView name("db.pq_pipeline");
+	static constexpr size_t Iterations = 500;
+	static constexpr size_t BatchSize = 8;
+
+	Rc<db::SimpleServer> serv;
+	if (!openPipelineTestServer(name, serv)) {
+		return false;
+	} else if (!serv) {
+		return true;
+	}
+
+	auto looper = event::Looper::acquire(event::LooperInfo{
+		.name = StringView("DbPipelineBenchmark"),
+		.workersCount = 1,
+	});
+
+	bool success = true;
+	int64_t sums[3] = {0, 0, 0};
+
+	auto measure = [&](StringView metric, const Callback<bool(db::pq::Handle *, size_t)> &cb) {
+		auto start = Time::now();
+		serv->perform([&](const db::Transaction &t) {
+			auto h = db::pq::Handle::get(t);
+			for (size_t i = 0; i < Iterations; ++i) {
+				if (!cb(h, i)) {
+					success = false;
+					break;
+				}
+			}
+			return true;
+		});
+		reportBenchmark(name, metric,
+				double((Time::now() - start).toMicros()) / double(Iterations), "us/batch");
+	};
+
+	measure(toString("sequential, ", BatchSize, " statements"), [&](db::pq::Handle *h, size_t i) {
+		for (size_t j = 0; j < BatchSize; ++j) {
+			auto ret = h->performSimpleSelect(toString("SELECT ", i + j, "::int8"),
+					[&](db::Result &res) { sums[0] += res.current().toInteger(0); });
+			if (!ret) {
+				return false;
+			}
+		}
+		return true;
+	});
+
+	measure(toString("pipeline, ", BatchSize, " statements"), [&](db::pq::Handle *h, size_t i) {
+		return h->performPipeline([&](db::pq::Pipeline &pipeline) {
+			addPipelineTestStatements(pipeline, BatchSize, i, sums[1]);
+		});
+	});
+
+	measure(toString("async pipeline, ", BatchSize, " statements"),
+			[&](db::pq::Handle *h, size_t i) {
+		bool completed = false;
+		bool ret = false;
+		auto started = h->performPipelineAsync(looper,
+				[&](db::pq::Pipeline &pipeline) {
+			addPipelineTestStatements(pipeline, BatchSize, i, sums[2]);
+		}, [&](db::pq::Pipeline *, bool ok) {
+			completed = true;
+			ret = ok;
+		});
+		return started && waitFor(looper, [&] { return completed; }) && ret;
+	});
+
+	return expect(success && sums[0] == sums[1] && sums[1] == sums[2], name, "results differ");
+});
+
+} // namespace stappler::test
+
+#endif
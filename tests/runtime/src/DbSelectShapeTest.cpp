@@ -0,0 +1,198 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_DB
+
+#include "SPDbSimpleServer.h"
+#include "SPDbWorker.h"
+#include "SPFilesystem.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+class DbSelectShapeServer : public db::SimpleServer {
+public:
+	static constexpr size_t FieldsCount = 24;
+	static constexpr size_t ObjectsCount = 64;
+
+	virtual ~DbSelectShapeServer() = default;
+
+	bool init(StringView path) {
+		bool success = false;
+
+		// scheme and init params should be allocated within server's pool
+		mem_pool::perform([&] {
+			_objects = new (_data->staticPool) db::Scheme("select_shape_objects");
+
+			db::Vector<db::Field> fields;
+			for (size_t i = 0; i < FieldsCount; ++i) {
+				auto fieldName = string::toString<db::Interface>((i % 2 == 0) ? "int" : "text", i);
+				if (i % 2 == 0) {
+					fields.emplace_back(db::Field::Integer(sp::move(fieldName)));
+				} else {
+					fields.emplace_back(db::Field::Text(sp::move(fieldName)));
+				}
+			}
+			_objects->define(sp::move(fields));
+
+			db::Value params({
+				stappler::pair("driver", db::Value("sqlite")),
+				stappler::pair("dbname", db::Value(path)),
+			});
+
+			const db::Scheme *schemes[] = {_objects};
+			success = SimpleServer::init(params, StringView(), db::AccessRoleId::System, schemes);
+		}, _data->staticPool);
+
+		if (!success) {
+			return false;
+		}
+
+		perform([&](const db::Transaction &t) {
+			for (size_t i = 0; i < ObjectsCount; ++i) {
+				db::Value obj;
+				for (size_t j = 0; j < FieldsCount; ++j) {
+					if (j % 2 == 0) {
+						obj.setInteger(int64_t(i * j), string::toString<db::Interface>("int", j));
+					} else {
+						obj.setString(string::toString<db::Interface>("value ", i, " ", j),
+								string::toString<db::Interface>("text", j));
+					}
+				}
+				db::Worker(*_objects, t).create(obj);
+			}
+			return true;
+		});
+		return true;
+	}
+
+	const db::sql::Driver *getDriver() const { return _data->driver; }
+	const db::Scheme &getObjects() const { return *_objects; }
+
+protected:
+	db::Scheme *_objects = nullptr;
+};
+
+static db::Value selectShapeObjects(const db::Transaction &t, const db::Scheme &scheme,
+		bool withIncludes) {
+	auto q = db::Query().limit(16, 0);
+	if (withIncludes) {
+		q.include("int0").include("text1");
+	}
+	return db::Worker(scheme, t).select(q);
+}
+
+static RuntimeTest s_dbSelectShape("db.select_shape", RuntimeTest::Type::Test, [] {
+	StringView name("db.select_shape");
+	bool success = true;
+
+	auto path = filesystem::findPath<Interface>(
+			FileInfo{"db-select-shape-test.sqlite", FileCategory::AppCache});
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+	filesystem::remove(FileInfo{path});
+
+	auto serv = Rc<DbSelectShapeServer>::create(path);
+	if (!expect(serv != nullptr, name, "fail to init server")) {
+		return false;
+	}
+
+	serv->perform([&](const db::Transaction &t) {
+		auto &scheme = serv->getObjects();
+
+		// first select renders select-list, second one uses cached shape
+		auto full1 = selectShapeObjects(t, scheme, false);
+		auto full2 = selectShapeObjects(t, scheme, false);
+		auto part1 = selectShapeObjects(t, scheme, true);
+		auto part2 = selectShapeObjects(t, scheme, true);
+
+		serv->getDriver()->clearSelectShapes();
+		auto part3 = selectShapeObjects(t, scheme, true);
+
+		success &= expect(full1.size() == 16 && full1 == full2, name,
+				"cached full select differs");
+		success &= expect(part1.size() == 16 && part1 == part2 && part1 == part3, name,
+				"cached select with includes differs");
+		success &= expect(full1.getValue(0).hasValue("text23"), name,
+				"full select misses fields");
+
+		// different include lists should not share the shape
+		success &= expect(!part1.getValue(0).hasValue("text23")
+						&& part1.getValue(0).hasValue("text1"),
+				name, "select with includes uses wrong shape");
+		return true;
+	});
+
+	serv = nullptr;
+	filesystem::remove(FileInfo{path});
+	return success;
+});
+
+// Select with cached select-list against select with select-list rendered for every call
+static RuntimeTest s_dbSelectShapeBenchmark("db.select_shape", RuntimeTest::Type::Benchmark, [] {
+	StringView name("db.select_shape");
+	static constexpr size_t Iterations = 2'000;
+
+	auto path = filesystem::findPath<Interface>(
+			FileInfo{"db-select-shape-benchmark.sqlite", FileCategory::AppCache});
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+	filesystem::remove(FileInfo{path});
+
+	auto serv = Rc<DbSelectShapeServer>::create(path);
+	if (!expect(serv != nullptr, name, "fail to init server")) {
+		return false;
+	}
+
+	auto measure = [&](StringView metric, bool clear) {
+		size_t count = 0;
+		auto start = Time::now();
+		serv->perform([&](const db::Transaction &t) {
+			db::Worker worker(serv->getObjects(), t);
+			for (size_t i = 0; i < Iterations; ++i) {
+				if (clear) {
+					serv->getDriver()->clearSelectShapes();
+				}
+				auto id = int64_t(i % DbSelectShapeServer::ObjectsCount) * 2;
+				count += worker.select(db::Query().select("int2", db::Comparation::Equal, id))
+								 .size();
+			}
+			return true;
+		});
+		reportBenchmark(name, metric,
+				double((Time::now() - start).toMicros()) / double(Iterations), "us/select");
+		return count;
+	};
+
+	auto uncached = measure("select by id, select-list rendered", true);
+	auto cached = measure("select by id, select-list cached", false);
+
+	serv = nullptr;
+	filesystem::remove(FileInfo{path});
+	return expect(uncached == cached && cached == Iterations, name, "results differ");
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,185 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_DOCUMENT
+
+#include "SPDocCache.h"
+#include "SPDocNode.h"
+#include "SPFilesystem.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+static String makeDocCacheSource(size_t paragraphs) {
+	StringStream out;
+	out << "<html><head><title>Cache test</title>"
+		   "<meta name=\"author\" content=\"Stappler\">"
+		   "<style>p.text { margin: 4px 8px; color: #333; } .em { font-weight: bold; }</style>"
+		   "</head><body>";
+
+	uint32_t seed = 1;
+	for (size_t i = 0; i < paragraphs; ++i) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		out << "<p id=\"p" << i << "\" class=\"text\" data-index=\"" << i << "\">Paragraph " << i
+			<< " text with <span class=\"em\">value " << (seed >> 8) % 1'000
+			<< "</span> and <a href=\"#p" << (seed >> 4) % paragraphs << "\">link</a></p>";
+	}
+	out << "</body></html>";
+	return out.str();
+}
+
+static void collectDocCacheNodes(const document::Document *doc,
+		Vector<const document::Node *> &nodes) {
+	if (auto page = doc->getRoot()) {
+		const document::Node *root = page->getRoot();
+		root->foreach ([&](const document::Node &node, size_t) { nodes.emplace_back(&node); });
+	}
+}
+
+static RuntimeTest s_docCache("document.cache", RuntimeTest::Type::Test, [] {
+	StringView name("document.cache");
+	bool success = true;
+
+	auto source = FileInfo{"doc-cache-test.html", FileCategory::AppCache};
+	auto cache = FileInfo{"doc-cache-test.cache", FileCategory::AppCache};
+	auto cache2 = FileInfo{"doc-cache-test-2.cache", FileCategory::AppCache};
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+
+	auto data = makeDocCacheSource(256);
+	filesystem::write(source,
+			BytesView(reinterpret_cast<const uint8_t *>(data.data()), data.size()));
+
+	auto hash = document::DocumentCache::getSourceHash(source);
+	auto parsed = document::Document::open(memory::app_root_pool, source, "text/html");
+	success &= expect(parsed != nullptr, name, "fail to parse source");
+	if (!parsed) {
+		return false;
+	}
+
+	// cache file should not depend on uninitialized memory
+	success &= expect(document::DocumentCache::write(parsed, cache, hash), name,
+			"fail to write cache");
+	success &= expect(document::DocumentCache::write(parsed, cache2, hash), name,
+			"fail to write cache");
+	success &= expect(filesystem::readIntoMemory<Interface>(cache)
+					== filesystem::readIntoMemory<Interface>(cache2),
+			name, "cache content is not deterministic");
+
+	auto cached = document::DocumentCache::load(memory::app_root_pool, cache, hash);
+	success &= expect(cached != nullptr, name, "fail to load cache");
+	success &= expect(!document::DocumentCache::load(memory::app_root_pool, cache, hash + 1), name,
+			"cache with other source hash is accepted");
+	if (!cached) {
+		return false;
+	}
+
+	Vector<const document::Node *> parsedNodes;
+	Vector<const document::Node *> cachedNodes;
+	collectDocCacheNodes(parsed, parsedNodes);
+	collectDocCacheNodes(cached, cachedNodes);
+
+	success &= expect(!parsedNodes.empty() && parsedNodes.size() == cachedNodes.size(), name,
+			"invalid nodes count");
+
+	const char *pName = nullptr;
+	size_t sharedNames = 0;
+	for (size_t i = 0; i < std::min(parsedNodes.size(), cachedNodes.size()); ++i) {
+		auto a = parsedNodes[i];
+		auto b = cachedNodes[i];
+		if (a->getHtmlName() != b->getHtmlName() || a->getHtmlId() != b->getHtmlId()
+				|| a->getValue() != b->getValue() || a->getClasses() != b->getClasses()
+				|| a->getAttributes() != b->getAttributes()
+				|| a->getNodes().size() != b->getNodes().size()
+				|| a->getStyle().data.size() != b->getStyle().data.size()) {
+			success &= expect(false, name, toString("node ", i, " differs"));
+			break;
+		}
+
+		// interned strings refer to the same bytes within mapped cache
+		if (b->getHtmlName() == "p") {
+			if (!pName) {
+				pName = b->getHtmlName().data();
+			} else if (pName == b->getHtmlName().data()) {
+				++sharedNames;
+			}
+		}
+	}
+
+	success &= expect(sharedNames == 255, name, "strings are not views into cache");
+	success &= expect(cached->getRoot()->getTitle() == "Cache test", name, "invalid title");
+
+	cached = nullptr;
+	parsed = nullptr;
+
+	filesystem::remove(source);
+	filesystem::remove(cache);
+	filesystem::remove(cache2);
+	return success;
+});
+
+// Parsing of the source against loading of the precompiled cache
+static RuntimeTest s_docCacheBenchmark("document.cache", RuntimeTest::Type::Benchmark, [] {
+	StringView name("document.cache");
+	static constexpr size_t Iterations = 20;
+
+	auto source = FileInfo{"doc-cache-benchmark.html", FileCategory::AppCache};
+	auto cache = FileInfo{"doc-cache-benchmark.cache", FileCategory::AppCache};
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+
+	auto data = makeDocCacheSource(10'000);
+	filesystem::write(source,
+			BytesView(reinterpret_cast<const uint8_t *>(data.data()), data.size()));
+
+	auto hash = document::DocumentCache::getSourceHash(source);
+	if (auto doc = document::Document::open(memory::app_root_pool, source, "text/html")) {
+		document::DocumentCache::write(doc, cache, hash);
+	}
+
+	auto measure = [&](StringView metric, const Callback<bool()> &cb) {
+		bool success = true;
+		auto start = Time::now();
+		for (size_t i = 0; i < Iterations; ++i) { success &= cb(); }
+		reportBenchmark(name, metric,
+				double((Time::now() - start).toMicros()) / 1'000.0 / double(Iterations), "ms");
+		return success;
+	};
+
+	bool success = true;
+	success &= measure("open, parse", [&] {
+		return document::Document::open(memory::app_root_pool, source, "text/html") != nullptr;
+	});
+	success &= measure("open, cache", [&] {
+		return document::DocumentCache::load(memory::app_root_pool, cache, hash) != nullptr;
+	});
+
+	filesystem::remove(source);
+	filesystem::remove(cache);
+	return expect(success, name, "fail to open document");
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,239 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_GEOM
+
+#include "SPMat4.h"
+#include "SPGeometry.h"
+#include "SPSIMDBatch.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace geom;
+
+static constexpr simd::BatchBackend s_batchBackends[] = {
+	simd::BatchBackend::Scalar,
+	simd::BatchBackend::Sse,
+	simd::BatchBackend::Avx2,
+	simd::BatchBackend::Neon,
+};
+
+static StringView getBatchBackendName(simd::BatchBackend b) {
+	switch (b) {
+	case simd::BatchBackend::Scalar: return "scalar"; break;
+	case simd::BatchBackend::Sse: return "sse"; break;
+	case simd::BatchBackend::Avx2: return "avx2"; break;
+	case simd::BatchBackend::Neon: return "neon"; break;
+	}
+	return StringView();
+}
+
+static Mat4 makeBatchTestMatrix() {
+	Mat4 ret;
+	Mat4::createRotationZ(0.35f, &ret);
+	ret.scale(1.5f, 0.75f, 1.0f);
+	ret.translate(12.0f, -7.0f, 0.5f);
+	return ret;
+}
+
+static void fillBatchTestData(Vector<float> &data, size_t count) {
+	data.resize(count);
+	uint32_t seed = 0xdead'beef;
+	for (auto &it : data) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		it = float(seed >> 8) / float(1 << 24) * 200.0f - 100.0f;
+	}
+}
+
+static bool isBatchResultEqual(SpanView<float> a, SpanView<float> b) {
+	if (a.size() != b.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.size(); ++i) {
+		// FMA and different summation order are allowed
+		if (std::abs(a[i] - b[i]) > 1e-3f * std::max(1.0f, std::abs(b[i]))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static RuntimeTest s_batchKernelsTest("geom.simd_batch.accuracy", RuntimeTest::Type::Test, [] {
+	StringView name("geom.simd_batch.accuracy");
+
+	// not multiple of any vector width to test tails
+	static constexpr size_t Count = 1'027;
+
+	auto m = makeBatchTestMatrix();
+	Vector<float> src;
+	fillBatchTestData(src, Count * 16);
+
+	auto scalar = simd::getBatchKernels(simd::BatchBackend::Scalar);
+
+	// reference for the scalar kernels - single-value geom functions
+	bool success = true;
+	for (size_t i = 0; i < Count; ++i) {
+		auto v = Vec4(src[i * 4], src[i * 4 + 1], src[i * 4 + 2], src[i * 4 + 3]);
+		auto ref = m * v;
+		float out[4];
+		scalar->transformVec4(m.m, &v.x, sizeof(Vec4), out, sizeof(Vec4), 1);
+		if (!isBatchResultEqual(makeSpanView(out, 4), makeSpanView(&ref.x, 4))) {
+			success = expect(false, name, "scalar transformVec4 does not match Mat4 * Vec4");
+			break;
+		}
+
+		auto r = Rect(src[i * 4], src[i * 4 + 1], std::abs(src[i * 4 + 2]),
+				std::abs(src[i * 4 + 3]));
+		auto refRect = TransformRect(r, m);
+		Rect outRect;
+		scalar->transformRect(m.m, &r.origin.x, sizeof(Rect), &outRect.origin.x, sizeof(Rect), 1);
+		if (!isBatchResultEqual(makeSpanView(&outRect.origin.x, 4),
+					makeSpanView(&refRect.origin.x, 4))) {
+			success = expect(false, name, "scalar transformRect does not match TransformRect");
+			break;
+		}
+	}
+
+	for (auto b : s_batchBackends) {
+		if (b == simd::BatchBackend::Scalar || !simd::isBatchBackendSupported(b)) {
+			continue;
+		}
+
+		auto k = simd::getBatchKernels(b);
+		auto backendName = getBatchBackendName(b);
+
+		auto check = [&](StringView kernel, auto &&cb, size_t outSize) {
+			Vector<float> expected(outSize);
+			Vector<float> actual(outSize);
+			cb(scalar, expected.data());
+			cb(k, actual.data());
+			success = expect(isBatchResultEqual(actual, expected), name,
+							  toString(backendName, ": ", kernel, " does not match scalar"))
+					&& success;
+		};
+
+		check("transformVec2", [&](const simd::BatchKernels *kernels, float *dst) {
+			kernels->transformVec2(m.m, src.data(), sizeof(float) * 2, dst, sizeof(float) * 2,
+					Count);
+		}, Count * 2);
+		check("transformVec4", [&](const simd::BatchKernels *kernels, float *dst) {
+			kernels->transformVec4(m.m, src.data(), sizeof(float) * 4, dst, sizeof(float) * 4,
+					Count);
+		}, Count * 4);
+		check("multiplyMat4", [&](const simd::BatchKernels *kernels, float *dst) {
+			kernels->multiplyMat4(m.m, src.data(), sizeof(Mat4), dst, sizeof(Mat4), Count);
+		}, Count * 16);
+		check("transformRect", [&](const simd::BatchKernels *kernels, float *dst) {
+			kernels->transformRect(m.m, src.data(), sizeof(float) * 4, dst, sizeof(float) * 4,
+					Count);
+		}, Count * 4);
+		check("transformVec2SoA", [&](const simd::BatchKernels *kernels, float *dst) {
+			kernels->transformVec2SoA(m.m, src.data(), src.data() + Count, dst, dst + Count, Count);
+		}, Count * 2);
+		check("transformVec4SoA", [&](const simd::BatchKernels *kernels, float *dst) {
+			const float *in[4] = {src.data(), src.data() + Count, src.data() + Count * 2,
+				src.data() + Count * 3};
+			float *out[4] = {dst, dst + Count, dst + Count * 2, dst + Count * 3};
+			kernels->transformVec4SoA(m.m, in, out, Count);
+		}, Count * 4);
+	}
+
+	return success;
+});
+
+static RuntimeTest s_batchKernelsBench("geom.simd_batch", RuntimeTest::Type::Benchmark, [] {
+	StringView name("geom.simd_batch");
+
+	static constexpr size_t Count = 1 << 20;
+	static constexpr size_t Iterations = 10;
+
+	auto m = makeBatchTestMatrix();
+	Vector<float> src;
+	Vector<float> dst;
+	fillBatchTestData(src, Count * 4);
+	dst.resize(Count * 16);
+
+	auto measure = [&](StringView metric, size_t count, auto &&cb) {
+		auto t = Time::now();
+		for (size_t i = 0; i < Iterations; ++i) { cb(); }
+		auto time = (Time::now() - t).toMicros();
+		reportBenchmark(name, metric,
+				double(time) * 1'000.0 / double(Iterations) / double(count), "ns/item");
+	};
+
+	// one-at-a-time operations, as used before batched kernels
+	measure("Mat4 * Vec4 (single)", Count, [&] {
+		auto in = reinterpret_cast<const Vec4 *>(src.data());
+		auto out = reinterpret_cast<Vec4 *>(dst.data());
+		for (size_t i = 0; i < Count; ++i) { out[i] = m * in[i]; }
+	});
+	measure("Mat4 * Mat4 (single)", Count / 4, [&] {
+		auto in = reinterpret_cast<const Mat4 *>(src.data());
+		auto out = reinterpret_cast<Mat4 *>(dst.data());
+		for (size_t i = 0; i < Count / 4; ++i) { out[i] = m * in[i]; }
+	});
+
+	for (auto b : s_batchBackends) {
+		if (!simd::isBatchBackendSupported(b)) {
+			continue;
+		}
+
+		auto kernels = simd::getBatchKernels(b);
+		auto backendName = getBatchBackendName(b);
+
+		measure(toString(backendName, ": transformVec2"), Count, [&] {
+			kernels->transformVec2(m.m, src.data(), sizeof(float) * 2, dst.data(),
+					sizeof(float) * 2, Count);
+		});
+		measure(toString(backendName, ": transformVec4"), Count, [&] {
+			kernels->transformVec4(m.m, src.data(), sizeof(float) * 4, dst.data(),
+					sizeof(float) * 4, Count);
+		});
+		measure(toString(backendName, ": multiplyMat4"), Count / 4, [&] {
+			kernels->multiplyMat4(m.m, src.data(), sizeof(Mat4), dst.data(), sizeof(Mat4),
+					Count / 4);
+		});
+		measure(toString(backendName, ": transformRect"), Count, [&] {
+			kernels->transformRect(m.m, src.data(), sizeof(float) * 4, dst.data(),
+					sizeof(float) * 4, Count);
+		});
+		measure(toString(backendName, ": transformVec2SoA"), Count, [&] {
+			kernels->transformVec2SoA(m.m, src.data(), src.data() + Count, dst.data(),
+					dst.data() + Count, Count);
+		});
+		measure(toString(backendName, ": transformVec4SoA"), Count, [&] {
+			const float *in[4] = {src.data(), src.data() + Count, src.data() + Count * 2,
+				src.data() + Count * 3};
+			float *out[4] = {dst.data(), dst.data() + Count, dst.data() + Count * 2,
+				dst.data() + Count * 3};
+			kernels->transformVec4SoA(m.m, in, out, Count);
+		});
+	}
+	return true;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,233 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_FONT
+
+#include "SPFontHyphenMap.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+// Subset of english Liang patterns, enough to produce breaks in common words
+static constexpr StringView s_hyphenTestDict(R"(UTF-8
+LEFTHYPHENMIN 2
+RIGHTHYPHENMIN 3
+.ach4
+.ad4der
+.al3t
+.an5c
+.ang4
+.ant4
+.as3c
+.as1p
+.atom5
+.ba4g
+.be5ra
+.ca4t
+.ch4
+.co4r
+.de3o
+.de3ra
+.des4c
+.dictio5
+.en3g
+.es3
+.eu3
+.for5mer
+.ga2
+4tion
+1tio
+2io
+o2n
+hy3ph
+he2n
+hen5at
+1na
+n2at
+1ba
+b2l
+2ment
+ex1
+1pe
+per1
+3ple
+a1ti
+con1
+1ca
+2ing
+1ni
+pro1
+1gr
+1ta
+5sion
+1cu
+1la
+1te
+1ty
+1ri
+1di
+1fi
+1li
+1mi
+1pi
+1si
+1vi
+)");
+
+static constexpr StringView s_hyphenTestWords[] = {
+	"hyphenation",
+	"dictionary",
+	"information",
+	"computation",
+	"composition",
+	"perpendicular",
+	"experimental",
+	"programming",
+	"anticipation",
+	"documentation",
+	"relativity",
+	"probability",
+	"mathematics",
+	"description",
+	"catastrophe",
+	"development",
+	"agreement",
+	"government",
+	"possibility",
+	"capability",
+	"ab",
+	"abc",
+	"table",
+	"nation",
+	"tiny",
+};
+
+static Rc<font::HyphenMap> makeHyphenTestMap(font::HyphenMap::DictMode mode, size_t cacheLimit) {
+	auto map = Rc<font::HyphenMap>::create();
+	map->setCacheLimit(cacheLimit);
+	map->addHyphenDict(CharGroupId::Latin,
+			BytesView(reinterpret_cast<const uint8_t *>(s_hyphenTestDict.data()),
+					s_hyphenTestDict.size()),
+			mode);
+	return map;
+}
+
+static RuntimeTest s_hyphenMap("font.hyphen_map", RuntimeTest::Type::Test, [] {
+	StringView name("font.hyphen_map");
+	bool success = true;
+
+	auto native = makeHyphenTestMap(font::HyphenMap::DictMode::Native, 0);
+	auto packed = makeHyphenTestMap(font::HyphenMap::DictMode::PackedTrie, 0);
+	auto cached = makeHyphenTestMap(font::HyphenMap::DictMode::PackedTrie, 16);
+
+	size_t breaks = 0;
+	for (auto &it : s_hyphenTestWords) {
+		auto word = string::toUtf16<Interface>(it);
+
+		auto a = native->makeWordHyphens(word);
+		auto b = packed->makeWordHyphens(word);
+		success &= expect(a == b, name, toString("modes differ for '", it, "'"));
+
+		// both lookups for the same word should be served equally from cache
+		success &= expect(cached->makeWordHyphens(word) == b, name,
+				toString("invalid cached result for '", it, "'"));
+		success &= expect(cached->makeWordHyphens(word) == b, name,
+				toString("invalid cached result for '", it, "'"));
+
+		// LEFTHYPHENMIN 2 and RIGHTHYPHENMIN 3 from dictionary
+		for (auto &pos : a) {
+			success &= expect(pos >= 2 && word.size() - pos >= 3, name,
+					toString("break ", int(pos), " in '", it, "' ignores limits"));
+		}
+		breaks += a.size();
+	}
+
+	success &= expect(breaks > 0, name, "no breaks found");
+
+	auto hyphenation = packed->makeWordHyphens(string::toUtf16<Interface>("hyphenation"));
+	success &= expect(!hyphenation.empty() && hyphenation.front() == 2, name,
+			"invalid breaks for 'hyphenation'");
+
+	// words outside of dictionary group
+	success &= expect(packed->makeWordHyphens(u"123456").empty(), name,
+			"digits should not be hyphenated");
+
+	packed->purgeHyphenDicts();
+	success &= expect(packed->makeWordHyphens(u"hyphenation").empty(), name,
+			"dictionary is not purged");
+	return success;
+});
+
+// Hyphenation of a novel-sized text with repeated words, with and without word cache
+static RuntimeTest s_hyphenMapBenchmark("font.hyphen_map", RuntimeTest::Type::Benchmark, [] {
+	StringView name("font.hyphen_map");
+	static constexpr size_t WordsCount = 200'000;
+
+	Vector<WideString> vocabulary;
+	for (auto &it : s_hyphenTestWords) { vocabulary.emplace_back(string::toUtf16<Interface>(it)); }
+
+	// skewed distribution: short list of words are used much more often
+	uint32_t seed = 1;
+	Vector<const WideString *> text;
+	text.reserve(WordsCount);
+	for (size_t i = 0; i < WordsCount; ++i) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		auto a = (seed >> 8) % vocabulary.size();
+		seed = seed * 1'664'525 + 1'013'904'223;
+		auto b = (seed >> 8) % vocabulary.size();
+		text.emplace_back(&vocabulary[a * b / vocabulary.size()]);
+	}
+
+	bool success = true;
+	size_t expected = 0;
+
+	auto measure = [&](StringView metric, font::HyphenMap::DictMode mode, size_t cacheLimit) {
+		auto map = makeHyphenTestMap(mode, cacheLimit);
+
+		size_t breaks = 0;
+		auto start = Time::now();
+		for (auto &it : text) { breaks += map->makeWordHyphens(*it).size(); }
+		reportBenchmark(name, metric, double((Time::now() - start).toMicros()) / 1'000.0, "ms");
+
+		if (expected == 0) {
+			expected = breaks;
+		}
+		success &= expect(breaks == expected, name, toString(metric, ": results differ"));
+	};
+
+	measure("native, no cache", font::HyphenMap::DictMode::Native, 0);
+	measure("native, cache", font::HyphenMap::DictMode::Native,
+			font::HyphenMap::DefaultCacheLimit);
+	measure("packed trie, no cache", font::HyphenMap::DictMode::PackedTrie, 0);
+	measure("packed trie, cache", font::HyphenMap::DictMode::PackedTrie,
+			font::HyphenMap::DefaultCacheLimit);
+
+	return success;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,169 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_APPLICATION
+
+#include "XLInputDispatcher.h"
+#include "XLInputListener.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+// Grid of list-like items with some overlapping and some unbounded listeners
+static Rc<InputListenerStorage> makeInputIndexStorage(Rc<PoolRef> &pool, uint32_t count,
+		Vector<Rc<InputListener>> &listeners, Vector<Rect> &bounds) {
+	pool = Rc<PoolRef>::alloc();
+	auto storage = Rc<InputListenerStorage>::alloc(pool.get());
+
+	auto columns = uint32_t(std::ceil(std::sqrt(float(count))));
+	for (uint32_t i = 0; i < count; ++i) {
+		auto l = Rc<InputListener>::create(int32_t(i % 3) - 1);
+		auto rect = Rect(float(i % columns) * 10.0f, float(i / columns) * 10.0f, 12.0f, 12.0f);
+
+		// every 100th listener has no known bounds
+		storage->addListener(l, nullptr, WindowLayer(), (i % 100 == 0) ? nullptr : &rect);
+		listeners.emplace_back(move(l));
+		bounds.emplace_back((i % 100 == 0) ? Rect(-1e6f, -1e6f, 2e6f, 2e6f) : rect);
+	}
+
+	storage->sort();
+	storage->buildIndex();
+	return storage;
+}
+
+static RuntimeTest s_inputIndexOrder("xenolith.input_index.order", RuntimeTest::Type::Test, [] {
+	StringView name("xenolith.input_index.order");
+
+	Vector<Rc<InputListener>> listeners;
+	Vector<Rect> bounds;
+	Rc<PoolRef> pool;
+	auto storage = makeInputIndexStorage(pool, 5'000, listeners, bounds);
+
+	Map<const InputListener *, const Rect *> boundsMap;
+	for (size_t i = 0; i < listeners.size(); ++i) {
+		boundsMap.emplace(listeners[i].get(), &bounds[i]);
+	}
+
+	Vector<const InputListener *> fullOrder;
+	storage->foreachListener([&](const InputListenerStorage::Rec &rec) {
+		fullOrder.emplace_back(rec.listener.get());
+		return true;
+	}, nullptr);
+
+	uint32_t seed = 42;
+	for (uint32_t i = 0; i < 1'000; ++i) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		auto x = float(seed >> 16) / 65'536.0f * 720.0f - 5.0f;
+		seed = seed * 1'664'525 + 1'013'904'223;
+		auto y = float(seed >> 16) / 65'536.0f * 720.0f - 5.0f;
+		auto loc = Vec2(x, y);
+
+		// expected: all listeners, that can be hit, in full iteration order
+		Vector<const InputListener *> expected;
+		for (auto &it : fullOrder) {
+			if (boundsMap[it]->containsPoint(loc)) {
+				expected.emplace_back(it);
+			}
+		}
+
+		Vector<const InputListener *> actual;
+		storage->foreachListenerAt(loc, [&](const InputListenerStorage::Rec &rec) {
+			if (boundsMap[rec.listener.get()]->containsPoint(loc)) {
+				actual.emplace_back(rec.listener.get());
+			}
+			return true;
+		}, nullptr, SpanView<const InputListener *>());
+
+		if (!expect(actual == expected, name,
+					toString("candidates mismatch at ", loc, ": ", actual.size(), " vs ",
+							expected.size()))) {
+			return false;
+		}
+	}
+	return true;
+});
+
+static RuntimeTest s_inputIndexBench("xenolith.input_index.10k", RuntimeTest::Type::Benchmark, [] {
+	StringView name("xenolith.input_index.10k");
+	static constexpr uint32_t Events = 10'000;
+
+	Vector<Rc<InputListener>> listeners;
+	Vector<Rect> bounds;
+	Rc<PoolRef> pool;
+
+	auto t = Time::now();
+	auto storage = makeInputIndexStorage(pool, 10'000, listeners, bounds);
+	auto buildTime = (Time::now() - t).toMicros();
+
+	Vector<Vec2> locations;
+	uint32_t seed = 7;
+	for (uint32_t i = 0; i < Events; ++i) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		auto x = float(seed >> 16) / 65'536.0f * 1'000.0f;
+		seed = seed * 1'664'525 + 1'013'904'223;
+		auto y = float(seed >> 16) / 65'536.0f * 1'000.0f;
+		locations.emplace_back(x, y);
+	}
+
+	// move event: every candidate checked with it's bounds, as listener does with node bounds
+	size_t fullCandidates = 0;
+	size_t hits = 0;
+	t = Time::now();
+	for (auto &loc : locations) {
+		storage->foreachListener([&](const InputListenerStorage::Rec &rec) {
+			++fullCandidates;
+			if (rec.indexed && rec.bounds.containsPoint(loc)) {
+				++hits;
+			}
+			return true;
+		}, nullptr);
+	}
+	auto fullTime = (Time::now() - t).toMicros();
+
+	size_t indexedCandidates = 0;
+	t = Time::now();
+	for (auto &loc : locations) {
+		storage->foreachListenerAt(loc, [&](const InputListenerStorage::Rec &rec) {
+			++indexedCandidates;
+			if (rec.indexed && rec.bounds.containsPoint(loc)) {
+				++hits;
+			}
+			return true;
+		}, nullptr, SpanView<const InputListener *>());
+	}
+	auto indexedTime = (Time::now() - t).toMicros();
+
+	reportBenchmark(name, "storage build with index", double(buildTime) / 1'000.0, "ms");
+	reportBenchmark(name, "full iteration", double(fullTime) / Events, "us/event");
+	reportBenchmark(name, "full iteration candidates", double(fullCandidates) / Events, "");
+	reportBenchmark(name, "indexed", double(indexedTime) / Events, "us/event");
+	reportBenchmark(name, "indexed candidates", double(indexedCandidates) / Events, "");
+	return hits > 0;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,243 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "LocalHttpServer.h"
+
+#if LINUX || MACOS
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+StringView LocalHttpServer::Request::getHeader(StringView name) const {
+	auto it = headers.find(string::tolower<memory::StandartInterface>(name));
+	if (it != headers.end()) {
+		return it->second;
+	}
+	return StringView();
+}
+
+LocalHttpServer::~LocalHttpServer() { stop(); }
+
+mem_std::String LocalHttpServer::getUrl(StringView path) const {
+	return string::toString<memory::StandartInterface>("http://127.0.0.1:", _port, path);
+}
+
+#if LINUX || MACOS
+
+bool LocalHttpServer::start(Handler &&handler) {
+	_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+	if (_socket < 0) {
+		return false;
+	}
+
+	int enable = 1;
+	::setsockopt(_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+
+	socklen_t len = sizeof(addr);
+	if (::bind(_socket, (struct sockaddr *)&addr, sizeof(addr)) != 0 || ::listen(_socket, 128) != 0
+			|| ::getsockname(_socket, (struct sockaddr *)&addr, &len) != 0) {
+		::close(_socket);
+		_socket = -1;
+		return false;
+	}
+
+	_port = ntohs(addr.sin_port);
+	_handler = sp::move(handler);
+	_running = true;
+	_acceptThread = std::thread([this] { acceptConnections(); });
+	return true;
+}
+
+void LocalHttpServer::stop() {
+	if (!_running.exchange(false)) {
+		return;
+	}
+
+	if (_acceptThread.joinable()) {
+		_acceptThread.join();
+	}
+
+	mem_std::Vector<std::thread> connections;
+	_mutex.lock();
+	connections = sp::move(_connections);
+	_mutex.unlock();
+
+	for (auto &it : connections) { it.join(); }
+
+	::close(_socket);
+	_socket = -1;
+}
+
+void LocalHttpServer::acceptConnections() {
+	while (_running) {
+		struct pollfd fd{_socket, POLLIN, 0};
+		if (::poll(&fd, 1, 20) <= 0) {
+			continue;
+		}
+
+		auto client = ::accept(_socket, nullptr, nullptr);
+		if (client >= 0) {
+			std::unique_lock lock(_mutex);
+			_connections.emplace_back([this, client] {
+				serveConnection(client);
+				::close(client);
+			});
+		}
+	}
+}
+
+static bool LocalHttpServer_readMore(int fd, mem_std::String &buf,
+		const std::atomic<bool> &running) {
+	char tmp[16 * 1'024];
+	while (running) {
+		struct pollfd pfd{fd, POLLIN, 0};
+		auto ret = ::poll(&pfd, 1, 20);
+		if (ret == 0) {
+			continue;
+		} else if (ret < 0) {
+			return false;
+		}
+
+		auto n = ::recv(fd, tmp, sizeof(tmp), 0);
+		if (n <= 0) {
+			return false;
+		}
+		buf.append(tmp, size_t(n));
+		return true;
+	}
+	return false;
+}
+
+static bool LocalHttpServer_write(int fd, const uint8_t *data, size_t size) {
+	while (size > 0) {
+		auto n = ::send(fd, data, size, MSG_NOSIGNAL);
+		if (n <= 0) {
+			return false;
+		}
+		data += n;
+		size -= size_t(n);
+	}
+	return true;
+}
+
+static StringView LocalHttpServer_getStatusText(uint32_t status) {
+	switch (status) {
+	case 200: return "OK"; break;
+	case 304: return "Not Modified"; break;
+	case 404: return "Not Found"; break;
+	default: break;
+	}
+	return "Unknown";
+}
+
+void LocalHttpServer::serveConnection(int fd) {
+	mem_std::String buf;
+	while (_running) {
+		size_t headerEnd = 0;
+		while ((headerEnd = buf.find("\r\n\r\n")) == mem_std::String::npos) {
+			if (!LocalHttpServer_readMore(fd, buf, _running)) {
+				return;
+			}
+		}
+
+		Request req;
+		StringView r(buf.data(), headerEnd);
+
+		auto line = r.readUntil<StringView::Chars<'\r'>>();
+		req.method = line.readUntil<StringView::WhiteSpace>().str<memory::StandartInterface>();
+		line.skipChars<StringView::WhiteSpace>();
+		req.path = line.readUntil<StringView::WhiteSpace>().str<memory::StandartInterface>();
+
+		while (!r.empty()) {
+			r.skipChars<StringView::Chars<'\r', '\n'>>();
+			auto header = r.readUntil<StringView::Chars<'\r'>>();
+			auto name = header.readUntil<StringView::Chars<':'>>();
+			if (header.is(':')) {
+				header += 1;
+				header.skipChars<StringView::WhiteSpace>();
+				req.headers.emplace(string::tolower<memory::StandartInterface>(name),
+						header.str<memory::StandartInterface>());
+			}
+		}
+
+		buf.erase(0, headerEnd + 4);
+
+		auto contentLength = StringView(req.getHeader("content-length")).readInteger(10).get(0);
+		while (buf.size() < size_t(contentLength)) {
+			if (!LocalHttpServer_readMore(fd, buf, _running)) {
+				return;
+			}
+		}
+
+		req.body.assign((const uint8_t *)buf.data(), (const uint8_t *)buf.data() + contentLength);
+		buf.erase(0, size_t(contentLength));
+
+		++_requests;
+		auto resp = _handler(req);
+
+		auto head = string::toString<memory::StandartInterface>("HTTP/1.1 ", resp.status, " ",
+				LocalHttpServer_getStatusText(resp.status), "\r\n");
+		for (auto &it : resp.headers) {
+			head.append(string::toString<memory::StandartInterface>(it.first, ": ", it.second,
+					"\r\n"));
+		}
+		if (resp.status != 304) {
+			head.append(string::toString<memory::StandartInterface>("Content-Length: ",
+					resp.body.size(), "\r\n"));
+		}
+		head.append("\r\n");
+
+		if (!LocalHttpServer_write(fd, (const uint8_t *)head.data(), head.size())) {
+			return;
+		}
+		if (req.method != "HEAD" && resp.status != 304
+				&& !LocalHttpServer_write(fd, resp.body.data(), resp.body.size())) {
+			return;
+		}
+	}
+}
+
+#else
+
+bool LocalHttpServer::start(Handler &&) { return false; }
+
+void LocalHttpServer::stop() { }
+
+void LocalHttpServer::acceptConnections() { }
+
+void LocalHttpServer::serveConnection(int fd) { }
+
+#endif
+
+} // namespace stappler::test
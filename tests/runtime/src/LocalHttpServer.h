@@ -0,0 +1,86 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#ifndef TESTS_RUNTIME_SRC_LOCALHTTPSERVER_H_
+#define TESTS_RUNTIME_SRC_LOCALHTTPSERVER_H_
+
+#include "SPCommon.h"
+
+#include <thread>
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+/* Minimal HTTP/1.1 server on 127.0.0.1 for network tests and benchmarks
+ *
+ * Every connection is served on its own thread with keep-alive, request body is read with
+ * Content-Length and passed to the handler. Handler is called from connection threads,
+ * so it should be thread-safe.
+ */
+class SP_PUBLIC LocalHttpServer {
+public:
+	struct Request {
+		mem_std::String method;
+		mem_std::String path;
+		mem_std::Map<mem_std::String, mem_std::String> headers; // names are lowercase
+		mem_std::Bytes body;
+
+		StringView getHeader(StringView) const;
+	};
+
+	struct Response {
+		uint32_t status = 200;
+		mem_std::Vector<Pair<mem_std::String, mem_std::String>> headers;
+		mem_std::Bytes body;
+	};
+
+	using Handler = std::function<Response(const Request &)>;
+
+	~LocalHttpServer();
+
+	// listens on a random port; returns false when sockets are not available
+	bool start(Handler &&);
+	void stop();
+
+	uint16_t getPort() const { return _port; }
+	mem_std::String getUrl(StringView path) const;
+
+	size_t getRequestsCount() const { return _requests.load(); }
+
+protected:
+	void acceptConnections();
+	void serveConnection(int fd);
+
+	Handler _handler;
+	int _socket = -1;
+	uint16_t _port = 0;
+	std::atomic<bool> _running = false;
+	std::atomic<size_t> _requests = 0;
+
+	std::mutex _mutex;
+	std::thread _acceptThread;
+	mem_std::Vector<std::thread> _connections;
+};
+
+} // namespace stappler::test
+
+#endif /* TESTS_RUNTIME_SRC_LOCALHTTPSERVER_H_ */
@@ -0,0 +1,184 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_CORE
+
+#include "SPMemPoolStats.h"
+
+#include <thread>
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+static bool findMemoryStatsPool(const memory::pool_t *pool, memory::stats::PoolStats &ret) {
+	bool found = false;
+	memory::stats::foreachPool([&](const memory::stats::PoolStats &stats) {
+		if (stats.pool == pool) {
+			ret = stats;
+			found = true;
+		}
+	});
+	return found;
+}
+
+static bool findMemoryStatsTag(StringView tag, memory::stats::TagStats &ret) {
+	bool found = false;
+	memory::stats::foreachTag([&](const memory::stats::TagStats &stats) {
+		if (StringView(stats.tag) == tag) {
+			ret = stats;
+			found = true;
+		}
+	});
+	return found;
+}
+
+static RuntimeTest s_memoryStats("memory.stats", RuntimeTest::Type::Test, [] {
+	StringView name("memory.stats");
+	static constexpr size_t ThreadsCount = 4;
+	static constexpr size_t AllocCount = 10'000;
+	static constexpr size_t AllocSize = 32;
+
+	bool success = true;
+	auto enabled = memory::stats::isEnabled();
+	memory::stats::reset();
+	memory::stats::setEnabled(true);
+
+	// every thread allocates from own pool and from one shared pool
+	auto shared = memory::pool::create_tagged("test.memory.shared");
+	Vector<memory::pool_t *> pools;
+	for (size_t i = 0; i < ThreadsCount; ++i) {
+		pools.emplace_back(memory::pool::create_tagged("test.memory.local"));
+	}
+
+	std::mutex sharedMutex;
+	Vector<std::thread> threads;
+	for (size_t i = 0; i < ThreadsCount; ++i) {
+		threads.emplace_back([&, pool = pools[i]] {
+			for (size_t j = 0; j < AllocCount; ++j) {
+				memory::pool::palloc(pool, AllocSize);
+				if (j % 10 == 0) {
+					std::unique_lock lock(sharedMutex);
+					memory::pool::palloc(shared, AllocSize);
+				}
+			}
+		});
+	}
+	for (auto &it : threads) { it.join(); }
+
+	// counters of finished threads are kept
+	for (auto &it : pools) {
+		memory::stats::PoolStats stats;
+		success &= expect(findMemoryStatsPool(it, stats), name, "pool is not tracked");
+		success &= expect(stats.allocations == AllocCount, name, "invalid allocations count");
+		success &= expect(stats.bytes == AllocCount * AllocSize, name, "invalid bytes");
+		success &= expect(stats.peakBytes >= stats.bytes, name, "invalid peak");
+	}
+
+	memory::stats::PoolStats sharedStats;
+	success &= expect(findMemoryStatsPool(shared, sharedStats), name, "pool is not tracked");
+	success &= expect(sharedStats.allocations == ThreadsCount * AllocCount / 10, name,
+			"invalid allocations count for shared pool");
+	success &= expect(sharedStats.totalBytes == ThreadsCount * AllocCount / 10 * AllocSize, name,
+			"invalid total bytes for shared pool");
+
+	// clear drops bytes in all threads, but keeps cumulative counters
+	memory::pool::clear(shared);
+	success &= expect(findMemoryStatsPool(shared, sharedStats), name, "pool is not tracked");
+	success &= expect(sharedStats.bytes == 0 && sharedStats.clears == 1, name,
+			"clear is not applied");
+	success &= expect(sharedStats.totalBytes == ThreadsCount * AllocCount / 10 * AllocSize, name,
+			"total bytes are dropped on clear");
+	success &= expect(sharedStats.peakBytes == sharedStats.totalBytes, name,
+			"peak is not merged on clear");
+
+	auto global = memory::stats::getGlobalStats();
+	success &= expect(global.bytes == ThreadsCount * AllocCount * AllocSize, name,
+			"invalid global bytes");
+
+	for (auto &it : pools) { memory::pool::destroy(it); }
+	memory::pool::destroy(shared);
+
+	memory::stats::TagStats tagStats;
+	success &= expect(findMemoryStatsTag("test.memory.local", tagStats), name, "tag is missed");
+	success &= expect(tagStats.livePools == 0 && tagStats.destroyedPools == ThreadsCount, name,
+			"invalid pools count for tag");
+	success &= expect(tagStats.allocations == ThreadsCount * AllocCount, name,
+			"invalid allocations count for tag");
+
+	memory::stats::setEnabled(enabled);
+	memory::stats::reset();
+	return success;
+});
+
+// Cost of instrumented palloc, disabled and enabled, with concurrent allocating threads
+static RuntimeTest s_memoryStatsBenchmark("memory.stats", RuntimeTest::Type::Benchmark, [] {
+	StringView name("memory.stats");
+	static constexpr size_t AllocCount = 1'000'000;
+
+	auto enabled = memory::stats::isEnabled();
+
+	auto measure = [&](size_t threadsCount) {
+		Vector<memory::pool_t *> pools;
+		for (size_t i = 0; i < threadsCount; ++i) {
+			pools.emplace_back(memory::pool::create_tagged("test.memory.benchmark"));
+		}
+
+		auto start = Time::now();
+		Vector<std::thread> threads;
+		for (size_t i = 0; i < threadsCount; ++i) {
+			threads.emplace_back([pool = pools[i]] {
+				for (size_t j = 0; j < AllocCount; ++j) {
+					memory::pool::palloc(pool, 16);
+					if (j % 4'096 == 4'095) {
+						memory::pool::clear(pool);
+					}
+				}
+			});
+		}
+		for (auto &it : threads) { it.join(); }
+		auto ret = double((Time::now() - start).toMicros()) * 1'000.0 / double(AllocCount);
+
+		for (auto &it : pools) { memory::pool::destroy(it); }
+		return ret;
+	};
+
+	for (size_t threadsCount : {size_t(1), size_t(4)}) {
+		memory::stats::setEnabled(false);
+		reportBenchmark(name, toString("palloc, disabled, ", threadsCount, " threads"),
+				measure(threadsCount), "ns/alloc");
+
+		memory::stats::setEnabled(true);
+		reportBenchmark(name, toString("palloc, enabled, ", threadsCount, " threads"),
+				measure(threadsCount), "ns/alloc");
+		memory::stats::reset();
+	}
+
+	memory::stats::setEnabled(enabled);
+	return true;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,356 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_RESOURCES_NETWORK
+
+#include "XLNetworkCache.h"
+#include "XLNetworkController.h"
+#include "LocalHttpServer.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using xenolith::network::Cache;
+using xenolith::network::CacheInfo;
+using xenolith::network::Controller;
+using xenolith::network::Request;
+
+static constexpr size_t NetworkCacheTestLargeBody = 512_KiB; // above CacheInfo::memoryBodyLimit
+
+static BytesView getNetworkCacheTestLargeBody() {
+	static mem_std::Bytes s_body = [] {
+		mem_std::Bytes ret;
+		ret.resize(NetworkCacheTestLargeBody);
+		for (size_t i = 0; i < ret.size(); ++i) { ret[i] = uint8_t(i * 13 + i / 4'096); }
+		return ret;
+	}();
+	return s_body;
+}
+
+static bool startNetworkCacheTestServer(LocalHttpServer &server) {
+	return server.start([](const LocalHttpServer::Request &req) {
+		LocalHttpServer::Response resp;
+		StringView path(req.path);
+		if (path.starts_with("/lang")) {
+			resp.headers.emplace_back("Vary", "Accept-Language");
+			resp.headers.emplace_back("Cache-Control", "max-age=3600");
+			resp.body = BytesView(StringView(toString("lang:", req.getHeader("accept-language"))))
+								.bytes<memory::StandartInterface>();
+		} else if (path.starts_with("/stale")) {
+			resp.headers.emplace_back("Cache-Control", "max-age=0");
+			resp.headers.emplace_back("ETag", "\"v1\"");
+			if (req.getHeader("if-none-match") == "\"v1\"") {
+				resp.status = 304;
+			} else {
+				resp.body = BytesView(StringView("stale")).bytes<memory::StandartInterface>();
+			}
+		} else if (path.starts_with("/large")) {
+			resp.headers.emplace_back("Cache-Control", "max-age=3600");
+			resp.body = getNetworkCacheTestLargeBody().bytes<memory::StandartInterface>();
+		} else {
+			// /blob/<n>, 16 KiB body
+			resp.headers.emplace_back("Cache-Control", "max-age=3600");
+			resp.body.resize(16 * 1'024);
+			for (size_t i = 0; i < resp.body.size(); ++i) { resp.body[i] = uint8_t(i * 7); }
+		}
+		return resp;
+	});
+}
+
+static Rc<Request> makeNetworkCacheTestRequest(const LocalHttpServer &server, StringView path,
+		StringView lang = StringView()) {
+	auto url = server.getUrl(path);
+	return Rc<Request>::create([&](xenolith::network::Handle &handle) {
+		if (!handle.init(url)) {
+			return false;
+		}
+		if (!lang.empty()) {
+			handle.addHeader("Accept-Language", lang);
+		}
+		return true;
+	});
+}
+
+// Performs request with controller and waits for completion on the looper,
+// cache lookup, revalidation and store are done by the controller
+static bool runNetworkCacheTestRequest(event::Looper *looper, Controller *controller,
+		Request *req) {
+	bool completed = false;
+	bool success = false;
+	req->perform(controller, [&](const Request &, bool ok) {
+		completed = true;
+		success = ok;
+	});
+	return waitFor(looper, [&] { return completed; }) && success;
+}
+
+static Rc<Request> fetchNetworkCacheTestRequest(event::Looper *looper, Controller *controller,
+		const LocalHttpServer &server, StringView path, StringView lang = StringView()) {
+	auto req = makeNetworkCacheTestRequest(server, path, lang);
+	if (!runNetworkCacheTestRequest(looper, controller, req)) {
+		return nullptr;
+	}
+	return req;
+}
+
+static Rc<event::Looper> makeNetworkCacheTestLooper(StringView name) {
+	return event::Looper::acquire(event::LooperInfo{
+		.name = name,
+		.workersCount = 1,
+	});
+}
+
+static Rc<Controller> makeNetworkCacheTestController(event::Looper *looper) {
+	auto controller = Rc<Controller>::alloc(looper, "runtimetest");
+	controller->initialize(nullptr);
+	return controller;
+}
+
+static Rc<Cache> makeNetworkCacheTestCache(StringView path, size_t diskLimit,
+		size_t entriesLimit) {
+	if (!path.empty()) {
+		filesystem::remove(FileInfo{path, FileCategory::AppCache}, true);
+	}
+	return Rc<Cache>::create(CacheInfo{
+		.path = path.str<memory::StandartInterface>(),
+		.diskLimit = diskLimit,
+		.entriesLimit = entriesLimit,
+	});
+}
+
+static RuntimeTest s_networkCacheVary("network.cache.vary", RuntimeTest::Type::Test, [] {
+	StringView name("network.cache.vary");
+
+	LocalHttpServer server;
+	if (!expect(startNetworkCacheTestServer(server), name, "fail to start server")) {
+		return false;
+	}
+
+	auto looper = makeNetworkCacheTestLooper(name);
+	auto controller = makeNetworkCacheTestController(looper);
+
+	auto fetch = [&](StringView path, StringView lang = StringView()) {
+		return fetchNetworkCacheTestRequest(looper, controller, server, path, lang);
+	};
+
+	bool success = true;
+	for (auto path : {StringView(), StringView("runtimetest.network.cache.vary")}) {
+		auto cache = makeNetworkCacheTestCache(path, 64_MiB, 4'096);
+		controller->setCache(Rc<Cache>(cache));
+
+		auto en = fetch("/lang", "en");
+		auto fr = fetch("/lang", "fr");
+		if (!expect(en && fr, name, "fail to perform requests")) {
+			success = false;
+			break;
+		}
+
+		success &= expect(cache->getEntriesCount() == 2, name,
+				"variants are not stored separately");
+		success &= expect(cache->getStats().stores == 2 && cache->getStats().misses == 2, name,
+				"invalid stores count");
+
+		// only variant with matching header should be served from cache
+		auto requests = server.getRequestsCount();
+		auto enHit = fetch("/lang", "en");
+		success &= expect(enHit && enHit->isCachedResponse()
+						&& server.getRequestsCount() == requests,
+				name, "matching variant was not served from cache");
+		success &= expect(enHit && enHit->getData() == BytesView(StringView("lang:en")), name,
+				"other variant was served");
+		success &= expect(cache->getStats().hits == 1, name, "hit was not counted");
+
+		// "en , fr" and " en,   fr " are the same value after normalization
+		fetch("/lang", "en , fr");
+		auto list2 = fetch("/lang", " en,   fr ");
+		success &= expect(list2 && list2->isCachedResponse(), name,
+				"normalized values do not match");
+		success &= expect(cache->getEntriesCount() == 3, name,
+				"normalized values are stored twice");
+
+		// stale entry is revalidated with If-None-Match from the controller, and updated with 304
+		fetch("/stale");
+		auto stale2 = fetch("/stale");
+		success &= expect(stale2 && stale2->isCachedResponse()
+						&& stale2->getHandle().getResponseCode() == 200,
+				name, "stale entry was not revalidated");
+		success &= expect(stale2 && stale2->getData() == BytesView(StringView("stale")), name,
+				"invalid revalidated body");
+		success &= expect(cache->getStats().revalidations == 1, name,
+				"revalidation was not counted");
+
+		// body above memory limit is served from mapped file, or not stored without disk cache
+		auto large1 = fetch("/large");
+		requests = server.getRequestsCount();
+		auto large2 = fetch("/large");
+		success &= expect(large1 && large1->getData() == getNetworkCacheTestLargeBody(), name,
+				"invalid large body");
+		if (path.empty()) {
+			success &= expect(large2 && !large2->isCachedResponse()
+							&& server.getRequestsCount() == requests + 1,
+					name, "large body was stored in memory");
+		} else {
+			success &= expect(large2 && large2->isCachedResponse()
+							&& server.getRequestsCount() == requests,
+					name, "large body was not served from cache");
+			success &= expect(large2 && large2->getData() == getNetworkCacheTestLargeBody(), name,
+					"invalid mapped body");
+		}
+
+		if (!path.empty()) {
+			// vary names and entries are read back from disk by the new cache
+			controller->setCache(
+					Rc<Cache>::create(CacheInfo{.path = path.str<memory::StandartInterface>()}));
+			requests = server.getRequestsCount();
+			auto frHit = fetch("/lang", "fr");
+			success &= expect(frHit && frHit->isCachedResponse()
+							&& server.getRequestsCount() == requests,
+					name, "variant was not restored from disk");
+			success &= expect(frHit && frHit->getData() == BytesView(StringView("lang:fr")), name,
+					"invalid restored variant");
+			auto largeHit = fetch("/large");
+			success &= expect(largeHit && largeHit->isCachedResponse()
+							&& largeHit->getData() == getNetworkCacheTestLargeBody(),
+					name, "large body was not restored from disk");
+		}
+
+		controller->setCache(nullptr);
+		if (!path.empty()) {
+			filesystem::remove(FileInfo{path, FileCategory::AppCache}, true);
+		}
+	}
+
+	controller->invalidate(nullptr);
+	server.stop();
+	return success;
+});
+
+static RuntimeTest s_networkCacheLimits("network.cache.limits", RuntimeTest::Type::Test, [] {
+	StringView name("network.cache.limits");
+	static constexpr size_t RequestsCount = 64;
+
+	LocalHttpServer server;
+	if (!expect(startNetworkCacheTestServer(server), name, "fail to start server")) {
+		return false;
+	}
+
+	auto looper = makeNetworkCacheTestLooper(name);
+	auto controller = makeNetworkCacheTestController(looper);
+
+	bool success = true;
+
+	// 16 KiB bodies with 256 KiB disk limit and 8 entries in memory
+	StringView path("runtimetest.network.cache.limits");
+	auto cache = makeNetworkCacheTestCache(path, 256_KiB, 8);
+	controller->setCache(Rc<Cache>(cache));
+	for (size_t i = 0; i < RequestsCount; ++i) {
+		success &= expect(fetchNetworkCacheTestRequest(looper, controller, server,
+								  toString("/blob/", i)) != nullptr,
+				name, "fail to perform request");
+
+		success &= expect(cache->getEntriesCount() <= 8, name, "entries are not bounded");
+		success &= expect(cache->getDiskSize() <= 256_KiB, name, "disk size is not bounded");
+	}
+
+	success &= expect(cache->getStats().diskEvictions > 0, name, "no disk evictions");
+
+	// most recent entry is available, the oldest one is evicted from disk
+	auto last = fetchNetworkCacheTestRequest(looper, controller, server,
+			toString("/blob/", RequestsCount - 1));
+	success &= expect(last && last->isCachedResponse(), name, "recent entry was evicted");
+
+	auto first = fetchNetworkCacheTestRequest(looper, controller, server, "/blob/0");
+	success &= expect(first && !first->isCachedResponse(), name, "oldest entry was not evicted");
+
+	// disk usage is restored from files on init
+	auto diskSize = cache->getDiskSize();
+	auto cache2 = Rc<Cache>::create(CacheInfo{
+		.path = path.str<memory::StandartInterface>(),
+		.diskLimit = 256_KiB,
+	});
+	success &= expect(cache2->getDiskSize() == diskSize, name, "disk size was not restored");
+
+	controller->invalidate(nullptr);
+	filesystem::remove(FileInfo{path, FileCategory::AppCache}, true);
+	server.stop();
+	return success;
+});
+
+// Latency of fresh hits against full requests to local server, memory-only and with disk
+static RuntimeTest s_networkCacheBenchmark("network.cache.hit", RuntimeTest::Type::Benchmark,
+		[] {
+	StringView name("network.cache.hit");
+	static constexpr size_t RequestsCount = 256;
+
+	LocalHttpServer server;
+	if (!expect(startNetworkCacheTestServer(server), name, "fail to start server")) {
+		return false;
+	}
+
+	auto looper = makeNetworkCacheTestLooper(name);
+	auto controller = makeNetworkCacheTestController(looper);
+
+	bool success = true;
+	for (auto path : {StringView(), StringView("runtimetest.network.cache.hit")}) {
+		auto mode = path.empty() ? StringView("memory") : StringView("disk");
+		auto cache = makeNetworkCacheTestCache(path, 64_MiB, 4'096);
+		controller->setCache(Rc<Cache>(cache));
+
+		auto run = [&] {
+			auto start = Time::now();
+			for (size_t i = 0; i < RequestsCount; ++i) {
+				fetchNetworkCacheTestRequest(looper, controller, server, toString("/blob/", i));
+			}
+			return Time::now() - start;
+		};
+
+		auto miss = run();
+		auto hit = run();
+
+		reportBenchmark(name, toString(mode, " miss"),
+				double(miss.toMicros()) / double(RequestsCount), "us/request");
+		reportBenchmark(name, toString(mode, " hit"),
+				double(hit.toMicros()) / double(RequestsCount), "us/request");
+
+		success &= expect(cache->getStats().stores == RequestsCount
+						&& cache->getStats().hits == RequestsCount,
+				name, "responses were not stored");
+
+		controller->setCache(nullptr);
+		if (!path.empty()) {
+			filesystem::remove(FileInfo{path, FileCategory::AppCache}, true);
+		}
+		if (!success) {
+			break;
+		}
+	}
+
+	controller->invalidate(nullptr);
+	server.stop();
+	return success;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,168 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_CORE
+
+#include "XLCoreProfiler.h"
+#include "SPData.h"
+
+#include <thread>
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+namespace profiling = xenolith::profiling;
+
+static constexpr StringView ProfilerTestZoneA("profiler.test.a");
+static constexpr StringView ProfilerTestZoneB("profiler.test.b");
+
+static void runProfilerTestWriter(size_t count) {
+	profiling::setThreadName("profiler.test.writer");
+	for (size_t i = 0; i < count; ++i) {
+		auto t = profiling::now();
+		// fixed durations, so exported events can be verified
+		profiling::record((i % 2) ? ProfilerTestZoneA : ProfilerTestZoneB, "test", t, t + 1'000,
+				i);
+	}
+}
+
+// Validates exported JSON; returns number of zones from test writers
+static bool checkProfilerTestExport(StringView name, size_t &zones) {
+	mem_std::String out;
+	profiling::exportChromeTrace([&](StringView str) { out.append(str.data(), str.size()); });
+
+	auto val = data::read<memory::StandartInterface>(out);
+	if (!expect(val.isDictionary() && val.isArray("traceEvents"), name, "invalid trace JSON")) {
+		return false;
+	}
+
+	zones = 0;
+	bool success = true;
+	for (auto &it : val.getArray("traceEvents")) {
+		auto evName = it.getString("name");
+		if (evName == ProfilerTestZoneA || evName == ProfilerTestZoneB) {
+			// torn events would have mismatched names, durations or categories
+			success &= expect(it.getString("cat") == "test" && it.getString("ph") == "X"
+							&& it.getDouble("dur") == 1.0,
+					name, "torn event in export");
+			++zones;
+		}
+	}
+	return success;
+}
+
+static RuntimeTest s_profilerExport("profiler.export", RuntimeTest::Type::Test, [] {
+	StringView name("profiler.export");
+	static constexpr size_t ThreadsCount = 4;
+	static constexpr size_t ZonesCount = 200'000;
+
+	bool success = true;
+
+	profiling::setEnabled(true);
+	profiling::clear();
+
+	// thread, that was only named, should not allocate buffers nor appear in trace
+	std::thread([] { profiling::setThreadName("profiler.test.idle"); }).join();
+
+	mem_std::Vector<std::thread> threads;
+	for (size_t i = 0; i < ThreadsCount; ++i) {
+		threads.emplace_back([] { runProfilerTestWriter(ZonesCount); });
+	}
+
+	// export while writers overwrite their ring buffers
+	size_t zones = 0;
+	for (size_t i = 0; i < 8; ++i) { success &= checkProfilerTestExport(name, zones); }
+
+	for (auto &it : threads) { it.join(); }
+
+	success &= checkProfilerTestExport(name, zones);
+	success &= expect(zones > 0 && zones <= ThreadsCount * ZonesCount, name,
+			"invalid number of exported zones");
+
+	mem_std::String out;
+	profiling::exportChromeTrace([&](StringView str) { out.append(str.data(), str.size()); });
+	success &= expect(out.find("profiler.test.idle") == mem_std::String::npos, name,
+			"idle thread was registered");
+
+	// statistics from all writers are merged by name
+	uint64_t count = 0;
+	profiling::foreachZoneStats([&](const profiling::ZoneStats &stats) {
+		if (stats.name == ProfilerTestZoneA || stats.name == ProfilerTestZoneB) {
+			count += stats.count;
+			success &= expect(stats.min == 1'000 && stats.max == 1'000, name,
+					"invalid zone duration");
+		}
+	});
+	success &= expect(count == ThreadsCount * ZonesCount, name, "invalid merged zones count");
+
+	profiling::resetZoneStats();
+	count = 0;
+	profiling::foreachZoneStats([&](const profiling::ZoneStats &stats) { count += stats.count; });
+	success &= expect(count == 0, name, "statistics were not reset");
+
+	profiling::clear();
+	success &= checkProfilerTestExport(name, zones);
+	success &= expect(zones == 0, name, "events were not cleared");
+
+	profiling::setEnabled(false);
+	return success;
+});
+
+// Cost of the scoped zone with disabled and enabled profiler, with concurrent writers
+static RuntimeTest s_profilerRecord("profiler.record", RuntimeTest::Type::Benchmark, [] {
+	StringView name("profiler.record");
+	static constexpr size_t ZonesCount = 1'000'000;
+
+	auto run = [&](size_t threadsCount) {
+		auto start = Time::now();
+		mem_std::Vector<std::thread> threads;
+		for (size_t i = 0; i < threadsCount; ++i) {
+			threads.emplace_back([] {
+				for (size_t j = 0; j < ZonesCount; ++j) {
+					profiling::ScopedZone zone(ProfilerTestZoneA, "test", j);
+				}
+			});
+		}
+		for (auto &it : threads) { it.join(); }
+		return double((Time::now() - start).toMicros()) * 1'000.0 / double(ZonesCount);
+	};
+
+	for (auto threadsCount : {size_t(1), size_t(4)}) {
+		profiling::setEnabled(false);
+		reportBenchmark(name, toString("disabled, threads: ", threadsCount), run(threadsCount),
+				"ns/zone");
+
+		profiling::setEnabled(true);
+		reportBenchmark(name, toString("enabled, threads: ", threadsCount), run(threadsCount),
+				"ns/zone");
+	}
+
+	profiling::setEnabled(false);
+	profiling::clear();
+	return true;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,91 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+static RuntimeTest *s_firstTest = nullptr;
+
+uint32_t RuntimeTest::run(Type type, StringView filter) {
+	uint32_t failed = 0;
+	uint32_t performed = 0;
+
+	auto test = s_firstTest;
+	while (test) {
+		if (test->_type == type && (filter.empty()
+						|| std::string_view(test->_name.data(), test->_name.size())
+									.find(std::string_view(filter.data(), filter.size()))
+								!= std::string_view::npos)) {
+			std::cout << "[" << (type == Type::Test ? "test" : "bench") << "] " << test->_name
+					  << "\n";
+
+			auto start = Time::now();
+			auto success = test->_callback();
+			auto time = Time::now() - start;
+
+			std::cout << "[" << (success ? "ok" : "failed") << "] " << test->_name << " ("
+					  << time.toMillis() << "ms)\n";
+
+			if (!success) {
+				++failed;
+			}
+			++performed;
+		}
+		test = test->_next;
+	}
+
+	std::cout << "Performed: " << performed << ", failed: " << failed << "\n";
+	return failed;
+}
+
+RuntimeTest::RuntimeTest(StringView name, Type type, TestCallback cb)
+: _name(name), _type(type), _callback(cb) {
+	// tests are registered on static initialization, order is not important
+	_next = s_firstTest;
+	s_firstTest = this;
+}
+
+bool expect(bool condition, StringView test, StringView message) {
+	if (!condition) {
+		std::cout << "\t" << test << ": check failed: " << message << "\n";
+	}
+	return condition;
+}
+
+void reportBenchmark(StringView test, StringView metric, double value, StringView unit) {
+	std::cout << "\t" << test << ": " << metric << " = " << value << " " << unit << "\n";
+}
+
+bool waitFor(event::Looper *looper, const Callback<bool()> &cb, TimeInterval timeout) {
+	auto start = Time::now();
+	while (!cb()) {
+		if (Time::now() - start > timeout) {
+			return false;
+		}
+		looper->wait(TimeInterval::milliseconds(1));
+	}
+	return true;
+}
+
+} // namespace stappler::test
@@ -0,0 +1,76 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#ifndef TESTS_RUNTIME_SRC_RUNTIMETEST_H_
+#define TESTS_RUNTIME_SRC_RUNTIMETEST_H_
+
+#include "SPCommon.h"
+#include "SPTime.h"
+#include "SPEventLooper.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+/* Tests and benchmarks are registered with static RuntimeTest objects and selected by name
+ * from the command line:
+ *
+ * runtimetest test [filter]
+ * runtimetest bench [filter]
+ *
+ * Test returns false on failure, benchmark reports values with reportBenchmark
+ */
+class SP_PUBLIC RuntimeTest {
+public:
+	enum class Type {
+		Test,
+		Benchmark,
+	};
+
+	using TestCallback = bool (*)();
+
+	// Runs all registered tests of type, which names contains filter, returns number of failures
+	static uint32_t run(Type, StringView filter);
+
+	RuntimeTest(StringView name, Type, TestCallback);
+
+	StringView getName() const { return _name; }
+	Type getType() const { return _type; }
+
+protected:
+	StringView _name;
+	Type _type;
+	TestCallback _callback;
+	RuntimeTest *_next = nullptr;
+};
+
+// Logs failed check; returns value of condition
+SP_PUBLIC bool expect(bool condition, StringView test, StringView message);
+
+SP_PUBLIC void reportBenchmark(StringView test, StringView metric, double value, StringView unit);
+
+// Run looper on the current thread until condition is met; returns false on timeout
+SP_PUBLIC bool waitFor(event::Looper *, const Callback<bool()> &,
+		TimeInterval timeout = TimeInterval::seconds(10));
+
+} // namespace stappler::test
+
+#endif /* TESTS_RUNTIME_SRC_RUNTIMETEST_H_ */
@@ -0,0 +1,186 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_APPLICATION
+
+#include "XLScheduler.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+static UpdateTime makeSchedulerTime(uint64_t base, uint64_t ms) {
+	return UpdateTime{base + ms * 1'000, ms * 1'000, 16'000, 0.016f};
+}
+
+static RuntimeTest s_schedulerTimers("xenolith.scheduler.timers", RuntimeTest::Type::Test, [] {
+	StringView name("xenolith.scheduler.timers");
+	bool success = true;
+
+	auto scheduler = Rc<Scheduler>::create();
+	auto base = sp::platform::clock(ClockType::Monotonic);
+
+	// owner is notified about timers, scheduled outside of update
+	size_t notifications = 0;
+	uint64_t notifiedDeadline = 0;
+	scheduler->setTimerCallback([&](uint64_t deadline) {
+		++notifications;
+		notifiedDeadline = deadline;
+	});
+
+	size_t oneShot = 0;
+	size_t repeating = 0;
+	size_t cancelled = 0;
+	size_t nested = 0;
+
+	scheduler->scheduleTimer([&](const UpdateTime &) {
+		++oneShot;
+		// timers, scheduled from update, are not reported
+		scheduler->scheduleTimer([&](const UpdateTime &) { ++nested; }, nullptr,
+				TimeInterval::milliseconds(10));
+	}, nullptr, TimeInterval::milliseconds(100));
+	success &= expect(notifications == 1 && notifiedDeadline >= base + 99'000, name,
+			"owner is not notified about new timer");
+
+	uint64_t repeatingId = 0;
+	repeatingId = scheduler->scheduleTimer([&](const UpdateTime &) {
+		if (++repeating == 5) {
+			// timer cancels itself while it is detached from wheel
+			success &= expect(scheduler->cancelTimer(repeatingId), name,
+					"fail to cancel running timer");
+		}
+	}, nullptr, TimeInterval::milliseconds(20), TimeInterval::milliseconds(20));
+
+	auto cancelledId = scheduler->scheduleTimer([&](const UpdateTime &) { ++cancelled; }, nullptr,
+			TimeInterval::milliseconds(50));
+	success &= expect(scheduler->cancelTimer(cancelledId), name, "fail to cancel timer");
+	success &= expect(!scheduler->cancelTimer(cancelledId), name, "timer is cancelled twice");
+
+	// timers by target: paused target holds expired timers, unschedule cancels all of them
+	int targetA = 0;
+	int targetB = 0;
+	size_t firedA = 0;
+	size_t firedB = 0;
+	scheduler->schedulePerFrame([](const UpdateTime &) { }, &targetA, 0, true);
+	for (size_t i = 0; i < 100; ++i) {
+		scheduler->scheduleTimer([&](const UpdateTime &) { ++firedA; }, &targetA,
+				TimeInterval::milliseconds(30 + i));
+		scheduler->scheduleTimer([&](const UpdateTime &) { ++firedB; }, &targetB,
+				TimeInterval::milliseconds(30 + i));
+	}
+
+	notifications = 0;
+	for (uint64_t ms = 0; ms <= 300; ms += 16) {
+		scheduler->update(makeSchedulerTime(base, ms));
+		if (ms == 48) {
+			scheduler->unschedule(&targetB);
+		}
+	}
+
+	success &= expect(notifications == 0, name, "timer from update is reported");
+	success &= expect(oneShot == 1 && nested == 1, name, "one-shot timers are not fired");
+	success &= expect(repeating == 5, name, "repeating timer is not cancelled");
+	success &= expect(cancelled == 0, name, "cancelled timer is fired");
+	success &= expect(firedA == 0, name, "timer of paused target is fired");
+	success &= expect(firedB > 0 && firedB < 100, name, "timers are not cancelled by target");
+
+	scheduler->resume(&targetA);
+	scheduler->update(makeSchedulerTime(base, 320));
+	success &= expect(firedA == 100, name, "held timers are not fired on resume");
+	success &= expect(scheduler->getTimersCount() == 0, name, "timers are not released");
+	success &= expect(scheduler->getNextDeadline() == maxOf<uint64_t>(), name,
+			"deadline reported without timers");
+
+	scheduler->unscheduleAll();
+	return success;
+});
+
+// Per-frame update cost with 100k pending timers: timing wheel against per-frame callbacks,
+// that poll their deadlines, as components did before timers
+static RuntimeTest s_schedulerTimersBenchmark("xenolith.scheduler.timers",
+		RuntimeTest::Type::Benchmark, [] {
+	StringView name("xenolith.scheduler.timers");
+	static constexpr size_t TimersCount = 100'000;
+	static constexpr size_t FramesCount = 600;
+
+	auto base = sp::platform::clock(ClockType::Monotonic);
+
+	auto measure = [&](StringView metric, Scheduler *scheduler) {
+		auto start = Time::now();
+		for (size_t i = 0; i < FramesCount; ++i) {
+			scheduler->update(makeSchedulerTime(base, i * 16));
+		}
+		reportBenchmark(name, metric,
+				double((Time::now() - start).toMicros()) / double(FramesCount), "us/frame");
+	};
+
+	// deadlines within 10 minutes, so a few of them expire within the measured 10 seconds
+	uint32_t seed = 1;
+	Vector<uint64_t> delays;
+	delays.reserve(TimersCount);
+	for (size_t i = 0; i < TimersCount; ++i) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		delays.emplace_back(1'000 + (seed >> 8) % 600'000);
+	}
+
+	size_t fired = 0;
+
+	auto empty = Rc<Scheduler>::create();
+	measure("empty scheduler", empty);
+
+	auto timers = Rc<Scheduler>::create();
+	auto start = Time::now();
+	for (auto &it : delays) {
+		timers->scheduleTimer([&](const UpdateTime &) { ++fired; }, nullptr,
+				TimeInterval::milliseconds(it));
+	}
+	reportBenchmark(name, "schedule 100k timers",
+			double((Time::now() - start).toMicros()) / 1'000.0, "ms");
+	measure("100k timers", timers);
+
+	auto polling = Rc<Scheduler>::create();
+	for (size_t i = 0; i < TimersCount; ++i) {
+		auto deadline = base + delays[i] * 1'000;
+		polling->schedulePerFrame([&, deadline, done = false](const UpdateTime &time) mutable {
+			if (!done && time.global >= deadline) {
+				done = true;
+				++fired;
+			}
+		}, &delays[i], 0, false);
+	}
+	measure("100k polling callbacks", polling);
+
+	start = Time::now();
+	timers->unscheduleAll();
+	reportBenchmark(name, "cancel 100k timers",
+			double((Time::now() - start).toMicros()) / 1'000.0, "ms");
+
+	polling->unscheduleAll();
+	return fired > 0;
+});
+
+} // namespace stappler::test
+
+#endif
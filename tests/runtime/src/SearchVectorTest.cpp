@@ -0,0 +1,266 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_SEARCH
+
+#include "SPSearchConfiguration.h"
+#include "SPData.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_pool;
+
+static constexpr size_t SearchTestVocabulary = 4'096;
+
+static StringView getSearchTestWord(uint32_t idx) {
+	return StringView(toString("word", idx % SearchTestVocabulary)).pdup();
+}
+
+// Zipf-like distribution: small word indexes are more frequent
+static void makeSearchTestVector(search::SearchVector &vec, uint32_t &seed, size_t length) {
+	vec.documentLength = length;
+	for (size_t i = 0; i < length; ++i) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		auto r = float(seed >> 8) / float(1 << 24);
+		auto idx = uint32_t(r * r * r * SearchTestVocabulary);
+		auto rank = search::SearchData::Rank((seed >> 4) % 4 + 1);
+		vec.words[getSearchTestWord(idx)].emplace_back(i + 1, rank);
+	}
+}
+
+static Bytes makeLegacySearchTestBlob(const search::SearchVector &vec) {
+	Value dict;
+	for (auto &it : vec.words) {
+		auto &arr = dict.setValue(Value(Value::Type::ARRAY), it.first);
+		for (auto &m : it.second) {
+			arr.addInteger(int64_t(m.first));
+			arr.addInteger(toInt(m.second));
+		}
+	}
+
+	Value val;
+	val.addInteger(1);
+	val.addInteger(int64_t(vec.documentLength));
+	val.addValue(move(dict));
+	return data::write<Interface>(val,
+			data::EncodeFormat(data::EncodeFormat::Cbor, data::EncodeFormat::LZ4HCCompression));
+}
+
+static search::SearchQuery makeSearchTestQuery(SpanView<uint32_t> words, search::SearchOp op) {
+	search::SearchQuery q;
+	q.op = op;
+	for (auto &it : words) { q.args.emplace_back(search::SearchQuery(getSearchTestWord(it))); }
+	return q;
+}
+
+static RuntimeTest s_searchVectorFormat("search.vector.format", RuntimeTest::Type::Test, [] {
+	StringView name("search.vector.format");
+	bool success = true;
+
+	auto p = memory::pool::create(memory::pool::acquire());
+	perform([&] {
+		search::Configuration cfg;
+
+		// word ids like sqlite `__words`: hash32 in high bits with collision counter
+		search::SearchVectorView::WordIdMap ids;
+		auto getWordId = [&](StringView word) -> uint64_t {
+			auto id = uint64_t(hash32(word)) << 16;
+			ids.emplace(word, id);
+			return id;
+		};
+		search::SearchVectorView::WordIdCallback wordId(getWordId);
+
+		uint32_t seed = 0x5eed;
+		uint32_t queryWords[] = {1, 3, 7, 40};
+
+		for (size_t doc = 0; doc < 64; ++doc) {
+			search::SearchVector vec;
+			makeSearchTestVector(vec, seed, 32 + doc * 16);
+
+			auto hashed = search::SearchVectorView::encode(vec);
+			auto keyed = cfg.encodeSearchVectorData(vec, search::SearchData::Rank::Unknown,
+					&wordId);
+			auto legacy = makeLegacySearchTestBlob(vec);
+
+			success &= expect(!search::SearchVectorView::isCurrentFormat(hashed), name,
+					"hash-keyed blob should be migrated");
+			success &= expect(search::SearchVectorView::isCurrentFormat(keyed), name,
+					"id-keyed blob should be current");
+
+			// migration pass: legacy blob decoded and written again with ids
+			search::SearchVector migrated;
+			success &= expect(search::SearchVectorView::read(legacy, migrated), name,
+					"legacy blob should be readable");
+			success &= expect(migrated.documentLength == vec.documentLength
+							&& migrated.words.size() == vec.words.size(),
+					name, "migrated vector should match source");
+
+			// small vectors are stored as is, forced compression is still readable
+			auto forced = search::SearchVectorView::compress(Bytes(keyed), 0);
+			success &= expect(keyed.size() >= search::SearchVectorView::CompressionThreshold
+							|| !search::SearchVectorView(keyed).isCompressed(),
+					name, "small vector should not be compressed");
+
+			Bytes buffer;
+			search::SearchVectorView keyedView(keyed, &buffer);
+			keyedView.setWordIds(&ids);
+
+			Bytes forcedBuffer;
+			search::SearchVectorView forcedView(forced, &forcedBuffer);
+			forcedView.setWordIds(&ids);
+			success &= expect(forcedView.valid()
+							&& forcedView.getWordsCount() == keyedView.getWordsCount(),
+					name, "compressed vector should be readable");
+
+			for (auto op : {search::SearchOp::And, search::SearchOp::Or}) {
+				auto q = makeSearchTestQuery(queryWords, op);
+				auto expected = q.rankQuery(vec);
+
+				success &= expect(std::abs(q.rankQuery(BytesView(hashed)) - expected) < 1e-5f, name,
+						"hash-keyed rank mismatch");
+				success &= expect(std::abs(q.rankQuery(forcedView) - expected) < 1e-5f, name,
+						"compressed vector rank mismatch");
+				success &= expect(std::abs(q.rankQuery(keyedView) - expected) < 1e-5f, name,
+						"id-keyed rank mismatch");
+				success &= expect(std::abs(q.rankQuery(BytesView(keyed)) - expected) < 1e-5f, name,
+						"id-keyed rank without ids mismatch");
+				success &= expect(std::abs(q.rankQuery(BytesView(legacy)) - expected) < 1e-5f, name,
+						"legacy rank mismatch");
+				success &= expect(std::abs(q.rankQuery(migrated) - expected) < 1e-5f, name,
+						"migrated rank mismatch");
+
+				success &= expect(q.isMatch(keyedView) == q.isMatch(vec), name,
+						"id-keyed match mismatch");
+				success &= expect(q.isMatch(BytesView(legacy)) == q.isMatch(vec), name,
+						"legacy match mismatch");
+			}
+		}
+	}, p);
+	memory::pool::destroy(p);
+
+	return success;
+});
+
+// Ranks 100k documents with a 3-word query, like sp_ts_rank does for every row
+static RuntimeTest s_searchRank100k("search.rank.100k", RuntimeTest::Type::Benchmark, [] {
+	StringView name("search.rank.100k");
+	static constexpr size_t DocumentsCount = 100'000;
+
+	auto p = memory::pool::create(memory::pool::acquire());
+	perform([&] {
+		search::Configuration cfg;
+
+		search::SearchVectorView::WordIdMap ids;
+		auto getWordId = [&](StringView word) -> uint64_t {
+			auto id = uint64_t(hash32(word)) << 16;
+			ids.emplace(word, id);
+			return id;
+		};
+		search::SearchVectorView::WordIdCallback wordId(getWordId);
+
+		Vector<Bytes> legacy;
+		Vector<Bytes> plain;
+		Vector<Bytes> compressed;
+		Vector<Bytes> stored;
+		legacy.reserve(DocumentsCount);
+		plain.reserve(DocumentsCount);
+		compressed.reserve(DocumentsCount);
+		stored.reserve(DocumentsCount);
+
+		size_t legacySize = 0;
+		size_t plainSize = 0;
+		size_t compressedSize = 0;
+		size_t storedSize = 0;
+
+		uint32_t seed = 0xbe4c4;
+		for (size_t i = 0; i < DocumentsCount; ++i) {
+			auto tmp = memory::pool::create(p);
+			perform([&] {
+				search::SearchVector vec;
+				makeSearchTestVector(vec, seed, 64 + (seed >> 8) % 512);
+
+				auto &l = legacy.emplace_back(makeLegacySearchTestBlob(vec));
+				auto &b = plain.emplace_back(search::SearchVectorView::encode(vec,
+						search::SearchData::Rank::Unknown, &wordId));
+				auto &c = compressed.emplace_back(search::SearchVectorView::compress(Bytes(b), 0));
+
+				// what the storage writes: compressed only above the size threshold
+				auto &s = stored.emplace_back(cfg.encodeSearchVectorData(vec,
+						search::SearchData::Rank::Unknown, &wordId));
+
+				legacySize += l.size();
+				plainSize += b.size();
+				compressedSize += c.size();
+				storedSize += s.size();
+			}, tmp);
+			memory::pool::destroy(tmp);
+		}
+
+		uint32_t queryWords[] = {2, 11, 90};
+		auto q = makeSearchTestQuery(queryWords, search::SearchOp::And);
+
+		// ids are resolved once per query, like TextQueryData does
+		q.foreach ([&](StringView word, StringView) { getWordId(word); });
+
+		auto run = [&](StringView metric, const Vector<Bytes> &blobs, bool withIds) {
+			Bytes buffer;
+			float accum = 0.0f;
+			auto start = Time::now();
+			for (auto &it : blobs) {
+				search::SearchVectorView view(it, &buffer);
+				if (view.valid()) {
+					if (withIds) {
+						view.setWordIds(&ids);
+					}
+					accum += q.rankQuery(view);
+				} else {
+					accum += q.rankQuery(BytesView(it));
+				}
+			}
+			auto time = Time::now() - start;
+			reportBenchmark(name, metric, double(time.toMicros()) / 1000.0, "ms");
+			return accum;
+		};
+
+		auto r1 = run("legacy_cbor_lz4", legacy, false);
+		auto r2 = run("binary", plain, true);
+		auto r3 = run("binary_lz4", compressed, true);
+		auto r4 = run("binary_lz4_no_ids", compressed, false);
+		auto r5 = run("binary_stored", stored, true);
+
+		reportBenchmark(name, "legacy_size", double(legacySize) / 1024.0, "KiB");
+		reportBenchmark(name, "binary_size", double(plainSize) / 1024.0, "KiB");
+		reportBenchmark(name, "binary_lz4_size", double(compressedSize) / 1024.0, "KiB");
+		reportBenchmark(name, "binary_stored_size", double(storedSize) / 1024.0, "KiB");
+		reportBenchmark(name, "checksum", double(r1 + r2 + r3 + r4 + r5), "");
+	}, p);
+	memory::pool::destroy(p);
+
+	return true;
+});
+
+} // namespace stappler::test
+
+#endif
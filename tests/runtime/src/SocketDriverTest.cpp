@@ -0,0 +1,250 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_NETWORK && MODULE_STAPPLER_EVENT
+
+#include "SPNetworkSocketDriver.h"
+#include "LocalHttpServer.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+static size_t SocketDriverTest_write(char *ptr, size_t size, size_t nmemb, void *userdata) {
+	*reinterpret_cast<size_t *>(userdata) += size * nmemb;
+	return size * nmemb;
+}
+
+static CURL *makeSocketDriverTestHandle(StringView url, size_t *received) {
+	auto curl = curl_easy_init();
+	curl_easy_setopt(curl, CURLOPT_URL, url.data());
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &SocketDriverTest_write);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, received);
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+	return curl;
+}
+
+static bool startSocketDriverTestServer(LocalHttpServer &server, size_t bodySize) {
+	mem_std::Bytes body;
+	body.resize(bodySize);
+	for (size_t i = 0; i < bodySize; ++i) { body[i] = uint8_t(i * 31); }
+
+	return server.start([body = sp::move(body)](const LocalHttpServer::Request &) {
+		LocalHttpServer::Response resp;
+		resp.headers.emplace_back("Content-Type", "application/octet-stream");
+		resp.body = body;
+		return resp;
+	});
+}
+
+// Cancels the driver with transfers in flight and with connections cached by CURL:
+// curl_multi_cleanup closes cached connections and should not reach the released sockets
+static RuntimeTest s_socketDriverCancel("network.socket_driver.cancel", RuntimeTest::Type::Test,
+		[] {
+	StringView name("network.socket_driver.cancel");
+	static constexpr size_t TransfersCount = 8;
+
+	LocalHttpServer server;
+	if (!expect(startSocketDriverTestServer(server, 1 << 20), name, "fail to start server")) {
+		return false;
+	}
+
+	auto looper = event::Looper::acquire(event::LooperInfo{
+		.name = StringView("SocketDriverTest"),
+		.workersCount = 1,
+	});
+
+	auto url = server.getUrl("/data");
+	bool success = true;
+
+	for (auto inFlight : {false, true}) {
+		size_t completed = 0;
+		size_t received = 0;
+
+		auto driver = Rc<network::SocketDriver>::alloc();
+		success &= expect(driver->init(looper, [&](CURL *, CURLcode code) {
+			if (code == CURLE_OK) {
+				++completed;
+			}
+		}), name, "fail to init driver");
+
+		mem_std::Vector<CURL *> handles;
+		for (size_t i = 0; i < TransfersCount; ++i) {
+			handles.emplace_back(makeSocketDriverTestHandle(url, &received));
+			driver->addHandle(handles.back());
+		}
+
+		if (inFlight) {
+			waitFor(looper, [&] { return received > 0; });
+		} else {
+			success &= expect(waitFor(looper, [&] { return completed == TransfersCount; }), name,
+					"transfers were not completed");
+		}
+
+		for (auto &it : handles) { driver->removeHandle(it); }
+
+		driver->cancel();
+		driver = nullptr;
+
+		// pending socket events should not reach the released driver
+		looper->poll();
+
+		for (auto &it : handles) { curl_easy_cleanup(it); }
+	}
+
+	server.stop();
+	return success;
+});
+
+// Downloads of the same resource from a local server, all started at once
+static bool runSocketDriverDownloadBenchmark(StringView name, size_t count, size_t bodySize) {
+	LocalHttpServer server;
+	if (!expect(startSocketDriverTestServer(server, bodySize), name, "fail to start server")) {
+		return false;
+	}
+
+	auto looper = event::Looper::acquire(event::LooperInfo{
+		.name = StringView("SocketDriverBenchmark"),
+		.workersCount = 1,
+	});
+
+	auto url = server.getUrl("/data");
+
+	// latencies are measured from the start of the batch to completion of every handle
+	auto report = [&](StringView mode, TimeInterval time, mem_std::Vector<TimeInterval> &latency) {
+		reportBenchmark(name, toString(mode, " total"), double(time.toMicros()) / 1'000.0, "ms");
+		reportBenchmark(name, toString(mode, " throughput"),
+				double(count * bodySize) / double(1 << 20) / (double(time.toMicros()) / 1e6),
+				"MiB/s");
+
+		if (latency.empty()) {
+			return;
+		}
+
+		std::sort(latency.begin(), latency.end());
+
+		uint64_t sum = 0;
+		for (auto &it : latency) { sum += it.toMicros(); }
+
+		auto p99 = latency[std::min(latency.size() - 1, (latency.size() * 99 + 99) / 100 - 1)];
+		reportBenchmark(name, toString(mode, " latency (mean)"),
+				double(sum) / double(latency.size()) / 1'000.0, "ms");
+		reportBenchmark(name, toString(mode, " latency (p99)"), double(p99.toMicros()) / 1'000.0,
+				"ms");
+	};
+
+	// looper-driven multi-socket transfers
+	do {
+		size_t completed = 0;
+		size_t received = 0;
+		mem_std::Vector<TimeInterval> latency;
+		latency.reserve(count);
+
+		auto start = Time::now();
+		auto driver = Rc<network::SocketDriver>::alloc();
+		driver->init(looper, [&](CURL *, CURLcode code) {
+			latency.emplace_back(Time::now() - start);
+			++completed;
+		});
+
+		mem_std::Vector<CURL *> handles;
+		start = Time::now();
+		for (size_t i = 0; i < count; ++i) {
+			handles.emplace_back(makeSocketDriverTestHandle(url, &received));
+			driver->addHandle(handles.back());
+		}
+
+		auto finished = waitFor(looper, [&] { return completed == count; },
+				TimeInterval::seconds(60));
+		auto time = Time::now() - start;
+
+		driver->cancel();
+		for (auto &it : handles) { curl_easy_cleanup(it); }
+
+		if (!expect(finished && received == count * bodySize, name, "driver transfers failed")) {
+			return false;
+		}
+		report("socket_driver", time, latency);
+	} while (0);
+
+	// curl_multi_poll loop on the calling thread, as the former polling thread did
+	do {
+		size_t received = 0;
+		mem_std::Vector<TimeInterval> latency;
+		latency.reserve(count);
+
+		auto multi = curl_multi_init();
+		mem_std::Vector<CURL *> handles;
+		auto start = Time::now();
+		for (size_t i = 0; i < count; ++i) {
+			handles.emplace_back(makeSocketDriverTestHandle(url, &received));
+			curl_multi_add_handle(multi, handles.back());
+		}
+
+		int running = 1;
+		while (running > 0) {
+			curl_multi_perform(multi, &running);
+
+			int queued = 0;
+			while (auto msg = curl_multi_info_read(multi, &queued)) {
+				if (msg->msg == CURLMSG_DONE) {
+					latency.emplace_back(Time::now() - start);
+				}
+			}
+
+			if (running > 0) {
+				curl_multi_poll(multi, nullptr, 0, 100, nullptr);
+			}
+		}
+		auto time = Time::now() - start;
+
+		for (auto &it : handles) {
+			curl_multi_remove_handle(multi, it);
+			curl_easy_cleanup(it);
+		}
+		curl_multi_cleanup(multi);
+
+		if (!expect(received == count * bodySize, name, "poll transfers failed")) {
+			return false;
+		}
+		report("multi_poll", time, latency);
+	} while (0);
+
+	reportBenchmark(name, "requests", double(server.getRequestsCount()), "");
+	server.stop();
+	return true;
+}
+
+static RuntimeTest s_socketDriverDownload64("network.socket_driver.download.64",
+		RuntimeTest::Type::Benchmark, [] {
+	return runSocketDriverDownloadBenchmark("network.socket_driver.download.64", 64, 256 * 1'024);
+});
+
+static RuntimeTest s_socketDriverDownload512("network.socket_driver.download.512",
+		RuntimeTest::Type::Benchmark, [] {
+	return runSocketDriverDownloadBenchmark("network.socket_driver.download.512", 512, 16 * 1'024);
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,256 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_APPLICATION
+
+#include "XLNode.h"
+#include "XLTransformTree.h"
+
+#include <thread>
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+// root -> rows -> items
+static Rc<Node> makeTransformTreeScene(uint32_t rows, uint32_t items, Vector<Node *> &rowNodes) {
+	auto root = Rc<Node>::create();
+	for (uint32_t i = 0; i < rows; ++i) {
+		auto row = root->addChild(Rc<Node>::create());
+		row->setPosition(Vec2(0.0f, float(i) * 10.0f));
+		rowNodes.emplace_back(row);
+		for (uint32_t j = 0; j < items; ++j) {
+			auto item = row->addChild(Rc<Node>::create());
+			item->setPosition(Vec2(float(j) * 10.0f, 0.0f));
+		}
+	}
+	return root;
+}
+
+static void visitTransformTreeBaseline(Node *node, const Mat4 &parent, Mat4 &out) {
+	auto t = parent * node->getNodeToParentTransform();
+	for (auto &it : node->getChildren()) { visitTransformTreeBaseline(it, t, out); }
+	out = t;
+}
+
+static RuntimeTest s_transformTreeMembership("xenolith.transform_tree.membership",
+		RuntimeTest::Type::Test, [] {
+	StringView name("xenolith.transform_tree.membership");
+
+	auto root = Rc<Node>::create();
+	root->setTransformTreeEnabled(true);
+
+	auto child = root->addChild(Rc<Node>::create());
+	child->setPosition(Vec2(10.0f, 20.0f));
+
+	Mat4 world;
+	auto tree = root->getTransformTree();
+	if (!expect(tree->getNodeToWorldTransform(child, world), name, "child is not in tree")
+			|| !expect(child->getTransformTree() == tree, name, "child is not a tree member")) {
+		return false;
+	}
+
+	// structural change should release membership immediately, not on next rebuild
+	root->addChild(Rc<Node>::create());
+	if (!expect(child->getTransformTree() == nullptr, name,
+				"membership was not reset on invalidate")) {
+		return false;
+	}
+
+	// membership restored on rebuild
+	tree->getNodeToWorldTransform(child, world);
+	if (!expect(child->getTransformTree() == tree, name, "membership was not restored")) {
+		return false;
+	}
+
+	Rc<Node> detached = child;
+	child->removeFromParent();
+
+	root->setTransformTreeEnabled(false);
+	root = nullptr;
+
+	// should not touch the released tree
+	detached->setPosition(Vec2(0.0f, 0.0f));
+	return expect(detached->getTransformTree() == nullptr, name, "detached node still in tree");
+});
+
+// recursive parent chain product, as Node does without TransformTree
+static Mat4 getTransformTreeReference(const Node *node) {
+	Mat4 t(node->getNodeToParentTransform());
+	for (Node *p = node->getParent(); p != nullptr; p = p->getParent()) {
+		t = p->getNodeToParentTransform() * t;
+	}
+	return t;
+}
+
+static void collectTransformTreeNodes(Node *node, Vector<Node *> &out) {
+	out.emplace_back(node);
+	for (auto &it : node->getChildren()) { collectTransformTreeNodes(it, out); }
+}
+
+static bool compareTransformTree(StringView name, StringView stage, Node *root) {
+	static constexpr float Epsilon = 1.0e-3f;
+
+	Vector<Node *> nodes;
+	collectTransformTreeNodes(root, nodes);
+
+	auto tree = root->getTransformTree();
+	for (auto node : nodes) {
+		Mat4 world;
+		if (!tree->getNodeToWorldTransform(node, world)) {
+			return expect(false, name, toString(stage, ": node is not in tree"));
+		}
+
+		auto ref = getTransformTreeReference(node);
+		for (size_t i = 0; i < 16; ++i) {
+			if (std::abs(world.m[i] - ref.m[i]) > Epsilon * std::max(1.0f, std::abs(ref.m[i]))) {
+				return expect(false, name,
+						toString(stage, ": world transform mismatch: ", world, " ", ref));
+			}
+		}
+	}
+	return true;
+}
+
+static RuntimeTest s_transformTreeWorld("xenolith.transform_tree.world", RuntimeTest::Type::Test,
+		[] {
+	StringView name("xenolith.transform_tree.world");
+
+	auto outer = Rc<Node>::create();
+	outer->setPosition(Vec2(5.0f, -7.0f));
+	outer->setScale(2.0f);
+
+	Vector<Node *> rowNodes;
+	auto root = outer->addChild(makeTransformTreeScene(16, 16, rowNodes));
+	root->setRotation(0.3f);
+	for (size_t i = 0; i < rowNodes.size(); ++i) {
+		auto items = rowNodes[i]->getChildren();
+		for (size_t j = 0; j < items.size(); j += 3) {
+			auto leaf = items[j]->addChild(Rc<Node>::create());
+			leaf->setPosition(Vec2(1.0f, 2.0f));
+			leaf->setRotation(float(j) * 0.1f);
+		}
+	}
+
+	root->setTransformTreeEnabled(true);
+
+	bool success = compareTransformTree(name, "initial", root);
+
+	// partial dirtying: one row, one item and one leaf
+	rowNodes[3]->setRotation(-0.5f);
+	rowNodes[5]->getChildren()[2]->setScale(Vec2(1.5f, 0.5f));
+	rowNodes[7]->getChildren()[0]->getChildren()[0]->setPosition(Vec2(-3.0f, 4.0f));
+	success &= compareTransformTree(name, "partial", root);
+
+	// root's parent changed
+	outer->setPosition(Vec2(11.0f, 13.0f));
+	success &= compareTransformTree(name, "parent", root);
+
+	// reparenting: item with leaf moved into other row
+	Rc<Node> moved = rowNodes[0]->getChildren()[0];
+	moved->removeFromParent();
+	rowNodes[9]->addChild(moved);
+	moved->setPosition(Vec2(100.0f, 0.0f));
+	success &= compareTransformTree(name, "reparent", root);
+
+	// parallel branch update with the threads, spawned by dispatch
+	Vector<std::thread> threads;
+	TransformTree::ParallelInfo info;
+	info.threshold = 16;
+	info.threadCount = 4;
+	info.dispatch = [&](Function<void()> &&fn) { threads.emplace_back(sp::move(fn)); };
+	root->getTransformTree()->setParallelInfo(sp::move(info));
+
+	auto tree = root->getTransformTree();
+	for (uint32_t i = 0; i < 4; ++i) {
+		for (size_t j = i; j < rowNodes.size(); j += 4) {
+			rowNodes[j]->setPosition(Vec2(float(i), float(j) * 10.0f));
+		}
+		outer->setRotation(float(i) * 0.2f);
+		tree->update(outer->getNodeToWorldTransform());
+		success &= compareTransformTree(name, toString("parallel ", i), root);
+	}
+
+	for (auto &it : threads) { it.join(); }
+	success &= expect(!threads.empty(), name, "parallel update was not dispatched");
+
+	root->setTransformTreeEnabled(false);
+	return success;
+});
+
+static bool runTransformTreeBenchmark(StringView name, uint32_t rows, uint32_t items) {
+	static constexpr uint32_t Iterations = 100;
+
+	Vector<Node *> rowNodes;
+	auto root = makeTransformTreeScene(rows, items, rowNodes);
+	root->setTransformTreeEnabled(true);
+
+	auto tree = root->getTransformTree();
+	tree->update(Mat4::IDENTITY);
+
+	// one row changed per update
+	auto t = Time::now();
+	for (uint32_t i = 0; i < Iterations; ++i) {
+		rowNodes[i % rowNodes.size()]->setPosition(Vec2(float(i), float(i % rows) * 10.0f));
+		tree->update(Mat4::IDENTITY);
+	}
+	auto subtreeTime = (Time::now() - t).toMicros();
+
+	// root's parent changed, whole tree should be updated
+	t = Time::now();
+	for (uint32_t i = 0; i < Iterations; ++i) {
+		Mat4 parent;
+		Mat4::createTranslation(float(i + 1), 0.0f, 0.0f, &parent);
+		tree->update(parent);
+	}
+	auto fullTime = (Time::now() - t).toMicros();
+
+	// recursive parent * local for every node, as visit without TransformTree does
+	Mat4 out;
+	t = Time::now();
+	for (uint32_t i = 0; i < Iterations; ++i) {
+		visitTransformTreeBaseline(root, Mat4::IDENTITY, out);
+	}
+	auto baselineTime = (Time::now() - t).toMicros();
+
+	reportBenchmark(name, "nodes", tree->size(), "");
+	reportBenchmark(name, "subtree update (one row)", double(subtreeTime) / Iterations, "us");
+	reportBenchmark(name, "full update", double(fullTime) / Iterations, "us");
+	reportBenchmark(name, "recursive visit (no tree)", double(baselineTime) / Iterations, "us");
+
+	root->setTransformTreeEnabled(false);
+	return true;
+}
+
+static RuntimeTest s_transformTree10k("xenolith.transform_tree.10k", RuntimeTest::Type::Benchmark,
+		[] { return runTransformTreeBenchmark("xenolith.transform_tree.10k", 100, 100); });
+
+static RuntimeTest s_transformTree100k("xenolith.transform_tree.100k",
+		RuntimeTest::Type::Benchmark,
+		[] { return runTransformTreeBenchmark("xenolith.transform_tree.100k", 100, 1'000); });
+
+} // namespace stappler::test
+
+#endif
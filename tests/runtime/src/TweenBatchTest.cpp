@@ -0,0 +1,143 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_XENOLITH_APPLICATION
+
+#include "XLNode.h"
+#include "XLAction.h"
+#include "XLActionEase.h"
+#include "XLActionManager.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace xenolith;
+
+static UpdateTime makeTweenBatchTime(float dt) {
+	return UpdateTime{0, 0, uint64_t(dt * 1'000'000.0f), dt};
+}
+
+static Vec3 getTweenBatchTarget(size_t i) {
+	return Vec3(float(i % 100) * 10.0f, float(i / 100) * 10.0f, 0.0f);
+}
+
+static RuntimeTest s_tweenBatch("xenolith.tween_batch", RuntimeTest::Type::Test, [] {
+	StringView name("xenolith.tween_batch");
+	static constexpr size_t NodesCount = 256;
+
+	bool success = true;
+
+	// tweens should follow the same curve as MoveTo/EaseActionTyped
+	auto manager = Rc<ActionManager>::create();
+	Vector<Rc<Node>> actionNodes;
+	Vector<Rc<Node>> tweenNodes;
+	for (size_t i = 0; i < NodesCount; ++i) {
+		auto type = (i % 2) ? interpolation::QuadEaseInOut : interpolation::Linear;
+		auto target = getTweenBatchTarget(i);
+
+		auto a = actionNodes.emplace_back(Rc<Node>::create());
+		Rc<ActionInterval> action = Rc<MoveTo>::create(1.0f, target);
+		if (type != interpolation::Linear) {
+			action = Rc<EaseActionTyped>::create(action, type);
+		}
+		manager->addAction(action, a, false);
+
+		auto t = tweenNodes.emplace_back(Rc<Node>::create());
+		success &= expect(manager->addTween(t, TweenProperty::Position, 1.0f, target, type), name,
+				"fail to add tween");
+	}
+
+	for (size_t step = 0; step < 70; ++step) {
+		manager->update(makeTweenBatchTime(1.0f / 60.0f));
+		for (size_t i = 0; i < NodesCount; ++i) {
+			auto diff = actionNodes[i]->getPosition() - tweenNodes[i]->getPosition();
+			if (!expect(diff.length() < 1e-3f, name,
+						toString("tween diverged from action on step ", step))) {
+				return false;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < NodesCount; ++i) {
+		success &= expect(tweenNodes[i]->getPosition() == getTweenBatchTarget(i), name,
+				"tween did not reach the target");
+	}
+	success &= expect(manager->getNumberOfRunningTweensInTarget(tweenNodes.back()) == 0, name,
+			"finished tweens are not removed");
+
+	// NaN components keep current value, as Node::runTween with Vec2 position does
+	auto node = Rc<Node>::create();
+	node->setPositionZ(5.0f);
+	success &= expect(manager->addTween(node, TweenProperty::Position, 0.5f,
+							  Vec3(1.0f, 2.0f, nan())),
+			name, "fail to add tween");
+	for (size_t step = 0; step < 40; ++step) { manager->update(makeTweenBatchTime(1.0f / 60.0f)); }
+	success &= expect(node->getPosition() == Vec3(1.0f, 2.0f, 5.0f), name,
+			"NaN component is not preserved");
+
+	return success;
+});
+
+// Per-frame update of 10k moving nodes: MoveTo actions against batched tweens
+static RuntimeTest s_tweenBatchBenchmark("xenolith.tween_batch", RuntimeTest::Type::Benchmark, [] {
+	StringView name("xenolith.tween_batch");
+	static constexpr size_t NodesCount = 10'000;
+	static constexpr size_t FramesCount = 120;
+
+	auto measure = [&](StringView metric, interpolation::Type type, bool tweens) {
+		auto manager = Rc<ActionManager>::create();
+		Vector<Rc<Node>> nodes;
+		nodes.reserve(NodesCount);
+		for (size_t i = 0; i < NodesCount; ++i) {
+			auto node = nodes.emplace_back(Rc<Node>::create());
+			auto target = getTweenBatchTarget(i);
+			if (tweens) {
+				manager->addTween(node, TweenProperty::Position, 2.0f, target, type);
+			} else {
+				Rc<ActionInterval> action = Rc<MoveTo>::create(2.0f, target);
+				if (type != interpolation::Linear) {
+					action = Rc<EaseActionTyped>::create(action, type);
+				}
+				manager->addAction(action, node, false);
+			}
+		}
+
+		auto start = Time::now();
+		for (size_t i = 0; i < FramesCount; ++i) {
+			manager->update(makeTweenBatchTime(1.0f / 60.0f));
+		}
+		auto time = double((Time::now() - start).toMicros()) / double(FramesCount);
+		reportBenchmark(name, metric, time, "us/frame");
+	};
+
+	measure("MoveTo, linear", interpolation::Linear, false);
+	measure("tween, linear", interpolation::Linear, true);
+	measure("MoveTo + ease, QuadEaseInOut", interpolation::QuadEaseInOut, false);
+	measure("tween, QuadEaseInOut", interpolation::QuadEaseInOut, true);
+	return true;
+});
+
+} // namespace stappler::test
+
+#endif
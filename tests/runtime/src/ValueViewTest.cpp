@@ -0,0 +1,202 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_DATA
+
+#include "SPDataValueView.h"
+#include "SPData.h"
+
+#include <thread>
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+static Value makeValueViewTestValue(uint32_t &seed, uint32_t depth) {
+	seed = seed * 1'664'525 + 1'013'904'223;
+	auto type = (depth > 3) ? (seed >> 16) % 6 : (seed >> 16) % 8;
+	switch (type) {
+	case 0: return Value(int64_t(seed >> 4));
+	case 1: return Value(-int64_t(seed >> 2));
+	case 2: return Value(double(seed) / 7.0);
+	case 3: return Value((seed & 1) != 0);
+	case 4: return Value(toString("str", seed));
+	case 5: return Value(Bytes{uint8_t(seed), uint8_t(seed >> 8), uint8_t(seed >> 16)});
+	case 6: {
+		Value ret(Value::Type::ARRAY);
+		for (size_t i = 0; i < (seed >> 8) % 8; ++i) {
+			ret.addValue(makeValueViewTestValue(seed, depth + 1));
+		}
+		return ret;
+	}
+	default: {
+		Value ret(Value::Type::DICTIONARY);
+		for (size_t i = 0; i < (seed >> 8) % 8; ++i) {
+			ret.setValue(makeValueViewTestValue(seed, depth + 1), toString("key", i * 3));
+		}
+		return ret;
+	}
+	}
+}
+
+static bool checkValueView(const data::ValueView &view, const Value &val) {
+	if (view.getType() != val.getType()) {
+		return false;
+	}
+
+	switch (val.getType()) {
+	case Value::Type::INTEGER: return view.getInteger() == val.getInteger();
+	case Value::Type::DOUBLE: return view.getDouble() == val.getDouble();
+	case Value::Type::BOOLEAN: return view.getBool() == val.getBool();
+	case Value::Type::CHARSTRING: return view.getString() == StringView(val.getString());
+	case Value::Type::BYTESTRING: return view.getBytes() == BytesView(val.getBytes());
+	case Value::Type::ARRAY:
+		if (view.size() != val.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < val.size(); ++i) {
+			if (!checkValueView(view.getValue(i), val.getValue(i))) {
+				return false;
+			}
+		}
+		return true;
+	case Value::Type::DICTIONARY:
+		if (view.size() != val.size()) {
+			return false;
+		}
+		for (auto &it : val.asDict()) {
+			if (!checkValueView(view.getValue(StringView(it.first)), it.second)) {
+				return false;
+			}
+		}
+		return !view.hasValue("missing");
+	default: break;
+	}
+	return true;
+}
+
+static RuntimeTest s_valueView("data.value_view", RuntimeTest::Type::Test, [] {
+	StringView name("data.value_view");
+	bool success = true;
+
+	uint32_t seed = 1;
+	for (size_t i = 0; i < 256; ++i) {
+		Value val(Value::Type::DICTIONARY);
+		for (size_t j = 0; j < 16; ++j) {
+			val.setValue(makeValueViewTestValue(seed, 0), toString("field", j));
+		}
+
+		auto data = data::write<Interface>(val, data::EncodeFormat::Cbor);
+		auto view = data::ValueView::read(data);
+		success &= expect(checkValueView(view, val), name, "view does not match value");
+		success &= expect(view.toValue<Interface>() == val, name, "invalid decoded value");
+	}
+
+	// index is built once and shared by concurrent readers of the same view
+	Value dict(Value::Type::DICTIONARY);
+	for (size_t i = 0; i < 1'000; ++i) { dict.setInteger(int64_t(i), toString("key", i)); }
+	auto data = data::write<Interface>(dict, data::EncodeFormat::Cbor);
+
+	for (size_t n = 0; n < 16; ++n) {
+		const auto view = data::ValueView::read(data);
+		std::atomic<size_t> errors = 0;
+		Vector<std::thread> threads;
+		for (size_t t = 0; t < 4; ++t) {
+			threads.emplace_back([&] {
+				for (size_t i = 0; i < 1'000; ++i) {
+					if (view.getValue(StringView(toString("key", i))).getInteger(-1)
+							!= int64_t(i)) {
+						++errors;
+					}
+				}
+			});
+		}
+		for (auto &it : threads) { it.join(); }
+		success &= expect(errors == 0, name, "concurrent lookup failed");
+	}
+
+	// offsets are 32-bit, so larger buffers are rejected without reading them
+	success &= expect(!data::ValueView::read(BytesView(data.data(), (size_t(1) << 32) + 1)), name,
+			"buffer over 4 GiB was accepted");
+
+	return success;
+});
+
+// Decoding of 100k records into Value against access in place with ValueView
+static RuntimeTest s_valueViewBenchmark("data.value_view", RuntimeTest::Type::Benchmark, [] {
+	StringView name("data.value_view");
+	static constexpr size_t RecordsCount = 100'000;
+
+	Value val(Value::Type::ARRAY);
+	for (size_t i = 0; i < RecordsCount; ++i) {
+		auto &record = val.emplace();
+		record.setInteger(int64_t(i), "id");
+		record.setString(toString("record name ", i), "name");
+		record.setDouble(double(i) / 3.0, "score");
+		auto &tags = record.emplace("tags");
+		for (size_t j = 0; j < 4; ++j) { tags.addString(toString("tag", (i + j) % 64)); }
+	}
+
+	auto data = data::write<Interface>(val, data::EncodeFormat::Cbor);
+	reportBenchmark(name, "encoded size", double(data.size()) / double(1 << 20), "MiB");
+
+	auto measure = [&](StringView metric, const Callback<double()> &cb) {
+		auto start = Time::now();
+		auto sum = cb();
+		reportBenchmark(name, metric, double((Time::now() - start).toMicros()) / 1'000.0, "ms");
+		return sum;
+	};
+
+	auto s1 = measure("decode + sum scores", [&] {
+		double sum = 0.0;
+		auto decoded = data::read<Interface>(data);
+		for (auto &it : decoded.asArray()) { sum += it.getDouble("score"); }
+		return sum;
+	});
+
+	auto s2 = measure("view + sum scores", [&] {
+		double sum = 0.0;
+		auto view = data::ValueView::read(data);
+		view.foreach([&](const data::ValueView &it) { sum += it.getValue("score").getDouble(); });
+		return sum;
+	});
+
+	auto s3 = measure("view + 10k random records", [&] {
+		double sum = 0.0;
+		uint32_t seed = 1;
+		auto view = data::ValueView::read(data);
+		for (size_t i = 0; i < 10'000; ++i) {
+			seed = seed * 1'664'525 + 1'013'904'223;
+			sum += view.getValue(seed % RecordsCount).getValue("score").getDouble();
+		}
+		return sum;
+	});
+
+	return expect(s1 == s2 && s3 > 0.0, name, "invalid sums");
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,224 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_VG && MODULE_STAPPLER_FILESYSTEM
+
+#include "SPVectorImage.h"
+#include "SPFilesystem.h"
+
+#include <random>
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+// Marker value to find path entry in binary data
+static constexpr float BinaryImageStrokeWidth = 1'234.5f;
+
+static String makeBinaryImageSvg(size_t pathsCount) {
+	std::mt19937 rnd(0x5EED);
+	StringStream out;
+	out << R"(<svg width="1024" height="1024" viewBox="0 0 1024 1024">)";
+	for (size_t i = 0; i < pathsCount; ++i) {
+		out << R"(<path id="p)" << i << R"(" d="M)" << rnd() % 1'024 << "," << rnd() % 1'024;
+		for (size_t j = 0; j < 32; ++j) {
+			out << " C" << rnd() % 1'024 << "," << rnd() % 1'024 << " " << rnd() % 1'024 << ","
+				<< rnd() % 1'024 << " " << rnd() % 1'024 << "," << rnd() % 1'024 << " Q"
+				<< rnd() % 1'024 << "," << rnd() % 1'024 << " " << rnd() % 1'024 << ","
+				<< rnd() % 1'024 << " A20,10 30 0 1 " << rnd() % 1'024 << "," << rnd() % 1'024;
+		}
+		out << R"( Z" fill="#)" << std::hex << rnd() % 0xFF'FFFF << std::dec
+			<< R"(" stroke="black" stroke-width=")" << BinaryImageStrokeWidth
+			<< R"(" stroke-linejoin="round"/>)";
+	}
+	out << "</svg>";
+	return out.str();
+}
+
+static bool isEqualBinaryImagePath(const vg::VectorPath &a, const vg::VectorPath &b) {
+	auto ac = a.getCommands();
+	auto bc = b.getCommands();
+	auto ap = a.getPoints();
+	auto bp = b.getPoints();
+	return ac.size() == bc.size() && ap.size() == bp.size()
+			&& memcmp(ac.data(), bc.data(), ac.size() * sizeof(vg::Command)) == 0
+			&& memcmp(ap.data(), bp.data(), ap.size() * sizeof(vg::CommandData)) == 0
+			&& a.getStyle() == b.getStyle() && a.getStrokeWidth() == b.getStrokeWidth()
+			&& a.getFillColor() == b.getFillColor() && a.getLineJoin() == b.getLineJoin()
+			&& a.getWindingRule() == b.getWindingRule() && a.getTransform() == b.getTransform();
+}
+
+static bool isEqualBinaryImage(const vg::VectorImage &a, const vg::VectorImage &b) {
+	auto &ap = a.getPaths();
+	auto &bp = b.getPaths();
+	if (ap.size() != bp.size()) {
+		return false;
+	}
+	for (auto &it : ap) {
+		auto iit = bp.find(it.first);
+		if (iit == bp.end()
+				|| !isEqualBinaryImagePath(*it.second->getPath(), *iit->second->getPath())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Overwrite uint32 value at offset from marker in every path entry
+static Bytes makeInvalidBinaryImage(const Bytes &source, int32_t offset, uint32_t value) {
+	Bytes ret(source);
+	for (size_t i = 0; i + sizeof(float) <= ret.size(); ++i) {
+		if (memcmp(ret.data() + i, &BinaryImageStrokeWidth, sizeof(float)) == 0) {
+			memcpy(ret.data() + i + offset, &value, sizeof(uint32_t));
+		}
+	}
+	return ret;
+}
+
+static RuntimeTest s_vgBinaryImage("vg.binary_image", RuntimeTest::Type::Test, [] {
+	StringView name("vg.binary_image");
+
+	bool success = true;
+	auto path = filesystem::findPath<Interface>(
+			FileInfo{"binary-image-test.spvi", FileCategory::AppCache});
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+
+	auto svg = makeBinaryImageSvg(16);
+	auto source = Rc<vg::VectorImage>::create(StringView(svg));
+	if (!expect(source != nullptr, name, "fail to read SVG")) {
+		return false;
+	}
+
+	auto binary = source->encode();
+	success &= expect(vg::VectorImage::isBinary(binary), name, "invalid binary image");
+	success &= expect(filesystem::write(FileInfo{path}, BytesView(binary)), name,
+			"fail to write binary image");
+
+	// from bytes: data is copied into paths
+	auto copied = Rc<vg::VectorImage>::create(BytesView(binary));
+	success &= expect(copied && isEqualBinaryImage(*source, *copied), name,
+			"image from bytes differs from source");
+	if (copied) {
+		for (auto &it : copied->getPaths()) {
+			success &= expect(!it.second->getPath()->hasExternalStorage(), name,
+					"path from bytes references external storage");
+		}
+	}
+
+	// from file: paths reference mapped file
+	auto mapped = Rc<vg::VectorImage>::create(FileInfo{path});
+	success &= expect(mapped && isEqualBinaryImage(*source, *mapped), name,
+			"image from file differs from source");
+	if (mapped && !mapped->getPaths().empty()) {
+		for (auto &it : mapped->getPaths()) {
+			success &= expect(it.second->getPath()->hasExternalStorage(), name,
+					"path from file does not reference mapped storage");
+		}
+
+		// modification copies data from storage into path
+		auto &ref = mapped->getPaths().begin()->second;
+		vg::VectorPath copy(*ref->getPath());
+		auto commandsCount = copy.commandsCount();
+		copy.openForWriting([](vg::PathWriter &writer) { writer.lineTo(1.0f, 1.0f); });
+
+		success &= expect(!copy.hasExternalStorage() && copy.commandsCount() == commandsCount + 1,
+				name, "path is not detached from storage on write");
+		success &= expect(ref->getPath()->hasExternalStorage()
+						&& ref->getPath()->commandsCount() == commandsCount,
+				name, "source path is modified on write");
+	}
+	mapped = nullptr;
+
+	// entry layout: style, strokeWidth, winding, lineCup, lineJoin
+	success &= expect(!Rc<vg::VectorImage>::create(
+							  BytesView(makeInvalidBinaryImage(binary, -4, 0xFF))),
+			name, "invalid style is accepted");
+	success &= expect(!Rc<vg::VectorImage>::create(
+							  BytesView(makeInvalidBinaryImage(binary, 4, 5))),
+			name, "invalid winding is accepted");
+	success &= expect(!Rc<vg::VectorImage>::create(
+							  BytesView(makeInvalidBinaryImage(binary, 8, 3))),
+			name, "invalid line cup is accepted");
+	success &= expect(!Rc<vg::VectorImage>::create(
+							  BytesView(makeInvalidBinaryImage(binary, 12, 3))),
+			name, "invalid line join is accepted");
+
+	// truncated data should be rejected
+	success &= expect(!Rc<vg::VectorImage>::create(BytesView(binary.data(), binary.size() / 2)),
+			name, "truncated image is accepted");
+
+	filesystem::remove(FileInfo{path});
+	return success;
+});
+
+// Image load: SVG parsing against binary container, copied from bytes or mapped from file
+static RuntimeTest s_vgBinaryImageBenchmark("vg.binary_image", RuntimeTest::Type::Benchmark,
+		[] {
+	StringView name("vg.binary_image");
+	static constexpr size_t Iterations = 20;
+
+	auto svgPath = filesystem::findPath<Interface>(
+			FileInfo{"binary-image-benchmark.svg", FileCategory::AppCache});
+	auto binaryPath = filesystem::findPath<Interface>(
+			FileInfo{"binary-image-benchmark.spvi", FileCategory::AppCache});
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+
+	bool success = true;
+	for (auto pathsCount : {size_t(16), size_t(256)}) {
+		auto svg = makeBinaryImageSvg(pathsCount);
+		auto svgData = BytesView(reinterpret_cast<const uint8_t *>(svg.data()), svg.size());
+		auto binary = vg::VectorImage::convertSvgToBinary(svgData);
+
+		success &= expect(!binary.empty(), name, "fail to convert image");
+		success &= expect(filesystem::write(FileInfo{svgPath}, svgData), name,
+				"fail to write image");
+		success &= expect(filesystem::write(FileInfo{binaryPath}, BytesView(binary)), name,
+				"fail to write image");
+
+		auto measure = [&](StringView mode, const Callback<Rc<vg::VectorImage>()> &cb) {
+			auto start = Time::now();
+			for (size_t i = 0; i < Iterations; ++i) {
+				success &= expect(cb() != nullptr, name, toString("fail to load image: ", mode));
+			}
+			reportBenchmark(name, toString("load, ", mode, ", ", pathsCount, " paths"),
+					double((Time::now() - start).toMicros()) / double(Iterations), "us");
+		};
+
+		measure("svg, string", [&] { return Rc<vg::VectorImage>::create(StringView(svg)); });
+		measure("svg, file", [&] { return Rc<vg::VectorImage>::create(FileInfo{svgPath}); });
+		measure("binary, bytes",
+				[&] { return Rc<vg::VectorImage>::create(BytesView(binary)); });
+		measure("binary, file",
+				[&] { return Rc<vg::VectorImage>::create(FileInfo{binaryPath}); });
+	}
+
+	filesystem::remove(FileInfo{svgPath});
+	filesystem::remove(FileInfo{binaryPath});
+	return success;
+});
+
+} // namespace stappler::test
+
+#endif
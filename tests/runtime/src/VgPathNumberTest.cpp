@@ -0,0 +1,288 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_VG
+
+#include "SPVectorImage.h"
+
+#include <bit>
+#include <random>
+
+#if LINUX
+#include <fstream>
+#endif
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+static constexpr StringView s_pathNumbers[] = {
+	"0", "-0", "+0", "1", "-1", "+1", ".5", "-.5", "+.5", "5.", "-5.", "0.1", "0.2", "0.3",
+	"123.456", "-123.456e-3", "1e22", "1e23", "1e-22", "1e-23", "1.5E+10", "2.5e-7", "7e0",
+	"9007199254740991", "9007199254740992", "9007199254740993", "90071992547409.93",
+	"1234567890123456789", "12345678901234567890", "18446744073709551615",
+	"0.1234567890123456789", "1.23456789012345678901", "00000000000000000000001",
+	"3.14159265358979323846", "4.9e-324", "1.7976931348623157e308", "1e1000", "1e-1000",
+	"0.000000000000000000001", "99999999999999999999", "12345678.87654321",
+
+	// partial tokens, fast path should stop at the same position as readDouble
+	"1e", "1e+", "1.5e-", "12,34", "-7.25-3", ".5.5", "1.2.3", "12abc", "8 9",
+
+	// not numbers
+	"-", "+", ".", ".e5", "e5", "-.", "abc",
+};
+
+// Fast path should be taken for this values
+static constexpr StringView s_pathFastNumbers[] = {
+	"0", "-0", ".5", "-.5", "5.", "0.1", "-123.456e-3", "1e22", "1e-22", "1.5E+10",
+	"9007199254740992", "12345678.87654321", "-7.25-3",
+};
+
+// Too many digits or too large exponent, fast path should fall back to readDouble
+static constexpr StringView s_pathSlowNumbers[] = {
+	"1e23", "1e-23", "9007199254740993", "12345678901234567890", "1.23456789012345678901",
+	"00000000000000000000001", "4.9e-324", "1e1000", "99999999999999999999",
+};
+
+static bool checkPathNumber(StringView name, StringView str, bool &fast) {
+	StringView a(str);
+	StringView b(str);
+	double fastValue = 0.0;
+	double value = 0.0;
+
+	fast = vg::readPathFastNumber(a, fastValue);
+	if (!fast) {
+		return expect(a.size() == str.size(), name,
+				toString("input is consumed on fallback: '", str, "'"));
+	}
+
+	if (!expect(b.readDouble().grab(value), name,
+				toString("fast path accepts value, rejected by readDouble: '", str, "'"))) {
+		return false;
+	}
+
+	bool success = true;
+	success &= expect(std::bit_cast<uint64_t>(fastValue) == std::bit_cast<uint64_t>(value), name,
+			toString("value differs for '", str, "': ", fastValue, " ", value));
+	success &= expect(a.size() == b.size(), name,
+			toString("consumed length differs for '", str, "': ", a, " ", b));
+	return success;
+}
+
+// Random coordinate-like tokens: sign, up to 24 digits with optional dot, optional exponent
+static String makeRandomPathNumber(std::mt19937 &rnd) {
+	String ret;
+	switch (rnd() % 4) {
+	case 0: ret.push_back('-'); break;
+	case 1: ret.push_back('+'); break;
+	default: break;
+	}
+
+	auto digits = 1 + rnd() % 24;
+	auto dot = rnd() % (digits + 2);
+	for (uint32_t i = 0; i < digits; ++i) {
+		if (i == dot) {
+			ret.push_back('.');
+		}
+		ret.push_back(char('0' + rnd() % 10));
+	}
+	if (dot == digits) {
+		ret.push_back('.');
+	}
+
+	if (rnd() % 3 == 0) {
+		ret.push_back((rnd() % 2) ? 'e' : 'E');
+		switch (rnd() % 3) {
+		case 0: ret.push_back('-'); break;
+		case 1: ret.push_back('+'); break;
+		default: break;
+		}
+		ret.append(mem_std::toString(rnd() % 40));
+	}
+	return ret;
+}
+
+static RuntimeTest s_vgPathNumber("vg.path_number", RuntimeTest::Type::Test, [] {
+	StringView name("vg.path_number");
+	static constexpr size_t RandomCount = 100'000;
+
+	bool success = true;
+	bool fast = false;
+
+	for (auto &it : s_pathNumbers) { success &= checkPathNumber(name, it, fast); }
+
+	for (auto &it : s_pathFastNumbers) {
+		success &= checkPathNumber(name, it, fast);
+		success &= expect(fast, name, toString("fast path is not taken for '", it, "'"));
+	}
+
+	for (auto &it : s_pathSlowNumbers) {
+		success &= checkPathNumber(name, it, fast);
+		success &= expect(!fast, name, toString("fast path is taken for '", it, "'"));
+	}
+
+	std::mt19937 rnd(0x5EED);
+	size_t fastCount = 0;
+	for (size_t i = 0; i < RandomCount; ++i) {
+		auto str = makeRandomPathNumber(rnd);
+		if (!checkPathNumber(name, str, fast)) {
+			success = false;
+			break;
+		}
+		fastCount += fast ? 1 : 0;
+	}
+
+	success &= expect(fastCount > 0 && fastCount < RandomCount, name,
+			"random tokens should use both fast path and fallback");
+	return success;
+});
+
+#if LINUX
+// Peak resident set size (VmHWM) can be reset on Linux with clear_refs
+static void resetPeakMemory() {
+	std::ofstream f("/proc/self/clear_refs");
+	f << "5";
+}
+
+static size_t getPeakMemory() {
+	std::ifstream f("/proc/self/status");
+	std::string line;
+	while (std::getline(f, line)) {
+		StringView r(line);
+		if (r.is("VmHWM:")) {
+			r.skipString("VmHWM:");
+			r.skipChars<StringView::WhiteSpace>();
+			return size_t(r.readInteger(10).get(0));
+		}
+	}
+	return 0;
+}
+#endif
+
+// Many paths with long coordinate lists, drawn directly or reused through <defs> and <use>
+static String makePathNumberSvg(size_t pathsCount, size_t usesCount) {
+	std::mt19937 rnd(0x5EED);
+	StringStream out;
+	out << R"(<svg width="1024" height="1024" viewBox="0 0 1024 1024">)";
+	if (usesCount > 0) {
+		out << "<defs>";
+	}
+	for (size_t i = 0; i < pathsCount; ++i) {
+		out << R"(<path id="p)" << i << R"(" d="M)" << rnd() % 1'024 << "." << rnd() % 100 << ","
+			<< rnd() % 1'024 << "." << rnd() % 100;
+		for (size_t j = 0; j < 64; ++j) {
+			out << " C" << rnd() % 1'024 << "." << rnd() % 1'000 << ",-" << rnd() % 1'024 << "."
+				<< rnd() % 1'000 << " ." << rnd() % 10'000 << "-" << rnd() % 100 << "e-1 "
+				<< rnd() % 1'024 << ".5," << rnd() % 1'024;
+		}
+		out << R"( Z"/>)";
+	}
+	if (usesCount > 0) {
+		out << "</defs>";
+	}
+	for (size_t i = 0; i < usesCount; ++i) {
+		out << R"(<use href="#p)" << i % pathsCount << R"(" transform="translate()" << i % 32
+			<< " " << i / 32 << R"()"/>)";
+	}
+	out << "</svg>";
+	return out.str();
+}
+
+static RuntimeTest s_vgPathNumberBenchmark("vg.path_number", RuntimeTest::Type::Benchmark, [] {
+	StringView name("vg.path_number");
+	static constexpr size_t NumbersCount = 1'000'000;
+	static constexpr size_t Iterations = 10;
+
+	// number parsing: fast path with fallback against readDouble only
+	std::mt19937 rnd(0x5EED);
+	Vector<String> numbers;
+	numbers.reserve(NumbersCount);
+	for (size_t i = 0; i < NumbersCount; ++i) {
+		numbers.emplace_back(toString(rnd() % 2'048, ".", rnd() % 1'000));
+	}
+
+	double fastSum = 0.0;
+	double sum = 0.0;
+	auto start = Time::now();
+	for (auto &it : numbers) {
+		StringView r(it);
+		double val = 0.0;
+		if (!vg::readPathFastNumber(r, val)) {
+			r.readDouble().grab(val);
+		}
+		fastSum += val;
+	}
+	reportBenchmark(name, "parse number, fast path",
+			double((Time::now() - start).toMicros()) * 1'000.0 / double(NumbersCount), "ns/number");
+
+	start = Time::now();
+	for (auto &it : numbers) {
+		StringView r(it);
+		double val = 0.0;
+		r.readDouble().grab(val);
+		sum += val;
+	}
+	reportBenchmark(name, "parse number, readDouble",
+			double((Time::now() - start).toMicros()) * 1'000.0 / double(NumbersCount), "ns/number");
+
+	bool success = expect(fastSum == sum, name, "parsed values differ");
+
+	// whole image load: paths in defs and uses of them
+	for (auto usesCount : {size_t(0), size_t(1'024)}) {
+		auto svg = makePathNumberSvg(256, usesCount);
+
+#if LINUX
+		resetPeakMemory();
+		auto initialPeak = getPeakMemory();
+#endif
+
+		size_t pathsCount = 0;
+		start = Time::now();
+		for (size_t i = 0; i < Iterations; ++i) {
+			if (auto image = Rc<vg::VectorImage>::create(StringView(svg))) {
+				pathsCount = image->getPaths().size();
+			}
+		}
+		auto time = double((Time::now() - start).toMicros()) / 1'000.0 / double(Iterations);
+
+		success &= expect(pathsCount > 0, name, "fail to load image");
+
+		reportBenchmark(name,
+				toString("load svg, ", svg.size() / 1'024, " KiB, ", usesCount, " uses"), time,
+				"ms");
+
+#if LINUX
+		auto peak = getPeakMemory();
+		reportBenchmark(name, toString("load svg peak memory, ", usesCount, " uses"),
+				double((peak > initialPeak) ? peak - initialPeak : 0), "KiB");
+#endif
+	}
+
+	return success;
+});
+
+} // namespace stappler::test
+
+#endif
@@ -0,0 +1,261 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "RuntimeTest.h"
+
+#if MODULE_STAPPLER_ZIP && MODULE_STAPPLER_THREADS
+
+#include "SPZipStream.h"
+#include "SPThreadPool.h"
+#include "SPFilesystem.h"
+
+namespace STAPPLER_VERSIONIZED stappler::test {
+
+using namespace mem_std;
+
+// text-like data from small vocabulary, compressible as real documents are
+static Bytes makeZipStreamTestData(uint32_t &seed, size_t size) {
+	static constexpr StringView Words[] = {"lorem ", "ipsum ", "dolor ", "sit ", "amet, ",
+		"consectetur ", "adipiscing ", "elit. ", "<p>", "</p>\n", "sed ", "do "};
+
+	Bytes ret;
+	ret.reserve(size + 16);
+	while (ret.size() < size) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		auto &w = Words[(seed >> 16) % (sizeof(Words) / sizeof(StringView))];
+		ret.insert(ret.end(), w.data(), w.data() + w.size());
+	}
+	ret.resize(size);
+	return ret;
+}
+
+static Bytes makeZipStreamRandomData(uint32_t &seed, size_t size) {
+	Bytes ret;
+	ret.resize(size);
+	for (auto &it : ret) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		it = uint8_t(seed >> 24);
+	}
+	return ret;
+}
+
+static Bytes readZipStreamFile(FILE *file) {
+	Bytes ret;
+	fseek(file, 0, SEEK_END);
+	ret.resize(size_t(ftell(file)));
+	fseek(file, 0, SEEK_SET);
+	if (fread(ret.data(), 1, ret.size(), file) != ret.size()) {
+		ret.clear();
+	}
+	return ret;
+}
+
+static bool checkZipStreamEntry(const ZipReader &reader, StringView name, BytesView data) {
+	bool success = false;
+	reader.readFile(name, [&](BytesView d) { success = (d == data); });
+	return success;
+}
+
+static RuntimeTest s_zipStream("zip.stream", RuntimeTest::Type::Test, [] {
+	StringView name("zip.stream");
+	bool success = true;
+
+	auto pool = Rc<thread::ThreadPool>::create(thread::ThreadPoolInfo{
+		.name = StringView("ZipStreamTest"),
+		.threadCount = 4,
+	});
+
+	// entries are written in order of addition, with mixed methods and sizes
+	Vector<Pair<String, Bytes>> files;
+	uint32_t seed = 1;
+	for (size_t i = 0; i < 256; ++i) {
+		auto size = (i % 7 == 0) ? size_t(0) : size_t(64 + seed % (i % 3 == 0 ? 256_KiB : 4_KiB));
+		files.emplace_back(toString("dir", i % 8, "/file", i, ".txt"),
+				(i % 5 == 0) ? makeZipStreamRandomData(seed, size)
+							 : makeZipStreamTestData(seed, size));
+	}
+
+	auto file = tmpfile();
+	do {
+		ZipWriter writer(file, pool.get(), 6);
+		writer.setPendingLimit(1_MiB);
+		writer.addDir("dir0");
+		for (size_t i = 0; i < files.size(); ++i) {
+			auto uncompressed = (i % 11 == 0);
+			success &= expect(writer.addFile(files[i].first, BytesView(files[i].second),
+									  uncompressed),
+					name, "fail to add file");
+		}
+		success &= expect(writer.finalize(), name, "fail to finalize archive");
+		success &= expect(!writer.addFile("late.txt", StringView("late")), name,
+				"entry is added after finalize");
+		success &= expect(!writer.finalize(), name, "archive is finalized twice");
+	} while (0);
+
+	auto archive = readZipStreamFile(file);
+	fclose(file);
+
+	ZipReader reader(archive);
+	success &= expect(bool(reader), name, "fail to read archive");
+	success &= expect(reader.size() == files.size() + 1, name, "invalid entries count");
+	success &= expect(reader.getFileName(0) == "dir0/", name, "entries are reordered");
+	for (size_t i = 0; i < files.size(); ++i) {
+		success &= expect(checkZipStreamEntry(reader, files[i].first, files[i].second), name,
+				toString("invalid data for ", files[i].first));
+		success &= expect(reader.getFileName(i + 1) == files[i].first, name,
+				"entries are reordered");
+	}
+
+	// stored entries are views into archive
+	auto stored = reader.getFileView(reader.locateFile(files[11].first));
+	success &= expect(stored == BytesView(files[11].second)
+					&& stored.data() >= archive.data()
+					&& stored.data() < archive.data() + archive.size(),
+			name, "stored entry is not a view into archive");
+
+	// archive is readable by libzip
+	ZipArchive<memory::StandartInterface> zip(archive, true);
+	for (size_t i = 0; i < files.size(); i += 17) {
+		auto data = BytesView(files[i].second);
+		bool found = data.empty();
+		zip.readFile(files[i].first, [&](BytesView d) { found = (d == data); });
+		success &= expect(found, name, toString("libzip fails to read ", files[i].first));
+	}
+
+	// damaged stored data is rejected by CRC
+	auto damaged = archive;
+	damaged[stored.data() - archive.data() + 7] ^= 0xFF;
+	success &= expect(!ZipReader(damaged).readFile(files[11].first, [](BytesView) { }), name,
+			"damaged stored entry is accepted");
+
+	// declared size, unreachable from compressed data, is rejected before allocation
+	do {
+		auto out = tmpfile();
+		ZipWriter writer(out);
+		writer.addFile("zeros", Bytes(64_KiB, 0));
+		writer.finalize();
+		auto data = readZipStreamFile(out);
+		fclose(out);
+
+		static constexpr uint8_t CentralHeader[] = {'P', 'K', 1, 2};
+		auto cd = std::search(data.begin(), data.end(), std::begin(CentralHeader),
+				std::end(CentralHeader));
+		if (expect(cd != data.end(), name, "central directory not found")) {
+			auto sizePtr = &*cd + 24;
+			sizePtr[0] = 0x00;
+			sizePtr[1] = 0x00;
+			sizePtr[2] = 0x00;
+			sizePtr[3] = 0x7F;
+			success &= expect(!ZipReader(data).readFile("zeros", [](BytesView) { }), name,
+					"invalid declared size is accepted");
+		} else {
+			success = false;
+		}
+	} while (0);
+
+	success &= expect(!ZipReader(BytesView(files[1].second)), name, "non-zip data is accepted");
+
+	pool->cancel();
+	return success;
+});
+
+// Packing and random access on 1000 x 64KiB archive: libzip against streaming writer
+// and mapped reader
+static RuntimeTest s_zipStreamBenchmark("zip.stream", RuntimeTest::Type::Benchmark, [] {
+	StringView name("zip.stream");
+	static constexpr size_t FilesCount = 1'000;
+	static constexpr size_t FileSize = 64_KiB;
+	static constexpr size_t ReadsCount = 10'000;
+
+	Vector<Pair<String, Bytes>> files;
+	uint32_t seed = 1;
+	for (size_t i = 0; i < FilesCount; ++i) {
+		files.emplace_back(toString("OEBPS/text/part", i, ".xhtml"),
+				makeZipStreamTestData(seed, FileSize));
+	}
+
+	auto measure = [&](StringView metric, const Callback<void()> &cb) {
+		auto start = Time::now();
+		cb();
+		reportBenchmark(name, metric, double((Time::now() - start).toMicros()) / 1'000.0, "ms");
+	};
+
+	auto path = FileInfo{"zip-stream-benchmark.zip", FileCategory::AppCache};
+	filesystem::mkdir_recursive(FileInfo{"", FileCategory::AppCache});
+
+	measure("pack, libzip", [&] {
+		ZipArchive<memory::StandartInterface> zip;
+		for (auto &it : files) { zip.addFile(it.first, BytesView(it.second)); }
+		auto data = zip.save();
+		filesystem::write(path, BytesView(data.data(), data.size()));
+	});
+
+	measure("pack, stream", [&] {
+		ZipWriter writer(path);
+		for (auto &it : files) { writer.addFile(it.first, BytesView(it.second)); }
+		writer.finalize();
+	});
+
+	auto pool = Rc<thread::ThreadPool>::create(thread::ThreadPoolInfo{
+		.name = StringView("ZipStreamBenchmark"),
+	});
+
+	measure(toString("pack, stream, ", pool->getInfo().threadCount, " threads"), [&] {
+		ZipWriter writer(path, pool.get());
+		for (auto &it : files) { writer.addFile(it.first, BytesView(it.second)); }
+		writer.finalize();
+	});
+
+	pool->cancel();
+
+	Vector<size_t> reads;
+	reads.reserve(ReadsCount);
+	for (size_t i = 0; i < ReadsCount; ++i) {
+		seed = seed * 1'664'525 + 1'013'904'223;
+		reads.emplace_back((seed >> 8) % FilesCount);
+	}
+
+	size_t bytes1 = 0;
+	measure("random read, libzip", [&] {
+		ZipArchive<memory::StandartInterface> zip(path);
+		for (auto &it : reads) {
+			zip.readFile(files[it].first, [&](BytesView d) { bytes1 += d.size(); });
+		}
+	});
+
+	size_t bytes2 = 0;
+	measure("random read, mapped", [&] {
+		ZipReader reader(path);
+		for (auto &it : reads) {
+			reader.readFile(files[it].first, [&](BytesView d) { bytes2 += d.size(); });
+		}
+	});
+
+	filesystem::remove(path);
+	return expect(bytes1 == bytes2 && bytes1 == ReadsCount * FileSize, name,
+			"read results differ");
+});
+
+} // namespace stappler::test
+
+#endif
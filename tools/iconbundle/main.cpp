@@ -0,0 +1,80 @@
+/**
+Copyright (c) 2025 Stappler LLC <admin@stappler.dev>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+**/
+
+
+#include "SPCommon.h"
+#include "SPFilesystem.h"
+#include "XL2dIcons.h"
+#include "XL2dVectorSprite.h"
+
+using namespace stappler;
+
+// iconbundle <output> [density] [size in dp...]
+//
+// Writes tesselation bundle for all static icons, drawn by VectorSprite with normal quality
+// at the screen density; sizes are the icon sizes in dp, that application uses
+int main(int argc, const char *argv[]) {
+	return perform_main(argc, argv, [&]() {
+		if (argc < 2) {
+			std::cerr << "Usage: " << argv[0] << " <output> [density] [size in dp...]\n";
+			return 1;
+		}
+
+		float density = 1.0f;
+		if (argc > 2) {
+			density = StringView(argv[2]).readFloat().get(0.0f);
+			if (density <= 0.0f) {
+				std::cerr << "Invalid density: " << argv[2] << "\n";
+				return 1;
+			}
+		}
+
+		mem_std::Vector<float> scales;
+		for (int i = 3; i < argc; ++i) {
+			auto size = StringView(argv[i]).readFloat().get(0.0f);
+			if (size <= 0.0f) {
+				std::cerr << "Invalid icon size: " << argv[i] << "\n";
+				return 1;
+			}
+			scales.emplace_back(size * density / 24.0f);
+		}
+
+		if (scales.empty()) {
+			for (auto size : {18.0f, 24.0f, 32.0f, 36.0f, 48.0f}) {
+				scales.emplace_back(size * density / 24.0f);
+			}
+		}
+
+		auto config = xenolith::basic2d::VectorSprite::makeCanvasConfig(
+				xenolith::basic2d::VectorSprite::QualityNormal, density, 0.0f);
+
+		FileInfo output(StringView(argv[1]));
+		if (!xenolith::basic2d::writeIconBundle(output, config,
+					SpanView<float>(scales.data(), scales.size()))) {
+			std::cerr << "Fail to write bundle: " << output << "\n";
+			return 1;
+		}
+
+		std::cout << "Bundle written: " << output << "\n";
+		return 0;
+	});
+}
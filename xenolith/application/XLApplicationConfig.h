@@ -29,6 +29,9 @@ namespace STAPPLER_VERSIONIZED stappler::xenolith::config {
 
 static constexpr size_t NodePreallocateChilds = 4;
 
+// Minimal number of transforms to update TransformTree in parallel
+static constexpr uint32_t TransformTreeParallelThreshold = 4096;
+
 static constexpr size_t MaxMaterialImages = 4;
 
 static constexpr uint32_t MaxAmbientLights = 16;
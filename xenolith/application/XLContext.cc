@@ -34,6 +34,10 @@
 #include "XLVkInstance.h"
 #endif
 
+#if MODULE_XENOLITH_BACKEND_NULL
+#include "XLNullInstance.h"
+#endif
+
 #include <sprt/runtime/window/native_window.h>
 #include <sprt/runtime/window/controller.h>
 #include <sprt/runtime/window/clipboard.h>
@@ -728,6 +732,13 @@ Rc<sprt::window::gapi::Instance> Context::makeInstance(
 
 		instanceInfo->backend = move(instanceBackendInfo);
 	}
+#endif
+#if MODULE_XENOLITH_BACKEND_NULL
+	if (info->api == core::InstanceApi::None && hasFlag(getInfo()->flags, ContextFlags::Headless)) {
+		instanceInfo = Rc<sprt::window::gapi::InstanceInfo>::alloc();
+		instanceInfo->api = info->api;
+		instanceInfo->flags = info->flags;
+	}
 #endif
 	if (instanceInfo) {
 		return core::Instance::create(move(instanceInfo));
@@ -766,6 +777,14 @@ Rc<sprt::window::gapi::Loop> Context::makeLoop(NotNull<sprt::window::gapi::Insta
 		};
 		loopInfo->backend = data;
 	}
+#endif
+#if MODULE_XENOLITH_BACKEND_NULL
+	if (instance->getApi() == core::InstanceApi::None) {
+		loopInfo = Rc<sprt::window::gapi::LoopInfo>::alloc();
+		loopInfo->deviceIdx = info->deviceIdx;
+		loopInfo->defaultFormat = info->defaultFormat;
+		loopInfo->backend = Rc<null::LoopBackendInfo>::alloc();
+	}
 #endif
 	if (loopInfo) {
 		return static_cast<core::Instance *>(instance.get())->makeLoop(_looper, move(loopInfo));
@@ -23,6 +23,7 @@
 #include "XLCommon.h" // IWYU pragma: keep
 
 #include "nodes/XLNode.cc"
+#include "nodes/XLTransformTree.cc"
 #include "nodes/XLScene.cc"
 #include "nodes/XLSceneContent.cc"
 #include "nodes/XLCloseGuardWidget.cc"
@@ -41,5 +42,6 @@
 
 #include "actions/XLAction.cc"
 #include "actions/XLActionEase.cc"
+#include "actions/XLActionTween.cc"
 #include "actions/XLActionManager.cc"
 #include "actions/XLInterpolation.cc"
@@ -56,6 +56,8 @@ void ActionManager::addAction(Action *action, Node *target, bool paused) {
 }
 
 void ActionManager::removeAllActions() {
+	_tweens.clear();
+
 	if (_inUpdate) {
 		auto it = _actions.begin();
 		while (it != _actions.end()) {
@@ -75,6 +77,8 @@ void ActionManager::removeAllActionsFromTarget(Node *target) {
 		return;
 	}
 
+	_tweens.removeTarget(target);
+
 	if (_current && _current->target == target) {
 		_current->foreach ([&](Action *a) {
 			a->invalidate();
@@ -152,6 +156,8 @@ void ActionManager::removeActionByTag(uint32_t tag, Node *target) {
 }
 
 void ActionManager::removeAllActionsByTag(uint32_t tag, Node *target) {
+	_tweens.removeByTag(target, tag, true);
+
 	if (_current && _current->target == target) {
 		_current->invalidateAllItemsByTag(tag);
 	} else {
@@ -216,6 +222,8 @@ size_t ActionManager::getNumberOfRunningActionsInTarget(const Node *target) cons
 }
 
 void ActionManager::pauseTarget(Node *target) {
+	_tweens.setPaused(target, true);
+
 	auto it = _actions.find(target);
 	if (it != _actions.end()) {
 		it->paused = true;
@@ -223,6 +231,8 @@ void ActionManager::pauseTarget(Node *target) {
 }
 
 void ActionManager::resumeTarget(Node *target) {
+	_tweens.setPaused(target, false);
+
 	auto it = _actions.find(target);
 	if (it != _actions.end()) {
 		it->paused = false;
@@ -235,11 +245,14 @@ Vector<Node *> ActionManager::pauseAllRunningActions() {
 		it.paused = true;
 		ret.emplace_back(it.target);
 	}
+	_tweens.pauseAll(ret);
 	return ret;
 }
 
 void ActionManager::resumeTargets(const Vector<Node *> &targetsToResume) {
 	for (auto &target : targetsToResume) {
+		_tweens.setPaused(target, false);
+
 		auto it = _actions.find(target);
 		if (it != _actions.end()) {
 			it->paused = false;
@@ -270,6 +283,8 @@ void ActionManager::update(const UpdateTime &time) {
 	}
 	_inUpdate = false;
 
+	_tweens.update(dt);
+
 	it = _actions.begin();
 	while (it != _actions.end()) {
 		if (it->cleanup()) {
@@ -289,6 +304,23 @@ void ActionManager::update(const UpdateTime &time) {
 	_pending.clear();
 }
 
-bool ActionManager::empty() const { return _actions.empty() && _pending.empty(); }
+bool ActionManager::addTween(Node *target, TweenProperty prop, float duration, const Vec3 &to,
+		interpolation::Type type, uint32_t tag, bool paused) {
+	XLASSERT(target != nullptr, "");
+
+	return _tweens.add(target, prop, duration, to, type, tag, paused);
+}
+
+void ActionManager::removeAllTweensByTag(uint32_t tag, Node *target) {
+	_tweens.removeByTag(target, tag, true);
+}
+
+size_t ActionManager::getNumberOfRunningTweensInTarget(const Node *target) const {
+	return _tweens.getNumberOfTweens(target);
+}
+
+bool ActionManager::empty() const {
+	return _actions.empty() && _pending.empty() && _tweens.empty();
+}
 
 } // namespace stappler::xenolith
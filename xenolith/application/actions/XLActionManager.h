@@ -25,6 +25,7 @@
 
 #include "XLNodeInfo.h"
 #include "XLAction.h"
+#include "XLActionTween.h"
 #include "SPHashTable.h"
 #include "SPRefContainer.h"
 
@@ -163,6 +164,33 @@ public:
 	 */
 	void resumeTargets(const Vector<Node *> &targetsToResume);
 
+	/** Adds batched tween for a target (see TweenBatch).
+	 * Tweens follows target's pause state, same as actions, and removed with
+	 * removeAllActionsFromTarget and removeAllActionsByTag.
+	 *
+	 * @param target    The target to animate.
+	 * @param prop      Property to animate.
+	 * @param duration  Duration in seconds.
+	 * @param to        Final value, NaN components are taken from the current value.
+	 * @param type      Ease curve, curves with parameters are not supported.
+	 * @param tag       Tag for removal.
+	 * @param paused    Is the tween paused.
+	 * @return  false if tween can not be added.
+	 */
+	bool addTween(Node *target, TweenProperty prop, float duration, const Vec3 &to,
+			interpolation::Type type = interpolation::Linear, uint32_t tag = Action::INVALID_TAG,
+			bool paused = false);
+
+	/** Removes tweens given its tag and the target.
+	 *
+	 * @param tag       The tweens' tag.
+	 * @param target    A certain target.
+	 */
+	void removeAllTweensByTag(uint32_t tag, Node *target);
+
+	/** Returns the numbers of tweens that are running in a certain target. */
+	size_t getNumberOfRunningTweensInTarget(const Node *target) const;
+
 	/** Main loop of ActionManager. */
 	void update(const UpdateTime &);
 
@@ -179,6 +207,7 @@ protected:
 	ActionContainer *_current = nullptr;
 	HashTable<ActionContainer> _actions;
 	Vector<PendingAction> _pending;
+	TweenBatch _tweens;
 };
 
 } // namespace stappler::xenolith
@@ -0,0 +1,248 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLActionTween.h"
+#include "XLNode.h"
+#include "SPSIMDBatch.h"
+
+#include <unordered_set>
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith {
+
+static Vec3 TweenBatch_getValue(Node *node, TweenProperty prop) {
+	switch (prop) {
+	case TweenProperty::Position: return node->getPosition(); break;
+	case TweenProperty::Scale: return node->getScale(); break;
+	case TweenProperty::Rotation: return node->getRotation3D(); break;
+	case TweenProperty::Opacity: return Vec3(node->getOpacity(), 0.0f, 0.0f); break;
+	}
+	return Vec3::ZERO;
+}
+
+static void TweenBatch_setValue(Node *node, TweenProperty prop, const Vec3 &value) {
+	switch (prop) {
+	case TweenProperty::Position: node->setPosition(value); break;
+	case TweenProperty::Scale: node->setScale(value); break;
+	case TweenProperty::Rotation: node->setRotation(value); break;
+	case TweenProperty::Opacity: node->setOpacity(value.x); break;
+	}
+}
+
+bool TweenBatch::add(Node *node, TweenProperty prop, float duration, const Vec3 &to,
+		interpolation::Type type, uint32_t tag, bool paused) {
+	XLASSERT(node != nullptr, "");
+
+	if (type == interpolation::Custom || type == interpolation::Bezierat
+			|| type >= interpolation::Max) {
+		log::source().error("TweenBatch", "Ease type with parameters is not supported");
+		return false;
+	}
+
+	auto from = TweenBatch_getValue(node, prop);
+	auto target = Vec3(std::isnan(to.x) ? from.x : to.x, std::isnan(to.y) ? from.y : to.y,
+			std::isnan(to.z) ? from.z : to.z);
+
+	_targets.emplace_back(node);
+	_tags.emplace_back(tag);
+	_properties.emplace_back(prop);
+	_easing.emplace_back(type);
+	_flags.emplace_back(FirstTick | (paused ? Paused : None));
+	_rate.emplace_back(0.0f);
+	_elapsed.emplace_back(0.0f);
+	_invDuration.emplace_back(1.0f / std::max(duration, sprt::Epsilon<float>));
+	_progress.emplace_back(0.0f);
+
+	const float f[3] = {from.x, from.y, from.z};
+	const float t[3] = {target.x, target.y, target.z};
+
+	for (size_t c = 0; c < 3; ++c) {
+		_from[c].emplace_back(f[c]);
+		_delta[c].emplace_back(t[c] - f[c]);
+		_value[c].emplace_back(f[c]);
+	}
+	return true;
+}
+
+void TweenBatch::update(float dt) {
+	// tweens, added from node callbacks within this update, will start on next one
+	auto count = _targets.size();
+	if (count == 0) {
+		return;
+	}
+
+	_inUpdate = true;
+
+	simd::advanceTimeBatchSoA(_elapsed.data(), _rate.data(), _invDuration.data(),
+			_progress.data(), dt, count);
+
+	for (size_t i = 0; i < count; ++i) {
+		if (_easing[i] != interpolation::Linear) {
+			_progress[i] = interpolation::interpolateTo(_progress[i], _easing[i]);
+		}
+	}
+
+	for (size_t c = 0; c < 3; ++c) {
+		simd::lerpBatchSoA(_from[c].data(), _delta[c].data(), _progress.data(), _value[c].data(),
+				count);
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		auto flags = _flags[i];
+		if (flags & (Removed | Paused)) {
+			continue;
+		}
+
+		TweenBatch_setValue(_targets[i], _properties[i],
+				Vec3(_value[0][i], _value[1][i], _value[2][i]));
+
+		if (flags & FirstTick) {
+			_flags[i] &= ~FirstTick;
+			_rate[i] = 1.0f;
+		} else if (_elapsed[i] * _invDuration[i] >= 1.0f) {
+			remove(i);
+		}
+	}
+
+	_inUpdate = false;
+
+	compact();
+}
+
+void TweenBatch::removeTarget(const Node *node) {
+	for (size_t i = 0; i < _targets.size(); ++i) {
+		if (_targets[i] == node) {
+			remove(i);
+		}
+	}
+	compact();
+}
+
+void TweenBatch::removeByTag(const Node *node, uint32_t tag, bool all) {
+	for (size_t i = 0; i < _targets.size(); ++i) {
+		if (_targets[i] == node && _tags[i] == tag && (_flags[i] & Removed) == 0) {
+			remove(i);
+			if (!all) {
+				break;
+			}
+		}
+	}
+	compact();
+}
+
+void TweenBatch::clear() {
+	for (size_t i = 0; i < _targets.size(); ++i) { remove(i); }
+	compact();
+}
+
+void TweenBatch::setPaused(const Node *node, bool paused) {
+	for (size_t i = 0; i < _targets.size(); ++i) {
+		if (_targets[i] == node) {
+			if (paused) {
+				_flags[i] |= Paused;
+				_rate[i] = 0.0f;
+			} else {
+				_flags[i] &= ~Paused;
+				_rate[i] = (_flags[i] & FirstTick) ? 0.0f : 1.0f;
+			}
+		}
+	}
+}
+
+void TweenBatch::pauseAll(Vector<Node *> &targets) {
+	std::unordered_set<const Node *> known(targets.begin(), targets.end());
+
+	for (size_t i = 0; i < _targets.size(); ++i) {
+		_flags[i] |= Paused;
+		_rate[i] = 0.0f;
+		if (known.emplace(_targets[i].get()).second) {
+			targets.emplace_back(_targets[i].get());
+		}
+	}
+}
+
+size_t TweenBatch::getNumberOfTweens(const Node *node) const {
+	size_t ret = 0;
+	for (size_t i = 0; i < _targets.size(); ++i) {
+		if (_targets[i] == node && (_flags[i] & Removed) == 0) {
+			++ret;
+		}
+	}
+	return ret;
+}
+
+void TweenBatch::remove(size_t idx) {
+	if ((_flags[idx] & Removed) == 0) {
+		_flags[idx] |= Removed;
+		_rate[idx] = 0.0f;
+		++_removed;
+	}
+}
+
+void TweenBatch::compact() {
+	if (_inUpdate || _removed == 0) {
+		return;
+	}
+
+	// stable compaction, so tweens for the same property are still applied in order of addition
+	size_t dst = 0;
+	for (size_t i = 0; i < _targets.size(); ++i) {
+		if (_flags[i] & Removed) {
+			continue;
+		}
+		if (dst != i) {
+			_targets[dst] = sp::move(_targets[i]);
+			_tags[dst] = _tags[i];
+			_properties[dst] = _properties[i];
+			_easing[dst] = _easing[i];
+			_flags[dst] = _flags[i];
+			_rate[dst] = _rate[i];
+			_elapsed[dst] = _elapsed[i];
+			_invDuration[dst] = _invDuration[i];
+			_progress[dst] = _progress[i];
+			for (size_t c = 0; c < 3; ++c) {
+				_from[c][dst] = _from[c][i];
+				_delta[c][dst] = _delta[c][i];
+				_value[c][dst] = _value[c][i];
+			}
+		}
+		++dst;
+	}
+
+	_targets.resize(dst);
+	_tags.resize(dst);
+	_properties.resize(dst);
+	_easing.resize(dst);
+	_flags.resize(dst);
+	_rate.resize(dst);
+	_elapsed.resize(dst);
+	_invDuration.resize(dst);
+	_progress.resize(dst);
+	for (size_t c = 0; c < 3; ++c) {
+		_from[c].resize(dst);
+		_delta[c].resize(dst);
+		_value[c].resize(dst);
+	}
+
+	_removed = 0;
+}
+
+} // namespace stappler::xenolith
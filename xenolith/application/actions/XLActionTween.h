@@ -0,0 +1,107 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_APPLICATION_ACTIONS_XLACTIONTWEEN_H_
+#define XENOLITH_APPLICATION_ACTIONS_XLACTIONTWEEN_H_
+
+#include "XLAction.h"
+#include "XLInterpolation.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith {
+
+class Node;
+
+enum class TweenProperty : uint8_t {
+	Position,
+	Scale,
+	Rotation, // in radians, (x, y, z) as in Node::setRotation(Vec3)
+	Opacity, // uses x component only
+};
+
+/** Batched storage for simple interval animations
+ *
+ * Equivalent of MoveTo/ScaleTo/FadeTo with an optional ease curve, but without per-action
+ * objects and virtual calls: all tweens are stored as arrays of components and stepped
+ * together, then results are written into nodes in a single pass.
+ *
+ * NaN components in target value are replaced with the start value of the node, like with
+ * MoveTo for Vec2 position.
+ *
+ * Curves, that requires parameters (Custom, Bezierat), are not supported, use
+ * EaseActionTyped for them.
+ */
+class SP_PUBLIC TweenBatch final {
+public:
+	bool add(Node *, TweenProperty, float duration, const Vec3 &to,
+			interpolation::Type = interpolation::Linear, uint32_t tag = Action::INVALID_TAG,
+			bool paused = false);
+
+	void update(float dt);
+
+	void removeTarget(const Node *);
+	void removeByTag(const Node *, uint32_t tag, bool all);
+	void clear();
+
+	void setPaused(const Node *, bool);
+
+	// pauses all tweens, appends its targets to the list, if not already there
+	void pauseAll(Vector<Node *> &);
+
+	size_t size() const { return _targets.size() - _removed; }
+	size_t getNumberOfTweens(const Node *) const;
+
+	bool empty() const { return size() == 0; }
+
+protected:
+	enum Flags : uint8_t {
+		None = 0,
+		Paused = 1 << 0,
+		FirstTick = 1 << 1,
+		Removed = 1 << 2,
+	};
+
+	void remove(size_t);
+	void compact();
+
+	bool _inUpdate = false;
+	size_t _removed = 0;
+
+	Vector<Rc<Node>> _targets;
+	Vector<uint32_t> _tags;
+	Vector<TweenProperty> _properties;
+	Vector<interpolation::Type> _easing;
+	Vector<uint8_t> _flags;
+
+	// 0.0 for paused tweens and on first tick, 1.0 otherwise
+	Vector<float> _rate;
+	Vector<float> _elapsed;
+	Vector<float> _invDuration;
+	Vector<float> _progress;
+
+	Vector<float> _from[3];
+	Vector<float> _delta[3];
+	Vector<float> _value[3];
+};
+
+} // namespace stappler::xenolith
+
+#endif /* XENOLITH_APPLICATION_ACTIONS_XLACTIONTWEEN_H_ */
@@ -33,6 +33,8 @@
 #include "XLCorePresentationEngine.h"
 #include "XLContext.h"
 #include "XLAppWindow.h"
+#include "SPEventLooper.h"
+#include "SPEventTimerHandle.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith {
 
@@ -45,12 +47,29 @@ bool Director::init(NotNull<AppThread> app, const core::FrameConstraints &constr
 	_application = app;
 	_window = window;
 	_engine = window->getPresentationEngine();
+
+	return initState(constraints, _window->getWindowState());
+}
+
+bool Director::init(NotNull<core::Loop> loop, const core::FrameConstraints &constraints) {
+	_loop = loop;
+
+	return initState(constraints, WindowState::None);
+}
+
+bool Director::initState(const core::FrameConstraints &constraints, WindowState state) {
 	_allocator = Rc<AllocRef>::alloc();
 	_pool = Rc<PoolRef>::alloc(_allocator);
 	_pool->perform([&, this] {
 		_scheduler = Rc<Scheduler>::create();
+		_scheduler->setTimerCallback([this](uint64_t deadline) {
+			// timer scheduled outside of frame (e.g. from looper) can precede armed wakeup
+			if (deadline < _wakeupDeadline && !hasActiveInteractions()) {
+				scheduleWakeup();
+			}
+		});
 		_actionManager = Rc<ActionManager>::create();
-		_inputDispatcher = Rc<InputDispatcher>::create(_pool, _window->getWindowState());
+		_inputDispatcher = Rc<InputDispatcher>::create(_pool, state);
 		_textInput = Rc<TextInputManager>::create(this);
 	});
 	_startTime = sp::platform::clock(ClockType::Monotonic);
@@ -68,7 +87,7 @@ bool Director::init(NotNull<AppThread> app, const core::FrameConstraints &constr
 TextInputManager *Director::getTextInputManager() const { return _textInput; }
 
 ResourceCache *Director::getResourceCache() const {
-	return _application->getExtension<ResourceCache>();
+	return _application ? _application->getExtension<ResourceCache>() : nullptr;
 }
 
 bool Director::acquireFrame(FrameRequest *req) {
@@ -108,8 +127,7 @@ bool Director::acquireFrame(FrameRequest *req) {
 		req->setQueue(_scene->getQueue());
 	}
 
-	// break current stack frame, perform on next one
-	_application->performOnAppThread([this, req = Rc<core::FrameRequest>(req)] {
+	auto render = [this, req = Rc<core::FrameRequest>(req)] {
 		if (!_scene || !req) {
 			return;
 		}
@@ -117,15 +135,25 @@ bool Director::acquireFrame(FrameRequest *req) {
 		auto pool = Rc<PoolRef>::alloc(_allocator);
 
 		pool->perform([&, this] {
+			XL_PROFILE_ZONE("Scene::renderRequest", "director");
 			_scene->renderRequest(req, pool);
 
 			if (hasActiveInteractions()) {
 				if (_window) {
 					_window->setReadyForNextFrame();
 				}
+			} else {
+				scheduleWakeup();
 			}
 		});
-	}, this, true);
+	};
+
+	if (_application) {
+		// break current stack frame, perform on next one
+		_application->performOnAppThread(sp::move(render), this, true);
+	} else {
+		render();
+	}
 
 	_avgFrameTime.addValue(sp::platform::clock(ClockType::Monotonic) - t);
 	_avgFrameTimeValue = _avgFrameTime.getAverage();
@@ -133,6 +161,8 @@ bool Director::acquireFrame(FrameRequest *req) {
 }
 
 void Director::update(uint64_t t) {
+	XL_PROFILE_ZONE("Director::update", "director");
+
 	if (_time.global) {
 		_time.delta = t - _time.global;
 	} else {
@@ -161,9 +191,20 @@ void Director::update(uint64_t t) {
 		_nextScene = nullptr;
 	}
 
-	_inputDispatcher->update(_time);
-	_scheduler->update(_time);
-	_actionManager->update(_time);
+	do {
+		XL_PROFILE_ZONE("InputDispatcher::update", "director");
+		_inputDispatcher->update(_time);
+	} while (0);
+
+	do {
+		XL_PROFILE_ZONE("Scheduler::update", "director");
+		_scheduler->update(_time);
+	} while (0);
+
+	do {
+		XL_PROFILE_ZONE("ActionManager::update", "director");
+		_actionManager->update(_time);
+	} while (0);
 
 	_autorelease.clear();
 }
@@ -221,6 +262,12 @@ void Director::end() {
 	_scene = nullptr;
 #endif
 
+	if (_wakeupTimer) {
+		_wakeupTimer->cancel();
+		_wakeupTimer = nullptr;
+	}
+
+	_scheduler->setTimerCallback(nullptr);
 	if (!_scheduler->empty()) {
 		_scheduler->unscheduleAll();
 	}
@@ -233,6 +280,9 @@ void Director::end() {
 }
 
 core::Loop *Director::getGlLoop() const {
+	if (!_application) {
+		return _loop;
+	}
 	return static_cast<core::Loop *>(_application->getContext()->getGlLoop());
 }
 
@@ -248,6 +298,12 @@ void Director::setFrameConstraints(const core::FrameConstraints &c) {
 }
 
 void Director::runScene(Rc<Scene> &&scene) {
+	if (scene && !_application) {
+		// headless: scene will be presented with the next FrameRequest
+		_nextScene = move(scene);
+		return;
+	}
+
 	if (!scene || !_window) {
 		return;
 	}
@@ -275,6 +331,9 @@ void Director::runScene(Rc<Scene> &&scene) {
 }
 
 void Director::pushDrawStat(const DrawStat &stat) {
+	if (!_application) {
+		return;
+	}
 	_application->performOnAppThread([this, stat] { _drawStat = stat; }, this, false);
 }
 
@@ -352,8 +411,51 @@ void Director::updateGeneralTransform() {
 	_generalProjection = proj;
 }
 
+uint64_t Director::getNextDeadline() const {
+	if (!_actionManager->empty() || _inputDispatcher->hasActiveInput()) {
+		return sp::platform::clock(ClockType::Monotonic);
+	}
+	return _scheduler->getNextDeadline();
+}
+
 bool Director::hasActiveInteractions() {
 	return !_actionManager->empty() || _inputDispatcher->hasActiveInput();
 }
 
+void Director::scheduleWakeup() {
+	auto deadline = _scheduler->getNextDeadline();
+	if (deadline == _wakeupDeadline && _wakeupTimer) {
+		return;
+	}
+
+	if (_wakeupTimer) {
+		_wakeupTimer->cancel();
+		_wakeupTimer = nullptr;
+	}
+
+	_wakeupDeadline = deadline;
+
+	if (deadline == maxOf<uint64_t>() || !_window) {
+		return;
+	}
+
+	auto now = sp::platform::clock(ClockType::Monotonic);
+	auto timeout = deadline > now ? deadline - now : 0;
+
+	// app thread sleeps until the deadline instead of requesting every frame
+	_wakeupTimer = _application->getLooper()->scheduleTimer(event::TimerInfo{
+		.completion = event::TimerInfo::Completion::create<Director>(this,
+				[](Director *director, event::TimerHandle *, uint32_t, Status status) {
+		if (isSuccessful(status)) {
+			director->_wakeupDeadline = maxOf<uint64_t>();
+			if (director->_window) {
+				director->_window->setReadyForNextFrame();
+			}
+		}
+	}),
+		.timeout = TimeInterval::microseconds(std::max(timeout, Scheduler::TimerTick)),
+		.count = 1,
+	}, this);
+}
+
 } // namespace stappler::xenolith
@@ -47,6 +47,10 @@ public:
 
 	bool init(NotNull<AppThread>, const core::FrameConstraints &, NotNull<AppWindow>);
 
+	// Headless director: no AppWindow and no AppThread, FrameRequests are provided by caller
+	// and scenes are rendered on the caller's thread. Scene's queue should be compiled by caller.
+	bool init(NotNull<core::Loop>, const core::FrameConstraints &);
+
 	void setFrameConstraints(const core::FrameConstraints &);
 
 	void runScene(Rc<Scene> &&);
@@ -91,17 +95,28 @@ public:
 
 	void autorelease(Ref *);
 
+	// Absolute time (same clock as UpdateTime::global), when director should be updated next:
+	// now, if there are active actions or input, next timer deadline otherwise, or
+	// maxOf<uint64_t>() if no updates are required
+	uint64_t getNextDeadline() const;
+
 protected:
 	// Vk Swaphain was invalidated, drop all dependent resources;
 	void invalidate();
 
+	bool initState(const core::FrameConstraints &, WindowState);
+
 	void updateGeneralTransform();
 
 	bool hasActiveInteractions();
 
+	// Schedules frame request for the next scheduler deadline, when director is idle
+	void scheduleWakeup();
+
 	Rc<AppThread> _application;
 	Rc<AppWindow> _window;
 	Rc<core::PresentationEngine> _engine;
+	Rc<core::Loop> _loop; // only for headless director
 
 	core::FrameConstraints _constraints;
 
@@ -123,6 +138,9 @@ protected:
 
 	Vector<Rc<Ref>> _autorelease;
 
+	Rc<event::TimerHandle> _wakeupTimer;
+	uint64_t _wakeupDeadline = maxOf<uint64_t>();
+
 	MovingAverage<20, uint64_t> _avgFrameTime;
 	uint64_t _avgFrameTimeValue = 0;
 };
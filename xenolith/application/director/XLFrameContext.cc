@@ -45,7 +45,9 @@ void FrameContext::submitHandle(FrameInfo &info, FrameContextHandle *handle) {
 	submitMaterials(info);
 
 	if (!handle->waitDependencies.empty()) {
-		info.director->getApplication()->wakeup();
+		if (auto app = info.director->getApplication()) {
+			app->wakeup();
+		}
 	}
 }
 
@@ -242,7 +244,9 @@ void FrameContext::submitMaterials(const FrameInfo &info) {
 			req->materialsToAddOrUpdate = sp::move(_pendingMaterialsToAdd);
 			req->materialsToRemove = sp::move(_pendingMaterialsToRemove);
 			req->callback = [app = Rc<AppThread>(info.director->getApplication())] {
-				app->wakeup();
+				if (app) {
+					app->wakeup();
+				}
 			};
 
 			for (auto &it : req->materialsToRemove) { emplace_ordered(_revokedIds, it); }
@@ -24,7 +24,26 @@
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith {
 
-Scheduler::Scheduler() { }
+static uint32_t Scheduler_findOccupied(
+		const std::array<uint64_t, Scheduler::TimerWheelSlots / 64> &bits, uint32_t from,
+		uint32_t to) {
+	while (from < to) {
+		auto word = bits[from / 64] >> (from % 64);
+		if (word) {
+			auto ret = from + uint32_t(std::countr_zero(word));
+			return ret < to ? ret : to;
+		}
+		from = (from / 64 + 1) * 64;
+	}
+	return to;
+}
+
+Scheduler::Scheduler() {
+	for (auto &it : _timerWheel) {
+		it.heads.fill(TimerInvalid);
+		it.occupied.fill(0);
+	}
+}
 
 Scheduler::~Scheduler() { unscheduleAll(); }
 
@@ -36,11 +55,18 @@ void Scheduler::unschedule(const void *ptr) {
 	} else {
 		_list.erase(ptr);
 	}
+	cancelTimers(ptr);
 }
 
 void Scheduler::unscheduleAll() {
 	_list.clear();
 	_tmp.clear();
+
+	for (uint32_t i = 0; i < _timers.size(); ++i) {
+		if (_timers[i].active) {
+			stopTimer(i);
+		}
+	}
 }
 
 void Scheduler::schedulePerFrame(SchedulerFunc &&callback, void *target, int32_t priority,
@@ -53,7 +79,113 @@ void Scheduler::schedulePerFrame(SchedulerFunc &&callback, void *target, int32_t
 	}
 }
 
+uint64_t Scheduler::scheduleTimer(SchedulerFunc &&callback, const void *target,
+		TimeInterval delay, TimeInterval interval) {
+	if (!callback) {
+		return 0;
+	}
+
+	auto now = sp::platform::clock(ClockType::Monotonic) / TimerTick;
+	if (!_timerWheelInit) {
+		_timerTick = now;
+		_timerWheelInit = true;
+	}
+
+	auto idx = allocateTimer();
+	auto &t = _timers[idx];
+	t.callback = sp::move(callback);
+	t.target = target;
+	t.expires = std::max(now, _timerTick) + (delay.toMicros() + TimerTick - 1) / TimerTick;
+	t.interval = 0;
+	if (interval.toMicros() > 0) {
+		t.interval = std::max(interval.toMicros() / TimerTick, uint64_t(1));
+	}
+	t.active = true;
+
+	if (target) {
+		auto it = _timerTargets.emplace(target, TimerInvalid).first;
+		t.targetNext = it->second;
+		if (t.targetNext != TimerInvalid) {
+			_timers[t.targetNext].targetPrev = idx;
+		}
+		it->second = idx;
+	}
+
+	insertTimer(idx, _timerTick + 1);
+
+	auto id = (uint64_t(t.generation) << 32) | idx;
+
+	if (!_inUpdate && _timerCallback) {
+		_timerCallback(t.expires * TimerTick);
+	}
+
+	return id;
+}
+
+void Scheduler::setTimerCallback(Function<void(uint64_t)> &&cb) { _timerCallback = sp::move(cb); }
+
+bool Scheduler::cancelTimer(uint64_t id) {
+	auto idx = uint32_t(id & maxOf<uint32_t>());
+	auto generation = uint32_t(id >> 32);
+	if (idx >= _timers.size() || _timers[idx].generation != generation || !_timers[idx].active) {
+		return false;
+	}
+
+	stopTimer(idx);
+	return true;
+}
+
+uint64_t Scheduler::getNextDeadline() const {
+	if (!_timerWheelInit || _timersCount == _parkedCount) {
+		return maxOf<uint64_t>();
+	}
+
+	constexpr uint32_t mask = TimerWheelSlots - 1;
+
+	uint64_t ret = maxOf<uint64_t>();
+
+	// first level contains exact deadlines
+	auto next = _timerTick + 1;
+	auto index = uint32_t(next & mask);
+	auto found = Scheduler_findOccupied(_timerWheel[0].occupied, index, TimerWheelSlots);
+	if (found < TimerWheelSlots) {
+		ret = next - index + found;
+	} else {
+		found = Scheduler_findOccupied(_timerWheel[0].occupied, 0, index);
+		if (found < index) {
+			ret = next - index + TimerWheelSlots + found;
+		}
+	}
+
+	// for upper levels - time, when the slot will be cascaded
+	for (uint32_t l = 1; l < TimerWheelLevels; ++l) {
+		auto shift = TimerWheelBits * l;
+		auto current = uint32_t((_timerTick >> shift) & mask);
+		uint64_t blocks = 0;
+
+		found = Scheduler_findOccupied(_timerWheel[l].occupied, current + 1, TimerWheelSlots);
+		if (found < TimerWheelSlots) {
+			blocks = found - current;
+		} else {
+			found = Scheduler_findOccupied(_timerWheel[l].occupied, 0, current + 1);
+			if (found <= current) {
+				blocks = TimerWheelSlots - current + found;
+			}
+		}
+
+		if (blocks) {
+			ret = std::min(ret, ((_timerTick >> shift) + blocks) << shift);
+		}
+	}
+
+	return ret == maxOf<uint64_t>() ? ret : ret * TimerTick;
+}
+
 void Scheduler::update(const UpdateTime &time) {
+	_inUpdate = true;
+
+	advanceTimers(time);
+
 	_locked = true;
 
 	_list.foreach ([&, this](void *target, int64_t priority, SchedulerCallback &cb) {
@@ -71,6 +203,9 @@ void Scheduler::update(const UpdateTime &time) {
 	for (auto &it : _tmp) {
 		_list.emplace(it.target, it.priority, sp::move(it.callback), it.paused);
 	}
+	_tmp.clear();
+
+	_inUpdate = false;
 }
 
 bool Scheduler::isPaused(void *ptr) const {
@@ -84,6 +219,7 @@ void Scheduler::resume(void *ptr) {
 	if (auto v = _list.find(ptr)) {
 		v->paused = false;
 	}
+	resumeTimers(ptr);
 }
 
 void Scheduler::pause(void *ptr) {
@@ -92,6 +228,271 @@ void Scheduler::pause(void *ptr) {
 	}
 }
 
-bool Scheduler::empty() const { return _list.empty() && _tmp.empty(); }
+bool Scheduler::empty() const { return _list.empty() && _tmp.empty() && _timersCount == 0; }
+
+uint32_t Scheduler::allocateTimer() {
+	++_timersCount;
+	if (!_freeTimers.empty()) {
+		auto idx = _freeTimers.back();
+		_freeTimers.pop_back();
+		return idx;
+	}
+
+	auto idx = uint32_t(_timers.size());
+	_timers.emplace_back().generation = 1;
+	return idx;
+}
+
+void Scheduler::releaseTimer(uint32_t idx) {
+	auto &t = _timers[idx];
+	if (t.target) {
+		if (t.targetNext != TimerInvalid) {
+			_timers[t.targetNext].targetPrev = t.targetPrev;
+		}
+		if (t.targetPrev != TimerInvalid) {
+			_timers[t.targetPrev].targetNext = t.targetNext;
+		} else if (t.targetNext != TimerInvalid) {
+			_timerTargets[t.target] = t.targetNext;
+		} else {
+			_timerTargets.erase(t.target);
+		}
+	}
+
+	t.callback = nullptr;
+	t.target = nullptr;
+	t.active = false;
+	t.prev = t.next = TimerInvalid;
+	t.targetPrev = t.targetNext = TimerInvalid;
+	t.slot = TimerDetached;
+
+	// invalidates ids, issued for this slot
+	++t.generation;
+	if (t.generation == 0) {
+		t.generation = 1;
+	}
+
+	_freeTimers.emplace_back(idx);
+	--_timersCount;
+}
+
+void Scheduler::insertTimer(uint32_t idx, uint64_t minTick) {
+	constexpr uint64_t span = uint64_t(1) << (TimerWheelBits * TimerWheelLevels);
+
+	auto &t = _timers[idx];
+	if (t.expires < minTick) {
+		t.expires = minTick;
+	}
+
+	auto delta = t.expires - _timerTick;
+
+	uint32_t level = 0;
+	while (level + 1 < TimerWheelLevels
+			&& delta >= (uint64_t(1) << (TimerWheelBits * (level + 1)))) {
+		++level;
+	}
+
+	// too distant timers are placed at the end of the wheel, and will be reinserted on cascade
+	auto place = (delta >= span) ? _timerTick + span - 1 : t.expires;
+	auto index = uint32_t(place >> (TimerWheelBits * level)) & (TimerWheelSlots - 1);
+
+	auto &wl = _timerWheel[level];
+	t.slot = level * TimerWheelSlots + index;
+	t.prev = TimerInvalid;
+	t.next = wl.heads[index];
+	if (t.next != TimerInvalid) {
+		_timers[t.next].prev = idx;
+	}
+	wl.heads[index] = idx;
+	wl.occupied[index / 64] |= uint64_t(1) << (index % 64);
+}
+
+void Scheduler::unlinkTimer(uint32_t idx) {
+	auto &t = _timers[idx];
+	auto level = t.slot / TimerWheelSlots;
+	auto index = t.slot % TimerWheelSlots;
+	auto &wl = _timerWheel[level];
+
+	if (t.prev != TimerInvalid) {
+		_timers[t.prev].next = t.next;
+	} else {
+		wl.heads[index] = t.next;
+	}
+	if (t.next != TimerInvalid) {
+		_timers[t.next].prev = t.prev;
+	}
+
+	if (wl.heads[index] == TimerInvalid) {
+		wl.occupied[index / 64] &= ~(uint64_t(1) << (index % 64));
+	}
+
+	t.prev = t.next = TimerInvalid;
+	t.slot = TimerDetached;
+}
+
+uint32_t Scheduler::detachSlot(uint32_t level, uint32_t index) {
+	auto &wl = _timerWheel[level];
+	auto head = wl.heads[index];
+	wl.heads[index] = TimerInvalid;
+	wl.occupied[index / 64] &= ~(uint64_t(1) << (index % 64));
+
+	// detached timers keeps next links, so the list can be traversed
+	auto idx = head;
+	while (idx != TimerInvalid) {
+		_timers[idx].slot = TimerDetached;
+		idx = _timers[idx].next;
+	}
+	return head;
+}
+
+void Scheduler::advanceTimers(const UpdateTime &time) {
+	if (!_timerWheelInit) {
+		return;
+	}
+
+	constexpr uint32_t mask = TimerWheelSlots - 1;
+
+	auto target = time.global / TimerTick;
+	while (_timerTick < target) {
+		if (_timersCount == _parkedCount) {
+			_timerTick = target;
+			break;
+		}
+
+		// skip empty slots of the first level up to the next cascade point
+		auto next = _timerTick + 1;
+		auto index = uint32_t(next & mask);
+		auto tick = next;
+		if (index != 0) {
+			tick = next - index
+					+ Scheduler_findOccupied(_timerWheel[0].occupied, index, TimerWheelSlots);
+		}
+
+		if (tick > target) {
+			_timerTick = target;
+			break;
+		}
+
+		_timerTick = tick;
+
+		if ((tick & mask) == 0) {
+			cascadeTimers(tick);
+		}
+
+		auto current = uint32_t(tick & mask);
+		if (_timerWheel[0].heads[current] != TimerInvalid) {
+			runTimers(detachSlot(0, current), time);
+		}
+	}
+}
+
+void Scheduler::cascadeTimers(uint64_t tick) {
+	constexpr uint32_t mask = TimerWheelSlots - 1;
+
+	for (uint32_t l = 1; l < TimerWheelLevels; ++l) {
+		auto index = uint32_t(tick >> (TimerWheelBits * l)) & mask;
+		auto idx = detachSlot(l, index);
+		while (idx != TimerInvalid) {
+			auto next = _timers[idx].next;
+			if (_timers[idx].active) {
+				insertTimer(idx, tick);
+			} else {
+				releaseTimer(idx);
+			}
+			idx = next;
+		}
+
+		if (index != 0) {
+			break;
+		}
+	}
+}
+
+void Scheduler::runTimers(uint32_t idx, const UpdateTime &time) {
+	while (idx != TimerInvalid) {
+		auto next = _timers[idx].next;
+		auto &t = _timers[idx];
+		if (!t.active) {
+			releaseTimer(idx);
+			idx = next;
+			continue;
+		}
+
+		if (t.target && isPaused(const_cast<void *>(t.target))) {
+			t.slot = TimerParked;
+			t.prev = t.next = TimerInvalid;
+			++_parkedCount;
+			idx = next;
+			continue;
+		}
+
+		// callback can schedule new timers, so storage can be reallocated
+		auto callback = sp::move(t.callback);
+		auto interval = t.interval;
+
+		callback(time);
+
+		auto &tt = _timers[idx];
+		if (tt.active && interval > 0) {
+			tt.callback = sp::move(callback);
+			tt.expires += interval;
+			insertTimer(idx, _timerTick + 1);
+		} else {
+			releaseTimer(idx);
+		}
+		idx = next;
+	}
+}
+
+void Scheduler::stopTimer(uint32_t idx) {
+	auto &t = _timers[idx];
+	if (t.slot == TimerDetached) {
+		// timer is processed right now, it will be released after that
+		t.active = false;
+		t.callback = nullptr;
+	} else if (t.slot == TimerParked) {
+		--_parkedCount;
+		releaseTimer(idx);
+	} else {
+		unlinkTimer(idx);
+		releaseTimer(idx);
+	}
+}
+
+void Scheduler::cancelTimers(const void *target) {
+	auto it = _timerTargets.find(target);
+	if (it == _timerTargets.end()) {
+		return;
+	}
+
+	// stopTimer can release timer and remove it from the list, so next link is read before
+	auto idx = it->second;
+	while (idx != TimerInvalid) {
+		auto next = _timers[idx].targetNext;
+		if (_timers[idx].active) {
+			stopTimer(idx);
+		}
+		idx = next;
+	}
+}
+
+void Scheduler::resumeTimers(const void *target) {
+	if (_parkedCount == 0) {
+		return;
+	}
+
+	auto it = _timerTargets.find(target);
+	if (it == _timerTargets.end()) {
+		return;
+	}
+
+	auto idx = it->second;
+	while (idx != TimerInvalid) {
+		if (_timers[idx].slot == TimerParked) {
+			--_parkedCount;
+			insertTimer(idx, _timerTick + 1);
+		}
+		idx = _timers[idx].targetNext;
+	}
+}
 
 } // namespace stappler::xenolith
@@ -27,6 +27,8 @@
 #include "SPPriorityList.h"
 #include "SPSubscription.h"
 
+#include <unordered_map>
+
 namespace STAPPLER_VERSIONIZED stappler::xenolith {
 
 using SchedulerFunc = Function<void(const UpdateTime &)>;
@@ -43,11 +45,19 @@ struct SP_PUBLIC SchedulerCallback {
 
 class SP_PUBLIC Scheduler : public Ref {
 public:
+	// Timer wheel granularity, in microseconds
+	static constexpr uint64_t TimerTick = 1'000;
+
+	static constexpr uint32_t TimerWheelBits = 8;
+	static constexpr uint32_t TimerWheelSlots = 1 << TimerWheelBits;
+	static constexpr uint32_t TimerWheelLevels = 4;
+
 	Scheduler();
 	virtual ~Scheduler();
 
 	bool init();
 
+	// Removes per-frame callback and cancels all timers for the target
 	void unschedule(const void *);
 	void unscheduleAll();
 
@@ -56,6 +66,34 @@ public:
 
 	void schedulePerFrame(SchedulerFunc &&callback, void *target, int32_t priority, bool paused);
 
+	/** Schedules one-shot (with zero interval) or repeating timer
+	 *
+	 * Timers are stored in hierarchical timing wheel, so pending timers costs nothing per frame.
+	 * Timer is called from update, when its deadline is reached, with TimerTick precision.
+	 * Repeating timer is called once per update, even if more than one interval has passed.
+	 *
+	 * Timer with a target is cancelled with unschedule(target). If per-frame callback of the
+	 * target is paused, expired timer is held until the target is resumed.
+	 *
+	 * Returns id for cancelTimer, 0 on failure.
+	 */
+	uint64_t scheduleTimer(SchedulerFunc &&callback, const void *target, TimeInterval delay,
+			TimeInterval interval = TimeInterval());
+
+	bool cancelTimer(uint64_t id);
+
+	size_t getTimersCount() const { return _timersCount; }
+
+	// Called when timer is scheduled outside of update, so owner can re-arm its wakeup for
+	// the new deadline (timers, scheduled within update, are visible after it returns)
+	void setTimerCallback(Function<void(uint64_t deadline)> &&);
+
+	// Absolute time (same clock as UpdateTime::global) of the next timer deadline, or
+	// maxOf<uint64_t>() if there are no timers pending. For distant timers returned time can be
+	// earlier than actual deadline (when timer should be moved to the lower level of the wheel),
+	// but never later.
+	uint64_t getNextDeadline() const;
+
 	void update(const UpdateTime &);
 
 	bool isPaused(void *) const;
@@ -65,6 +103,13 @@ public:
 	bool empty() const;
 
 protected:
+	// end of list for timer links
+	static constexpr uint32_t TimerInvalid = maxOf<uint32_t>();
+
+	// slot values for timers, that are not in the wheel
+	static constexpr uint32_t TimerDetached = maxOf<uint32_t>() - 1;
+	static constexpr uint32_t TimerParked = maxOf<uint32_t>() - 2;
+
 	struct ScheduledTemporary {
 		SchedulerFunc callback;
 		void *target;
@@ -72,11 +117,57 @@ protected:
 		bool paused;
 	};
 
+	struct Timer {
+		SchedulerFunc callback;
+		const void *target = nullptr;
+		uint64_t expires = 0; // in ticks
+		uint64_t interval = 0; // in ticks
+		uint32_t generation = 0;
+		uint32_t prev = TimerInvalid;
+		uint32_t next = TimerInvalid;
+		uint32_t targetPrev = TimerInvalid; // list of timers with the same target
+		uint32_t targetNext = TimerInvalid;
+		uint32_t slot = TimerDetached; // level * TimerWheelSlots + index
+		bool active = false;
+	};
+
+	struct TimerWheelLevel {
+		std::array<uint32_t, TimerWheelSlots> heads;
+		std::array<uint64_t, TimerWheelSlots / 64> occupied;
+	};
+
+	uint32_t allocateTimer();
+	void releaseTimer(uint32_t);
+
+	void insertTimer(uint32_t, uint64_t minTick);
+	void unlinkTimer(uint32_t);
+	uint32_t detachSlot(uint32_t level, uint32_t index);
+
+	void advanceTimers(const UpdateTime &);
+	void cascadeTimers(uint64_t tick);
+	void runTimers(uint32_t head, const UpdateTime &);
+	void stopTimer(uint32_t);
+	void cancelTimers(const void *target);
+	void resumeTimers(const void *target);
+
 	bool _locked = false;
+	bool _inUpdate = false;
 	const void *_currentTarget = nullptr;
 	SchedulerCallback *_currentNode = nullptr;
 	PriorityList<SchedulerCallback> _list;
 	Vector<ScheduledTemporary> _tmp;
+
+	bool _timerWheelInit = false;
+	uint64_t _timerTick = 0; // last processed tick
+	size_t _timersCount = 0;
+	size_t _parkedCount = 0;
+	Vector<Timer> _timers;
+	Vector<uint32_t> _freeTimers;
+	std::array<TimerWheelLevel, TimerWheelLevels> _timerWheel;
+
+	// head of timers list for every target
+	std::unordered_map<const void *, uint32_t> _timerTargets;
+	Function<void(uint64_t)> _timerCallback;
 };
 
 template <class T = Subscription>
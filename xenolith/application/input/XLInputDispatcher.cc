@@ -38,6 +38,9 @@ InputListenerStorage::InputListenerStorage(PoolRef *p) : PoolRef(p) {
 		_focus = new (_pool) memory::map<FocusGroup *, memory::vector<Rec *>>;
 		_focus->set_memory_persistent(true);
 
+		_index = new (_pool) Index;
+		_index->positions.set_memory_persistent(true);
+
 		_sceneEvents->reserve(256);
 	});
 }
@@ -48,6 +51,7 @@ void InputListenerStorage::clear() {
 		_preSceneEvents->clear();
 		_sceneEvents->clear();
 		_postSceneEvents->clear();
+		_index->clear();
 		_order = 0;
 	});
 }
@@ -59,7 +63,7 @@ void InputListenerStorage::reserve(const InputListenerStorage *st) {
 }
 
 void InputListenerStorage::addListener(NotNull<InputListener> input, FocusGroup *focus,
-		WindowLayer &&layer) {
+		WindowLayer &&layer, const Rect *bounds) {
 	perform([&, this] {
 		Rec *record = nullptr;
 		auto p = input->getPriority();
@@ -93,6 +97,10 @@ void InputListenerStorage::addListener(NotNull<InputListener> input, FocusGroup
 						Rec{input.get(), focus, sp::move(layer), ++_order});
 			}
 		}
+		if (bounds) {
+			record->bounds = *bounds;
+			record->indexed = true;
+		}
 		if (focus) {
 			auto it = _focus->find(focus);
 			if (it == _focus->end()) {
@@ -122,6 +130,149 @@ void InputListenerStorage::sort() {
 	}
 }
 
+void InputListenerStorage::buildIndex() {
+	perform([&, this] {
+		_index->clear();
+
+		auto count = _preSceneEvents->size() + _sceneEvents->size() + _postSceneEvents->size();
+		if (count < IndexThreshold) {
+			return;
+		}
+
+		_index->ordered.reserve(count);
+
+		// same order as in foreachListener
+		Rect bounds;
+		bool hasBounds = false;
+		auto addRecords = [&](memory::vector<Rec> &vec) {
+			for (auto it = vec.rbegin(); it != vec.rend(); ++it) {
+				auto pos = uint32_t(_index->ordered.size());
+				_index->ordered.emplace_back(&*it);
+				_index->positions.emplace(it->listener.get(), pos);
+				if (it->indexed) {
+					if (!hasBounds) {
+						bounds = it->bounds;
+						hasBounds = true;
+					} else {
+						bounds.merge(it->bounds);
+					}
+				}
+			}
+		};
+
+		addRecords(*_preSceneEvents);
+		addRecords(*_sceneEvents);
+		addRecords(*_postSceneEvents);
+
+		if (!hasBounds || bounds.size.width <= 0.0f || bounds.size.height <= 0.0f) {
+			_index->clear();
+			return;
+		}
+
+		// about 4 listeners per cell for uniform distribution
+		auto targetCells = std::clamp(float(count) / 4.0f, 1.0f, 4096.0f);
+		auto width = uint32_t(std::ceil(
+				std::sqrt(targetCells * bounds.size.width / bounds.size.height)));
+		width = std::clamp(width, uint32_t(1), uint32_t(256));
+		auto height = std::clamp(uint32_t(std::ceil(targetCells / width)), uint32_t(1),
+				uint32_t(256));
+
+		_index->bounds = bounds;
+		_index->width = width;
+		_index->height = height;
+		_index->scale =
+				Vec2(float(width) / bounds.size.width, float(height) / bounds.size.height);
+
+		// listeners, that covers large part of the grid, are tested for all events
+		auto maxCells = std::max(uint32_t(4), (width * height) / 8);
+
+		auto getRange = [&](const Rect &r, uint32_t &x0, uint32_t &y0, uint32_t &x1,
+								uint32_t &y1) {
+			auto cellX = [&](float v) {
+				return uint32_t(std::clamp((v - bounds.origin.x) * _index->scale.x, 0.0f,
+						float(width - 1)));
+			};
+			auto cellY = [&](float v) {
+				return uint32_t(std::clamp((v - bounds.origin.y) * _index->scale.y, 0.0f,
+						float(height - 1)));
+			};
+			x0 = cellX(r.getMinX());
+			x1 = cellX(r.getMaxX());
+			y0 = cellY(r.getMinY());
+			y1 = cellY(r.getMaxY());
+		};
+
+		// count, then fill cells in CSR layout, positions are added in ascending order
+		_index->offsets.resize(width * height + 1);
+		std::fill(_index->offsets.begin(), _index->offsets.end(), 0);
+
+		uint32_t x0, y0, x1, y1;
+		for (uint32_t pos = 0; pos < _index->ordered.size(); ++pos) {
+			auto rec = _index->ordered[pos];
+			if (!rec->indexed) {
+				continue;
+			}
+			getRange(rec->bounds, x0, y0, x1, y1);
+			if ((x1 - x0 + 1) * (y1 - y0 + 1) > maxCells) {
+				rec->indexed = false;
+				continue;
+			}
+			for (auto y = y0; y <= y1; ++y) {
+				for (auto x = x0; x <= x1; ++x) { ++_index->offsets[y * width + x + 1]; }
+			}
+		}
+
+		for (uint32_t i = 1; i < _index->offsets.size(); ++i) {
+			_index->offsets[i] += _index->offsets[i - 1];
+		}
+
+		_index->cells.resize(_index->offsets.back());
+
+		auto &fill = _index->fill;
+		fill.resize(width * height);
+		memcpy(fill.data(), _index->offsets.data(), fill.size() * sizeof(uint32_t));
+		for (uint32_t pos = 0; pos < _index->ordered.size(); ++pos) {
+			auto rec = _index->ordered[pos];
+			if (!rec->indexed) {
+				continue;
+			}
+			getRange(rec->bounds, x0, y0, x1, y1);
+			for (auto y = y0; y <= y1; ++y) {
+				for (auto x = x0; x <= x1; ++x) { _index->cells[fill[y * width + x]++] = pos; }
+			}
+		}
+
+		// records, excluded from the grid, should be tested with others
+		_index->unindexed.clear();
+		for (uint32_t pos = 0; pos < _index->ordered.size(); ++pos) {
+			if (!_index->ordered[pos]->indexed) {
+				_index->unindexed.emplace_back(pos);
+			}
+		}
+	});
+}
+
+void InputListenerStorage::Index::clear() {
+	width = height = 0;
+	ordered.clear();
+	unindexed.clear();
+	offsets.clear();
+	cells.clear();
+	fill.clear();
+	positions.clear();
+}
+
+SpanView<uint32_t> InputListenerStorage::Index::getCell(const Vec2 &loc) const {
+	if (width == 0 || !bounds.containsPoint(loc)) {
+		return SpanView<uint32_t>();
+	}
+
+	auto x = std::min(uint32_t((loc.x - bounds.origin.x) * scale.x), width - 1);
+	auto y = std::min(uint32_t((loc.y - bounds.origin.y) * scale.y), height - 1);
+	auto idx = y * width + x;
+	return SpanView<uint32_t>(cells.data() + offsets[idx], offsets[idx + 1] - offsets[idx]);
+}
+
 SpanView<InputListenerStorage::Rec *> InputListenerStorage::getFocusGroupListener(
 		FocusGroup *group) const {
 	auto it = _focus->find(group);
@@ -163,6 +314,8 @@ void InputDispatcher::commitStorage(AppWindow *window, Rc<InputListenerStorage>
 	// Sort focus groups
 	_events->sort();
 
+	_events->buildIndex();
+
 	_events->foreachFocusGroup(
 			[](NotNull<FocusGroup> group, SpanView<InputListenerStorage::Rec *> l) {
 		Vector<InputListener *> listeners;
@@ -179,7 +332,9 @@ void InputDispatcher::commitStorage(AppWindow *window, Rc<InputListenerStorage>
 		return true;
 	}, nullptr);
 
-	window->updateLayers(sp::move(layers));
+	if (window) {
+		window->updateLayers(sp::move(layers));
+	}
 }
 
 void InputDispatcher::handleInputEvent(const InputEventData &event) {
@@ -203,7 +358,7 @@ void InputDispatcher::handleInputEvent(const InputEventData &event) {
 			v->second.event = getEventInfo(event);
 		}
 
-		v->second.addListenersFromStorage(_events);
+		v->second.addListenersFromStorage(_events, _retainedListeners);
 		v->second.handle(true);
 		break;
 	}
@@ -230,7 +385,7 @@ void InputDispatcher::handleInputEvent(const InputEventData &event) {
 		_pointerLocation = event.getLocation();
 
 		EventHandlersInfo handlers{getEventInfo(event)};
-		handlers.addListenersFromStorage(_events);
+		handlers.addListenersFromStorage(_events, _retainedListeners);
 		handlers.handle(false);
 
 		for (auto &it : _activeEvents) {
@@ -247,14 +402,14 @@ void InputDispatcher::handleInputEvent(const InputEventData &event) {
 	}
 	case InputEventName::Scroll: {
 		EventHandlersInfo handlers{getEventInfo(event)};
-		handlers.addListenersFromStorage(_events);
+		handlers.addListenersFromStorage(_events, _retainedListeners);
 		handlers.handle(false);
 		break;
 	}
 	case InputEventName::WindowState: {
 		_windowState = event.window.state;
 		EventHandlersInfo handlers{getEventInfo(event)};
-		handlers.addListenersFromStorage(_events);
+		handlers.addListenersFromStorage(_events, _retainedListeners);
 		handlers.handle(false);
 
 		bool hasFocus = hasFlag(handlers.event.data.window.state, core::WindowState::Focused);
@@ -274,7 +429,7 @@ void InputDispatcher::handleInputEvent(const InputEventData &event) {
 	}
 	case InputEventName::KeyPressed: {
 		auto v = resetKey(event);
-		v->addListenersFromStorage(_events);
+		v->addListenersFromStorage(_events, _retainedListeners);
 		v->handle(true);
 		break;
 	}
@@ -310,6 +465,20 @@ void InputDispatcher::setListenerExclusiveForKey(const InputListener *l, InputKe
 	}
 }
 
+void InputDispatcher::addRetainedListener(const InputListener *l) {
+	auto it = std::find(_retainedListeners.begin(), _retainedListeners.end(), l);
+	if (it == _retainedListeners.end()) {
+		_retainedListeners.emplace_back(l);
+	}
+}
+
+void InputDispatcher::removeRetainedListener(const InputListener *l) {
+	auto it = std::find(_retainedListeners.begin(), _retainedListeners.end(), l);
+	if (it != _retainedListeners.end()) {
+		_retainedListeners.erase(it);
+	}
+}
+
 bool InputDispatcher::hasActiveInput() const {
 	return !_activeEvents.empty() || !_activeKeys.empty();
 }
@@ -442,8 +611,16 @@ void InputDispatcher::EventHandlersInfo::setExclusive(const InputListener *l) {
 }
 
 void InputDispatcher::EventHandlersInfo::addListenersFromStorage(
-		NotNull<InputListenerStorage> storage) {
-	storage->foreachListener([&](const InputListenerStorage::Rec &l) {
+		NotNull<InputListenerStorage> storage, SpanView<const InputListener *> retained) {
+	auto foreachListener = [&](const auto &cb, FocusGroup *focus) {
+		if (event.data.hasLocation()) {
+			return storage->foreachListenerAt(event.currentLocation, cb, focus, retained);
+		} else {
+			return storage->foreachListener(cb, focus);
+		}
+	};
+
+	foreachListener([&](const InputListenerStorage::Rec &l) {
 		if (l.listener->getOwner() && l.listener->canHandleEvent(event)) {
 			if (l.focus && l.focus->canHandleEvent(event)) {
 				if (hasFlag(l.focus->getFlags(), FocusGroup::Flags::Exclusive)) {
@@ -466,7 +643,7 @@ void InputDispatcher::EventHandlersInfo::addListenersFromStorage(
 
 	if (exclusiveGroup) {
 		listeners.clear();
-		storage->foreachListener([&](const InputListenerStorage::Rec &l) {
+		foreachListener([&](const InputListenerStorage::Rec &l) {
 			if (l.listener->getOwner() && l.listener->canHandleEvent(event)) {
 				if (!l.focus || l.focus->canHandleEventWithListener(event, l.listener)) {
 					listeners.emplace_back(l.listener);
@@ -39,8 +39,15 @@ public:
 		Rc<FocusGroup> focus;
 		WindowLayer layer;
 		uint32_t order = 0;
+
+		// World-space bounds, listener can be culled with spatial index if it's not hit
+		Rect bounds;
+		bool indexed = false;
 	};
 
+	// Minimal number of listeners to use spatial index
+	static constexpr uint32_t IndexThreshold = 64;
+
 	virtual ~InputListenerStorage();
 
 	InputListenerStorage(PoolRef *);
@@ -48,23 +55,53 @@ public:
 	void clear();
 	void reserve(const InputListenerStorage *);
 
-	void addListener(NotNull<InputListener>, FocusGroup *, WindowLayer &&);
+	void addListener(NotNull<InputListener>, FocusGroup *, WindowLayer &&,
+			const Rect *bounds = nullptr);
 
 	void sort();
 
+	// Build uniform grid over listener's bounds, should be called after all listeners were added
+	void buildIndex();
+
 	template <typename Callback>
 	bool foreachListener(const Callback &, FocusGroup *);
 
+	// Same as foreachListener, but only for listeners, that can be hit at location (and listeners,
+	// that can not be culled), in the same order. Retained listeners are always included.
+	template <typename Callback>
+	bool foreachListenerAt(const Vec2 &, const Callback &, FocusGroup *,
+			SpanView<const InputListener *> retained);
+
 	template <typename Callback>
 	bool foreachFocusGroup(const Callback &, FocusGroup *parentGroup);
 
 	SpanView<Rec *> getFocusGroupListener(FocusGroup *) const;
 
 protected:
+	struct Index {
+		Rect bounds;
+		Vec2 scale; // cells per unit
+		uint32_t width = 0;
+		uint32_t height = 0;
+
+		memory::vector<Rec *> ordered; // all records in foreachListener order
+		memory::vector<uint32_t> unindexed; // positions of records, that should always be tested
+		memory::vector<uint32_t> offsets; // offsets into `cells` for each cell, width * height + 1
+		memory::vector<uint32_t> cells; // sorted positions within each cell
+		memory::vector<uint32_t> fill; // temporary write positions for cells
+		memory::map<const InputListener *, uint32_t> positions;
+
+		void clear();
+		SpanView<uint32_t> getCell(const Vec2 &) const;
+	};
+
+	static bool isFocusMatch(const Rec &, FocusGroup *);
+
 	memory::vector<Rec> *_preSceneEvents = nullptr;
 	memory::vector<Rec> *_sceneEvents = nullptr; // in reverse order
 	memory::vector<Rec> *_postSceneEvents = nullptr;
 	memory::map<FocusGroup *, memory::vector<Rec *>> *_focus = nullptr;
+	Index *_index = nullptr;
 	uint32_t _order = 0;
 };
 
@@ -87,6 +124,11 @@ public:
 	void setListenerExclusiveForTouch(const InputListener *l, uint32_t);
 	void setListenerExclusiveForKey(const InputListener *l, InputKeyCode);
 
+	// Listeners with retained events can receive events outside of it's bounds, so they should
+	// bypass spatial index
+	void addRetainedListener(const InputListener *);
+	void removeRetainedListener(const InputListener *);
+
 	WindowState getWindowState() const { return _windowState; }
 	bool hasActiveInput() const;
 
@@ -110,7 +152,8 @@ protected:
 
 		void setExclusive(const InputListener *);
 
-		void addListenersFromStorage(NotNull<InputListenerStorage>);
+		void addListenersFromStorage(NotNull<InputListenerStorage>,
+				SpanView<const InputListener *> retained);
 	};
 
 	void setListenerExclusive(EventHandlersInfo &, const InputListener *l) const;
@@ -128,6 +171,7 @@ protected:
 	HashMap<uint32_t, EventHandlersInfo> _activeKeySyms;
 	Rc<InputListenerStorage> _events;
 	Rc<InputListenerStorage> _tmpEvents;
+	Vector<const InputListener *> _retainedListeners;
 	Rc<PoolRef> _pool;
 
 	Vec2 _pointerLocation = Vec2::ZERO;
@@ -155,9 +199,7 @@ bool InputListenerStorage::foreachListener(const Callback &cb, FocusGroup *focus
 	end = _preSceneEvents->rend();
 
 	for (; it != end; ++it) {
-		if (!focus || it->focus == focus
-				|| (it->focus && hasFlag(focus->getFlags(), FocusGroup::Flags::Propagate)
-						&& it->focus->isParentGroup(focus))) {
+		if (isFocusMatch(*it, focus)) {
 			if (!cb(*it)) {
 				return false;
 			}
@@ -168,9 +210,7 @@ bool InputListenerStorage::foreachListener(const Callback &cb, FocusGroup *focus
 	end = _sceneEvents->rend();
 
 	for (; it != end; ++it) {
-		if (!focus || it->focus == focus
-				|| (it->focus && hasFlag(focus->getFlags(), FocusGroup::Flags::Propagate)
-						&& it->focus->isParentGroup(focus))) {
+		if (isFocusMatch(*it, focus)) {
 			if (!cb(*it)) {
 				return false;
 			}
@@ -181,9 +221,7 @@ bool InputListenerStorage::foreachListener(const Callback &cb, FocusGroup *focus
 	end = _postSceneEvents->rend();
 
 	for (; it != end; ++it) {
-		if (!focus || it->focus == focus
-				|| (it->focus && hasFlag(focus->getFlags(), FocusGroup::Flags::Propagate)
-						&& it->focus->isParentGroup(focus))) {
+		if (isFocusMatch(*it, focus)) {
 			if (!cb(*it)) {
 				return false;
 			}
@@ -193,6 +231,78 @@ bool InputListenerStorage::foreachListener(const Callback &cb, FocusGroup *focus
 	return true;
 }
 
+template <typename Callback>
+bool InputListenerStorage::foreachListenerAt(const Vec2 &loc, const Callback &cb,
+		FocusGroup *focus, SpanView<const InputListener *> retained) {
+	static_assert(std::is_invocable_v<Callback, const Rec &>, "Invalid callback type");
+
+	if (_index->width == 0 || (focus && !hasFlag(focus->getFlags(), FocusGroup::Flags::Propagate))) {
+		return foreachListener(cb, focus);
+	}
+
+	auto cell = _index->getCell(loc);
+	auto &always = _index->unindexed;
+
+	std::array<uint32_t, 8> retainedPositions;
+	size_t retainedCount = 0;
+	for (auto &it : retained) {
+		auto pos = _index->positions.find(it);
+		if (pos != _index->positions.end()) {
+			if (retainedCount == retainedPositions.size()) {
+				// too many retained listeners, use full iteration
+				return foreachListener(cb, focus);
+			}
+			retainedPositions[retainedCount++] = pos->second;
+		}
+	}
+	std::sort(retainedPositions.begin(), retainedPositions.begin() + retainedCount);
+
+	// merge sorted positions to preserve original order
+	size_t a = 0, b = 0, c = 0;
+	uint32_t last = maxOf<uint32_t>();
+	while (a < cell.size() || b < always.size() || c < retainedCount) {
+		auto next = maxOf<uint32_t>();
+		if (a < cell.size()) {
+			next = std::min(next, cell[a]);
+		}
+		if (b < always.size()) {
+			next = std::min(next, always[b]);
+		}
+		if (c < retainedCount) {
+			next = std::min(next, retainedPositions[c]);
+		}
+
+		if (a < cell.size() && cell[a] == next) {
+			++a;
+		}
+		if (b < always.size() && always[b] == next) {
+			++b;
+		}
+		if (c < retainedCount && retainedPositions[c] == next) {
+			++c;
+		}
+
+		if (next == last) {
+			continue;
+		}
+		last = next;
+
+		auto rec = _index->ordered[next];
+		if (isFocusMatch(*rec, focus)) {
+			if (!cb(*rec)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+inline bool InputListenerStorage::isFocusMatch(const Rec &rec, FocusGroup *focus) {
+	return !focus || rec.focus == focus
+			|| (rec.focus && hasFlag(focus->getFlags(), FocusGroup::Flags::Propagate)
+					&& rec.focus->isParentGroup(focus));
+}
+
 template <typename Callback>
 bool InputListenerStorage::foreachFocusGroup(const Callback &cb, FocusGroup *parentGroup) {
 	static_assert(std::is_invocable_v<Callback, NotNull<FocusGroup>, SpanView<Rec *>>,
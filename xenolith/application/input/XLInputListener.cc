@@ -115,6 +115,13 @@ void InputListener::handleExit() {
 	if (_hasFocus) {
 		handleFocusOut(nullptr);
 	}
+
+	if (!_retainedEvents.empty()) {
+		if (auto dispatcher = getInputDispatcher()) {
+			dispatcher->removeRetainedListener(this);
+		}
+	}
+
 	_scene = nullptr;
 
 	System::handleExit();
@@ -126,16 +133,32 @@ void InputListener::handleVisitSelf(FrameInfo &info, Node *node, NodeVisitFlags
 	if (_enabled) {
 		auto g = info.getSystem<FocusGroup>(FocusGroup::Id);
 
+		// Listeners with default hit-test and 2D transform can be culled by spatial index
+		auto &transform = info.modelTransformStack.back();
+		Rect bounds;
+		bool indexed = false;
+		if (!_eventFilter && _retainedEvents.empty() && transform.m[2] == 0.0f
+				&& transform.m[3] == 0.0f && transform.m[6] == 0.0f && transform.m[7] == 0.0f
+				&& transform.m[8] == 0.0f && transform.m[9] == 0.0f && transform.m[11] == 0.0f
+				&& transform.m[15] == 1.0f) {
+			auto size = node->getContentSize();
+			bounds = TransformRect(Rect(-_touchPadding, -_touchPadding,
+										   size.width + _touchPadding * 2.0f,
+										   size.height + _touchPadding * 2.0f),
+					transform);
+			indexed = true;
+		}
+
 		if (_windowLayer) {
 			WindowLayer layer{
-				TransformRect(Rect(Vec2(0, 0), node->getContentSize()),
-						info.modelTransformStack.back()),
+				TransformRect(Rect(Vec2(0, 0), node->getContentSize()), transform),
 				_windowLayer.cursor,
 				_windowLayer.flags,
 			};
-			info.input->addListener(this, g, sp::move(layer));
+			info.input->addListener(this, g, sp::move(layer), indexed ? &bounds : nullptr);
 		} else {
-			info.input->addListener(this, g, WindowLayer(_windowLayer));
+			info.input->addListener(this, g, WindowLayer(_windowLayer),
+					indexed ? &bounds : nullptr);
 		}
 	}
 }
@@ -437,6 +460,11 @@ void InputListener::retainEvent(core::InputEventName name) {
 	if (it != _retainedEvents.end()) {
 		++it->second;
 	} else {
+		if (_retainedEvents.empty()) {
+			if (auto dispatcher = getInputDispatcher()) {
+				dispatcher->addRetainedListener(this);
+			}
+		}
 		_retainedEvents.emplace(name, 1);
 	}
 }
@@ -446,12 +474,26 @@ void InputListener::releaseEvent(core::InputEventName name) {
 	if (it != _retainedEvents.end()) {
 		if (it->second == 1) {
 			_retainedEvents.erase(it);
+			if (_retainedEvents.empty()) {
+				if (auto dispatcher = getInputDispatcher()) {
+					dispatcher->removeRetainedListener(this);
+				}
+			}
 		} else {
 			--it->second;
 		}
 	}
 }
 
+InputDispatcher *InputListener::getInputDispatcher() const {
+	if (_scene) {
+		if (auto dir = _scene->getDirector()) {
+			return dir->getInputDispatcher();
+		}
+	}
+	return nullptr;
+}
+
 void InputListener::makeDelay() {
 	if (_running) {
 		_owner->runAction(Rc<RenderContinuously>::create(1.0f));
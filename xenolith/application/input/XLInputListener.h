@@ -33,6 +33,7 @@ class Node;
 class Scene;
 class GestureRecognizer;
 class FocusGroup;
+class InputDispatcher;
 
 class SP_PUBLIC InputListener : public System {
 public:
@@ -162,6 +163,8 @@ protected:
 	void releaseEvent(core::InputEventName);
 	void makeDelay();
 
+	InputDispatcher *getInputDispatcher() const;
+
 	int32_t _priority = 0; // 0 - scene graph
 	uint64_t _id = 0;
 	EventMask _eventMask;
@@ -156,6 +156,12 @@ Mat4 Node::getChainParentToNodeTransform(Node *parent, Node *node, bool withPare
 Node::Node() { }
 
 Node::~Node() {
+	if (_transformTreeRoot) {
+		_transformTreeRoot->clear();
+	} else if (_transformTree) {
+		_transformTree->invalidate();
+	}
+
 	for (auto &child : _children) { child->_parent = nullptr; }
 
 	// stopAllActions();
@@ -184,7 +190,7 @@ void Node::setScale(float scale) {
 	}
 
 	_scale.x = _scale.y = _scale.z = scale;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setScale(const Vec2 &scale) {
@@ -194,7 +200,7 @@ void Node::setScale(const Vec2 &scale) {
 
 	_scale.x = scale.x;
 	_scale.y = scale.y;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setScale(const Vec3 &scale) {
@@ -203,7 +209,7 @@ void Node::setScale(const Vec3 &scale) {
 	}
 
 	_scale = scale;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setScaleX(float scaleX) {
@@ -212,7 +218,7 @@ void Node::setScaleX(float scaleX) {
 	}
 
 	_scale.x = scaleX;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setScaleY(float scaleY) {
@@ -221,7 +227,7 @@ void Node::setScaleY(float scaleY) {
 	}
 
 	_scale.y = scaleY;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setScaleZ(float scaleZ) {
@@ -230,7 +236,7 @@ void Node::setScaleZ(float scaleZ) {
 	}
 
 	_scale.z = scaleZ;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setPosition(const Vec2 &position) {
@@ -240,7 +246,7 @@ void Node::setPosition(const Vec2 &position) {
 
 	_position.x = position.x;
 	_position.y = position.y;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setPosition(const Vec3 &position) {
@@ -249,7 +255,7 @@ void Node::setPosition(const Vec3 &position) {
 	}
 
 	_position = position;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setPositionX(float value) {
@@ -258,7 +264,7 @@ void Node::setPositionX(float value) {
 	}
 
 	_position.x = value;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setPositionY(float value) {
@@ -267,7 +273,7 @@ void Node::setPositionY(float value) {
 	}
 
 	_position.y = value;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setPositionZ(float value) {
@@ -276,7 +282,7 @@ void Node::setPositionZ(float value) {
 	}
 
 	_position.z = value;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setSkewX(float skewX) {
@@ -285,7 +291,7 @@ void Node::setSkewX(float skewX) {
 	}
 
 	_skew.x = skewX;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setSkewY(float skewY) {
@@ -294,7 +300,7 @@ void Node::setSkewY(float skewY) {
 	}
 
 	_skew.y = skewY;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setAnchorPoint(const Vec2 &point) {
@@ -303,7 +309,7 @@ void Node::setAnchorPoint(const Vec2 &point) {
 	}
 
 	_anchorPoint = point;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::setContentSize(const Size2 &size) {
@@ -312,7 +318,8 @@ void Node::setContentSize(const Size2 &size) {
 	}
 
 	_contentSize = size;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = _contentSizeDirty = true;
+	_contentSizeDirty = true;
+	markTransformDirty();
 }
 
 void Node::setVisible(bool visible) {
@@ -321,7 +328,8 @@ void Node::setVisible(bool visible) {
 	}
 	_visible = visible;
 	if (_visible) {
-		_contentSizeDirty = _transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+		_contentSizeDirty = true;
+		markTransformDirty();
 	}
 }
 
@@ -331,7 +339,7 @@ void Node::setRotation(float rotation) {
 	}
 
 	_rotation = Vec3(0.0f, 0.0f, rotation);
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 	_rotationQuat = Quaternion(_rotation);
 }
 
@@ -341,7 +349,7 @@ void Node::setRotation(const Vec3 &rotation) {
 	}
 
 	_rotation = rotation;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 	_rotationQuat = Quaternion(_rotation);
 }
 
@@ -352,7 +360,7 @@ void Node::setRotation(const Quaternion &quat) {
 
 	_rotationQuat = quat;
 	_rotation = _rotationQuat.toEulerAngles();
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	markTransformDirty();
 }
 
 void Node::addChildNode(Node *child) { addChildNode(child, child->_zOrder, InvalidTag); }
@@ -407,8 +415,21 @@ void Node::setParent(Node *parent) {
 	if (parent == _parent) {
 		return;
 	}
+
+	// hierarchy changed, parent's TransformTree should be rebuilt
+	if (_transformTree && _transformTree != _transformTreeRoot) {
+		auto tree = _transformTree;
+		tree->invalidate();
+		detachTransformTree(tree);
+	}
+
 	_parent = parent;
-	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+
+	if (_parent && _parent->_transformTree) {
+		_parent->_transformTree->invalidate();
+	}
+
+	markTransformDirty();
 }
 
 void Node::removeFromParent(bool cleanup) {
@@ -550,6 +571,50 @@ Action *Node::getActionByTag(uint32_t tag) {
 	return nullptr;
 }
 
+bool Node::runTween(TweenProperty prop, float duration, const Vec3 &value,
+		interpolation::Type type, uint32_t tag) {
+	if (_actionManager) {
+		return _actionManager->addTween(this, prop, duration, value, type, tag, !_running);
+	}
+	return false;
+}
+
+bool Node::runTween(TweenProperty prop, float duration, const Vec2 &value,
+		interpolation::Type type, uint32_t tag) {
+	switch (prop) {
+	case TweenProperty::Position:
+		return runTween(prop, duration, Vec3(value.x, value.y, nan()), type, tag);
+		break;
+	case TweenProperty::Scale:
+		return runTween(prop, duration, Vec3(value.x, value.y, nan()), type, tag);
+		break;
+	case TweenProperty::Rotation:
+	case TweenProperty::Opacity:
+		log::source().error("Node", "Vec2 value is not applicable for tween property");
+		break;
+	}
+	return false;
+}
+
+bool Node::runTween(TweenProperty prop, float duration, float value, interpolation::Type type,
+		uint32_t tag) {
+	switch (prop) {
+	case TweenProperty::Position:
+		log::source().error("Node", "Scalar value is not applicable for position tween");
+		break;
+	case TweenProperty::Scale:
+		return runTween(prop, duration, Vec3(value, value, value), type, tag);
+		break;
+	case TweenProperty::Rotation:
+		return runTween(prop, duration, Vec3(nan(), nan(), value), type, tag);
+		break;
+	case TweenProperty::Opacity:
+		return runTween(prop, duration, Vec3(value, nan(), nan()), type, tag);
+		break;
+	}
+	return false;
+}
+
 size_t Node::getNumberOfRunningActions() const {
 	if (_actionManager) {
 		return _actionManager->getNumberOfRunningActionsInTarget(this);
@@ -749,6 +814,10 @@ void Node::handleEnter(Scene *scene) {
 		_scheduler->scheduleUpdate(this, 0, _paused);
 	}
 
+	if (_transformTreeRoot) {
+		updateTransformTreeParallelInfo();
+	}
+
 	_running = true;
 	this->resume();
 }
@@ -967,6 +1036,9 @@ void Node::setNodeToParentTransform(const Mat4 &transform) {
 	_transform = transform;
 	_transformCacheDirty = false;
 	_transformDirty = true;
+	if (_transformTree) {
+		_transformTree->markDirty(this);
+	}
 }
 
 const Mat4 &Node::getParentToNodeTransform() const {
@@ -979,6 +1051,13 @@ const Mat4 &Node::getParentToNodeTransform() const {
 }
 
 Mat4 Node::getNodeToWorldTransform() const {
+	if (_transformTree) {
+		Mat4 ret;
+		if (_transformTree->getNodeToWorldTransform(this, ret)) {
+			return ret;
+		}
+	}
+
 	Mat4 t(this->getNodeToParentTransform());
 
 	for (Node *p = _parent; p != nullptr; p = p->getParent()) {
@@ -990,6 +1069,39 @@ Mat4 Node::getNodeToWorldTransform() const {
 
 Mat4 Node::getWorldToNodeTransform() const { return getNodeToWorldTransform().getInversed(); }
 
+void Node::setTransformTreeEnabled(bool value) {
+	if (value == isTransformTreeEnabled()) {
+		return;
+	}
+
+	if (value) {
+		// node is no longer a member of the parent's tree
+		if (_transformTree) {
+			auto tree = _transformTree;
+			tree->invalidate();
+			detachTransformTree(tree);
+		}
+
+		_transformTreeRoot = Rc<TransformTree>::create(this);
+		_transformTree = _transformTreeRoot;
+		_transformTreeIndex = 0;
+		if (_running) {
+			updateTransformTreeParallelInfo();
+		}
+	} else {
+		_transformTreeRoot->clear();
+		_transformTreeRoot = nullptr;
+		_transformTree = nullptr;
+		_transformTreeIndex = TransformTree::None;
+
+		// subtree can be included into the parent's tree
+		if (_parent && _parent->_transformTree) {
+			_parent->_transformTree->invalidate();
+		}
+	}
+	_transformDirty = true;
+}
+
 Vec2 Node::convertToNodeSpace(const Vec2 &worldPoint) const {
 	Mat4 tmp = getWorldToNodeTransform();
 	return tmp.transformPoint(worldPoint);
@@ -1238,6 +1350,37 @@ Mat4 Node::transform(const Mat4 &parentTransform) {
 	return parentTransform * this->getNodeToParentTransform();
 }
 
+void Node::markTransformDirty() {
+	_transformInverseDirty = _transformCacheDirty = _transformDirty = true;
+	if (_transformTree) {
+		_transformTree->markDirty(this);
+	}
+}
+
+void Node::detachTransformTree(TransformTree *tree) {
+	if (_transformTree != tree) {
+		return;
+	}
+
+	_transformTree = nullptr;
+	_transformTreeIndex = TransformTree::None;
+	for (auto &it : _children) { it->detachTransformTree(tree); }
+}
+
+void Node::updateTransformTreeParallelInfo() {
+	TransformTree::ParallelInfo info;
+	if (_director) {
+		if (auto app = _director->getApplication()) {
+			auto looper = app->getLooper();
+			info.threadCount = looper->getThreadPool()->getInfo().threadCount;
+			info.dispatch = [looper, app = Rc<AppThread>(app)](Function<void()> &&fn) {
+				looper->performAsync(sp::move(fn), app.get());
+			};
+		}
+	}
+	_transformTreeRoot->setParallelInfo(sp::move(info));
+}
+
 NodeVisitFlags Node::processParentFlags(FrameInfo &info, NodeVisitFlags parentFlags) {
 	NodeVisitFlags flags = parentFlags;
 
@@ -1249,7 +1392,17 @@ NodeVisitFlags Node::processParentFlags(FrameInfo &info, NodeVisitFlags parentFl
 
 	if ((flags & NodeVisitFlags::GlobalTransformDirtyMask) != NodeVisitFlags::None
 			|| _transformDirty || _contentSizeDirty) {
-		_modelViewTransform = this->transform(info.modelTransformStack.back());
+		const Mat4 *treeTransform = nullptr;
+		if (_transformTree) {
+			treeTransform =
+					_transformTree->getVisitTransform(this, info.modelTransformStack.back());
+		}
+
+		if (treeTransform) {
+			_modelViewTransform = *treeTransform;
+		} else {
+			_modelViewTransform = this->transform(info.modelTransformStack.back());
+		}
 
 		handleGlobalTransformDirty(info.modelTransformStack.back());
 	}
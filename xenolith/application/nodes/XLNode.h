@@ -26,6 +26,8 @@
 #include "XLNodeInfo.h"
 #include "XLSystem.h"
 #include "XLComponent.h"
+#include "XLTransformTree.h"
+#include "XLInterpolation.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith {
 
@@ -37,6 +39,8 @@ class InputListener;
 class Action;
 class ActionManager;
 class Director;
+
+enum class TweenProperty : uint8_t;
 class FrameContext;
 
 struct SP_PUBLIC ActionStorage : public Ref {
@@ -203,6 +207,22 @@ public:
 	Action *getActionByTag(uint32_t tag);
 	size_t getNumberOfRunningActions() const;
 
+	/** Runs batched tween (see TweenBatch), lightweight alternative for MoveTo/ScaleTo/FadeTo
+	 * Node should be attached to running scene, returns false otherwise.
+	 * Tweens are stopped with stopAllActions and stopAllActionsByTag.
+	 */
+	bool runTween(TweenProperty, float duration, const Vec3 &,
+			interpolation::Type = interpolation::Linear, uint32_t tag = maxOf<uint32_t>());
+
+	// Position in XY plane, Z component is preserved
+	bool runTween(TweenProperty, float duration, const Vec2 &,
+			interpolation::Type = interpolation::Linear, uint32_t tag = maxOf<uint32_t>());
+
+	// Uniform scale, opacity or rotation around Z axis
+	// Position has no scalar form, use Vec2 or Vec3 overload
+	bool runTween(TweenProperty, float duration, float,
+			interpolation::Type = interpolation::Linear, uint32_t tag = maxOf<uint32_t>());
+
 	template <typename C>
 	auto addSystem(C *system) -> C * {
 		if (addSystemItem(system)) {
@@ -293,6 +313,14 @@ public:
 	virtual Mat4 getNodeToWorldTransform() const;
 	virtual Mat4 getWorldToNodeTransform() const;
 
+	// Store transforms of the node's subtree in TransformTree, recommended for subtrees with
+	// large number of nodes (like scrollable lists)
+	virtual void setTransformTreeEnabled(bool);
+	virtual bool isTransformTreeEnabled() const { return _transformTreeRoot != nullptr; }
+
+	// TransformTree, that contains this node, if any
+	TransformTree *getTransformTree() const { return _transformTree; }
+
 	Vec2 convertToNodeSpace(const Vec2 &worldPoint) const;
 	Vec2 convertToWorldSpace(const Vec2 &nodePoint) const;
 	Vec2 convertToNodeSpaceAR(const Vec2 &worldPoint) const;
@@ -378,6 +406,8 @@ public:
 			uint32_t maxDepth = 0);
 
 protected:
+	friend class TransformTree;
+
 	struct VisitInfo {
 		void (*visitBegin)(const VisitInfo &) = nullptr;
 		void (*visitNodesBelow)(const VisitInfo &, SpanView<Rc<Node>>) = nullptr;
@@ -399,6 +429,10 @@ protected:
 	virtual void updateColor() { }
 
 	Mat4 transform(const Mat4 &parentTransform);
+
+	void markTransformDirty();
+	void detachTransformTree(TransformTree *);
+	void updateTransformTreeParallelInfo();
 	virtual NodeVisitFlags processParentFlags(FrameInfo &info, NodeVisitFlags parentFlags);
 
 	virtual bool wrapVisit(FrameInfo &, NodeVisitFlags flags, const VisitInfo &, bool useContext);
@@ -452,6 +486,10 @@ protected:
 	Vector<Rc<Node>> _children;
 	Node *_parent = nullptr;
 
+	Rc<TransformTree> _transformTreeRoot;
+	TransformTree *_transformTree = nullptr;
+	uint32_t _transformTreeIndex = TransformTree::None;
+
 	Vector<Rc<System>> _systems;
 
 	Scene *_scene = nullptr;
@@ -95,8 +95,15 @@ void Scene::render(FrameInfo &info) {
 
 	info.input = eventDispatcher->acquireNewStorage();
 
-	visitGeometry(info, NodeVisitFlags::None);
-	visitDraw(info, NodeVisitFlags::None);
+	do {
+		XL_PROFILE_ZONE("Scene::visitGeometry", "scene");
+		visitGeometry(info, NodeVisitFlags::None);
+	} while (0);
+
+	do {
+		XL_PROFILE_ZONE("Scene::visitDraw", "scene");
+		visitDraw(info, NodeVisitFlags::None);
+	} while (0);
 
 	eventDispatcher->commitStorage(_director->getWindow(), move(info.input));
 }
@@ -139,7 +146,7 @@ void Scene::handlePresented(Director *dir) {
 		auto cache = dir->getResourceCache();
 		if (cache) {
 			cache->addResource(res);
-		} else {
+		} else if (dir->getApplication()) {
 			log::source().error("Director", "ResourceCache is not loaded");
 		}
 	}
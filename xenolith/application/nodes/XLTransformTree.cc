@@ -0,0 +1,300 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLTransformTree.h"
+#include "XLNode.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith {
+
+struct TransformTree::UpdateJob : public Ref {
+	TransformTree *tree = nullptr;
+	uint32_t chunks = 0;
+
+	std::atomic<uint32_t> next = 0;
+	std::atomic<uint32_t> complete = 0;
+
+	void run() {
+		auto chunk = next.fetch_add(1);
+		while (chunk < chunks) {
+			auto idx = tree->_branches[chunk];
+			tree->propagate(idx, tree->_subtreeEnd[idx], None);
+			complete.fetch_add(1);
+			chunk = next.fetch_add(1);
+		}
+	}
+};
+
+static bool TransformTree_isEqual(const Mat4 &l, const Mat4 &r) {
+	// parent transform can be calculated in different order from visit stack or parent chain,
+	// so, allow small difference to prevent full updates
+	for (size_t i = 0; i < 16; ++i) {
+		if (std::abs(l.m[i] - r.m[i]) > std::numeric_limits<float>::epsilon() * 16.0f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TransformTree::~TransformTree() { clear(); }
+
+bool TransformTree::init(Node *root) {
+	_root = root;
+	return true;
+}
+
+void TransformTree::setParallelInfo(ParallelInfo &&info) {
+	_parallel = sp::move(info);
+	invalidate();
+}
+
+void TransformTree::clear() { invalidate(); }
+
+void TransformTree::invalidate() {
+	// nodes can be removed from hierarchy or destroyed after this call, so, membership should
+	// be released here, it will be restored with rebuild
+	for (auto &it : _nodes) {
+		if (it->_transformTree == this && it != _root) {
+			it->_transformTree = nullptr;
+			it->_transformTreeIndex = None;
+		}
+	}
+	_nodes.clear();
+	_dirtyList.clear();
+	_branches.clear();
+	_valid = false;
+}
+
+void TransformTree::markDirty(const Node *node) {
+	if (!_valid || node->_transformTree != this) {
+		return;
+	}
+
+	auto idx = node->_transformTreeIndex;
+	if ((_flags[idx] & EntryDirty) == 0) {
+		_flags[idx] |= EntryDirty;
+		_dirtyList.emplace_back(idx);
+	}
+
+	auto p = _parents[idx];
+	while (p != None && (_flags[p] & EntryChildDirty) == 0) {
+		_flags[p] |= EntryChildDirty;
+		p = _parents[p];
+	}
+
+	_dirty = true;
+}
+
+void TransformTree::update(const Mat4 &parentWorld) {
+	if (!_valid || !TransformTree_isEqual(_parentWorld, parentWorld)) {
+		_parentWorld = parentWorld;
+		_parentChanged = true;
+	}
+	update();
+}
+
+void TransformTree::update() {
+	if (!_valid) {
+		rebuild();
+	}
+
+	if (!_dirty && !_parentChanged) {
+		return;
+	}
+
+	auto size = uint32_t(_nodes.size());
+
+	// estimate amount of work with dirty subtrees size
+	uint32_t work = _parentChanged ? size : 0;
+	for (auto idx : _dirtyList) {
+		_local[idx] = _nodes[idx]->getNodeToParentTransform();
+		if (work < size) {
+			work += _subtreeEnd[idx] - idx;
+		}
+	}
+	_dirtyList.clear();
+
+	if (++_epoch == 0) {
+		std::fill(_updated.begin(), _updated.end(), 0);
+		_epoch = 1;
+	}
+
+	if (_splitDepth > 0 && work >= _parallel.threshold) {
+		// common part of the tree, then independent branches
+		propagate(0, size, _splitDepth);
+
+		auto job = Rc<UpdateJob>::alloc();
+		job->tree = this;
+		job->chunks = uint32_t(_branches.size());
+
+		for (uint32_t i = 1; i < std::min(_parallel.threadCount, job->chunks); ++i) {
+			_parallel.dispatch([job] { job->run(); });
+		}
+
+		job->run();
+		while (job->complete.load() < job->chunks) { std::this_thread::yield(); }
+	} else {
+		propagate(0, size, None);
+	}
+
+	_dirty = false;
+	_parentChanged = false;
+}
+
+const Mat4 *TransformTree::getVisitTransform(const Node *node, const Mat4 &parentTransform) {
+	if (node == _root) {
+		update(parentTransform);
+	} else if (isDirty()) {
+		update();
+	}
+
+	if (node->_transformTree != this) {
+		return nullptr;
+	}
+	return &_world[node->_transformTreeIndex];
+}
+
+bool TransformTree::getNodeToWorldTransform(const Node *node, Mat4 &ret) {
+	auto parent = _root->getParent();
+	update(parent ? parent->getNodeToWorldTransform() : Mat4::IDENTITY);
+
+	if (node->_transformTree != this) {
+		return false;
+	}
+	ret = _world[node->_transformTreeIndex];
+	return true;
+}
+
+void TransformTree::rebuild() {
+	_nodes.clear();
+	_parents.clear();
+	_depth.clear();
+
+	struct StackItem {
+		Node *node;
+		uint32_t parent;
+		uint32_t depth;
+	};
+
+	Vector<StackItem> stack;
+	stack.emplace_back(StackItem{_root, None, 0});
+
+	// pre-order DFS, children pushed in reverse to preserve order
+	while (!stack.empty()) {
+		auto item = stack.back();
+		stack.pop_back();
+
+		auto idx = uint32_t(_nodes.size());
+		item.node->_transformTree = this;
+		item.node->_transformTreeIndex = idx;
+
+		_nodes.emplace_back(item.node);
+		_parents.emplace_back(item.parent);
+		_depth.emplace_back(item.depth);
+
+		auto &children = item.node->_children;
+		for (auto it = children.rbegin(); it != children.rend(); ++it) {
+			// nodes with own tree processed separately
+			if (*it && !(*it)->_transformTreeRoot) {
+				stack.emplace_back(StackItem{it->get(), idx, item.depth + 1});
+			}
+		}
+	}
+
+	auto size = uint32_t(_nodes.size());
+
+	// subtree sizes, then subtree bounds
+	_subtreeEnd.assign(size, 1);
+	for (uint32_t i = size - 1; i > 0; --i) { _subtreeEnd[_parents[i]] += _subtreeEnd[i]; }
+	for (uint32_t i = 0; i < size; ++i) { _subtreeEnd[i] += i; }
+
+	_flags.assign(size, EntryClean);
+	_updated.assign(size, 0);
+	_epoch = 0;
+
+	_local.resize(size);
+	_world.resize(size);
+	for (uint32_t i = 0; i < size; ++i) { _local[i] = _nodes[i]->getNodeToParentTransform(); }
+
+	// select the first level with enough branches to load all threads
+	_splitDepth = 0;
+	_branches.clear();
+	if (_parallel.threadCount > 1 && _parallel.dispatch && size >= _parallel.threshold) {
+		Vector<uint32_t> levels;
+		for (auto d : _depth) {
+			if (d >= levels.size()) {
+				levels.resize(d + 1, 0);
+			}
+			++levels[d];
+		}
+
+		uint32_t best = 0;
+		for (uint32_t d = 1; d < levels.size(); ++d) {
+			if (levels[d] >= _parallel.threadCount * 2) {
+				best = d;
+				break;
+			} else if (best == 0 || levels[d] > levels[best]) {
+				best = d;
+			}
+		}
+
+		if (best > 0 && levels[best] > 1) {
+			_splitDepth = best;
+			for (uint32_t i = 0; i < size; ++i) {
+				if (_depth[i] == _splitDepth) {
+					_branches.emplace_back(i);
+				}
+			}
+		}
+	}
+
+	_dirtyList.clear();
+	_valid = true;
+	_dirty = true;
+	_parentChanged = true;
+}
+
+void TransformTree::propagate(uint32_t first, uint32_t last, uint32_t stopDepth) {
+	auto i = first;
+	while (i < last) {
+		if (_depth[i] == stopDepth) {
+			i = _subtreeEnd[i];
+			continue;
+		}
+
+		auto p = _parents[i];
+		auto flags = _flags[i];
+		_flags[i] = EntryClean;
+
+		if ((p == None ? _parentChanged : _updated[p] == _epoch) || (flags & EntryDirty)) {
+			_world[i] = (p == None ? _parentWorld : _world[p]) * _local[i];
+			_updated[i] = _epoch;
+			++i;
+		} else if (flags & EntryChildDirty) {
+			++i;
+		} else {
+			// clean subtree
+			i = _subtreeEnd[i];
+		}
+	}
+}
+
+} // namespace stappler::xenolith
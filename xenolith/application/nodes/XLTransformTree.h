@@ -0,0 +1,137 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_APPLICATION_NODES_XLTRANSFORMTREE_H_
+#define XENOLITH_APPLICATION_NODES_XLTRANSFORMTREE_H_
+
+#include "XLNodeInfo.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith {
+
+class Node;
+
+/** TransformTree stores local and world transforms for the node's subtree in contiguous arrays
+in depth-first order.
+
+Node's setters mark entries as dirty, and only dirty subtrees are recomputed on update. When
+subtree is large enough, independent branches are processed in parallel with the dispatch function.
+
+Nodes that own their own TransformTree are not included into the parent's tree.
+Any structural change (child added or removed) invalidates tree, it will be rebuilt on next update.
+*/
+class SP_PUBLIC TransformTree : public Ref {
+public:
+	static constexpr uint32_t None = maxOf<uint32_t>();
+
+	struct ParallelInfo {
+		// minimal number of entries to update in parallel
+		uint32_t threshold = config::TransformTreeParallelThreshold;
+		uint32_t threadCount = 0;
+		Function<void(Function<void()> &&)> dispatch;
+	};
+
+	virtual ~TransformTree();
+
+	bool init(Node *root);
+
+	void setParallelInfo(ParallelInfo &&);
+
+	// Releases all nodes from tree, called by root node on destruction
+	void clear();
+
+	// Mark tree for rebuild on structural changes
+	void invalidate();
+
+	// Mark node's local transform as changed
+	void markDirty(const Node *);
+
+	bool isValid() const { return _valid; }
+	bool isDirty() const { return !_valid || _dirty; }
+
+	Node *getRoot() const { return _root; }
+	size_t size() const { return _nodes.size(); }
+
+	// Update with transform of the root's parent
+	void update(const Mat4 &parentWorld);
+
+	// Update with last known parent transform (to apply changes in the middle of the visit)
+	void update();
+
+	// Transform for the node within the visit: root uses transform from the visit stack, members
+	// use transforms, calculated for the root. Returns nullptr if node is not in the tree.
+	const Mat4 *getVisitTransform(const Node *, const Mat4 &parentTransform);
+
+	// World transform for the node with the actual root's parent transform
+	// Returns false if node is not in the tree
+	bool getNodeToWorldTransform(const Node *, Mat4 &);
+
+protected:
+	struct UpdateJob;
+
+	enum EntryFlags : uint8_t {
+		EntryClean = 0,
+		EntryDirty = 1 << 0,
+		EntryChildDirty = 1 << 1,
+	};
+
+	void rebuild();
+
+	// Process [first, last) in depth-first order, subtrees of entries with depth == stopDepth
+	// are skipped, they should be processed with separate calls
+	void propagate(uint32_t first, uint32_t last, uint32_t stopDepth);
+
+	Node *_root = nullptr;
+
+	bool _valid = false;
+	bool _dirty = true;
+	bool _parentChanged = true;
+
+	// update counter, world transform for the entry is updated in current pass if
+	// _updated[idx] == _epoch
+	uint32_t _epoch = 0;
+
+	// depth for the independent subtrees, that can be processed in parallel (0 - no parallel update)
+	uint32_t _splitDepth = 0;
+
+	Mat4 _parentWorld = Mat4::IDENTITY;
+
+	Vector<Node *> _nodes;
+	Vector<uint32_t> _parents;
+	Vector<uint32_t> _subtreeEnd;
+	Vector<uint32_t> _depth;
+	Vector<uint32_t> _updated;
+	Vector<uint8_t> _flags;
+	Vector<Mat4> _local;
+	Vector<Mat4> _world;
+
+	// entries to read local transform from nodes on next update
+	Vector<uint32_t> _dirtyList;
+
+	// roots of the subtrees with _splitDepth
+	Vector<uint32_t> _branches;
+
+	ParallelInfo _parallel;
+};
+
+} // namespace stappler::xenolith
+
+#endif /* XENOLITH_APPLICATION_NODES_XLTRANSFORMTREE_H_ */
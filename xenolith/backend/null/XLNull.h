@@ -0,0 +1,68 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULL_H_
+#define XENOLITH_BACKEND_NULL_XLNULL_H_
+
+#include "XLCommon.h" // IWYU pragma: keep
+#include "XLCoreEnum.h"
+#include "XLCoreInstance.h"
+
+/* Headless null backend
+ *
+ * Implements core::Instance, core::Loop and core::Device without any GPU API. All device objects
+ * are CPU-side stand-ins with unique handles, queue submissions are "executed" by arming a fence,
+ * that becomes signaled after simulated GPU latency. Latency is configured with
+ * null::LoopBackendInfo, and can depend on workload, recorded by passes into command buffers.
+ *
+ * Backend is intended for CI, profiling and frame-time benchmarking of engine-side work
+ * (scene graph traversal, command list construction, vertex processing, frame scheduling).
+ */
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+class Instance;
+class Device;
+class Loop;
+
+struct SP_PUBLIC LoopBackendInfo : public core::LoopBackendInfo {
+	// Fixed simulated cost of every queue submission
+	TimeInterval submitLatency = TimeInterval::microseconds(500);
+
+	// Simulated cost of a single workload unit (in nanoseconds), recorded into command buffers
+	// with CommandBuffer::addWorkload
+	double workloadLatencyNanos = 0.0;
+
+	// Number of simulated queues in the device queue family
+	uint32_t queueCount = 2;
+
+	virtual ~LoopBackendInfo() = default;
+
+	virtual Value encode() const override;
+};
+
+// Unique non-zero handle for the null device object
+SP_PUBLIC core::ObjectHandle makeObjectHandle();
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULL_H_ */
@@ -0,0 +1,61 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullAttachment.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+auto BufferAttachment::makeFrameHandle(const FrameQueue &handle) -> Rc<AttachmentHandle> {
+	if (_frameHandleCallback) {
+		return _frameHandleCallback(*this, handle);
+	}
+	return Rc<core::AttachmentHandle>::create(this, handle);
+}
+
+auto ImageAttachment::makeFrameHandle(const FrameQueue &handle) -> Rc<AttachmentHandle> {
+	if (_frameHandleCallback) {
+		return _frameHandleCallback(*this, handle);
+	}
+	return Rc<core::AttachmentHandle>::create(this, handle);
+}
+
+auto MaterialAttachment::makeFrameHandle(const FrameQueue &handle) -> Rc<AttachmentHandle> {
+	if (_frameHandleCallback) {
+		return _frameHandleCallback(*this, handle);
+	}
+	return Rc<MaterialAttachmentHandle>::create(this, handle);
+}
+
+bool MaterialAttachmentHandle::init(const Rc<Attachment> &a, const FrameQueue &handle) {
+	if (!core::AttachmentHandle::init(a, handle)) {
+		return false;
+	}
+
+	_materials = static_cast<MaterialAttachment *>(a.get())->getMaterials();
+	return true;
+}
+
+const MaterialAttachment *MaterialAttachmentHandle::getMaterialAttachment() const {
+	return static_cast<const MaterialAttachment *>(_attachment.get());
+}
+
+} // namespace stappler::xenolith::null
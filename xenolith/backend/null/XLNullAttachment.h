@@ -0,0 +1,72 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLATTACHMENT_H_
+#define XENOLITH_BACKEND_NULL_XLNULLATTACHMENT_H_
+
+#include "XLNullObject.h"
+#include "XLCoreAttachment.h"
+#include "XLCoreMaterial.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+class SP_PUBLIC BufferAttachment : public core::BufferAttachment {
+public:
+	virtual ~BufferAttachment() = default;
+
+	virtual Rc<AttachmentHandle> makeFrameHandle(const FrameQueue &) override;
+};
+
+class SP_PUBLIC ImageAttachment : public core::ImageAttachment {
+public:
+	virtual ~ImageAttachment() = default;
+
+	virtual Rc<AttachmentHandle> makeFrameHandle(const FrameQueue &) override;
+};
+
+class SP_PUBLIC MaterialAttachment : public core::MaterialAttachment {
+public:
+	virtual ~MaterialAttachment() = default;
+
+	virtual Rc<AttachmentHandle> makeFrameHandle(const FrameQueue &) override;
+};
+
+class SP_PUBLIC MaterialAttachmentHandle : public core::AttachmentHandle {
+public:
+	virtual ~MaterialAttachmentHandle() = default;
+
+	virtual bool init(const Rc<Attachment> &, const FrameQueue &) override;
+
+	const MaterialAttachment *getMaterialAttachment() const;
+
+	// material set, captured on frame creation
+	const Rc<core::MaterialSet> &getSet() const { return _materials; }
+
+protected:
+	using core::AttachmentHandle::init;
+
+	Rc<core::MaterialSet> _materials;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLATTACHMENT_H_ */
@@ -0,0 +1,169 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullDevice.h"
+#include "XLNullInstance.h"
+#include "XLCoreImageStorage.h"
+#include "XLCoreDynamicImage.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+Device::~Device() {
+	clearShaders();
+	invalidateObjects();
+}
+
+bool Device::init(const Instance *inst, Rc<LoopBackendInfo> &&info) {
+	if (!core::Device::init(inst)) {
+		return false;
+	}
+
+	_backend = info ? sp::move(info) : Rc<LoopBackendInfo>::alloc();
+
+	auto count = std::max(_backend->queueCount, uint32_t(1));
+	auto flags =
+			core::QueueFlags::Graphics | core::QueueFlags::Compute | core::QueueFlags::Transfer;
+
+	// Single universal family, like the simplest hardware implementations
+	_families.emplace_back(core::DeviceQueueFamily(
+			{0, count, core::QueueFlags::Graphics, flags, 64, Extent3(1, 1, 1)}));
+
+	for (auto &it : _families) {
+		it.queues.reserve(it.count);
+		it.pools.reserve(it.count);
+		for (uint32_t i = 0; i < it.count; ++i) {
+			it.queues.emplace_back(Rc<DeviceQueue>::create(*this, it.index, it.flags));
+			it.pools.emplace_back(Rc<CommandPool>::create(*this, it.index, it.preferred));
+		}
+	}
+
+	_depthFormats.emplace_back(core::ImageFormat::D16_UNORM);
+	_depthFormats.emplace_back(core::ImageFormat::D32_SFLOAT);
+	_depthFormats.emplace_back(core::ImageFormat::D24_UNORM_S8_UINT);
+	_depthFormats.emplace_back(core::ImageFormat::D32_SFLOAT_S8_UINT);
+
+	_colorFormats.emplace_back(core::ImageFormat::R8_UNORM);
+	_colorFormats.emplace_back(core::ImageFormat::R8G8_UNORM);
+	_colorFormats.emplace_back(core::ImageFormat::R8G8B8_UNORM);
+	_colorFormats.emplace_back(core::ImageFormat::R8G8B8A8_UNORM);
+
+	return true;
+}
+
+Rc<core::Framebuffer> Device::makeFramebuffer(const core::QueuePassData *pass,
+		SpanView<Rc<core::ImageView>> views) {
+	return Rc<Framebuffer>::create(*this, pass->impl.get(), views);
+}
+
+auto Device::makeImage(StringView key, const core::ImageInfoData &imageInfo)
+		-> Rc<ImageStorage> {
+	auto img = Rc<Image>::create(*this, imageInfo);
+	if (!img) {
+		return nullptr;
+	}
+	img->setName(key);
+	return Rc<ImageStorage>::create(img.get());
+}
+
+Rc<core::Semaphore> Device::makeSemaphore() {
+	return Rc<Semaphore>::create(*this, core::SemaphoreType::Default);
+}
+
+Rc<core::ImageView> Device::makeImageView(const Rc<core::ImageObject> &img,
+		const core::ImageViewInfo &info) {
+	return Rc<ImageView>::create(*this, img.get(), info);
+}
+
+Rc<core::CommandPool> Device::makeCommandPool(uint32_t family, core::QueueFlags flags) {
+	return Rc<CommandPool>::create(*this, family, flags);
+}
+
+Rc<core::TextureSet> Device::makeTextureSet(const core::TextureSetLayout &layout) {
+	return Rc<TextureSet>::create(*this, layout);
+}
+
+bool Device::compileResource(core::Resource &res) {
+	for (auto &it : res.getBuffers()) {
+		auto buf = Rc<Buffer>::create(*this, *it);
+		if (!buf) {
+			return false;
+		}
+		buf->setName(it->key);
+		it->writeData(buf->getMappedData(), it->size);
+		it->buffer = buf;
+	}
+
+	for (auto &it : res.getImages()) {
+		auto img = Rc<Image>::create(*this, *it);
+		if (!img) {
+			return false;
+		}
+		img->setName(it->key);
+
+		Bytes data;
+		data.resize(img->getDataSize());
+		it->writeData(data.data(), data.size());
+		img->setData(sp::move(data));
+
+		it->image = img;
+	}
+
+	res.setCompiled(true);
+	return true;
+}
+
+Rc<Image> Device::compileImage(const core::DynamicImage &dynamicImage) {
+	auto info = dynamicImage.getInfo();
+	auto img = Rc<Image>::create(*this, info);
+	if (!img) {
+		return nullptr;
+	}
+
+	img->setName(info.key);
+
+	const_cast<core::DynamicImage &>(dynamicImage).acquireData([&](BytesView bytes) {
+		img->setData(bytes.bytes<Interface>());
+	});
+
+	return img;
+}
+
+uint64_t Device::getSimulatedLatency(uint64_t workload) const {
+	return _backend->submitLatency.toMicros()
+			+ uint64_t(_backend->workloadLatencyNanos * double(workload) / 1'000.0);
+}
+
+void Device::updateIdleDeadline(uint64_t value) {
+	auto current = _idleDeadline.load();
+	while (current < value && !_idleDeadline.compare_exchange_weak(current, value)) { }
+}
+
+void Device::waitIdle() const {
+	auto deadline = _idleDeadline.load();
+	auto now = sp::platform::clock(ClockType::Monotonic);
+	if (deadline > now) {
+		std::this_thread::sleep_for(std::chrono::microseconds(deadline - now));
+	}
+	core::Device::waitIdle();
+}
+
+} // namespace stappler::xenolith::null
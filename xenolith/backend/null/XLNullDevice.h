@@ -0,0 +1,71 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLDEVICE_H_
+#define XENOLITH_BACKEND_NULL_XLNULLDEVICE_H_
+
+#include "XLNullObject.h"
+#include "XLCoreDevice.h"
+#include "XLCoreResource.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+class SP_PUBLIC Device : public core::Device {
+public:
+	virtual ~Device();
+
+	bool init(const Instance *, Rc<LoopBackendInfo> &&);
+
+	virtual Rc<core::Framebuffer> makeFramebuffer(const core::QueuePassData *,
+			SpanView<Rc<core::ImageView>>) override;
+	virtual Rc<ImageStorage> makeImage(StringView, const core::ImageInfoData &) override;
+	virtual Rc<core::Semaphore> makeSemaphore() override;
+	virtual Rc<core::ImageView> makeImageView(const Rc<core::ImageObject> &,
+			const core::ImageViewInfo &) override;
+	virtual Rc<core::CommandPool> makeCommandPool(uint32_t family, core::QueueFlags flags) override;
+	virtual Rc<core::TextureSet> makeTextureSet(const core::TextureSetLayout &) override;
+
+	// Creates CPU-side images and buffers for the resource and fills them with resource data
+	bool compileResource(core::Resource &);
+
+	// Creates CPU-side image for the dynamic image from its current data
+	Rc<Image> compileImage(const core::DynamicImage &);
+
+	const LoopBackendInfo *getBackendInfo() const { return _backend; }
+
+	// Simulated execution time (in microseconds) for a submission with the specified workload
+	uint64_t getSimulatedLatency(uint64_t workload) const;
+
+	void updateIdleDeadline(uint64_t);
+
+	virtual void waitIdle() const override;
+
+protected:
+	using core::Device::init;
+
+	Rc<LoopBackendInfo> _backend;
+	std::atomic<uint64_t> _idleDeadline = 0;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLDEVICE_H_ */
@@ -0,0 +1,45 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLINSTANCE_H_
+#define XENOLITH_BACKEND_NULL_XLNULLINSTANCE_H_
+
+#include "XLNull.h"
+#include "XLCoreInstance.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+class SP_PUBLIC Instance : public core::Instance {
+public:
+	Instance(core::InstanceFlags flags);
+	virtual ~Instance() = default;
+
+	virtual Rc<core::Loop> makeLoop(NotNull<event::Looper>, Rc<core::LoopInfo> &&) const override;
+
+	Rc<Device> makeDevice(const core::LoopInfo &) const;
+};
+
+SP_PUBLIC Rc<core::Instance> createInstance(Rc<core::InstanceInfo> &&);
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLINSTANCE_H_ */
@@ -0,0 +1,312 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullObject.h"
+#include "XLNullDevice.h"
+#include "XLCoreFrameQueue.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+static std::atomic<uint64_t> s_nullObjectHandle = 1;
+
+// null objects own no external resources, so cleanup is no-op
+static void clearNullObject(core::Device *, core::ObjectType, core::ObjectHandle, void *) { }
+
+core::ObjectHandle makeObjectHandle() {
+	auto id = s_nullObjectHandle.fetch_add(1);
+#if (XL_USE_64_BIT_PTR_DEFINES == 1)
+	return core::ObjectHandle(reinterpret_cast<void *>(uintptr_t(id)));
+#else
+	return core::ObjectHandle(id);
+#endif
+}
+
+Value LoopBackendInfo::encode() const {
+	Value ret;
+	ret.setInteger(submitLatency.toMicros(), "submitLatency");
+	ret.setDouble(workloadLatencyNanos, "workloadLatencyNanos");
+	ret.setInteger(queueCount, "queueCount");
+	return ret;
+}
+
+bool Image::init(Device &dev, const core::ImageInfoData &info) {
+	_info = info;
+	return core::ImageObject::init(dev, &clearNullObject, core::ObjectType::Image,
+			makeObjectHandle(), nullptr);
+}
+
+size_t Image::getDataSize() const {
+	return size_t(core::getFormatBlockSize(_info.format)) * _info.extent.width
+			* _info.extent.height * _info.extent.depth * _info.arrayLayers.get();
+}
+
+bool ImageView::init(Device &dev, core::ImageObject *image, const core::ImageViewInfo &info) {
+	if (!image) {
+		return false;
+	}
+
+	_info = image->getViewInfo(info);
+	_image = image;
+
+	return core::ImageView::init(dev, &clearNullObject, core::ObjectType::ImageView,
+			makeObjectHandle(), nullptr);
+}
+
+bool Buffer::init(Device &dev, const core::BufferInfo &info) {
+	_info = info;
+	_data.resize(info.size);
+	return core::BufferObject::init(dev, &clearNullObject, core::ObjectType::Buffer,
+			makeObjectHandle(), nullptr);
+}
+
+bool Sampler::init(Device &dev, const core::SamplerInfo &info) {
+	_info = info;
+	return core::Sampler::init(dev, &clearNullObject, core::ObjectType::Sampler,
+			makeObjectHandle(), nullptr);
+}
+
+bool Shader::init(Device &dev, const core::ProgramData &data) {
+	_stage = data.stage;
+	_name = data.key.str<Interface>();
+	return core::Shader::init(dev, &clearNullObject, core::ObjectType::ShaderModule,
+			makeObjectHandle(), nullptr);
+}
+
+bool GraphicPipeline::init(Device &dev, const PipelineData &data, const SubpassData &,
+		const Queue &) {
+	_name = data.key.str<Interface>();
+	return core::GraphicPipeline::init(dev, &clearNullObject, core::ObjectType::Pipeline,
+			makeObjectHandle(), nullptr);
+}
+
+bool ComputePipeline::init(Device &dev, const PipelineData &data, const SubpassData &,
+		const Queue &) {
+	_name = data.key.str<Interface>();
+	return core::ComputePipeline::init(dev, &clearNullObject, core::ObjectType::Pipeline,
+			makeObjectHandle(), nullptr);
+}
+
+bool RenderPass::init(Device &dev, const core::QueuePassData &data) {
+	_type = data.pass->getType();
+	_name = data.key.str<Interface>();
+	return core::RenderPass::init(dev, &clearNullObject, core::ObjectType::RenderPass,
+			makeObjectHandle(), nullptr);
+}
+
+bool Framebuffer::init(Device &dev, core::RenderPass *renderPass,
+		SpanView<Rc<core::ImageView>> imageViews) {
+	if (imageViews.empty()) {
+		return false;
+	}
+
+	_viewIds.reserve(imageViews.size());
+	_imageViews.reserve(imageViews.size());
+	_renderPass = renderPass;
+
+	auto extent = imageViews.front()->getFramebufferExtent();
+
+	for (auto &it : imageViews) {
+		_viewIds.emplace_back(it->getIndex());
+		_imageViews.emplace_back(it);
+
+		if (extent != it->getFramebufferExtent()) {
+			log::source().error("null::Framebuffer",
+					"Invalid extent for framebuffer image: ", it->getFramebufferExtent());
+			return false;
+		}
+	}
+
+	_extent = Extent2(extent.width, extent.height);
+	_layerCount = extent.depth;
+
+	return core::Framebuffer::init(dev, &clearNullObject, core::ObjectType::Framebuffer,
+			makeObjectHandle(), nullptr);
+}
+
+bool TextureSetLayout::init(Device &dev, const core::TextureSetLayoutData &data) {
+	_imageCount = data.imageCount;
+	_samplersCount = uint32_t(data.compiledSamplers.size());
+	_samplers.reserve(data.compiledSamplers.size());
+	for (auto &it : data.compiledSamplers) { _samplers.emplace_back(it); }
+
+	return core::TextureSetLayout::init(dev, &clearNullObject,
+			core::ObjectType::DescriptorSetLayout, makeObjectHandle(), nullptr);
+}
+
+bool TextureSet::init(Device &dev, const core::TextureSetLayout &layout) {
+	_count = layout.getImageCount();
+	return core::TextureSet::init(dev, &clearNullObject, core::ObjectType::DescriptorPool,
+			makeObjectHandle(), nullptr);
+}
+
+bool Semaphore::init(Device &dev, core::SemaphoreType type) {
+	_type = type;
+	return core::Semaphore::init(dev, &clearNullObject, core::ObjectType::Semaphore,
+			makeObjectHandle(), nullptr);
+}
+
+bool Fence::init(Device &dev, core::FenceType type) {
+	_type = type;
+	_state = Disabled;
+	return core::Fence::init(dev, &clearNullObject, core::ObjectType::Fence, makeObjectHandle(),
+			nullptr);
+}
+
+void Fence::setDeadline(uint64_t deadline) { _deadline = deadline; }
+
+Status Fence::doCheckFence(bool lockfree) {
+	auto deadline = _deadline.load();
+	auto now = sp::platform::clock(ClockType::Monotonic);
+	if (now >= deadline) {
+		return Status::Ok;
+	}
+
+	if (lockfree) {
+		return Status::Suspended;
+	}
+
+	std::this_thread::sleep_for(std::chrono::microseconds(deadline - now));
+	return Status::Ok;
+}
+
+void Fence::doResetFence() { _deadline = 0; }
+
+bool CommandBuffer::init(const CommandPool *pool) {
+	_pool = pool;
+	return true;
+}
+
+void CommandBuffer::addWorkload(uint64_t value) { _workload += value; }
+
+void CommandBuffer::cmdBeginRenderPass(core::Framebuffer *fb) {
+	bindFramebuffer(fb);
+	_withinRenderpass = true;
+	_currentSubpass = 0;
+	++_commands;
+}
+
+void CommandBuffer::cmdEndRenderPass() {
+	_withinRenderpass = false;
+	++_commands;
+}
+
+bool CommandPool::init(Device &dev, uint32_t familyIdx, core::QueueFlags c) {
+	_familyIdx = familyIdx;
+	_class = c;
+	return core::CommandPool::init(dev, &clearNullObject, core::ObjectType::CommandPool,
+			makeObjectHandle(), nullptr);
+}
+
+const core::CommandBuffer *CommandPool::recordBuffer(core::Device &dev,
+		const Callback<bool(core::CommandBuffer &)> &cb) {
+	auto buf = Rc<CommandBuffer>::create(this);
+	if (!buf) {
+		return nullptr;
+	}
+
+	if (!cb(*buf)) {
+		return nullptr;
+	}
+
+	_buffers.emplace_back(buf);
+	return buf;
+}
+
+Status DeviceQueue::waitIdle() {
+	auto deadline = _busyUntil.load();
+	auto now = sp::platform::clock(ClockType::Monotonic);
+	if (deadline > now) {
+		std::this_thread::sleep_for(std::chrono::microseconds(deadline - now));
+	}
+	return Status::Ok;
+}
+
+Status DeviceQueue::doSubmit(const core::FrameSync *sync, core::CommandPool *commandPool,
+		core::Fence &fence, SpanView<const core::CommandBuffer *> buffers,
+		core::DeviceIdleFlags idle) {
+	auto dev = static_cast<Device *>(_device);
+
+	if (hasFlag(idle, core::DeviceIdleFlags::PreDevice)) {
+		dev->waitIdle();
+	} else if (hasFlag(idle, core::DeviceIdleFlags::PreQueue)) {
+		waitIdle();
+	}
+
+	uint64_t workload = 0;
+	for (auto &it : buffers) {
+		if (it) {
+			workload += static_cast<const CommandBuffer *>(it)->getWorkload();
+		}
+	}
+
+	// Queue executes submissions in order, so next submission starts after the previous one
+	auto now = sp::platform::clock(ClockType::Monotonic);
+	auto start = std::max(now, _busyUntil.load());
+	auto deadline = start + dev->getSimulatedLatency(workload);
+	_busyUntil = deadline;
+	dev->updateIdleDeadline(deadline);
+
+	static_cast<Fence &>(fence).setDeadline(deadline);
+
+	if (sync) {
+		for (auto &it : sync->waitAttachments) {
+			if (it.semaphore) {
+				it.semaphore->setWaited(true);
+				fence.addRelease([sem = it.semaphore.get(), t = it.semaphore->getTimeline()](
+										 bool success) { sem->setInUse(false, t); },
+						it.semaphore, "null::DeviceQueue::submit");
+				fence.autorelease(it.semaphore.get());
+				if (commandPool) {
+					commandPool->autorelease(it.semaphore.get());
+				}
+			}
+		}
+
+		for (auto &it : sync->signalAttachments) {
+			if (it.semaphore) {
+				it.semaphore->setSignaled(true);
+				it.semaphore->setInUse(true, it.semaphore->getTimeline());
+				fence.autorelease(it.semaphore.get());
+				if (commandPool) {
+					commandPool->autorelease(it.semaphore.get());
+				}
+			}
+		}
+	}
+
+	fence.setArmed(*this);
+
+	if (sync) {
+		for (auto &it : sync->images) { it.image->setLayout(it.newLayout); }
+	}
+
+	if (hasFlag(idle, core::DeviceIdleFlags::PostDevice)) {
+		dev->waitIdle();
+	} else if (hasFlag(idle, core::DeviceIdleFlags::PostQueue)) {
+		waitIdle();
+	}
+
+	_lastStatus = Status::Ok;
+	return Status::Ok;
+}
+
+} // namespace stappler::xenolith::null
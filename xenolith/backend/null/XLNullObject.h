@@ -0,0 +1,244 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLOBJECT_H_
+#define XENOLITH_BACKEND_NULL_XLNULLOBJECT_H_
+
+#include "XLNull.h"
+#include "XLCoreObject.h"
+#include "XLCoreDeviceQueue.h"
+#include "XLCoreTextureSet.h"
+#include "XLCoreQueueData.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+class CommandPool;
+
+class SP_PUBLIC Image : public core::ImageObject {
+public:
+	virtual ~Image() = default;
+
+	bool init(Device &, const core::ImageInfoData &);
+
+	// CPU-side contents of the image, empty until written or captured
+	BytesView getData() const { return _data; }
+	void setData(Bytes &&data) { _data = sp::move(data); }
+
+	size_t getDataSize() const;
+
+protected:
+	using core::ImageObject::init;
+
+	Bytes _data;
+};
+
+class SP_PUBLIC ImageView : public core::ImageView {
+public:
+	virtual ~ImageView() = default;
+
+	bool init(Device &, core::ImageObject *, const core::ImageViewInfo &);
+
+protected:
+	using core::ImageView::init;
+};
+
+class SP_PUBLIC Buffer : public core::BufferObject {
+public:
+	virtual ~Buffer() = default;
+
+	bool init(Device &, const core::BufferInfo &);
+
+	BytesView getData() const { return _data; }
+	uint8_t *getMappedData() { return _data.data(); }
+
+protected:
+	using core::BufferObject::init;
+
+	Bytes _data;
+};
+
+class SP_PUBLIC Sampler : public core::Sampler {
+public:
+	virtual ~Sampler() = default;
+
+	bool init(Device &, const core::SamplerInfo &);
+
+protected:
+	using core::Sampler::init;
+};
+
+class SP_PUBLIC Shader : public core::Shader {
+public:
+	virtual ~Shader() = default;
+
+	bool init(Device &, const core::ProgramData &);
+
+protected:
+	using core::Shader::init;
+};
+
+class SP_PUBLIC GraphicPipeline : public core::GraphicPipeline {
+public:
+	virtual ~GraphicPipeline() = default;
+
+	bool init(Device &, const PipelineData &, const SubpassData &, const Queue &);
+
+protected:
+	using core::GraphicPipeline::init;
+};
+
+class SP_PUBLIC ComputePipeline : public core::ComputePipeline {
+public:
+	virtual ~ComputePipeline() = default;
+
+	bool init(Device &, const PipelineData &, const SubpassData &, const Queue &);
+
+protected:
+	using core::ComputePipeline::init;
+};
+
+class SP_PUBLIC RenderPass : public core::RenderPass {
+public:
+	virtual ~RenderPass() = default;
+
+	bool init(Device &, const core::QueuePassData &);
+
+protected:
+	using core::RenderPass::init;
+};
+
+class SP_PUBLIC Framebuffer : public core::Framebuffer {
+public:
+	virtual ~Framebuffer() = default;
+
+	bool init(Device &, core::RenderPass *, SpanView<Rc<core::ImageView>>);
+
+protected:
+	using core::Framebuffer::init;
+};
+
+class SP_PUBLIC TextureSetLayout : public core::TextureSetLayout {
+public:
+	virtual ~TextureSetLayout() = default;
+
+	bool init(Device &, const core::TextureSetLayoutData &);
+
+protected:
+	using core::TextureSetLayout::init;
+};
+
+class SP_PUBLIC TextureSet : public core::TextureSet {
+public:
+	virtual ~TextureSet() = default;
+
+	bool init(Device &, const core::TextureSetLayout &);
+
+protected:
+	using core::TextureSet::init;
+};
+
+class SP_PUBLIC Semaphore : public core::Semaphore {
+public:
+	virtual ~Semaphore() = default;
+
+	bool init(Device &, core::SemaphoreType = core::SemaphoreType::Default);
+
+protected:
+	using core::Semaphore::init;
+};
+
+/* Fence, signaled by the monotonic clock
+ *
+ * DeviceQueue sets simulated completion time on submission, fence becomes signaled when
+ * this time is reached. Blocking check sleeps until the deadline.
+ */
+class SP_PUBLIC Fence : public core::Fence {
+public:
+	virtual ~Fence() = default;
+
+	bool init(Device &, core::FenceType);
+
+	void setDeadline(uint64_t);
+	uint64_t getDeadline() const { return _deadline.load(); }
+
+protected:
+	using core::Fence::init;
+
+	virtual Status doCheckFence(bool lockfree) override;
+	virtual void doResetFence() override;
+
+	std::atomic<uint64_t> _deadline = 0;
+};
+
+class SP_PUBLIC CommandBuffer : public core::CommandBuffer {
+public:
+	virtual ~CommandBuffer() = default;
+
+	bool init(const CommandPool *);
+
+	// Adds abstract work units (e.g. processed vertexes) to simulate GPU time
+	void addWorkload(uint64_t);
+	uint64_t getWorkload() const { return _workload; }
+
+	void cmdBeginRenderPass(core::Framebuffer *);
+	void cmdEndRenderPass();
+
+	uint32_t getCommandsCount() const { return _commands; }
+
+protected:
+	uint64_t _workload = 0;
+	uint32_t _commands = 0;
+};
+
+class SP_PUBLIC CommandPool : public core::CommandPool {
+public:
+	virtual ~CommandPool() = default;
+
+	bool init(Device &dev, uint32_t familyIdx, core::QueueFlags c);
+
+	virtual const core::CommandBuffer *recordBuffer(core::Device &dev,
+			const Callback<bool(core::CommandBuffer &)> &) override;
+
+protected:
+	using core::CommandPool::init;
+};
+
+class SP_PUBLIC DeviceQueue : public core::DeviceQueue {
+public:
+	virtual ~DeviceQueue() = default;
+
+	virtual Status waitIdle() override;
+
+	// monotonic time, when all submitted work will be completed
+	uint64_t getBusyUntil() const { return _busyUntil.load(); }
+
+protected:
+	virtual Status doSubmit(const core::FrameSync *, core::CommandPool *, core::Fence &,
+			SpanView<const core::CommandBuffer *>,
+			core::DeviceIdleFlags = core::DeviceIdleFlags::None) override;
+
+	std::atomic<uint64_t> _busyUntil = 0;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLOBJECT_H_ */
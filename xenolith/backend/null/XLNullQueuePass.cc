@@ -0,0 +1,201 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNullQueuePass.h"
+#include "XLNullDevice.h"
+#include "XLCoreFrameQueue.h"
+#include "XLCoreFrameHandle.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+bool QueuePass::init(QueuePassBuilder &passBuilder) {
+	if (core::QueuePass::init(passBuilder)) {
+		switch (getType()) {
+		case core::PassType::Graphics:
+		case core::PassType::Generic: _queueOps = core::QueueFlags::Graphics; break;
+		case core::PassType::Compute: _queueOps = core::QueueFlags::Compute; break;
+		case core::PassType::Transfer: _queueOps = core::QueueFlags::Transfer; break;
+		}
+		return true;
+	}
+	return false;
+}
+
+Rc<core::QueuePassHandle> QueuePass::makeFrameHandle(const FrameQueue &queue) {
+	if (_frameHandleCallback) {
+		return _frameHandleCallback(*this, queue);
+	}
+	return Rc<null::QueuePassHandle>::create(*this, queue);
+}
+
+QueuePassHandle::~QueuePassHandle() { invalidate(); }
+
+void QueuePassHandle::invalidate() {
+	if (_pool) {
+		_device->releaseCommandPoolUnsafe(move(_pool));
+		_pool = nullptr;
+	}
+
+	if (_queue) {
+		_device->releaseQueue(move(_queue));
+		_queue = nullptr;
+	}
+
+	_sync = nullptr;
+}
+
+bool QueuePassHandle::prepare(FrameQueue &q, Function<void(bool)> &&cb) {
+	_device = static_cast<Device *>(q.getFrame()->getDevice());
+	_pool = static_cast<CommandPool *>(_device->acquireCommandPool(getQueueOps()).get());
+
+	if (!_pool) {
+		invalidate();
+		return false;
+	}
+
+	prepareSubpasses(q);
+
+	q.getFrame()->performInQueue([this](FrameHandle &frame) {
+		auto ret = doPrepareCommands(frame);
+		if (!ret.empty()) {
+			_buffers = sp::move(ret);
+			return true;
+		}
+		return false;
+	}, [this, cb = sp::move(cb)](FrameHandle &frame, bool success) {
+		if (!success) {
+			log::source().error("null::QueuePassHandle", "Fail to doPrepareCommands");
+			_valid = false;
+		}
+		cb(_valid);
+	}, this, "null::QueuePassHandle::doPrepareCommands");
+	return false;
+}
+
+void QueuePassHandle::submit(FrameQueue &q, Rc<FrameSync> &&sync, Function<void(bool)> &&onSubmited,
+		Function<void(bool)> &&onComplete) {
+	if (!_pool) {
+		onSubmited(true);
+		q.getFrame()->performInQueue(
+				[onComplete = sp::move(onComplete)](FrameHandle &frame) mutable {
+			onComplete(true);
+			return true;
+		}, this, "null::QueuePassHandle::complete");
+		return;
+	}
+
+	Rc<FrameHandle> f = q.getFrame(); // capture frame ref
+
+	_fence->addRelease([dev = _device, pool = _pool, loop = q.getLoop()](bool success) {
+		dev->releaseCommandPool(*loop, Rc<core::CommandPool>(pool));
+	}, nullptr, "null::QueuePassHandle::submit dev->releaseCommandPool");
+
+	_fence->addRelease([this, func = sp::move(onComplete), q = &q](bool success) mutable {
+		doComplete(*q, sp::move(func), success);
+	}, this, "null::QueuePassHandle::submit onComplete");
+
+	_sync = move(sync);
+
+	_device->acquireQueue(getQueueOps(), *f.get(),
+			[this, onSubmited = sp::move(onSubmited)](FrameHandle &frame,
+					const Rc<core::DeviceQueue> &queue) mutable {
+		_queue = static_cast<DeviceQueue *>(queue.get());
+
+		frame.performInQueue([this, onSubmited = sp::move(onSubmited)](FrameHandle &frame) mutable {
+			return doSubmit(frame, sp::move(onSubmited));
+		}, this, "null::QueuePassHandle::submit");
+	},
+			[this](FrameHandle &frame) {
+		_sync = nullptr;
+		invalidate();
+	}, this);
+}
+
+core::QueueFlags QueuePassHandle::getQueueOps() const {
+	return (static_cast<null::QueuePass *>(_queuePass.get()))->getQueueOps();
+}
+
+Vector<const core::CommandBuffer *> QueuePassHandle::doPrepareCommands(FrameHandle &handle) {
+	auto buf = _pool->recordBuffer(*_device, [&, this](core::CommandBuffer &b) {
+		auto &buf = static_cast<CommandBuffer &>(b);
+		auto fb = getFramebuffer();
+		if (fb) {
+			buf.cmdBeginRenderPass(fb);
+		}
+
+		auto ret = doRecordCommands(handle, buf);
+
+		if (fb) {
+			buf.cmdEndRenderPass();
+		}
+		return ret;
+	});
+
+	if (!buf) {
+		return Vector<const core::CommandBuffer *>();
+	}
+	return Vector<const core::CommandBuffer *>{buf};
+}
+
+bool QueuePassHandle::doSubmit(FrameHandle &frame, Function<void(bool)> &&onSubmited) {
+	auto success = _queue->submit(*_sync, *_pool, *_fence, _buffers);
+	_pool = nullptr;
+	frame.performOnGlThread(
+			[this, success, onSubmited = sp::move(onSubmited), queue = move(_queue),
+					armedTime = _fence->getArmedTime()](FrameHandle &frame) mutable {
+		_queueData->submitTime = armedTime;
+
+		if (queue) {
+			_device->releaseQueue(move(queue));
+			queue = nullptr;
+		}
+
+		doSubmitted(frame, sp::move(onSubmited), success == Status::Ok, move(_fence));
+		_fence = nullptr;
+		invalidate();
+
+		if (success != Status::Ok) {
+			log::source().error("null::QueuePassHandle", "Fail to submit: ", success);
+		}
+		_sync = nullptr;
+	},
+			nullptr, false, "null::QueuePassHandle::doSubmit");
+	return success == Status::Ok;
+}
+
+void QueuePassHandle::doSubmitted(FrameHandle &handle, Function<void(bool)> &&func, bool success,
+		Rc<core::Fence> &&fence) {
+	auto queue = handle.getFrameQueue(_data->queue->queue);
+	for (auto &it : _data->submittedCallbacks) { it(*queue, *_data, success); }
+
+	func(success);
+
+	fence->schedule(*_loop);
+}
+
+void QueuePassHandle::doComplete(FrameQueue &queue, Function<void(bool)> &&func, bool success) {
+	for (auto &it : _data->completeCallbacks) { it(queue, *_data, success); }
+
+	func(success);
+}
+
+} // namespace stappler::xenolith::null
@@ -0,0 +1,85 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_BACKEND_NULL_XLNULLQUEUEPASS_H_
+#define XENOLITH_BACKEND_NULL_XLNULLQUEUEPASS_H_
+
+#include "XLNullObject.h"
+#include "XLCoreQueuePass.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::null {
+
+class SP_PUBLIC QueuePass : public core::QueuePass {
+public:
+	virtual ~QueuePass() = default;
+
+	virtual bool init(QueuePassBuilder &passBuilder) override;
+
+	virtual Rc<core::QueuePassHandle> makeFrameHandle(const FrameQueue &) override;
+
+	core::QueueFlags getQueueOps() const { return _queueOps; }
+
+protected:
+	core::QueueFlags _queueOps = core::QueueFlags::Graphics;
+};
+
+/* Pass handle for the null backend
+ *
+ * Commands are recorded into null::CommandBuffer in the worker thread, submission goes
+ * through device queue, so pass timing follows the simulated latency of the device.
+ * Subclasses should override doPrepareCommands to perform CPU-side work and to report
+ * workload for the buffer.
+ */
+class SP_PUBLIC QueuePassHandle : public core::QueuePassHandle {
+public:
+	virtual ~QueuePassHandle();
+	void invalidate();
+
+	virtual bool prepare(FrameQueue &, Function<void(bool)> &&) override;
+	virtual void submit(FrameQueue &, Rc<FrameSync> &&, Function<void(bool)> &&onSubmited,
+			Function<void(bool)> &&onComplete) override;
+
+	virtual core::QueueFlags getQueueOps() const;
+
+protected:
+	virtual Vector<const core::CommandBuffer *> doPrepareCommands(FrameHandle &);
+	virtual bool doSubmit(FrameHandle &frame, Function<void(bool)> &&onSubmited);
+
+	virtual void doSubmitted(FrameHandle &, Function<void(bool)> &&, bool, Rc<core::Fence> &&);
+
+	// called before OnComplete event sended to FrameHandle (so, before any finalization)
+	virtual void doComplete(FrameQueue &, Function<void(bool)> &&, bool);
+
+	// Record commands for the pass itself, called within render pass for graphics passes
+	virtual bool doRecordCommands(FrameHandle &, CommandBuffer &) { return true; }
+
+	Device *_device = nullptr;
+	Rc<CommandPool> _pool;
+	Rc<DeviceQueue> _queue;
+	Vector<const core::CommandBuffer *> _buffers;
+	Rc<FrameSync> _sync;
+	bool _valid = true;
+};
+
+} // namespace stappler::xenolith::null
+
+#endif /* XENOLITH_BACKEND_NULL_XLNULLQUEUEPASS_H_ */
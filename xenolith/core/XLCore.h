@@ -181,5 +181,6 @@ SP_PUBLIC void store(ProfileData &);
 
 #include "XLCoreEnum.h"
 #include "XLCorePipelineInfo.h"
+#include "XLCoreProfiler.h"
 
 #endif /* XENOLITH_CORE_XLCORE_H_ */
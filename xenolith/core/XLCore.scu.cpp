@@ -29,6 +29,7 @@
 #include "XLCoreEnum.cc"
 #include "XLCoreInfo.cc"
 #include "XLCoreObject.cc"
+#include "XLCoreProfiler.cc"
 #include "XLCoreDevice.cc"
 #include "XLCoreDeviceQueue.cc"
 #include "XLCoreInstance.cc"
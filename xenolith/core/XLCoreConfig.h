@@ -59,6 +59,15 @@ static constexpr uint32_t MaxTextureSetImagesIndexed = 1024 << 4;
 
 static constexpr uint32_t MaxBufferArrayObjectsIndexed = 1024;
 
+/* Zone profiler (see XLCoreProfiler.h), zones are compiled in for all builds and cost a single
+ * check while profiler is disabled at runtime; define XL_PROFILE_ZONES=0 to compile them out */
+#ifndef XL_PROFILE_ZONES
+#define XL_PROFILE_ZONES 1
+#endif
+
+/* Events per thread in profiler's ring buffer, older events are overwritten */
+static constexpr uint32_t ProfilerThreadBufferSize = 1 << 14;
+
 }
 
 #endif /* XENOLITH_CORE_XLCORECONFIG_H_ */
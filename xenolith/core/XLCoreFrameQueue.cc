@@ -362,6 +362,7 @@ void FrameQueue::onAttachmentAcquire(FrameAttachmentData &attachment) {
 	}
 
 	XL_FRAME_QUEUE_LOG("[Attachment:", attachment.handle->getName(), "] State: ResourcesPending");
+	XL_PROFILE_INSTANT("Attachment:ResourcesPending", "frame", _order);
 	attachment.state = FrameAttachmentState::ResourcesPending;
 	if (attachment.handle->getAttachment()->getData()->type == AttachmentType::Image) {
 		auto img = static_cast<ImageAttachment *>(attachment.handle->getAttachment().get());
@@ -437,6 +438,7 @@ void FrameQueue::onAttachmentRelease(FrameAttachmentData &attachment, FrameAttac
 	} else {
 		XL_FRAME_QUEUE_LOG("[Attachment:", attachment.handle->getName(),
 				"] State: ResourcesReleased");
+		XL_PROFILE_INSTANT("Attachment:ResourcesReleased", "frame", _order);
 		attachment.state = state;
 	}
 }
@@ -491,30 +493,37 @@ void FrameQueue::updateRenderPassState(FramePassData &data, FrameRenderPassState
 		break;
 	case FrameRenderPassState::Ready:
 		XL_FRAME_QUEUE_LOG("[RenderPass:", data.handle->getName(), "] State: Ready");
+		XL_PROFILE_INSTANT("RenderPass:Ready", "frame", _order);
 		onRenderPassReady(data);
 		break;
 	case FrameRenderPassState::ResourcesAcquired:
 		XL_FRAME_QUEUE_LOG("[RenderPass:", data.handle->getName(), "] State: ResourcesAcquired");
+		XL_PROFILE_INSTANT("RenderPass:ResourcesAcquired", "frame", _order);
 		onRenderPassResourcesAcquired(data);
 		break;
 	case FrameRenderPassState::Prepared:
 		XL_FRAME_QUEUE_LOG("[RenderPass:", data.handle->getName(), "] State: Prepared");
+		XL_PROFILE_INSTANT("RenderPass:Prepared", "frame", _order);
 		onRenderPassPrepared(data);
 		break;
 	case FrameRenderPassState::Submission:
 		XL_FRAME_QUEUE_LOG("[RenderPass:", data.handle->getName(), "] State: Submission");
+		XL_PROFILE_INSTANT("RenderPass:Submission", "frame", _order);
 		onRenderPassSubmission(data);
 		break;
 	case FrameRenderPassState::Submitted:
 		XL_FRAME_QUEUE_LOG("[RenderPass:", data.handle->getName(), "] State: Submitted");
+		XL_PROFILE_INSTANT("RenderPass:Submitted", "frame", _order);
 		onRenderPassSubmitted(data);
 		break;
 	case FrameRenderPassState::Complete:
 		XL_FRAME_QUEUE_LOG("[RenderPass:", data.handle->getName(), "] State: Complete");
+		XL_PROFILE_INSTANT("RenderPass:Complete", "frame", _order);
 		onRenderPassComplete(data);
 		break;
 	case FrameRenderPassState::Finalized:
 		XL_FRAME_QUEUE_LOG("[RenderPass:", data.handle->getName(), "] State: Finalized");
+		XL_PROFILE_INSTANT("RenderPass:Finalized", "frame", _order);
 		data.handle->finalize(*this, _success);
 		break;
 	}
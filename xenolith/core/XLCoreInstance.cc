@@ -28,6 +28,10 @@
 #include "XLVkPlatform.h"
 #endif
 
+#ifdef MODULE_XENOLITH_BACKEND_NULL
+#include "XLNullInstance.h"
+#endif
+
 namespace STAPPLER_VERSIONIZED stappler::xenolith::core {
 
 Value encodeInstanceInfo(const InstanceInfo &info) {
@@ -69,6 +73,15 @@ Rc<Instance> Instance::create(Rc<InstanceInfo> &&info) {
 			return createInstance(move(info));
 		}
 	}
+#endif
+#ifdef MODULE_XENOLITH_BACKEND_NULL
+	if (info->api == InstanceApi::None) {
+		auto createInstance = SharedModule::acquireTypedSymbol<decltype(&null::createInstance)>(
+				buildconfig::MODULE_XENOLITH_BACKEND_NULL_NAME, "null::createInstance");
+		if (createInstance) {
+			return createInstance(move(info));
+		}
+	}
 #endif
 	return nullptr;
 }
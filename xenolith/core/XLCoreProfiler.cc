@@ -0,0 +1,464 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLCore.h"
+#include "XLCoreProfiler.h"
+#include "SPThreadPool.h"
+
+#include <chrono>
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::profiling {
+
+// Event slot in ring buffer, written by owner thread only
+//
+// Fields are published with sequence number (2 * index + 2 when written, odd while writing),
+// so exporter can detect and skip slots, that were overwritten while reading
+struct EventSlot {
+	std::atomic<uint64_t> seq = 0;
+	std::atomic<const char *> name = nullptr;
+	std::atomic<size_t> nameSize = 0;
+	std::atomic<const char *> category = nullptr;
+	std::atomic<size_t> categorySize = 0;
+	std::atomic<uint64_t> begin = 0;
+	std::atomic<uint64_t> end = 0;
+	std::atomic<uint64_t> arg = 0;
+};
+
+// Statistics for zone, key (name) is published after other fields, counters are written
+// by owner thread only
+struct StatsSlot {
+	std::atomic<const char *> name = nullptr;
+	std::atomic<size_t> nameSize = 0;
+	std::atomic<const char *> category = nullptr;
+	std::atomic<size_t> categorySize = 0;
+	std::atomic<uint64_t> count = 0;
+	std::atomic<uint64_t> total = 0;
+	std::atomic<uint64_t> min = maxOf<uint64_t>();
+	std::atomic<uint64_t> max = 0;
+};
+
+struct ThreadBuffer : public Ref {
+	// open addressing table for zone statistics, zones above the limit are not counted
+	static constexpr size_t StatsTableSize = 256;
+
+	uint32_t threadId = 0;
+	String threadName;
+	std::atomic<bool> finished = false;
+
+	// ring buffer, allocated by owner thread with the first recorded event
+	std::atomic<EventSlot *> events = nullptr;
+	std::atomic<uint64_t> head = 0;
+
+	// statistics are dropped by owner thread, when epoch differs from global one
+	std::atomic<uint64_t> statsEpoch = 0;
+	std::array<StatsSlot, StatsTableSize> stats;
+
+	ThreadBuffer(uint32_t id, StringView name) : threadId(id), threadName(name.str<Interface>()) { }
+
+	virtual ~ThreadBuffer() { delete[] events.load(); }
+
+	void push(StringView name, StringView category, uint64_t begin, uint64_t end, uint64_t arg);
+	void addStats(uint64_t epoch, StringView name, StringView category, uint64_t duration);
+};
+
+struct ProfilerData {
+	static ProfilerData *getInstance() {
+		static ProfilerData s_data;
+		return &s_data;
+	}
+
+	// limit for buffers of finished threads, that kept for export
+	static constexpr size_t FinishedBuffersLimit = 32;
+
+	std::atomic<bool> enabled = false;
+
+	// incremented on statistics reset
+	std::atomic<uint64_t> statsEpoch = 1;
+
+	// events before this time are not exported after `clear`
+	std::atomic<uint64_t> clearTime = 0;
+
+	std::mutex mutex;
+	Vector<Rc<ThreadBuffer>> buffers;
+	uint32_t nextThreadId = 1;
+
+	Rc<ThreadBuffer> addThread(StringView name) {
+		std::unique_lock lock(mutex);
+		auto b = Rc<ThreadBuffer>::alloc(nextThreadId++, name);
+
+		size_t finished = 0;
+		for (auto &it : buffers) {
+			if (it->finished.load()) {
+				++finished;
+			}
+		}
+
+		if (finished >= FinishedBuffersLimit) {
+			auto it = std::find_if(buffers.begin(), buffers.end(),
+					[](const Rc<ThreadBuffer> &b) { return b->finished.load(); });
+			if (it != buffers.end()) {
+				buffers.erase(it);
+			}
+		}
+
+		buffers.emplace_back(b);
+		return b;
+	}
+};
+
+void ThreadBuffer::push(StringView name, StringView category, uint64_t begin, uint64_t end,
+		uint64_t arg) {
+	auto slots = events.load(std::memory_order_relaxed);
+	if (!slots) {
+		slots = new EventSlot[config::ProfilerThreadBufferSize];
+		events.store(slots, std::memory_order_release);
+	}
+
+	auto h = head.load(std::memory_order_relaxed);
+	auto &slot = slots[h % config::ProfilerThreadBufferSize];
+
+	slot.seq.store(h * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.name.store(name.data(), std::memory_order_relaxed);
+	slot.nameSize.store(name.size(), std::memory_order_relaxed);
+	slot.category.store(category.data(), std::memory_order_relaxed);
+	slot.categorySize.store(category.size(), std::memory_order_relaxed);
+	slot.begin.store(begin, std::memory_order_relaxed);
+	slot.end.store(end, std::memory_order_relaxed);
+	slot.arg.store(arg, std::memory_order_relaxed);
+
+	slot.seq.store(h * 2 + 2, std::memory_order_release);
+	head.store(h + 1, std::memory_order_release);
+}
+
+void ThreadBuffer::addStats(uint64_t epoch, StringView name, StringView category,
+		uint64_t duration) {
+	if (statsEpoch.load(std::memory_order_relaxed) != epoch) {
+		for (auto &it : stats) {
+			it.name.store(nullptr, std::memory_order_relaxed);
+			it.count.store(0, std::memory_order_relaxed);
+			it.total.store(0, std::memory_order_relaxed);
+			it.min.store(maxOf<uint64_t>(), std::memory_order_relaxed);
+			it.max.store(0, std::memory_order_relaxed);
+		}
+		statsEpoch.store(epoch, std::memory_order_release);
+	}
+
+	// zone names are literals, so the pointer is enough to identify the zone
+	auto idx = (uintptr_t(name.data()) >> 3) * 0x9E37'79B9'7F4A'7C15ULL;
+	for (size_t i = 0; i < StatsTableSize; ++i) {
+		auto &slot = stats[(idx + i) % StatsTableSize];
+		auto key = slot.name.load(std::memory_order_relaxed);
+		if (!key) {
+			slot.nameSize.store(name.size(), std::memory_order_relaxed);
+			slot.category.store(category.data(), std::memory_order_relaxed);
+			slot.categorySize.store(category.size(), std::memory_order_relaxed);
+			slot.name.store(name.data(), std::memory_order_release);
+		} else if (key != name.data()
+				|| slot.nameSize.load(std::memory_order_relaxed) != name.size()) {
+			continue;
+		}
+
+		// single writer, so no read-modify-write operations required
+		slot.count.store(slot.count.load(std::memory_order_relaxed) + 1,
+				std::memory_order_relaxed);
+		slot.total.store(slot.total.load(std::memory_order_relaxed) + duration,
+				std::memory_order_relaxed);
+		if (duration < slot.min.load(std::memory_order_relaxed)) {
+			slot.min.store(duration, std::memory_order_relaxed);
+		}
+		if (duration > slot.max.load(std::memory_order_relaxed)) {
+			slot.max.store(duration, std::memory_order_relaxed);
+		}
+		return;
+	}
+}
+
+struct ThreadBufferHolder {
+	String name;
+	Rc<ThreadBuffer> buffer;
+
+	ThreadBuffer *get() {
+		if (!buffer) {
+			buffer = ProfilerData::getInstance()->addThread(name);
+		}
+		return buffer.get();
+	}
+
+	~ThreadBufferHolder() {
+		if (buffer) {
+			buffer->finished = true;
+		}
+	}
+};
+
+static thread_local ThreadBufferHolder tl_buffer;
+static thread_local uint64_t tl_taskBegin = 0;
+
+static void onTaskBegin(const thread::Task &) { tl_taskBegin = now(); }
+
+static void onTaskEnd(const thread::Task &task) {
+	if (tl_taskBegin) {
+		auto tag = task.getTag();
+		record(tag.empty() ? StringView("Task") : tag, "thread", tl_taskBegin, now());
+		tl_taskBegin = 0;
+	}
+}
+
+uint64_t now() {
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch())
+					.count());
+}
+
+void setEnabled(bool value) {
+	ProfilerData::getInstance()->enabled = value;
+	if (value) {
+		thread::ThreadPool::setExecutionHooks(&onTaskBegin, &onTaskEnd);
+	} else {
+		thread::ThreadPool::setExecutionHooks(nullptr, nullptr);
+	}
+}
+
+bool isEnabled() { return ProfilerData::getInstance()->enabled.load(std::memory_order_relaxed); }
+
+void setThreadName(StringView name) {
+	// thread is registered with the first recorded event, no buffers allocated here
+	tl_buffer.name = name.str<Interface>();
+	if (tl_buffer.buffer) {
+		std::unique_lock lock(ProfilerData::getInstance()->mutex);
+		tl_buffer.buffer->threadName = tl_buffer.name;
+	}
+}
+
+void record(StringView name, StringView category, uint64_t begin, uint64_t end, uint64_t arg) {
+	auto b = tl_buffer.get();
+	b->push(name, category, begin, end, arg);
+	b->addStats(ProfilerData::getInstance()->statsEpoch.load(std::memory_order_relaxed), name,
+			category, end - begin);
+}
+
+void instant(StringView name, StringView category, uint64_t arg) {
+	auto t = now();
+	tl_buffer.get()->push(name, category, t, t, arg);
+}
+
+void foreachZoneStats(const Callback<void(const ZoneStats &)> &cb) {
+	auto data = ProfilerData::getInstance();
+	auto epoch = data->statsEpoch.load(std::memory_order_relaxed);
+
+	Vector<Rc<ThreadBuffer>> buffers;
+	do {
+		std::unique_lock lock(data->mutex);
+		buffers = data->buffers;
+	} while (0);
+
+	// zones with the same name from different threads are merged
+	Map<StringView, ZoneStats> merged;
+	for (auto &b : buffers) {
+		if (b->statsEpoch.load(std::memory_order_acquire) != epoch) {
+			continue;
+		}
+
+		for (auto &slot : b->stats) {
+			auto key = slot.name.load(std::memory_order_acquire);
+			if (!key) {
+				continue;
+			}
+
+			ZoneStats stats{
+				StringView(key, slot.nameSize.load(std::memory_order_relaxed)),
+				StringView(slot.category.load(std::memory_order_relaxed),
+						slot.categorySize.load(std::memory_order_relaxed)),
+				slot.count.load(std::memory_order_relaxed),
+				slot.total.load(std::memory_order_relaxed),
+				slot.min.load(std::memory_order_relaxed),
+				slot.max.load(std::memory_order_relaxed),
+			};
+
+			auto mIt = merged.find(stats.name);
+			if (mIt == merged.end()) {
+				merged.emplace(stats.name, stats);
+			} else {
+				mIt->second.count += stats.count;
+				mIt->second.total += stats.total;
+				mIt->second.min = std::min(mIt->second.min, stats.min);
+				mIt->second.max = std::max(mIt->second.max, stats.max);
+			}
+		}
+	}
+
+	for (auto &it : merged) { cb(it.second); }
+}
+
+void resetZoneStats() { ++ProfilerData::getInstance()->statsEpoch; }
+
+static void exportChromeTrace_string(const Callback<void(StringView)> &cb, StringView str) {
+	cb << "\"";
+	while (!str.empty()) {
+		auto tmp = str.readUntil<StringView::Chars<'"', '\\'>>();
+		if (!tmp.empty()) {
+			cb(tmp);
+		}
+		if (!str.empty()) {
+			cb << "\\" << StringView(str.data(), 1);
+			++str;
+		}
+	}
+	cb << "\"";
+}
+
+// Chrome trace uses microseconds with fractional part
+static void exportChromeTrace_time(const Callback<void(StringView)> &cb, uint64_t ns) {
+	auto frac = ns % 1'000;
+	cb << (ns / 1'000) << "." << ((frac < 100) ? ((frac < 10) ? "00" : "0") : "") << frac;
+}
+
+void exportChromeTrace(const Callback<void(StringView)> &cb) {
+	auto data = ProfilerData::getInstance();
+
+	auto clearTime = data->clearTime.load(std::memory_order_relaxed);
+
+	Vector<Rc<ThreadBuffer>> buffers;
+	do {
+		std::unique_lock lock(data->mutex);
+		buffers = data->buffers;
+	} while (0);
+
+	bool first = true;
+	auto separator = [&] {
+		if (first) {
+			first = false;
+		} else {
+			cb << ",\n";
+		}
+	};
+
+	cb << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+	for (auto &b : buffers) {
+		String threadName;
+		do {
+			std::unique_lock lock(data->mutex);
+			threadName = b->threadName;
+		} while (0);
+
+		separator();
+		cb << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->threadId
+		   << ",\"args\":{\"name\":";
+		exportChromeTrace_string(cb,
+				threadName.empty() ? StringView(toString("Thread ", b->threadId)) : threadName);
+		cb << "}}";
+
+		auto slots = b->events.load(std::memory_order_acquire);
+		if (!slots) {
+			continue;
+		}
+
+		auto head = b->head.load(std::memory_order_acquire);
+		auto size = uint64_t(config::ProfilerThreadBufferSize);
+		auto start = (head > size) ? head - size : 0;
+
+		for (auto i = start; i < head; ++i) {
+			auto &slot = slots[i % size];
+
+			auto seq = slot.seq.load(std::memory_order_acquire);
+			if (seq != i * 2 + 2) {
+				continue; // overwritten by owner thread
+			}
+
+			ZoneEvent ev{
+				StringView(slot.name.load(std::memory_order_relaxed),
+						slot.nameSize.load(std::memory_order_relaxed)),
+				StringView(slot.category.load(std::memory_order_relaxed),
+						slot.categorySize.load(std::memory_order_relaxed)),
+				slot.begin.load(std::memory_order_relaxed),
+				slot.end.load(std::memory_order_relaxed),
+				slot.arg.load(std::memory_order_relaxed),
+			};
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.seq.load(std::memory_order_relaxed) != seq || ev.begin < clearTime) {
+				continue;
+			}
+
+			separator();
+			cb << "{\"name\":";
+			exportChromeTrace_string(cb, ev.name);
+			cb << ",\"cat\":";
+			exportChromeTrace_string(cb, ev.category);
+			if (ev.end == ev.begin) {
+				cb << ",\"ph\":\"i\",\"s\":\"t\"";
+			} else {
+				cb << ",\"ph\":\"X\",\"dur\":";
+				exportChromeTrace_time(cb, ev.end - ev.begin);
+			}
+			cb << ",\"ts\":";
+			exportChromeTrace_time(cb, ev.begin);
+			cb << ",\"pid\":1,\"tid\":" << b->threadId;
+			if (ev.arg) {
+				cb << ",\"args\":{\"value\":" << ev.arg << "}";
+			}
+			cb << "}";
+		}
+	}
+
+	cb << "\n]}\n";
+}
+
+bool exportChromeTrace(const FileInfo &info) {
+	StringStream stream;
+	exportChromeTrace([&](StringView str) { stream << str; });
+	auto str = stream.str();
+	return filesystem::write(info, (const uint8_t *)str.data(), str.size());
+}
+
+void clear() {
+	// buffers are owned by writer threads, so, only export and statistics bounds are moved
+	auto data = ProfilerData::getInstance();
+	data->clearTime.store(now(), std::memory_order_relaxed);
+	++data->statsEpoch;
+}
+
+ProfileData begin(StringView tag, StringView variant, uint64_t limit) {
+	return ProfileData{now(), tag, variant, limit};
+}
+
+void end(ProfileData &data) {
+	auto t = now();
+	auto dt = (t - data.timestamp) / 1'000;
+	if (dt > data.limit) {
+		log::source().warn("Profiling", data.tag, " [", data.variant, "]: ", dt, " mks");
+	}
+	if (isEnabled()) {
+		record(data.tag, data.variant, data.timestamp, t);
+	}
+}
+
+void store(ProfileData &data) {
+	if (isEnabled()) {
+		record(data.tag, data.variant, data.timestamp, now());
+	}
+}
+
+} // namespace stappler::xenolith::profiling
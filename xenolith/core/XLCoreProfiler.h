@@ -0,0 +1,136 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_CORE_XLCOREPROFILER_H_
+#define XENOLITH_CORE_XLCOREPROFILER_H_
+
+#include "XLCoreConfig.h"
+#include "SPFilesystem.h"
+
+/* Scoped-zone frame profiler
+ *
+ * Every thread writes zones and statistics into its own buffers, so recording takes no locks.
+ * Buffers are allocated with the first recorded event, statistics from all threads are merged
+ * on request. Profiler is disabled on startup and can be enabled with `profiling::setEnabled`.
+ * Zones are compiled in by default, with XL_PROFILE_ZONES = 0 they are not compiled at all.
+ *
+ * Zone names and categories should be string literals, or should outlive the profiler.
+ */
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::profiling {
+
+struct SP_PUBLIC ZoneEvent {
+	StringView name;
+	StringView category;
+	uint64_t begin = 0; // nanoseconds, steady clock
+	uint64_t end = 0; // equals to begin for instant events
+	uint64_t arg = 0; // user value, like frame order
+};
+
+struct SP_PUBLIC ZoneStats {
+	StringView name;
+	StringView category;
+	uint64_t count = 0;
+	uint64_t total = 0; // nanoseconds
+	uint64_t min = maxOf<uint64_t>();
+	uint64_t max = 0;
+
+	uint64_t getAverage() const { return count ? total / count : 0; }
+};
+
+// Current steady clock value in nanoseconds
+SP_PUBLIC uint64_t now();
+
+SP_PUBLIC void setEnabled(bool);
+SP_PUBLIC bool isEnabled();
+
+// Name for current thread in exported trace
+SP_PUBLIC void setThreadName(StringView);
+
+SP_PUBLIC void record(StringView name, StringView category, uint64_t begin, uint64_t end,
+		uint64_t arg = 0);
+SP_PUBLIC void instant(StringView name, StringView category, uint64_t arg = 0);
+
+// Live statistics, merged from all threads
+SP_PUBLIC void foreachZoneStats(const Callback<void(const ZoneStats &)> &);
+SP_PUBLIC void resetZoneStats();
+
+// Chrome trace event format (JSON), can be loaded into chrome://tracing or Perfetto UI
+// Events, that were overwritten by active threads while exporting, are skipped
+SP_PUBLIC void exportChromeTrace(const Callback<void(StringView)> &);
+SP_PUBLIC bool exportChromeTrace(const FileInfo &);
+
+// Drops recorded events and statistics
+SP_PUBLIC void clear();
+
+class SP_PUBLIC ScopedZone final {
+public:
+	ScopedZone(StringView name, StringView category, uint64_t arg = 0)
+	: _name(name), _category(category), _arg(arg) {
+		if (isEnabled()) {
+			_begin = now();
+		}
+	}
+
+	~ScopedZone() {
+		if (_begin) {
+			record(_name, _category, _begin, now(), _arg);
+		}
+	}
+
+	ScopedZone(const ScopedZone &) = delete;
+	ScopedZone &operator=(const ScopedZone &) = delete;
+
+protected:
+	StringView _name;
+	StringView _category;
+	uint64_t _arg = 0;
+	uint64_t _begin = 0;
+};
+
+} // namespace stappler::xenolith::profiling
+
+#if XL_PROFILE_ZONES
+#define XL_PROFILE_ZONE_CONCAT_IMPL(a, b) a ## b
+#define XL_PROFILE_ZONE_CONCAT(a, b) XL_PROFILE_ZONE_CONCAT_IMPL(a, b)
+
+#define XL_PROFILE_ZONE(name, category) \
+	stappler::xenolith::profiling::ScopedZone XL_PROFILE_ZONE_CONCAT(__xl_zone__, __LINE__)( \
+			name, category);
+
+#define XL_PROFILE_ZONE_ARG(name, category, arg) \
+	stappler::xenolith::profiling::ScopedZone XL_PROFILE_ZONE_CONCAT(__xl_zone__, __LINE__)( \
+			name, category, arg);
+
+#define XL_PROFILE_INSTANT(name, category, arg) \
+	do { \
+		if (stappler::xenolith::profiling::isEnabled()) { \
+			stappler::xenolith::profiling::instant(name, category, arg); \
+		} \
+	} while (0)
+#else
+#define XL_PROFILE_ZONE(name, category)
+#define XL_PROFILE_ZONE_ARG(name, category, arg)
+#define XL_PROFILE_INSTANT(name, category, arg) do { } while (0)
+#endif
+
+#endif /* XENOLITH_CORE_XLCOREPROFILER_H_ */
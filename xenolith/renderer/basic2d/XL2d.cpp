@@ -26,6 +26,7 @@
 #include "XL2dCommandList.cc"
 #include "XL2dVertexArray.cc"
 #include "XL2dFrameContext.cc"
+#include "XL2dCommandFlattener.cc"
 
 #include "XL2dSprite.cc"
 #include "XL2dLayer.cc"
@@ -50,7 +51,7 @@
 #include "particle/XL2dParticleSystem.cc"
 #include "particle/XL2dParticleEmitter.cc"
 
-#ifdef MODULE_XENOLITH_BACKEND_VK
+#if MODULE_XENOLITH_BACKEND_VK
 #include "backend/vk/XL2dVkMaterial.cc"
 #include "backend/vk/XL2dVkVertexPass.cc"
 #include "backend/vk/XL2dVkShadow.cc"
@@ -58,6 +59,10 @@
 #include "backend/vk/XL2dVkShadowPass.cc"
 #endif
 
+#if MODULE_XENOLITH_BACKEND_NULL
+#include "backend/null/XL2dNullRenderQueue.cc"
+#endif
+
 namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
 
 ImagePlacementResult ImagePlacementInfo::resolve(const Size2 &viewSize, const Size2 &imageSize) {
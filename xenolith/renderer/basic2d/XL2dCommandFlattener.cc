@@ -0,0 +1,907 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XL2dCommandFlattener.h"
+#include "XLCoreQueueData.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
+
+struct CommandFlattener::WriteJob : public Ref {
+	const CommandFlattener *flattener = nullptr;
+	WriteTarget target;
+	uint32_t blocks = 0;
+	uint32_t chunkSize = 0;
+	uint32_t chunks = 0;
+
+	std::atomic<uint32_t> next = 0;
+	std::atomic<uint32_t> complete = 0;
+
+	void run() {
+		auto chunk = next.fetch_add(1);
+		while (chunk < chunks) {
+			auto first = chunk * chunkSize;
+			flattener->writeBlocks(target, first, std::min(first + chunkSize, blocks));
+			complete.fetch_add(1);
+			chunk = next.fetch_add(1);
+		}
+	}
+};
+
+// stable LSD radix sort with 8-bit digits, digits with a single bucket are skipped
+template <typename Item>
+static void CommandFlattener_radixSort(Vector<Item> &items) {
+	if (items.size() < 64) {
+		std::stable_sort(items.begin(), items.end(),
+				[](const Item &l, const Item &r) { return l.key < r.key; });
+		return;
+	}
+
+	static constexpr uint32_t Passes = sizeof(uint64_t);
+
+	uint32_t counts[Passes][256];
+	memset(counts, 0, sizeof(counts));
+
+	for (auto &it : items) {
+		for (uint32_t p = 0; p < Passes; ++p) { ++counts[p][(it.key >> (p * 8)) & 0xFF]; }
+	}
+
+	Vector<Item> tmp;
+	tmp.resize(items.size());
+
+	auto src = &items;
+	auto dst = &tmp;
+
+	for (uint32_t p = 0; p < Passes; ++p) {
+		auto &c = counts[p];
+		auto shift = p * 8;
+		if (c[(src->front().key >> shift) & 0xFF] == items.size()) {
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (auto &it : c) {
+			auto n = it;
+			it = offset;
+			offset += n;
+		}
+
+		auto target = dst->data();
+		for (auto &it : *src) { target[c[(it.key >> shift) & 0xFF]++] = it; }
+
+		std::swap(src, dst);
+	}
+
+	if (src != &items) {
+		items.swap(tmp);
+	}
+}
+
+static bool CommandFlattener_compareMaterials(const core::Material *l, const core::Material *r) {
+	auto lp = l->getPipeline();
+	auto rp = r->getPipeline();
+	if (lp != rp) {
+		auto &lm = lp->material;
+		auto &rm = rp->material;
+		if (lm.getDepthInfo().writeEnabled != rm.getDepthInfo().writeEnabled) {
+			return lm.getDepthInfo().writeEnabled; // pipelines with depth write comes first
+		} else if (lm.getBlendInfo().enabled != rm.getBlendInfo().enabled) {
+			return !lm.getBlendInfo().enabled; // pipelines without blending comes first
+		}
+		return lp < rp;
+	} else if (l->getLayoutIndex() != r->getLayoutIndex()) {
+		return l->getLayoutIndex() < r->getLayoutIndex();
+	}
+	return l->getId() < r->getId();
+}
+
+uint64_t CommandFlattener::makeSortKey(Level level, uint32_t zRank, uint32_t materialRank,
+		StateId state, BlockType type) {
+	// objects without state are drawn last within the material
+	uint64_t stateValue = (state == StateIdNone) ? StateMask : (state & StateMask);
+
+	return (uint64_t(level) << (64 - LevelBits))
+			| (uint64_t(zRank & ZRankMask) << (BlockTypeBits + StateBits + MaterialBits))
+			| (uint64_t(materialRank & MaterialMask) << (BlockTypeBits + StateBits))
+			| (stateValue << BlockTypeBits) | uint64_t(type);
+}
+
+bool CommandFlattener::fitsSortKey(uint32_t zRank, uint32_t materialRank, StateId state) {
+	// StateMask itself is reserved for StateIdNone
+	return zRank <= ZRankMask && materialRank <= MaterialMask
+			&& (state == StateIdNone || state < StateMask);
+}
+
+bool CommandFlattener::init(const CommandFlattenerInfo &info, const core::MaterialSet *set,
+		FrameContextHandle2d *input) {
+	_info = info;
+	_materialSet = set;
+	_input = input;
+
+	if (_input && _input->commands) {
+		_paths.reserve(_input->commands->size());
+		_blocks.reserve(_input->commands->size());
+	}
+	return _materialSet != nullptr;
+}
+
+void CommandFlattener::pushCommands(const CommandList *list) {
+	auto cmd = list->getFirst();
+	while (cmd) {
+		pushCommand(cmd);
+		cmd = cmd->next;
+	}
+}
+
+void CommandFlattener::pushCommand(const Command *c) {
+	switch (c->type) {
+	case CommandType::CommandGroup: break;
+	case CommandType::VertexArray: {
+		auto cmd = reinterpret_cast<const CmdVertexArray *>(c->data);
+		auto material = acquireMaterial(cmd->material);
+		if (material == maxOf<uint32_t>()) {
+			return;
+		}
+
+		Level level = Level::Transparent;
+		if (_materials[material].material->getPipeline()->isSolid()) {
+			level = Level::Solid;
+		} else if (cmd->renderingLevel == RenderingLevel::Surface) {
+			level = Level::Surface;
+		}
+		pushVertexArray(c, cmd, material, level, cmd->vertexes);
+		break;
+	}
+	case CommandType::Deferred: {
+		auto cmd = reinterpret_cast<const CmdDeferred *>(c->data);
+		auto material = acquireMaterial(cmd->material);
+		if (material == maxOf<uint32_t>()) {
+			return;
+		}
+
+		if (!cmd->deferred->isWaitOnReady()) {
+			if (!cmd->deferred->isReady()) {
+				return;
+			}
+		}
+
+		SpanView<InstanceVertexData> storedVertexes;
+
+		cmd->deferred->acquireResult(
+				[&](SpanView<InstanceVertexData> vertexes, DeferredVertexResult::Flags flags) {
+			auto v = vertexes.pdup();
+			applyNormalized(v, cmd);
+			storedVertexes = v;
+		});
+
+		Level level = Level::Transparent;
+		if (cmd->renderingLevel == RenderingLevel::Solid) {
+			level = Level::Solid;
+		} else if (cmd->renderingLevel == RenderingLevel::Surface) {
+			level = Level::Surface;
+		}
+		pushVertexArray(c, cmd, material, level, storedVertexes);
+		break;
+	}
+	case CommandType::ParticleEmitter: {
+		auto cmd = reinterpret_cast<const CmdParticleEmitter *>(c->data);
+		auto material = acquireMaterial(cmd->material);
+		if (material == maxOf<uint32_t>()) {
+			return;
+		}
+
+		Level level = Level::Transparent;
+		if (_materials[material].material->getPipeline()->isSolid()) {
+			level = Level::Solid;
+		} else if (cmd->renderingLevel == RenderingLevel::Surface) {
+			level = Level::Surface;
+		}
+		pushParticleEmitter(cmd, material, level);
+		break;
+	}
+	}
+}
+
+void CommandFlattener::sort() {
+	// z-path ranks: equal paths share the same rank
+	Vector<uint32_t> order;
+	order.resize(_paths.size());
+	for (uint32_t i = 0; i < order.size(); ++i) { order[i] = i; }
+
+	std::sort(order.begin(), order.end(),
+			[&](uint32_t l, uint32_t r) { return ZOrderLess()(_paths[l], _paths[r]); });
+
+	uint32_t rank = 0;
+	_pathRanks.resize(_paths.size());
+	for (uint32_t i = 0; i < order.size(); ++i) {
+		if (i > 0 && ZOrderLess()(_paths[order[i - 1]], _paths[order[i]])) {
+			++rank;
+		}
+		_pathRanks[order[i]] = rank;
+	}
+	_pathsCount = _paths.empty() ? 0 : rank + 1;
+
+	// material ranks: minimize pipeline and texture set switching
+	order.resize(_materials.size());
+	for (uint32_t i = 0; i < order.size(); ++i) { order[i] = i; }
+
+	std::sort(order.begin(), order.end(), [&](uint32_t l, uint32_t r) {
+		return CommandFlattener_compareMaterials(_materials[l].material, _materials[r].material);
+	});
+
+	for (uint32_t i = 0; i < order.size(); ++i) { _materials[order[i]].rank = i; }
+
+	// full-width group key, used when values do not fit into the packed key
+	auto getWideKey = [&](const Block &b) {
+		auto zRank = (b.level == Level::Transparent) ? _pathRanks[b.path] : 0;
+		auto state = (b.cmd->state == StateIdNone) ? uint64_t(maxOf<uint32_t>()) + 1
+												   : uint64_t(b.cmd->state);
+		return std::make_tuple(toInt(b.level), zRank, _materials[b.material].rank, state);
+	};
+
+	bool overflow = false;
+	_sorted.resize(_blocks.size());
+	for (uint32_t i = 0; i < _blocks.size(); ++i) {
+		auto &b = _blocks[i];
+		auto zRank = (b.level == Level::Transparent) ? _pathRanks[b.path] : 0;
+		auto materialRank = _materials[b.material].rank;
+		if (!fitsSortKey(zRank, materialRank, b.cmd->state)) {
+			overflow = true;
+		}
+		_sorted[i] = SortItem{makeSortKey(b.level, zRank, materialRank, b.cmd->state, b.type), i};
+	}
+
+	if (overflow) {
+		log::source().warn("CommandFlattener", "Sort key overflow (", _pathsCount, " z-paths, ",
+				_materials.size(), " materials), fallback to comparison sort");
+
+		std::stable_sort(_sorted.begin(), _sorted.end(), [&](const SortItem &l, const SortItem &r) {
+			auto &lb = _blocks[l.block];
+			auto &rb = _blocks[r.block];
+			auto lk = getWideKey(lb);
+			auto rk = getWideKey(rb);
+			if (lk != rk) {
+				return lk < rk;
+			}
+			return toInt(lb.type) < toInt(rb.type);
+		});
+	} else {
+		CommandFlattener_radixSort(_sorted);
+	}
+
+	_groups.clear();
+
+	uint64_t groupKey = 0;
+	for (uint32_t i = 0; i < _sorted.size(); ++i) {
+		auto key = _sorted[i].key >> BlockTypeBits;
+		auto &b = _blocks[_sorted[i].block];
+		bool newGroup = _groups.empty() || key != groupKey;
+		if (overflow && !newGroup) {
+			newGroup = getWideKey(b) != getWideKey(_blocks[_sorted[i - 1].block]);
+		}
+		if (newGroup) {
+			auto &g = _groups.emplace_back(Group());
+			g.first = i;
+			g.level = b.level;
+			g.material = b.material;
+			g.state = b.cmd->state;
+
+			if (g.state != StateIdNone) {
+				if (auto state = _input->getState(g.state)) {
+					g.stateData =
+							dynamic_cast<StateData *>(state->data ? state->data.get() : nullptr);
+					if (g.stateData && g.stateData->gradient) {
+						_vertexes += g.stateData->gradient->steps.size() + 2;
+					}
+				}
+			}
+
+			groupKey = key;
+		}
+
+		++_groups.back().count;
+		b.group = uint32_t(_groups.size() - 1);
+	}
+}
+
+void CommandFlattener::write(WriteTarget &target, Result &result) {
+	writeInitial(target);
+
+	if (_vertexes == 0 || _indexes == 0) {
+		return;
+	}
+
+	// assign offsets for all blocks, so they can be written independently
+	for (auto &g : _groups) {
+		if (g.stateData && g.stateData->gradient) {
+			g.gradientStart = target.vertexOffset;
+			g.gradientCount = uint32_t(g.stateData->gradient->steps.size());
+			target.vertexOffset += g.gradientCount + 2;
+		}
+
+		for (auto i = g.first; i < g.first + g.count; ++i) {
+			auto &b = _blocks[_sorted[i].block];
+			b.vertexOffset = target.vertexOffset;
+			b.transformOffset = target.transformOffset;
+
+			switch (b.type) {
+			case BlockType::Instanced:
+				for (auto &it : b.vertexes) {
+					target.vertexOffset += it.data->data.size();
+					target.transformOffset += it.instances.size();
+				}
+				break;
+			case BlockType::Packed:
+				for (auto &it : b.vertexes) {
+					target.vertexOffset += it.data->data.size();
+					++target.transformOffset;
+				}
+				break;
+			case BlockType::Particle:
+				// particles uses transforms, preallocated by command list
+				if (b.particle->transformIndex) {
+					b.transformOffset = b.particle->transformIndex;
+				} else {
+					++target.transformOffset;
+				}
+				break;
+			}
+
+			b.vertexCount = target.vertexOffset - b.vertexOffset;
+			b.transformCount =
+					(b.type == BlockType::Particle) ? 1 : target.transformOffset - b.transformOffset;
+		}
+
+		writeGradient(target, g);
+	}
+
+	auto nblocks = uint32_t(_sorted.size());
+	if (_info.parallelThreshold > 0 && _info.threadCount > 1 && _info.dispatch
+			&& nblocks > _info.parallelThreshold) {
+		auto job = Rc<WriteJob>::alloc();
+		job->flattener = this;
+		job->target = target;
+		job->blocks = nblocks;
+		job->chunkSize = std::max(nblocks / (_info.threadCount * 4), uint32_t(32));
+		job->chunks = (nblocks + job->chunkSize - 1) / job->chunkSize;
+
+		for (uint32_t i = 1; i < std::min(_info.threadCount, job->chunks); ++i) {
+			_info.dispatch([job] { job->run(); });
+		}
+
+		// help with our own chunks, then wait for the chunks in progress
+		job->run();
+		while (job->complete.load() < job->chunks) { std::this_thread::yield(); }
+	} else {
+		writeBlocks(target, 0, nblocks);
+	}
+
+	writeIndexes(target, result, IndexPhase::General);
+	writeIndexes(target, result, IndexPhase::ShadowSolid);
+	writeIndexes(target, result, IndexPhase::ShadowVolumes);
+}
+
+uint32_t CommandFlattener::acquireMaterial(core::MaterialId id) {
+	if (_lastMaterial < _materials.size() && _materials[_lastMaterial].id == id) {
+		return _lastMaterial;
+	}
+
+	auto it = std::lower_bound(_materialsIndex.begin(), _materialsIndex.end(), id,
+			[&](uint32_t l, core::MaterialId r) { return _materials[l].id < r; });
+	if (it == _materialsIndex.end() || _materials[*it].id != id) {
+		auto material = _materialSet->getMaterialById(id);
+		if (!material) {
+			return maxOf<uint32_t>();
+		}
+
+		// blocks refer materials by index, so _materials is append-only
+		_materials.emplace_back(MaterialInfo{id, material, material->getAtlas(), 0});
+		it = _materialsIndex.emplace(it, uint32_t(_materials.size() - 1));
+	}
+
+	_lastMaterial = *it;
+	return _lastMaterial;
+}
+
+uint32_t CommandFlattener::pushPath(SpanView<ZOrder> path) {
+	_paths.emplace_back(path);
+	return uint32_t(_paths.size() - 1);
+}
+
+void CommandFlattener::pushVertexArray(const Command *c, const CmdInfo *cmd, uint32_t material,
+		Level level, SpanView<InstanceVertexData> vertexes) {
+	auto path = pushPath(cmd->zPath);
+
+	auto pushBlock = [&](BlockType type, const InstanceVertexData *data, size_t count) {
+		auto &b = _blocks.emplace_back(Block());
+		b.vertexes = makeSpanView(data, count);
+		b.cmd = cmd;
+		b.level = level;
+		b.type = type;
+		b.material = material;
+		b.path = path;
+	};
+
+	const InstanceVertexData *packedStart = vertexes.data();
+	size_t packedCommands = 0;
+
+	for (auto &vIt : vertexes) {
+		// count data objects
+		_vertexes += vIt.data->data.size();
+		_indexes += vIt.data->indexes.size();
+
+		if (vIt.sdfIndexes > 0) {
+			_indexes += (vIt.sdfIndexes + vIt.fillIndexes);
+		}
+
+		if ((c->flags & CommandFlags::DoNotCount) != CommandFlags::None) {
+			_excludeVertexes += vIt.data->data.size();
+			_excludeIndexes += vIt.data->indexes.size();
+		}
+
+		_maxShadowValue = std::max(_maxShadowValue, cmd->depthValue);
+
+		// pack non-instanced blocks
+		if (vIt.instances.size() > 1) {
+			_transforms += vIt.instances.size();
+
+			if (packedCommands > 0) {
+				pushBlock(BlockType::Packed, packedStart, packedCommands);
+			}
+
+			pushBlock(BlockType::Instanced, &vIt, 1);
+
+			packedCommands = 0;
+			packedStart = &vIt + 1;
+		} else {
+			++_transforms;
+			++packedCommands;
+		}
+	}
+
+	if (packedCommands > 0) {
+		pushBlock(BlockType::Packed, packedStart, packedCommands);
+	}
+}
+
+void CommandFlattener::pushParticleEmitter(const CmdParticleEmitter *cmd, uint32_t material,
+		Level level) {
+	auto &b = _blocks.emplace_back(Block());
+	b.cmd = cmd;
+	b.particle = cmd;
+	b.level = level;
+	b.type = BlockType::Particle;
+	b.material = material;
+	b.path = pushPath(cmd->zPath);
+}
+
+void CommandFlattener::applyNormalized(SpanView<InstanceVertexData> &vertexes,
+		const CmdDeferred *cmd) {
+	// apply transforms;
+	if (cmd->normalized) {
+		for (auto &it : vertexes) {
+			if (it.instances.size() > 0) {
+				const_cast<SpanView<TransformData> &>(it.instances) = it.instances.pdup();
+			} else {
+				TransformData instance;
+				instance.transform = Mat4::IDENTITY;
+				const_cast<SpanView<TransformData> &>(it.instances) =
+						makeSpanView(&instance, 1).pdup();
+			}
+			for (auto &inst : it.instances) {
+				auto modelTransform = cmd->modelTransform * inst.transform;
+
+				Mat4 newMV;
+				newMV.m[12] = std::floor(modelTransform.m[12]);
+				newMV.m[13] = std::floor(modelTransform.m[13]);
+				newMV.m[14] = std::floor(modelTransform.m[14]);
+
+				const_cast<TransformData &>(inst).transform = cmd->viewTransform * newMV;
+			}
+		}
+	} else {
+		auto viewModel = cmd->viewTransform * cmd->modelTransform;
+		for (auto &it : vertexes) {
+			if (it.instances.size() > 0) {
+				const_cast<SpanView<TransformData> &>(it.instances) = it.instances.pdup();
+			} else {
+				TransformData instance;
+				instance.transform = Mat4::IDENTITY;
+				const_cast<SpanView<TransformData> &>(it.instances) =
+						makeSpanView(&instance, 1).pdup();
+			}
+
+			// transforms are updated in place with the batched kernel
+			auto data = const_cast<TransformData *>(it.instances.data());
+			simd::multiplyMat4Batch(viewModel.m, data->transform.m, sizeof(TransformData),
+					data->transform.m, sizeof(TransformData), it.instances.size());
+		}
+	}
+}
+
+void CommandFlattener::writeInitial(WriteTarget &writeTarget) {
+	if (writeTarget.transform) {
+		TransformData nullTransforml;
+		nullTransforml.offset = Vec4::ZERO;
+		memcpy(writeTarget.transform, &nullTransforml, sizeof(TransformData));
+		++writeTarget.transformOffset;
+	}
+
+	if (writeTarget.indexes) {
+		uint32_t indexes[]{0, 2, 1, 0, 3, 2, 4, 6, 5, 4, 7, 6};
+		memcpy(writeTarget.indexes, indexes, sizeof(indexes));
+		writeTarget.indexOffset += sizeof(indexes) / sizeof(uint32_t);
+	}
+
+	if (writeTarget.vertexes) {
+		auto shadowSize = _info.shadowSize;
+		Vertex vertexes[]{// full screen quad data
+			Vertex{Vec4(-1.0f, -1.0f, 0.0f, 1.0f), Vec4::ONE, Vec2::ZERO, 0, 0},
+			Vertex{Vec4(-1.0f, 1.0f, 0.0f, 1.0f), Vec4::ONE, Vec2::UNIT_Y, 0, 0},
+			Vertex{Vec4(1.0f, 1.0f, 0.0f, 1.0f), Vec4::ONE, Vec2::ONE, 0, 0},
+			Vertex{Vec4(1.0f, -1.0f, 0.0f, 1.0f), Vec4::ONE, Vec2::UNIT_X, 0, 0},
+
+			// shadow quad data
+			Vertex{Vec4(-1.0f, -1.0f, 0.0f, 1.0f), Vec4::ONE, Vec2(0.0f, 1.0f - shadowSize.y), 0,
+				0},
+			Vertex{Vec4(-1.0f, 1.0f, 0.0f, 1.0f), Vec4::ONE, Vec2(0.0f, 1.0f), 0, 0},
+			Vertex{Vec4(1.0f, 1.0f, 0.0f, 1.0f), Vec4::ONE, Vec2(shadowSize.x, 1.0f), 0, 0},
+			Vertex{Vec4(1.0f, -1.0f, 0.0f, 1.0f), Vec4::ONE,
+				Vec2(shadowSize.x, 1.0f - shadowSize.y), 0, 0}};
+
+		switch (core::getPureTransform(_info.transform)) {
+		case core::SurfaceTransformFlags::Rotate90:
+			vertexes[0].tex = Vec2::UNIT_Y;
+			vertexes[1].tex = Vec2::ONE;
+			vertexes[2].tex = Vec2::UNIT_X;
+			vertexes[3].tex = Vec2::ZERO;
+			vertexes[4].tex = Vec2(0.0f, shadowSize.y);
+			vertexes[5].tex = shadowSize;
+			vertexes[6].tex = Vec2(shadowSize.x, 0.0f);
+			vertexes[7].tex = Vec2::ZERO;
+			break;
+		case core::SurfaceTransformFlags::Rotate180:
+			vertexes[0].tex = Vec2::ONE;
+			vertexes[1].tex = Vec2::UNIT_X;
+			vertexes[2].tex = Vec2::ZERO;
+			vertexes[3].tex = Vec2::UNIT_Y;
+			vertexes[4].tex = shadowSize;
+			vertexes[5].tex = Vec2(shadowSize.x, 0.0f);
+			vertexes[6].tex = Vec2::ZERO;
+			vertexes[7].tex = Vec2(0.0f, shadowSize.y);
+			break;
+		case core::SurfaceTransformFlags::Rotate270:
+			vertexes[0].tex = Vec2::UNIT_X;
+			vertexes[1].tex = Vec2::ZERO;
+			vertexes[2].tex = Vec2::UNIT_Y;
+			vertexes[3].tex = Vec2::ONE;
+			vertexes[4].tex = Vec2(shadowSize.x, 0.0f);
+			vertexes[5].tex = Vec2::ZERO;
+			vertexes[6].tex = Vec2(0.0f, shadowSize.y);
+			vertexes[7].tex = shadowSize;
+			break;
+		default: break;
+		}
+
+		memcpy(writeTarget.vertexes, vertexes, sizeof(vertexes));
+		writeTarget.vertexOffset += sizeof(vertexes) / sizeof(Vertex);
+	}
+}
+
+void CommandFlattener::writeGradient(WriteTarget &writeTarget, Group &group) {
+	// write gradient vertexes (2 + n: start, end, anchors)
+	if (!group.stateData || !group.stateData->gradient) {
+		return;
+	}
+
+	auto stateData = group.stateData;
+	auto target = reinterpret_cast<Vertex *>(writeTarget.vertexes) + group.gradientStart;
+
+	Vec2 start = stateData->transform * stateData->gradient->start;
+	Vec2 end = stateData->transform * stateData->gradient->end;
+
+	start.y = _info.surfaceExtent.height - start.y;
+	end.y = _info.surfaceExtent.height - end.y;
+
+	Vec2 norm = end - start;
+
+	float d = norm.y * norm.y / (norm.x * norm.x + norm.y * norm.y);
+
+	Vec2 axisAngle;
+	if (std::abs(norm.y) > std::abs(norm.x)) {
+		axisAngle.x = std::copysign(norm.length(), norm.y);
+		axisAngle.y = d;
+	} else {
+		axisAngle.x = std::copysign(norm.length(), norm.x);
+		axisAngle.y = d;
+	}
+
+	target->pos = Vec4(start, 0.0f, 0.0f);
+	target->tex = axisAngle;
+	++target;
+
+	target->pos = Vec4(end, 1.0f, 0.0f);
+	target->tex = axisAngle;
+	++target;
+
+	for (auto &it : stateData->gradient->steps) {
+		target->pos = Vec4(math::lerp(start, end, it.value), it.value, it.factor);
+		target->tex = axisAngle;
+		target->color = Vec4(it.color.r, it.color.g, it.color.b, it.color.a);
+		++target;
+	}
+}
+
+void CommandFlattener::writeBlocks(const WriteTarget &writeTarget, uint32_t first,
+		uint32_t last) const {
+	for (auto i = first; i < last; ++i) {
+		auto &b = _blocks[_sorted[i].block];
+		auto &group = _groups[b.group];
+		auto &material = _materials[b.material];
+
+		float zOffset = getPathDepth(b.path);
+		float depthValue = 0.0f;
+
+		if (b.cmd->depthValue > 0.0f) {
+			auto f16 = sprt::halffloat::encode(b.cmd->depthValue);
+			depthValue = sprt::halffloat::decode(f16);
+		}
+
+		auto vertexTarget = reinterpret_cast<Vertex *>(writeTarget.vertexes) + b.vertexOffset;
+		auto transformIndex = b.transformOffset;
+
+		switch (b.type) {
+		case BlockType::Instanced:
+			// transform is selected with firstInstance for instanced drawing
+			for (auto &it : b.vertexes) {
+				for (auto &inst : it.instances) {
+					writeTransform(writeTarget.transform + transformIndex, inst, zOffset,
+							depthValue, group.stateData);
+					++transformIndex;
+				}
+
+				writeVertexes(vertexTarget, material, 0, it);
+				vertexTarget += it.data->data.size();
+			}
+			break;
+		case BlockType::Packed:
+			for (auto &it : b.vertexes) {
+				writeTransform(writeTarget.transform + transformIndex, it.instances.front(),
+						zOffset, depthValue, group.stateData);
+				writeVertexes(vertexTarget, material, transformIndex, it);
+				vertexTarget += it.data->data.size();
+				++transformIndex;
+			}
+			break;
+		case BlockType::Particle:
+			writeTransform(writeTarget.transform + transformIndex,
+					TransformData(b.particle->transform), zOffset, depthValue, group.stateData);
+			break;
+		}
+	}
+}
+
+void CommandFlattener::writeVertexes(Vertex *target, const MaterialInfo &material,
+		uint32_t transform, const InstanceVertexData &vertexes) const {
+	auto materialId = material.id;
+
+	memcpy(target, vertexes.data->data.data(), vertexes.data->data.size() * sizeof(Vertex));
+
+	size_t idx = 0;
+	if (material.atlas) {
+		if (_info.hasGpuSideAtlases) {
+			for (; idx < vertexes.data->data.size(); ++idx) {
+				target[idx].material = materialId | transform << 16;
+			}
+		} else {
+			auto ext = material.atlas->getImageExtent();
+			float atlasScaleX = 1.0f / ext.width;
+			float atlasScaleY = 1.0f / ext.height;
+
+			for (; idx < vertexes.data->data.size(); ++idx) {
+				auto &t = target[idx];
+				t.material = materialId | transform << 16;
+
+				struct AtlasData {
+					Vec2 pos;
+					Vec2 tex;
+				};
+
+				if (auto d = reinterpret_cast<const AtlasData *>(
+							material.atlas->getObjectByName(t.object))) {
+					t.pos += Vec4(d->pos.x, d->pos.y, 0, 0);
+					t.tex = d->tex;
+					t.object = 0;
+				} else {
+#if DEBUG
+					log::source().warn("CommandFlattener", "Object not found: ", t.object, " ",
+							string::toUtf8<Interface>(char16_t(t.object)));
+#endif
+					auto anchor = font::CharId::getAnchorForChar(t.object);
+					switch (anchor) {
+					case font::CharAnchor::BottomLeft:
+						t.tex = Vec2(1.0f - atlasScaleX, 0.0f);
+						break;
+					case font::CharAnchor::TopLeft:
+						t.tex = Vec2(1.0f - atlasScaleX, 0.0f + atlasScaleY);
+						break;
+					case font::CharAnchor::TopRight: t.tex = Vec2(1.0f, 0.0f + atlasScaleY); break;
+					case font::CharAnchor::BottomRight: t.tex = Vec2(1.0f, 0.0f); break;
+					}
+				}
+			}
+		}
+	} else {
+		for (; idx < vertexes.data->data.size(); ++idx) {
+			target[idx].material = materialId | transform << 16;
+		}
+	}
+}
+
+void CommandFlattener::writeTransform(TransformData *target, const TransformData &inst,
+		float zOffset, float depthValue, const StateData *stateData) const {
+	memcpy(target, &inst, sizeof(TransformData));
+	target->offset.z = zOffset;
+	target->shadowValue = depthValue;
+	if (stateData) {
+		target->outlineColor = stateData->outlineColor;
+		target->outlineOffset = stateData->outlineOffset;
+	} else {
+		target->outlineOffset = 0.0f;
+	}
+}
+
+void CommandFlattener::writeIndexes(WriteTarget &writeTarget, Result &result,
+		IndexPhase phase) {
+	auto writeIndexes = [](uint32_t *indexTarget, const uint32_t *indexSource, uint32_t indexCount,
+								uint32_t vertexOffset) {
+		if (vertexOffset == 0) {
+			memcpy(indexTarget, indexSource, indexCount * sizeof(uint32_t));
+		} else {
+			for (size_t i = 0; i < indexCount; ++i) {
+				*(indexTarget++) = *(indexSource++) + vertexOffset;
+			}
+		}
+		return indexCount;
+	};
+
+	auto pushIndexes = [&](const InstanceVertexData &vertexes, uint32_t localVertexOffset) {
+		auto target = reinterpret_cast<uint32_t *>(writeTarget.indexes) + writeTarget.indexOffset;
+		switch (phase) {
+		case IndexPhase::General:
+			writeTarget.indexOffset += writeIndexes(target, vertexes.data->indexes.data(),
+					uint32_t(vertexes.data->indexes.size() - vertexes.sdfIndexes),
+					localVertexOffset);
+			break;
+		case IndexPhase::ShadowSolid:
+			if (vertexes.sdfIndexes > 0 && vertexes.fillIndexes > 0) {
+				writeTarget.indexOffset += writeIndexes(target, vertexes.data->indexes.data(),
+						vertexes.fillIndexes, localVertexOffset);
+			}
+			break;
+		case IndexPhase::ShadowVolumes:
+			if (vertexes.sdfIndexes > 0) {
+				writeTarget.indexOffset += writeIndexes(target,
+						vertexes.data->indexes.data() + vertexes.fillIndexes
+								+ vertexes.strokeIndexes,
+						vertexes.sdfIndexes, localVertexOffset);
+			}
+			break;
+		}
+	};
+
+	Vector<VertexSpan> *spans = nullptr;
+	switch (phase) {
+	case IndexPhase::General: spans = &result.materialSpans; break;
+	case IndexPhase::ShadowSolid: spans = &result.shadowSolidSpans; break;
+	case IndexPhase::ShadowVolumes: spans = &result.shadowSdfSpans; break;
+	}
+
+	for (auto &g : _groups) {
+		auto materialId = _materials[g.material].id;
+		auto outlineOffset = g.stateData ? g.stateData->outlineOffset : 0.0f;
+		auto spansCount = spans->size();
+
+		auto makeSpan = [&](uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+								uint32_t vertexOffset, uint32_t firstInstance) {
+			return VertexSpan{.material = materialId,
+				.indexCount = indexCount,
+				.instanceCount = instanceCount,
+				.firstIndex = firstIndex,
+				.vertexOffset = vertexOffset,
+				.firstInstance = firstInstance,
+				.state = g.state,
+				.gradientOffset = g.gradientStart,
+				.gradientCount = g.gradientCount,
+				.outlineOffset = outlineOffset};
+		};
+
+		uint32_t packedIndexes = 0;
+		uint32_t packedVertexOffset = maxOf<uint32_t>();
+		uint32_t localVertexOffset = 0;
+
+		// blocks are sorted by type within the group: instanced, packed, particles
+		for (auto i = g.first; i < g.first + g.count; ++i) {
+			auto &b = _blocks[_sorted[i].block];
+			switch (b.type) {
+			case BlockType::Instanced:
+				for (auto &it : b.vertexes) {
+					auto firstIndex = writeTarget.indexOffset;
+					pushIndexes(it, 0);
+					if (writeTarget.indexOffset > firstIndex) {
+						spans->emplace_back(makeSpan(writeTarget.indexOffset - firstIndex,
+								b.transformCount, firstIndex, b.vertexOffset, b.transformOffset));
+					}
+				}
+				break;
+			case BlockType::Packed:
+				if (packedVertexOffset == maxOf<uint32_t>()) {
+					packedVertexOffset = b.vertexOffset;
+					packedIndexes = writeTarget.indexOffset;
+				}
+				for (auto &it : b.vertexes) {
+					pushIndexes(it, localVertexOffset);
+					localVertexOffset += it.data->data.size();
+				}
+				break;
+			case BlockType::Particle:
+				if (packedVertexOffset != maxOf<uint32_t>()) {
+					if (writeTarget.indexOffset > packedIndexes) {
+						spans->emplace_back(makeSpan(writeTarget.indexOffset - packedIndexes, 1,
+								packedIndexes, packedVertexOffset, 0));
+					}
+					packedVertexOffset = maxOf<uint32_t>();
+				}
+
+				// do not draw shadows for a particles for now
+				if (phase == IndexPhase::General) {
+					auto span = makeSpan(0, 1, 0, 0, 0);
+					span.particleSystemId = b.particle->id;
+					spans->emplace_back(span);
+				}
+				break;
+			}
+		}
+
+		if (packedVertexOffset != maxOf<uint32_t>()) {
+			if (writeTarget.indexOffset > packedIndexes) {
+				spans->emplace_back(makeSpan(writeTarget.indexOffset - packedIndexes, 1,
+						packedIndexes, packedVertexOffset, 0));
+			}
+		}
+
+		if (phase == IndexPhase::General) {
+			auto count = uint32_t(spans->size() - spansCount);
+			switch (g.level) {
+			case Level::Solid: result.solidCmds += count; break;
+			case Level::Surface: result.surfaceCmds += count; break;
+			case Level::Transparent: result.transparentCmds += count; break;
+			}
+		}
+	}
+}
+
+float CommandFlattener::getPathDepth(uint32_t path) const {
+	float depthScale = 1.0f / float(_pathsCount + 1);
+	return 1.0f - depthScale * float(_pathRanks[path] + 1);
+}
+
+} // namespace stappler::xenolith::basic2d
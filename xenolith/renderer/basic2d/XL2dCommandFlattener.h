@@ -0,0 +1,230 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_RENDERER_BASIC2D_XL2DCOMMANDFLATTENER_H_
+#define XENOLITH_RENDERER_BASIC2D_XL2DCOMMANDFLATTENER_H_
+
+#include "XL2dFrameContext.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
+
+struct SP_PUBLIC CommandFlattenerInfo {
+	Extent3 surfaceExtent;
+	core::SurfaceTransformFlags transform = core::SurfaceTransformFlags::Identity;
+	Vec2 shadowSize = Vec2(1.0f, 1.0f);
+	bool hasGpuSideAtlases = false;
+
+	// Vertex copy is split between threads, when number of blocks is greater than threshold
+	// Zero threshold disables parallel copy
+	uint32_t parallelThreshold = 0;
+	uint32_t threadCount = 1;
+
+	// Should run function on some other thread; flattener will wait for the results
+	Function<void(Function<void()> &&)> dispatch;
+};
+
+/* Backend-independent command list processor for the 2d vertex pass
+ *
+ * Every drawable part of the command list becomes a block with a 64-bit sort key:
+ *
+ * | level (2) | z-path rank (22) | material rank (16) | state (22) | block type (2) |
+ *
+ * Blocks are sorted with stable LSD radix sort, so command order is preserved within
+ * the same key. Blocks with the same key prefix (without block type) form a group, that
+ * is drawn with a single VertexSpan (except instanced blocks, that requires own span).
+ *
+ * Z-path rank is used only for transparent level, solid and surface objects can be drawn
+ * out of order. Material rank is based on pipeline properties, to minimize pipeline switches.
+ */
+class SP_PUBLIC CommandFlattener {
+public:
+	enum class Level : uint8_t {
+		Solid,
+		Surface,
+		Transparent,
+	};
+
+	enum class BlockType : uint8_t {
+		Instanced,
+		Packed,
+		Particle,
+	};
+
+	static constexpr uint32_t BlockTypeBits = 2;
+	static constexpr uint32_t StateBits = 22;
+	static constexpr uint32_t MaterialBits = 16;
+	static constexpr uint32_t ZRankBits = 22;
+	static constexpr uint32_t LevelBits = 2;
+
+	static_assert(BlockTypeBits + StateBits + MaterialBits + ZRankBits + LevelBits == 64);
+
+	static constexpr uint32_t StateMask = (1 << StateBits) - 1;
+	static constexpr uint32_t MaterialMask = (1 << MaterialBits) - 1;
+	static constexpr uint32_t ZRankMask = (1 << ZRankBits) - 1;
+
+	struct WriteTarget {
+		TransformData *transform = nullptr;
+		uint8_t *vertexes = nullptr;
+		uint8_t *indexes = nullptr;
+
+		uint32_t vertexOffset = 0;
+		uint32_t indexOffset = 0;
+		uint32_t transformOffset = 0;
+	};
+
+	struct Result {
+		Vector<VertexSpan> materialSpans;
+		Vector<VertexSpan> shadowSolidSpans;
+		Vector<VertexSpan> shadowSdfSpans;
+
+		uint32_t solidCmds = 0;
+		uint32_t surfaceCmds = 0;
+		uint32_t transparentCmds = 0;
+	};
+
+	// Values should fit into the key fields (see fitsSortKey), otherwise distinct groups
+	// would share the same key; sort() falls back to comparison sort for such frames
+	static uint64_t makeSortKey(Level, uint32_t zRank, uint32_t materialRank, StateId,
+			BlockType);
+	static bool fitsSortKey(uint32_t zRank, uint32_t materialRank, StateId);
+
+	bool init(const CommandFlattenerInfo &, const core::MaterialSet *, FrameContextHandle2d *);
+
+	// Deferred results are copied into the current memory pool
+	void pushCommands(const CommandList *);
+	void pushCommand(const Command *);
+
+	// Assign ranks, build keys and sort blocks; required before write
+	void sort();
+
+	// Buffers should be large enough to hold initial data with all counted vertexes, indexes
+	// and transforms
+	void write(WriteTarget &, Result &);
+
+	uint32_t getVertexesCount() const { return _vertexes; }
+	uint32_t getIndexesCount() const { return _indexes; }
+	uint32_t getTransformsCount() const { return _transforms; }
+
+	uint32_t getExcludedVertexesCount() const { return _excludeVertexes; }
+	uint32_t getExcludedIndexesCount() const { return _excludeIndexes; }
+
+	uint32_t getBlocksCount() const { return uint32_t(_blocks.size()); }
+	uint32_t getGroupsCount() const { return uint32_t(_groups.size()); }
+	uint32_t getPathsCount() const { return _pathsCount; }
+
+	float getMaxShadowValue() const { return _maxShadowValue; }
+
+protected:
+	struct WriteJob;
+
+	struct MaterialInfo {
+		core::MaterialId id = 0;
+		const core::Material *material = nullptr;
+		const core::DataAtlas *atlas = nullptr;
+		uint32_t rank = 0;
+	};
+
+	struct Block {
+		SpanView<InstanceVertexData> vertexes;
+		const CmdInfo *cmd = nullptr;
+		const CmdParticleEmitter *particle = nullptr;
+		Level level = Level::Solid;
+		BlockType type = BlockType::Packed;
+		uint32_t material = 0; // index in _materials
+		uint32_t path = 0; // index in _paths
+		uint32_t group = 0;
+
+		uint32_t vertexOffset = 0;
+		uint32_t vertexCount = 0;
+		uint32_t transformOffset = 0;
+		uint32_t transformCount = 0;
+	};
+
+	struct Group {
+		uint32_t first = 0; // in _sorted
+		uint32_t count = 0;
+		Level level = Level::Solid;
+		uint32_t material = 0;
+		StateId state = StateIdNone;
+		const StateData *stateData = nullptr;
+		uint32_t gradientStart = 0;
+		uint32_t gradientCount = 0;
+	};
+
+	struct SortItem {
+		uint64_t key;
+		uint32_t block;
+	};
+
+	enum class IndexPhase {
+		General,
+		ShadowSolid,
+		ShadowVolumes
+	};
+
+	uint32_t acquireMaterial(core::MaterialId);
+	uint32_t pushPath(SpanView<ZOrder>);
+
+	void pushVertexArray(const Command *, const CmdInfo *, uint32_t material, Level,
+			SpanView<InstanceVertexData>);
+	void pushParticleEmitter(const CmdParticleEmitter *, uint32_t material, Level);
+
+	void applyNormalized(SpanView<InstanceVertexData> &vertexes, const CmdDeferred *cmd);
+
+	void writeInitial(WriteTarget &);
+	void writeGradient(WriteTarget &, Group &);
+	void writeBlocks(const WriteTarget &, uint32_t first, uint32_t last) const;
+	void writeVertexes(Vertex *, const MaterialInfo &, uint32_t transform,
+			const InstanceVertexData &) const;
+	void writeTransform(TransformData *, const TransformData &, float zOffset,
+			float depthValue, const StateData *) const;
+
+	void writeIndexes(WriteTarget &, Result &, IndexPhase);
+
+	float getPathDepth(uint32_t path) const;
+
+	CommandFlattenerInfo _info;
+	const core::MaterialSet *_materialSet = nullptr;
+	FrameContextHandle2d *_input = nullptr;
+
+	Vector<MaterialInfo> _materials;
+	Vector<uint32_t> _materialsIndex; // sorted by MaterialId
+	Vector<SpanView<ZOrder>> _paths;
+	Vector<uint32_t> _pathRanks;
+	Vector<Block> _blocks;
+	Vector<SortItem> _sorted;
+	Vector<Group> _groups;
+
+	uint32_t _lastMaterial = maxOf<uint32_t>();
+	uint32_t _pathsCount = 0;
+
+	uint32_t _vertexes = 0;
+	uint32_t _indexes = 0;
+	uint32_t _transforms = 0;
+	uint32_t _excludeVertexes = 0;
+	uint32_t _excludeIndexes = 0;
+	float _maxShadowValue = 0.0f;
+};
+
+} // namespace stappler::xenolith::basic2d
+
+#endif /* XENOLITH_RENDERER_BASIC2D_XL2DCOMMANDFLATTENER_H_ */
@@ -31,6 +31,7 @@
 #include "XLSceneContent.h"
 #include "XLAppWindow.h"
 #include "backend/vk/XL2dVkShadowPass.h"
+#include "backend/null/XL2dNullRenderQueue.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
 
@@ -188,6 +189,23 @@ bool Scene2d::init(NotNull<AppThread> app, NotNull<AppWindow> window,
 
 	buildQueueResources(queueInfo, builder);
 
+#if MODULE_XENOLITH_BACKEND_NULL
+	auto loop = static_cast<core::Loop *>(app->getContext()->getGlLoop());
+	if (loop && loop->getInstance()->getApi() == core::InstanceApi::None) {
+		basic2d::null::MaterialPass::RenderQueueInfo info{
+			loop,
+			queueInfo.extent,
+			queueInfo.backgroundColor,
+		};
+
+		basic2d::null::MaterialPass::makeRenderQueue(builder, info);
+
+		cb(builder);
+
+		return init(move(builder), constraints);
+	}
+#endif
+
 #if MODULE_XENOLITH_BACKEND_VK
 
 	basic2d::vk::ShadowPass::RenderQueueInfo info{
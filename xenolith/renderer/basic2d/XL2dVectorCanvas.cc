@@ -22,10 +22,15 @@
 
 #include "XL2dVectorCanvas.h"
 #include "SPFilepath.h"
+#include "SPFilesystem.h"
+#include "SPFilesystemFile.h"
+#include "SPFilesystemMap.h"
 #include "SPThread.h"
 
 #include <sprt/runtime/thread/info.h>
 
+#include <optional>
+
 namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
 
 struct VectorCanvasPathOutput {
@@ -56,6 +61,7 @@ struct VectorCanvasCacheData {
 	float quality = 1.0f;
 	float scale = 1.0f;
 	geom::Tesselator::RelocateRule relocateRule = geom::Tesselator::RelocateRule::Auto;
+	geom::LineFlattening flattening = geom::LineFlattening::Recursive;
 	vg::DrawFlags style = vg::DrawFlags::Fill;
 
 	bool operator<(const VectorCanvasCacheData &other) const {
@@ -67,15 +73,99 @@ struct VectorCanvasCacheData {
 			return quality < other.quality;
 		} else if (relocateRule != other.relocateRule) {
 			return toInt(relocateRule) < toInt(other.relocateRule);
+		} else if (flattening != other.flattening) {
+			return toInt(flattening) < toInt(other.flattening);
 		} else {
 			return scale < other.scale;
 		}
 	}
 };
 
+// Bundle file layout: header, entries (sorted by name, style and scale), names, vertexes, indexes
+// All offsets are from the start of the file, vertex and index ranges are in elements
+struct VectorCanvasBundleHeader {
+	static constexpr uint32_t Magic = 0x4256'4C58; // 'XLVB'
+	static constexpr uint32_t Version = 2;
+
+	uint32_t magic = Magic;
+	uint32_t version = Version;
+	uint32_t vertexSize = sizeof(Vertex);
+	uint32_t entriesCount = 0;
+
+	// tesselation config, bundle can be used only with the same values
+	float quality = 1.0f;
+	float boundaryOffset = 0.0f;
+	float boundaryInset = 0.0f;
+	float sdfBoundaryOffset = 0.0f;
+	float sdfBoundaryInset = 0.0f;
+	uint32_t relocateRule = 0;
+	uint32_t fillMaterial = 0;
+	uint32_t strokeMaterial = 0;
+	uint32_t sdfMaterial = 0;
+	uint32_t forcePseudoSdf = 0;
+	uint32_t flattening = 0;
+
+	uint32_t namesSize = 0;
+	uint32_t vertexesCount = 0;
+	uint32_t indexesCount = 0;
+
+	uint64_t entriesOffset = 0;
+	uint64_t namesOffset = 0;
+	uint64_t vertexesOffset = 0;
+	uint64_t indexesOffset = 0;
+	uint64_t fileSize = 0;
+};
+
+struct VectorCanvasBundleEntry {
+	uint32_t nameOffset = 0;
+	uint32_t nameSize = 0;
+	uint32_t style = 0;
+	float scale = 1.0f;
+	uint32_t fillIndexes = 0;
+	uint32_t strokeIndexes = 0;
+	uint32_t sdfIndexes = 0;
+	uint32_t firstVertex = 0;
+	uint32_t vertexCount = 0;
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+	uint32_t padding = 0;
+};
+
+struct VectorCanvasBundle : public Ref {
+	// runtime scale can differ from the bundled one due to float math in transforms
+	static constexpr float ScaleTolerance = 0.001f;
+
+	std::optional<filesystem::MemoryMappedRegion> region;
+	const VectorCanvasBundleHeader *header = nullptr;
+	SpanView<VectorCanvasBundleEntry> entries;
+	StringView names;
+	SpanView<Vertex> vertexes;
+	SpanView<uint32_t> indexes;
+
+	bool init(filesystem::MemoryMappedRegion &&);
+
+	bool isCompatible(const VectorCanvasConfig &) const;
+
+	StringView getName(const VectorCanvasBundleEntry &) const;
+
+	const VectorCanvasBundleEntry *find(StringView name, vg::DrawFlags, float scale) const;
+};
+
+// Bundled tesselation result; vertexes and indexes are valid while bundle is retained
+struct VectorCanvasBundleData {
+	Rc<VectorCanvasBundle> bundle;
+	SpanView<Vertex> vertexes;
+	SpanView<uint32_t> indexes;
+	uint32_t fillIndexes = 0;
+	uint32_t strokeIndexes = 0;
+	uint32_t sdfIndexes = 0;
+};
+
 struct VectorCanvasCache {
 	static Mutex s_cacheMutex;
 	static VectorCanvasCache *s_instance;
+	static Vector<Rc<VectorCanvasBundle>> s_bundles;
+	static bool s_defaultBundleChecked;
 
 	static void retain();
 	static void release();
@@ -83,6 +173,11 @@ struct VectorCanvasCache {
 	static const VectorCanvasCacheData *getCacheData(const VectorCanvasCacheData &);
 	static const VectorCanvasCacheData *setCacheData(VectorCanvasCacheData &&);
 
+	static bool getBundleData(const VectorCanvasCacheData &, const VectorCanvasConfig &,
+			VectorCanvasBundleData &);
+
+	static void loadDefaultBundle();
+
 	VectorCanvasCache();
 	~VectorCanvasCache();
 
@@ -92,6 +187,8 @@ struct VectorCanvasCache {
 
 VectorCanvasCache *VectorCanvasCache::s_instance = nullptr;
 Mutex VectorCanvasCache::s_cacheMutex;
+Vector<Rc<VectorCanvasBundle>> VectorCanvasCache::s_bundles;
+bool VectorCanvasCache::s_defaultBundleChecked = false;
 
 struct VectorCanvas::Data : memory::AllocPool {
 	memory::pool_t *pool = nullptr;
@@ -126,8 +223,14 @@ struct VectorCanvas::Data : memory::AllocPool {
 
 	void doDraw(const VectorPath &, StringView id, StringView cache, const Color4F &color);
 
+	// Writes path from a precompiled bundle, returns false if no bundle contains it
+	bool doDrawBundle(const VectorPath &, StringView id, const VectorCanvasCacheData &,
+			InstanceVertexData *out, const Color4F &color);
+
 	void writeCacheData(const VectorPath &p, InstanceVertexData *out,
 			const VectorCanvasCacheData &source);
+	void writeCacheData(const VectorPath &p, InstanceVertexData *out, SpanView<Vertex>,
+			SpanView<uint32_t>, uint32_t fillIndexes, uint32_t strokeIndexes);
 };
 
 static void VectorCanvasPathDrawer_pushVertex(void *ptr, uint32_t idx, const Vec2 &pt,
@@ -188,6 +291,7 @@ bool VectorCanvas::init(bool deferred) {
 	memory::context ctx(p);
 	_data = new (p) Data(p, deferred);
 	if (_data) {
+		VectorCanvasCache::loadDefaultBundle();
 		return true;
 	}
 	return false;
@@ -281,6 +385,227 @@ Rc<VectorCanvasResult> VectorCanvas::draw(Rc<VectorImageData> &&image) {
 	return ret;
 }
 
+bool VectorCanvas::addBundle(const FileInfo &info) {
+	auto region = filesystem::MemoryMappedRegion::mapFile(info, filesystem::MappingType::Private,
+			filesystem::ProtFlags::MapRead);
+	if (!region) {
+		log::source().error("VectorCanvas", "Fail to map tesselation bundle: ", info);
+		return false;
+	}
+
+	auto bundle = Rc<VectorCanvasBundle>::create(sp::move(region));
+	if (!bundle) {
+		log::source().error("VectorCanvas", "Invalid tesselation bundle: ", info);
+		return false;
+	}
+
+	std::unique_lock<Mutex> lock(VectorCanvasCache::s_cacheMutex);
+	VectorCanvasCache::s_bundles.emplace_back(move(bundle));
+	return true;
+}
+
+void VectorCanvas::clearBundles() {
+	std::unique_lock<Mutex> lock(VectorCanvasCache::s_cacheMutex);
+	// bundles, used by the running draw calls, are retained by them
+	VectorCanvasCache::s_bundles.clear();
+}
+
+bool VectorCanvas::writeBundle(const FileInfo &info, const VectorCanvasConfig &config,
+		SpanView<float> scales, SpanView<Rc<VectorImageData>> images) {
+	struct BundleItem {
+		String name;
+		vg::DrawFlags style = vg::DrawFlags::Fill;
+		float scale = 1.0f;
+		uint32_t fillIndexes = 0;
+		uint32_t strokeIndexes = 0;
+		uint32_t sdfIndexes = 0;
+		Rc<VertexData> data;
+	};
+
+	Vector<BundleItem> items;
+
+	VectorCanvasPathDrawer pathDrawer;
+	static_cast<VectorCanvasConfig &>(pathDrawer) = config;
+
+	auto pool = memory::pool::create_tagged("xenolith::VectorCanvas::writeBundle");
+	auto transactionPool = memory::pool::create(pool);
+
+	memory::perform([&] {
+		for (auto &image : images) {
+			if (!image) {
+				continue;
+			}
+
+			auto imageSize = image->getImageSize();
+			auto &viewBox = image->getViewBoxTransform();
+
+			for (auto scale : scales) {
+				// the same transform, as VectorCanvas::draw uses for the target of this scale
+				Mat4 t = Mat4::IDENTITY;
+				t.scale(scale, scale, 1.0f);
+				if (!viewBox.isIdentity()) {
+					t *= viewBox;
+				}
+
+				pathDrawer.targetSize = Size2(imageSize.width * scale, imageSize.height * scale);
+
+				image->draw([&](const VectorPath &path, StringView id, StringView cacheId,
+									const Mat4 &pos, const Color4F &color) {
+					if (cacheId.empty()) {
+						return;
+					}
+
+					auto transform = t * (path.getTransform() * pos);
+
+					Vec3 scaleVec;
+					transform.getScale(&scaleVec);
+
+					BundleItem item;
+					item.name = cacheId.str<Interface>();
+					item.style = path.getStyle();
+					item.scale = std::max(scaleVec.x, scaleVec.y);
+					item.data = Rc<VertexData>::alloc();
+
+					memory::perform_clear([&] {
+						if (pathDrawer.draw(transactionPool, path, transform, item.data, true,
+									item.fillIndexes, item.strokeIndexes, item.sdfIndexes)
+								!= 0) {
+							items.emplace_back(move(item));
+						}
+					}, transactionPool);
+				});
+			}
+		}
+	}, pool);
+
+	memory::pool::destroy(transactionPool);
+	memory::pool::destroy(pool);
+
+	std::sort(items.begin(), items.end(), [](const BundleItem &l, const BundleItem &r) {
+		if (l.name != r.name) {
+			return StringView(l.name) < StringView(r.name);
+		} else if (l.style != r.style) {
+			return toInt(l.style) < toInt(r.style);
+		} else {
+			return l.scale < r.scale;
+		}
+	});
+
+	// cacheable path can be shared between images
+	items.erase(std::unique(items.begin(), items.end(),
+						[](const BundleItem &l, const BundleItem &r) {
+		return l.name == r.name && l.style == r.style && l.scale == r.scale;
+	}), items.end());
+
+	auto alignOffset = [](uint64_t offset, uint64_t align) {
+		return (offset + align - 1) & ~(align - 1);
+	};
+
+	uint64_t namesSize = 0;
+	uint64_t vertexesCount = 0;
+	uint64_t indexesCount = 0;
+	for (auto &it : items) {
+		namesSize += it.name.size();
+		vertexesCount += it.data->data.size();
+		indexesCount += it.data->indexes.size();
+	}
+
+	if (namesSize > maxOf<uint32_t>() || vertexesCount > maxOf<uint32_t>()
+			|| indexesCount > maxOf<uint32_t>()) {
+		log::source().error("VectorCanvas", "Tesselation bundle is too large: ", info);
+		return false;
+	}
+
+	VectorCanvasBundleHeader header;
+	header.entriesCount = uint32_t(items.size());
+	header.quality = config.quality;
+	header.boundaryOffset = config.boundaryOffset;
+	header.boundaryInset = config.boundaryInset;
+	header.sdfBoundaryOffset = config.sdfBoundaryOffset;
+	header.sdfBoundaryInset = config.sdfBoundaryInset;
+	header.relocateRule = toInt(config.relocateRule);
+	header.fillMaterial = config.fillMaterial;
+	header.strokeMaterial = config.strokeMaterial;
+	header.sdfMaterial = config.sdfMaterial;
+	header.forcePseudoSdf = config.forcePseudoSdf ? 1 : 0;
+	header.flattening = toInt(config.flattening);
+	header.namesSize = uint32_t(namesSize);
+	header.vertexesCount = uint32_t(vertexesCount);
+	header.indexesCount = uint32_t(indexesCount);
+
+	header.entriesOffset = alignOffset(sizeof(VectorCanvasBundleHeader), 16);
+	header.namesOffset = header.entriesOffset + items.size() * sizeof(VectorCanvasBundleEntry);
+	header.vertexesOffset = alignOffset(header.namesOffset + namesSize, 16);
+	header.indexesOffset = header.vertexesOffset + vertexesCount * sizeof(Vertex);
+	header.fileSize = alignOffset(header.indexesOffset + indexesCount * sizeof(uint32_t), 16);
+
+	Bytes output;
+	output.resize(header.fileSize, 0);
+
+	memcpy(output.data(), &header, sizeof(VectorCanvasBundleHeader));
+
+	auto entries =
+			reinterpret_cast<VectorCanvasBundleEntry *>(output.data() + header.entriesOffset);
+	auto names = output.data() + header.namesOffset;
+	auto vertexes = reinterpret_cast<Vertex *>(output.data() + header.vertexesOffset);
+	auto indexes = reinterpret_cast<uint32_t *>(output.data() + header.indexesOffset);
+
+	uint32_t nameOffset = 0;
+	uint32_t firstVertex = 0;
+	uint32_t firstIndex = 0;
+	for (auto &it : items) {
+		VectorCanvasBundleEntry entry;
+		entry.nameOffset = nameOffset;
+		entry.nameSize = uint32_t(it.name.size());
+		entry.style = toInt(it.style);
+		entry.scale = it.scale;
+		entry.fillIndexes = it.fillIndexes;
+		entry.strokeIndexes = it.strokeIndexes;
+		entry.sdfIndexes = it.sdfIndexes;
+		entry.firstVertex = firstVertex;
+		entry.vertexCount = uint32_t(it.data->data.size());
+		entry.firstIndex = firstIndex;
+		entry.indexCount = uint32_t(it.data->indexes.size());
+
+		memcpy(entries++, &entry, sizeof(VectorCanvasBundleEntry));
+		memcpy(names + nameOffset, it.name.data(), it.name.size());
+		memcpy(vertexes + firstVertex, it.data->data.data(), entry.vertexCount * sizeof(Vertex));
+		memcpy(indexes + firstIndex, it.data->indexes.data(),
+				entry.indexCount * sizeof(uint32_t));
+
+		nameOffset += entry.nameSize;
+		firstVertex += entry.vertexCount;
+		firstIndex += entry.indexCount;
+	}
+
+	// write into temporary file near the target, then replace target with it
+	auto tmpPath = string::toString<Interface>(info.path, ".tmp");
+	auto tmpInfo = FileInfo(tmpPath, info.category, info.flags);
+
+	auto file = filesystem::File::open(tmpInfo, filesystem::OpenFlags::Override);
+	if (!file) {
+		log::source().error("VectorCanvas", "Fail to open bundle file for writing: ", tmpInfo);
+		return false;
+	}
+
+	auto written = file.write(output.data(), output.size());
+	file.close();
+
+	if (written != output.size()) {
+		log::source().error("VectorCanvas", "Fail to write bundle file: ", tmpInfo);
+		filesystem::remove(tmpInfo);
+		return false;
+	}
+
+	if (!filesystem::move(tmpInfo, info)) {
+		log::source().error("VectorCanvas", "Fail to replace bundle file: ", info);
+		filesystem::remove(tmpInfo);
+		return false;
+	}
+
+	return true;
+}
+
 VectorCanvas::Data::Data(memory::pool_t *p, bool deferred) : pool(p), deferred(deferred) {
 	transactionPool = memory::pool::create(pool);
 
@@ -356,7 +681,7 @@ void VectorCanvas::Data::doDraw(const VectorPath &path, StringView id, StringVie
 			float scale = std::max(scaleVec.x, scaleVec.y);
 
 			VectorCanvasCacheData data{nullptr, 0, 0, 0, cache.str<Interface>(), quality, scale,
-				pathDrawer.relocateRule, style};
+				pathDrawer.relocateRule, pathDrawer.flattening, style};
 
 			if (auto it = VectorCanvasCache::getCacheData(data)) {
 				if (!it->data->indexes.empty()) {
@@ -370,6 +695,10 @@ void VectorCanvas::Data::doDraw(const VectorPath &path, StringView id, StringVie
 				return;
 			}
 
+			if (doDrawBundle(path, id, data, outData, color)) {
+				return;
+			}
+
 			data.data = Rc<VertexData>::alloc();
 
 			auto ret = pathDrawer.draw(transactionPool, path, transform, data.data, true,
@@ -413,16 +742,49 @@ void VectorCanvas::Data::doDraw(const VectorPath &path, StringView id, StringVie
 	}, transactionPool);
 }
 
+bool VectorCanvas::Data::doDrawBundle(const VectorPath &path, StringView id,
+		const VectorCanvasCacheData &data, InstanceVertexData *outData, const Color4F &color) {
+	VectorCanvasBundleData bundleData;
+	if (!VectorCanvasCache::getBundleData(data, pathDrawer, bundleData)) {
+		return false;
+	}
+
+	if (!bundleData.indexes.empty()) {
+		writeCacheData(path, outData, bundleData.vertexes, bundleData.indexes,
+				bundleData.fillIndexes, bundleData.strokeIndexes);
+
+		auto &inst = instances->emplace_front(Vector<TransformData>());
+		auto &instObj = inst.emplace_back(TransformData(transform));
+		instObj.instanceColor = color;
+		outData->instances = inst;
+
+		if (pathDrawer.instancedMode == VectorInstancedMode::Aggressive) {
+			objects->emplace(id.str<Interface>(),
+					VectorCanvasResult::ObjectRef{&inst, uint32_t(out->size() - 1)});
+		}
+	}
+	return true;
+}
+
 void VectorCanvas::Data::writeCacheData(const VectorPath &p, InstanceVertexData *out,
 		const VectorCanvasCacheData &source) {
+	writeCacheData(p, out,
+			SpanView<Vertex>(source.data->data.data(), source.data->data.size()),
+			SpanView<uint32_t>(source.data->indexes.data(), source.data->indexes.size()),
+			source.fillIndexes, source.strokeIndexes);
+}
+
+void VectorCanvas::Data::writeCacheData(const VectorPath &p, InstanceVertexData *out,
+		SpanView<Vertex> vertexes, SpanView<uint32_t> indexes, uint32_t fillIndexes,
+		uint32_t strokeIndexes) {
 	auto fillColor = Color4F(p.getFillColor());
 	auto strokeColor = Color4F(p.getStrokeColor());
 
 	Vec4 fillVec = fillColor;
 	Vec4 strokeVec = strokeColor;
 
-	out->data->indexes = source.data->indexes;
-	out->data->data = source.data->data;
+	out->data->indexes.assign(indexes.begin(), indexes.end());
+	out->data->data.assign(vertexes.begin(), vertexes.end());
 	for (auto &it : out->data->data) {
 		if (it.material == pathDrawer.fillMaterial) {
 			it.color = it.color * fillVec;
@@ -430,8 +792,8 @@ void VectorCanvas::Data::writeCacheData(const VectorPath &p, InstanceVertexData
 			it.color = it.color * strokeVec;
 		}
 	}
-	out->fillIndexes = source.fillIndexes;
-	out->strokeIndexes = source.strokeIndexes;
+	out->fillIndexes = fillIndexes;
+	out->strokeIndexes = strokeIndexes;
 }
 
 uint32_t VectorCanvasPathDrawer::draw(memory::pool_t *pool, const VectorPath &p,
@@ -463,6 +825,7 @@ uint32_t VectorCanvasPathDrawer::draw(memory::pool_t *pool, const VectorPath &p,
 	geom::LineDrawer line(approxScale * quality, Rc<geom::Tesselator>(fillTess),
 			Rc<geom::Tesselator>(strokeTess), Rc<geom::Tesselator>(sdfTess),
 			path->getStrokeWidth());
+	line.flattening = flattening;
 
 	auto d = path->getPoints().data();
 
@@ -649,6 +1012,43 @@ const VectorCanvasCacheData *VectorCanvasCache::setCacheData(VectorCanvasCacheDa
 	return &*it;
 }
 
+void VectorCanvasCache::loadDefaultBundle() {
+	std::unique_lock<Mutex> lock(s_cacheMutex);
+	if (s_defaultBundleChecked) {
+		return;
+	}
+	s_defaultBundleChecked = true;
+	lock.unlock();
+
+	FileInfo info{VectorCanvas::DefaultBundleName, FileCategory::Bundled};
+	if (filesystem::exists(info)) {
+		VectorCanvas::addBundle(info);
+	}
+}
+
+bool VectorCanvasCache::getBundleData(const VectorCanvasCacheData &data,
+		const VectorCanvasConfig &config, VectorCanvasBundleData &out) {
+	std::unique_lock<Mutex> lock(s_cacheMutex);
+	for (auto &it : s_bundles) {
+		if (!it->isCompatible(config)) {
+			continue;
+		}
+
+		if (auto entry = it->find(data.name, data.style, data.scale)) {
+			out.bundle = it;
+			out.vertexes =
+					SpanView<Vertex>(it->vertexes.data() + entry->firstVertex, entry->vertexCount);
+			out.indexes =
+					SpanView<uint32_t>(it->indexes.data() + entry->firstIndex, entry->indexCount);
+			out.fillIndexes = entry->fillIndexes;
+			out.strokeIndexes = entry->strokeIndexes;
+			out.sdfIndexes = entry->sdfIndexes;
+			return true;
+		}
+	}
+	return false;
+}
+
 VectorCanvasCache::VectorCanvasCache() {
 	auto path = FileInfo("vector_cache.cbor", FileCategory::AppCache);
 
@@ -664,6 +1064,7 @@ VectorCanvasCache::VectorCanvasCache() {
 			data.quality = it.getDouble("quality");
 			data.scale = it.getDouble("scale");
 			data.relocateRule = geom::Tesselator::RelocateRule(it.getInteger("rule"));
+			data.flattening = geom::LineFlattening(it.getInteger("flattening"));
 			data.style = geom::DrawFlags(it.getInteger("style"));
 			data.fillIndexes = uint32_t(it.getInteger("fill"));
 			data.strokeIndexes = uint32_t(it.getInteger("stroke"));
@@ -695,6 +1096,7 @@ VectorCanvasCache::~VectorCanvasCache() {
 		data.setDouble(it.quality, "quality");
 		data.setDouble(it.scale, "scale");
 		data.setInteger(toInt(it.relocateRule), "rule");
+		data.setInteger(toInt(it.flattening), "flattening");
 		data.setInteger(toInt(it.style), "style");
 		data.setInteger(it.fillIndexes, "fill");
 		data.setInteger(it.strokeIndexes, "stroke");
@@ -719,6 +1121,100 @@ VectorCanvasCache::~VectorCanvasCache() {
 	}
 }
 
+bool VectorCanvasBundle::init(filesystem::MemoryMappedRegion &&r) {
+	region.emplace(sp::move(r));
+
+	auto view = region->getView();
+	if (view.size() < sizeof(VectorCanvasBundleHeader)) {
+		return false;
+	}
+
+	header = reinterpret_cast<const VectorCanvasBundleHeader *>(view.data());
+	if (header->magic != VectorCanvasBundleHeader::Magic
+			|| header->version != VectorCanvasBundleHeader::Version
+			|| header->vertexSize != sizeof(Vertex) || header->fileSize != view.size()) {
+		return false;
+	}
+
+	auto isValidRange = [&](uint64_t offset, uint64_t count, size_t size, size_t align) {
+		return offset % align == 0 && offset <= view.size()
+				&& count <= (view.size() - offset) / size;
+	};
+
+	if (!isValidRange(header->entriesOffset, header->entriesCount,
+				sizeof(VectorCanvasBundleEntry), alignof(VectorCanvasBundleEntry))
+			|| !isValidRange(header->namesOffset, header->namesSize, 1, 1)
+			|| !isValidRange(header->vertexesOffset, header->vertexesCount, sizeof(Vertex),
+					alignof(Vertex))
+			|| !isValidRange(header->indexesOffset, header->indexesCount, sizeof(uint32_t),
+					alignof(uint32_t))) {
+		return false;
+	}
+
+	entries = SpanView<VectorCanvasBundleEntry>(
+			reinterpret_cast<const VectorCanvasBundleEntry *>(view.data() + header->entriesOffset),
+			header->entriesCount);
+	names = StringView(reinterpret_cast<const char *>(view.data() + header->namesOffset),
+			header->namesSize);
+	vertexes = SpanView<Vertex>(
+			reinterpret_cast<const Vertex *>(view.data() + header->vertexesOffset),
+			header->vertexesCount);
+	indexes = SpanView<uint32_t>(
+			reinterpret_cast<const uint32_t *>(view.data() + header->indexesOffset),
+			header->indexesCount);
+
+	for (auto &it : entries) {
+		if (uint64_t(it.nameOffset) + it.nameSize > names.size()
+				|| uint64_t(it.firstVertex) + it.vertexCount > vertexes.size()
+				|| uint64_t(it.firstIndex) + it.indexCount > indexes.size()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool VectorCanvasBundle::isCompatible(const VectorCanvasConfig &config) const {
+	return header->quality == config.quality && header->relocateRule == toInt(config.relocateRule)
+			&& header->boundaryOffset == config.boundaryOffset
+			&& header->boundaryInset == config.boundaryInset
+			&& header->sdfBoundaryOffset == config.sdfBoundaryOffset
+			&& header->sdfBoundaryInset == config.sdfBoundaryInset
+			&& header->fillMaterial == config.fillMaterial
+			&& header->strokeMaterial == config.strokeMaterial
+			&& header->sdfMaterial == config.sdfMaterial
+			&& header->forcePseudoSdf == (config.forcePseudoSdf ? 1 : 0)
+			&& header->flattening == toInt(config.flattening);
+}
+
+StringView VectorCanvasBundle::getName(const VectorCanvasBundleEntry &entry) const {
+	return names.sub(entry.nameOffset, entry.nameSize);
+}
+
+const VectorCanvasBundleEntry *VectorCanvasBundle::find(StringView name, vg::DrawFlags style,
+		float scale) const {
+	auto minScale = scale * (1.0f - ScaleTolerance);
+	auto maxScale = scale * (1.0f + ScaleTolerance);
+
+	auto it = std::lower_bound(entries.begin(), entries.end(), name,
+			[&](const VectorCanvasBundleEntry &entry, StringView n) {
+		auto entryName = getName(entry);
+		if (entryName != n) {
+			return entryName < n;
+		} else if (entry.style != toInt(style)) {
+			return entry.style < toInt(style);
+		} else {
+			return entry.scale < minScale;
+		}
+	});
+
+	if (it != entries.end() && getName(*it) == name && it->style == toInt(style)
+			&& it->scale <= maxScale) {
+		return &*it;
+	}
+	return nullptr;
+}
+
 void VectorCanvasResult::updateColor(const Color4F &color) {
 	auto copyData = [](const VertexData *data) {
 		auto ret = Rc<VertexData>::alloc();
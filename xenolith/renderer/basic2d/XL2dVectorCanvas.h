@@ -43,6 +43,21 @@ public:
 	Rc<VectorCanvasResult> draw(const VectorCanvasConfig &config, Rc<VectorImageData> &&);
 	Rc<VectorCanvasResult> draw(Rc<VectorImageData> &&);
 
+	// Precompiled tesselation bundle is a read-only level of the tesselation cache: cacheable
+	// paths, drawn with the compatible config at one of the bundled scales, are copied from
+	// the mapped file, other paths are tesselated in runtime as usual
+	static bool addBundle(const FileInfo &);
+	static void clearBundles();
+
+	// Bundle in the application resources (FileCategory::Bundled), loaded with the first canvas
+	// if present; it can be generated with tools/iconbundle
+	static constexpr StringView DefaultBundleName = "xenolith/icons.xlbundle";
+
+	// Tesselates all cacheable paths from images at every scale, and writes them as bundle.
+	// Scale is relative to the image size (2.0 for 24x24 image, drawn into 48x48 target)
+	static bool writeBundle(const FileInfo &, const VectorCanvasConfig &, SpanView<float> scales,
+			SpanView<Rc<VectorImageData>>);
+
 protected:
 	struct Data;
 
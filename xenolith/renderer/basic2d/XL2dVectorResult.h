@@ -40,6 +40,7 @@ enum class VectorInstancedMode {
 
 struct SP_PUBLIC VectorCanvasConfig {
 	geom::Tesselator::RelocateRule relocateRule = geom::Tesselator::RelocateRule::Auto;
+	geom::LineFlattening flattening = geom::LineFlattening::Recursive;
 	VectorInstancedMode instancedMode = VectorInstancedMode::Aggressive;
 
 	Size2 targetSize;
@@ -55,6 +55,20 @@ static float VectorSprite_getPseudoSdfOffset(float value) {
 	}
 }
 
+VectorCanvasConfig VectorSprite::makeCanvasConfig(float quality, float density, float depthIndex) {
+	VectorCanvasConfig config;
+	config.quality = quality;
+
+	// Canvas uses pixel-wide extents, but for sdf we need dp-wide
+	config.sdfBoundaryInset *= density;
+	config.sdfBoundaryOffset = VectorSprite_getPseudoSdfOffset(depthIndex) * density;
+
+	if (depthIndex > 0.0f) {
+		config.forcePseudoSdf = true;
+	}
+	return config;
+}
+
 VectorSprite::VectorSprite() { }
 
 bool VectorSprite::init(Rc<VectorImage> &&img) {
@@ -172,6 +186,15 @@ void VectorSprite::setQuality(float val) {
 	}
 }
 
+void VectorSprite::setLineFlattening(geom::LineFlattening val) {
+	if (_flattening != val) {
+		_flattening = val;
+		if (_image) {
+			_image->setDirty();
+		}
+	}
+}
+
 void VectorSprite::handleTransformDirty(const Mat4 &parent) {
 	_vertexesDirty = true;
 	Sprite::handleTransformDirty(parent);
@@ -428,9 +451,10 @@ void VectorSprite::updateVertexes(FrameInfo &frame) {
 			return;
 		}
 
-		VectorCanvasConfig config;
+		auto config = makeCanvasConfig(_quality, frame.request->getFrameConstraints().density,
+				_depthIndex);
+		config.flattening = _flattening;
 		config.color = _displayedColor;
-		config.quality = _quality;
 		config.targetSize = _imageTargetSize;
 		config.textureFlippedX = _flippedX;
 		config.textureFlippedY = _flippedY;
@@ -439,14 +463,6 @@ void VectorSprite::updateVertexes(FrameInfo &frame) {
 				Size2(_texture->getExtent().width, _texture->getExtent().height));
 		_textureScale = texPlacementResult.scale;
 
-		// Canvas uses pixel-wide extents, but for sdf we need dp-wide
-		config.sdfBoundaryInset *= frame.request->getFrameConstraints().density;
-		config.sdfBoundaryOffset = _savedSdfValue * frame.request->getFrameConstraints().density;
-
-		if (_depthIndex > 0.0f) {
-			config.forcePseudoSdf = true;
-		}
-
 		if (_deferred) {
 			_deferredResult =
 					VectorSprite_runDeferredVectorCavas(_director->getApplication()->getLooper(),
@@ -37,6 +37,10 @@ public:
 	constexpr static float QualityHigh = 1.25f;
 	constexpr static float QualityPerfect = 1.75f;
 
+	// Tesselation config, that sprite uses for the frame density and depth index (without target
+	// and color); precompiled bundles (see VectorCanvas::addBundle) should use the same config
+	static VectorCanvasConfig makeCanvasConfig(float quality, float density, float depthIndex);
+
 	virtual ~VectorSprite() { }
 
 	VectorSprite();
@@ -69,6 +73,10 @@ public:
 	virtual void setQuality(float);
 	virtual float getQuality() const { return _quality; }
 
+	// Curve flattening mode for tesselation, Analytic produces fewer segments for the same quality
+	virtual void setLineFlattening(geom::LineFlattening);
+	virtual geom::LineFlattening getLineFlattening() const { return _flattening; }
+
 	virtual void handleTransformDirty(const Mat4 &) override;
 
 	virtual bool visitDraw(FrameInfo &, NodeVisitFlags parentFlags) override;
@@ -120,6 +128,7 @@ protected:
 	uint64_t _asyncJobId = 0;
 	Rc<VectorImage> _image;
 	float _quality = QualityNormal;
+	geom::LineFlattening _flattening = geom::LineFlattening::Recursive;
 	float _savedSdfValue = nan();
 	Rc<VectorCanvasResult> _result;
 	Rc<VectorCanvasDeferredResult> _deferredResult;
@@ -0,0 +1,275 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XL2dNullRenderQueue.h"
+#include "XL2dFrameContext.h"
+#include "XL2dCommandFlattener.h"
+#include "XLCoreFrameQueue.h"
+#include "XLCoreFrameCache.h"
+#include "XLDirector.h"
+
+#if MODULE_XENOLITH_BACKEND_NULL
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d::null {
+
+auto InputAttachment::makeFrameHandle(const FrameQueue &handle) -> Rc<AttachmentHandle> {
+	if (_frameHandleCallback) {
+		return _frameHandleCallback(*this, handle);
+	}
+	return Rc<core::AttachmentHandle>::create(this, handle);
+}
+
+bool MaterialPass::makeRenderQueue(core::Queue::Builder &builder, RenderQueueInfo &info) {
+	using namespace core;
+
+	builder.addPass("MaterialSwapchainPass", PassType::Graphics, RenderOrderingHighest,
+			[&](QueuePassBuilder &passBuilder) -> Rc<core::QueuePass> {
+		return Rc<MaterialPass>::create(builder, passBuilder, info);
+	});
+
+	return true;
+}
+
+bool MaterialPass::init(core::Queue::Builder &queueBuilder, QueuePassBuilder &passBuilder,
+		const RenderQueueInfo &info) {
+	using namespace core;
+
+	core::SamplerInfo samplers[] = {
+		SamplerInfo{
+			.magFilter = Filter::Nearest,
+			.minFilter = Filter::Nearest,
+			.addressModeU = SamplerAddressMode::Repeat,
+			.addressModeV = SamplerAddressMode::Repeat,
+			.addressModeW = SamplerAddressMode::Repeat,
+		},
+		SamplerInfo{
+			.magFilter = Filter::Linear,
+			.minFilter = Filter::Linear,
+			.addressModeU = SamplerAddressMode::Repeat,
+			.addressModeV = SamplerAddressMode::Repeat,
+			.addressModeW = SamplerAddressMode::Repeat,
+		},
+		SamplerInfo{
+			.magFilter = Filter::Linear,
+			.minFilter = Filter::Linear,
+			.addressModeU = SamplerAddressMode::ClampToEdge,
+			.addressModeV = SamplerAddressMode::ClampToEdge,
+			.addressModeW = SamplerAddressMode::ClampToEdge,
+		},
+	};
+
+	auto texLayout = queueBuilder.addTextureSetLayout("General", samplers);
+
+	_output =
+			queueBuilder.addAttachemnt("Output", [&](AttachmentBuilder &builder) -> Rc<Attachment> {
+		builder.defineAsOutput();
+
+		return Rc<xenolith::null::ImageAttachment>::create(builder,
+				ImageInfo(info.extent, core::ForceImageUsage(core::ImageUsage::ColorAttachment),
+						info.target->getCommonFormat()),
+				core::ImageAttachment::AttachmentInfo{
+					.initialLayout = AttachmentLayout::Undefined,
+					.finalLayout = AttachmentLayout::ShaderReadOnlyOptimal,
+					.clearOnLoad = true,
+					.clearColor = info.backgroundColor});
+	});
+
+	_materials = queueBuilder.addAttachemnt(FrameContext2d::MaterialAttachmentName,
+			[&](AttachmentBuilder &builder) -> Rc<Attachment> {
+		return Rc<xenolith::null::MaterialAttachment>::create(builder, texLayout);
+	});
+
+	_vertexes = queueBuilder.addAttachemnt(FrameContext2d::VertexAttachmentName,
+			[&](AttachmentBuilder &builder) -> Rc<Attachment> {
+		builder.defineAsInput();
+		return Rc<InputAttachment>::create(builder);
+	});
+
+	_lightsData = queueBuilder.addAttachemnt(FrameContext2d::LightDataAttachmentName,
+			[](AttachmentBuilder &builder) -> Rc<Attachment> {
+		builder.defineAsInput();
+		return Rc<InputAttachment>::create(builder);
+	});
+
+	_particles = queueBuilder.addAttachemnt(FrameContext2d::ParticleEmittersAttachment,
+			[](AttachmentBuilder &builder) -> Rc<Attachment> {
+		builder.defineAsInput();
+		return Rc<InputAttachment>::create(builder);
+	});
+
+	auto colorAttachment = passBuilder.addAttachment(_output);
+
+	passBuilder.addAttachment(_vertexes);
+	passBuilder.addAttachment(_lightsData);
+	passBuilder.addAttachment(_materials);
+	passBuilder.addAttachment(_particles);
+
+	auto layout2d =
+			passBuilder.addDescriptorLayout("Layout2d", [&](PipelineLayoutBuilder &layoutBuilder) {
+		layoutBuilder.setTextureSetLayout(texLayout);
+	});
+
+	passBuilder.addSubpass([&](SubpassBuilder &subpassBuilder) {
+		subpassBuilder.addColor(colorAttachment,
+				AttachmentDependencyInfo{
+					PipelineStage::ColorAttachmentOutput,
+					AccessType::ColorAttachmentWrite,
+					PipelineStage::ColorAttachmentOutput,
+					AccessType::ColorAttachmentWrite,
+					FrameRenderPassState::Submitted,
+				},
+				AttachmentLayout::ColorAttachmentOptimal);
+
+		// material pipelines from vk::ShadowPass without shaders, so FrameContext2d can
+		// resolve materials for scene nodes the same way
+		struct PipelineNames {
+			StringView solid;
+			StringView transparent;
+			ImageViewType viewType;
+		};
+
+		for (auto &it : {
+				 PipelineNames{"Solid", "Transparent", ImageViewType::ImageView2D},
+				 PipelineNames{"Solid_Tex2dArrayFrag", "Transparent_Tex2dArrayFrag",
+					 ImageViewType::ImageView2DArray},
+				 PipelineNames{"Solid_Tex3dFrag", "Transparent_Tex3dFrag",
+					 ImageViewType::ImageView3D},
+			 }) {
+			subpassBuilder.addGraphicPipeline(it.solid, layout2d->defaultFamily,
+					PipelineMaterialInfo(
+							{BlendInfo(), DepthInfo(true, true, CompareOp::Less), it.viewType}));
+
+			subpassBuilder.addGraphicPipeline(it.transparent, layout2d->defaultFamily,
+					PipelineMaterialInfo({
+						BlendInfo(BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha,
+								BlendOp::Add, BlendFactor::Zero, BlendFactor::One, BlendOp::Add),
+						DepthInfo(false, true, CompareOp::LessOrEqual),
+						it.viewType,
+					}));
+		}
+	});
+
+	return xenolith::null::QueuePass::init(passBuilder);
+}
+
+auto MaterialPass::makeFrameHandle(const FrameQueue &handle) -> Rc<QueuePassHandle> {
+	return Rc<MaterialPassHandle>::create(*this, handle);
+}
+
+bool MaterialPassHandle::prepare(FrameQueue &q, Function<void(bool)> &&cb) {
+	auto pass = static_cast<MaterialPass *>(_queuePass.get());
+
+	if (auto vertexes = q.getAttachment(pass->getVertexes())) {
+		if (auto input = vertexes->handle->getInput()) {
+			_input = static_cast<FrameContextHandle2d *>(input);
+		}
+	}
+
+	if (auto materials = q.getAttachment(pass->getMaterials())) {
+		if (auto handle = dynamic_cast<xenolith::null::MaterialAttachmentHandle *>(
+					materials->handle.get())) {
+			_materialSet = handle->getSet();
+		}
+	}
+
+	return xenolith::null::QueuePassHandle::prepare(q, sp::move(cb));
+}
+
+bool MaterialPassHandle::doRecordCommands(FrameHandle &frame,
+		xenolith::null::CommandBuffer &buf) {
+	auto t = sp::platform::clock(ClockType::Monotonic);
+
+	_drawStat = DrawStat();
+
+	if (!_input || !_input->commands || !_materialSet) {
+		return true;
+	}
+
+	auto pool = memory::pool::create(memory::pool::acquire());
+	mem_pool::perform([&] {
+		auto shadowExtent =
+				_input->lights.getShadowExtent(frame.getFrameConstraints().getScreenSize());
+		auto shadowSize =
+				_input->lights.getShadowSize(frame.getFrameConstraints().getScreenSize());
+
+		CommandFlattenerInfo info;
+		info.surfaceExtent = frame.getFrameConstraints().extent;
+		info.transform = frame.getFrameConstraints().transform;
+		info.shadowSize = Vec2(shadowSize.width / float(shadowExtent.width),
+				shadowSize.height / float(shadowExtent.height));
+
+		CommandFlattener flattener;
+		if (!flattener.init(info, _materialSet.get(), _input.get())) {
+			return;
+		}
+
+		flattener.pushCommands(_input->commands.get());
+		flattener.sort();
+
+		// the same layout as vk::VertexAttachment uses for its buffers
+		_vertexData.resize((flattener.getVertexesCount() + 8) * sizeof(Vertex));
+		_indexData.resize((flattener.getIndexesCount() + 12) * sizeof(uint32_t));
+		_transformData.resize((_input->commands->getPredefinedTransforms()
+									  + flattener.getTransformsCount() + 1)
+				* sizeof(TransformData));
+
+		CommandFlattener::WriteTarget target;
+		target.vertexes = _vertexData.data();
+		target.indexes = _indexData.data();
+		target.transform = reinterpret_cast<TransformData *>(_transformData.data());
+		target.transformOffset = _input->commands->getPredefinedTransforms();
+
+		CommandFlattener::Result result;
+		flattener.write(target, result);
+
+		_drawStat.vertexes = flattener.getVertexesCount() - flattener.getExcludedVertexesCount();
+		_drawStat.triangles =
+				(flattener.getIndexesCount() - flattener.getExcludedIndexesCount()) / 3;
+		_drawStat.zPaths = flattener.getPathsCount();
+		_drawStat.drawCalls = uint32_t(result.materialSpans.size());
+		_drawStat.solidCmds = result.solidCmds;
+		_drawStat.surfaceCmds = result.surfaceCmds;
+		_drawStat.transparentCmds = result.transparentCmds;
+	}, pool);
+	memory::pool::destroy(pool);
+
+	// one unit of simulated work per processed vertex
+	buf.addWorkload(_drawStat.vertexes);
+
+	if (auto cache = frame.getLoop()->getFrameCache()) {
+		_drawStat.cachedFramebuffers = uint32_t(cache->getFramebuffersCount());
+		_drawStat.cachedImages = uint32_t(cache->getImagesCount());
+		_drawStat.cachedImageViews = uint32_t(cache->getImageViewsCount());
+	}
+	_drawStat.materials = uint32_t(_materialSet->getMaterials().size());
+	_drawStat.vertexInputTime = uint32_t(sp::platform::clock(ClockType::Monotonic) - t);
+
+	// headless benchmarks and tests feed frames without director
+	if (_input->director) {
+		_input->director->pushDrawStat(_drawStat);
+	}
+	return true;
+}
+
+} // namespace stappler::xenolith::basic2d::null
+
+#endif
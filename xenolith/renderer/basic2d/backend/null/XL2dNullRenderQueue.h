@@ -0,0 +1,102 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_RENDERER_BASIC2D_BACKEND_NULL_XL2DNULLRENDERQUEUE_H_
+#define XENOLITH_RENDERER_BASIC2D_BACKEND_NULL_XL2DNULLRENDERQUEUE_H_
+
+#include "XL2dCommandList.h"
+#include "XLCoreQueue.h"
+
+#if MODULE_XENOLITH_BACKEND_NULL
+
+#include "XLNullQueuePass.h"
+#include "XLNullAttachment.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d::null {
+
+// Generic input attachment, that stores FrameContextHandle2d as input data
+class SP_PUBLIC InputAttachment : public core::GenericAttachment {
+public:
+	virtual ~InputAttachment() = default;
+
+	virtual Rc<AttachmentHandle> makeFrameHandle(const FrameQueue &) override;
+};
+
+/* Headless replacement for vk::ShadowPass
+ *
+ * Pass consumes the same inputs as GPU queue and flattens the command list into CPU buffers
+ * (as a stand-in for the vertex upload), so CPU-side cost of the scene is preserved, while
+ * GPU execution time is simulated by the null device.
+ */
+class SP_PUBLIC MaterialPass : public xenolith::null::QueuePass {
+public:
+	struct RenderQueueInfo {
+		core::Loop *target = nullptr;
+		Extent2 extent;
+		Color4F backgroundColor = Color4F::WHITE;
+	};
+
+	static bool makeRenderQueue(core::Queue::Builder &, RenderQueueInfo &);
+
+	virtual ~MaterialPass() = default;
+
+	virtual bool init(core::Queue::Builder &queueBuilder, QueuePassBuilder &passBuilder,
+			const RenderQueueInfo &info);
+
+	const AttachmentData *getVertexes() const { return _vertexes; }
+	const AttachmentData *getMaterials() const { return _materials; }
+
+	virtual Rc<QueuePassHandle> makeFrameHandle(const FrameQueue &) override;
+
+protected:
+	using xenolith::null::QueuePass::init;
+
+	const AttachmentData *_output = nullptr;
+	const AttachmentData *_materials = nullptr;
+	const AttachmentData *_vertexes = nullptr;
+	const AttachmentData *_lightsData = nullptr;
+	const AttachmentData *_particles = nullptr;
+};
+
+class SP_PUBLIC MaterialPassHandle : public xenolith::null::QueuePassHandle {
+public:
+	virtual ~MaterialPassHandle() = default;
+
+	virtual bool prepare(FrameQueue &q, Function<void(bool)> &&cb) override;
+
+protected:
+	virtual bool doRecordCommands(FrameHandle &, xenolith::null::CommandBuffer &) override;
+
+	Rc<FrameContextHandle2d> _input;
+	Rc<core::MaterialSet> _materialSet;
+
+	Bytes _vertexData;
+	Bytes _indexData;
+	Bytes _transformData;
+	DrawStat _drawStat;
+};
+
+} // namespace stappler::xenolith::basic2d::null
+
+#endif
+
+#endif /* XENOLITH_RENDERER_BASIC2D_BACKEND_NULL_XL2DNULLRENDERQUEUE_H_ */
@@ -50,7 +50,7 @@ MODULE_XENOLITH_RENDERER_BASIC2D_INCLUDES_OBJS := \
 	$(XENOLITH_MODULE_DIR)/renderer/basic2d/icons
 MODULE_XENOLITH_RENDERER_BASIC2D_DEPENDS_ON := xenolith_renderer_basic2d_shaders
 
-MODULE_XENOLITH_RENDERER_BASIC2D_SHARED_DEPENDS_ON := xenolith_backend_vk xenolith_application xenolith_font stappler_tess stappler_vg
+MODULE_XENOLITH_RENDERER_BASIC2D_SHARED_DEPENDS_ON := xenolith_backend_vk xenolith_backend_null xenolith_application xenolith_font stappler_tess stappler_vg
 MODULE_XENOLITH_RENDERER_BASIC2D_SHARED_CONSUME := \
 	xenolith_renderer_basic2d_shaders
 
@@ -22,6 +22,7 @@
  **/
 
 #include "XL2dIcons.h"
+#include "XL2dVectorCanvas.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::basic2d {
 
@@ -207,4 +208,27 @@ void drawIcon(vg::VectorImage &image, IconName name, float pr) {
 	}
 }
 
+bool writeIconBundle(const FileInfo &info, const VectorCanvasConfig &config,
+		SpanView<float> scales) {
+	Vector<Rc<vg::VectorImage>> sources;
+	Vector<Rc<VectorImageData>> images;
+	for (auto i = toInt(IconName::Empty) + 1; i < toInt(IconName::Max); ++i) {
+		auto name = IconName(i);
+		if (name == IconName::Dynamic_Loader || name == IconName::Dynamic_Nav
+				|| name == IconName::Dynamic_DownloadProgress) {
+			// dynamic icons depend on progress and are not cached
+			continue;
+		}
+
+		if (auto image = Rc<vg::VectorImage>::create(Size2(24.0f, 24.0f))) {
+			drawIcon(*image, name, 0.0f);
+			images.emplace_back(image->popData());
+			sources.emplace_back(move(image));
+		}
+	}
+
+	return VectorCanvas::writeBundle(info, config, scales,
+			SpanView<Rc<VectorImageData>>(images.data(), images.size()));
+}
+
 } // namespace stappler::xenolith::basic2d
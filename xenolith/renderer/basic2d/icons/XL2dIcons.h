@@ -4352,6 +4352,14 @@ SP_PUBLIC bool getIconData(IconName, const Callback<void(BytesView)> &);
 
 SP_PUBLIC void drawIcon(vg::VectorImage &, IconName, float progress);
 
+struct VectorCanvasConfig;
+
+// Writes precompiled tesselation bundle for all static icons at the scales (see
+// VectorCanvas::writeBundle and tools/iconbundle); bundle, placed in application resources as
+// VectorCanvas::DefaultBundleName, is loaded automatically
+SP_PUBLIC bool writeIconBundle(const FileInfo &, const VectorCanvasConfig &,
+		SpanView<float> scales);
+
 } // namespace stappler::xenolith::basic2d
 
 #endif /* XENOLITH_RENDERER_BASIC2D_ICONS_XL2DICONS_H_ */
@@ -135,8 +135,23 @@ void DataScrollView::handleContentSizeDirty() {
 	}
 }
 
+void DataScrollView::update(const UpdateTime &time) {
+	ScrollView::update(time);
+
+	if (_itemBuildDeferred) {
+		// retry items, that was not constructed on previous frames
+		_itemBuildDeferred = false;
+		_controller->onScrollPosition();
+	}
+
+	if (!_itemBuildDeferred && _adjust == Adjust::None) {
+		unscheduleUpdate();
+	}
+}
+
 void DataScrollView::reset() {
 	_controller->clear();
+	releaseDetachedItemNodes();
 
 	auto min = getScrollMinPosition();
 	if (!isnan(min)) {
@@ -170,10 +185,13 @@ void DataScrollView::setSource(DataSource *c) {
 		_sourceListener->setSubscription(c);
 		_categoryDirty = true;
 
+		clearItemReusePool();
+
 		_invalidateAfter = stappler::Time::now();
 
 		if (_contentSize != Size2::ZERO) {
 			_controller->clear();
+			releaseDetachedItemNodes();
 
 			if (isVertical()) {
 				_controller->addItem(
@@ -220,6 +238,32 @@ void DataScrollView::setCategoryBounds(bool value) {
 
 bool DataScrollView::hasCategoryBounds() const { return _useCategoryBounds; }
 
+void DataScrollView::setSlicePrefetch(bool value) { _slicePrefetch = value; }
+
+bool DataScrollView::isSlicePrefetch() const { return _slicePrefetch; }
+
+void DataScrollView::setPrefetchTime(TimeInterval time) { _prefetchTime = time; }
+
+TimeInterval DataScrollView::getPrefetchTime() const { return _prefetchTime; }
+
+void DataScrollView::setPrefetchMaxSlices(size_t value) {
+	_prefetchMaxSlices = value;
+	_sourceListener->setDirty();
+}
+
+size_t DataScrollView::getPrefetchMaxSlices() const { return _prefetchMaxSlices; }
+
+void DataScrollView::setItemBuildBudget(TimeInterval time) { _itemBuildBudget = time; }
+
+TimeInterval DataScrollView::getItemBuildBudget() const { return _itemBuildBudget; }
+
+void DataScrollView::setItemReuseLimit(size_t value) {
+	_itemReuseLimit = value;
+	trimItemReusePool();
+}
+
+size_t DataScrollView::getItemReuseLimit() const { return _itemReuseLimit; }
+
 void DataScrollView::setMaxSize(size_t max) {
 	_sliceMax = max;
 	_categoryDirty = true;
@@ -245,6 +289,21 @@ void DataScrollView::setItemCallback(ItemCallback &&cb) { _itemCallback = sp::mo
 
 void DataScrollView::setLoaderCallback(LoaderCallback &&cb) { _loaderCallback = sp::move(cb); }
 
+void DataScrollView::setItemReuseCallback(ItemReuseCallback &&cb) {
+	_itemReuseCallback = sp::move(cb);
+	clearItemReusePool();
+}
+
+void DataScrollView::setItemTypeCallback(ItemTypeCallback &&cb) {
+	_itemTypeCallback = sp::move(cb);
+	clearItemReusePool();
+}
+
+void DataScrollView::clearItemReusePool() {
+	// nodes in scroll are still in use, they are moved to the pool when removed
+	_itemReusePool.clear();
+}
+
 void DataScrollView::onSourceDirty() {
 	if ((isVertical() && _contentSize.height == 0.0f)
 			|| (!isVertical() && _contentSize.width == 0.0f)) {
@@ -253,6 +312,8 @@ void DataScrollView::onSourceDirty() {
 
 	if (!_sourceListener->getSubscription() || _items.size() == 0) {
 		_controller->clear();
+		releaseDetachedItemNodes();
+
 		if (isVertical()) {
 			_controller->addItem(
 					std::bind(&DataScrollView::handleLoaderRequest, this, Request::Reset),
@@ -342,9 +403,36 @@ bool DataScrollView::requestSlice(DataSource::Id first, size_t count, Request ty
 					std::placeholders::_1, Time::now(), type),
 			first, count, _categoryLookupLevel, _itemsForSubcats);
 
+	if (_slicePrefetch) {
+		prefetchSlice(first, count, type);
+	}
+
 	return true;
 }
 
+void DataScrollView::prefetchSlice(DataSource::Id first, size_t count, Request type) {
+	auto source = _sourceListener->getSubscription();
+	if (!source || source->getSliceCacheLimit() == 0) {
+		return;
+	}
+
+	// user scrolls in direction of the last request, so, next slice will be requested soon
+	if (type == Request::Back) {
+		auto next = size_t(first.get()) + count;
+		if (next < _itemsCount) {
+			source->prefetchSliceData(DataSource::Id(next), std::min(_sliceSize, _itemsCount - next),
+					_categoryLookupLevel, _itemsForSubcats);
+		}
+	} else if (type == Request::Front) {
+		auto end = size_t(first.get());
+		if (end > 0) {
+			auto start = (end > _sliceSize) ? end - _sliceSize : 0;
+			source->prefetchSliceData(DataSource::Id(start), end - start, _categoryLookupLevel,
+					_itemsForSubcats);
+		}
+	}
+}
+
 bool DataScrollView::updateSlice() {
 	auto size = std::max(_currentSliceLen, _sliceSize);
 	auto first = _currentSliceStart;
@@ -488,6 +576,9 @@ void DataScrollView::updateSliceItems(ItemMap &&val, Time time, Request type) {
 
 	updateItems();
 
+	// scroll position is changed by items relocation, it's not a movement
+	_scrollVelocityPosition = nan();
+
 	if (type == Request::Update) {
 		setScrollRelativePosition(relPos);
 	} else if (type == Request::Reset) {
@@ -515,6 +606,7 @@ void DataScrollView::updateSliceItems(ItemMap &&val, Time time, Request type) {
 
 void DataScrollView::updateItems() {
 	_controller->clear();
+	releaseDetachedItemNodes();
 
 	if (!_items.empty()) {
 		if (_items.begin()->first.get() > 0) {
@@ -560,15 +652,189 @@ Rc<DataScrollView::Handler> DataScrollView::makeHandler() { return _handlerCallb
 Rc<Node> DataScrollView::handleItemRequest(const ScrollController::Item &item, DataSource::Id id) {
 	if ((isVertical() && item.size.height > 0.0f) || (isHorizontal() && item.size.width > 0)) {
 		auto it = _items.find(id);
-		if (it != _items.end()) {
-			if (_itemCallback) {
-				return _itemCallback(it->second);
+		if (it != _items.end() && isItemBuildAllowed(item)) {
+			if (!_itemBuildBudget) {
+				return acquireItemNode(it->second);
 			}
+
+			auto start = Time::now();
+			auto node = acquireItemNode(it->second);
+			_itemBuildSpent += Time::now() - start;
+			return node;
+		}
+	}
+	return nullptr;
+}
+
+Rc<Node> DataScrollView::acquireItemNode(Item *item) {
+	if (!_itemReuseCallback) {
+		if (_itemCallback) {
+			return _itemCallback(item);
+		}
+		return nullptr;
+	}
+
+	auto type = _itemTypeCallback ? _itemTypeCallback(item) : uint32_t(0);
+
+	// node from pool was removed from scroll, and can be rebound to the new item;
+	// node, that can not be rebound, is dropped
+	auto poolIt = _itemReusePool.find(type);
+	if (poolIt != _itemReusePool.end() && !poolIt->second.empty()) {
+		auto node = sp::move(poolIt->second.back());
+		poolIt->second.pop_back();
+		if (_itemReuseCallback(node, item)) {
+			_itemNodes.emplace_back(type, node);
+			return node;
 		}
 	}
+
+	if (_itemCallback) {
+		auto node = _itemCallback(item);
+		if (node) {
+			_itemNodes.emplace_back(type, node);
+		}
+		return node;
+	}
 	return nullptr;
 }
 
+bool DataScrollView::isItemBuildAllowed(const ScrollController::Item &item) {
+	if (!_itemBuildBudget || !_director) {
+		return true;
+	}
+
+	auto frame = _director->getUpdateTime().global;
+	if (frame != _itemBuildFrame) {
+		_itemBuildFrame = frame;
+		_itemBuildSpent = nullptr;
+	}
+
+	if (_itemBuildSpent < _itemBuildBudget) {
+		return true;
+	}
+
+	// items in visible area should always be constructed
+	auto pos = getNodeScrollPosition(item.pos);
+	auto size = getNodeScrollSize(item.size);
+	if (pos + size > getScrollPosition() && pos < getScrollPosition() + getScrollSize()) {
+		return true;
+	}
+
+	_itemBuildDeferred = true;
+	scheduleUpdate();
+	return false;
+}
+
+void DataScrollView::trimItemReusePool() {
+	for (auto &it : _itemReusePool) {
+		if (it.second.size() > _itemReuseLimit) {
+			it.second.resize(_itemReuseLimit);
+		}
+	}
+}
+
+void DataScrollView::releaseItemNode(Node *node) {
+	for (auto it = _itemNodes.begin(); it != _itemNodes.end(); ++it) {
+		if (it->second.get() == node) {
+			auto &pool = _itemReusePool[it->first];
+			if (pool.size() < _itemReuseLimit) {
+				pool.emplace_back(sp::move(it->second));
+			}
+			_itemNodes.erase(it);
+			return;
+		}
+	}
+}
+
+void DataScrollView::releaseDetachedItemNodes() {
+	// controller removes nodes directly on clear, without removeScrollNode
+	auto it = _itemNodes.begin();
+	while (it != _itemNodes.end()) {
+		if (!it->second->getParent()) {
+			auto &pool = _itemReusePool[it->first];
+			if (pool.size() < _itemReuseLimit) {
+				pool.emplace_back(sp::move(it->second));
+			}
+			it = _itemNodes.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+bool DataScrollView::removeScrollNode(Node *node) {
+	if (ScrollView::removeScrollNode(node)) {
+		if (_itemReuseCallback) {
+			releaseItemNode(node);
+		}
+		return true;
+	}
+	return false;
+}
+
+void DataScrollView::updateScrollVelocity() {
+	auto now = Time::now();
+	auto pos = getScrollPosition();
+
+	if (!isnan(_scrollVelocityPosition) && _scrollVelocityTime) {
+		auto dt = (now - _scrollVelocityTime).toFloatSeconds();
+		if (dt > 0.25f) {
+			_scrollVelocity = 0.0f;
+		} else if (dt > 0.0f) {
+			// smooth per-frame jitter
+			_scrollVelocity = (_scrollVelocity + (pos - _scrollVelocityPosition) / dt) / 2.0f;
+		}
+	} else {
+		_scrollVelocity = 0.0f;
+	}
+
+	_scrollVelocityPosition = pos;
+	_scrollVelocityTime = now;
+}
+
+void DataScrollView::prefetchForVelocity() {
+	if (!_slicePrefetch || _items.empty() || _prefetchMaxSlices == 0 || _scrollVelocity == 0.0f) {
+		return;
+	}
+
+	auto source = _sourceListener->getSubscription();
+	if (!source || source->getSliceCacheLimit() == 0) {
+		return;
+	}
+
+	auto length = getScrollLength();
+	if (isnan(length) || length <= 0.0f || _currentSliceLen == 0) {
+		return;
+	}
+
+	// distance, that scroll will pass within prefetch time, versus distance to slice bound
+	auto reach = fabsf(_scrollVelocity) * _prefetchTime.toFloatSeconds();
+	auto distance = (_scrollVelocity > 0.0f) ? getScrollMaxPosition() - getScrollPosition()
+											 : getScrollPosition() - getScrollMinPosition();
+	if (isnan(distance) || reach <= distance) {
+		return;
+	}
+
+	auto itemSize = length / _currentSliceLen;
+	auto count = std::clamp(size_t(ceilf((reach - distance) / itemSize)), _sliceSize,
+			_sliceSize * _prefetchMaxSlices);
+
+	if (_scrollVelocity > 0.0f) {
+		auto next = size_t(_currentSliceStart.get()) + _currentSliceLen;
+		if (next < _itemsCount) {
+			source->prefetchSliceData(DataSource::Id(next), std::min(count, _itemsCount - next),
+					_categoryLookupLevel, _itemsForSubcats);
+		}
+	} else {
+		auto end = size_t(_currentSliceStart.get());
+		if (end > 0) {
+			auto start = (end > count) ? end - count : 0;
+			source->prefetchSliceData(DataSource::Id(start), end - start, _categoryLookupLevel,
+					_itemsForSubcats);
+		}
+	}
+}
+
 Rc<DataScrollView::Loader> DataScrollView::handleLoaderRequest(Request type) {
 	if (type == Request::Back) {
 		if (_loaderCallback) {
@@ -613,6 +879,13 @@ void DataScrollView::updateIndicatorPosition() {
 			(isVertical() ? scrollHeight : scrollWidth) / scrollLength, value, true, 20.0f);
 }
 
+void DataScrollView::onPosition() {
+	ScrollView::onPosition();
+
+	updateScrollVelocity();
+	prefetchForVelocity();
+}
+
 void DataScrollView::onOverscroll(float delta) {
 	if (delta > 0 && _currentSliceStart.get() + _currentSliceLen == _itemsCount) {
 		ScrollView::onOverscroll(delta);
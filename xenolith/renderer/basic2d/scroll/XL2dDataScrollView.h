@@ -52,6 +52,8 @@ public:
 
 	using HandlerCallback = Function<Rc<Handler>(DataScrollView *)>;
 	using ItemCallback = Function<Rc<Node>(Item *)>;
+	using ItemTypeCallback = Function<uint32_t(Item *)>;
+	using ItemReuseCallback = Function<bool(Node *, Item *)>;
 	using LoaderCallback = Function<Rc<Loader>(Request, const Function<void()> &)>;
 
 	virtual ~DataScrollView() = default;
@@ -59,6 +61,7 @@ public:
 	virtual bool init(DataSource *dataCategory = nullptr, Layout = Layout::Vertical);
 
 	virtual void handleContentSizeDirty() override;
+	virtual void update(const UpdateTime &time) override;
 	virtual void reset();
 
 	virtual Value save() const override;
@@ -78,6 +81,30 @@ public:
 	virtual void setCategoryBounds(bool value);
 	virtual bool hasCategoryBounds() const;
 
+	// Prefetch next slice in scroll direction into source's slice cache (disabled by default)
+	// Source's cache should be enabled with DataSource::setSliceCacheLimit, the limit of
+	// getSliceSize() * (2 + 2 * getPrefetchMaxSlices()) items covers all prefetched slices
+	virtual void setSlicePrefetch(bool value);
+	virtual bool isSlicePrefetch() const;
+
+	// During fast scrolling, data for items that will be reached within this time
+	// is prefetched ahead of the scroll direction, up to max slices
+	virtual void setPrefetchTime(TimeInterval);
+	virtual TimeInterval getPrefetchTime() const;
+
+	virtual void setPrefetchMaxSlices(size_t);
+	virtual size_t getPrefetchMaxSlices() const;
+
+	// Time per frame for item nodes construction; items outside of the visible area
+	// that do not fit in budget are constructed on the next frames. Zero (default) disables
+	// the limit
+	virtual void setItemBuildBudget(TimeInterval);
+	virtual TimeInterval getItemBuildBudget() const;
+
+	// Max number of detached item nodes, kept for reuse for each item type
+	virtual void setItemReuseLimit(size_t);
+	virtual size_t getItemReuseLimit() const;
+
 	virtual void setLoaderSize(float);
 	virtual float getLoaderSize() const;
 
@@ -100,6 +127,16 @@ public:
 	// you can use custom loader with this callback
 	virtual void setLoaderCallback(LoaderCallback &&);
 
+	// if set, item nodes, that leaves the scroll, are kept in reuse pool, and this callback
+	// is used to bind them to the new items of the same type instead of ItemCallback;
+	// return false if node can not be bound to the item
+	virtual void setItemReuseCallback(ItemReuseCallback &&);
+
+	// type for the item node reuse pool, items with the same type can share nodes
+	virtual void setItemTypeCallback(ItemTypeCallback &&);
+
+	virtual void clearItemReusePool();
+
 protected:
 	virtual void onSourceDirty();
 
@@ -107,6 +144,7 @@ protected:
 	virtual Pair<DataSource *, bool> getSourceCategory(int64_t id);
 
 	virtual bool requestSlice(DataSource::Id, size_t, Request);
+	virtual void prefetchSlice(DataSource::Id, size_t, Request);
 
 	virtual bool updateSlice();
 	virtual bool resetSlice();
@@ -121,13 +159,26 @@ protected:
 	virtual Rc<Node> handleItemRequest(const ScrollController::Item &, DataSource::Id);
 	virtual Rc<Loader> handleLoaderRequest(Request type);
 
+	virtual Rc<Node> acquireItemNode(Item *);
+	virtual bool isItemBuildAllowed(const ScrollController::Item &);
+	virtual void trimItemReusePool();
+	virtual void releaseItemNode(Node *);
+	virtual void releaseDetachedItemNodes();
+
+	virtual bool removeScrollNode(Node *) override;
+
+	virtual void updateScrollVelocity();
+	virtual void prefetchForVelocity();
+
 	virtual void onOverscroll(float delta) override;
+	virtual void onPosition() override;
 	virtual void updateIndicatorPosition() override;
 
 	uint32_t _categoryLookupLevel = 0;
 	bool _itemsForSubcats = false;
 	bool _categoryDirty = true;
 	bool _useCategoryBounds = false;
+	bool _slicePrefetch = false;
 
 	DataListener<DataSource> *_sourceListener = nullptr;
 
@@ -135,6 +186,27 @@ protected:
 	HandlerCallback _handlerCallback = nullptr;
 	ItemCallback _itemCallback = nullptr;
 	LoaderCallback _loaderCallback = nullptr;
+	ItemTypeCallback _itemTypeCallback = nullptr;
+	ItemReuseCallback _itemReuseCallback = nullptr;
+
+	// nodes in scroll, created for items, with their types
+	Vector<Pair<uint32_t, Rc<Node>>> _itemNodes;
+
+	// nodes, removed from scroll, available for reuse, by item type
+	Map<uint32_t, Vector<Rc<Node>>> _itemReusePool;
+	size_t _itemReuseLimit = 16;
+
+	TimeInterval _itemBuildBudget;
+	TimeInterval _itemBuildSpent;
+	uint64_t _itemBuildFrame = 0;
+	bool _itemBuildDeferred = false;
+
+	float _scrollVelocity = 0.0f;
+	float _scrollVelocityPosition = nan();
+	Time _scrollVelocityTime;
+
+	TimeInterval _prefetchTime = TimeInterval::milliseconds(500);
+	size_t _prefetchMaxSlices = 2;
 
 	DataSource::Id _currentSliceStart = DataSource::Id(0);
 	size_t _currentSliceLen = 0;
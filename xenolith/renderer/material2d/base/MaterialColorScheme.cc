@@ -86,74 +86,20 @@ ColorScheme::ColorScheme(ThemeType t, const ColorHCT &color, bool isContent)
 : ColorScheme(t, CorePalette(color.data.hue, color.data.chroma, isContent)) { }
 
 void ColorScheme::set(ThemeType t, const CorePalette &p) {
-	type = t;
-	switch (type) {
-	case ThemeType::LightTheme:
-	case ThemeType::Custom:
-		colors[toInt(ColorRole::Primary)] = Color4F(p.primary.get(40));
-		colors[toInt(ColorRole::OnPrimary)] = Color4F(p.primary.get(100));
-		colors[toInt(ColorRole::PrimaryContainer)] = Color4F(p.primary.get(90));
-		colors[toInt(ColorRole::OnPrimaryContainer)] = Color4F(p.primary.get(10));
-		colors[toInt(ColorRole::Secondary)] = Color4F(p.secondary.get(40));
-		colors[toInt(ColorRole::OnSecondary)] = Color4F(p.secondary.get(100));
-		colors[toInt(ColorRole::SecondaryContainer)] = Color4F(p.secondary.get(90));
-		colors[toInt(ColorRole::OnSecondaryContainer)] = Color4F(p.secondary.get(10));
-		colors[toInt(ColorRole::Tertiary)] = Color4F(p.tertiary.get(40));
-		colors[toInt(ColorRole::OnTertiary)] = Color4F(p.tertiary.get(100));
-		colors[toInt(ColorRole::TertiaryContainer)] = Color4F(p.tertiary.get(90));
-		colors[toInt(ColorRole::OnTertiaryContainer)] = Color4F(p.tertiary.get(10));
-		colors[toInt(ColorRole::Error)] = Color4F(p.error.get(40));
-		colors[toInt(ColorRole::OnError)] = Color4F(p.error.get(100));
-		colors[toInt(ColorRole::ErrorContainer)] = Color4F(p.error.get(90));
-		colors[toInt(ColorRole::OnErrorContainer)] = Color4F(p.error.get(10));
-		colors[toInt(ColorRole::Background)] = Color4F(p.neutral.get(99));
-		colors[toInt(ColorRole::OnBackground)] = Color4F(p.neutral.get(10));
-		colors[toInt(ColorRole::Surface)] = Color4F(p.neutral.get(99));
-		colors[toInt(ColorRole::OnSurface)] = Color4F(p.neutral.get(10));
-		colors[toInt(ColorRole::SurfaceVariant)] = Color4F(p.neutralVariant.get(90));
-		colors[toInt(ColorRole::OnSurfaceVariant)] = Color4F(p.neutralVariant.get(30));
-		colors[toInt(ColorRole::Outline)] = Color4F(p.neutralVariant.get(50));
-		colors[toInt(ColorRole::OutlineVariant)] = Color4F(p.neutralVariant.get(80));
-		colors[toInt(ColorRole::Shadow)] = Color4F(p.neutral.get(0));
-		colors[toInt(ColorRole::Scrim)] = Color4F(p.neutral.get(0));
-		colors[toInt(ColorRole::InverseSurface)] = Color4F(p.neutral.get(20));
-		colors[toInt(ColorRole::InverseOnSurface)] = Color4F(p.neutral.get(95));
-		colors[toInt(ColorRole::InversePrimary)] = Color4F(p.primary.get(80));
-		break;
-	case ThemeType::DarkTheme:
-		colors[toInt(ColorRole::Primary)] = Color4F(p.primary.get(80));
-		colors[toInt(ColorRole::OnPrimary)] = Color4F(p.primary.get(20));
-		colors[toInt(ColorRole::PrimaryContainer)] = Color4F(p.primary.get(30));
-		colors[toInt(ColorRole::OnPrimaryContainer)] = Color4F(p.primary.get(90));
-		colors[toInt(ColorRole::Secondary)] = Color4F(p.secondary.get(80));
-		colors[toInt(ColorRole::OnSecondary)] = Color4F(p.secondary.get(20));
-		colors[toInt(ColorRole::SecondaryContainer)] = Color4F(p.secondary.get(30));
-		colors[toInt(ColorRole::OnSecondaryContainer)] = Color4F(p.secondary.get(90));
-		colors[toInt(ColorRole::Tertiary)] = Color4F(p.tertiary.get(80));
-		colors[toInt(ColorRole::OnTertiary)] = Color4F(p.tertiary.get(20));
-		colors[toInt(ColorRole::TertiaryContainer)] = Color4F(p.tertiary.get(30));
-		colors[toInt(ColorRole::OnTertiaryContainer)] = Color4F(p.tertiary.get(90));
-		colors[toInt(ColorRole::Error)] = Color4F(p.error.get(80));
-		colors[toInt(ColorRole::OnError)] = Color4F(p.error.get(20));
-		colors[toInt(ColorRole::ErrorContainer)] = Color4F(p.error.get(30));
-		colors[toInt(ColorRole::OnErrorContainer)] = Color4F(p.error.get(80));
-		colors[toInt(ColorRole::Background)] = Color4F(p.neutral.get(10));
-		colors[toInt(ColorRole::OnBackground)] = Color4F(p.neutral.get(90));
-		colors[toInt(ColorRole::Surface)] = Color4F(p.neutral.get(10));
-		colors[toInt(ColorRole::OnSurface)] = Color4F(p.neutral.get(90));
-		colors[toInt(ColorRole::SurfaceVariant)] = Color4F(p.neutralVariant.get(30));
-		colors[toInt(ColorRole::OnSurfaceVariant)] = Color4F(p.neutralVariant.get(80));
-		colors[toInt(ColorRole::Outline)] = Color4F(p.neutralVariant.get(60));
-		colors[toInt(ColorRole::OutlineVariant)] = Color4F(p.neutralVariant.get(30));
-		colors[toInt(ColorRole::Shadow)] = Color4F(p.neutral.get(0));
-		colors[toInt(ColorRole::Scrim)] = Color4F(p.neutral.get(0));
-		colors[toInt(ColorRole::InverseSurface)] = Color4F(p.neutral.get(90));
-		colors[toInt(ColorRole::InverseOnSurface)] = Color4F(p.neutral.get(20));
-		colors[toInt(ColorRole::InversePrimary)] = Color4F(p.primary.get(40));
-		break;
+	// Custom theme starts with the light theme colors
+	type = (t == ThemeType::DarkTheme) ? ThemeType::DarkTheme : ThemeType::LightTheme;
+	palette = p;
+
+	for (size_t i = 0; i < toInt(ColorRole::Undefined); ++i) {
+		roleValues[i] = values(ColorRole(i));
 	}
+	roleValues[toInt(ColorRole::Undefined)] = ColorHCT::Values{0.0f, 50.0f, 0.0f, 1.0f};
 
-	this->palette = p;
+	// roles are grouped by palette, so hue terms are reused within the batch
+	ColorHCT::solveColor4F(SpanView<ColorHCT::Values>(roleValues.data(), toInt(ColorRole::Undefined)),
+			colors.data());
+
+	type = t;
 }
 
 void ColorScheme::set(ThemeType t, const Color4F &color, bool isContent) {
@@ -165,6 +111,12 @@ void ColorScheme::set(ThemeType t, const ColorHCT &color, bool isContent) {
 }
 
 ColorHCT ColorScheme::hct(ColorRole name, float alpha) const {
+	if (type != ThemeType::Custom && name < ColorRole::Undefined) {
+		auto v = roleValues[toInt(name)];
+		v.alpha = alpha;
+		return ColorHCT(v, colors[toInt(name)]);
+	}
+
 	switch (type) {
 	case ThemeType::LightTheme:
 		switch (name) {
@@ -322,4 +274,16 @@ ColorHCT::Values ColorScheme::values(ColorRole name, float alpha) const {
 	return ColorHCT::Values{0.0f, 50.0f, 0.0f, alpha};
 }
 
+ColorHCT ColorScheme::resolve(const ColorHCT::Values &v) const {
+	if (type != ThemeType::Custom) {
+		for (size_t i = 0; i < toInt(ColorRole::Undefined); ++i) {
+			auto &it = roleValues[i];
+			if (it.hue == v.hue && it.chroma == v.chroma && it.tone == v.tone) {
+				return ColorHCT(v, colors[i]);
+			}
+		}
+	}
+	return ColorHCT(v);
+}
+
 }
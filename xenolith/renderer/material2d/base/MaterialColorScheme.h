@@ -140,8 +140,12 @@ struct SP_PUBLIC ColorScheme {
 	// faster then complete color
 	ColorHCT::Values values(ColorRole name, float alpha = 1.0f) const;
 
+	// returns HCT color for values, solved colors for roles are reused from cache
+	ColorHCT resolve(const ColorHCT::Values &) const;
+
 	ThemeType type = ThemeType::LightTheme;
 	std::array<Color4F, toInt(ColorRole::Max)> colors;
+	std::array<ColorHCT::Values, toInt(ColorRole::Max)> roleValues{};
 	CorePalette palette;
 };
 
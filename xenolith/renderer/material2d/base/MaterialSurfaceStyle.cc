@@ -329,12 +329,12 @@ bool SurfaceStyle::apply(SurfaceStyleData &data, const Size2 &contentSize, const
 	}
 
 	if (targetColorHCT != data.colorHCT.data) {
-		data.colorHCT = targetColorHCT;
+		data.colorHCT = scheme->resolve(targetColorHCT);
 		data.colorScheme = data.colorHCT.asColor4F();
 		dirty = true;
 	}
 	if (targetColorBackground != data.colorBackground.data) {
-		data.colorBackground = targetColorBackground;
+		data.colorBackground = scheme->resolve(targetColorBackground);
 		dirty = true;
 	}
 	if (targetOutlineValue != data.outlineValue) {
@@ -375,7 +375,7 @@ bool SurfaceStyle::apply(SurfaceStyleData &data, const Size2 &contentSize, const
 	}
 
 	if (targetColorOn != data.colorOn.data) {
-		data.colorOn = targetColorOn;
+		data.colorOn = scheme->resolve(targetColorOn);
 		dirty = true;
 	}
 
@@ -412,9 +412,16 @@ bool SurfaceStyle::apply(SurfaceStyleData &data, const Size2 &contentSize, const
 SurfaceStyleData SurfaceStyleData::progress(const SurfaceStyleData &l, const SurfaceStyleData &r, float p) {
 	SurfaceStyleData ret(r);
 	ret.schemeTag =  (p < 0.5f) ? l.schemeTag : r.schemeTag;
-	ret.colorHCT = stappler::progress(l.colorHCT, r.colorHCT, p);
-	ret.colorBackground = stappler::progress(l.colorBackground, r.colorBackground, p);
-	ret.colorOn = stappler::progress(l.colorOn, r.colorOn, p);
+
+	const ColorHCT from[] = {l.colorHCT, l.colorBackground, l.colorOn};
+	const ColorHCT to[] = {r.colorHCT, r.colorBackground, r.colorOn};
+	ColorHCT result[3];
+
+	ColorHCT::progress(from, to, p, result, 3);
+
+	ret.colorHCT = result[0];
+	ret.colorBackground = result[1];
+	ret.colorOn = result[2];
 
 	ret.colorScheme = ret.colorHCT;
 	ret.elevationValue = stappler::progress(l.elevationValue, r.elevationValue, p);
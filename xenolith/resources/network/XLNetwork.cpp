@@ -22,6 +22,7 @@
 
 #include "XLCommon.h"
 
+#include "XLNetworkCache.cc"
 #include "XLNetworkController.cc"
 #include "XLNetworkRequest.cc"
 #include "XLNetworkShared.cc"
@@ -0,0 +1,772 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#include "XLNetworkCache.h"
+#include "SPNetworkContext.h"
+#include "SPFilepath.h"
+#include "SPFilesystem.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
+
+static int64_t Cache_toSeconds(Time t) { return int64_t(t.toSeconds()); }
+
+static StringView Cache_getMethodName(Method method) {
+	switch (method) {
+	case Method::Unknown: return "UNKNOWN"; break;
+	case Method::Get: return "GET"; break;
+	case Method::Post: return "POST"; break;
+	case Method::Put: return "PUT"; break;
+	case Method::Delete: return "DELETE"; break;
+	case Method::Head: return "HEAD"; break;
+	case Method::Smtp: return "SMTP"; break;
+	}
+	return StringView();
+}
+
+// RFC 9110 5.3: list elements are trimmed, repeated whitespace is collapsed
+static void Cache_appendNormalized(String &out, StringView value) {
+	bool first = true;
+	value.split<StringView::Chars<','>>([&](StringView token) {
+		token.trimChars<StringView::WhiteSpace>();
+		if (token.empty()) {
+			return;
+		}
+
+		if (!first) {
+			out.push_back(',');
+		}
+		first = false;
+
+		bool firstWord = true;
+		while (!token.empty()) {
+			auto word = token.readUntil<StringView::WhiteSpace>();
+			token.skipChars<StringView::WhiteSpace>();
+			if (!firstWord) {
+				out.push_back(' ');
+			}
+			out.append(word.data(), word.size());
+			firstWord = false;
+		}
+	});
+}
+
+static StringView Cache_getRequestHeader(const Request &req, StringView name) {
+	for (auto &it : req.getHandle().getRequestHeaders()) {
+		if (string::tolower<Interface>(it.first) == name) {
+			return it.second;
+		}
+	}
+	return StringView();
+}
+
+CacheControl CacheControl::parse(StringView str) {
+	CacheControl ret;
+	str.split<StringView::Chars<','>>([&](StringView token) {
+		token.trimChars<StringView::WhiteSpace>();
+		auto name = string::tolower<Interface>(token.readUntil<StringView::Chars<'='>>());
+		if (name == "max-age") {
+			++token;
+			token.trimChars<StringView::Chars<'"'>>();
+			ret.maxAge = token.readInteger(10).get(-1);
+		} else if (name == "no-cache") {
+			ret.noCache = true;
+		} else if (name == "no-store") {
+			ret.noStore = true;
+		} else if (name == "must-revalidate") {
+			ret.mustRevalidate = true;
+		} else if (name == "public") {
+			ret.isPublic = true;
+		} else if (name == "private") {
+			ret.isPrivate = true;
+		}
+	});
+	return ret;
+}
+
+StringView CacheEntry::getHeader(StringView name) const {
+	auto it = _headers.find(name);
+	if (it != _headers.end()) {
+		return it->second;
+	}
+	return StringView();
+}
+
+int64_t CacheEntry::getFreshnessLifetime() const {
+	if (_control.maxAge >= 0) {
+		return _control.maxAge;
+	}
+
+	auto dateHeader = getHeader("date");
+	auto date = dateHeader.empty() ? _responseTime : Time::fromHttp(dateHeader);
+
+	auto expires = getHeader("expires");
+	if (!expires.empty()) {
+		// invalid date means already expired
+		auto e = Time::fromHttp(expires);
+		return std::max(int64_t(0), Cache_toSeconds(e) - Cache_toSeconds(date));
+	}
+
+	// heuristic freshness: 10% of time since last modification, up to one day
+	auto lastModified = getLastModified();
+	if (!lastModified.empty()) {
+		auto lm = Time::fromHttp(lastModified);
+		auto diff = Cache_toSeconds(date) - Cache_toSeconds(lm);
+		if (diff > 0) {
+			return std::min(diff / 10, int64_t(24 * 60 * 60));
+		}
+	}
+	return 0;
+}
+
+int64_t CacheEntry::getCurrentAge(Time now) const {
+	auto dateHeader = getHeader("date");
+	auto date = dateHeader.empty() ? _responseTime : Time::fromHttp(dateHeader);
+
+	auto apparentAge =
+			std::max(int64_t(0), Cache_toSeconds(_responseTime) - Cache_toSeconds(date));
+	auto ageValue = std::max(int64_t(0), getHeader("age").readInteger(10).get(0));
+	auto responseDelay = Cache_toSeconds(_responseTime) - Cache_toSeconds(_requestTime);
+	auto correctedAge = ageValue + std::max(int64_t(0), responseDelay);
+	auto residentTime = std::max(int64_t(0), Cache_toSeconds(now) - Cache_toSeconds(_responseTime));
+
+	return std::max(apparentAge, correctedAge) + residentTime;
+}
+
+bool CacheEntry::isFresh(Time now) const {
+	if (_control.noCache) {
+		return false;
+	}
+	return getFreshnessLifetime() > getCurrentAge(now);
+}
+
+BytesView CacheEntry::getBody() const {
+	if (_bodySize == 0) {
+		return BytesView();
+	}
+
+	if (!_body.empty()) {
+		return _body;
+	}
+
+	if (!_mapped && !_file.empty()) {
+		auto region = filesystem::MemoryMappedRegion::mapFile(FileInfo{_file, _category},
+				filesystem::MappingType::Private, filesystem::ProtFlags::MapRead);
+		if (region && region.getSize() == _bodySize) {
+			_mapped = Rc<MappedBody>::alloc(sp::move(region));
+		}
+	}
+
+	if (_mapped) {
+		return _mapped->region.getView();
+	}
+	return BytesView();
+}
+
+Cache::~Cache() { clear(); }
+
+bool Cache::init(CacheInfo &&info) {
+	_info = sp::move(info);
+
+	if (!_info.path.empty()) {
+		if (!filesystem::mkdir_recursive(FileInfo{_info.path, _info.category})) {
+			log::source().warn("network::Cache", "Fail to create cache dir: ", _info.path,
+					", fallback to memory-only cache");
+			_info.path.clear();
+		} else {
+			scanDisk();
+			trimDisk();
+		}
+	}
+	return true;
+}
+
+bool Cache::isCacheable(const Request &req) const {
+	auto &handle = req.getHandle();
+	if (handle.getMethod() != Method::Get || !req.isUseCache() || req.isIgnoreResponseData()) {
+		return false;
+	}
+
+	// only responses, received into Request's memory buffer, can be served from cache
+	if (!req._receiveToBuffer) {
+		return false;
+	}
+
+	auto control = CacheControl::parse(Cache_getRequestHeader(req, "cache-control"));
+	if (control.noStore || control.noCache) {
+		return false;
+	}
+	return true;
+}
+
+Rc<CacheEntry> Cache::lookup(const Request &req) {
+	auto primaryKey = makeKey(req, SpanView<String>());
+	auto vary = getVary(primaryKey);
+	auto key = vary.empty() ? primaryKey : makeKey(req, vary);
+
+	Rc<CacheEntry> entry;
+	auto it = _entries.find(key);
+	if (it != _entries.end()) {
+		entry = it->second;
+	} else {
+		entry = readEntry(key);
+	}
+
+	if (!entry) {
+		return nullptr;
+	}
+
+	touch(entry.get());
+
+	if (!entry->_file.empty()) {
+		auto dit = _disk.find(getFilePath(key));
+		if (dit != _disk.end()) {
+			updateDiskAccess(dit->first, dit->second, Time::now());
+		}
+	}
+	return entry;
+}
+
+void Cache::prepareRevalidation(const CacheEntry &entry, Handle::Context *ctx) const {
+	auto etag = entry.getETag();
+	if (!etag.empty()) {
+		ctx->headers = curl_slist_append(ctx->headers, toString("If-None-Match: ", etag).data());
+	}
+
+	auto lastModified = entry.getLastModified();
+	if (!lastModified.empty()) {
+		ctx->headers = curl_slist_append(ctx->headers,
+				toString("If-Modified-Since: ", lastModified).data());
+	}
+}
+
+Rc<CacheEntry> Cache::store(Request &req, Time requestTime) {
+	auto &handle = req._handle;
+	auto code = handle.getResponseCode();
+
+	// RFC 9111 4.2.2, heuristically cacheable status codes
+	switch (code) {
+	case 200:
+	case 203:
+	case 204:
+	case 300:
+	case 301:
+	case 308:
+	case 404:
+	case 405:
+	case 410:
+	case 414:
+	case 501: break;
+	default: return nullptr; break;
+	}
+
+	auto control = CacheControl::parse(handle.getReceivedHeaderString("Cache-Control"));
+	if (control.noStore) {
+		return nullptr;
+	}
+
+	if (!Cache_getRequestHeader(req, "authorization").empty() && !control.isPublic) {
+		return nullptr;
+	}
+
+	auto body = BytesView(req._data).sub(0, req._nbytes);
+	if (body.size() > _info.memoryBodyLimit
+			&& (_info.path.empty() || (_info.diskLimit > 0 && body.size() > _info.diskLimit))) {
+		return nullptr;
+	}
+
+	bool varyAny = false;
+	Vector<String> vary;
+	handle.getReceivedHeaderString("Vary").split<StringView::Chars<','>>([&](StringView name) {
+		name.trimChars<StringView::WhiteSpace>();
+		if (name == "*") {
+			varyAny = true;
+		} else if (!name.empty()) {
+			vary.emplace_back(string::tolower<Interface>(name));
+		}
+	});
+
+	if (varyAny) {
+		return nullptr;
+	}
+
+	std::sort(vary.begin(), vary.end());
+	vary.erase(std::unique(vary.begin(), vary.end()), vary.end());
+
+	auto entry = Rc<CacheEntry>::alloc();
+	entry->_key = makeKey(req, vary);
+	entry->_vary = vary;
+	entry->_control = control;
+	entry->_responseCode = code;
+	entry->_requestTime = requestTime;
+	entry->_responseTime = Time::now();
+	entry->_category = _info.category;
+
+	for (auto &it : handle.getData()->receive.parsed) {
+		if (it.first != "set-cookie") {
+			entry->_headers.emplace(it.first, it.second);
+		}
+	}
+
+	if (!entry->isFresh(entry->_responseTime) && !entry->hasValidators()) {
+		// response can not be reused in any way
+		return nullptr;
+	}
+
+	entry->_bodySize = body.size();
+	if (body.size() <= _info.memoryBodyLimit) {
+		entry->_body = body.bytes<Interface>();
+	}
+
+	remove(entry->_key);
+
+	setVary(makeKey(req, SpanView<String>()), sp::move(vary));
+
+	if (!_info.path.empty()) {
+		entry->_file = toString(getFilePath(entry->_key), ".body");
+		writeEntry(entry.get(), body);
+	}
+
+	_entries.emplace(entry->_key, entry);
+	_memorySize += entry->_body.size();
+	touch(entry.get());
+	trim();
+	trimDisk();
+
+	++_stats.stores;
+	return entry;
+}
+
+void Cache::update(CacheEntry *entry, Request &req, Time requestTime) {
+	auto &handle = req._handle;
+
+	// RFC 9111 4.3.4, update stored headers with ones from 304 response
+	for (auto &it : handle.getData()->receive.parsed) {
+		if (it.first == "set-cookie" || it.first == "content-length") {
+			continue;
+		}
+		auto iit = entry->_headers.find(it.first);
+		if (iit != entry->_headers.end()) {
+			iit->second = it.second;
+		} else {
+			entry->_headers.emplace(it.first, it.second);
+		}
+	}
+
+	entry->_control = CacheControl::parse(entry->getHeader("cache-control"));
+	entry->_requestTime = requestTime;
+	entry->_responseTime = Time::now();
+
+	if (!_info.path.empty() && !entry->_file.empty()) {
+		writeEntry(entry, BytesView());
+		trimDisk();
+	}
+}
+
+void Cache::apply(const CacheEntry *entry, Request &req) const {
+	auto &handle = req._handle;
+	auto data = handle.getData();
+
+	data->process.responseCode = entry->_responseCode;
+	data->process.errorCode = 0;
+	data->receive.parsed.clear();
+	data->receive.headers.clear();
+	for (auto &it : entry->_headers) {
+		data->receive.parsed.emplace(it.first, it.second);
+		data->receive.headers.emplace_back(toString(it.first, ": ", it.second));
+	}
+	data->receive.contentType = entry->getHeader("content-type").str<Interface>();
+
+	handle._success = true;
+	handle._etag = entry->getETag().str<Interface>();
+	handle._mtime = Time::fromHttp(entry->getLastModified()).toMicroseconds();
+
+	req._cacheEntry = const_cast<CacheEntry *>(entry);
+	req._cachedResponse = true;
+	req._data.clear();
+	req._nbytes = 0;
+}
+
+void Cache::remove(StringView key) {
+	auto it = _entries.find(key);
+	if (it != _entries.end()) {
+		drop(it->second.get());
+	}
+
+	if (!_info.path.empty()) {
+		auto path = getFilePath(key);
+		filesystem::remove(FileInfo{toString(path, ".meta"), _info.category});
+		filesystem::remove(FileInfo{toString(path, ".body"), _info.category});
+		removeDiskRecord(path);
+	}
+}
+
+void Cache::clear() {
+	while (_head) { unlink(_head); }
+	_entries.clear();
+	_vary.clear();
+	_memorySize = 0;
+}
+
+void Cache::addHit(TimeInterval t, bool revalidated) {
+	if (revalidated) {
+		++_stats.revalidations;
+	} else {
+		++_stats.hits;
+	}
+	_stats.hitLatency += t;
+}
+
+void Cache::addMiss(TimeInterval t) {
+	++_stats.misses;
+	_stats.missLatency += t;
+}
+
+String Cache::makeKey(const Request &req, SpanView<String> vary) {
+	auto &handle = req.getHandle();
+	auto ret = toString(Cache_getMethodName(handle.getMethod()), " ", handle.getUrl());
+	for (auto &name : vary) {
+		ret.push_back('\n');
+		ret.append(name);
+
+		bool found = false;
+		String value;
+		for (auto &it : handle.getRequestHeaders()) {
+			if (string::tolower<Interface>(it.first) == name) {
+				if (found) {
+					value.push_back(',');
+				}
+				value.append(it.second.data(), it.second.size());
+				found = true;
+			}
+		}
+
+		if (found) {
+			ret.push_back(':');
+			Cache_appendNormalized(ret, value);
+		}
+	}
+	return ret;
+}
+
+String Cache::getFilePath(StringView key) const {
+	auto hash = hash64(key);
+	return filepath::merge<Interface>(_info.path,
+			base16::encode<Interface>(BytesView((const uint8_t *)&hash, sizeof(uint64_t))));
+}
+
+Vector<String> Cache::getVary(StringView primaryKey) {
+	auto it = _vary.find(primaryKey);
+	if (it != _vary.end()) {
+		return it->second;
+	}
+
+	Vector<String> ret;
+	if (!_info.path.empty()) {
+		auto path = toString(getFilePath(primaryKey), ".vary");
+		auto meta = data::readFile<Interface>(FileInfo{path, _info.category});
+		if (meta.isDictionary() && meta.getString("key") == primaryKey) {
+			for (auto &it : meta.getArray("vary")) { ret.emplace_back(it.getString()); }
+		}
+	}
+
+	// names are also cached for resources without stored variants, so the map is bounded
+	if (_vary.size() >= _info.entriesLimit) {
+		_vary.clear();
+	}
+	_vary.emplace(primaryKey.str<Interface>(), ret);
+	return ret;
+}
+
+void Cache::setVary(StringView primaryKey, Vector<String> &&vary) {
+	auto it = _vary.find(primaryKey);
+	if (it != _vary.end()) {
+		if (it->second == vary) {
+			return;
+		}
+		it->second = sp::move(vary);
+	} else {
+		if (_vary.size() >= _info.entriesLimit) {
+			_vary.clear();
+		}
+		it = _vary.emplace(primaryKey.str<Interface>(), sp::move(vary)).first;
+	}
+
+	if (_info.path.empty()) {
+		return;
+	}
+
+	auto path = getFilePath(primaryKey);
+	auto file = FileInfo{toString(path, ".vary"), _info.category};
+	if (it->second.empty()) {
+		filesystem::remove(file);
+	} else {
+		Value meta;
+		meta.setString(primaryKey, "key");
+		auto &names = meta.emplace("vary");
+		names.setArray(Value::ArrayType());
+		for (auto &name : it->second) { names.addString(name); }
+		data::save(meta, file, data::EncodeFormat::Cbor);
+	}
+	updateDiskRecord(path, StringView());
+}
+
+Rc<CacheEntry> Cache::readEntry(StringView key) {
+	if (_info.path.empty()) {
+		return nullptr;
+	}
+
+	auto path = getFilePath(key);
+	auto metaFile = FileInfo{toString(path, ".meta"), _info.category};
+	auto meta = data::readFile<Interface>(metaFile);
+	if (!meta.isDictionary() || meta.getString("key") != key) {
+		return nullptr;
+	}
+
+	auto entry = Rc<CacheEntry>::alloc();
+	entry->_key = key.str<Interface>();
+	entry->_file = toString(path, ".body");
+	entry->_category = _info.category;
+	entry->_responseCode = long(meta.getInteger("code"));
+	entry->_requestTime = Time::microseconds(meta.getInteger("requestTime"));
+	entry->_responseTime = Time::microseconds(meta.getInteger("responseTime"));
+	entry->_bodySize = size_t(meta.getInteger("bodySize"));
+
+	for (auto &it : meta.getDict("headers")) {
+		entry->_headers.emplace(it.first, it.second.getString());
+	}
+
+	for (auto &it : meta.getArray("vary")) { entry->_vary.emplace_back(it.getString()); }
+
+	entry->_control = CacheControl::parse(entry->getHeader("cache-control"));
+
+	if (entry->_bodySize > 0 && entry->_bodySize <= _info.memoryBodyLimit) {
+		entry->_body =
+				filesystem::readIntoMemory<Interface>(FileInfo{entry->_file, _info.category});
+		if (entry->_body.size() != entry->_bodySize) {
+			remove(key);
+			return nullptr;
+		}
+	}
+
+	// mtime of metadata is used as access time on the next start
+	filesystem::touch(metaFile);
+	updateDiskRecord(path, key);
+
+	_entries.emplace(entry->_key, entry);
+	_memorySize += entry->_body.size();
+	touch(entry.get());
+	trim();
+	return entry;
+}
+
+void Cache::writeEntry(const CacheEntry *entry, BytesView body) {
+	auto path = getFilePath(entry->_key);
+
+	Value meta;
+	meta.setString(entry->_key, "key");
+	meta.setInteger(entry->_responseCode, "code");
+	meta.setInteger(entry->_requestTime.toMicroseconds(), "requestTime");
+	meta.setInteger(entry->_responseTime.toMicroseconds(), "responseTime");
+	meta.setInteger(entry->_bodySize, "bodySize");
+
+	auto &headers = meta.emplace("headers");
+	for (auto &it : entry->_headers) { headers.setString(it.second, it.first); }
+
+	auto &vary = meta.emplace("vary");
+	vary.setArray(Value::ArrayType());
+	for (auto &it : entry->_vary) { vary.addString(it); }
+
+	// body is written only with new response, metadata can be updated separately
+	if (!body.empty()) {
+		filesystem::write(FileInfo{entry->_file, _info.category}, body);
+	}
+
+	data::save(meta, FileInfo{toString(path, ".meta"), _info.category},
+			data::EncodeFormat::Cbor);
+
+	updateDiskRecord(path, entry->_key);
+}
+
+void Cache::touch(CacheEntry *entry) {
+	if (_head == entry) {
+		return;
+	}
+
+	unlink(entry);
+
+	entry->_next = _head;
+	if (_head) {
+		_head->_prev = entry;
+	}
+	_head = entry;
+	if (!_tail) {
+		_tail = entry;
+	}
+}
+
+void Cache::unlink(CacheEntry *entry) {
+	if (entry->_prev) {
+		entry->_prev->_next = entry->_next;
+	} else if (_head == entry) {
+		_head = entry->_next;
+	}
+
+	if (entry->_next) {
+		entry->_next->_prev = entry->_prev;
+	} else if (_tail == entry) {
+		_tail = entry->_prev;
+	}
+
+	entry->_prev = entry->_next = nullptr;
+}
+
+void Cache::drop(CacheEntry *entry) {
+	Rc<CacheEntry> ref = entry; // entry can be released with erase
+	unlink(entry);
+	_memorySize -= entry->_body.size();
+	_entries.erase(entry->_key);
+}
+
+void Cache::trim() {
+	// metadata of least recently used entries is released, stored ones can be read again
+	while (_entries.size() > _info.entriesLimit && _tail && _tail != _head) {
+		++_stats.evictions;
+		drop(_tail);
+	}
+
+	auto entry = _tail;
+	while (_memorySize > _info.memoryLimit && entry && entry != _head) {
+		auto prev = entry->_prev;
+		if (!entry->_body.empty()) {
+			++_stats.evictions;
+			if (!entry->_file.empty()) {
+				// body still available on disk
+				_memorySize -= entry->_body.size();
+				entry->_body = Bytes();
+			} else {
+				drop(entry);
+			}
+		}
+		entry = prev;
+	}
+}
+
+void Cache::scanDisk() {
+	_disk.clear();
+	_diskAccess.clear();
+	_diskSize = 0;
+
+	filesystem::ftw(FileInfo{_info.path, _info.category},
+			[&](const FileInfo &info, FileType type) {
+		if (type != FileType::File) {
+			return true;
+		}
+
+		auto ext = filepath::lastExtension(info);
+		if (ext != "meta" && ext != "body" && ext != "vary") {
+			return true;
+		}
+
+		filesystem::Stat stat;
+		if (!filesystem::stat(info, stat)) {
+			return true;
+		}
+
+		auto path = filepath::merge<Interface>(_info.path, filepath::name(info));
+		auto &rec = _disk[path];
+		rec.size += stat.size;
+		rec.access = std::max(rec.access, stat.mtime);
+		_diskSize += stat.size;
+		return true;
+	}, 1);
+
+	for (auto &it : _disk) { _diskAccess.emplace(it.second.access, it.first); }
+}
+
+void Cache::updateDiskRecord(StringView path, StringView key) {
+	size_t size = 0;
+	for (auto ext : {".meta", ".body", ".vary"}) {
+		filesystem::Stat stat;
+		if (filesystem::stat(FileInfo{toString(path, ext), _info.category}, stat)) {
+			size += stat.size;
+		}
+	}
+
+	auto it = _disk.find(path);
+	if (it == _disk.end()) {
+		it = _disk.emplace(path.str<Interface>(), DiskRecord()).first;
+	}
+
+	_diskSize = _diskSize - it->second.size + size;
+	it->second.size = size;
+	updateDiskAccess(it->first, it->second, Time::now());
+	if (!key.empty()) {
+		it->second.key = key.str<Interface>();
+	}
+}
+
+void Cache::updateDiskAccess(StringView path, DiskRecord &rec, Time access) {
+	auto key = path.str<Interface>();
+	_diskAccess.erase(Pair<Time, String>(rec.access, key));
+	_diskAccess.emplace(access, sp::move(key));
+	rec.access = access;
+}
+
+void Cache::removeDiskRecord(StringView path) {
+	auto it = _disk.find(path);
+	if (it != _disk.end()) {
+		_diskAccess.erase(Pair<Time, String>(it->second.access, it->first));
+		_diskSize -= it->second.size;
+		_disk.erase(it);
+	}
+}
+
+void Cache::trimDisk() {
+	if (_info.path.empty() || _info.diskLimit == 0) {
+		return;
+	}
+
+	while (_diskSize > _info.diskLimit && !_diskAccess.empty()) {
+		auto oldest = _disk.find(_diskAccess.begin()->second);
+		_diskAccess.erase(_diskAccess.begin());
+		if (oldest == _disk.end()) {
+			continue;
+		}
+
+		if (!oldest->second.key.empty()) {
+			auto eit = _entries.find(oldest->second.key);
+			if (eit != _entries.end()) {
+				drop(eit->second.get());
+			}
+		}
+
+		for (auto ext : {".meta", ".body", ".vary"}) {
+			filesystem::remove(FileInfo{toString(oldest->first, ext), _info.category});
+		}
+
+		_diskSize -= oldest->second.size;
+		_disk.erase(oldest);
+		++_stats.diskEvictions;
+	}
+}
+
+} // namespace stappler::xenolith::network
@@ -0,0 +1,228 @@
+/**
+ Copyright (c) 2025 Stappler Team <admin@stappler.org>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ **/
+
+#ifndef XENOLITH_RESOURCES_NETWORK_XLNETWORKCACHE_H_
+#define XENOLITH_RESOURCES_NETWORK_XLNETWORKCACHE_H_
+
+#include "XLNetworkRequest.h"
+#include "SPFilesystemMap.h"
+
+namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
+
+struct SP_PUBLIC CacheControl {
+	static CacheControl parse(StringView);
+
+	int64_t maxAge = -1; // seconds, -1 if not defined
+	bool noCache = false;
+	bool noStore = false;
+	bool mustRevalidate = false;
+	bool isPublic = false;
+	bool isPrivate = false;
+};
+
+struct SP_PUBLIC CacheInfo {
+	// Root for on-disk storage, memory-only cache when empty
+	String path;
+	FileCategory category = FileCategory::AppCache;
+
+	// Limit for response bodies, stored in memory
+	size_t memoryLimit = 8_MiB;
+
+	// Larger bodies are not stored in memory, they are mapped from disk on demand
+	size_t memoryBodyLimit = 256_KiB;
+
+	// Limit for on-disk storage, least recently used entries are removed above it
+	size_t diskLimit = 64_MiB;
+
+	// Limit for entries metadata, held in memory; entries above it are dropped
+	// from memory, but still can be read from disk
+	size_t entriesLimit = 4'096;
+};
+
+struct SP_PUBLIC CacheStats {
+	uint64_t hits = 0; // served without network request
+	uint64_t revalidations = 0; // served after 304 response
+	uint64_t misses = 0;
+	uint64_t stores = 0;
+	uint64_t evictions = 0;
+	uint64_t diskEvictions = 0;
+
+	TimeInterval hitLatency; // accumulated for hits and revalidations
+	TimeInterval missLatency;
+
+	float getHitRate() const {
+		auto total = hits + revalidations + misses;
+		return total ? float(hits + revalidations) / float(total) : 0.0f;
+	}
+};
+
+class SP_PUBLIC CacheEntry final : public Ref {
+public:
+	virtual ~CacheEntry() = default;
+
+	StringView getKey() const { return _key; }
+	long getResponseCode() const { return _responseCode; }
+
+	const Map<String, String> &getHeaders() const { return _headers; }
+	StringView getHeader(StringView) const;
+
+	StringView getETag() const { return getHeader("etag"); }
+	StringView getLastModified() const { return getHeader("last-modified"); }
+
+	bool hasValidators() const { return !getETag().empty() || !getLastModified().empty(); }
+
+	// seconds, RFC 9111 4.2.1, 4.2.3
+	int64_t getFreshnessLifetime() const;
+	int64_t getCurrentAge(Time now) const;
+
+	bool isFresh(Time now) const;
+
+	// Body is served from memory or from mapped file
+	BytesView getBody() const;
+
+protected:
+	friend class Cache;
+
+	String _key;
+	String _file; // body file path, empty for memory-only entry
+	FileCategory _category = FileCategory::Custom;
+	Vector<String> _vary; // lowercased request header names from Vary, sorted
+	Map<String, String> _headers; // lowercased response header name, value
+	CacheControl _control;
+	long _responseCode = 0;
+	Time _requestTime;
+	Time _responseTime;
+
+	struct MappedBody : Ref {
+		MappedBody(filesystem::MemoryMappedRegion &&r) : region(sp::move(r)) { }
+
+		filesystem::MemoryMappedRegion region;
+	};
+
+	Bytes _body;
+	size_t _bodySize = 0;
+	mutable Rc<MappedBody> _mapped;
+
+	// LRU list for all entries in memory, most recent first
+	CacheEntry *_prev = nullptr;
+	CacheEntry *_next = nullptr;
+};
+
+/* RFC 9111 private cache for network requests
+ *
+ * Only GET requests with responses, received into Request's memory buffer, are cached.
+ * Stored responses are served without network query while fresh, and revalidated with
+ * If-None-Match/If-Modified-Since when stale
+ *
+ * Entries are keyed with method, URL and normalized values of request headers, listed in
+ * response's Vary, so every variant of resource is stored separately. Vary header names are
+ * remembered for method and URL, to build the key for the next request.
+ *
+ * Cache is not thread-safe, it should be used from application thread only
+ */
+class SP_PUBLIC Cache final : public Ref {
+public:
+	virtual ~Cache();
+
+	bool init(CacheInfo &&);
+
+	bool isCacheable(const Request &) const;
+
+	Rc<CacheEntry> lookup(const Request &);
+
+	// Adds conditional headers for stale entry
+	void prepareRevalidation(const CacheEntry &, Handle::Context *) const;
+
+	// Stores successful response, returns new entry or nullptr if response is not storable
+	Rc<CacheEntry> store(Request &, Time requestTime);
+
+	// Updates stored entry with 304 response
+	void update(CacheEntry *, Request &, Time requestTime);
+
+	// Applies stored response to request
+	void apply(const CacheEntry *, Request &) const;
+
+	void remove(StringView key);
+	void clear();
+
+	void addHit(TimeInterval, bool revalidated);
+	void addMiss(TimeInterval);
+
+	const CacheStats &getStats() const { return _stats; }
+
+	size_t getEntriesCount() const { return _entries.size(); }
+	size_t getMemorySize() const { return _memorySize; }
+	size_t getDiskSize() const { return _diskSize; }
+
+	// "METHOD URL", then "\nname:value" for every Vary header, value is normalized as in
+	// RFC 9110 5.3: field lines are combined, whitespace around commas and repeated
+	// whitespace are removed; absent header is written without colon
+	static String makeKey(const Request &, SpanView<String> vary);
+
+protected:
+	struct DiskRecord {
+		String key; // empty, if entry was not read in this session
+		size_t size = 0;
+		Time access;
+	};
+
+	String getFilePath(StringView key) const;
+
+	Vector<String> getVary(StringView primaryKey);
+	void setVary(StringView primaryKey, Vector<String> &&);
+
+	Rc<CacheEntry> readEntry(StringView key);
+	void writeEntry(const CacheEntry *, BytesView);
+
+	void touch(CacheEntry *);
+	void unlink(CacheEntry *);
+	void drop(CacheEntry *);
+	void trim();
+
+	void scanDisk();
+	void updateDiskRecord(StringView path, StringView key);
+	void updateDiskAccess(StringView path, DiskRecord &, Time);
+	void removeDiskRecord(StringView path);
+	void trimDisk();
+
+	CacheInfo _info;
+	CacheStats _stats;
+
+	Map<String, Rc<CacheEntry>> _entries;
+	CacheEntry *_head = nullptr;
+	CacheEntry *_tail = nullptr;
+	size_t _memorySize = 0;
+
+	// Vary header names for "METHOD URL"
+	Map<String, Vector<String>> _vary;
+
+	// records for entries on disk, by file path without extension
+	Map<String, DiskRecord> _disk;
+	size_t _diskSize = 0;
+
+	// (access time, file path) for every disk record, least recently used first
+	Set<Pair<Time, String>> _diskAccess;
+};
+
+} // namespace stappler::xenolith::network
+
+#endif /* XENOLITH_RESOURCES_NETWORK_XLNETWORKCACHE_H_ */
@@ -26,8 +26,8 @@
 #include "XLEventListener.h"
 #include "XLNetworkRequest.h"
 #include "XLContext.h"
-
-#include <sprt/runtime/thread/info.h>
+#include "XLNetworkCache.h"
+#include "SPNetworkSocketDriver.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
 
@@ -37,22 +37,24 @@ struct ControllerHandle {
 	Rc<Request> request;
 	Handle *handle;
 	Context context;
+	bool cacheable = false;
 };
 
-struct Controller::Data final : thread::Thread {
+// Transfers are driven by SocketDriver on the application looper, so CURL sockets and timers
+// are processed as a regular looper events without a dedicated polling thread
+struct Controller::Data final {
 	using Context = stappler::network::Context<Interface>;
 
 	AppThread *_application = nullptr;
+	event::Looper *_looper = nullptr;
 	Controller *_controller = nullptr;
 	String _name;
 	Bytes _signKey;
 
-	Mutex _mutexQueue;
-	Mutex _mutexFree;
-
-	CURLM *_handle = nullptr;
+	Rc<stappler::network::SocketDriver> _driver;
+	Rc<Cache> _cache;
 
-	memory::PriorityQueue<Rc<Request>> _pending;
+	Vector<Rc<Request>> _pending;
 
 	Map<String, void *> _sharegroups;
 
@@ -60,19 +62,22 @@ struct Controller::Data final : thread::Thread {
 	NetworkFlags _capabilities = NetworkFlags::None;
 
 	Data(AppThread *app, Controller *c, StringView name, Bytes &&signKey);
-	virtual ~Data();
+	Data(event::Looper *looper, Controller *c, StringView name, Bytes &&signKey);
+	~Data();
 
 	bool init();
-	void invalidate();
 
-	virtual void threadInit() override;
-	virtual bool worker() override;
-	virtual void threadDispose() override;
+	// should be called on application thread
+	void start();
+	void stop();
 
 	void *getSharegroup(StringView);
 
 	void handleNetworkStateChanged(NetworkFlags);
 
+	// on application thread, or on looper's thread for controller without application
+	void performOnThread(Function<void()> &&, Ref *target, bool onNextFrame);
+
 	void onUploadProgress(Handle *, int64_t total, int64_t now);
 	void onDownloadProgress(Handle *, int64_t total, int64_t now);
 	bool onComplete(Handle *, bool success);
@@ -80,7 +85,9 @@ struct Controller::Data final : thread::Thread {
 	void sign(NetworkHandle &, Context &) const;
 
 	void pushTask(Rc<Request> &&handle);
-	void wakeup();
+	void addTask(Rc<Request> &&handle);
+	void handleCompleted(CURL *, CURLcode);
+	void handleCacheResponse(Request &);
 
 	bool prepare(Handle &handle, Context *ctx, const Callback<bool(CURL *)> &onBeforePerform);
 	bool finalize(Handle &handle, Context *ctx, const Callback<bool(CURL *)> &onAfterPerform);
@@ -89,135 +96,138 @@ struct Controller::Data final : thread::Thread {
 Controller::Data::Data(AppThread *app, Controller *c, StringView name, Bytes &&signKey)
 : _application(app), _controller(c), _name(name.str<Interface>()), _signKey(sp::move(signKey)) { }
 
+Controller::Data::Data(event::Looper *looper, Controller *c, StringView name, Bytes &&signKey)
+: _looper(looper), _controller(c), _name(name.str<Interface>()), _signKey(sp::move(signKey)) { }
+
 Controller::Data::~Data() { }
 
 bool Controller::Data::init() {
-	_capabilities = _application->getNetworkFlags();
+	if (_application) {
+		_capabilities = _application->getNetworkFlags();
+	}
 	return true;
 }
 
-void Controller::Data::invalidate() { }
+void Controller::Data::start() {
+	if (_application) {
+		_looper = _application->getLooper();
+	}
 
-void Controller::Data::threadInit() {
-	_pending.setQueueLocking(_mutexQueue);
-	_pending.setFreeLocking(_mutexFree);
+	_driver = Rc<stappler::network::SocketDriver>::alloc();
+	if (!_driver->init(_looper,
+				[this](CURL *curl, CURLcode code) { handleCompleted(curl, code); })) {
+		log::source().error("network::Controller", "Fail to initialize socket driver");
+		_driver = nullptr;
+		return;
+	}
 
-	sprt::thread::info::set(_name);
+	auto pending = sp::move(_pending);
+	_pending.clear();
+	for (auto &it : pending) { addTask(move(it)); }
+}
 
-	_handle = curl_multi_init();
+void Controller::Data::stop() {
+	if (_driver) {
+		for (auto &it : _handles) {
+			_driver->removeHandle(it.first);
+			it.second.context.code = CURLE_FAILED_INIT;
+			finalize(*it.second.handle, &it.second.context, nullptr);
+			curl_easy_cleanup(it.first);
+		}
+
+		_driver->cancel();
+		_driver = nullptr;
+	}
 
-	Thread::threadInit();
+	for (auto &it : _sharegroups) { curl_share_cleanup((CURLSH *)it.second); }
+
+	_handles.clear();
+	_sharegroups.clear();
+	_pending.clear();
+	_cache = nullptr;
 }
 
-bool Controller::Data::worker() {
-	if (!_continueExecution.test_and_set()) {
-		return false;
+void Controller::Data::addTask(Rc<Request> &&req) {
+	XL_PROFILE_ZONE("network::Controller::addTask", "network");
+
+	if (!_driver) {
+		_pending.emplace_back(move(req));
+		return;
 	}
 
-	do {
-		if (!_pending.pop_direct([&, this](memory::PriorityQueue<Rc<Handle>>::PriorityType type,
-										 Rc<Request> &&it) {
-			auto h = curl_easy_init();
-			auto networkHandle = const_cast<Handle *>(&it->getHandle());
-			auto i = _handles.emplace(h, ControllerHandle{move(it), networkHandle}).first;
-
-			auto sg = i->second.handle->getSharegroup();
-			if (!sg.empty()) {
-				i->second.context.share = getSharegroup(sg);
-			}
-
-			i->second.context.userdata = this;
-			i->second.context.curl = h;
-			i->second.context.origHandle = networkHandle;
-
-			i->second.context.origHandle->setDownloadProgress(
-					[this, h = networkHandle](int64_t total, int64_t now) -> int {
-				onDownloadProgress(h, total, now);
-				return 0;
-			});
-
-			i->second.context.origHandle->setUploadProgress(
-					[this, h = networkHandle](int64_t total, int64_t now) -> int {
-				onUploadProgress(h, total, now);
-				return 0;
-			});
-
-			if (i->second.handle->shouldSignRequest()) {
-				sign(*networkHandle, i->second.context);
-			}
-
-			prepare(*networkHandle, &i->second.context, nullptr);
-
-			curl_multi_add_handle(reinterpret_cast<CURLM *>(_handle), h);
-		})) {
-			break;
+	auto cacheable = _cache && _cache->isCacheable(*req);
+	if (cacheable) {
+		req->_cacheRequestTime = Time::now();
+		req->_cacheEntry = _cache->lookup(*req);
+		if (req->_cacheEntry && req->_cacheEntry->isFresh(req->_cacheRequestTime)) {
+			_cache->apply(req->_cacheEntry.get(), *req);
+			_cache->addHit(Time::now() - req->_cacheRequestTime, false);
+			onComplete(const_cast<Handle *>(&req->getHandle()), true);
+			return;
 		}
-	} while (0);
-
-	int running = 0;
-	auto err = curl_multi_perform(reinterpret_cast<CURLM *>(_handle), &running);
-	if (err != CURLM_OK) {
-		log::source().error("CURL", toString("Fail to perform multi: ", err));
-		return false;
 	}
 
-	int timeout = 16;
-	if (running == 0) {
-		timeout = 1'000;
-	}
+	auto h = curl_easy_init();
+	auto networkHandle = const_cast<Handle *>(&req->getHandle());
+	auto i = _handles.emplace(h, ControllerHandle{move(req), networkHandle}).first;
 
-	err = curl_multi_poll(reinterpret_cast<CURLM *>(_handle), NULL, 0, timeout, nullptr);
-	if (err != CURLM_OK) {
-		log::source().error("CURL", toString("Fail to poll multi: ", err));
-		return false;
+	auto sg = i->second.handle->getSharegroup();
+	if (!sg.empty()) {
+		i->second.context.share = getSharegroup(sg);
 	}
 
-	struct CURLMsg *msg = nullptr;
-	do {
-		int msgq = 0;
-		msg = curl_multi_info_read(reinterpret_cast<CURLM *>(_handle), &msgq);
-		if (msg && (msg->msg == CURLMSG_DONE)) {
-			CURL *e = msg->easy_handle;
-			curl_multi_remove_handle(reinterpret_cast<CURLM *>(_handle), e);
-
-			auto it = _handles.find(e);
-			if (it != _handles.end()) {
-				it->second.context.code = msg->data.result;
-				auto ret = finalize(*it->second.handle, &it->second.context, nullptr);
-				if (!onComplete(it->second.handle, ret)) {
-					_handles.erase(it);
-					return false;
-				}
-				_handles.erase(it);
-			}
-
-			curl_easy_cleanup(e);
-		}
-	} while (msg);
+	i->second.context.userdata = _controller;
+	i->second.context.curl = h;
+	i->second.context.origHandle = networkHandle;
 
-	return true;
-}
+	i->second.context.origHandle->setDownloadProgress(
+			[this, h = networkHandle](int64_t total, int64_t now) -> int {
+		onDownloadProgress(h, total, now);
+		return 0;
+	});
 
-void Controller::Data::threadDispose() {
-	if (_handle) {
-		for (auto &it : _handles) {
-			curl_multi_remove_handle(reinterpret_cast<CURLM *>(_handle), it.first);
-			it.second.context.code = CURLE_FAILED_INIT;
-			finalize(*it.second.handle, &it.second.context, nullptr);
-			curl_easy_cleanup(it.first);
-		}
+	i->second.context.origHandle->setUploadProgress(
+			[this, h = networkHandle](int64_t total, int64_t now) -> int {
+		onUploadProgress(h, total, now);
+		return 0;
+	});
+
+	if (i->second.handle->shouldSignRequest()) {
+		sign(*networkHandle, i->second.context);
+	}
+
+	i->second.cacheable = cacheable;
+	if (cacheable && i->second.request->_cacheEntry
+			&& i->second.request->_cacheEntry->hasValidators()) {
+		_cache->prepareRevalidation(*i->second.request->_cacheEntry, &i->second.context);
+	}
 
-		curl_multi_cleanup(reinterpret_cast<CURLM *>(_handle));
+	prepare(*networkHandle, &i->second.context, nullptr);
 
-		for (auto &it : _sharegroups) { curl_share_cleanup((CURLSH *)it.second); }
+	if (!_driver->addHandle(h)) {
+		i->second.context.code = CURLE_FAILED_INIT;
+		auto ret = finalize(*i->second.handle, &i->second.context, nullptr);
+		onComplete(i->second.handle, ret);
+		_handles.erase(i);
+		curl_easy_cleanup(h);
+	}
+}
 
-		_handles.clear();
-		_sharegroups.clear();
+void Controller::Data::handleCompleted(CURL *e, CURLcode code) {
+	XL_PROFILE_ZONE("network::Controller::handleCompleted", "network");
 
-		_handle = nullptr;
+	auto it = _handles.find(e);
+	if (it != _handles.end()) {
+		it->second.context.code = code;
+		auto ret = finalize(*it->second.handle, &it->second.context, nullptr);
+		if (ret && _cache && it->second.cacheable) {
+			handleCacheResponse(*it->second.request);
+		}
+		onComplete(it->second.handle, ret);
+		_handles.erase(it);
 	}
 
-	Thread::threadDispose();
+	curl_easy_cleanup(e);
 }
 
 void *Controller::Data::getSharegroup(StringView name) {
@@ -239,33 +249,43 @@ void *Controller::Data::getSharegroup(StringView name) {
 
 void Controller::Data::handleNetworkStateChanged(NetworkFlags caps) { _capabilities = caps; }
 
+void Controller::Data::performOnThread(Function<void()> &&func, Ref *target, bool onNextFrame) {
+	if (_application) {
+		_application->performOnAppThread(sp::move(func), target, onNextFrame);
+	} else if (!onNextFrame && _looper->isOnThisThread()) {
+		func();
+	} else {
+		_looper->performOnThread(sp::move(func), target, !onNextFrame);
+	}
+}
+
+// Callbacks are called from within CURL, so, notifications are deferred to the next event
+// Request is retained, because handle can be released before notification
 void Controller::Data::onUploadProgress(Handle *handle, int64_t total, int64_t now) {
-	_application->performOnAppThread([handle, total, now] {
-		auto req = handle->getReqeust();
+	performOnThread([req = handle->getReqeust(), total, now] {
 		req->notifyOnUploadProgress(total, now);
-	});
-	_application->wakeup();
+	}, nullptr, true);
 }
 
 void Controller::Data::onDownloadProgress(Handle *handle, int64_t total, int64_t now) {
-	_application->performOnAppThread([handle, total, now] {
-		auto req = handle->getReqeust();
+	performOnThread([req = handle->getReqeust(), total, now] {
 		req->notifyOnDownloadProgress(total, now);
-	});
-	_application->wakeup();
+	}, nullptr, true);
 }
 
 bool Controller::Data::onComplete(Handle *handle, bool success) {
-	_application->performOnAppThread([handle, success] {
-		auto req = handle->getReqeust();
+	performOnThread([req = handle->getReqeust(), success] {
 		req->notifyOnComplete(success);
-	});
-
-	_application->wakeup();
+	}, nullptr, true);
 	return true;
 }
 
 void Controller::Data::sign(NetworkHandle &handle, Context &ctx) const {
+	if (!_application) {
+		log::source().error("network::Controller", "Request signing requires application");
+		return;
+	}
+
 	String date = Time::now().toHttp<Interface>();
 
 	auto appInfo = _application->getContext()->getInfo();
@@ -286,11 +306,30 @@ void Controller::Data::sign(NetworkHandle &handle, Context &ctx) const {
 }
 
 void Controller::Data::pushTask(Rc<Request> &&handle) {
-	_pending.push(0, false, move(handle));
-	curl_multi_wakeup(_handle);
+	performOnThread([c = Rc<Controller>(_controller), handle = move(handle)]() mutable {
+		// controller data can be released before task is performed
+		if (c->_data) {
+			c->_data->addTask(move(handle));
+		}
+	}, _controller, false);
 }
 
-void Controller::Data::wakeup() { curl_multi_wakeup(_handle); }
+void Controller::Data::handleCacheResponse(Request &req) {
+	auto &handle = req.getHandle();
+	auto latency = Time::now() - req._cacheRequestTime;
+	if (handle.getResponseCode() == 304 && req._cacheEntry) {
+		_cache->update(req._cacheEntry.get(), req, req._cacheRequestTime);
+		_cache->apply(req._cacheEntry.get(), req);
+		_cache->addHit(latency, true);
+	} else {
+		if (handle.getResponseCode() < 400 && req._cacheEntry) {
+			_cache->remove(req._cacheEntry->getKey());
+		}
+		req._cacheEntry = nullptr;
+		_cache->store(req, req._cacheRequestTime);
+		_cache->addMiss(latency);
+	}
+}
 
 bool Controller::Data::prepare(Handle &handle, Context *ctx,
 		const Callback<bool(CURL *)> &onBeforePerform) {
@@ -315,17 +354,19 @@ Rc<ApplicationExtension> Controller::createController(AppThread *app, StringView
 Controller::Controller(AppThread *app, StringView name, Bytes &&signKey) {
 	_data = new (std::nothrow) Data(app, this, name, sp::move(signKey));
 	_data->init();
-	_data->run();
+}
+
+Controller::Controller(event::Looper *looper, StringView name, Bytes &&signKey) {
+	_data = new (std::nothrow) Data(looper, this, name, sp::move(signKey));
+	_data->init();
 }
 
 Controller::~Controller() { }
 
-void Controller::initialize(AppThread *) { }
+void Controller::initialize(AppThread *) { _data->start(); }
 
 void Controller::invalidate(AppThread *) {
 	_data->stop();
-	curl_multi_wakeup(_data->_handle);
-	_data->waitStopped();
 	delete _data;
 	_data = nullptr;
 }
@@ -342,6 +383,10 @@ void Controller::run(Rc<Request> &&handle) { _data->pushTask(move(handle)); }
 
 void Controller::setSignKey(Bytes &&value) { _data->_signKey = sp::move(value); }
 
+void Controller::setCache(Rc<Cache> &&cache) { _data->_cache = move(cache); }
+
+Cache *Controller::getCache() const { return _data->_cache.get(); }
+
 bool Controller::isNetworkOnline() const {
 	return (_data->_capabilities & NetworkFlags::Internet) != NetworkFlags::None;
 }
@@ -32,6 +32,7 @@
 namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
 
 class Request;
+class Cache;
 
 class SP_PUBLIC Controller final : public ApplicationExtension {
 public:
@@ -39,6 +40,12 @@ public:
 			Bytes &&signKey = Bytes());
 
 	Controller(AppThread *, StringView, Bytes &&signKey = Bytes());
+
+	// Controller without application, driven by looper directly (tools and tests):
+	// call initialize/invalidate with nullptr from the looper's thread to start and stop it,
+	// callbacks are called on the looper's thread
+	Controller(event::Looper *, StringView, Bytes &&signKey = Bytes());
+
 	virtual ~Controller();
 
 	virtual void initialize(AppThread *) override;
@@ -55,6 +62,10 @@ public:
 
 	void setSignKey(Bytes &&value);
 
+	// Response cache for GET requests, should be set from application thread
+	void setCache(Rc<Cache> &&);
+	Cache *getCache() const;
+
 	bool isNetworkOnline() const;
 
 protected:
@@ -24,6 +24,7 @@
 #include "SPFilepath.h"
 #include "XLNetworkController.h"
 #include "XLNetworkRequest.h"
+#include "XLNetworkCache.h"
 #include "XLContext.h"
 
 namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
@@ -44,8 +45,6 @@ bool Handle::init(StringView url, const FileInfo &fileName) {
 bool Handle::init(Method method, StringView url) { return NetworkHandle::init(method, url); }
 
 bool Handle::prepare(Context *ctx) {
-	auto appInfo = _controller->getApplication()->getContext()->getInfo();
-
 	if (_mtime > 0) {
 		auto httpTime = Time::microseconds(_mtime).toHttp<Interface>();
 		ctx->headers =
@@ -56,10 +55,19 @@ bool Handle::prepare(Context *ctx) {
 		ctx->headers = curl_slist_append(ctx->headers, toString("If-None-Match: ", _etag).data());
 	}
 
-	ctx->headers = curl_slist_append(ctx->headers,
-			toString("X-ApplicationName: ", appInfo->bundleName).data());
-	ctx->headers = curl_slist_append(ctx->headers,
-			toString("X-ApplicationVersion: ", appInfo->appVersion).data());
+	// controller without application has no app info to send
+	if (auto app = _controller->getApplication()) {
+		auto appInfo = app->getContext()->getInfo();
+
+		ctx->headers = curl_slist_append(ctx->headers,
+				toString("X-ApplicationName: ", appInfo->bundleName).data());
+		ctx->headers = curl_slist_append(ctx->headers,
+				toString("X-ApplicationVersion: ", appInfo->appVersion).data());
+
+		if (!appInfo->userAgent.empty()) {
+			setUserAgent(appInfo->userAgent);
+		}
+	}
 
 	if (!_sharegroup.empty() && ctx->share) {
 		auto cookieFile =
@@ -67,10 +75,6 @@ bool Handle::prepare(Context *ctx) {
 		setCookieFile(FileInfo{cookieFile, FileCategory::AppCache});
 	}
 
-	if (!appInfo->userAgent.empty()) {
-		setUserAgent(appInfo->userAgent);
-	}
-
 	return true;
 }
 
@@ -119,10 +123,14 @@ void Request::perform(Controller *c, CompleteCallback &&cb) {
 
 	_uploadProgress = pair(0, 0);
 	_downloadProgress = pair(0, 0);
+	_cachedResponse = false;
+	_cacheEntry = nullptr;
+	_receiveToBuffer = false;
 
 	auto &source = _handle.getReceiveDataSource();
 	if (std::holds_alternative<std::monostate>(source)) {
 		if (!_ignoreResponseData) {
+			_receiveToBuffer = true;
 			_targetHeaderCallback = _handle.getHeaderCallback();
 
 			_handle.setHeaderCallback(
@@ -142,6 +150,19 @@ void Request::setIgnoreResponseData(bool value) {
 	}
 }
 
+void Request::setUseCache(bool value) {
+	if (!_running) {
+		_useCache = value;
+	}
+}
+
+BytesView Request::getData() const {
+	if (_cachedResponse && _cacheEntry) {
+		return _cacheEntry->getBody();
+	}
+	return _data;
+}
+
 void Request::setUploadProgress(ProgressCallback &&cb) { _onUploadProgress = sp::move(cb); }
 
 void Request::setDownloadProgress(ProgressCallback &&cb) { _onDownloadProgress = sp::move(cb); }
@@ -38,6 +38,8 @@ namespace STAPPLER_VERSIONIZED stappler::xenolith::network {
 
 class Controller;
 class Request;
+class Cache;
+class CacheEntry;
 
 using Method = stappler::network::Method;
 
@@ -73,6 +75,7 @@ public:
 protected:
 	friend class Controller;
 	friend class Request;
+	friend class Cache;
 
 	bool prepare(Context *ctx);
 	bool finalize(Context *ctx, bool success);
@@ -104,6 +107,13 @@ public:
 	void setIgnoreResponseData(bool);
 	bool isIgnoreResponseData() const { return _ignoreResponseData; }
 
+	// Use controller's response cache, if any (true by default)
+	void setUseCache(bool);
+	bool isUseCache() const { return _useCache; }
+
+	// Response was served from cache, without network query or after revalidation
+	bool isCachedResponse() const { return _cachedResponse; }
+
 	bool isRunning() const { return _running; }
 
 	const Handle &getHandle() const { return _handle; }
@@ -121,10 +131,11 @@ public:
 	void setUploadProgress(ProgressCallback &&);
 	void setDownloadProgress(ProgressCallback &&);
 
-	BytesView getData() const { return _data; }
+	BytesView getData() const;
 
 protected:
 	friend class Controller;
+	friend class Cache;
 
 	void handleHeader(StringView, StringView);
 	size_t handleReceive(char *, size_t);
@@ -136,6 +147,9 @@ protected:
 	bool _running = false;
 	bool _ignoreResponseData = false;
 	bool _setupInput = false;
+	bool _useCache = true;
+	bool _cachedResponse = false;
+	bool _receiveToBuffer = false; // response is received into _data with own callbacks
 	Function<void(StringView, StringView)> _targetHeaderCallback;
 	Pair<int64_t, int64_t> _uploadProgress = pair(0, 0); // total, now
 	Pair<int64_t, int64_t> _downloadProgress = pair(0, 0); // total, now
@@ -147,6 +161,10 @@ protected:
 
 	size_t _nbytes = 0;
 	Bytes _data;
+
+	// stored response for revalidation, or response body holder for cached response
+	Rc<CacheEntry> _cacheEntry;
+	Time _cacheRequestTime;
 };
 
 } // namespace stappler::xenolith::network
@@ -828,6 +828,8 @@ Server::ServerData::ServerData() {
 Server::ServerData::~ServerData() { }
 
 bool Server::ServerData::execute(const ServerDataTaskCallback &task) {
+	XL_PROFILE_ZONE("storage::Server::execute", "storage");
+
 	if (currentTransaction) {
 		if (!task.callback) {
 			return false;
@@ -873,6 +875,8 @@ void Server::ServerData::runAsync() {
 }
 
 void Server::ServerData::threadInit() {
+	profiling::setThreadName("Storage");
+
 	memory::perform([&] {
 		handle = driver->connect(storage->params);
 		if (!handle.get()) {
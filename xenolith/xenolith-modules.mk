@@ -30,6 +30,7 @@ TOOLKIT_MODULE_LIST += \
 	$(XENOLITH_MODULE_DIR)/application/application.mk \
 	$(XENOLITH_MODULE_DIR)/font/font.mk \
 	$(XENOLITH_MODULE_DIR)/backend/vk/vk.mk \
+	$(XENOLITH_MODULE_DIR)/backend/null/null.mk \
 	$(XENOLITH_MODULE_DIR)/renderer/basic2d/basic2d.mk \
 	$(XENOLITH_MODULE_DIR)/renderer/material2d/material2d.mk \
 	$(XENOLITH_MODULE_DIR)/renderer/richtext/richtext.mk \